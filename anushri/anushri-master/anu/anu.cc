@@ -54,21 +54,87 @@ TuningTimer tuning_timer;
 PwmOutput<3> audio_out;
 
 volatile uint8_t refresh_counter = 0;
-volatile uint16_t clock_ticks = 0;
-volatile uint8_t num_external_clock_events = 0;
+volatile uint8_t clock_ticks = 0;
+volatile uint8_t dac_read_tick = 0;
+
+// Edges on the Trig and Gate inputs. The 12 LSBs are the time of the edge, as
+// returned by SampleTime().
+enum InputEvent {
+  INPUT_EVENT_TRIG = 0x1000,
+  INPUT_EVENT_GATE_ON = 0x2000,
+  INPUT_EVENT_GATE_OFF = 0x3000
+};
+
+struct InputEventBufferSpecs {
+  enum {
+    buffer_size = 16,
+    data_size = 16,
+  };
+  typedef avrlib::DataTypeForSize<data_size>::Type Value;
+};
+
+RingBuffer<InputEventBufferSpecs> input_events;
+
+// Clock timer ticks per call to the TIMER0 ISR. A DAC state sample lasts two
+// calls, 16 ticks.
+static const uint8_t kPollTicks = 8;
+
+// Edges and clock events are applied to the next DAC state sample written,
+// and the envelopes they trigger are rendered ahead by the time elapsed since
+// the event, down to 1/16th of a sample. Up to 8 samples are caught up.
+static const uint8_t kMaxTriggerDelay = 128;
+
+// Time in clock timer ticks (39kHz), 1/16th of a DAC state sample. It is
+// 16 * n, modulo 4096, when the n-th DAC state sample is sent.
+inline uint16_t SampleTime() {
+  cli();
+  uint8_t read_count = voice_controller.voice().dac_read_count();
+  uint8_t age = clock_ticks - dac_read_tick;
+  sei();
+  return ((static_cast<uint16_t>(read_count) << 4) + age) & 0xfff;
+}
+
+// Delay between an event and the time the DAC state sample about to be
+// written is sent, minus the sample which is rendered anyway.
+inline uint8_t TriggerDelay(uint16_t event_time) {
+  uint8_t sample = voice_controller.voice().dac_write_count() + 1;
+  uint16_t sample_time = static_cast<uint16_t>(sample) << 4;
+  int16_t delay = static_cast<int16_t>((sample_time - event_time) & 0xfff) - 16;
+  if (delay < 0) {
+    delay = 0;
+  } else if (delay > kMaxTriggerDelay) {
+    delay = kMaxTriggerDelay;
+  }
+  return delay;
+}
+
+// Number of clock timer ticks (39kHz) during which the MIDI out does not start
+// sending a low priority byte ahead of an internal clock event. A byte written
+// now can keep the UART busy for two byte durations (640us, 25 ticks), and
+// would delay the 0xf8 message by as much.
+const uint8_t kClockByteGuardTicks = 25;
 
 inline void FlushMidiOut() {
-  // Try to flush the high priority buffer first.
+  // A byte takes 1.6 calls to be shifted out.
+  midi_dispatcher.TickTx();
+  if (!midi_io.writable()) {
+    return;
+  }
+  // Try to flush the high priority buffer (real-time messages) first. They
+  // can be inserted between any two bytes of a running message.
   if (midi_dispatcher.readable_high_priority()) {
-    if (midi_io.writable()) {
-      midi_io.Overwrite(midi_dispatcher.ImmediateReadHighPriority());
-    }
-  } else {
-    if (midi_dispatcher.readable_low_priority()) {
-      if (midi_io.writable()) {
-        midi_io.Overwrite(midi_dispatcher.ImmediateReadLowPriority());
-      }
+    uint8_t byte = midi_dispatcher.ImmediateReadHighPriority();
+    midi_io.Overwrite(byte);
+    midi_dispatcher.OnRealtimeByteSent(byte);
+  } else if (midi_dispatcher.readable_low_priority()) {
+    // Messages are sent at the full line rate, except right before a clock
+    // message we are about to generate.
+    if (voice_controller.internal_clock() &&
+        midi_dispatcher.sends_transport() &&
+        clock.event_due(kClockByteGuardTicks)) {
+      return;
     }
+    midi_io.Overwrite(midi_dispatcher.ImmediateReadLowPriority());
   }
 }
 
@@ -81,6 +147,7 @@ inline void PollMidiIn() {
 inline bool UpdateDACs() {
   Word dac_value;
   voice_controller.mutable_voice()->ReadDACStateSample();
+  dac_read_tick = clock_ticks;
   const DACState& dac_state = voice_controller.voice().dac_state();
   
   // Write VCO CV.
@@ -139,16 +206,21 @@ ISR(TIMER0_OVF_vect, ISR_NOBLOCK) {
   // Read the input shift register without updating the switch debounce state.
   uint8_t in = inputs.ReadRegister();
   
-  // Detect raising edges on the Trig line.
-  if ((in & (1 << INPUT_TRIG)) && !(previous_in & (1 << INPUT_TRIG))) {
-    ++num_external_clock_events;
-  }
-  // Detect raising and falling edges on the Gate line.
-  if ((in & (1 << INPUT_GATE)) && !(previous_in & (1 << INPUT_GATE))) {
-    voice_controller.GateOn();
-  }
-  if (!(in & (1 << INPUT_GATE)) && (previous_in & (1 << INPUT_GATE))) {
-    voice_controller.GateOff();
+  // Detect raising edges on the Trig line, raising and falling edges on the
+  // Gate line.
+  uint8_t changes = in ^ previous_in;
+  if (changes & ((1 << INPUT_TRIG) | (1 << INPUT_GATE))) {
+    // The edge happened since the previous call: the middle of the interval
+    // is taken.
+    uint16_t time = (SampleTime() - kPollTicks / 2) & 0xfff;
+    if (changes & in & (1 << INPUT_TRIG)) {
+      input_events.NonBlockingWrite(INPUT_EVENT_TRIG | time);
+    }
+    if (changes & (1 << INPUT_GATE)) {
+      input_events.NonBlockingWrite(
+          ((in & (1 << INPUT_GATE)) ? INPUT_EVENT_GATE_ON : INPUT_EVENT_GATE_OFF)
+          | time);
+    }
   }
   previous_in = in;
   
@@ -168,6 +240,8 @@ ISR(TIMER0_OVF_vect, ISR_NOBLOCK) {
     TickSystemClock();
     inputs.Process(in);
     ui.Poll();
+  } else {
+    ui.OversamplePot();
   }
   outputs.Write(out);
   ++cycle;
@@ -193,8 +267,20 @@ ISR(TIMER1_OVF_vect, ISR_NOBLOCK) {
 
 // 39kHz clock used for the tempo counter.
 ISR(TIMER2_OVF_vect, ISR_NOBLOCK) {
+  static uint8_t sample = 0;
+  static bool underrun = false;
+  ++clock_ticks;
   clock.Tick();
-  audio_out.Write(audio_buffer.ImmediateRead());
+  // When the main loop could not keep up, hold the last sample rather than
+  // replaying stale buffer contents.
+  if (audio_buffer.readable()) {
+    sample = audio_buffer.ImmediateRead();
+    underrun = false;
+  } else if (!underrun) {
+    underrun = true;
+    ++audio_underruns;
+  }
+  audio_out.Write(sample);
 }
 
 inline void Init() {
@@ -235,26 +321,73 @@ inline void Init() {
   dco_controller.Start();
 }
 
+inline void ProcessInputEvents() {
+  Voice* voice = voice_controller.mutable_voice();
+  while (input_events.readable()) {
+    uint16_t event = input_events.ImmediateRead();
+    voice->set_trigger_delay(TriggerDelay(event & 0xfff));
+    switch (event & 0xf000) {
+      case INPUT_EVENT_TRIG:
+        if (!voice_controller.internal_clock()) {
+          voice_controller.Clock(false);
+        }
+        break;
+      case INPUT_EVENT_GATE_ON:
+        voice_controller.GateOn();
+        break;
+      case INPUT_EVENT_GATE_OFF:
+        voice_controller.GateOff();
+        break;
+    }
+  }
+  voice->set_trigger_delay(0);
+}
+
+inline void ProcessClockEvents() {
+  // Count how many clock ticks have elapsed since the last refresh.
+  if (voice_controller.internal_clock()) {
+    uint8_t num_events = clock.CountEvents();
+    if (num_events) {
+      voice_controller.mutable_voice()->set_trigger_delay(
+          TriggerDelay((SampleTime() - clock.event_age()) & 0xfff));
+    }
+    while (num_events) {
+      voice_controller.Clock(false);
+      --num_events;
+    }
+    voice_controller.mutable_voice()->set_trigger_delay(0);
+  }
+}
+
+inline void RenderAudio() {
+  // Fill some samples for the PWM out. To avoid getting the 40kHz PWM carrier 
+  // when unnecessary, we set the output to 0 unless:
+  // - The drum machine is configured to play a pattern.
+  // - We have received a note message on MIDI channel 10, which is a hint
+  //   that an external sequencer might trigger Anushri's drum synth.
+  if (voice_controller.has_drums() ||
+      midi_dispatcher.seen_midi_drum_events() ||
+      drum_synth.playing()) {
+    drum_synth.Render();
+  } else {
+    drum_synth.FillWithSilence();
+  }
+}
+
 int main(void) {
   Init();
   ui.FlushEvents();
   while (1) {
-    // Fill some samples for the DACs.
-    voice_controller.mutable_voice()->Refresh();
-    
-    // Fill some samples for the PWM out. To avoid getting the 40kHz PWM carrier 
-    // when unnecessary, we set the output to 0 unless:
-    // - The drum machine is configured to play a pattern.
-    // - We have received a note message on MIDI channel 10, which is a hint
-    //   that an external sequencer might trigger Anushri's drum synth.
-    if (voice_controller.has_drums() ||
-        midi_dispatcher.seen_midi_drum_events() ||
-        drum_synth.playing()) {
-      drum_synth.Render();
-    } else {
-      drum_synth.FillWithSilence();
+    // Fill some samples for the DACs. Clock and gate events are processed
+    // between samples, right before the first one written after them.
+    while (voice_controller.voice().writable()) {
+      ProcessInputEvents();
+      ProcessClockEvents();
+      voice_controller.mutable_voice()->WriteDACStateSample();
     }
     
+    RenderAudio();
+    
     // If we have not received any event on channel 10 for 5 mins, we consider
     // that no further event will come and we preventively disable the drum
     // engine.
@@ -262,25 +395,15 @@ int main(void) {
       midi_dispatcher.ResetDrumEventMonitor();
     }
 
-    // Count how many clock ticks have elapsed since the last refresh.
-    if (voice_controller.internal_clock()) {
-      uint8_t num_events = clock.CountEvents();
-      while (num_events) {
-        voice_controller.Clock(false);
-        --num_events;
-      }
-      num_external_clock_events = 0;
-    } else {
-      while (num_external_clock_events) {
-        voice_controller.Clock(false);
-        --num_external_clock_events;
-      }
-    }
-    
     // Check if there is some MIDI data to process. If so, decode the MIDI
     // bytestream.
     while (midi_in_buffer.readable()) {
       midi_parser.PushByte(midi_in_buffer.ImmediateRead());
+      // Render ahead between bytes so that long bursts of MIDI data do not
+      // starve the audio buffer.
+      if (audio_buffer.writable() >= kAudioBlockSize) {
+        RenderAudio();
+      }
     }
     
     // Update the voice tuner state machine.
@@ -289,6 +412,14 @@ int main(void) {
       voice_tuner.Abort();
     }
     
+    // Top up the audio buffer again before the UI gets its turn.
+    if (audio_buffer.writable() >= kAudioBlockSize) {
+      RenderAudio();
+    }
+
+    // Write the sequence being saved, one EEPROM byte at a time.
+    sequence_bank.Tick();
+
     // Handle UI events
     ui.DoEvents();
   }
@@ -24,4 +24,7 @@ namespace anu {
 /* extern */
 avrlib::RingBuffer<AudioBufferSpecs> audio_buffer;
 
+/* extern */
+volatile uint16_t audio_underruns = 0;
+
 }  // namespace anu
@@ -36,6 +36,9 @@ static const uint8_t kAudioBlockSize = 32;
 
 extern avrlib::RingBuffer<AudioBufferSpecs> audio_buffer;
 
+// Number of times the audio interrupt found the buffer empty.
+extern volatile uint16_t audio_underruns;
+
 }  // namespace anu
 
 #endif  // ANU_AUDIO_BUFFER_H_
@@ -68,6 +68,22 @@ class Clock {
     return count;
   }
   
+  // Number of calls to Tick() since the last clock event, modulo 256. Only
+  // the low byte is read, so that Tick() cannot change it halfway.
+  static inline uint8_t event_age() {
+    return static_cast<uint8_t>(clock_counter_);
+  }
+
+  // True when the next clock event has been counted but not processed yet,
+  // or will be counted within the given number of calls to Tick().
+  static inline bool event_due(uint8_t num_ticks) {
+    if (num_clock_events_) {
+      return true;
+    }
+    return prescaler_counter_ + 1 >= prescaler_ &&
+        clock_counter_ + num_ticks >= tick_duration_;
+  }
+  
   static void set_prescaler(uint8_t prescaler) {
     prescaler_ = prescaler;
   }
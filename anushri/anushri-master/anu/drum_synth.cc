@@ -15,6 +15,7 @@
 
 #include "anu/drum_synth.h"
 
+#include "avrlib/adpcm.h"
 #include "avrlib/op.h"
 #include "avrlib/random.h"
 #include "avrlib/time.h"
@@ -54,6 +55,28 @@ bool DrumSynth::playing_;
 /* static */
 uint32_t DrumSynth::last_event_time_;
 
+/* static */
+AdpcmDecoder DrumSynth::hh_decoder_;
+
+/* static */
+uint16_t DrumSynth::hh_end_;
+
+// Samples of the third voice, picked by the 2 upper bits of its crunchiness.
+// They are played once, up to the end phase: the number of samples << 4.
+static const prog_uint8_t* hh_samples[] = {
+  wav_res_hh,
+  wav_res_oh,
+  wav_res_clap,
+  wav_res_rim,
+};
+
+static const prog_uint16_t hh_sample_sizes[] PROGMEM = {
+  WAV_RES_HH_DECODED_SIZE,
+  WAV_RES_OH_DECODED_SIZE,
+  WAV_RES_CLAP_DECODED_SIZE,
+  WAV_RES_RIM_DECODED_SIZE,
+};
+
 static const prog_uint8_t preset_bd_1[] PROGMEM = { 60, 18, 104, 120, 0 };
 static const prog_uint8_t preset_bd_2[] PROGMEM = { 56, 60, 120, 150, 0 };
 static const prog_uint8_t preset_bd_3[] PROGMEM = { 60, 42, 130, 180, 14 };
@@ -66,11 +89,13 @@ static const prog_uint8_t preset_sd_3[] PROGMEM = { 108, 36, 50, 90, 180 };
 static const prog_uint8_t preset_sd_4[] PROGMEM = { 116, 36, 32, 80, 150 };
 static const prog_uint8_t preset_sd_5[] PROGMEM = { 124, 40, 190, 90, 40 };
 
-static const prog_uint8_t preset_hh_1[] PROGMEM = { 124, 0, 0, 80, 0 };
-static const prog_uint8_t preset_hh_2[] PROGMEM = { 136, 0, 0, 80, 0 };
-static const prog_uint8_t preset_hh_3[] PROGMEM = { 136, 0, 0, 110, 0 };
-static const prog_uint8_t preset_hh_4[] PROGMEM = { 148, 0, 0, 90, 0 };
-static const prog_uint8_t preset_hh_5[] PROGMEM = { 154, 0, 0, 45, 0 };
+// Closed hi-hats, open hi-hat, clap, rim shot. The clap and rim shot are
+// played at the pitch they were synthesized for (128).
+static const prog_uint8_t preset_hh_1[] PROGMEM = { 124, 0, 0, 80, 32 };
+static const prog_uint8_t preset_hh_2[] PROGMEM = { 148, 0, 0, 60, 32 };
+static const prog_uint8_t preset_hh_3[] PROGMEM = { 136, 0, 0, 150, 96 };
+static const prog_uint8_t preset_hh_4[] PROGMEM = { 128, 0, 0, 110, 160 };
+static const prog_uint8_t preset_hh_5[] PROGMEM = { 128, 0, 0, 60, 224 };
 
 static const prog_uint8_t* drum_presets[] = {
   preset_bd_1,
@@ -95,6 +120,8 @@ static const prog_uint8_t* drum_presets[] = {
 /* static */
 void DrumSynth::Init() {
   memset(state_, 0, sizeof(DrumState) * kNumDrumInstruments);
+  hh_decoder_.Init(wav_res_hh);
+  hh_end_ = 0;
 }
 
 /* static */
@@ -107,11 +134,18 @@ void DrumSynth::Trigger(uint8_t instrument, uint8_t level) {
   state_[instrument].amp_env_phase = 0;
   
   // Initialize envelope increments
-  state_[instrument].pitch_env_increment = pgm_read_word(
-      lut_res_drm_env_increments + patch_[instrument].pitch_decay);
-  state_[instrument].amp_env_increment = pgm_read_word(
-      lut_res_drm_env_increments + patch_[instrument].amp_decay);
+  state_[instrument].pitch_env_increment = ResourcesManager::LookupDelta2(
+      lut_res_drm_env_increments, lut_res_drm_env_increments_blocks,
+      patch_[instrument].pitch_decay);
+  state_[instrument].amp_env_increment = ResourcesManager::LookupDelta2(
+      lut_res_drm_env_increments, lut_res_drm_env_increments_blocks,
+      patch_[instrument].amp_decay);
   state_[instrument].level = U8U8MulShift8(level, patch_[instrument].level);
+  if (instrument == 2) {
+    uint8_t sample = patch_[2].crunchiness >> 6;
+    hh_decoder_.Init(hh_samples[sample]);
+    hh_end_ = pgm_read_word(hh_sample_sizes + sample) << 4;
+  }
   playing_ = true;
 }
 
@@ -133,12 +167,12 @@ static const prog_uint8_t drums_cc_map[] PROGMEM = {
   // SD
   6, 7, 8, 9, 10, 11,
   //
-  12, 15, 17
+  12, 15, 17, 16
 };
 
 /* static */
 void DrumSynth::SetParameterCc(uint8_t cc, uint8_t value) {
-  if (cc < 16 || cc > 30) {
+  if (cc < 16 || cc > 31) {
     return;
   }
   uint8_t address = pgm_read_byte(drums_cc_map + cc - 16);
@@ -190,6 +224,8 @@ void DrumSynth::Render() {
     uint16_t phase_0 = state_[0].phase;
     uint16_t phase_1 = state_[1].phase;
     uint16_t phase_2 = state_[2].phase;
+    uint16_t hh_end = hh_end_;
+    bool hh_playing = state_[2].amp_level != 0;
     for (uint8_t i = 0; i < kAudioBlockSize; ++i) {
       ++sample_counter;
       int16_t mix = 128;
@@ -198,6 +234,10 @@ void DrumSynth::Render() {
       phase_0 += state_[0].phase_increment;
       phase_1 += state_[1].phase_increment;
       phase_2 += state_[2].phase_increment;
+      if (phase_2 >= hh_end) {
+        phase_2 = hh_end;
+        hh_playing = false;
+      }
       
       // Linear interpolation optimized for the case when the delta
       // between adjacent samples is in the -127..+127 range.
@@ -212,7 +252,9 @@ void DrumSynth::Render() {
       mix += S8U8MulShift8(sd, state_[1].amp_level);
       mix += S8U8MulShift8(noise, state_[1].amp_level_noise);
 
-      int8_t hh = pgm_read_byte(wav_res_hh + U16ShiftRight4(phase_2));
+      // The sample is stored as ADPCM, decoded sequentially. It costs one
+      // step per source sample.
+      int8_t hh = hh_playing ? hh_decoder_.Read(U16ShiftRight4(phase_2)) : 0;
       mix += S8U8MulShift8(hh, state_[2].amp_level);
       
       if (sample_counter > sample_rate_) {
@@ -276,6 +318,10 @@ void DrumSynth::UpdateModulations() {
       state_[1].amp_level,
       ~patch_[1].crunchiness);
   state_[2].phase_increment >>= 6;
+  // No more than 2 ADPCM steps per sample.
+  if (state_[2].phase_increment > 32) {
+    state_[2].phase_increment = 32;
+  }
 }
 
 /* static */
@@ -18,6 +18,7 @@
 
 #include <string.h>
 
+#include "avrlib/adpcm.h"
 #include "avrlib/base.h"
 
 namespace anu {
@@ -72,6 +73,8 @@ class DrumSynth {
   static uint8_t fade_counter_;
   static uint32_t last_event_time_;
   static bool playing_;
+  static avrlib::AdpcmDecoder hh_decoder_;
+  static uint16_t hh_end_;
   
   DISALLOW_COPY_AND_ASSIGN(DrumSynth);
 };
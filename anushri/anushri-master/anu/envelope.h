@@ -32,6 +32,15 @@ enum EnvelopeSegment {
   ENV_NUM_SEGMENTS,
 };
 
+// Overshoot of the point approached by a segment, relative to its amplitude:
+// exp(-4) / (1 - exp(-4)).
+static const uint16_t kEnvelopeOvershoot = 1223;
+
+// Below this phase increment, the fraction of the distance covered at each
+// sample is under 2^-8, and is computed in units of 2^-24 rather than read
+// from lut_res_env_coefficients, in units of 2^-16.
+static const uint32_t kEnvelopeFineIncrement = 1UL << 22;
+
 class Envelope {
  public:
   Envelope() { }
@@ -56,9 +65,9 @@ class Envelope {
   }
   
   inline void Update(uint8_t a, uint8_t d, uint8_t s, uint8_t r) {
-    increment_[ENV_SEGMENT_ATTACK] = pgm_read_dword(lut_res_env_increments + a);
-    increment_[ENV_SEGMENT_DECAY] = pgm_read_dword(lut_res_env_increments + d);
-    increment_[ENV_SEGMENT_RELEASE] = pgm_read_dword(lut_res_env_increments + r);
+    SetTime(ENV_SEGMENT_ATTACK, a);
+    SetTime(ENV_SEGMENT_DECAY, d);
+    SetTime(ENV_SEGMENT_RELEASE, r);
     target_[ENV_SEGMENT_SUSTAIN] = target_[ENV_SEGMENT_DECAY] = s << 8;
   }
   
@@ -68,11 +77,45 @@ class Envelope {
     }
     a_ = value_;
     b_ = target_[segment];
+    uint16_t distance = b_ > a_ ? b_ - a_ : a_ - b_;
+    distance_ = static_cast<uint32_t>(distance) << 16;
+    overshoot_ = U16U16MulShift16(distance, kEnvelopeOvershoot) >> 1;
     segment_ = segment;
     phase_ = 0;
   }
 
+  // Segments are computed recursively, unless the firmware is built with
+  // ENABLE_ENVELOPE_EXPO_TABLE, which interpolates lut_res_env_expo instead.
+  // tools/envelope_test compares the two.
   inline uint16_t Render() {
+#ifdef ENABLE_ENVELOPE_EXPO_TABLE
+    return RenderTable();
+#else
+    return RenderRecursive();
+#endif  // ENABLE_ENVELOPE_EXPO_TABLE
+  }
+
+  inline uint16_t RenderRecursive() {
+    uint32_t increment = increment_[segment_];
+    phase_ += increment;
+    if (phase_ < increment) {
+      value_ = b_;
+      Trigger(static_cast<EnvelopeSegment>(segment_ + 1));
+    } else if (increment) {
+      // Cover a fixed fraction of the distance left to a point beyond b_, so
+      // that b_ is reached at the end of the segment. Distances are halved
+      // to fit the multiplication in 32 bits.
+      uint16_t distance = (distance_ >> 17) + overshoot_;
+      uint32_t step = static_cast<uint32_t>(distance) * coefficient_[segment_];
+      step = fine_[segment_] ? step >> 7 : step << 1;
+      distance_ = distance_ > step ? distance_ - step : 0;
+      distance = distance_ >> 16;
+      value_ = b_ > a_ ? b_ - distance : b_ + distance;
+    }
+    return value_;
+  }
+
+  inline uint16_t RenderTable() {
     uint32_t increment = increment_[segment_];
     phase_ += increment;
     if (phase_ < increment) {
@@ -88,12 +131,52 @@ class Envelope {
     return value_;
   }
   
+  // Renders ahead by a number of 1/16th of a sample, so that a segment
+  // triggered late is in phase with the event it follows. For the last
+  // fraction of a sample, the increment and the fraction of the distance
+  // covered are scaled down.
+  inline void Advance(uint8_t sixteenths) {
+    while (sixteenths >= 16) {
+      Render();
+      sixteenths -= 16;
+    }
+    if (sixteenths) {
+      uint8_t segment = segment_;
+      uint32_t increment = increment_[segment];
+      uint16_t coefficient = coefficient_[segment];
+      increment_[segment] = (increment >> 4) * sixteenths;
+      coefficient_[segment] = (coefficient >> 4) * sixteenths;
+      Render();
+      increment_[segment] = increment;
+      coefficient_[segment] = coefficient;
+    }
+  }
+
   inline uint16_t value() const { return value_; }
 
  private:
+  inline void SetTime(EnvelopeSegment segment, uint8_t time) {
+    uint32_t increment = pgm_read_dword(lut_res_env_increments + time);
+    increment_[segment] = increment;
+    fine_[segment] = increment < kEnvelopeFineIncrement;
+    if (fine_[segment]) {
+      // 1 - exp(-x) ~ x - x^2 / 2, with x = 4 * increment / 2^32.
+      uint16_t x = increment >> 6;
+      coefficient_[segment] = x - (static_cast<uint32_t>(x) * x >> 25);
+    } else {
+      coefficient_[segment] = ResourcesManager::LookupDelta2(
+          lut_res_env_coefficients, lut_res_env_coefficients_blocks, time);
+    }
+  }
+
   // Phase increments for each segment.
   uint32_t increment_[ENV_NUM_SEGMENTS];
   
+  // Fraction of the remaining distance covered at each sample, in units of
+  // 2^-24 if fine_, of 2^-16 otherwise.
+  uint16_t coefficient_[ENV_NUM_SEGMENTS];
+  uint8_t fine_[ENV_NUM_SEGMENTS];
+
   // Value that needs to be reached at the end of each segment.
   uint16_t target_[ENV_NUM_SEGMENTS];
   
@@ -105,6 +188,10 @@ class Envelope {
   uint16_t b_;
   uint16_t value_;
 
+  // Distance left to b_ (16.16) and half the overshoot of the approached point.
+  uint32_t distance_;
+  uint16_t overshoot_;
+
   uint32_t phase_increment_;
   uint32_t phase_;
 
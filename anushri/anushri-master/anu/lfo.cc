@@ -27,8 +27,18 @@ namespace anu {
 
 using avrlib::Random;
 
+static const uint32_t kClockPulseIncrement = 178956970;  // 2^32 / 24.
+static const uint8_t kNumAcquisitionPulses = 3;
+static const int16_t kLockRange = 4096;
+static const int16_t kFineLockRange = 512;
+// The tracking range is 15 BPM .. 960 BPM at the 2.45kHz control rate.
+static const uint32_t kMinPhaseIncrement = 438086;
+static const uint32_t kMaxPhaseIncrement = 28037546;
+// Twice the period of the clock at the slowest tempo tracked.
+static const uint16_t kMaxClockPeriod = 817;
+
 uint16_t Lfo::Render() {
-  uint16_t value;
+  uint16_t value = 0;
   switch (shape_) {
     case LFO_SHAPE_TRIANGLE:
       value = (phase_ & 0x80000000)
@@ -77,7 +87,60 @@ uint16_t Lfo::Render() {
   }
   phase_ += phase_increment_;
   looped_ = phase_ < phase_increment_;
+  if (clock_period_ < kMaxClockPeriod) {
+    ++clock_period_;
+  } else {
+    // The clock has stopped: the next pulse is the first one of a new
+    // synchronization, and the period is measured again.
+    sync_pulses_ = 0;
+  }
   return value;
 }
 
+void Lfo::set_target_phase(uint16_t target_phase) {
+  uint16_t clock_period = clock_period_;
+  clock_period_ = 0;
+  int16_t error = target_phase - (phase_ >> 16);
+  
+  if (sync_pulses_ < kNumAcquisitionPulses ||
+      error > kLockRange || error < -kLockRange) {
+    // Acquisition: a loop with gains low enough to reject clock jitter takes
+    // dozens of pulses to converge (and never does at slow tempi), so the
+    // increment is directly derived from the period of the clock.
+    if (sync_pulses_ && clock_period) {
+      phase_increment_ = kClockPulseIncrement / clock_period;
+    }
+    if (sync_pulses_ < kNumAcquisitionPulses) {
+      phase_ = static_cast<uint32_t>(target_phase) << 16;
+      ++sync_pulses_;
+    } else {
+      // Tempo change: only catch up with half of the phase error to avoid a
+      // large discontinuity.
+      phase_ += static_cast<int32_t>(error) << 15;
+    }
+  } else {
+    // Tracking: P.I. corrector. The proportional term nudges the phase, the
+    // integral term is scaled by the increment itself so that the loop has the
+    // same dynamics at all tempi. The gains are lowered once the error is
+    // within the range of the MIDI clock jitter.
+    int32_t p_correction = error;
+    int32_t i_correction = static_cast<int32_t>(phase_increment_ >> 8) * error;
+    if (error > kFineLockRange || error < -kFineLockRange) {
+      p_correction <<= 14;
+      i_correction >>= 6;
+    } else {
+      p_correction <<= 13;
+      i_correction >>= 8;
+    }
+    phase_ += p_correction;
+    phase_increment_ += i_correction;
+  }
+  
+  if (phase_increment_ < kMinPhaseIncrement) {
+    phase_increment_ = kMinPhaseIncrement;
+  } else if (phase_increment_ > kMaxPhaseIncrement) {
+    phase_increment_ = kMaxPhaseIncrement;
+  }
+}
+
 }  // namespace anu
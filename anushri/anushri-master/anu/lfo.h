@@ -52,24 +52,15 @@ class Lfo {
 
   uint16_t Render();
   
-  inline void set_target_phase(uint16_t target_phase) {
-    // This is a simple P.D. corrector to get the LFO to track the phase and
-    // frequency of the pseudo-sawtooth given by the MIDI clock.
-    uint16_t phi = phase_ >> 16;
-    int16_t d_error = (65536 / 24) - (phi - previous_phase_);
-    int16_t p_error = target_phase - phi;
-    int32_t error = 0;
-    error += d_error;
-    error += p_error;
-    error <<= 8;
-    phase_increment_ += error;
-    // The tracking range is 15 BPM .. 960 BPM.
-    if (phase_increment_ < 109523) {
-      phase_increment_ = 109523;
-    } else if (phase_increment_ > 7009509) {
-      phase_increment_ = 7009509;
-    }
-    previous_phase_ = phi;
+  // Tracks the phase and frequency of the pseudo-sawtooth given by the MIDI
+  // clock, 24 pulses per LFO cycle.
+  void set_target_phase(uint16_t target_phase);
+  
+  // Restarts the synchronization: the next clock pulse sets the phase, and the
+  // following ones measure the clock period before the tracking loop kicks in.
+  inline void ResetSync() {
+    sync_pulses_ = 0;
+    clock_period_ = 0;
   }
   
   inline void set_phase(uint32_t phase) {
@@ -90,7 +81,8 @@ class Lfo {
  private:
   uint32_t phase_increment_;
   uint32_t phase_;
-  uint16_t previous_phase_;
+  uint16_t clock_period_;  // Number of calls to Render() since the last pulse.
+  uint8_t sync_pulses_;
   uint16_t value_;
   uint16_t next_value_;
   uint32_t filtered_value_;
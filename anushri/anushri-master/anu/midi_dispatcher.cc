@@ -29,6 +29,15 @@ bool MidiDispatcher::learning_midi_channel_ = false;
 /* static */
 bool MidiDispatcher::seen_midi_drum_events_ = false;
 
+/* static */
+volatile uint8_t MidiDispatcher::tx_tick_ = 0;
+
+/* static */
+volatile uint8_t MidiDispatcher::clock_latency_min_ = 0xff;
+
+/* static */
+volatile uint8_t MidiDispatcher::clock_latency_max_ = 0;
+
 /* static */
 void MidiDispatcher::Send(uint8_t status, uint8_t* data, uint8_t size) {
   OutputBufferLowPriority::Overwrite(status);
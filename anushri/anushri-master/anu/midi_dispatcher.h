@@ -46,10 +46,19 @@ struct HighPriorityBufferSpecs {
   typedef avrlib::DataTypeForSize<data_size>::Type Value;
 };
 
+struct ClockTimestampBufferSpecs {
+  enum {
+    buffer_size = 16,
+    data_size = 8,
+  };
+  typedef avrlib::DataTypeForSize<data_size>::Type Value;
+};
+
 class MidiDispatcher : public midi::MidiDevice {
  public:
   typedef avrlib::RingBuffer<LowPriorityBufferSpecs> OutputBufferLowPriority;
   typedef avrlib::RingBuffer<HighPriorityBufferSpecs> OutputBufferHighPriority;
+  typedef avrlib::RingBuffer<ClockTimestampBufferSpecs> ClockTimestamps;
 
   MidiDispatcher() { }
 
@@ -113,7 +122,16 @@ class MidiDispatcher : public midi::MidiDevice {
       voice_controller.Stop();
     }
   }
-  static void Continue() { Start(); }
+  static void Continue() {
+    if (!voice_controller.internal_clock()) {
+      voice_controller.Continue();
+    }
+  }
+  static void SongPosition(uint16_t position) {
+    if (!voice_controller.internal_clock()) {
+      voice_controller.SongPosition(position);
+    }
+  }
   
   static void SysExStart() {
     ProcessSysEx(0xf0);
@@ -212,6 +230,10 @@ class MidiDispatcher : public midi::MidiDevice {
   static bool seen_midi_drum_events() {
     return seen_midi_drum_events_;
   }
+  
+  static bool sends_transport() {
+    return mode() & MIDI_OUT_TX_TRANSPORT;
+  }
 
   // ------ Generation of MIDI out messages ------------------------------------
   static inline void OnInternalNoteOff(uint8_t note) {
@@ -245,6 +267,12 @@ class MidiDispatcher : public midi::MidiDevice {
     }
   }
 
+  static inline void OnContinue() {
+    if (mode() & MIDI_OUT_TX_TRANSPORT) {
+      SendNow(0xfb);
+    }
+  }
+
   static inline void OnStop() {
     if (mode() & MIDI_OUT_TX_TRANSPORT) {
       SendNow(0xfc);
@@ -257,16 +285,47 @@ class MidiDispatcher : public midi::MidiDevice {
       return;
     }
     if (mode() & MIDI_OUT_TX_TRANSPORT) {
+      ClockTimestamps::Overwrite(tx_tick_);
       SendNow(0xf8);
     }
   }
   
+  // Called from the MIDI out polling routine (4.9kHz), which also gives the
+  // time base for the clock latency statistics.
+  static inline void TickTx() {
+    ++tx_tick_;
+  }
+  
+  static inline void OnRealtimeByteSent(uint8_t byte) {
+    if (byte == 0xf8 && ClockTimestamps::readable()) {
+      uint8_t latency = tx_tick_ - ClockTimestamps::ImmediateRead();
+      if (latency < clock_latency_min_) {
+        clock_latency_min_ = latency;
+      }
+      if (latency > clock_latency_max_) {
+        clock_latency_max_ = latency;
+      }
+    }
+  }
+  
+  // Range of the delays between the generation of a clock message and its
+  // transmission, in MIDI out polling periods (204us).
+  static uint8_t clock_latency_min() { return clock_latency_min_; }
+  static uint8_t clock_latency_max() { return clock_latency_max_; }
+  static void ResetClockLatency() {
+    clock_latency_min_ = 0xff;
+    clock_latency_max_ = 0;
+  }
+  
   static void Send3(uint8_t status, uint8_t a, uint8_t b);
   static void SendBlocking(uint8_t byte);
 
  private:
   static bool learning_midi_channel_;
   static bool seen_midi_drum_events_;
+  static volatile uint8_t tx_tick_;
+  static volatile uint8_t clock_latency_min_;
+  static volatile uint8_t clock_latency_max_;
    
   static void Send(uint8_t status, uint8_t* data, uint8_t size);
   static void SendNow(uint8_t byte);
@@ -60,6 +60,7 @@ uint8_t Parameter::Unscale(uint8_t value) const {
       }
     }
   }
+  return 0;
 }
 
 typedef Parameter PROGMEM prog_Parameter;
@@ -100,7 +101,8 @@ static const prog_uint8_t cc_map[116] PROGMEM = {
   // 80 to 87
   0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
   // 88 to 95
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
+  PARAMETER_SEQUENCE, PARAMETER_SEQUENCE_CHAIN,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
   // 96 to 103
   0xff, 0xff, 0xff, 0xff, 0xff, 0xff, PARAMETER_DRUMS_X, PARAMETER_DRUMS_Y, 
   // 104 to 111
@@ -157,7 +159,8 @@ static const prog_Parameter parameters[PARAMETER_LAST] PROGMEM = {
   { PARAMETER_DOMAIN_PATCH, PRM_PATCH_VCO_DETUNE, UNIT_QUANTIZED_PITCH, 0, 0 },
 
   // PARAMETER_VCO_FINE
-  { PARAMETER_DOMAIN_PATCH, PRM_PATCH_VCO_FINE, UNIT_INT8, -32, 32 },
+  { PARAMETER_DOMAIN_PATCH, PRM_PATCH_VCO_FINE, UNIT_INT8,
+    static_cast<uint8_t>(-32), 32 },
   
   // PARAMETER_LFO_SHAPE
   { PARAMETER_DOMAIN_PATCH, PRM_PATCH_LFO_SHAPE, UNIT_UINT8,
@@ -200,10 +203,12 @@ static const prog_Parameter parameters[PARAMETER_LAST] PROGMEM = {
   { PARAMETER_DOMAIN_SEQUENCER, PRM_SEQ_ARP_ACIDITY, UNIT_UINT8, 0, 15 },
 
   // PARAMETER_VCO_DCO_RANGE
-  { PARAMETER_DOMAIN_PATCH, PRM_PATCH_VCO_DCO_RANGE, UNIT_INT8, -2, 2 },
+  { PARAMETER_DOMAIN_PATCH, PRM_PATCH_VCO_DCO_RANGE, UNIT_INT8,
+    static_cast<uint8_t>(-2), 2 },
 
   // PARAMETER_VCO_DCO_FINE
-  { PARAMETER_DOMAIN_PATCH, PRM_PATCH_VCO_DCO_FINE, UNIT_INT8, -127, 127 },
+  { PARAMETER_DOMAIN_PATCH, PRM_PATCH_VCO_DCO_FINE, UNIT_INT8,
+    static_cast<uint8_t>(-127), 127 },
 
   // PARAMETER_VELOCITY_MOD
   { PARAMETER_DOMAIN_PATCH, PRM_PATCH_KBD_VCF_VELOCITY_AMOUNT, UNIT_CROSSFADE,
@@ -251,6 +256,14 @@ static const prog_Parameter parameters[PARAMETER_LAST] PROGMEM = {
   // PARAMETER_DRUMS_BANDWIDTH
   { PARAMETER_DOMAIN_SEQUENCER, PRM_SEQ_DRUMS_BANDWIDTH, UNIT_RAW, 0, 0 },
   
+  // PARAMETER_SEQUENCE
+  { PARAMETER_DOMAIN_SEQUENCER, PRM_SEQ_SEQUENCE, UNIT_UINT8,
+    0, kNumSequences - 1 },
+
+  // PARAMETER_SEQUENCE_CHAIN
+  { PARAMETER_DOMAIN_SEQUENCER, PRM_SEQ_SEQUENCE_CHAIN, UNIT_UINT8,
+    1, kNumSequences },
+  
   // PARAMETER_UNASSIGNED,
   { PARAMETER_DOMAIN_SEQUENCER, 0, UNIT_RAW, 0, 0 },
 };
@@ -310,6 +323,7 @@ uint8_t ParameterManager::GetValue(const Parameter& p) {
   } else if (p.domain == PARAMETER_DOMAIN_SEQUENCER) {
     return voice_controller.GetValue(p.offset);
   }
+  return 0;
 }
 
 /* extern */
@@ -86,6 +86,9 @@ enum Parameters {
   PARAMETER_DRUMS_BALANCE,
   PARAMETER_DRUMS_BANDWIDTH,
   
+  PARAMETER_SEQUENCE,
+  PARAMETER_SEQUENCE_CHAIN,
+  
   PARAMETER_UNASSIGNED,
   PARAMETER_LAST
 };
@@ -39,66 +39,41 @@ const prog_uint16_t lut_res_glide_increments[] PROGMEM = {
     6666,   6363,   6075,   5801,   5541,   5293,   5058,   4834,
     4621,   4418,   4225,   4042,   3867,   3700,   3541,   3390,
     3245,   3108,   2977,   2852,   2732,   2618,   2510,   2406,
-    2307,   2212,   2122,   2036,   1953,   1875,   1799,   1727,
-    1658,   1593,   1530,   1469,   1412,   1356,   1304,   1253,
-    1205,   1158,   1114,   1071,   1031,    992,    954,    918,
-     884,    851,    819,    789,    760,    732,    705,    679,
-     654,    631,    608,    586,    565,    545,    525,    507,
-     489,    472,    455,    439,    424,    409,    395,    381,
-     368,    355,    343,    332,    320,    310,    299,    289,
-     279,    270,    261,    252,    244,    236,    228,    221,
-     214,    207,    200,    193,    187,    181,    175,    170,
-     164,    159,    154,    149,    145,    140,    136,    131,
-     127,    123,    120,    116,    112,    109,    106,    102,
-      99,     96,     93,     91,     88,     85,     83,     80,
-      78,     75,     73,     71,     69,     67,     65,     63,
-      61,     60,     58,     56,     55,     53,     51,     50,
-      49,     47,     46,     45,     43,     42,     41,     40,
-      39,     38,     37,     36,     35,     34,     33,     32,
-      31,     30,     29,     28,     28,     27,     26,     25,
-      25,     24,     23,     23,     22,     22,     21,     21,
-      20,     19,     19,     18,     18,     17,     17,     17,
-      16,     16,     15,     15,     15,     14,     14,     13,
-      13,     13,     12,     12,     12,     11,     11,     11,
-      11,     10,     10,     10,     10,      9,      9,      9,
-       9,      8,      8,      8,      8,      8,      7,      7,
-       7,      7,      7,      7,      6,      6,      6,      6,
-       6,      6,      5,      5,      5,      5,      5,      5,
-       5,      5,      4,      4,      4,      4,      4,      4,
+    2307,  65441,  21557,   9268,   8769,  16640,   1205,  65489,
+   12593,   4641,   4625,   4352,    654,  65513,    273,    513,
+     272,   4096,    368,  65523,   4594,  61697,     16,    256,
+     214,  65529,     16,    497,     31,   7936,    127,  65532,
+    7937,   3856,    496,   7936,     78,  65533,   4096,      1,
+   61471,    256,     49,  65534,   4337,      0,      0,      0,
+      31,  65535,     31,     31,    497,  61696,     20,  65535,
+    7967,   4337,  61711,   7936,     13,      0,  61711,   4111,
+    4111,   4096,      9,  65535,   4096,  61696,    241,      0,
+       6,      0,  61696,      0,  61696,      0,
+};
+const prog_uint16_t lut_res_glide_increments_blocks[] PROGMEM = {
+       0,     16,     32,  32816,  32822,  32828,  32834,  32840,
+   32846,  32852,  32858,  32864,  32870,  32876,  32882,  32888,
 };
 const prog_uint16_t lut_res_drm_env_increments[] PROGMEM = {
    16383,  15179,  14082,  13083,  12171,  11337,  10574,   9873,
     9230,   8638,   8093,   7590,   7126,   6696,   6299,   5930,
     5588,   5271,   4975,   4700,   4444,   4205,   3982,   3773,
     3578,   3396,   3225,   3064,   2913,   2772,   2639,   2514,
-    2396,   2285,   2180,   2082,   1989,   1901,   1817,   1739,
-    1664,   1594,   1527,   1463,   1403,   1346,   1292,   1240,
-    1191,   1145,   1101,   1058,   1018,    980,    943,    909,
-     875,    844,    813,    784,    757,    730,    705,    681,
-     657,    635,    614,    593,    574,    555,    537,    520,
-     503,    487,    472,    457,    443,    429,    416,    404,
-     392,    380,    369,    358,    347,    337,    328,    318,
-     309,    301,    292,    284,    276,    269,    261,    254,
-     247,    241,    235,    228,    222,    217,    211,    206,
-     200,    195,    190,    186,    181,    177,    172,    168,
-     164,    160,    156,    152,    149,    145,    142,    139,
-     135,    132,    129,    126,    123,    121,    118,    115,
-     113,    110,    108,    106,    103,    101,     99,     97,
-      95,     93,     91,     89,     87,     85,     83,     82,
-      80,     78,     77,     75,     74,     72,     71,     69,
-      68,     67,     66,     64,     63,     62,     61,     59,
-      58,     57,     56,     55,     54,     53,     52,     51,
-      50,     49,     48,     48,     47,     46,     45,     44,
-      43,     43,     42,     41,     41,     40,     39,     38,
-      38,     37,     37,     36,     35,     35,     34,     34,
-      33,     32,     32,     31,     31,     30,     30,     29,
-      29,     28,     28,     28,     27,     27,     26,     26,
-      25,     25,     25,     24,     24,     24,     23,     23,
-      23,     22,     22,     22,     21,     21,     21,     20,
-      20,     20,     19,     19,     19,     19,     18,     18,
-      18,     18,     17,     17,     17,     17,     16,     16,
-      16,     16,     15,     15,     15,     15,     15,     14,
-      14,     14,     14,     14,     13,     13,     13,     13,
+    2396,  65425,  26453,  17973,  13123,  12800,   1191,  65490,
+    8498,   4867,    544,   8448,    657,  65514,   4128,   4353,
+    4112,   4352,    392,  65524,   4097,   7953,  61697,  61696,
+     247,  65530,   3857,  61937,    497,  61696,    164,  65532,
+      31,   4337,      1,  61440,    113,  65533,   4337,      0,
+       0,    256,     80,  65534,   7967,   7952,   3856,   3840,
+      58,  65535,      0,      0,    496,      0,     43,      0,
+   61471,     31,   7937,  61696,     33,  65535,   7967,   7967,
+    4337,  61696,     25,      0,   3856,  61711,   4337,   3840,
+      20,      0,  61696,  61696,  61696,  61696,     16,      0,
+   61696,   3856,    241,      0,
+};
+const prog_uint16_t lut_res_drm_env_increments_blocks[] PROGMEM = {
+       0,     16,  32800,  32806,  32812,  32818,  32824,  32830,
+   32836,  32842,  32848,  32854,  32860,  32866,  32872,  32878,
 };
 const prog_uint16_t lut_res_drm_phase_increments[] PROGMEM = {
       12,     12,     13,     13,     14,     14,     14,     15,
@@ -150,6 +125,29 @@ const prog_uint16_t lut_res_dco_pitch[] PROGMEM = {
    32141,  31910,  31680,  31452,  31226,  31002,  30779,  30557,
    30337,
 };
+const prog_uint16_t lut_res_env_coefficients[] PROGMEM = {
+   48261,  46188,  44107,  42036,  39991,  37985,  36030,  34134,
+   32305,  30545,  28860,  27251,  25718,  24261,  22879,  21571,
+   20334,  19166,  18065,  17027,  16050,  15131,  14267,  13454,
+   12691,  11974,  11300,  10667,  10073,   9515,   8990,   8498,
+    8035,   7600,   7192,   6807,   6446,   6107,   5787,   5486,
+    5203,   4937,   4686,   4449,   4226,   4016,   3817,   3630,
+    3453,   3286,   3129,   2980,   2839,   2706,   2580,   2460,
+    2347,   2240,   2139,   2043,   1952,   1865,   1783,   1706,
+    1632,  65465,  21059,   9010,   8738,   8704,    837,  65504,
+    4385,   4610,    288,   4096,    459,  65520,   4112,   4352,
+    4112,   4096,    267,  65527,   4127,   4112,      1,  61696,
+     162,  65532,  61937,     31,    256,      0,    103,  65533,
+     497,  61696,      0,      0,     67,  65535,  61471,   7952,
+   61696,   3840,     45,  65535,      0,     31,      1,  61440,
+      31,      0,  61471,    497,  61937,  61696,     22,      0,
+   61937,   3871,   4337,   3840,     16,      0,  61711,   4111,
+    4111,   4096,     12,      0,  61696,  61696,    241,      0,
+};
+const prog_uint16_t lut_res_env_coefficients_blocks[] PROGMEM = {
+       0,     16,     32,     48,  32832,  32838,  32844,  32850,
+   32856,  32862,  32868,  32874,  32880,  32886,  32892,  32898,
+};
 const prog_uint16_t lut_res_env_expo[] PROGMEM = {
        0,   1035,   2054,   3057,   4045,   5018,   5975,   6918,
     7846,   8760,   9659,  10545,  11416,  12275,  13120,  13952,
@@ -186,28 +184,28 @@ const prog_uint16_t lut_res_env_expo[] PROGMEM = {
    65535,
 };
 const prog_uint16_t lut_res_groove_swing[] PROGMEM = {
-     127,    127,   -127,   -127,    127,    127,   -127,   -127,
-     127,    127,   -127,   -127,    127,    127,   -127,   -127,
+     127,    127,  65409,  65409,    127,    127,  65409,  65409,
+     127,    127,  65409,  65409,    127,    127,  65409,  65409,
 };
 const prog_uint16_t lut_res_groove_shuffle[] PROGMEM = {
-     127,   -127,    127,   -127,    127,   -127,    127,   -127,
-     127,   -127,    127,   -127,    127,   -127,    127,   -127,
+     127,  65409,    127,  65409,    127,  65409,    127,  65409,
+     127,  65409,    127,  65409,    127,  65409,    127,  65409,
 };
 const prog_uint16_t lut_res_groove_push[] PROGMEM = {
-     -63,    -63,    127,      0,   -127,      0,      0,     88,
-       0,      0,     88,    -50,    -88,      0,     88,      0,
+   65473,  65473,    127,      0,  65409,      0,      0,     88,
+       0,      0,     88,  65486,  65448,      0,     88,      0,
 };
 const prog_uint16_t lut_res_groove_lag[] PROGMEM = {
-      19,     44,     93,     -4,     32,    -53,    -90,   -127,
-     117,     32,   -102,    -53,    105,    -53,     93,    -53,
+      19,     44,     93,  65532,     32,  65483,  65446,  65409,
+     117,     32,  65434,  65483,    105,  65483,     93,  65483,
 };
 const prog_uint16_t lut_res_groove_human[] PROGMEM = {
-      88,   -101,    107,    -95,     88,    -88,     50,    -38,
-      65,    -88,    101,    -95,    101,   -127,     63,    -31,
+      88,  65435,    107,  65441,     88,  65448,     50,  65498,
+      65,  65448,    101,  65441,    101,  65409,     63,  65505,
 };
 const prog_uint16_t lut_res_groove_monkey[] PROGMEM = {
-      70,    -84,     84,   -112,     84,    -98,    112,    -98,
-      54,    -70,    127,    -84,    127,   -112,     84,    -84,
+      70,  65452,     84,  65424,     84,  65438,    112,  65438,
+      54,  65466,    127,  65452,    127,  65424,     84,  65452,
 };
 const prog_uint16_t lut_res_arpeggiator_patterns[] PROGMEM = {
    21845,  62965,  30583,  21065,  27499,  28527,
@@ -219,6 +217,7 @@ const prog_uint16_t* lookup_table_table[] = {
   lut_res_drm_env_increments,
   lut_res_drm_phase_increments,
   lut_res_dco_pitch,
+  lut_res_env_coefficients,
   lut_res_env_expo,
   lut_res_groove_swing,
   lut_res_groove_shuffle,
@@ -339,13 +338,13 @@ const prog_uint8_t wav_res_deadband[] PROGMEM = {
      233,    236,    239,    242,    245,    248,    252,    255,
 };
 const prog_uint8_t wav_res_pitch_deadband[] PROGMEM = {
-     -12,    -12,    -12,    -12,    -12,    -12,    -12,    -12,
-     -12,    -12,    -12,    -12,    -12,    -12,    -12,    -12,
-     -12,    -12,    -12,    -12,    -12,    -11,    -11,    -11,
-     -10,    -10,    -10,     -9,     -9,     -9,     -8,     -8,
-      -8,     -8,     -7,     -7,     -7,     -6,     -6,     -6,
-      -5,     -5,     -5,     -4,     -4,     -4,     -4,     -3,
-      -3,     -3,     -2,     -2,     -2,     -1,     -1,     -1,
+     244,    244,    244,    244,    244,    244,    244,    244,
+     244,    244,    244,    244,    244,    244,    244,    244,
+     244,    244,    244,    244,    244,    245,    245,    245,
+     246,    246,    246,    247,    247,    247,    248,    248,
+     248,    248,    249,    249,    249,    250,    250,    250,
+     251,    251,    251,    252,    252,    252,    252,    253,
+     253,    253,    254,    254,    254,    255,    255,    255,
        0,      0,      0,      0,      0,      0,      0,      0,
        0,      0,      0,      0,      0,      0,      0,      0,
        0,      0,      0,      0,      0,      0,      0,      0,
@@ -443,519 +442,521 @@ const prog_uint8_t wav_res_sine[] PROGMEM = {
        3,
 };
 const prog_uint8_t wav_res_hh[] PROGMEM = {
-       4,    251,    116,     27,     13,     41,    158,    245,
-       7,    208,    236,     18,    233,    240,    248,    226,
-       0,      0,     43,    236,    188,    245,     13,    237,
-     199,    237,    163,    199,     39,    240,    246,    248,
-     251,      7,    223,      3,     23,    250,     31,     18,
-      11,    237,    199,     48,    253,    224,    234,     26,
-      35,    250,     60,    198,    220,     14,     13,     63,
-     254,    227,    235,    254,     27,     10,    181,      3,
-      88,    245,     22,     57,     83,     16,    240,     16,
-      16,     19,     13,     69,     14,    231,    242,      9,
-     249,    227,     18,     12,    217,    232,     38,    206,
-       9,     69,    216,    227,    223,     16,    217,    215,
-       7,    200,    189,    190,    202,    243,    252,    231,
-      19,    199,    207,    246,    246,     44,      1,    201,
-     205,     26,    249,    211,    228,     26,      7,    224,
-      31,      1,    211,    244,     64,     60,    246,    240,
-      54,     88,     22,    246,      4,      6,     21,     10,
-       2,    232,     13,     24,     47,     48,    225,     86,
-     244,    244,     53,     16,    249,    209,     64,     43,
-     220,    156,    225,     79,      3,    203,    251,    239,
-     199,     64,     10,    172,      5,    228,    147,    161,
-     244,    231,    219,    189,    227,    239,    128,    206,
-     209,    182,    228,    236,     19,    215,     14,     27,
-      29,     16,      3,    244,    252,     67,      3,     58,
-     253,     70,    246,    224,     82,    200,     33,     54,
-      16,    249,    219,     30,      4,    218,    223,    241,
-      87,    237,    208,     18,     16,     81,     23,     12,
-     217,    211,      5,    212,    244,    173,    215,     71,
-     210,    229,    242,    174,      7,     78,    234,    164,
-     184,    251,     72,    218,    209,     46,      7,    246,
-      10,    226,    164,     16,     23,    189,    232,     26,
-      24,    235,     32,      2,     27,     47,    181,     31,
-      58,    244,    243,    214,     74,     53,    164,    244,
-      23,     73,     14,    244,     41,    253,      4,    152,
-     206,     45,    240,    216,    176,    201,    248,     19,
-      21,    195,    253,     50,    234,    251,    254,    214,
-     227,    231,    251,    225,    164,    152,    248,     32,
-      30,     27,    207,    241,    239,     27,     24,     41,
-      90,     18,     23,      3,    218,    239,     86,      4,
-     216,    201,    186,     64,    236,    220,     16,    219,
-     251,     71,    205,    135,    167,     19,    108,    215,
-     237,    249,    168,     61,     86,    217,    219,    252,
-      74,     14,    182,     37,     52,    253,    229,    212,
-     216,    220,      1,     10,    237,    227,    241,      3,
-     249,    217,     12,     46,    252,    243,    223,    229,
-     216,    250,     24,    195,    195,    223,     41,     14,
-     197,     39,    242,      6,     33,    211,     19,     14,
-       0,     13,    232,    215,    242,    253,     60,    228,
-     186,     24,     61,     20,    183,    182,    243,      4,
-     251,    233,    235,     20,    233,     11,     26,    246,
-     183,    240,     18,    227,     96,    228,    152,     87,
-      70,    205,    219,    216,      2,     15,    228,    225,
-       2,     23,    226,    253,     26,    232,    195,     37,
-      28,      6,    240,    225,     35,     22,     12,    228,
-     214,    245,    246,    210,      4,    235,    212,     37,
-     248,    236,     15,    248,    243,      4,    253,      1,
-      14,    249,    248,     55,     11,    195,    233,      5,
-     245,    206,    248,    251,    226,    248,    240,    223,
-       5,    229,     11,     20,    194,    243,    252,    246,
-     201,     61,     55,    222,      9,    151,    210,     35,
-     218,    237,    231,      3,     33,    232,    218,    240,
-      37,    252,    250,     86,    228,    158,     13,     20,
-     250,    198,      9,     70,    223,      4,     21,    235,
-      24,    244,    176,     35,     33,    228,    248,      4,
-     234,    232,     16,    223,    251,     28,      1,     27,
-     231,    212,     13,     11,    214,    202,     61,      9,
-     167,    202,    233,    209,     11,     19,    206,    203,
-     200,    240,     21,      1,    229,     62,      9,    225,
-     254,    239,    202,      9,     74,    216,    185,    201,
-      40,    222,      0,     98,    233,    216,     23,     27,
-     242,     11,     21,     16,      1,    193,     10,     78,
-      15,    249,    231,      5,     11,    214,    240,      5,
-     224,      3,    240,    233,    244,    195,    200,     41,
-     240,    194,    239,    224,     83,    245,    161,    233,
-       5,     14,    253,    220,    232,     20,     60,     15,
-     146,    203,    243,     19,    231,    220,     28,    254,
-      12,     73,     23,    177,      7,     26,     23,     54,
-       3,    206,    236,    254,    254,    219,    191,     16,
-      18,    218,      1,    228,    206,     27,    243,    210,
-     203,    227,      5,    228,    226,    252,    227,    254,
-      19,    214,    241,    248,     36,     46,    207,    220,
-      20,    220,    190,     11,    248,    240,     50,     60,
-     202,    223,    243,    245,     21,    229,     57,     29,
-      15,     38,      4,      9,    251,    233,     10,    248,
-     190,    241,     32,      4,    200,    236,    220,      0,
-      90,    245,    156,    217,     30,     13,    209,    200,
-     220,    248,     54,      9,    201,    193,     26,     52,
-     220,    183,    218,      4,      7,    243,    216,    232,
-     245,     46,      4,    214,     29,     29,      0,     66,
-      30,    214,    227,     20,     46,    237,    229,     48,
-      40,    229,    252,    211,    237,    240,    251,     39,
-     205,    203,    220,      7,    232,    191,     13,      9,
-     215,    253,    244,    220,     27,    250,      6,      4,
-     217,      0,    253,     37,    241,    212,      3,     18,
-      33,    211,    167,      0,     37,    248,    240,    249,
-      10,     46,     31,    239,    248,    226,    246,    248,
-     227,     28,    235,    232,    250,    240,     15,    231,
-     243,    245,      2,     11,    192,    212,     26,    217,
-     235,     22,    191,     32,      6,    178,     16,     45,
-      19,    232,    242,    226,    236,      0,    192,     33,
-      77,    214,    237,    252,    229,    254,    215,    243,
-      37,    250,    239,      9,     52,     12,    218,    242,
-       9,     23,     39,    208,    234,     29,    200,    253,
-       9,    237,    224,     46,      6,    215,     31,    251,
-      35,    214,    224,    244,    169,    231,     26,     19,
-     239,    241,    227,     15,     16,    219,    240,    253,
-       4,    228,     16,     21,    177,      5,     31,    215,
-     246,    231,    246,     43,    251,    235,      2,      0,
-      20,     31,     23,     58,    246,    207,     62,    228,
-     226,      5,    218,     22,    232,    234,    223,    245,
-      53,    241,    212,    254,    220,    216,    241,    233,
-      16,    228,    197,    253,     38,    227,    231,     19,
-      28,     26,    209,    243,     32,    246,    225,    241,
-       6,     11,    249,    254,    228,     27,      3,    211,
-       1,    245,     26,      3,     11,    214,    217,     50,
-     245,    237,     53,     21,    237,     19,    233,    246,
-     232,    210,     13,    253,    229,    234,    245,    232,
-     233,    245,     20,    227,    245,     12,    241,      2,
-     228,    242,     45,     10,    254,     26,    216,    248,
-      26,     13,    233,    186,    251,    248,    244,    242,
-     201,     16,    254,      7,    245,    192,    228,      4,
-      19,    222,     21,     21,     19,      1,    235,     74,
-     215,    215,     66,    242,    228,     23,    242,    254,
-     249,    242,    234,    234,     38,    240,    254,     49,
-     224,    246,      0,    242,    216,    212,     67,    228,
-     210,     67,     21,    234,    253,    236,    222,     32,
-     248,    194,     48,    246,    207,     22,    249,    194,
-     199,     44,     36,    249,     18,    220,    244,     57,
-     227,     18,    243,    227,     71,    205,    249,     13,
-     193,    186,    210,     26,    251,     16,    249,    254,
-      41,    205,    217,     56,      5,    211,    249,      3,
-       0,    232,     24,    237,    237,     31,    244,     24,
-      18,     10,    245,     46,    252,    194,    252,    220,
-     250,     10,     18,    245,    228,      3,     30,    249,
-     215,     19,     31,     12,    182,    231,    248,    239,
-       4,    215,     19,     10,    220,     18,     39,    236,
-     241,     19,     14,    226,      7,     29,     14,      2,
-     197,    244,    237,    237,      5,      7,     66,     10,
-      11,    239,    232,     56,    237,    244,     20,    235,
-     205,    244,      1,    233,      2,    205,    209,     23,
-       4,     16,     64,     19,      7,    235,    246,    236,
-     208,      7,    220,      5,    237,    210,     28,    253,
-       5,     14,    231,     31,     21,     12,     53,    219,
-     223,      0,     10,    243,    228,     28,      6,    236,
-     250,      7,    231,    216,     30,     50,    248,    235,
-     198,     16,     45,    210,    236,    232,    225,    254,
-       9,    245,     26,     52,    227,    227,     44,     13,
-     233,      7,     24,    245,    240,    237,    203,      1,
-      14,    207,    237,     18,     33,     33,    251,    249,
-     252,      0,    243,    241,     32,    225,      2,     24,
-     217,    225,    240,      2,     22,     32,    251,      6,
-     249,     14,    252,    243,    253,      6,     14,      2,
-      22,    240,      9,    248,    240,    225,    236,     27,
-     248,      2,      4,    229,      1,      5,    208,    243,
-     245,    214,    220,    224,      5,      2,    227,    240,
-     245,     16,      7,     14,     20,     21,     52,    248,
-     216,    250,    253,    237,     32,     26,      3,     11,
-     218,    236,     15,     18,     28,     26,     21,      7,
-     250,      3,     24,    245,    209,    242,     20,    244,
-     236,    239,      4,    254,    222,    214,    211,     16,
-      27,     15,    239,    254,      2,    216,    243,      0,
-     246,     21,    251,    216,     29,     35,     10,    250,
-      15,     20,    216,    237,      3,    242,    251,     30,
-     245,    218,    234,      1,     24,      5,      3,     10,
-      29,    239,      6,     45,    242,     19,     35,    252,
-     223,      9,    253,    253,      5,    226,      6,     10,
-      18,    244,    235,     26,      0,    242,      1,    226,
-       1,     33,    248,    228,    236,    231,    233,      5,
-      22,    246,     15,    243,    235,      2,    243,    244,
-     203,      7,      5,    234,    222,    249,     41,     22,
-       3,    249,      2,    249,     31,     12,      6,     54,
-      29,    252,    239,     18,    253,    194,    248,     40,
-     246,    239,    244,     10,     20,    237,    248,     11,
-      14,     11,      7,    220,    240,      3,    231,      9,
-     249,      6,    244,      1,      5,    212,     11,      2,
-      10,     19,    232,    242,    232,    235,     38,    227,
-     231,     33,    248,     21,     21,    235,      4,     39,
-     252,    253,      9,      1,      6,    249,      6,    227,
-       4,      2,    236,    250,    227,    253,     10,    239,
-     248,     20,      6,      6,      7,    244,    239,    250,
-      14,    254,      7,     13,    218,    244,      2,    239,
-      10,     11,      2,    251,    218,    223,    253,     14,
-      13,    237,     28,     10,    233,     19,      0,    251,
-       7,     43,     10,      7,    245,    251,     10,    246,
-      24,    234,    234,     18,      7,    237,      4,      3,
-       3,      4,     31,    252,    236,     16,    222,     14,
-     245,    240,     15,    236,    246,    224,      3,      9,
-     235,     18,    246,    224,      1,     11,      1,    231,
-      13,     20,    252,      2,      3,     14,      4,    242,
-      14,     43,      5,    222,      1,     36,      6,    227,
-     216,     21,     35,      0,    236,    233,    253,    252,
-       6,    249,    249,     35,     16,      9,      2,    232,
-       3,     13,    246,    251,      5,    222,    252,     33,
-     248,    232,    243,     19,     10,      1,    226,    250,
-      19,    236,    246,    236,    250,    251,    237,    244,
-     253,     32,     23,    236,     19,     27,    250,    244,
-     234,     16,     57,      4,    235,      7,    252,    250,
-      16,     13,     19,     15,      3,      1,    245,     27,
-     245,      0,    253,    220,      6,    244,    252,    242,
-     254,    250,    251,    250,    233,     20,     19,    232,
-       6,      7,    205,    242,      9,      1,     11,    251,
-     233,     20,     16,    251,      6,      5,    251,      3,
-      22,    216,    251,     55,    250,    248,    243,    245,
-      15,      3,     16,     16,      7,      0,     19,    252,
-     245,     22,      3,     30,      4,     12,    251,    225,
-       5,    252,    250,    223,      9,      7,    253,     13,
-     236,    249,    250,    227,      2,     11,      5,    245,
-     233,     18,    244,    234,    239,     15,     39,    232,
-     249,      3,    250,     22,      3,    239,      1,    254,
-       2,      6,      6,      9,     12,      4,    246,      9,
-       9,      2,     20,     18,      3,      5,     20,     12,
-     243,      3,    232,      6,     12,      1,     23,    254,
-       4,    253,    243,    240,    249,    250,     24,    250,
-     237,    235,    224,      9,    249,    254,    253,    249,
-      11,     20,    250,    235,      6,      3,    248,     23,
-       4,    224,    252,     32,     15,    232,    240,      0,
-      31,     27,      6,    250,      4,      7,     13,      2,
-     226,     10,     26,      2,    251,     18,    248,    242,
-     239,    240,      3,    246,    245,     21,     20,      5,
-     243,    243,     21,    243,    233,    242,     27,     27,
-     253,    252,    250,      3,    246,      0,     11,     18,
-       3,      5,      9,      1,    229,    236,    241,    249,
-       5,    253,     14,    243,     23,    251,    243,     29,
-       0,     18,    251,    252,      6,    251,     11,    244,
-     252,     10,      5,     29,    244,      5,     18,    253,
-      28,    241,    228,    253,      1,     28,     15,    246,
-       0,    244,    246,      4,    237,    239,     26,      4,
-       7,    254,    228,      0,      3,      4,    223,    240,
-      12,     23,     31,    249,    226,    244,     14,      4,
-       9,      5,     27,     24,      0,    241,    235,    252,
-     250,     16,     14,      0,    254,      7,      6,    250,
-       3,    245,     10,      2,    240,    254,     10,     16,
-       0,    235,    217,     19,     18,    237,     16,      9,
-     252,     12,    243,    235,      5,    244,     12,     27,
-       5,      3,     12,      4,    249,    251,    242,      9,
-       5,     12,     19,    240,      6,    251,    246,    252,
-     234,     11,      4,      3,      1,    251,      5,    235,
-     254,      7,    250,      4,      2,    252,     33,     26,
-     232,    254,      4,    249,     18,     20,      0,      3,
-      11,      9,     11,    248,    239,      3,    253,    253,
-       0,    240,    253,     12,    243,    225,      5,     33,
-       0,      9,     24,    240,      3,    245,    232,      2,
-     251,      4,     18,     14,    254,     12,    241,    251,
-       9,    229,     10,     22,     10,      5,     20,      1,
-     254,     13,    253,    248,     15,     23,      2,    241,
-     225,      4,    239,    235,    240,    248,     16,    254,
-       4,     18,      4,    223,    251,      0,    249,     31,
-       6,      4,     21,    244,    244,      9,      6,    252,
-      29,     16,    249,      4,    229,    254,     13,    248,
-       7,      6,    248,     20,     21,    242,    228,    250,
-     252,      3,     12,      3,      1,      2,     24,    249,
-     243,    245,    253,     10,      5,    252,    248,     21,
-     254,      1,      3,    249,    252,      7,     22,     12,
-       5,    252,    249,      1,    243,    236,    244,      1,
-      44,     10,    233,      2,     13,     14,    252,    244,
-     248,     19,     27,    249,    248,     11,    248,    246,
-      23,     15,      2,      1,      9,      2,    246,    237,
-     242,     19,    254,    228,     21,     21,      3,    239,
-     231,      6,     10,      5,    248,    243,     10,     23,
-     253,      9,    248,    241,     13,      1,     16,    248,
-     244,     13,    250,     12,      5,    248,      7,     10,
-      30,     26,      5,      3,      3,    254,    246,    245,
-       5,     20,    254,     22,      5,    232,    252,      3,
-       5,    239,    249,    237,    253,     12,    229,    226,
-     240,     21,     16,    248,    246,      2,     14,      6,
-       3,      2,    235,      1,     32,     11,      4,    248,
-       3,     26,      5,    237,      3,     31,     11,    243,
-       5,     21,     13,      4,    244,    248,      2,    253,
-      19,      7,    243,    254,    252,      2,    252,    244,
-     248,     19,     26,      3,    249,    242,      3,      5,
-       1,    228,    244,      3,      4,     18,    246,    254,
-     253,    252,    253,      1,      5,     15,      9,    252,
-     251,    225,    250,     14,     14,      4,    254,      4,
-     249,     15,     11,      4,      4,     12,     11,      5,
-       7,     13,     16,     12,      6,    241,    251,    244,
-       0,      7,      2,     11,    252,     10,    245,    242,
-      20,     14,      0,    249,    254,    254,      5,    240,
-     234,    248,    240,    249,      1,      5,     10,    254,
-       3,     18,      0,    236,      1,     14,    250,      1,
-      13,    249,      3,     10,     13,     13,      9,      9,
-       4,      2,      1,      5,    234,    252,     22,     19,
-       7,    246,    253,    252,      3,    244,    250,     19,
-       3,    251,    253,      2,      5,      5,      7,    250,
-     233,    241,      0,     18,      3,    250,     10,    251,
-     251,    252,     12,      9,     11,     36,      6,      0,
-       1,    249,    254,    248,    249,    253,    251,      3,
-      13,      6,      3,    243,      3,      6,    248,      7,
-       3,      6,      6,    242,    241,      4,     10,      3,
-      10,     19,    250,    254,     14,    250,      9,      9,
-     250,    250,      7,      9,    251,      1,    234,      0,
-       1,    241,      2,      0,      7,      3,     18,     11,
-     250,    251,    248,     13,      3,      3,     14,      6,
-       3,      6,      4,    248,    243,     13,     15,     14,
-      13,    248,      2,    249,    244,      4,     10,      5,
-     250,     19,      7,    245,      2,    243,      7,      5,
-     244,      2,      2,    239,      0,     13,    240,    243,
-     251,      1,    252,      6,      6,    248,    252,      0,
-      18,      5,    249,      5,     23,     14,    252,    253,
-      18,      3,      1,     13,      0,      3,      9,     11,
-       6,    240,    240,     14,    253,      2,      7,      3,
-       3,      3,      1,    242,    239,    248,     12,    249,
-     252,      9,      9,      4,    235,    242,      0,      4,
-       4,     18,      1,    252,     10,    245,    252,     10,
-     253,      9,     23,      9,      4,     20,      6,    249,
-       5,      4,    243,    250,      6,      5,      9,    239,
-     249,     14,    236,    233,      4,      5,      5,     12,
-       2,      9,    252,      2,     20,    253,      1,     10,
-      12,      7,      4,    251,    249,    240,      6,     19,
-     250,    251,    253,      9,     11,    250,    234,    253,
-       5,      6,      0,      3,      9,    241,      4,      3,
-     249,      6,      2,     14,     19,    244,    250,      2,
-     243,      9,      4,    252,      7,      9,     10,    253,
-       0,      5,      0,      7,    252,    254,     13,     10,
-       5,     12,    244,    240,      4,    252,    253,      0,
-       1,    254,    252,    237,    254,     13,    250,      0,
-      14,     15,      4,      5,      9,    254,    244,    252,
-      16,     10,    252,     11,     19,      9,    242,    243,
-       4,    250,      4,      2,    253,      0,    248,      9,
-       3,    251,    253,    253,     16,      3,      1,     13,
-       2,      3,      7,    248,    243,     10,      6,      4,
-      12,    251,    244,      0,    250,      3,      0,    254,
-      13,      9,     12,    254,      5,     10,    245,      9,
-       1,    248,     16,      1,      1,     21,    244,    236,
-     254,      7,      5,    248,      6,      1,    241,    237,
-     249,      6,    250,    249,     16,     14,      0,     12,
-      14,    253,    252,      3,     10,      7,    254,      0,
-      14,     12,    248,    244,    253,      2,     11,      5,
-      11,     10,    250,    253,      2,      2,    250,    253,
-      14,      3,    253,      6,    251,      0,      3,    241,
-       1,     10,      0,      2,      0,    250,      5,      1,
-     245,      3,     10,      3,      0,      6,    248,      6,
-       1,    253,     13,      2,     10,    254,     10,    253,
-     242,      9,    248,    252,      1,      3,     12,      6,
-      12,    250,    237,    244,      5,     16,      1,      3,
-      11,     14,     10,      3,      0,    251,    245,      5,
-       6,      3,     16,    252,      4,     14,    252,    244,
-     252,      0,      7,      6,    252,    252,    251,    246,
-     248,      2,    253,      4,      5,    251,    249,     13,
-       7,    245,     10,    253,    254,      0,    254,     16,
-       4,      3,    254,    254,      5,    249,      3,     11,
-       3,     16,      0,    249,      6,      4,      4,    251,
-       7,     18,    251,    248,    251,    250,      9,    251,
-     250,      6,      2,      1,      9,      5,      0,    248,
-     237,      2,      9,      4,      6,     12,      6,      1,
-     248,    248,      3,      6,     11,      7,      9,    252,
-       0,     10,    252,    246,      4,    245,    251,      5,
-     252,      2,      4,      0,    248,    249,      4,      9,
-     254,      6,      1,    251,    252,      2,     11,    251,
-     250,      1,      6,     11,      3,    248,     11,      1,
-       2,      2,    250,     23,      9,      4,      6,    240,
-     251,      7,      7,     12,      7,     13,    254,    253,
-       2,    248,      6,      2,    254,      4,    252,      2,
-       1,    253,    250,    244,    248,    253,     12,      0,
-     254,     12,      4,    253,    249,    253,      2,      6,
-       4,      4,      4,    254,    249,    254,      4,    254,
-       6,      3,    254,     14,      5,    248,      4,      1,
-     254,      0,      2,     15,      4,      2,      6,      2,
-     252,    250,      5,     12,      5,      4,      6,    248,
-       2,    250,    244,      3,    251,      6,      6,    254,
-       3,      4,      3,    252,    250,      3,      4,     18,
-       4,    241,      2,      3,    249,    245,      2,      5,
-     253,      2,    244,    250,     10,    254,    253,      0,
-       1,    254,      6,     10,      4,      6,    254,      4,
-       7,      1,     11,     14,      2,      5,      1,    253,
-       3,      3,    253,      1,      7,    254,      9,    254,
-     249,    253,    253,      9,    252,    248,      9,     16,
-       5,    248,    251,    254,    254,    252,    253,      2,
-     253,      2,      3,    245,      0,      7,    241,    250,
-      12,      1,      4,      1,      1,    254,    254,      4,
-       3,     14,      2,      3,      5,      3,      7,    254,
-       4,      4,      2,      1,      1,      1,      3,      3,
-       5,    249,    252,     13,      2,    254,      0,      6,
-       4,    254,      0,    252,      6,      1,    244,      5,
-       0,    252,      6,      0,      1,    251,    250,      7,
-       5,      0,      4,      5,    252,    243,      5,     10,
-     251,      0,    253,    253,      7,      4,    254,      5,
-       3,    254,      1,    250,      1,      5,    253,    254,
-     253,      0,      2,      0,      6,      4,      1,     10,
-       4,      6,      2,      1,     13,      6,    254,      0,
-       0,      5,      4,      0,    252,      2,    251,    249,
-       7,      0,      4,      7,    254,    246,    251,      3,
-       1,    254,    250,      5,      4,      0,    252,      7,
-       4,    253,      3,      5,      5,    242,    254,     10,
-     254,      2,    254,    245,      0,     11,      1,    248,
-      11,      9,    251,      7,      6,      2,      4,      5,
-     254,      6,      3,    249,      5,    253,      0,    253,
-     253,      5,      2,      3,    251,    254,    252,      5,
-       6,    252,      2,      0,      5,    253,    250,      1,
-       5,     11,    253,      1,     10,      0,      0,      5,
-       0,      0,    254,    242,      4,      7,    248,      0,
-       4,      0,    246,    252,      7,      4,      6,      5,
-     252,      5,      6,      3,    248,    254,     11,    253,
-       1,      1,      1,      5,      0,      0,      3,      3,
-       7,    253,    254,     13,    254,    249,      0,      4,
-       5,    254,    251,      1,      6,      0,    251,      1,
-       2,      0,      4,      1,    248,    254,      0,    245,
-     254,      0,      2,    254,      0,      7,      1,      2,
-       3,      5,      6,      1,      0,      9,     10,      0,
-       1,      0,    252,      4,      1,    249,    254,      9,
-       3,    250,      5,      4,      0,      6,      1,    252,
-       7,      0,    253,      4,    252,      1,    251,    254,
-       4,      6,      2,    252,    253,    254,    251,    253,
-       2,    254,      5,      0,    250,    254,      3,      7,
-       5,      0,      5,      0,    253,     10,      6,      5,
-     252,    245,    254,      5,      4,    250,      1,      7,
-     251,    250,    254,      5,      4,      5,      4,    254,
-       7,      2,      0,      3,      4,      0,    252,      2,
-       4,      2,    253,     10,      1,    245,    253,      1,
-       2,      4,      6,    250,    242,    252,      4,    251,
-       0,    254,      5,      4,    249,      4,      2,    253,
-     254,      6,      2,    254,      5,    253,    252,      4,
-       3,    254,      1,      3,      1,      4,      7,      1,
-       3,      3,    253,      5,      7,      2,      1,    254,
-     254,      0,     10,    253,    245,      3,      0,    251,
-     251,      1,      3,    254,    254,    250,    252,      4,
-     254,      1,      6,    253,    254,    254,      3,     12,
-       6,      0,      2,      4,    252,    253,      3,      1,
-       0,      4,      1,    253,      5,      2,      3,      2,
-     251,      1,      2,      0,      6,      6,      0,      2,
-     248,    251,      9,      6,    251,    253,      3,    254,
-     251,      0,      3,      2,    254,    249,      2,      3,
-     253,      0,      1,      4,      0,    254,      2,      0,
-       2,      0,      1,      0,    250,    253,      3,    254,
-     251,      4,      2,      0,      1,    254,      1,      1,
-       6,      6,      2,      1,      2,     10,      5,      5,
-     254,    248,      9,      7,    253,      0,      6,      3,
-     253,    254,      0,      0,      3,      5,    254,    251,
-     254,    253,      1,      3,    252,      0,    254,    250,
-     253,    251,      0,      4,    253,    252,      0,    251,
-     251,      1,      3,      4,    251,      3,      5,      3,
-       4,      3,      9,    254,    250,      5,     12,      5,
-     253,      1,      1,      3,      9,      1,      0,      1,
-     252,      2,      2,    253,      0,      1,      1,    254,
-       1,      0,    251,      4,      0,    252,      2,    254,
-       1,      1,    253,      0,    253,    253,    253,    254,
-       5,      1,      0,    253,    253,      3,      0,    254,
-       3,      2,    254,      2,    254,    254,      6,      4,
-       2,    251,    251,      3,      3,      4,      3,      3,
-       3,    252,      3,      6,    253,      2,      6,      1,
-       2,    252,    249,      2,      2,      5,      5,    253,
-     252,      2,      1,    251,      1,      2,    253,    253,
-       0,    253,      0,      0,    251,    253,      2,      0,
-     251,      4,      2,      1,    253,    249,      2,      3,
-     254,      0,      2,      2,      4,      3,      1,      2,
-       6,      4,    253,      3,      5,      4,      1,      1,
-       4,      2,      0,    254,      1,      1,      0,      2,
-       0,    254,    253,    253,      2,      1,      1,    253,
-     248,      1,      2,    254,    246,    246,      5,      9,
-     254,    251,      1,    254,      1,      2,    253,    253,
-       4,      2,      1,      1,    251,      0,      2,      3,
-       3,      4,      0,      3,     10,      1,    254,      3,
-       3,      4,      5,    248,    251,      6,      4,      3,
-       0,    254,    253,      1,      2,    254,    253,      0,
-       2,      1,    253,    251,      4,      0,      0,      7,
-     251,    251,      1,      2,      0,    251,      0,      2,
-       1,    252,    251,      3,      4,    252,    253,    254,
-       0,      2,      1,      1,      1,      3,      3,      1,
-     254,      2,      1,      0,      0,      1,      2,      1,
-       3,      5,      1,      0,      1,      2,      5,      4,
-     252,      3,      3,      1,    252,    249,      3,      3,
-       1,    254,    254,    254,    254,      0,    253,    254,
-     252,    254,      0,      0,      0,    251,    252,      4,
-       6,    254,    253,      2,      1,      3,    254,    252,
-       3,      4,      1,      1,      1,    254,      4,      3,
-     252,      0,    254,      0,      0,      2,      6,      0,
-       0,    254,      1,      3,      0,      1,      1,      1,
-       0,      1,    254,    253,      1,    252,    253,      3,
-       4,    254,    252,    254,      0,      4,    254,    251,
-       0,      1,      1,      0,    251,    251,      4,      1,
-     254,      4,      1,    254,      3,      1,      2,      2,
-       0,      2,      2,      1,      0,      4,      1,      0,
-       2,    254,      2,      5,      2,      0,      0,      3,
-       1,      1,      2,    253,    254,    254,    253,      3,
-       0,    253,    254,    254,    254,      2,      2,    253,
-       0,      1,    251,    251,    254,    254,    254,      0,
-     254,      0,      0,    253,      1,      2,      4,      2,
-     253,    253,      4,      4,      0,      1,      1,      3,
-       1,      2,      4,      1,      6,      3,    254,      0,
-       0,      1,      1,      0,    253,    254,      1,    253,
-       1,      1,    254,    254,      0,      2,    254,    254,
-       0,    254,      0,    254,      0,    254,    253,      2,
-       1,    254,    254,    253,    251,      1,      6,      0,
-       0,    254,    254,      2,      2,    253,    252,      1,
-       0,      3,      1,    253,      3,      1,      0,      4,
-       4,    254,      1,      2,    254,      0,    253,    254,
-       2,      2,      2,    254,    254,      2,      2,      1,
-     253,    254,      2,    252,      1,      1,    252,      0,
-       0,    254,      0,    253,      0,      2,      1,    254,
-     252,    252,      0,      2,      3,      0,    254,      3,
-       1,      1,      2,      0,      2,      2,    254,    254,
-       1,      2,      0,      0,    253,    253,      0,      1,
-       2,      2,      0,      0,      2,    253,    254,      1,
-       1,      0,    253,    253,    253,    254,    254,    254,
-     254,    252,      1,      4,      1,    252,    254,      6,
-       3,      1,    252,    253,      4,      3,      0,    250,
-     254,      2,      3,      3,      0,      3,      0,      1,
-       2,      0,    253,    253,      1,      0,    254,    252,
-     253,      4,      2,    254,    254,      0,      2,      2,
-       0,    254,      0,      1,      0,    253,    250,    254,
-       0,    254,      1,    254,      1,      0,    254,      0,
-       2,    254,      1,      4,      0,      2,    252,    252,
-       2,    253,    252,      3,      2,      2,      1,    252,
-       0,      3,      2,      2,    254,      0,      0,      1,
-     254,    252,      0,      1,      1,      2,      0,    254,
-       1,      4,      2,      0,      0,    254,      0,    254,
-     254,    254,    252,    254,    254,    254,    254,    254,
-       2,      3,      0,    251,    254,      2,      3,    253,
-     253,      1,      1,      0,    254,      0,    254,      0,
-       0,      0,      2,      0,      1,      3,      0,      0,
-       2,    254,      1,      0,      0,      1,      1,      1,
-     254,    254,      1,      3,      1,      1,      0,    254,
-       1,    254,    253,    254,    254,      1,    254,    252,
-     254,
+       4,     82,    135,    168,     13,     32,    144,     42,
+       0,    146,    131,    219,     65,    170,     46,     36,
+     160,      0,    251,     88,      9,     16,    146,    136,
+     170,    121,    144,     32,    164,    224,     16,     26,
+     144,     17,    143,     32,     88,     82,    209,     16,
+     170,     40,      8,     75,    177,     25,    166,    140,
+      20,    210,     45,      8,     42,    128,      7,     82,
+     184,    129,     48,    165,    208,     16,     59,    192,
+      89,    161,     57,    182,    154,     21,    139,    128,
+      54,     80,     45,    144,      1,    152,    164,      2,
+     143,     91,      2,    153,    166,    138,    179,     90,
+     162,    128,    199,     86,     73,    179,    155,      4,
+     136,    146,     15,     40,    129,      2,    179,     24,
+     137,    144,    123,     64,    253,     78,     92,    133,
+     194,      9,    137,     57,    160,     23,    185,     32,
+      59,    140,    131,    178,    210,    112,    210,     78,
+      17,    228,     61,    161,     35,    216,     57,    128,
+     171,    112,    177,     40,    163,    145,     31,     32,
+      58,     82,    184,    151,    141,     33,     26,    130,
+     160,    241,     58,    138,     18,     16,    226,     43,
+       0,    160,    227,     70,      4,    207,    133,     40,
+     140,     16,     40,     20,    208,    153,      7,    169,
+     136,     90,    129,    144,    251,     78,    109,    161,
+      52,    208,     10,     80,    184,     19,    173,     64,
+     168,    128,    130,     10,    129,     16,    249,     86,
+     146,     26,    137,      8,     34,    248,     20,    155,
+      90,     16,    179,    136,     10,    146,     23,    208,
+     186,     85,     50,    173,      2,      8,    136,     42,
+      33,    191,     49,    167,    186,    104,    176,    129,
+      26,    128,      2,     69,     79,     18,    202,    120,
+     137,    131,    136,    184,     40,    181,    154,    121,
+     129,    152,     24,      0,     14,     77,    152,    106,
+     193,     41,    162,     10,     40,    165,    180,     15,
+      32,    139,    112,    177,    193,     48,    218,     77,
+      24,     51,    248,      4,    168,    124,    147,      9,
+     163,     62,     16,    145,    155,     96,    160,      0,
+     234,     82,    130,    161,     42,     62,    131,    140,
+     135,    155,     17,    147,     12,    136,     50,    154,
+     122,    144,    254,     76,    155,    100,    232,      3,
+     177,     92,    130,    137,     16,    136,    195,     75,
+     137,     32,    193,     16,    224,     72,     90,    129,
+     224,    122,    146,    150,    171,     48,      8,    161,
+      35,    207,     17,     26,    131,    144,     12,     81,
+      59,    243,      8,     26,    161,     24,    170,    112,
+     178,    153,     90,    152,     18,    160,     43,     48,
+      19,     80,    193,      3,     15,      2,    169,     56,
+     132,     15,      0,      1,    164,    152,     26,      8,
+     146,    144,    190,     80,     51,    173,     41,     39,
+     187,     35,    155,    129,     37,    172,    133,     28,
+     145,     16,    138,     16,    245,     74,    106,    181,
+      10,     73,    192,     33,    185,    104,    177,    161,
+       0,     78,    129,     25,    165,    128,    215,     71,
+     105,    150,    161,    139,     56,     76,    164,      1,
+     233,     50,    168,      1,     40,    208,    145,      0,
+     227,     73,    123,      1,    147,    193,    129,     15,
+       4,    177,     46,     56,    180,      8,    160,    128,
+      29,     80,     77,     82,    224,      8,      9,     18,
+     168,     19,    188,     33,     17,    240,     45,     32,
+     152,     73,    181,    144,     35,     77,    224,     12,
+      50,    138,      8,     56,    209,     16,    181,     15,
+      33,    177,    128,     59,    146,    128,     20,     85,
+       8,     27,    167,    168,     25,     42,      8,     20,
+     201,     42,      1,    131,    202,     67,    208,     32,
+      28,     76,    143,     18,    169,     17,      9,     11,
+     121,    179,    131,    160,    224,    106,    131,    154,
+      43,     16,    232,     77,    149,    153,      0,    136,
+      20,    209,     26,     43,     23,    168,     45,     18,
+     154,    181,    128,    128,    201,     83,     56,      9,
+     194,     32,    196,    128,    153,    124,      3,    184,
+      41,      8,    136,    133,    177,     48,    224,     88,
+       0,    137,      5,    184,     73,    144,    136,     58,
+     183,    153,     41,    160,     80,    161,    177,     64,
+     227,     84,     41,    150,    193,     10,    129,     58,
+      25,      3,    240,     74,    145,      8,    147,    176,
+      75,     48,     18,     79,    137,     75,    195,    162,
+      17,    186,     66,    188,     96,    158,     32,    129,
+     163,    139,     65,    192,    241,     80,     40,    179,
+      25,    159,     40,      1,      5,    184,    152,    123,
+       1,    169,     33,    162,    208,     80,      4,     75,
+      21,    185,    161,    155,    122,     41,    167,    144,
+      10,     56,    131,    248,     16,    152,     57,    160,
+     250,     85,      9,    131,     27,    154,     97,    209,
+     136,     16,    146,     46,    132,    153,     16,    152,
+     138,     64,     14,     73,    241,     33,    139,    128,
+       9,    135,    194,     12,      1,     17,     11,     25,
+      42,    145,     17,    160,     22,     68,    242,    168,
+     162,    106,      0,    179,     15,     40,    160,      4,
+     139,     17,     57,     16,      7,    224,    216,     68,
+     112,    166,    137,     12,     18,      1,    136,    169,
+      19,    235,     52,    185,      3,    142,    136,    112,
+      27,     69,    174,     16,    210,     25,     74,    198,
+       9,    145,     13,     17,    145,     43,    178,     35,
+     176,      0,     29,     74,    209,     61,     32,    170,
+      56,    129,    211,      0,    185,    121,    145,    179,
+      76,    144,    128,     48,     22,     73,    194,    169,
+      58,     15,     88,    153,     36,    153,    128,    148,
+     152,     89,    185,     74,    211,     48,    246,     63,
+     162,    114,    240,     32,    136,    241,     26,     57,
+      26,     16,    244,    128,     11,      9,      7,    176,
+     231,     81,     58,     16,    178,     61,      0,    128,
+     145,    195,    138,     44,     50,    192,     73,      8,
+     184,     32,     14,     75,    144,     31,     17,    145,
+       8,    155,      4,     40,    213,    154,     57,    129,
+      75,    138,      2,    176,     24,     74,    208,     57,
+     162,    128,    133,    201,     61,     57,    130,    177,
+     181,     11,     90,    163,     25,    176,     13,     71,
+      28,      0,     25,    182,     61,    179,     75,    185,
+     113,    169,    129,      0,    144,     89,    137,    176,
+       3,     73,     27,      2,    242,     60,    145,     57,
+     155,     52,    208,    129,    137,     17,    105,    195,
+      28,    128,    234,     74,     68,    201,     24,    130,
+     128,    137,    137,    107,      8,    197,    144,    128,
+     128,    138,    112,    192,      6,     73,     15,     18,
+     145,    154,     88,    144,      9,     18,    241,     75,
+     136,      2,    145,    136,    147,    192,    245,     73,
+      74,     59,     26,    196,    136,    197,    136,     27,
+      16,    180,     25,    169,    122,    144,     66,    240,
+     249,     68,     42,    122,    162,    128,     24,      0,
+     156,     64,    147,    139,      4,    175,     44,     49,
+     147,    192,      3,     69,    153,    130,    135,    185,
+     137,    121,      8,    130,     27,    164,    137,     74,
+     211,     58,    192,     32,     23,     72,    138,    145,
+       0,    158,     65,    168,     43,    136,    132,    160,
+      88,    155,      6,    185,     21,    128,    254,     61,
+       9,     60,     35,     45,      0,    175,      0,     18,
+     148,    212,    169,     90,     26,      1,    146,    192,
+     254,     59,     57,    125,     17,    163,    217,     32,
+      57,    177,    160,     44,      7,    144,    154,     56,
+      13,     16,      4,     65,     16,    202,     34,    145,
+     131,    156,    168,     56,     72,    168,     16,    178,
+     197,    155,     35,     16,      0,     63,    153,     88,
+     163,    152,     27,    131,    163,     43,    129,    154,
+     137,     88,     17,    242,    152,    128,    253,     49,
+      89,      8,    129,    179,     25,    128,    133,     14,
+      24,      1,    137,    128,    136,      0,    136,      0,
+};
+const prog_uint8_t wav_res_oh[] PROGMEM = {
+     254,     86,      8,      8,    128,    129,    128,    176,
+     123,     20,    216,     17,    154,     96,    224,     89,
+     163,    144,    218,     78,      3,     60,    212,     11,
+      21,    156,     17,     16,    201,     18,    139,      6,
+     186,     56,     26,      0,     19,     70,    248,     24,
+     148,     15,      6,    155,     33,    153,     18,    200,
+      48,    176,     65,    170,     41,    128,     35,     70,
+     248,     73,    169,     36,    168,     44,     35,    171,
+      82,    216,    131,     47,    146,     41,     33,    240,
+      31,     78,     12,     56,    168,     42,    133,    200,
+      19,    202,    106,    129,    161,    195,     91,    161,
+      32,    160,    210,     74,    120,    177,     32,    216,
+      56,     78,    131,    168,     33,    241,     17,     13,
+      33,    153,    129,      0,     30,     82,     58,    210,
+      40,    162,    208,     25,    153,     42,     76,     41,
+     135,    160,    152,     91,      3,    208,    186,     79,
+      72,    147,     28,    160,    120,    145,    168,     48,
+     131,    158,      1,     24,    241,     24,      1,      0,
+     219,     84,    132,    137,     28,    134,    155,     56,
+     130,    176,      3,    175,    131,     58,    184,     84,
+     201,      0,    213,     76,    104,    128,    129,    179,
+     145,    224,     72,    170,     90,    151,    184,     33,
+      29,     16,     24,    208,     29,     82,    161,     42,
+     170,     81,     61,    160,     88,    243,    137,     41,
+      60,    133,    138,    165,    154,     80,    232,     79,
+       0,      7,    208,      8,     12,     96,    176,      1,
+     180,    170,    105,      8,    130,    154,    128,     48,
+      37,     71,    215,    185,     88,    154,     18,    184,
+      32,    178,     72,    241,     44,     25,     24,    161,
+      58,    160,     25,     84,    177,    130,     47,     16,
+     137,     49,    241,     41,    128,    178,     58,     44,
+      18,     13,     33,    192,     19,     80,      0,    241,
+      16,    153,     79,     18,      0,    209,      1,    153,
+      41,     58,    155,     50,     89,    240,    227,     83,
+      16,    147,    201,     80,     12,     16,      8,    161,
+     148,    164,    192,     47,     74,    136,    167,    128,
+     197,     84,      2,     16,    224,     24,     18,    200,
+      32,    137,     16,    194,     57,    204,     80,     41,
+     177,    192,     82,     85,    172,     33,     13,     32,
+     178,     40,    193,      2,    172,     57,      8,    149,
+      25,      1,     13,    128,     10,     82,    162,     61,
+     132,    138,      8,    130,    162,    242,     10,    122,
+       9,    132,    155,     33,    197,    192,    223,     85,
+      59,     61,     17,    153,     19,    217,     64,    163,
+     139,    162,    123,     24,      1,    193,    130,    144,
+     245,     71,     25,    228,     75,     30,     35,    210,
+      11,      1,     33,    186,     32,    240,    106,    181,
+     138,      0,    225,     81,     89,    168,    145,     72,
+     168,    149,     10,      9,     17,     76,    148,    146,
+     233,    122,    129,    144,      4,     68,    112,    185,
+     124,    128,      5,    200,     32,    169,     73,      8,
+     177,    132,    146,    217,    121,    160,    214,     84,
+      74,    178,     52,    224,     25,    136,     89,    146,
+     170,     48,     27,    151,    138,    136,     72,    208,
+      11,     73,     15,     58,    194,      6,     12,    147,
+      27,    128,     27,     64,    144,     33,    179,    249,
+     121,    144,     42,     83,    169,    132,     10,     16,
+     141,    181,     76,    130,    138,     33,    180,     15,
+       4,    128,    170,     32,     17,     71,     13,    120,
+     195,    141,     35,    193,     27,     33,    155,      8,
+      96,    240,      2,    136,    172,     64,     45,     71,
+     253,     19,    138,    161,    121,    180,     13,     49,
+     193,     41,     10,      3,     27,    212,    140,     32,
+       5,     75,    151,     28,    193,     72,    152,    163,
+     138,     17,    161,    110,    150,    168,     28,     49,
+     178,    176,     30,     87,     25,     13,     17,     24,
+     177,     49,    249,     58,     89,    176,     16,    145,
+     137,     35,    249,     48,     12,     83,    136,    145,
+       0,    135,    143,     32,    164,     11,      0,    129,
+      28,     88,    193,    129,    129,      0,    227,     76,
+      11,     97,    140,      2,    161,    168,     55,     13,
+     147,    129,     29,     18,    139,     44,     64,    160,
+      58,     80,    226,    138,     88,    152,    136,      1,
+     196,     12,    129,     41,    145,     27,    165,     16,
+     195,     16,    153,     85,     36,    138,    146,    130,
+     192,    121,    178,    137,     26,     80,    193,     25,
+     145,     58,    198,    160,    220,     73,     64,     78,
+      27,     20,    152,    181,    168,     80,    200,     72,
+     140,      2,      3,    193,    157,     64,     23,     72,
+     243,     42,    241,     16,    139,     60,    151,      9,
+     130,    187,     35,     60,    138,      1,      5,    128,
+      31,     69,    245,    159,     40,     42,    151,    140,
+     131,     11,    145,     40,    146,    160,     59,     46,
+      42,    176,    230,     61,     84,    246,    185,    120,
+     168,     16,    176,    113,    200,     25,     58,     41,
+     177,    133,    209,     48,    233,     87,      8,     17,
+      31,      2,    163,    169,     50,    202,     75,     35,
+     185,    163,     15,     49,    146,    176,    241,     69,
+     227,    123,     27,     20,    164,    233,     96,    201,
+      64,    168,    145,     58,    182,    138,     57,    208,
+     194,     82,    104,    136,    145,      8,    137,     50,
+     200,    196,     75,    176,     65,    184,      9,    132,
+     200,     80,    246,     83,     10,    133,    153,     56,
+     148,    217,     24,     19,     10,    160,     90,    161,
+      17,     47,    131,    192,      7,     63,    125,    146,
+     108,    181,      8,     12,     35,    168,    140,      8,
+     106,    130,    196,    154,     49,    176,    240,     78,
+      18,    159,     48,    164,    170,     64,    184,    130,
+      26,    130,    149,    138,    233,    113,    168,    160,
+     250,     85,     10,     32,     16,    161,    218,     55,
+     154,      0,     59,    146,     29,      4,    208,      4,
+     143,     48,     59,     83,     12,    132,    200,     25,
+      57,    131,    193,    128,     92,    146,    129,    153,
+      73,    170,     98,    192,    225,     74,      7,    142,
+      72,    161,     33,    248,     73,    128,      9,      8,
+     164,    152,     90,    152,      2,    144,    237,     81,
+      25,     75,    229,      8,    168,     74,    128,     18,
+     208,     25,     16,     29,    133,    168,      8,     64,
+      21,     78,    200,      6,    168,     25,    132,    171,
+      74,     20,    142,    133,    160,      8,     42,    177,
+      89,    128,     11,     76,    152,    150,    128,    189,
+      65,    177,     56,    160,    189,     65,     57,    186,
+     230,     10,     40,    144,    254,     75,     12,     38,
+     192,     29,     65,    184,    130,      9,      8,     60,
+     129,    128,     24,      9,    133,    240,     10,     82,
+     139,     88,     11,     34,    241,     24,     12,     35,
+     184,      8,      1,    170,    104,     25,    193,    144,
+      54,     85,     12,      0,     43,    128,    133,     11,
+     146,    168,     88,    144,    162,     24,    227,     45,
+      41,     16,    223,     85,    132,    138,    147,      2,
+     159,      1,     27,     40,    134,    169,    162,     90,
+     153,     17,      8,    128,     15,     86,    144,     41,
+     153,     23,    170,      3,    153,     73,    168,     17,
+      45,    151,    168,      1,    140,     64,     56,     84,
+     185,    133,    152,     59,    136,     18,    194,    139,
+      52,    225,     76,      8,     41,    165,    160,      0,
+     225,     83,    132,     13,     17,    160,     41,    162,
+      24,     44,    163,      9,     16,    244,     12,    130,
+      40,     16,    214,     81,    167,     24,    209,      8,
+      75,      3,    184,     41,    210,     89,    177,     40,
+     160,     58,    162,    192,    201,     84,     56,    137,
+      32,    196,    160,     26,     12,     50,     63,    163,
+       1,    170,     41,     54,    158,    128,     86,     71,
+     250,    140,    121,    144,     19,    187,      8,     52,
+     187,     24,     72,    226,     32,    219,     96,    128,
+      35,     79,    184,     24,     81,    232,     41,    160,
+      72,     26,    181,    161,    153,     88,    178,     11,
+      55,    192,    183,     76,    120,      1,    154,    150,
+     137,     40,    152,    163,     16,     14,    129,     34,
+     219,     36,     27,    144,    223,     87,     40,    180,
+     154,     72,    152,     16,    178,    169,     80,    161,
+      75,    137,     56,    162,    197,    160,    220,     81,
+      64,    169,     74,    178,     56,    208,     19,    170,
+      73,    226,     43,     57,    179,     73,    226,     16,
+      27,     80,    192,     42,     17,    138,      6,    155,
+      48,    195,     29,     16,      8,    167,    155,     73,
+     146,    144,     11,     86,    161,     59,     10,      5,
+     138,    179,     90,    145,     41,    160,     16,     12,
+      35,    248,     34,    160,    240,     68,    105,     61,
+     133,    224,     48,    171,     20,    137,     27,    128,
+      54,    217,     56,    128,    144,     48,     22,     85,
+     193,     56,    168,     90,    146,    152,    130,     28,
+       0,     24,    152,     26,      1,    215,    136,      0,
+     250,     76,     28,     40,     40,    194,    160,      7,
+      12,    130,    168,     56,    142,     49,    152,    163,
+     106,    224,    251,     72,      7,    141,     57,      0,
+     162,    161,     11,    243,     92,     25,      4,    170,
+       3,    168,     26,    144,     10,     62,    123,    192,
+     123,    163,    182,     44,    160,     72,    128,    153,
+      40,    201,     69,    155,    129,      0,     29,     80,
+      15,     48,    192,     18,    178,     11,    133,    139,
+       8,     40,    182,    128,    138,     41,    136,    160,
+     234,     61,    116,     11,    191,    104,    146,    210,
+      27,     33,    156,     50,    170,      7,    154,    144,
+     104,      0,    211,     78,     21,    138,    149,    144,
+     139,      2,     78,     32,    162,    177,     26,     56,
+     232,     34,     11,     16,      9,     76,    178,     45,
+      49,    226,    144,     24,    168,    121,    152,    128,
+      33,    242,     11,     48,    129,    144,    240,     72,
+     122,    166,    168,     43,     17,      8,    169,     17,
+     134,    158,     32,    132,    202,     65,    153,    128,
+     243,     83,     26,     33,    162,    200,     18,    154,
+     146,     63,      2,     17,    240,     16,    144,     59,
+     138,     64,     30,     81,    161,    145,     28,    164,
+     128,     24,     15,     64,    192,     41,    164,     10,
+     147,     29,     24,     16,    251,     84,      8,    148,
+     177,      8,     27,     74,     27,      4,    163,    200,
+      18,    212,     31,      1,      9,     16,     27,     83,
+     176,     72,    184,     20,    140,    129,     41,    130,
+     195,     44,    180,     10,      0,    145,     89,    144,
+       8,     77,    164,     12,    130,    154,    120,    160,
+      40,    180,    168,     42,    129,     90,    184,    104,
+     153,    144,    241,     62,    113,    204,     97,    153,
+     178,     83,    234,     34,    139,     40,    145,     25,
+     196,    138,     16,     16,     18,     69,    232,    148,
+      47,      3,    152,     25,    144,      5,    174,     33,
+       8,    177,     16,    162,     10,     80,    247,     75,
+     144,     22,    154,    130,      9,     28,     19,    232,
+      89,    160,     16,    131,    200,     60,     24,      0,
+      17,     76,    144,     46,      3,    160,    152,     60,
+      33,    157,     34,    144,    195,    145,    153,     18,
+      77,     16,    224,     75,     22,    168,      8,     24,
+     144,      1,     10,    137,     34,     30,    131,    196,
+      46,    129,    148,    128,    237,     66,    104,    164,
+     168,     60,    182,     42,    144,    144,     89,    194,
+     129,     13,     17,      8,    146,    144,    245,     58,
+      68,    188,    120,    130,    169,     61,    151,    160,
+      41,    184,     72,    146,    153,      2,    139,     64,
+     252,     66,     27,    135,    128,    185,     88,    145,
+     177,     16,    155,    120,      9,    196,     25,    154,
+      23,    128,      1,     70,    137,     16,     24,    243,
+      43,    128,    136,     56,    209,     17,    184,     64,
+     153,    143,     67,    192,    239,     70,      3,    136,
+     137,    122,    162,      0,    129,    171,     81,    136,
+     169,     65,    202,     35,    140,     16,      3,     61,
+       0,    152,    226,     57,    188,    113,    170,     18,
+     161,    180,    155,    120,    160,     57,    138,      0,
+       6,     55,    184,    244,     59,    208,     33,     10,
+     137,     17,     11,    198,     30,      3,    136,    137,
+      25,     32,      5,     54,    200,    146,     40,    200,
+      81,    201,     17,     76,    163,    129,    138,     26,
+      33,    152,     33,    192,      0,     66,    128,      8,
+     128,    128,      8,      8,    128,      8,    147,    140,
+      17,     17,    169,    195,     47,     48,      0,      6,
+       8,      7,    184,    123,      8,    247,    152,      8,
+       8,    128,      8,    128,      8,    128,      8,      0,
+};
+const prog_uint8_t wav_res_clap[] PROGMEM = {
+      47,     76,    203,     18,      0,    179,    144,     75,
+     211,    146,    182,     40,    154,    179,     46,    144,
+     163,     48,    242,     60,    152,    112,    171,     69,
+      36,    154,     28,    202,     33,     32,    152,    193,
+      42,     24,    182,     64,     15,     53,     89,     44,
+     250,    177,    169,      7,     24,     19,    136,     29,
+     168,     11,    130,      6,    136,    144,    251,     63,
+      18,    145,     60,    160,     45,     18,    128,    185,
+     177,     49,      9,      1,    171,     52,    135,     16,
+       2,     18,    127,    244,    162,    240,    153,     24,
+      39,     24,     13,    137,    136,      8,     19,     16,
+      73,    160,      0,     80,      8,    128,    128,      8,
+       8,    128,    128,      8,    116,    209,     16,    200,
+      28,    187,    164,     16,    200,     76,     97,    129,
+      17,     13,    139,    152,     17,     26,     32,     32,
+     224,    146,    185,    165,    136,     80,      5,     58,
+       7,    113,    200,    184,    144,    131,      1,     41,
+     154,     16,    241,     40,    137,    162,    200,     32,
+       3,     65,     41,    128,    186,     73,    145,     73,
+      40,      1,    216,     15,    153,      4,      2,     16,
+     145,    144,      2,     54,    144,     74,    194,      2,
+     160,    156,     48,     13,    195,    137,     82,      0,
+       9,    192,    155,     16,    250,     42,     81,     50,
+     128,     81,    152,    204,    149,    145,    147,    154,
+      42,     83,      1,     10,    190,    144,    254,     83,
+     128,    128,      8,      8,      8,      8,      8,      0,
+     136,      8,    249,    210,    151,     65,    168,      0,
+      60,     70,    208,    249,      9,     32,     41,    161,
+      16,     89,     40,     29,     24,     16,    210,    140,
+     163,     16,    236,     73,    148,     18,    128,     24,
+     186,    251,     16,     16,     49,     59,    145,     29,
+       8,     58,     17,    176,      1,     61,    145,    152,
+     104,    187,     67,     45,     11,     16,     42,    172,
+      19,      8,     41,      7,     24,     32,     14,     61,
+     168,     12,    186,      8,     22,     16,     32,     24,
+     157,      8,    139,    139,     57,    136,    114,     32,
+       6,     41,     15,    172,    136,    137,     22,     25,
+     153,     56,     75,     27,    140,     28,      3,    146,
+      40,     48,      2,     87,      8,    128,    128,    128,
+       8,    128,    128,    128,      8,    128,      8,      8,
+     126,    179,     57,    176,    190,     80,     19,    148,
+       3,    186,    191,    129,    150,     42,    136,     64,
+     178,    156,     32,    140,    185,    112,    210,     79,
+      22,     40,    161,    177,    143,    168,      2,     51,
+     155,    147,     41,    194,    184,    139,     87,      0,
+      54,     85,     16,    137,    217,     24,    136,      0,
+      58,     81,    169,    145,    130,     89,     56,    233,
+      25,    208,    176,     74,     96,    160,     24,     35,
+      73,    133,    188,     26,    145,     65,    194,     11,
+      43,    179,    172,    112,     31,     80,    153,    148,
+     163,     12,    160,     67,     13,    130,     29,    145,
+      32,    137,    160,     27,    165,     48,     14,     65,
+     134,     15,     17,     14,    138,      2,     19,     49,
+     159,    128,      0,    168,    203,    150,     64,    128,
+      35,     74,      2,     13,      0,    202,    136,    128,
+     152,     99,    139,    182,    136,    136,     34,     31,
+       3,    160,      7,     73,    139,    196,    132,    128,
+     168,    128,    148,     72,     17,    235,    144,    154,
+      84,     24,    169,    144,     15,     65,      7,     40,
+     235,    154,    138,     98,    130,    130,     33,    217,
+      17,    155,    241,     26,    160,     80,    232,     61,
+     116,     11,    192,    149,    146,     25,     52,    153,
+       8,    168,    240,    138,      9,     17,    241,     16,
+     250,     67,     76,    148,     25,     18,    192,    141,
+     164,    148,    137,     17,      9,     18,    152,    202,
+     240,     16,    220,     72,     58,     50,     74,     24,
+     225,    136,     10,    200,     82,     49,    176,    202,
+     144,     45,     66,    160,    241,     57,     71,    187,
+     181,      6,     34,    192,    169,     28,    147,    184,
+     133,      8,    131,     40,    161,     80,     35,     60,
+      31,    248,     25,    137,    168,     16,     54,     80,
+      27,    136,    187,     26,     50,    185,     91,     16,
+       1,     61,     75,    212,     11,     19,    209,    147,
+      57,    195,     41,    173,    216,     49,    171,      0,
+      82,      0,      9,     75,      2,    154,    160,    169,
+      17,      7,     16,      0,    172,    136,      8,    163,
+     140,    149,     58,    144,    246,     65,    128,     36,
+      36,    155,     45,     24,    224,    161,     18,     24,
+      24,    241,      1,    170,    129,      0,      2,     55,
+     218,     55,    128,    193,    162,    178,    164,     16,
+       9,    128,    106,    232,     25,      9,    128,     64,
+       8,     55,     97,     29,    129,    203,    139,     53,
+     162,     61,    163,    136,     40,    201,    183,     16,
+     144,     32,      6,     58,    141,    137,     82,    161,
+      41,     47,    154,    164,     25,     65,     25,     25,
+     203,    138,    193,     32,    251,     60,     40,     89,
+      10,    145,    150,     11,     18,    203,     16,    184,
+      96,    181,    146,     34,    169,    160,      5,     59,
+     159,    152,     25,     66,     65,     26,    200,    184,
+     140,     56,     64,     60,      2,    155,     64,    192,
+       3,     58,    162,    232,    129,      3,     89,     28,
+      32,    192,    177,    138,     57,     50,    121,     25,
+      45,     32,    255,     54,     47,     25,     57,     73,
+       9,    201,    183,     24,     33,     27,     26,    217,
+       8,    131,     10,     96,    255,     48,    249,     88,
+      41,     74,      8,    171,    138,     24,      5,     35,
+      97,    131,    128,    142,    154,    240,    244,     63,
+       0,    147,     58,     33,      8,    143,     32,     42,
+      14,    145,    136,     88,     58,     10,    146,    128,
+     255,     61,    152,      3,     56,    136,    156,    162,
+      74,     57,     31,     18,    200,      2,     27,    201,
+       0,     80,      1,     61,    129,      3,     29,    138,
+       8,    170,     43,     69,     24,      9,     43,    202,
+      89,      2,    181,      0,      3,     58,      9,     28,
+     178,     10,    105,      1,     49,    146,    187,    241,
+     160,     19,     40,    140,     42,    208,    246,     61,
+      32,     40,      1,    169,     18,      2,    159,    145,
+     152,     40,    200,      4,    149,     24,     45,    128,
+     252,     22,    255,     24,    112,    115,     72,    154,
+     142,     27,    160,     67,     32,    161,     31,    138,
+       1,    128,    255,     55,     24,    128,      1,     27,
+      25,    152,     10,    128,     56,      8,    195,      8,
+      14,     48,    136,      0,
+};
+const prog_uint8_t wav_res_rim[] PROGMEM = {
+     120,     85,    168,    187,    128,     53,     33,    137,
+     204,    168,    128,     36,     65,    137,    203,    152,
+       2,     80,     49,     66,    114,    138,    221,    168,
+      19,     82,      0,    154,    220,    152,      2,     51,
+      24,    190,    186,    128,    164,     62,     71,     98,
+      16,    171,    186,    129,    100,     34,      8,    171,
+     202,    145,     67,     49,    139,    224,    242,     68,
+     233,    128,     51,     49,    140,    203,    169,     19,
+     115,     49,    137,    187,    168,     55,     51,     16,
+      66,     67,    155,    219,    184,     18,     66,      9,
+     205,    202,    144,     18,     51,     24,    173,    170,
+       3,     80,      0,     61,    114,     24,    154,    185,
+     131,     68,     33,    139,    235,    187,    128,     35,
+      16,    174,    203,    160,    211,     56,     20,     99,
+      49,      9,    186,    146,    100,     66,     33,    138,
+     187,    168,     20,     34,     11,    240,      5,     63,
+     187,    168,      2,     33,    137,    204,    184,    131,
+      70,     50,     32,    138,    136,     36,     83,     32,
+      30,     47,     13,    221,    170,    136,     32,    136,
+     205,    203,    185,    129,     34,     49,    153,    201,
+     131,    112,    250,     58,     51,     34,      8,    153,
+       1,     36,     65,     10,    220,    187,    185,    144,
+     136,    174,    173,    160,    236,     28,    243,    119,
+      51,     40,      8,     33,    115,     67,     65,     24,
+     137,    176,    145,     40,     14,    160,      6,     48,
+     219,    186,    168,      8,     10,    157,    154,    146,
+      70,     50,     66,      1,      1,     20,     51,     96,
+      14,     24,    115,    254,    186,    200,    154,     13,
+     171,    251,    154,    154,     40,     40,      8,      8,
+      52,     48,    251,     47,     52,     50,     18,     16,
+      40,     51,     56,      8,    219,    251,    201,    169,
+     170,    174,    154,    176,    246,     54,    136,      0,
+      17,     17,     24,     34,     37,     50,     65,     72,
+      40,    160,    128,    128,    192,    176,      4,     60,
+     136,    152,    137,    128,    144,    153,      8,    145,
+       2,     34,     82,     34,     40,     51,     67,     48,
+       7,     24,    115,    128,    248,    203,    140,    188,
+      15,    154,    154,    170,    139,      8,      4,      8,
+       4,      0,    252,     40,     54,     18,     34,    131,
+     131,      4,    128,     75,    136,    203,    218,    139,
+     188,    139,    204,    160,    251,      4,    255,    251,
+     113,     88,     72,     72,     48,     52,      3,      4,
+     128,    128,      8,    128,    248,    128,      2,      2,
+     255,    255,    204,    128,    128,    128,      8,    128,
+       8,      8,    115,    128,    136,      8,      0,    128,
 };
 const prog_uint8_t wav_res_drum_map_node_0[] PROGMEM = {
      236,      0,      0,    138,      0,      0,    208,      0,
@@ -1037,6 +1038,9 @@ const prog_uint8_t* waveform_table[] = {
   wav_res_drm_envelope,
   wav_res_sine,
   wav_res_hh,
+  wav_res_oh,
+  wav_res_clap,
+  wav_res_rim,
   wav_res_drum_map_node_0,
   wav_res_drum_map_node_1,
   wav_res_drum_map_node_2,
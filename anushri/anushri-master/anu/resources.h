@@ -45,9 +45,13 @@ extern const prog_uint32_t* lookup_table_32_table[];
 extern const prog_uint8_t* waveform_table[];
 
 extern const prog_uint16_t lut_res_glide_increments[] PROGMEM;
+extern const prog_uint16_t lut_res_glide_increments_blocks[] PROGMEM;
 extern const prog_uint16_t lut_res_drm_env_increments[] PROGMEM;
+extern const prog_uint16_t lut_res_drm_env_increments_blocks[] PROGMEM;
 extern const prog_uint16_t lut_res_drm_phase_increments[] PROGMEM;
 extern const prog_uint16_t lut_res_dco_pitch[] PROGMEM;
+extern const prog_uint16_t lut_res_env_coefficients[] PROGMEM;
+extern const prog_uint16_t lut_res_env_coefficients_blocks[] PROGMEM;
 extern const prog_uint16_t lut_res_env_expo[] PROGMEM;
 extern const prog_uint16_t lut_res_groove_swing[] PROGMEM;
 extern const prog_uint16_t lut_res_groove_shuffle[] PROGMEM;
@@ -63,6 +67,9 @@ extern const prog_uint8_t wav_res_pitch_deadband[] PROGMEM;
 extern const prog_uint8_t wav_res_drm_envelope[] PROGMEM;
 extern const prog_uint8_t wav_res_sine[] PROGMEM;
 extern const prog_uint8_t wav_res_hh[] PROGMEM;
+extern const prog_uint8_t wav_res_oh[] PROGMEM;
+extern const prog_uint8_t wav_res_clap[] PROGMEM;
+extern const prog_uint8_t wav_res_rim[] PROGMEM;
 extern const prog_uint8_t wav_res_drum_map_node_0[] PROGMEM;
 extern const prog_uint8_t wav_res_drum_map_node_1[] PROGMEM;
 extern const prog_uint8_t wav_res_drum_map_node_2[] PROGMEM;
@@ -74,28 +81,39 @@ extern const prog_uint8_t wav_res_drum_map_node_7[] PROGMEM;
 extern const prog_uint8_t wav_res_drum_map_node_8[] PROGMEM;
 #define STR_RES_DUMMY 0  // dummy
 #define LUT_RES_GLIDE_INCREMENTS 0
-#define LUT_RES_GLIDE_INCREMENTS_SIZE 256
+#define LUT_RES_GLIDE_INCREMENTS_SIZE 126
+#define LUT_RES_GLIDE_INCREMENTS_BLOCK_SIZE 16
+#define LUT_RES_GLIDE_INCREMENTS_DECODED_SIZE 256
+#define LUT_RES_GLIDE_INCREMENTS_CHECKSUM 0xaec2
 #define LUT_RES_DRM_ENV_INCREMENTS 1
-#define LUT_RES_DRM_ENV_INCREMENTS_SIZE 256
+#define LUT_RES_DRM_ENV_INCREMENTS_SIZE 116
+#define LUT_RES_DRM_ENV_INCREMENTS_BLOCK_SIZE 16
+#define LUT_RES_DRM_ENV_INCREMENTS_DECODED_SIZE 256
+#define LUT_RES_DRM_ENV_INCREMENTS_CHECKSUM 0xbce6
 #define LUT_RES_DRM_PHASE_INCREMENTS 2
 #define LUT_RES_DRM_PHASE_INCREMENTS_SIZE 257
 #define LUT_RES_DCO_PITCH 3
 #define LUT_RES_DCO_PITCH_SIZE 97
-#define LUT_RES_ENV_EXPO 4
+#define LUT_RES_ENV_COEFFICIENTS 4
+#define LUT_RES_ENV_COEFFICIENTS_SIZE 136
+#define LUT_RES_ENV_COEFFICIENTS_BLOCK_SIZE 16
+#define LUT_RES_ENV_COEFFICIENTS_DECODED_SIZE 256
+#define LUT_RES_ENV_COEFFICIENTS_CHECKSUM 0xef36
+#define LUT_RES_ENV_EXPO 5
 #define LUT_RES_ENV_EXPO_SIZE 257
-#define LUT_RES_GROOVE_SWING 5
+#define LUT_RES_GROOVE_SWING 6
 #define LUT_RES_GROOVE_SWING_SIZE 16
-#define LUT_RES_GROOVE_SHUFFLE 6
+#define LUT_RES_GROOVE_SHUFFLE 7
 #define LUT_RES_GROOVE_SHUFFLE_SIZE 16
-#define LUT_RES_GROOVE_PUSH 7
+#define LUT_RES_GROOVE_PUSH 8
 #define LUT_RES_GROOVE_PUSH_SIZE 16
-#define LUT_RES_GROOVE_LAG 8
+#define LUT_RES_GROOVE_LAG 9
 #define LUT_RES_GROOVE_LAG_SIZE 16
-#define LUT_RES_GROOVE_HUMAN 9
+#define LUT_RES_GROOVE_HUMAN 10
 #define LUT_RES_GROOVE_HUMAN_SIZE 16
-#define LUT_RES_GROOVE_MONKEY 10
+#define LUT_RES_GROOVE_MONKEY 11
 #define LUT_RES_GROOVE_MONKEY_SIZE 16
-#define LUT_RES_ARPEGGIATOR_PATTERNS 11
+#define LUT_RES_ARPEGGIATOR_PATTERNS 12
 #define LUT_RES_ARPEGGIATOR_PATTERNS_SIZE 6
 #define LUT_RES_LFO_INCREMENTS 0
 #define LUT_RES_LFO_INCREMENTS_SIZE 256
@@ -110,24 +128,42 @@ extern const prog_uint8_t wav_res_drum_map_node_8[] PROGMEM;
 #define WAV_RES_SINE 3
 #define WAV_RES_SINE_SIZE 257
 #define WAV_RES_HH 4
-#define WAV_RES_HH_SIZE 4097
-#define WAV_RES_DRUM_MAP_NODE_0 5
+#define WAV_RES_HH_SIZE 1080
+#define WAV_RES_HH_BLOCK_SIZE 32
+#define WAV_RES_HH_DECODED_SIZE 1920
+#define WAV_RES_HH_CHECKSUM 0xc811
+#define WAV_RES_OH 5
+#define WAV_RES_OH_SIZE 1728
+#define WAV_RES_OH_BLOCK_SIZE 32
+#define WAV_RES_OH_DECODED_SIZE 3072
+#define WAV_RES_OH_CHECKSUM 0x9c27
+#define WAV_RES_CLAP 6
+#define WAV_RES_CLAP_SIZE 900
+#define WAV_RES_CLAP_BLOCK_SIZE 32
+#define WAV_RES_CLAP_DECODED_SIZE 1600
+#define WAV_RES_CLAP_CHECKSUM 0xdad4
+#define WAV_RES_RIM 7
+#define WAV_RES_RIM_SIZE 360
+#define WAV_RES_RIM_BLOCK_SIZE 32
+#define WAV_RES_RIM_DECODED_SIZE 640
+#define WAV_RES_RIM_CHECKSUM 0x94da
+#define WAV_RES_DRUM_MAP_NODE_0 8
 #define WAV_RES_DRUM_MAP_NODE_0_SIZE 48
-#define WAV_RES_DRUM_MAP_NODE_1 6
+#define WAV_RES_DRUM_MAP_NODE_1 9
 #define WAV_RES_DRUM_MAP_NODE_1_SIZE 48
-#define WAV_RES_DRUM_MAP_NODE_2 7
+#define WAV_RES_DRUM_MAP_NODE_2 10
 #define WAV_RES_DRUM_MAP_NODE_2_SIZE 48
-#define WAV_RES_DRUM_MAP_NODE_3 8
+#define WAV_RES_DRUM_MAP_NODE_3 11
 #define WAV_RES_DRUM_MAP_NODE_3_SIZE 48
-#define WAV_RES_DRUM_MAP_NODE_4 9
+#define WAV_RES_DRUM_MAP_NODE_4 12
 #define WAV_RES_DRUM_MAP_NODE_4_SIZE 48
-#define WAV_RES_DRUM_MAP_NODE_5 10
+#define WAV_RES_DRUM_MAP_NODE_5 13
 #define WAV_RES_DRUM_MAP_NODE_5_SIZE 48
-#define WAV_RES_DRUM_MAP_NODE_6 11
+#define WAV_RES_DRUM_MAP_NODE_6 14
 #define WAV_RES_DRUM_MAP_NODE_6_SIZE 48
-#define WAV_RES_DRUM_MAP_NODE_7 12
+#define WAV_RES_DRUM_MAP_NODE_7 15
 #define WAV_RES_DRUM_MAP_NODE_7_SIZE 48
-#define WAV_RES_DRUM_MAP_NODE_8 13
+#define WAV_RES_DRUM_MAP_NODE_8 16
 #define WAV_RES_DRUM_MAP_NODE_8_SIZE 48
 typedef avrlib::ResourcesManager<
     ResourceId,
@@ -0,0 +1,79 @@
+#!/usr/bin/python2.5
+#
+# Copyright 2026 agent.
+#
+# Author: agent (agent@local)
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# -----------------------------------------------------------------------------
+#
+# Synthesis of the clap and rim shot samples of the drum synth, written as
+# 8-bit signed .raw files next to the hi-hat recordings. They are played an
+# octave below the sample rate of the drum synth (pitch 128), so they are
+# synthesized at half of it.
+#
+# Run from the source root:
+#   python anu/resources/drum_samples.py
+
+import numpy
+
+sample_rate = 20000000 / 510 / 2.0
+
+
+def resonator(x, frequency, q):
+  """Two-pole band-pass filter (state variable filter)."""
+  f = 2 * numpy.sin(numpy.pi * frequency / sample_rate)
+  damp = 1.0 / q
+  lp = bp = 0.0
+  y = numpy.zeros(len(x))
+  for i, v in enumerate(x):
+    lp += f * bp
+    hp = v - lp - damp * bp
+    bp += f * hp
+    y[i] = bp
+  return y
+
+
+def normalize(x, peak=120):
+  return numpy.round(x / numpy.abs(x).max() * peak).astype(numpy.int8)
+
+
+def clap(num_samples=1600):
+  """Three short bursts of band-passed noise, then a longer decaying one."""
+  t = numpy.arange(num_samples) / sample_rate
+  noise = numpy.random.RandomState(808).uniform(-1.0, 1.0, num_samples)
+  envelope = numpy.zeros(num_samples)
+  for start in [0.0, 0.009, 0.019]:
+    burst = t >= start
+    envelope[burst] += numpy.exp(-(t[burst] - start) / 0.0025)
+  tail = t >= 0.029
+  envelope[tail] += 1.2 * numpy.exp(-(t[tail] - 0.029) / 0.018)
+  x = resonator(noise * envelope, 1100.0, 1.8)
+  # The last milliseconds fade to silence, since the sample is a one-shot.
+  fade = numpy.minimum(1.0, (num_samples - numpy.arange(num_samples)) / 64.0)
+  return normalize(x * fade)
+
+
+def rim(num_samples=640):
+  """Two damped resonators excited by a click, as on the TR-808."""
+  click = numpy.zeros(num_samples)
+  click[0:3] = [1.0, -0.6, 0.2]
+  x = resonator(click, 455.0, 18.0) + 0.7 * resonator(click, 1667.0, 24.0)
+  x = numpy.tanh(3.0 * x / numpy.abs(x).max())
+  fade = numpy.minimum(1.0, (num_samples - numpy.arange(num_samples)) / 64.0)
+  return normalize(x * fade)
+
+
+if __name__ == '__main__':
+  clap().tofile('anu/resources/clap.raw')
+  rim().tofile('anu/resources/rim.raw')
@@ -59,6 +59,7 @@ values = numpy.power(rates, -1 / gamma).astype(int)
 lookup_tables_32.append(
     ('env_increments', values)
 )
+env_increments = values
 
 
 # Create lookup table for glide times.
@@ -73,7 +74,7 @@ rates = numpy.linspace(numpy.power(max_increment, -gamma),
 
 values = numpy.power(rates, -1 / gamma).astype(int)
 lookup_tables.append(
-    ('glide_increments', values)
+    ('glide_increments', values, ('delta2', 16))
 )
 
 # Create lookup table for drum envelope times
@@ -90,7 +91,7 @@ rates = numpy.linspace(numpy.power(max_increment, -gamma),
 
 values = numpy.power(rates, -1 / gamma).astype(int)
 lookup_tables.append(
-    ('drm_env_increments', values)
+    ('drm_env_increments', values, ('delta2', 16))
 )
 
 # Create pitch increment table for drum synth
@@ -117,13 +118,20 @@ lookup_tables.append(
 Envelope curves
 -----------------------------------------------------------------------------"""
 
+# Segments follow a (1 - exp(-4 t)) / (1 - exp(-4)) curve, computed
+# recursively: each sample covers a fixed fraction of the distance left to a
+# point beyond the end of the segment. The fraction only depends on the
+# segment duration, hence one coefficient per envelope time.
+env_coefficients = 1.0 - numpy.exp(-4.0 * env_increments / (65536 * 65536.0))
+env_coefficients = numpy.minimum(numpy.round(env_coefficients * 65536), 65535)
+lookup_tables.append(
+    ('env_coefficients', env_coefficients, ('delta2', 16)))
+
+# The curve itself, for the table-based envelopes of ENABLE_ENVELOPE_EXPO_TABLE
+# builds and for tools/envelope_test.
 env_linear = numpy.arange(0, 257.0) / 256.0
 env_linear[-1] = env_linear[-2]
-env_quartic = 1.0 - (1.0 - env_linear) ** 2.0
 env_expo = 1.0 - numpy.exp(-4 * env_linear)
-
-# lookup_tables.append(('env_linear', env_linear / env_linear.max() * 65535.0))
-# lookup_tables.append(('env_quartic', env_quartic / env_quartic.max() * 65535.0))
 lookup_tables.append(('env_expo', env_expo / env_expo.max() * 65535.0))
 
 """----------------------------------------------------------------------------
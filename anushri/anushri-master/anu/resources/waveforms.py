@@ -55,10 +55,20 @@ waveforms.append(('drm_envelope', scale(expo_decay, min=0, max=255)))
 sine = -numpy.sin(numpy.arange(257) / float(257) * 2 * numpy.pi) * 127.5 + 127.5
 waveforms.append(('sine', scale(sine) + 128))
 
-# HH
-hh = map(ord, file('anu/resources/hh_linn.raw').read())
-hh = hh[:4097]
-waveforms.append(('hh', hh))
+# Samples of the third drum voice, stored as 4-bit IMA ADPCM blocks of 32
+# samples (18 bytes), in the 4097 bytes of the former 8-bit hi-hat: closed
+# and open hi-hats, cut and faded out, then the clap and rim shot synthesized
+# by drum_samples.py.
+def drum_sample(name, size, fade_length=0):
+  x = numpy.fromfile('anu/resources/%s.raw' % name, dtype=numpy.int8)[:size]
+  x = x.astype(float)
+  x[size - fade_length:] *= numpy.linspace(1.0, 0.0, fade_length)
+  return numpy.round(x).astype(int)
+
+waveforms.append(('hh', drum_sample('hh_linn', 1920, 256), ('adpcm', 32)))
+waveforms.append(('oh', drum_sample('hh_dt', 3072, 512), ('adpcm', 32)))
+waveforms.append(('clap', drum_sample('clap', 1600), ('adpcm', 32)))
+waveforms.append(('rim', drum_sample('rim', 640), ('adpcm', 32)))
 
 # DrumMap nodes
 nodes = [[236, 0, 0, 138, 0, 0, 208, 0, 58, 28, 174, 0, 104, 0, 58, 0, 10, 66, 0, 8, 232, 0, 0, 38, 0, 148, 0, 14, 198, 0, 114, 0, 154, 98, 244, 34, 160, 108, 192, 24, 160, 98, 228, 20, 160, 92, 194, 44],
@@ -0,0 +1,535 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Storage of several sequences in the internal EEPROM.
+
+#include "anu/sequence_bank.h"
+
+#include <avr/eeprom.h>
+#include <string.h>
+
+namespace anu {
+
+// The bank uses the EEPROM space between the sequencer settings and the
+// system settings. The first byte identifies the format - it can never be
+// mistaken for the length of a sequence stored in the former format.
+static uint8_t* const kBankMagicAddress = (uint8_t*)(256);
+static uint8_t* const kBankStart = (uint8_t*)(257);
+static uint8_t* const kBankEnd = (uint8_t*)(1000);
+static const uint8_t kBankMagic = 0xa8;
+
+static const uint8_t kFirstNote = 60;
+static const uint8_t kEndOfSequence = 0xff;
+
+// Bytes which do not change are not written. Tick() skips at most this number
+// of them per call.
+static const uint8_t kMaxSkippedBytes = 16;
+
+/* <static> */
+SequenceBank::SaveState SequenceBank::save_state_;
+uint8_t* SequenceBank::save_address_;
+uint8_t* SequenceBank::save_end_;
+int16_t SequenceBank::save_delta_;
+uint8_t SequenceBank::save_num_steps_;
+uint8_t* SequenceBank::write_address_;
+uint8_t* SequenceBank::move_source_;
+uint16_t SequenceBank::move_size_;
+const Sequence* SequenceBank::save_sequence_;
+uint8_t SequenceBank::save_length_;
+uint8_t SequenceBank::save_index_;
+uint8_t SequenceBank::save_previous_note_;
+uint8_t SequenceBank::token_[2];
+uint8_t SequenceBank::token_size_;
+uint8_t SequenceBank::token_position_;
+
+uint8_t SequenceBank::chain_first_slot_;
+uint8_t* SequenceBank::chain_address_;
+uint8_t SequenceBank::chain_length_;
+uint8_t SequenceBank::chain_slot_;
+bool SequenceBank::chain_changed_;
+
+uint8_t* SequenceBank::read_address_;
+uint8_t SequenceBank::previous_note_;
+uint8_t SequenceBank::run_length_;
+SequenceStep SequenceBank::step_;
+bool SequenceBank::empty_;
+/* </static> */
+
+/* static */
+bool SequenceBank::Init() {
+  save_state_ = SAVE_STATE_IDLE;
+  chain_first_slot_ = 0;
+  chain_address_ = kBankStart;
+  chain_length_ = 1;
+  read_address_ = kBankStart;
+  empty_ = true;
+  if (eeprom_read_byte(kBankMagicAddress) != kBankMagic) {
+    return false;
+  }
+  // All the end of sequence markers must be found within the bank.
+  return SlotAddress(kNumSequences) != NULL;
+}
+
+/* static */
+void SequenceBank::Format() {
+  // A save in progress is abandoned.
+  save_state_ = SAVE_STATE_IDLE;
+  eeprom_update_byte(kBankMagicAddress, kBankMagic);
+  for (uint8_t i = 0; i < kNumSequences; ++i) {
+    eeprom_update_byte(kBankStart + i, kEndOfSequence);
+  }
+}
+
+/* static */
+uint8_t* SequenceBank::SlotAddress(uint8_t slot) {
+  // The note byte following an escape code is always below 0x80, so end of
+  // sequence markers can be found without decoding the tokens. During a save,
+  // the addresses are the ones from before the save.
+  uint8_t* address = kBankStart;
+  while (slot && address < kBankEnd) {
+    if (busy() && address == save_address_) {
+      // The slot being saved might already be overwritten.
+      address = save_end_;
+      --slot;
+    } else if (eeprom_read_byte(Locate(address++)) == kEndOfSequence) {
+      --slot;
+    }
+  }
+  return slot ? NULL : address;
+}
+
+/* static */
+uint8_t* SequenceBank::Locate(uint8_t* address) {
+  if (!busy() || address < save_address_) {
+    return address;
+  }
+  bool moved;
+  if (address >= save_end_) {
+    // The following slots are copied one byte at a time, from the end when
+    // they move up, from the beginning when they move down.
+    if (save_state_ == SAVE_STATE_MOVE_UP) {
+      moved = address > move_source_;
+    } else if (save_state_ == SAVE_STATE_MOVE_DOWN) {
+      moved = address < move_source_;
+    } else {
+      moved = true;
+    }
+    return moved ? address + save_delta_ : address;
+  }
+  // The old version of the slot being saved.
+  uint8_t* new_end = save_end_ + save_delta_;
+  bool overwritten;
+  if (save_state_ == SAVE_STATE_MOVE_UP) {
+    overwritten = false;
+  } else if (save_state_ == SAVE_STATE_MOVE_DOWN) {
+    overwritten = address >= new_end && address < write_address_;
+  } else if (save_state_ == SAVE_STATE_ENCODE) {
+    overwritten = address < write_address_ || address >= new_end;
+  } else {
+    overwritten = true;
+  }
+  return overwritten ? NULL : address;
+}
+
+/* static */
+bool SequenceBank::Readable(uint8_t* address) {
+  uint8_t* location = Locate(address);
+  if (!location) {
+    return false;
+  }
+  uint8_t token = eeprom_read_byte(location);
+  return token < 0xe0 || token == kEndOfSequence || Locate(address + 1);
+}
+
+/* static */
+uint8_t SequenceBank::ReadStep(
+    uint8_t** address,
+    uint8_t* previous_note,
+    SequenceStep* step) {
+  if (*address >= kBankEnd) {
+    return 0;
+  }
+  uint8_t token = eeprom_read_byte(Locate((*address)++));
+  uint8_t num_steps = 1;
+  if (!(token & 0x80)) {
+    int8_t offset = static_cast<int8_t>(token << 3) >> 3;
+    step->note = (*previous_note + offset) & 0x7f;
+    step->accent = token & 0x40;
+    step->slide = token & 0x20;
+    *previous_note = step->note;
+  } else if (!(token & 0x40)) {
+    step->note = 0xff;
+    num_steps += token & 0x3f;
+  } else if (!(token & 0x20)) {
+    step->note = 0xfe;
+    num_steps += token & 0x1f;
+  } else if (token != kEndOfSequence) {
+    step->note = eeprom_read_byte(Locate((*address)++)) & 0x7f;
+    step->accent = token & 0x02;
+    step->slide = token & 0x01;
+    *previous_note = step->note;
+  } else {
+    num_steps = 0;
+  }
+  return num_steps;
+}
+
+/* static */
+uint8_t SequenceBank::EncodeToken(
+    const Sequence& sequence,
+    uint8_t i,
+    uint8_t length,
+    uint8_t* previous_note,
+    uint8_t* token,
+    uint8_t* num_steps) {
+  uint8_t note = sequence.notes[i];
+  uint8_t token_size = 1;
+  *num_steps = 1;
+  if (note >= 0xfe) {
+    uint8_t max_num_steps = note == 0xff ? 64 : 32;
+    while (i + *num_steps < length &&
+           sequence.notes[i + *num_steps] == note &&
+           *num_steps < max_num_steps) {
+      ++*num_steps;
+    }
+    token[0] = (note == 0xff ? 0x80 : 0xc0) | (*num_steps - 1);
+  } else {
+    uint8_t accent_slide_index = i >> 3;
+    uint8_t accent_slide_mask = 1 << (i & 0x7);
+    bool accent = sequence.accents[accent_slide_index] & accent_slide_mask;
+    bool slide = sequence.slides[accent_slide_index] & accent_slide_mask;
+    note &= 0x7f;
+    int16_t offset = static_cast<int16_t>(note) - *previous_note;
+    if (offset >= -16 && offset < 16) {
+      token[0] = (offset & 0x1f) | (accent ? 0x40 : 0) | (slide ? 0x20 : 0);
+    } else {
+      token[0] = 0xe0 | (accent ? 0x02 : 0) | (slide ? 0x01 : 0);
+      token[1] = note;
+      token_size = 2;
+    }
+    *previous_note = note;
+  }
+  return token_size;
+}
+
+/* static */
+uint16_t SequenceBank::Encode(
+    const Sequence& sequence,
+    uint16_t max_size,
+    uint8_t* num_notes) {
+  uint16_t size = 0;
+  uint8_t previous_note = kFirstNote;
+  uint8_t i = 0;
+  uint8_t length = sequence.num_notes;
+  if (length > kMaxSequenceLength) {
+    length = kMaxSequenceLength;
+  }
+  while (i < length) {
+    uint8_t token[2];
+    uint8_t num_steps;
+    uint8_t token_size = EncodeToken(
+        sequence, i, length, &previous_note, token, &num_steps);
+    // Leave room for the end of sequence marker.
+    if (size + token_size + 1 > max_size) {
+      break;
+    }
+    size += token_size;
+    i += num_steps;
+  }
+  *num_notes = i;
+  return size + 1;
+}
+
+/* static */
+void SequenceBank::Load(uint8_t slot, Sequence* sequence) {
+  Flush();
+  if (slot >= kNumSequences) {
+    slot = kNumSequences - 1;
+  }
+  memset(sequence, 0, sizeof(Sequence));
+  uint8_t* address = SlotAddress(slot);
+  uint8_t previous_note = kFirstNote;
+  SequenceStep step;
+  uint8_t num_steps;
+  while ((num_steps = ReadStep(&address, &previous_note, &step)) != 0) {
+    while (num_steps--) {
+      if (sequence->num_notes == kMaxSequenceLength) {
+        return;
+      }
+      uint8_t i = sequence->num_notes++;
+      sequence->notes[i] = step.note;
+      if (step.note < 0x80) {
+        uint8_t accent_slide_index = i >> 3;
+        uint8_t accent_slide_mask = 1 << (i & 0x7);
+        if (step.accent) {
+          sequence->accents[accent_slide_index] |= accent_slide_mask;
+        }
+        if (step.slide) {
+          sequence->slides[accent_slide_index] |= accent_slide_mask;
+        }
+      }
+    }
+  }
+}
+
+/* static */
+void SequenceBank::Save(uint8_t slot, Sequence* sequence) {
+  Flush();
+  if (slot >= kNumSequences) {
+    slot = kNumSequences - 1;
+  }
+  uint8_t* start = SlotAddress(slot);
+  uint8_t* end = SlotAddress(slot + 1);
+  uint8_t* bank_end = SlotAddress(kNumSequences);
+  uint16_t max_size = (kBankEnd - bank_end) + (end - start);
+  uint8_t num_notes;
+  uint16_t size = Encode(*sequence, max_size, &num_notes);
+  sequence->num_notes = num_notes;
+
+  save_address_ = start;
+  save_end_ = end;
+  save_delta_ = static_cast<int16_t>(size) - (end - start);
+  save_sequence_ = sequence;
+  save_length_ = num_notes;
+
+  // The length of the old version, for the playback once it is overwritten.
+  save_num_steps_ = 0;
+  uint8_t* address = start;
+  uint8_t previous_note = kFirstNote;
+  SequenceStep step;
+  uint8_t num_steps;
+  while ((num_steps = ReadStep(&address, &previous_note, &step)) != 0) {
+    save_num_steps_ += num_steps;
+  }
+
+  // Make room for the new sequence, or close the gap left by the old one.
+  // When the following slots move up, they are copied from the end.
+  move_size_ = bank_end - end;
+  if (start + size == end || !move_size_) {
+    StartEncode();
+  } else if (start + size < end) {
+    save_state_ = SAVE_STATE_MOVE_DOWN;
+    write_address_ = start + size;
+    move_source_ = end;
+  } else {
+    save_state_ = SAVE_STATE_MOVE_UP;
+    write_address_ = start + size + move_size_ - 1;
+    move_source_ = bank_end - 1;
+  }
+}
+
+/* static */
+void SequenceBank::StartEncode() {
+  save_state_ = SAVE_STATE_ENCODE;
+  write_address_ = save_address_;
+  save_index_ = 0;
+  save_previous_note_ = kFirstNote;
+  NextToken();
+}
+
+/* static */
+void SequenceBank::NextToken() {
+  token_position_ = 0;
+  if (save_index_ < save_length_) {
+    uint8_t num_steps;
+    token_size_ = EncodeToken(
+        *save_sequence_,
+        save_index_,
+        save_length_,
+        &save_previous_note_,
+        token_,
+        &num_steps);
+    save_index_ += num_steps;
+  } else if (save_index_ == save_length_) {
+    token_[0] = kEndOfSequence;
+    token_size_ = 1;
+    ++save_index_;
+  } else {
+    save_state_ = SAVE_STATE_DONE;
+  }
+}
+
+/* static */
+uint8_t SequenceBank::PendingByte() {
+  return save_state_ == SAVE_STATE_ENCODE ?
+      token_[token_position_] : eeprom_read_byte(move_source_);
+}
+
+/* static */
+void SequenceBank::NextPendingByte() {
+  if (save_state_ == SAVE_STATE_ENCODE) {
+    ++write_address_;
+    if (++token_position_ == token_size_) {
+      NextToken();
+    }
+  } else {
+    if (save_state_ == SAVE_STATE_MOVE_UP) {
+      --write_address_;
+      --move_source_;
+    } else {
+      ++write_address_;
+      ++move_source_;
+    }
+    if (!--move_size_) {
+      StartEncode();
+    }
+  }
+}
+
+/* static */
+void SequenceBank::EndSave() {
+  save_state_ = SAVE_STATE_IDLE;
+  chain_address_ = SlotAddress(chain_first_slot_);
+  if (read_address_ >= save_end_) {
+    read_address_ += save_delta_;
+  } else if (read_address_ >= save_address_) {
+    Resync();
+  }
+}
+
+/* static */
+void SequenceBank::Resync() {
+  // The slot being played has been saved: its new version is played from the
+  // next step, or from the next slot if it is shorter.
+  uint8_t position = step_.position;
+  uint8_t first_position = 0;
+  read_address_ = save_address_;
+  previous_note_ = kFirstNote;
+  run_length_ = 0;
+  while (true) {
+    uint8_t* address = read_address_;
+    uint8_t num_steps = ReadStep(&read_address_, &previous_note_, &step_);
+    if (!num_steps) {
+      read_address_ = address;
+      Advance();
+      return;
+    }
+    if (position < first_position + num_steps) {
+      run_length_ = first_position + num_steps - 1 - position;
+      step_.position = position;
+      return;
+    }
+    first_position += num_steps;
+  }
+}
+
+/* static */
+void SequenceBank::Tick() {
+  uint8_t num_skipped = 0;
+  // Reading the EEPROM would wait for the end of the previous write too.
+  while (busy() && eeprom_is_ready()) {
+    if (save_state_ == SAVE_STATE_DONE) {
+      EndSave();
+      break;
+    }
+    uint8_t* address = write_address_;
+    uint8_t value = PendingByte();
+    bool write = eeprom_read_byte(address) != value;
+    if (write) {
+      eeprom_write_byte(address, value);
+    }
+    NextPendingByte();
+    if (write || ++num_skipped == kMaxSkippedBytes) {
+      break;
+    }
+  }
+}
+
+/* static */
+void SequenceBank::Flush() {
+  while (busy()) {
+    eeprom_busy_wait();
+    Tick();
+  }
+}
+
+/* static */
+void SequenceBank::SetChain(uint8_t first_slot, uint8_t num_slots) {
+  if (first_slot >= kNumSequences) {
+    first_slot = kNumSequences - 1;
+  }
+  if (num_slots == 0) {
+    num_slots = 1;
+  }
+  if (first_slot + num_slots > kNumSequences) {
+    num_slots = kNumSequences - first_slot;
+  }
+  chain_first_slot_ = first_slot;
+  chain_length_ = num_slots;
+  chain_changed_ = true;
+  chain_address_ = SlotAddress(first_slot);
+}
+
+/* static */
+void SequenceBank::Rewind() {
+  read_address_ = chain_address_;
+  previous_note_ = kFirstNote;
+  run_length_ = 0;
+  chain_slot_ = 0;
+  chain_changed_ = false;
+  step_.position = 0xff;
+  Advance();
+}
+
+/* static */
+void SequenceBank::Advance() {
+  if (run_length_) {
+    --run_length_;
+    ++step_.position;
+    return;
+  }
+  uint8_t position = step_.position + 1;
+  // Going through all the sequences of the chain without finding a step means
+  // that the chain is empty.
+  for (uint8_t i = 0; i <= chain_length_; ++i) {
+    uint8_t num_steps = 0;
+    if (!busy() || Readable(read_address_)) {
+      num_steps = ReadStep(&read_address_, &previous_note_, &step_);
+    } else if (position < save_num_steps_) {
+      // The old version of the slot being saved is overwritten: rests, until
+      // the step where it ended.
+      step_.note = 0xff;
+      step_.position = position;
+      return;
+    } else {
+      read_address_ = save_end_;
+    }
+    if (num_steps) {
+      run_length_ = num_steps - 1;
+      step_.position = position;
+      empty_ = false;
+      return;
+    }
+    // Continue with the next sequence of the chain, or loop.
+    previous_note_ = kFirstNote;
+    position = 0;
+    ++chain_slot_;
+    if (chain_slot_ >= chain_length_ || chain_changed_) {
+      read_address_ = chain_address_;
+      chain_slot_ = 0;
+      chain_changed_ = false;
+    }
+  }
+  step_.note = 0xff;
+  step_.position = 0;
+  empty_ = true;
+}
+
+/* extern */
+SequenceBank sequence_bank;
+
+}  // namespace anu
@@ -0,0 +1,169 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Storage of several sequences in the internal EEPROM.
+//
+// Each sequence is encoded as a stream of tokens:
+// - 0asddddd: note, d being a signed offset from the previous note. a and s
+//   are the accent and slide flags.
+// - 10nnnnnn: n + 1 rests.
+// - 110nnnnn: n + 1 ties.
+// - 111000as 0nnnnnnn: note n, when it is too far from the previous note.
+// - 11111111: end of sequence.
+// The first note of a sequence is coded relative to middle C. The accent and
+// slide flags of rests and ties are not stored since they are never played.
+//
+// The sequences are stored back to back, so slot n starts after the n-th end
+// of sequence marker, and chaining consecutive slots is just a matter of
+// reading further.
+//
+// Saving a slot moves all the following ones: up to 743 bytes, and a byte
+// takes 3.4ms to write. The writes are thus done in the background, one at a
+// time, by Tick() which is called from the main loop. Meanwhile, playback
+// goes on: a byte of the following slots is read where it was, or where it
+// has been copied to, and the old version of the saved slot is read until it
+// is overwritten.
+
+#ifndef ANU_SEQUENCE_BANK_H_
+#define ANU_SEQUENCE_BANK_H_
+
+#include "avrlib/base.h"
+
+namespace anu {
+
+static const uint8_t kNumSequences = 8;
+static const uint8_t kMaxSequenceLength = 128;
+
+struct Sequence {
+  uint8_t num_notes;
+  uint8_t notes[kMaxSequenceLength];
+  uint8_t accents[kMaxSequenceLength / 8];
+  uint8_t slides[kMaxSequenceLength / 8];
+};
+
+struct SequenceStep {
+  uint8_t note;  // 0xff for a rest, 0xfe for a tie.
+  uint8_t position;
+  bool accent;
+  bool slide;
+};
+
+class SequenceBank {
+ public:
+  SequenceBank() { }
+
+  // Returns false if the EEPROM does not contain a bank - in which case it
+  // must be formatted.
+  static bool Init();
+  static void Format();
+
+  // Waits for the save in progress, if any.
+  static void Load(uint8_t slot, Sequence* sequence);
+  // The sequence is truncated if there is not enough room left in the bank,
+  // num_notes is updated right away. The bank is written by Tick(), and the
+  // sequence must not be modified until busy() returns false. Meanwhile,
+  // playback continues with the old version of the slot, and gives rests
+  // once it is overwritten. When the save is done, the new version is played
+  // from the same step.
+  static void Save(uint8_t slot, Sequence* sequence);
+
+  // Writes the next byte of the save in progress, if the EEPROM is ready.
+  static void Tick();
+  // Completes the save in progress. Blocking.
+  static void Flush();
+  static inline bool busy() { return save_state_ != SAVE_STATE_IDLE; }
+
+  // The new chain is played once the current sequence is over.
+  static void SetChain(uint8_t first_slot, uint8_t num_slots);
+
+  // Playback. The next step is always decoded one step ahead, so reading it
+  // from the sequencer clock handler is instantaneous.
+  static void Rewind();
+  static void Advance();
+  static inline const SequenceStep& step() { return step_; }
+  static inline bool empty() { return empty_; }
+
+ private:
+  enum SaveState {
+    SAVE_STATE_IDLE,
+    SAVE_STATE_MOVE_UP,
+    SAVE_STATE_MOVE_DOWN,
+    SAVE_STATE_ENCODE,
+    SAVE_STATE_DONE
+  };
+
+  static uint8_t* SlotAddress(uint8_t slot);
+  static uint8_t* Locate(uint8_t* address);
+  static bool Readable(uint8_t* address);
+  static uint8_t EncodeToken(
+      const Sequence& sequence,
+      uint8_t i,
+      uint8_t length,
+      uint8_t* previous_note,
+      uint8_t* token,
+      uint8_t* num_steps);
+  static uint16_t Encode(
+      const Sequence& sequence,
+      uint16_t max_size,
+      uint8_t* num_notes);
+  static uint8_t ReadStep(
+      uint8_t** address,
+      uint8_t* previous_note,
+      SequenceStep* step);
+  static uint8_t PendingByte();
+  static void NextPendingByte();
+  static void StartEncode();
+  static void NextToken();
+  static void EndSave();
+  static void Resync();
+
+  static SaveState save_state_;
+  static uint8_t* save_address_;
+  static uint8_t* save_end_;
+  static int16_t save_delta_;
+  static uint8_t save_num_steps_;
+  static uint8_t* write_address_;
+  static uint8_t* move_source_;
+  static uint16_t move_size_;
+  static const Sequence* save_sequence_;
+  static uint8_t save_length_;
+  static uint8_t save_index_;
+  static uint8_t save_previous_note_;
+  static uint8_t token_[2];
+  static uint8_t token_size_;
+  static uint8_t token_position_;
+
+  static uint8_t chain_first_slot_;
+  static uint8_t* chain_address_;
+  static uint8_t chain_length_;
+  static uint8_t chain_slot_;
+  static bool chain_changed_;
+
+  static uint8_t* read_address_;
+  static uint8_t previous_note_;
+  static uint8_t run_length_;
+  static SequenceStep step_;
+  static bool empty_;
+
+  DISALLOW_COPY_AND_ASSIGN(SequenceBank);
+};
+
+extern SequenceBank sequence_bank;
+
+}  // namespace anu
+
+#endif  // ANU_SEQUENCE_BANK_H_
@@ -15,11 +15,14 @@
 
 #include "anu/sysex_handler.h"
 
+#include "anu/audio_buffer.h"
 #include "anu/midi_dispatcher.h"
 #include "anu/storage.h"
 #include "anu/system_settings.h"
 #include "anu/voice_controller.h"
 
+#include <avr/interrupt.h>
+
 namespace anu {
 
 /* static */
@@ -56,6 +59,12 @@ static const prog_uint8_t header[] PROGMEM = {
   // - 0x02: SequencerSettings
   // - 0x03: Sequence (first block of 128 bytes)
   // - 0x04: Sequence (second block of remaining bytes)
+  // * Command byte:
+  // - 0x11: Data structure dump request
+  // - 0x12: Diagnostics request, answered with command 0x02, the number
+  //   of audio buffer underruns (16-bit, LSB first), and the minimum and
+  //   maximum delay between the generation and transmission of MIDI clock
+  //   messages since the previous request (in units of 204us)
 };
 
 static const prog_uint8_t block_sizes[] PROGMEM = {
@@ -68,7 +77,6 @@ static const prog_uint8_t block_sizes[] PROGMEM = {
 
 /* static */
 void* SysExHandler::GetObjectAddress(SysExObjectType type) {
-  uint8_t* p;
   switch (type) {
     case SYSEX_OBJECT_TYPE_SYSTEM_SETTINGS:
       return system_settings.mutable_data();
@@ -85,6 +93,9 @@ void* SysExHandler::GetObjectAddress(SysExObjectType type) {
     case SYSEX_OBJECT_TYPE_SEQUENCE_BLOCK_2:
       return static_cast<uint8_t*>(
           static_cast<void*>(voice_controller.mutable_sequence())) + 128;
+
+    default:
+      return NULL;
   }
 }
 
@@ -100,59 +111,89 @@ void SysExHandler::ParseCommand() {
   rx_destination_ = rx_buffer_;
   switch (rx_command_[0]) {
     case 0x01:  // Data structure transfer
-      {
+      if (rx_command_[1] < SYSEX_OBJECT_TYPE_LAST) {
         SysExObjectType type = static_cast<SysExObjectType>(rx_command_[1]);
         rx_expected_size_ = GetObjectSize(type);
+      } else {
+        rx_state_ = RECEPTION_ERROR;
       }
       break;
     
     case 0x11:  // Data structure dump request
+    case 0x12:  // Diagnostics request
       rx_expected_size_ = 0;
       break;
 
     default:
-      rx_state_ = RECEIVING_FOOTER;
+      rx_state_ = RECEPTION_ERROR;
       break;
   }
 }
 
+/* static */
+void SysExHandler::SendBlock(
+    uint8_t command,
+    uint8_t argument,
+    const uint8_t* data,
+    uint8_t size) {
+  // Header.
+  for (uint8_t i = 0; i < sizeof(header); ++i) {
+    midi_dispatcher.SendBlocking(pgm_read_byte(header + i));
+  }
+  
+  // Command and argument.
+  midi_dispatcher.SendBlocking(command);
+  midi_dispatcher.SendBlocking(argument);
+  
+  // Outputs the data.
+  uint8_t checksum = 0;
+  for (uint8_t i = 0; i < size; ++i) {
+    checksum += data[i];
+    midi_dispatcher.SendBlocking(U8ShiftRight4(data[i]));
+    midi_dispatcher.SendBlocking(data[i] & 0x0f);
+  }
+  // Outputs a checksum.
+  midi_dispatcher.SendBlocking(U8ShiftRight4(checksum));
+  midi_dispatcher.SendBlocking(checksum & 0x0f);
+
+  // End of SysEx block.
+  midi_dispatcher.SendBlocking(0xf7);
+}
+
 /* static */
 void SysExHandler::BulkDump() {
   for (uint8_t object = 0; object < SYSEX_OBJECT_TYPE_LAST; ++object) {
     SysExObjectType type = static_cast<SysExObjectType>(object);
-    const uint8_t* data = static_cast<uint8_t*>(GetObjectAddress(type));
-    uint8_t size = GetObjectSize(type);
-    
-    // Header.
-    for (uint8_t i = 0; i < sizeof(header); ++i) {
-      midi_dispatcher.SendBlocking(pgm_read_byte(header + i));
-    }
-    
-    // Command and argument.
-    midi_dispatcher.SendBlocking(0x01);
-    midi_dispatcher.SendBlocking(object);
-    
-    // Outputs the data.
-    uint8_t checksum = 0;
-    for (uint8_t i = 0; i < size; ++i) {
-      checksum += data[i];
-      midi_dispatcher.SendBlocking(U8ShiftRight4(data[i]));
-      midi_dispatcher.SendBlocking(data[i] & 0x0f);
-    }
-    // Outputs a checksum.
-    midi_dispatcher.SendBlocking(U8ShiftRight4(checksum));
-    midi_dispatcher.SendBlocking(checksum & 0x0f);
-
-    // End of SysEx block.
-    midi_dispatcher.SendBlocking(0xf7);
+    SendBlock(
+        0x01,
+        object,
+        static_cast<uint8_t*>(GetObjectAddress(type)),
+        GetObjectSize(type));
   }
 }
 
+/* static */
+void SysExHandler::SendDiagnostics() {
+  uint8_t data[4];
+  cli();
+  uint16_t underruns = audio_underruns;
+  data[2] = midi_dispatcher.clock_latency_min();
+  data[3] = midi_dispatcher.clock_latency_max();
+  midi_dispatcher.ResetClockLatency();
+  sei();
+  data[0] = underruns & 0xff;
+  data[1] = underruns >> 8;
+  SendBlock(0x02, 0x00, data, sizeof(data));
+}
+
 /* static */
 void SysExHandler::AcceptBuffer() {
   switch (rx_command_[0]) {
     case 0x01:  // Transfer
       {
+        if (rx_command_[1] >= SYSEX_OBJECT_TYPE_LAST) {
+          break;
+        }
         SysExObjectType type = static_cast<SysExObjectType>(rx_command_[1]);
         void* address = GetObjectAddress(type);
         uint8_t size = GetObjectSize(type);
@@ -168,6 +209,9 @@ void SysExHandler::AcceptBuffer() {
     case 0x11:  // Request
       BulkDump();
       break;
+    case 0x12:  // Diagnostics request
+      SendDiagnostics();
+      break;
   }
 }
 
@@ -188,7 +232,8 @@ void SysExHandler::Receive(uint8_t rx_byte) {
           rx_bytes_received_ = 0;
         }
       } else {
-        rx_state_ = RECEIVING_FOOTER;
+        // Not for us.
+        rx_state_ = RECEPTION_ERROR;
       }
       break;
 
@@ -225,6 +270,9 @@ void SysExHandler::Receive(uint8_t rx_byte) {
       rx_state_ = RECEPTION_ERROR;
     }
     break;
+
+  default:
+    break;
   }
 }
 
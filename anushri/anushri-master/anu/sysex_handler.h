@@ -41,11 +41,17 @@ enum SysExObjectType {
 class SysExHandler {
  public:
   static void BulkDump();
+  static void SendDiagnostics();
   static void Receive(uint8_t sysex_rx_byte);
   
  private:
   static void ParseCommand();
   static void AcceptBuffer();
+  static void SendBlock(
+      uint8_t command,
+      uint8_t argument,
+      const uint8_t* data,
+      uint8_t size);
 
   static void* GetObjectAddress(SysExObjectType type);
   static uint8_t GetObjectSize(SysExObjectType type);
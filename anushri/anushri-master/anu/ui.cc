@@ -31,6 +31,13 @@ namespace anu {
 static const uint8_t kNumSoftPots = 10;
 static const uint8_t kNumRows = 3;
 
+// Number of scans of the pot being moved without any change after which it is
+// considered stationary again (about 0.2s).
+static const uint8_t kMovingPotTimeout = 64;
+
+// Largest widening of the pot hysteresis by the noise level, in ADC LSBs.
+static const uint8_t kMaxNoiseThreshold = 8;
+
 using namespace avrlib;
 
 /* <static> */
@@ -41,8 +48,15 @@ uint8_t Ui::inhibit_switch_ = 0;
 uint8_t Ui::pwm_cycle_;
 uint8_t Ui::display_mode_;
 uint16_t Ui::adc_values_[kNumPots];
+uint8_t Ui::adc_previous_lsbs_[kNumPots];
+uint8_t Ui::adc_noise_[kNumPots];
 uint8_t Ui::adc_thresholds_[kNumPots];
 uint8_t Ui::scanned_pot_;
+uint8_t Ui::converted_pot_;
+uint8_t Ui::moving_pot_ = kNumPots;
+uint8_t Ui::moving_pot_timeout_;
+uint16_t Ui::adc_sum_;
+uint16_t Ui::falling_pots_;
 uint8_t Ui::pot_scanning_warm_up_ = 16;
 bool Ui::busy_ = false;
 bool Ui::snapped_[kNumPots];
@@ -134,30 +148,90 @@ void Ui::Poll() {
     }
   }
   
-  // Read pot value and launch ADC scan.
-  uint16_t adc_value = adc.ReadOut();
-  int16_t delta = adc_values_[scanned_pot_] - adc_value;
-  if (delta < 0) {
+  // Read pot value and launch ADC scan. The conversions made since the
+  // previous call are averaged, which makes a pot left alone less noisy
+  // without delaying the reading of a pot being moved.
+  uint8_t pot = converted_pot_;
+  uint16_t adc_value = (adc_sum_ + adc.ReadOut() +
+      (1 << (kPotOversamplingShift - 1))) >> kPotOversamplingShift;
+  adc_sum_ = 0;
+  // Consecutive readings of a pot left alone are close, so the low byte of
+  // the last one is enough to measure their deviation.
+  int16_t step = static_cast<int8_t>(adc_value - adc_previous_lsbs_[pot]);
+  adc_previous_lsbs_[pot] = adc_value;
+  bool moving = pot == moving_pot_;
+  uint16_t mask = 1 << pot;
+  int16_t delta = adc_value - adc_values_[pot];
+  bool falling = delta < 0;
+  if (falling) {
     delta = -delta;
   }
-  if (delta >= adc_thresholds_[scanned_pot_]) {
-    adc_values_[scanned_pot_] = adc_value;
+  // A pot turned further in the direction of its last event posts an event
+  // as soon as it crosses the threshold, lowered by 1 LSB since the readings
+  // are averaged. A reversal must also exceed the noise level of the pot
+  // (mean deviation between consecutive readings, with 4 bits of fractional
+  // part, measured while the pot posts no event): the last event of a noisy
+  // pot left alone was posted at a peak of the noise, and the next peak in
+  // the other direction must not post another one. The widening is capped,
+  // so that a very noisy pot can still be turned back.
+  uint8_t threshold = adc_thresholds_[pot] - 1;
+  bool reversal = falling != ((falling_pots_ & mask) != 0);
+  if (reversal) {
+    uint8_t noise_threshold = adc_noise_[pot] >> 2;
+    if (noise_threshold > kMaxNoiseThreshold) {
+      noise_threshold = kMaxNoiseThreshold;
+    }
+    threshold += noise_threshold + 1;
+  }
+  if (delta >= threshold) {
+    adc_values_[pot] = adc_value;
+    if (falling) {
+      falling_pots_ |= mask;
+    } else {
+      falling_pots_ &= ~mask;
+    }
     // Do not post events in the queue until 16 scanning cycles have been
     // performed.
     if (!pot_scanning_warm_up_) {
-      queue_.AddEvent(CONTROL_POT, scanned_pot_, adc_value >> 2);
+      queue_.AddEvent(CONTROL_POT, pot, adc_value >> 2);
+      // A single reversal is more likely noise than a pot being turned.
+      if (moving || !reversal) {
+        moving_pot_ = pot;
+        moving_pot_timeout_ = kMovingPotTimeout;
+      }
+    }
+  } else if (!pot_scanning_warm_up_) {
+    if (moving) {
+      --moving_pot_timeout_;
+      if (!moving_pot_timeout_) {
+        moving_pot_ = kNumPots;
+      }
     }
+    if (step < 0) {
+      step = -step;
+    }
+    uint8_t noise = step > 15 ? 255 : step << 4;
+    adc_noise_[pot] += (noise - adc_noise_[pot]) >> 3;
   }
   mux_bank1_ss.High();
   mux_bank2_ss.High();
-  ++scanned_pot_;
-  if (scanned_pot_ == kNumPots) {
-    scanned_pot_ = 0;
-    if (pot_scanning_warm_up_) {
-      --pot_scanning_warm_up_;
+  
+  // Scans of the pot being moved are interleaved with the round-robin scan of
+  // all pots, so that it is sampled at half the polling rate.
+  if (moving_pot_ != kNumPots && pot != moving_pot_) {
+    pot = moving_pot_;
+  } else {
+    ++scanned_pot_;
+    if (scanned_pot_ == kNumPots) {
+      scanned_pot_ = 0;
+      if (pot_scanning_warm_up_) {
+        --pot_scanning_warm_up_;
+      }
     }
+    pot = scanned_pot_;
   }
-  uint8_t address = pots_layout[scanned_pot_];
+  converted_pot_ = pot;
+  uint8_t address = pots_layout[pot];
   if (address & 0x08) {
     mux_bank2_ss.Low();
   } else {
@@ -168,6 +242,12 @@ void Ui::Poll() {
   adc.StartConversion(kAdcInputMux);
 }
 
+/* static */
+void Ui::OversamplePot() {
+  adc_sum_ += adc.ReadOut();
+  adc.StartConversion(kAdcInputMux);
+}
+
 /* static */
 void Ui::UnlockPot(uint8_t index) {
   if (index < kNumSoftPots) {
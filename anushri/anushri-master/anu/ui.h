@@ -74,12 +74,18 @@ enum DisplayMode {
 const uint8_t kNumPots = 14;
 const uint8_t kNumSwitches = 6;
 
+// Each call of Ui::Poll() averages 1 << kPotOversamplingShift conversions of
+// the pot being scanned: its own, and the ones of Ui::OversamplePot(), called
+// by the timer ISR in between.
+const uint8_t kPotOversamplingShift = 3;
+
 class Ui {
  public:
   Ui() { }
   
   static void Init();
   static void Poll();
+  static void OversamplePot();
   static void DoEvents();
   static void FlushEvents() {
     queue_.Flush();
@@ -97,6 +103,8 @@ class Ui {
   static void LockPots(bool snap);
   
   static uint16_t adc_values_[kNumPots];
+  static uint8_t adc_previous_lsbs_[kNumPots];
+  static uint8_t adc_noise_[kNumPots];
   static uint8_t adc_thresholds_[kNumPots];
   static bool snapped_[kNumPots];
   static int16_t snap_position_cache_[kNumPots];
@@ -106,6 +114,11 @@ class Ui {
   static uint8_t inhibit_switch_;
   static uint8_t display_mode_;
   static uint8_t scanned_pot_;
+  static uint8_t converted_pot_;
+  static uint8_t moving_pot_;
+  static uint8_t moving_pot_timeout_;
+  static uint16_t adc_sum_;
+  static uint16_t falling_pots_;
   static uint8_t pot_scanning_warm_up_;
   static bool busy_;
   static int8_t display_snap_delta_;
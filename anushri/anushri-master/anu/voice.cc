@@ -73,6 +73,7 @@ void Voice::Init() {
   locked_ = false;
   dirty_ = false;
   retriggered_ = false;
+  trigger_delay_ = 0;
   volume_ = 240;
 
   ResetAllControllers();
@@ -161,12 +162,6 @@ void Voice::ResetAllControllers() {
   mod_aftertoutch_ = 0;
 }
 
-void Voice::Refresh() {
-  while (writable()) {
-    WriteDACStateSample();
-  }
-}
-
 void Voice::WriteDACStateSample() {
   uint8_t w = dac_state_write_ptr_;
       
@@ -270,12 +265,14 @@ void Voice::WriteDACStateSample() {
   vca_envelope = U16U8MulShift8(vca_envelope, volume_);
   dac_state_buffer_[w].vca_cv = U16ShiftRight4(vca_envelope);
   dac_state_write_ptr_ = (w + 1) & (kDACStateBufferSize - 1);
+  ++dac_write_count_;
 }
 
 void Voice::GateOn() {
   vca_envelope_.Trigger(ENV_SEGMENT_ATTACK);
   vcf_envelope_.Trigger(ENV_SEGMENT_ATTACK);
   mod_envelope_.Trigger(ENV_SEGMENT_ATTACK);
+  AdvanceEnvelopes();
   if (gate()) {
     retriggered_ = true;
   }
@@ -285,6 +282,15 @@ void Voice::GateOff() {
   vca_envelope_.Trigger(ENV_SEGMENT_RELEASE);
   vcf_envelope_.Trigger(ENV_SEGMENT_RELEASE);
   mod_envelope_.Trigger(ENV_SEGMENT_RELEASE);
+  AdvanceEnvelopes();
+}
+
+void Voice::AdvanceEnvelopes() {
+  if (trigger_delay_) {
+    vca_envelope_.Advance(trigger_delay_);
+    vcf_envelope_.Advance(trigger_delay_);
+    mod_envelope_.Advance(trigger_delay_);
+  }
 }
 
 void Voice::NoteOn(
@@ -313,8 +319,10 @@ void Voice::NoteOn(
   uint16_t slide_time = patch_.kbd_glide + slide;
   if (slide_time > 255) {
     patch_.kbd_glide = 255;
+    slide_time = 255;
   }
-  pitch_increment_ = pgm_read_word(lut_res_glide_increments + slide_time);
+  pitch_increment_ = ResourcesManager::LookupDelta2(
+      lut_res_glide_increments, lut_res_glide_increments_blocks, slide_time);
   pitch_counter_ = 0;
 }
 
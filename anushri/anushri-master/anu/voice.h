@@ -112,7 +112,7 @@ class Voice {
   Voice() { }
   ~Voice() { }
   void Init();
-  void Refresh();
+  void WriteDACStateSample();
   
   void NoteOn(
       uint8_t note,
@@ -128,6 +128,10 @@ class Voice {
   void ResetAllControllers();
   void GateOn();
   void GateOff();
+
+  // The envelopes triggered by GateOn() and GateOff() are rendered ahead by
+  // this delay, in 1/16th of a DAC state sample.
+  inline void set_trigger_delay(uint8_t delay) { trigger_delay_ = delay; }
   
   void SetValue(uint8_t offset, uint8_t value);
   uint8_t GetValue(uint8_t offset) const {
@@ -154,9 +158,15 @@ class Voice {
   inline void set_lfo_pll_target_phase(uint8_t step) {
     if (patch_.lfo_rate < 2) {
       lfo_.set_target_phase(static_cast<uint16_t>(step) * 2730);
+    } else {
+      lfo_.ResetSync();
     }
   }
   
+  inline void ResetLfoSync() {
+    lfo_.ResetSync();
+  }
+  
   void SavePatch();
   void ResetToFactoryDefaults();
   
@@ -173,9 +183,15 @@ class Voice {
       uint8_t r = dac_state_read_ptr_;
       dac_state_ = dac_state_buffer_[r];
       dac_state_read_ptr_ = (r + 1) & (kDACStateBufferSize - 1);
+      ++dac_read_count_;
     }
   }
   
+  // Number of DAC state samples written and read so far. The n-th sample
+  // written is sent to the DACs when dac_read_count() reaches n.
+  inline uint8_t dac_write_count() const { return dac_write_count_; }
+  inline uint8_t dac_read_count() const { return dac_read_count_; }
+  
   inline uint8_t writable() const {
     return (dac_state_read_ptr_ - dac_state_write_ptr_ - 1) & \
         (kDACStateBufferSize - 1);
@@ -199,8 +215,8 @@ class Voice {
   }
   
  private:
-  void WriteDACStateSample();
   void UpdateEnvelopeParameters();
+  void AdvanceEnvelopes();
    
   Patch patch_;
   Lfo lfo_;
@@ -243,6 +259,9 @@ class Voice {
   DACState dac_state_buffer_[kDACStateBufferSize];
   uint8_t dac_state_read_ptr_;
   uint8_t dac_state_write_ptr_;
+  uint8_t dac_read_count_;
+  uint8_t trigger_delay_;
+  uint8_t dac_write_count_;
   
   DISALLOW_COPY_AND_ASSIGN(Voice);
 };
@@ -54,6 +54,10 @@ uint8_t VoiceController::arp_pattern_step_;
 int8_t VoiceController::arp_direction_;
 int8_t VoiceController::arp_step_;
 int8_t VoiceController::arp_octave_;
+uint8_t VoiceController::arp_plan_[kMaxArpeggiatorPlanSize];
+uint8_t VoiceController::arp_plan_size_;
+uint8_t VoiceController::arp_plan_position_;
+uint8_t VoiceController::arp_plan_num_notes_;
 uint8_t VoiceController::lfo_sync_counter_;
 
 uint8_t VoiceController::drum_sequencer_step_;
@@ -85,8 +89,8 @@ static const prog_SequencerSettings init_seq_settings PROGMEM = {
   // Acidity
   0,
   
-  // Padding
-  0, 0,
+  // Sequence and length of the chain
+  0, 1,
 };
 
 static const prog_Sequence init_sequence PROGMEM = {
@@ -110,6 +114,8 @@ struct StorageLayout<SequencerSettings> {
   }
 };
 
+// Sequences used to be stored, uncompressed, at the beginning of what is now
+// the sequence bank. This is only used to convert them.
 template<>
 struct StorageLayout<Sequence> {
   static uint8_t* eeprom_address() { 
@@ -128,7 +134,12 @@ void VoiceController::Init() {
   STATIC_ASSERT(sizeof(SequencerSettings) == PRM_SEQ_LAST);
   
   storage.Load(&seq_settings_);
-  storage.Load(&sequence_);
+  if (!sequence_bank.Init()) {
+    storage.Load(&sequence_);
+    sequence_bank.Format();
+    sequence_bank.Save(0, &sequence_);
+  }
+  TouchSequence();
   pressed_keys_.Init();
   voice_.Init();
 
@@ -181,6 +192,7 @@ void VoiceController::SetValue(uint8_t offset, uint8_t value) {
     if (offset == PRM_SEQ_ARP_MODE) {
       arp_direction_ = \
           seq_settings_.arp_direction() == ARPEGGIO_DIRECTION_DOWN ? -1 : 1;
+      arp_plan_num_notes_ = 0xff;
     } else if (offset >= PRM_SEQ_TEMPO && offset <= PRM_SEQ_SWING) {
       TouchClock();
     } else if (offset >= PRM_SEQ_DRUMS_BD_TONE && \
@@ -190,6 +202,8 @@ void VoiceController::SetValue(uint8_t offset, uint8_t value) {
     else if (offset >= PRM_SEQ_DRUMS_BALANCE && \
              offset <= PRM_SEQ_DRUMS_BANDWIDTH) {
       RefreshDrumSynthMixing();
+    } else if (offset >= PRM_SEQ_SEQUENCE) {
+      TouchSequence();
     }
   }
 }
@@ -199,7 +213,7 @@ void VoiceController::NoteOn(uint8_t note, uint8_t velocity) {
   if (velocity == 0) {
     NoteOff(note);
   } else {
-    if (sequencer_running_ && sequence_.num_notes) {
+    if (sequencer_playing()) {
       // Note is interpreted as transposition/velocity for sequencer.
       sequencer_transposition_ = note - 60;
       sequencer_velocity_ = velocity;
@@ -227,8 +241,7 @@ void VoiceController::NoteOn(uint8_t note, uint8_t velocity) {
 /* static */
 void VoiceController::NoteOff(uint8_t note) {
   // Note off messages are ignored when the sequencer is running.
-  if (!(sequencer_running_ && sequence_.num_notes)
-      && !ignore_note_off_messages_) {
+  if (!sequencer_playing() && !ignore_note_off_messages_) {
     if (seq_settings_.arp_mode == 0) {
       // Normal play mode.
       uint8_t top_note = pressed_keys_.most_recent_note().note;
@@ -351,20 +364,37 @@ void VoiceController::StartClock() {
   clock.Reset();
   clock_counter_ = 0;
   lfo_sync_counter_ = 0;
+  voice_.ResetLfoSync();
   clock_running_ = true;
   midi_dispatcher.OnStart();
 }
 
+/* static */
+void VoiceController::ContinueClock() {
+  // The LFO phase is set again by the next pulse.
+  voice_.ResetLfoSync();
+  clock_running_ = true;
+  midi_dispatcher.OnContinue();
+}
 
 /* static */
 void VoiceController::StartSequencer() {
-  if (!(pressed_keys_.size() && sequence_.num_notes == 0)) {
+  if (sequencer_recording_) {
+    StopRecording();
+  }
+  sequence_bank.Rewind();
+  if (!(pressed_keys_.size() && sequence_bank.empty())) {
     AllSoundOff();
   }
+  sequencer_note_ = 0;
+  sequencer_running_ = true;
+}
+
+/* static */
+void VoiceController::ContinueSequencer() {
   if (sequencer_recording_) {
     StopRecording();
   }
-  sequencer_note_ = 0;
   sequencer_running_ = true;
 }
 
@@ -377,6 +407,7 @@ void VoiceController::StartArpeggiator() {
   arp_direction_ = \
       seq_settings_.arp_direction() == ARPEGGIO_DIRECTION_DOWN ? -1 : 1;
   ResetArpeggiatorPattern();
+  arp_plan_num_notes_ = 0xff;
 }
 
 /* static */
@@ -409,11 +440,13 @@ void VoiceController::StopArpeggiator() {
 
 /* static */
 void VoiceController::ClockSequencer() {
-  if (!sequence_.num_notes || !sequencer_running_) {
+  if (!sequencer_playing()) {
     return;
   }
   
-  int16_t note = sequence_.notes[sequencer_note_];
+  // The step has been decoded at the previous clock tick.
+  const SequenceStep& step = sequence_bank.step();
+  int16_t note = step.note;
   if (note == 0xff) {
     // Rest.
     voice_.NoteOff(previous_generated_note_);
@@ -422,11 +455,9 @@ void VoiceController::ClockSequencer() {
   } else if (note == 0xfe) {
     // Tie: do nothing!
   } else {
-    uint8_t accent_slide_index = sequencer_note_ >> 3;
-    uint8_t accent_slide_mask = 1 << (sequencer_note_ & 0x7);
     note += sequencer_transposition_;
-    bool slid = sequence_.slides[accent_slide_index] & accent_slide_mask;
-    bool accented = sequence_.accents[accent_slide_index] & accent_slide_mask;
+    bool slid = step.slide;
+    bool accented = step.accent;
     
     // When the sequencer note is slid, the note emitted on the MIDI out will
     // overlap with the previous note, to allow an external sound module to
@@ -449,10 +480,8 @@ void VoiceController::ClockSequencer() {
     previous_generated_note_ = note;
   }
   
-  ++sequencer_note_;
-  if (sequencer_note_ >= sequence_.num_notes) {
-    sequencer_note_ = 0;
-  }
+  sequencer_note_ = step.position + 1;
+  sequence_bank.Advance();
 }
 
 uint8_t drums_midi_notes[] = { 36, 38, 42 };
@@ -478,9 +507,9 @@ void VoiceController::ClockDrumMachine() {
       }
       
       if (level > threshold) {
-        uint8_t level = 128 + (level >> 1);
-        drum_synth.Trigger(i, level);
-        midi_dispatcher.OnDrumNote(drums_midi_notes[i], level >> 1);
+        uint8_t velocity = 128 + (level >> 1);
+        drum_synth.Trigger(i, velocity);
+        midi_dispatcher.OnDrumNote(drums_midi_notes[i], velocity >> 1);
       }
       override_mask <<= 1;
     }
@@ -511,7 +540,21 @@ void VoiceController::ClockArpeggiator() {
 
     // Trigger notes only if the arp is on, and if keys are pressed.
     if (has_arpeggiator_note) {
-      StepArpeggiator();
+      if (arp_plan_num_notes_ != pressed_keys_.size()) {
+        CompileArpeggiatorPlan();
+      }
+      if (arp_plan_size_) {
+        uint8_t state = arp_plan_[arp_plan_position_];
+        ++arp_plan_position_;
+        if (arp_plan_position_ == arp_plan_size_) {
+          arp_plan_position_ = 0;
+        }
+        arp_step_ = state & 0x0f;
+        arp_octave_ = (state >> 4) & 0x07;
+        arp_direction_ = (state & 0x80) ? -1 : 1;
+      } else {
+        StepArpeggiator();
+      }
       const NoteEntry& arpeggio_note = pressed_keys_.sorted_note(arp_step_);
       uint8_t note = arpeggio_note.note;
       uint8_t velocity = arpeggio_note.velocity;
@@ -606,12 +649,48 @@ void VoiceController::StepArpeggiator() {
   }
 }
 
+/* static */
+void VoiceController::CompileArpeggiatorPlan() {
+  // Unless the direction is random, the arpeggiator state (step, octave and
+  // direction) cycles with a period which depends only on the number of held
+  // notes and the arpeggiator mode. One full cycle, starting from the current
+  // state, is computed here so that each clock only reads the next entry.
+  arp_plan_size_ = 0;
+  arp_plan_position_ = 0;
+  arp_plan_num_notes_ = pressed_keys_.size();
+  if (seq_settings_.arp_direction() == ARPEGGIO_DIRECTION_RANDOM) {
+    return;
+  }
+  int8_t step = arp_step_;
+  int8_t octave = arp_octave_;
+  int8_t direction = arp_direction_;
+  
+  StepArpeggiator();
+  uint8_t first_state = arpeggiator_state();
+  uint8_t state = first_state;
+  do {
+    arp_plan_[arp_plan_size_++] = state;
+    StepArpeggiator();
+    state = arpeggiator_state();
+  } while (state != first_state && arp_plan_size_ < kMaxArpeggiatorPlanSize);
+  if (state != first_state) {
+    // Should not happen (the longest cycle is 62 steps with 16 notes in
+    // up/down mode on 2 octaves) - fall back to stepping at each clock.
+    arp_plan_size_ = 0;
+  }
+  
+  arp_step_ = step;
+  arp_octave_ = octave;
+  arp_direction_ = direction;
+}
+
 /* static */
 void VoiceController::StartRecording() {
   Stop();
   StopArpeggiator();
   seq_settings_.arp_mode = 0;
   sequencer_recording_ = true;
+  sequence_bank.Flush();
   memset(&sequence_, 0, sizeof(Sequence));
 }
 
@@ -626,7 +705,18 @@ void VoiceController::StopRecording() {
 
 /* static */
 void VoiceController::SaveSequence() {
-  storage.Save(sequence_);
+  sequence_bank.Save(seq_settings_.sequence, &sequence_);
+  sequence_bank.SetChain(seq_settings_.sequence, seq_settings_.sequence_chain);
+}
+
+/* static */
+void VoiceController::TouchSequence() {
+  // While recording, the sequence being recorded will be saved in the newly
+  // selected slot.
+  if (!sequencer_recording_) {
+    sequence_bank.Load(seq_settings_.sequence, &sequence_);
+  }
+  sequence_bank.SetChain(seq_settings_.sequence, seq_settings_.sequence_chain);
 }
 
 /* static */
@@ -641,7 +731,9 @@ void VoiceController::SavePatch() {
 /* static */
 void VoiceController::ResetToFactoryDefaults() {
   storage.ResetToFactoryDefaults(&seq_settings_);
-  storage.ResetToFactoryDefaults(&sequence_);
+  memcpy_P(&sequence_, &init_sequence, sizeof(Sequence));
+  sequence_bank.Format();
+  SaveSequence();
   voice_.ResetToFactoryDefaults();
 }
 
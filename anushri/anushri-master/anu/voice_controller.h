@@ -22,11 +22,13 @@
 #include "anu/envelope.h"
 #include "anu/lfo.h"
 #include "anu/note_stack.h"
+#include "anu/sequence_bank.h"
 #include "anu/voice.h"
 
 namespace anu {
 
 static const uint8_t kNumDrumParts = 3;
+static const uint8_t kMaxArpeggiatorPlanSize = 64;
 
 enum ArpeggiatorDirection {
   ARPEGGIO_DIRECTION_UP = 0,
@@ -59,8 +61,8 @@ enum SequencerSettingsParameter {
   PRM_SEQ_DRUMS_HH_PATTERN_L,
   PRM_SEQ_DRUMS_HH_PATTERN_H,
   PRM_SEQ_ARP_ACIDITY,
-  PRM_SEQ_PADDING_1,
-  PRM_SEQ_PADDING_2,
+  PRM_SEQ_SEQUENCE,
+  PRM_SEQ_SEQUENCE_CHAIN,
   PRM_SEQ_LAST
 };
 
@@ -81,7 +83,8 @@ struct SequencerSettings {
   uint16_t drums_pattern[kNumDrumParts];
   
   uint8_t acidity;
-  uint8_t padding[2];
+  uint8_t sequence;
+  uint8_t sequence_chain;
   
   inline uint8_t arp_range() const { return ((arp_mode - 1) & 0x01) + 1; }
   inline uint8_t arp_direction() const { return (arp_mode - 1) >> 1; }
@@ -92,13 +95,6 @@ struct SequencerSettings {
   }
 };
 
-struct Sequence {
-  uint8_t num_notes;
-  uint8_t notes[128];
-  uint8_t accents[16];
-  uint8_t slides[16];
-};
-
 class VoiceController {
  public:
   VoiceController() { }
@@ -120,6 +116,17 @@ class VoiceController {
     StartSequencer();
     StartDrumMachine();
   }
+  static inline void Continue() {
+    // The sequencer, drum machine, arpeggiator and LFO resume from where they
+    // were stopped, or from the song position.
+    ContinueClock();
+    ContinueSequencer();
+  }
+  static inline void SongPosition(uint16_t position) {
+    // The position is in 16th notes, and the LFO cycle is a quarter note.
+    lfo_sync_counter_ = (position & 3) * 6;
+    voice_.ResetLfoSync();
+  }
   static inline void Stop() {
     StopSequencer();
     StopClock();
@@ -127,14 +134,14 @@ class VoiceController {
   
   static inline void InsertRest() {
     sequence_.notes[sequence_.num_notes++] = 0xff;
-    if (sequence_.num_notes == 128) {
+    if (sequence_.num_notes == kMaxSequenceLength) {
       StopRecording();
     }
   };
   
   static inline void InsertTie() {
     sequence_.notes[sequence_.num_notes++] = 0xfe;
-    if (sequence_.num_notes == 128) {
+    if (sequence_.num_notes == kMaxSequenceLength) {
       StopRecording();
     }
   };
@@ -159,7 +166,11 @@ class VoiceController {
   
   static inline const Voice& voice() { return voice_; }
   static inline Voice* mutable_voice() { return &voice_; }
-  static inline Sequence* mutable_sequence() { return &sequence_; }
+  static inline Sequence* mutable_sequence() {
+    // The sequence is read until the end of the save in progress.
+    sequence_bank.Flush();
+    return &sequence_;
+  }
   static inline SequencerSettings* mutable_sequencer_settings() {
     return &seq_settings_;
   }
@@ -207,15 +218,25 @@ class VoiceController {
   static void ResetArpeggiatorPattern();
 
   static void StartClock();
+  static void ContinueClock();
   static void StopClock();
   static void StartArpeggiator();
   static void ClockArpeggiator();
   static void StopArpeggiator();
   static void StepArpeggiator();
+  static void CompileArpeggiatorPlan();
+  static inline uint8_t arpeggiator_state() {
+    return arp_step_ | (arp_octave_ << 4) | (arp_direction_ < 0 ? 0x80 : 0);
+  }
 
   static void StartSequencer();
+  static void ContinueSequencer();
   static void ClockSequencer();
   static void StopSequencer();
+  static void TouchSequence();
+  static inline bool sequencer_playing() {
+    return sequencer_running_ && !sequence_bank.empty();
+  }
   
   static void StartDrumMachine();
   static void ClockDrumMachine();
@@ -253,6 +274,10 @@ class VoiceController {
   static int8_t arp_direction_;
   static int8_t arp_step_;
   static int8_t arp_octave_;
+  static uint8_t arp_plan_[kMaxArpeggiatorPlanSize];
+  static uint8_t arp_plan_size_;
+  static uint8_t arp_plan_position_;
+  static uint8_t arp_plan_num_notes_;
   
   static uint8_t drum_sequencer_step_;
   static uint8_t drum_sequencer_perturbation_[kNumDrumParts];
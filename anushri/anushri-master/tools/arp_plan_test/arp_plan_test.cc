@@ -0,0 +1,187 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Equivalence test of the arpeggiator step plan.
+//
+// VoiceController::ClockArpeggiator() is run twice on the same scripted
+// input, with the same random seed: once reading the step plan, and once
+// with the plan disabled before each clock, which makes it call
+// StepArpeggiator() as it did before the plan. The script holds 1 to 16
+// notes, starts in a random mode, pattern and acidity, presses and releases
+// notes and changes the mode while the arpeggiator runs. The notes played
+// and the arpeggiator states (step, octave, direction) must be identical.
+//
+// The time taken by ClockArpeggiator() is also given, for 16 notes in up and
+// down mode on 2 octaves, which has the longest cycle. It is measured on the
+// host, so it only tells the order of magnitude of the saving on the AVR.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile arp_plan_test
+//   build/tools/arp_plan_test [--runs n]
+
+#include "anu/drum_synth.h"
+#include "anu/system_settings.h"
+
+#include "avrlib/random.h"
+
+// The test drives the arpeggiator directly and disables its plan.
+#define private public
+#include "anu/voice_controller.h"
+#undef private
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+using namespace anu;
+using namespace avrlib;
+
+namespace {
+
+const uint16_t kNumClocks = 400;
+const uint8_t kNumArpModes = 8;  // Mode 0 is off.
+
+struct Step {
+  uint8_t note;
+  uint8_t state;
+};
+
+void PressRandomNote() {
+  voice_controller.NoteOn(36 + rand() % 48, 1 + rand() % 127);
+}
+
+void ReleaseRandomNote() {
+  uint8_t size = voice_controller.pressed_keys_.size();
+  if (size) {
+    const NoteEntry& e = voice_controller.pressed_keys_.sorted_note(
+        rand() % size);
+    voice_controller.NoteOff(e.note);
+  }
+}
+
+void Run(uint32_t seed, bool planned, Step* steps) {
+  voice_controller.Init();
+  srand(seed);
+  Random::Seed(seed + 1);
+  voice_controller.SetValue(PRM_SEQ_ARP_MODE, 1 + rand() % kNumArpModes);
+  voice_controller.SetValue(
+      PRM_SEQ_ARP_PATTERN, rand() % LUT_RES_ARPEGGIATOR_PATTERNS_SIZE);
+  voice_controller.SetValue(PRM_SEQ_ARP_ACIDITY, rand() % 128);
+  uint8_t num_notes = 1 + rand() % 16;
+  while (voice_controller.pressed_keys_.size() < num_notes) {
+    PressRandomNote();
+  }
+  voice_controller.StartArpeggiator();
+  for (uint16_t i = 0; i < kNumClocks; ++i) {
+    uint8_t r = rand() % 64;
+    if (r == 0) {
+      PressRandomNote();
+    } else if (r == 1) {
+      ReleaseRandomNote();
+    } else if (r == 2) {
+      voice_controller.SetValue(PRM_SEQ_ARP_MODE, 1 + rand() % kNumArpModes);
+    }
+    if (!planned) {
+      voice_controller.arp_plan_num_notes_ =
+          voice_controller.pressed_keys_.size();
+      voice_controller.arp_plan_size_ = 0;
+    }
+    voice_controller.ClockArpeggiator();
+    steps[i].note = voice_controller.previous_generated_note_;
+    steps[i].state = voice_controller.arpeggiator_state();
+  }
+}
+
+double HostSeconds() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+double Benchmark(bool planned) {
+  const uint32_t kNumBenchmarkClocks = 1000000;
+  voice_controller.Init();
+  Random::Seed(1);
+  voice_controller.SetValue(PRM_SEQ_ARP_MODE, 1 + 2 * 2 + 1);  // Up/down, 2 oct
+  voice_controller.SetValue(PRM_SEQ_ARP_PATTERN, 0);  // All steps
+  for (uint8_t i = 0; i < 16; ++i) {
+    voice_controller.NoteOn(48 + i, 100);
+  }
+  voice_controller.StartArpeggiator();
+  double start = HostSeconds();
+  for (uint32_t i = 0; i < kNumBenchmarkClocks; ++i) {
+    if (!planned) {
+      voice_controller.arp_plan_num_notes_ = 16;
+      voice_controller.arp_plan_size_ = 0;
+    }
+    voice_controller.ClockArpeggiator();
+  }
+  return (HostSeconds() - start) / kNumBenchmarkClocks * 1e9;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t num_runs = 20000;
+  if (argc == 3 && !strcmp(argv[1], "--runs")) {
+    num_runs = atoi(argv[2]);
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: arp_plan_test [--runs n]\n");
+    return 1;
+  }
+
+  // As Init() in anu/anu.cc.
+  system_settings.Init();
+  drum_synth.Init();
+  voice_controller.Init();
+
+  static Step stepped[kNumClocks];
+  static Step planned[kNumClocks];
+  uint32_t failures = 0;
+  uint32_t num_notes_played = 0;
+  for (uint32_t run = 0; run < num_runs; ++run) {
+    Run(run, false, stepped);
+    Run(run, true, planned);
+    for (uint16_t i = 0; i < kNumClocks; ++i) {
+      if (stepped[i].note != 0xff) {
+        ++num_notes_played;
+      }
+    }
+    if (memcmp(stepped, planned, sizeof(stepped))) {
+      for (uint16_t i = 0; i < kNumClocks; ++i) {
+        if (memcmp(&stepped[i], &planned[i], sizeof(Step))) {
+          printf("run %u, clock %u: note %d state %02x, %d %02x without plan\n",
+                 run, i, planned[i].note, planned[i].state, stepped[i].note,
+                 stepped[i].state);
+          break;
+        }
+      }
+      ++failures;
+    }
+  }
+  printf("%u runs of %u clocks, %u notes: %u differ\n",
+         num_runs, kNumClocks, num_notes_played, failures);
+
+  Benchmark(true);  // Warm-up
+  double stepped_time = Benchmark(false);
+  double planned_time = Benchmark(true);
+  printf("ClockArpeggiator(), 16 notes, up/down, 2 octaves: "
+         "%.1f ns stepped, %.1f ns planned (host)\n",
+         stepped_time, planned_time);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,536 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Simulation of the interleaving of the main loop and of the audio output
+// interrupt, under scripted MIDI and UI load.
+//
+// The main loop is modelled task by task, as in main() in anu/anu.cc, each
+// task costing a number of CPU cycles, while the 39kHz interrupt reads one
+// sample of the audio buffer every 510 cycles. The interrupts take their
+// share of the CPU first. Two versions of the loop are compared:
+//   before   the drums are rendered once per iteration, before the clock
+//            events, the MIDI input and the UI are handled.
+//   after    the drums are also rendered between MIDI input bytes and before
+//            ui.DoEvents(), whenever a block is free.
+//
+// The costs are estimates from the code of each task, they are not measured.
+// The headroom is the factor by which all of them can grow before the first
+// underrun, it tells how much the result depends on them. Blocking EEPROM
+// writes (3.4ms per byte) are not scaled.
+//
+// For each load, the underrun probability is the share of 10ms windows in
+// which at least one sample was held; the number of underruns is the count
+// the firmware keeps in audio_underruns.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile audio_load_sim
+//   build/tools/audio_load_sim            prints the table
+//   build/tools/audio_load_sim --check    exits with an error if the loop
+//                                         underruns under a load without
+//                                         blocking EEPROM writes, or has less
+//                                         headroom than before
+
+#include "anu/audio_buffer.h"
+#include "anu/voice.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace anu;
+
+namespace {
+
+const uint32_t kCyclesPerSample = 510;  // Timer2, phase correct PWM
+const uint32_t kCyclesPerDacSample = 8160;  // Every other Timer0 interrupt
+const uint32_t kCyclesPerMidiByte = F_CPU / 3125;
+const uint32_t kCyclesPerEepromWrite = F_CPU / 1000 * 34 / 10;
+const uint32_t kCyclesPerWindow = F_CPU / 100;
+const double kSimulatedSeconds = 20.0;
+
+// Share of the CPU left to the main loop: the Timer2 interrupt (clock tick,
+// audio sample) and the Timer0 interrupt (DAC update every other call, MIDI
+// and shift registers).
+const double kMainLoopShare = 1.0 - 80.0 / 510.0 - 450.0 / 4080.0;
+
+// Estimated costs of the main loop tasks, in cycles.
+const uint32_t kRenderBlockCycles = 3200;  // 32 samples, 3 drums
+const uint32_t kDacSampleCycles = 900;  // Voice::WriteDACStateSample()
+const uint32_t kClockEventCycles = 1500;  // VoiceController::Clock()
+const uint32_t kMidiByteCycles = 100;  // Parser
+const uint32_t kNoteOnCycles = 1500;
+const uint32_t kNoteOffCycles = 800;
+const uint32_t kControlChangeCycles = 600;
+const uint32_t kSysExByteCycles = 150;  // Nibble decoding, checksum
+const uint32_t kSysExAcceptCycles = 2000;
+const uint32_t kTunerCycles = 60;
+const uint32_t kSequenceBankCycles = 40;
+const uint32_t kUiIdleCycles = 200;
+const uint32_t kUiEventCycles = 2500;  // Pot move, parameter update
+const uint32_t kLoopCycles = 100;
+
+// The buffer holds one sample less than its size.
+const uint16_t kAudioBufferCapacity = AudioBufferSpecs::buffer_size - 1;
+const uint8_t kMidiBufferSize = 32;
+
+// Fixed size arrays: the host build packs structures, as avr-gcc does, which
+// the standard containers do not support.
+const uint32_t kMaxMidiBytes = 80000;
+const uint32_t kMaxUiEvents = 20000;
+
+enum LoopVersion {
+  LOOP_BEFORE,
+  LOOP_AFTER
+};
+
+// Scripted input.
+
+struct MidiByte {
+  uint64_t time;
+  uint8_t byte;
+};
+
+struct Script {
+  MidiByte midi[kMaxMidiBytes];
+  uint32_t num_midi_bytes;
+  uint64_t ui_events[kMaxUiEvents];
+  uint32_t num_ui_events;
+  uint32_t sysex_eeprom_writes;  // At the end of each SysEx message
+};
+
+uint64_t Seconds(double s) {
+  return static_cast<uint64_t>(s * F_CPU);
+}
+
+// Bytes are sent back to back from the given time, or later if the line is
+// busy.
+void SendMidi(Script* script, uint64_t time, const uint8_t* data, uint8_t n) {
+  uint64_t t = time;
+  if (script->num_midi_bytes) {
+    uint64_t line_free = script->midi[script->num_midi_bytes - 1].time +
+        kCyclesPerMidiByte;
+    if (line_free > t) {
+      t = line_free;
+    }
+  }
+  for (uint8_t i = 0; i < n && script->num_midi_bytes < kMaxMidiBytes; ++i) {
+    MidiByte& b = script->midi[script->num_midi_bytes++];
+    b.time = t;
+    b.byte = data[i];
+    t += kCyclesPerMidiByte;
+  }
+}
+
+uint64_t Jitter() {
+  return rand() % (F_CPU / 1000);
+}
+
+void ScriptNotes(Script* script) {
+  // 16th notes at 140 BPM on the voice channel, drum notes on channel 10.
+  double step = 60.0 / 140.0 / 4.0;
+  for (double t = 0.0; t < kSimulatedSeconds; t += step) {
+    uint8_t note = 48 + rand() % 24;
+    uint8_t drum = 36 + rand() % 8;
+    uint8_t on[] = { 0x90, note, 100, 0x99, drum, 100 };
+    SendMidi(script, Seconds(t) + Jitter(), on, sizeof(on));
+    uint8_t off[] = { 0x80, note, 0 };
+    SendMidi(script, Seconds(t + step / 2.0) + Jitter(), off, sizeof(off));
+  }
+}
+
+void ScriptControlChanges(Script* script) {
+  // The line is full of control changes.
+  uint8_t cc[] = { 0xb0, 1, 0 };
+  for (uint64_t t = 0; t < Seconds(kSimulatedSeconds);
+       t += 3 * kCyclesPerMidiByte) {
+    cc[2] = (cc[2] + 1) & 0x7f;
+    SendMidi(script, t, cc, sizeof(cc));
+  }
+}
+
+void ScriptSysEx(Script* script, uint32_t eeprom_writes) {
+  // Back to back sequence or settings transfers: header, command, 64 bytes
+  // of data sent as nibbles, checksum.
+  uint8_t message[139] = { 0xf0, 0x00, 0x21, 0x02, 0x00, 0x07, 0x01, 0x01 };
+  for (uint8_t i = 8; i < sizeof(message) - 1; ++i) {
+    message[i] = rand() & 0x0f;
+  }
+  message[sizeof(message) - 1] = 0xf7;
+  for (uint64_t t = 0; t < Seconds(kSimulatedSeconds);
+       t += Seconds(0.25)) {
+    SendMidi(script, t, message, sizeof(message));
+  }
+  script->sysex_eeprom_writes = eeprom_writes;
+}
+
+void ScriptPots(Script* script) {
+  // Pots turned continuously: one event per UI poll (612Hz) on average.
+  for (uint64_t t = 0; t < Seconds(kSimulatedSeconds);
+       t += rand() % (2 * F_CPU / 612)) {
+    if (script->num_ui_events < kMaxUiEvents) {
+      script->ui_events[script->num_ui_events++] = t;
+    }
+  }
+}
+
+struct Load {
+  const char* name;
+  void (*make_script)(Script*);
+  bool blocking;  // Has blocking EEPROM writes
+};
+
+void MakeSequencerOnly(Script* script) { }
+
+void MakeNotes(Script* script) {
+  ScriptNotes(script);
+}
+
+void MakeControlChanges(Script* script) {
+  ScriptControlChanges(script);
+}
+
+void MakeSequenceTransfer(Script* script) {
+  // The sequence is written by sequence_bank.Tick(), a byte per iteration.
+  ScriptSysEx(script, 0);
+}
+
+void MakePots(Script* script) {
+  ScriptPots(script);
+}
+
+void MakeEverything(Script* script) {
+  ScriptNotes(script);
+  ScriptPots(script);
+}
+
+void MakeSettingsTransfer(Script* script) {
+  // SystemSettings::Save() writes 16 bytes and a checksum.
+  ScriptSysEx(script, 17);
+}
+
+const Load kLoads[] = {
+  { "sequencer only", &MakeSequencerOnly, false },
+  { "MIDI notes", &MakeNotes, false },
+  { "MIDI line full of CCs", &MakeControlChanges, false },
+  { "SysEx sequence transfers", &MakeSequenceTransfer, false },
+  { "pots", &MakePots, false },
+  { "MIDI notes and pots", &MakeEverything, false },
+  { "SysEx settings transfers", &MakeSettingsTransfer, true },
+};
+
+const uint8_t kNumLoads = sizeof(kLoads) / sizeof(kLoads[0]);
+
+// Main loop and audio interrupt.
+
+struct Result {
+  uint32_t underruns;
+  uint64_t held_samples;
+  double underrun_probability;
+  uint16_t min_level;
+};
+
+class Simulator {
+ public:
+  Simulator(const Script& script, LoopVersion version, double scale)
+      : script_(&script),
+        version_(version),
+        scale_(scale),
+        now_(0),
+        level_(0),
+        samples_read_(0),
+        dac_samples_written_(0),
+        clock_events_(0),
+        midi_index_(0),
+        ui_index_(0),
+        midi_in_start_(0),
+        midi_in_size_(0),
+        status_(0),
+        data_size_(0),
+        underrun_(false),
+        num_windows_(0),
+        last_window_(~0ULL) {
+    // The buffer is filled before the interrupts start.
+    while (kAudioBufferCapacity - level_ >= kAudioBlockSize) {
+      level_ += kAudioBlockSize;
+    }
+    memset(&result_, 0, sizeof(result_));
+    result_.min_level = kAudioBufferCapacity;
+  }
+
+  Result Run() {
+    uint64_t end = Seconds(kSimulatedSeconds);
+    while (now_ < end) {
+      if (version_ == LOOP_BEFORE) {
+        RunLoopBefore();
+      } else {
+        RunLoopAfter();
+      }
+    }
+    result_.underrun_probability = static_cast<double>(num_windows_) /
+        (end / kCyclesPerWindow);
+    return result_;
+  }
+
+ private:
+  // Main loop code taking the given number of cycles. The interrupts read
+  // the samples due meanwhile.
+  void Spend(uint32_t cycles, bool scaled) {
+    double c = scaled ? cycles * scale_ : cycles;
+    now_ += static_cast<uint64_t>(c / kMainLoopShare);
+    uint64_t due = now_ / kCyclesPerSample - samples_read_;
+    samples_read_ += due;
+    if (due <= level_) {
+      level_ -= due;
+      if (due) {
+        underrun_ = false;
+      }
+    } else {
+      if (level_ || !underrun_) {
+        ++result_.underruns;
+      }
+      underrun_ = true;
+      result_.held_samples += due - level_;
+      uint64_t window = now_ / kCyclesPerWindow;
+      if (window != last_window_) {
+        ++num_windows_;
+        last_window_ = window;
+      }
+      level_ = 0;
+    }
+    if (level_ < result_.min_level) {
+      result_.min_level = level_;
+    }
+  }
+
+  void RenderAudio() {
+    // DrumSynth::Render() fills the free blocks, and the ones freed meanwhile
+    // (never when the costs are too high to keep up).
+    uint8_t num_blocks = (kAudioBufferCapacity - level_) / kAudioBlockSize;
+    uint8_t max_num_blocks = AudioBufferSpecs::buffer_size / kAudioBlockSize;
+    while (num_blocks && max_num_blocks--) {
+      Spend(kRenderBlockCycles, true);
+      level_ += kAudioBlockSize;
+      num_blocks = (kAudioBufferCapacity - level_) / kAudioBlockSize;
+    }
+  }
+
+  void WriteDACStateSamples() {
+    uint64_t due = now_ / kCyclesPerDacSample;
+    // The DAC state buffer holds one sample less than its size. Samples the
+    // interrupt did not find are lost.
+    if (dac_samples_written_ < due) {
+      dac_samples_written_ = due;
+    }
+    while (dac_samples_written_ < due + kDACStateBufferSize - 1) {
+      Spend(kDacSampleCycles, true);
+      ++dac_samples_written_;
+    }
+  }
+
+  void ProcessClockEvents() {
+    // 24 pulses per beat at 140 BPM.
+    uint64_t due = now_ * 56 / F_CPU;
+    while (clock_events_ < due) {
+      Spend(kClockEventCycles, true);
+      ++clock_events_;
+    }
+  }
+
+  bool MidiReadable() {
+    // Bytes are dropped when the input buffer is full.
+    while (midi_index_ < script_->num_midi_bytes &&
+           script_->midi[midi_index_].time <= now_) {
+      if (midi_in_size_ < kMidiBufferSize) {
+        midi_in_[(midi_in_start_ + midi_in_size_++) % kMidiBufferSize] =
+            script_->midi[midi_index_].byte;
+      }
+      ++midi_index_;
+    }
+    return midi_in_size_ != 0;
+  }
+
+  void PushMidiByte() {
+    uint8_t byte = midi_in_[midi_in_start_];
+    midi_in_start_ = (midi_in_start_ + 1) % kMidiBufferSize;
+    --midi_in_size_;
+    Spend(kMidiByteCycles, true);
+    if (byte & 0x80) {
+      if (byte == 0xf7 && status_ == 0xf0) {
+        Spend(kSysExAcceptCycles, true);
+        for (uint32_t i = 0; i < script_->sysex_eeprom_writes; ++i) {
+          Spend(kCyclesPerEepromWrite, false);
+        }
+      }
+      status_ = byte;
+      data_size_ = 0;
+      return;
+    }
+    if (status_ == 0xf0) {
+      Spend(kSysExByteCycles, true);
+      return;
+    }
+    if (++data_size_ < 2) {
+      return;
+    }
+    data_size_ = 0;
+    switch (status_ & 0xf0) {
+      case 0x90:
+        Spend(kNoteOnCycles, true);
+        break;
+      case 0x80:
+        Spend(kNoteOffCycles, true);
+        break;
+      default:
+        Spend(kControlChangeCycles, true);
+        break;
+    }
+  }
+
+  void DoUiEvents() {
+    Spend(kUiIdleCycles, true);
+    while (ui_index_ < script_->num_ui_events &&
+           script_->ui_events[ui_index_] <= now_) {
+      Spend(kUiEventCycles, true);
+      ++ui_index_;
+    }
+  }
+
+  // main() before the audio output path was made underrun-safe.
+  void RunLoopBefore() {
+    WriteDACStateSamples();
+    RenderAudio();
+    ProcessClockEvents();
+    while (MidiReadable()) {
+      PushMidiByte();
+    }
+    Spend(kTunerCycles, true);
+    DoUiEvents();
+    Spend(kLoopCycles, true);
+  }
+
+  // main() in anu/anu.cc.
+  void RunLoopAfter() {
+    ProcessClockEvents();
+    WriteDACStateSamples();
+    RenderAudio();
+    while (MidiReadable()) {
+      PushMidiByte();
+      if (kAudioBufferCapacity - level_ >= kAudioBlockSize) {
+        RenderAudio();
+      }
+    }
+    Spend(kTunerCycles, true);
+    if (kAudioBufferCapacity - level_ >= kAudioBlockSize) {
+      RenderAudio();
+    }
+    Spend(kSequenceBankCycles, true);
+    DoUiEvents();
+    Spend(kLoopCycles, true);
+  }
+
+  const Script* script_;
+  LoopVersion version_;
+  double scale_;
+
+  uint64_t now_;  // Cycles
+  uint16_t level_;  // Samples in the audio buffer
+  uint64_t samples_read_;
+  uint64_t dac_samples_written_;
+  uint64_t clock_events_;
+  uint32_t midi_index_;
+  uint32_t ui_index_;
+  uint8_t midi_in_[kMidiBufferSize];
+  uint8_t midi_in_start_;
+  uint8_t midi_in_size_;
+  uint8_t status_;
+  uint8_t data_size_;
+
+  bool underrun_;
+  uint32_t num_windows_;
+  uint64_t last_window_;
+  Result result_;
+};
+
+Result Simulate(const Load& load, LoopVersion version, double scale) {
+  static Script script;
+  srand(1);
+  memset(&script, 0, sizeof(script));
+  load.make_script(&script);
+  Simulator simulator(script, version, scale);
+  return simulator.Run();
+}
+
+// Largest scale of the main loop costs without underruns, up to 16.
+double Headroom(const Load& load, LoopVersion version) {
+  if (Simulate(load, version, 1.0).underruns) {
+    return 0.0;
+  }
+  double low = 1.0;
+  double high = 16.0;
+  if (!Simulate(load, version, high).underruns) {
+    return high;
+  }
+  while (high - low > 0.05) {
+    double middle = 0.5 * (low + high);
+    if (Simulate(load, version, middle).underruns) {
+      high = middle;
+    } else {
+      low = middle;
+    }
+  }
+  return low;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: audio_load_sim [--check]\n");
+    return 1;
+  }
+
+  static const char* const kVersionNames[] = { "before", "after" };
+  int failures = 0;
+  printf("%-26s %-7s %10s %9s %11s %9s %9s\n",
+         "load", "loop", "P(underrun)", "underruns", "held", "min level",
+         "headroom");
+  for (uint8_t i = 0; i < kNumLoads; ++i) {
+    const Load& load = kLoads[i];
+    double headroom[2];
+    for (uint8_t v = LOOP_BEFORE; v <= LOOP_AFTER; ++v) {
+      LoopVersion version = static_cast<LoopVersion>(v);
+      Result r = Simulate(load, version, 1.0);
+      headroom[v] = Headroom(load, version);
+      printf("%-26s %-7s %10.4f%% %9u %11llu %9u %8.2fx\n",
+             v == LOOP_BEFORE ? load.name : "", kVersionNames[v],
+             100.0 * r.underrun_probability, r.underruns,
+             static_cast<unsigned long long>(r.held_samples), r.min_level,
+             headroom[v]);
+      if (version == LOOP_AFTER && !load.blocking && r.underruns) {
+        ++failures;
+      }
+    }
+    if (!load.blocking && headroom[LOOP_AFTER] < headroom[LOOP_BEFORE]) {
+      printf("%-26s less headroom than before\n", "");
+      ++failures;
+    }
+  }
+  return check && failures ? 1 : 0;
+}
@@ -0,0 +1,249 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Comparison of the two envelope cores of anu/envelope.h.
+//
+// The same envelopes are rendered side by side with Envelope::RenderTable(),
+// which interpolates lut_res_env_expo (the firmware with
+// ENABLE_ENVELOPE_EXPO_TABLE), and Envelope::RenderRecursive(), the default.
+// For every attack, decay and release time, and a few sustain levels, an
+// envelope is triggered, held until it sustains, then released until it
+// dies. Reported:
+//
+//   - the number of samples spent in each segment by both cores;
+//   - the largest difference between the two outputs, in % of full scale;
+//   - the host time per rendered sample of each core. The AVR cycles are not
+//     counted.
+//
+// Envelope::Advance(), which renders a triggered envelope ahead by a number of
+// 1/16th of a sample, is checked too: a whole number of samples must give the
+// same output as as many calls to Render(), and a fraction of a sample an
+// output between the ones of the samples before and after.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile envelope_test
+//   build/tools/envelope_test            prints the comparison
+//   build/tools/envelope_test --check    exits with an error if a segment
+//                                        length differs, if the outputs
+//                                        differ by more than 0.2%, or if
+//                                        Advance() fails
+
+#include "anu/envelope.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+using namespace anu;
+
+namespace {
+
+const uint32_t kMaxSegmentSize = 1UL << 22;
+const uint16_t kSustainSize = 64;
+const double kMaxDeviation = 0.2;  // % of full scale
+const uint32_t kNumBenchmarkSamples = 1UL << 22;
+
+const uint8_t kSustainLevels[] = { 0, 128, 255 };
+const uint8_t kNumSustainLevels = sizeof(kSustainLevels);
+
+Envelope table_envelope;
+Envelope recursive_envelope;
+Envelope advanced_envelope;
+
+double HostSeconds() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+struct Comparison {
+  uint32_t table_size[ENV_NUM_SEGMENTS];
+  uint32_t recursive_size[ENV_NUM_SEGMENTS];
+  uint16_t max_deviation;
+};
+
+// Renders one sample with both cores, and counts it in the segment each core
+// was in.
+void Step(Comparison* c) {
+  ++c->table_size[table_envelope.segment()];
+  ++c->recursive_size[recursive_envelope.segment()];
+  uint16_t a = table_envelope.RenderTable();
+  uint16_t b = recursive_envelope.RenderRecursive();
+  uint16_t deviation = a > b ? a - b : b - a;
+  if (deviation > c->max_deviation) {
+    c->max_deviation = deviation;
+  }
+}
+
+// Attack, decay and release of the given time, until the envelopes sustain,
+// then until they die.
+Comparison Compare(uint8_t time, uint8_t sustain) {
+  Comparison c;
+  memset(&c, 0, sizeof(Comparison));
+  table_envelope.Update(time, time, sustain, time);
+  recursive_envelope.Update(time, time, sustain, time);
+  table_envelope.Trigger(ENV_SEGMENT_ATTACK);
+  recursive_envelope.Trigger(ENV_SEGMENT_ATTACK);
+  uint32_t n = 0;
+  while ((table_envelope.segment() != ENV_SEGMENT_SUSTAIN ||
+          recursive_envelope.segment() != ENV_SEGMENT_SUSTAIN) &&
+         n++ < 2 * kMaxSegmentSize) {
+    Step(&c);
+  }
+  for (uint16_t i = 0; i < kSustainSize; ++i) {
+    Step(&c);
+  }
+  table_envelope.Trigger(ENV_SEGMENT_RELEASE);
+  recursive_envelope.Trigger(ENV_SEGMENT_RELEASE);
+  n = 0;
+  while ((table_envelope.segment() != ENV_SEGMENT_DEAD ||
+          recursive_envelope.segment() != ENV_SEGMENT_DEAD) &&
+         n++ < kMaxSegmentSize) {
+    Step(&c);
+  }
+  return c;
+}
+
+bool SameSegments(const Comparison& c) {
+  return c.table_size[ENV_SEGMENT_ATTACK] ==
+          c.recursive_size[ENV_SEGMENT_ATTACK] &&
+      c.table_size[ENV_SEGMENT_DECAY] == c.recursive_size[ENV_SEGMENT_DECAY] &&
+      c.table_size[ENV_SEGMENT_RELEASE] ==
+          c.recursive_size[ENV_SEGMENT_RELEASE];
+}
+
+double Percent(uint16_t deviation) {
+  return deviation * 100.0 / 65535.0;
+}
+
+// Number of Advance() calls whose output is not where it should be.
+uint16_t TestAdvance() {
+  const uint8_t kTimes[] = { 0, 20, 60, 120 };
+  uint16_t failures = 0;
+  for (uint8_t t = 0; t < sizeof(kTimes); ++t) {
+    uint8_t time = kTimes[t];
+    for (uint8_t sixteenths = 0; sixteenths < 128; ++sixteenths) {
+      advanced_envelope.Update(time, time, 128, time);
+      advanced_envelope.Trigger(ENV_SEGMENT_ATTACK);
+      advanced_envelope.Advance(sixteenths);
+      recursive_envelope.Update(time, time, 128, time);
+      recursive_envelope.Trigger(ENV_SEGMENT_ATTACK);
+      for (uint8_t i = 0; i < sixteenths / 16; ++i) {
+        recursive_envelope.Render();
+      }
+      uint16_t before = recursive_envelope.value();
+      uint16_t after = recursive_envelope.Render();
+      uint16_t low = before < after ? before : after;
+      uint16_t high = before < after ? after : before;
+      uint16_t value = advanced_envelope.value();
+      bool ok = sixteenths % 16 ? value >= low && value <= high :
+          value == before;
+      if (!ok) {
+        printf("Advance(%d), time %d: %d, expected %d to %d\n",
+               sixteenths, time, value, low, high);
+        ++failures;
+      }
+    }
+  }
+  return failures;
+}
+
+// Host time per sample of a core, retriggered as a fast envelope ends.
+template<uint16_t (Envelope::*Render)()>
+double NanosecondsPerSample(Envelope* envelope) {
+  envelope->Update(40, 60, 128, 50);
+  envelope->Trigger(ENV_SEGMENT_ATTACK);
+  uint32_t sum = 0;
+  double start = HostSeconds();
+  for (uint32_t i = 0; i < kNumBenchmarkSamples; ++i) {
+    sum += (envelope->*Render)();
+    if (envelope->segment() == ENV_SEGMENT_SUSTAIN) {
+      envelope->Trigger(ENV_SEGMENT_RELEASE);
+    } else if (envelope->segment() == ENV_SEGMENT_DEAD) {
+      envelope->Trigger(ENV_SEGMENT_ATTACK);
+    }
+  }
+  double elapsed = HostSeconds() - start;
+  // Keeps the loop from being optimized out.
+  return sum ? elapsed * 1e9 / kNumBenchmarkSamples : 0.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: envelope_test [--check]\n");
+    return 1;
+  }
+
+  table_envelope.Init();
+  recursive_envelope.Init();
+  advanced_envelope.Init();
+
+  uint16_t failures = 0;
+  uint16_t max_deviation = 0;
+  uint8_t max_deviation_time = 0;
+  printf("%5s %7s  %-25s %-25s %-25s %9s\n", "time", "sustain",
+         "attack, table/recursive", "decay, table/recursive",
+         "release, table/recursive", "deviation");
+  for (uint16_t time = 0; time < 256; ++time) {
+    for (uint8_t s = 0; s < kNumSustainLevels; ++s) {
+      Comparison c = Compare(time, kSustainLevels[s]);
+      bool same = SameSegments(c);
+      if (c.max_deviation > max_deviation) {
+        max_deviation = c.max_deviation;
+        max_deviation_time = time;
+      }
+      if (time % 32 == 0 || time == 255 || !same) {
+        printf("%5d %7d  %11u %-13u %11u %-13u %11u %-13u %8.2f%%%s\n",
+               time, kSustainLevels[s],
+               c.table_size[ENV_SEGMENT_ATTACK],
+               c.recursive_size[ENV_SEGMENT_ATTACK],
+               c.table_size[ENV_SEGMENT_DECAY],
+               c.recursive_size[ENV_SEGMENT_DECAY],
+               c.table_size[ENV_SEGMENT_RELEASE],
+               c.recursive_size[ENV_SEGMENT_RELEASE],
+               Percent(c.max_deviation), same ? "" : "  LENGTH MISMATCH");
+      }
+      if (!same) {
+        ++failures;
+      }
+    }
+  }
+  printf("segment lengths in samples, deviation in %% of full scale.\n");
+  printf("largest deviation: %.2f%%, at time %d\n",
+         Percent(max_deviation), max_deviation_time);
+  if (Percent(max_deviation) > kMaxDeviation) {
+    printf("  over %.1f%%\n", kMaxDeviation);
+    ++failures;
+  }
+
+  uint16_t advance_failures = TestAdvance();
+  printf("Advance(): %d failures out of 512\n", advance_failures);
+  failures += advance_failures;
+
+  double table_ns = NanosecondsPerSample<&Envelope::RenderTable>(
+      &table_envelope);
+  double recursive_ns = NanosecondsPerSample<&Envelope::RenderRecursive>(
+      &recursive_envelope);
+  printf("ns/sample: table %.2f, recursive %.2f (host time)\n",
+         table_ns, recursive_ns);
+  return check && failures ? 1 : 0;
+}
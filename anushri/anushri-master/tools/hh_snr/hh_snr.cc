@@ -0,0 +1,171 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Samples of the third drum voice: flash size, decode cost and signal to
+// noise ratio.
+//
+// Each sample is decoded from its ADPCM blocks as DrumSynth::Render() does at
+// the original pitch (one sample per phase increment of 16), and compared
+// with its source in anu/resources/. The hi-hats are cut and faded out: the
+// SNR over the played samples counts the fade as noise, the SNR against the
+// whole source also counts the missing tail. The decode cost is the host time
+// per block of 32 samples decoded in sequence; the AVR cycles are not counted.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile hh_snr
+//   build/tools/hh_snr            prints the table
+//   build/tools/hh_snr --check    exits with an error if a sample is below
+//                                 14dB over its played samples, or if the
+//                                 samples do not fit in the 4097 bytes of
+//                                 the former 8-bit hi-hat
+
+#include "avrlib/adpcm.h"
+#include "avrlib/op.h"
+
+#include "anu/resources.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+using namespace anu;
+using namespace avrlib;
+
+namespace {
+
+const uint16_t kMaxSourceSize = 8192;
+const uint16_t kFlashBudget = 4097;
+const uint16_t kNumPasses = 2000;
+const double kMinSnr = 14.0;
+
+struct Sample {
+  const char* name;
+  const prog_uint8_t* data;
+  uint16_t stored_size;
+  uint16_t decoded_size;
+  const char* source;
+};
+
+const Sample samples[] = {
+  { "closed hi-hat", wav_res_hh, WAV_RES_HH_SIZE, WAV_RES_HH_DECODED_SIZE,
+    "anu/resources/hh_linn.raw" },
+  { "open hi-hat", wav_res_oh, WAV_RES_OH_SIZE, WAV_RES_OH_DECODED_SIZE,
+    "anu/resources/hh_dt.raw" },
+  { "clap", wav_res_clap, WAV_RES_CLAP_SIZE, WAV_RES_CLAP_DECODED_SIZE,
+    "anu/resources/clap.raw" },
+  { "rim shot", wav_res_rim, WAV_RES_RIM_SIZE, WAV_RES_RIM_DECODED_SIZE,
+    "anu/resources/rim.raw" },
+};
+
+double HostSeconds() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+double Snr(double signal, double noise) {
+  return noise == 0.0 ? INFINITY : 10.0 * log10(signal / noise);
+}
+
+struct Result {
+  uint16_t source_size;
+  double played_snr;
+  double snr;
+  double ns_per_block;
+};
+
+bool Measure(const Sample& sample, Result* result) {
+  FILE* fp = fopen(sample.source, "rb");
+  if (!fp) {
+    fprintf(stderr, "Cannot open %s\n", sample.source);
+    return false;
+  }
+  static int8_t source[kMaxSourceSize];
+  result->source_size = fread(source, 1, kMaxSourceSize, fp);
+  fclose(fp);
+
+  AdpcmDecoder decoder;
+  decoder.Init(sample.data);
+  double signal = 0.0;
+  double played_signal = 0.0;
+  double played_noise = 0.0;
+  for (uint16_t i = 0; i < result->source_size; ++i) {
+    double s = source[i];
+    signal += s * s;
+    if (i < sample.decoded_size) {
+      uint16_t phase = i << 4;
+      double played = decoder.Read(U16ShiftRight4(phase));
+      played_signal += s * s;
+      played_noise += (played - s) * (played - s);
+    }
+  }
+  result->played_snr = Snr(played_signal, played_noise);
+  result->snr = Snr(signal, played_noise + signal - played_signal);
+
+  int32_t sum = 0;
+  double start = HostSeconds();
+  for (uint16_t pass = 0; pass < kNumPasses; ++pass) {
+    for (uint16_t i = 0; i < sample.decoded_size; ++i) {
+      sum += decoder.Read(i);
+    }
+  }
+  double elapsed = HostSeconds() - start;
+  uint16_t num_blocks = sample.decoded_size / kAdpcmBlockSize;
+  // Keeps the loop from being optimized out.
+  result->ns_per_block = sum ? elapsed * 1e9 / kNumPasses / num_blocks : 0.0;
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: hh_snr [--check]\n");
+    return 1;
+  }
+
+  uint8_t failures = 0;
+  uint16_t total_size = 0;
+  printf("%-14s %8s %6s %8s %8s %9s\n",
+         "sample", "played", "bytes", "SNR", "whole", "ns/block");
+  for (uint8_t i = 0; i < sizeof(samples) / sizeof(Sample); ++i) {
+    const Sample& sample = samples[i];
+    Result r;
+    if (!Measure(sample, &r)) {
+      return 1;
+    }
+    total_size += sample.stored_size;
+    printf("%-14s %4d/%-4d %5d %6.1fdB %6.1fdB %9.1f%s\n",
+           sample.name, sample.decoded_size, r.source_size,
+           sample.stored_size, r.played_snr, r.snr, r.ns_per_block,
+           r.played_snr < kMinSnr ? "  LOW" : "");
+    if (r.played_snr < kMinSnr) {
+      ++failures;
+    }
+  }
+  printf("played: samples played of the source. SNR: over the played "
+         "samples. whole: against the whole source.\n");
+  printf("total: %d bytes of %d\n", total_size, kFlashBudget);
+  if (total_size > kFlashBudget) {
+    ++failures;
+  }
+  return check && failures ? 1 : 0;
+}
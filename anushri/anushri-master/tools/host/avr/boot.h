@@ -0,0 +1,27 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host stand-in for <avr/boot.h>. Nothing is written to the flash.
+
+#ifndef TOOLS_HOST_AVR_BOOT_H_
+#define TOOLS_HOST_AVR_BOOT_H_
+
+#include <avr/io.h>
+
+#define SPM_PAGESIZE 256
+
+#endif  // TOOLS_HOST_AVR_BOOT_H_
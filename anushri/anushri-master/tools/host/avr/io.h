@@ -0,0 +1,220 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host stand-in for <avr/io.h>: the ATmega644P registers used by avrlib and
+// the firmware, held in a plain array so that the firmware sources build and
+// run on the host. Bytes written to the UART data registers are appended to
+// a log (see host.h) instead of being lost.
+
+#ifndef TOOLS_HOST_AVR_IO_H_
+#define TOOLS_HOST_AVR_IO_H_
+
+#include <stdint.h>
+
+#define __AVR_ATmega644P__ 1
+
+#define _BV(bit) (1 << (bit))
+
+enum HostRegister {
+  HOST_SREG,
+  HOST_MCUSR, HOST_WDTCSR,
+  HOST_PINA, HOST_PINB, HOST_PINC, HOST_PIND,
+  HOST_DDRA, HOST_DDRB, HOST_DDRC, HOST_DDRD,
+  HOST_PORTA, HOST_PORTB, HOST_PORTC, HOST_PORTD,
+  HOST_TCCR0A, HOST_TCCR0B, HOST_TCNT0, HOST_OCR0A, HOST_OCR0B, HOST_TIMSK0,
+  HOST_TCCR1A, HOST_TCCR1B, HOST_TIMSK1, HOST_TIFR1,
+  HOST_TCCR2A, HOST_TCCR2B, HOST_TCNT2, HOST_OCR2A, HOST_OCR2B, HOST_TIMSK2,
+  HOST_ADCL, HOST_ADCH, HOST_ADCSRA, HOST_ADMUX,
+  HOST_SPCR, HOST_SPSR, HOST_SPDR,
+  HOST_TWBR, HOST_TWSR, HOST_TWDR, HOST_TWCR,
+  HOST_UCSR0A, HOST_UCSR0B, HOST_UCSR0C, HOST_UBRR0H, HOST_UBRR0L,
+  HOST_UCSR1A, HOST_UCSR1B, HOST_UCSR1C, HOST_UBRR1H, HOST_UBRR1L,
+  HOST_NUM_REGISTERS
+};
+
+enum HostRegister16 {
+  HOST_TCNT1, HOST_OCR1A, HOST_OCR1B, HOST_ICR1, HOST_ADC,
+  HOST_UBRR0, HOST_UBRR1,
+  HOST_NUM_REGISTERS16
+};
+
+extern volatile uint8_t host_registers[HOST_NUM_REGISTERS];
+extern volatile uint16_t host_registers16[HOST_NUM_REGISTERS16];
+
+// Returns the location the next byte written to the UART goes to.
+volatile uint8_t* HostUartData(uint8_t port);
+
+#define _SFR_BYTE(sfr) (*(volatile uint8_t*)&(sfr))
+#define _SFR_WORD(sfr) (*(volatile uint16_t*)&(sfr))
+
+#define SREG host_registers[HOST_SREG]
+#define MCUSR host_registers[HOST_MCUSR]
+#define WDTCSR host_registers[HOST_WDTCSR]
+
+#define PINA host_registers[HOST_PINA]
+#define PINB host_registers[HOST_PINB]
+#define PINC host_registers[HOST_PINC]
+#define PIND host_registers[HOST_PIND]
+#define DDRA host_registers[HOST_DDRA]
+#define DDRB host_registers[HOST_DDRB]
+#define DDRC host_registers[HOST_DDRC]
+#define DDRD host_registers[HOST_DDRD]
+#define PORTA host_registers[HOST_PORTA]
+#define PORTB host_registers[HOST_PORTB]
+#define PORTC host_registers[HOST_PORTC]
+#define PORTD host_registers[HOST_PORTD]
+
+#define TCCR0A host_registers[HOST_TCCR0A]
+#define TCCR0B host_registers[HOST_TCCR0B]
+#define TCNT0 host_registers[HOST_TCNT0]
+#define OCR0A host_registers[HOST_OCR0A]
+#define OCR0B host_registers[HOST_OCR0B]
+#define TIMSK0 host_registers[HOST_TIMSK0]
+#define TCCR1A host_registers[HOST_TCCR1A]
+#define TCCR1B host_registers[HOST_TCCR1B]
+#define TCNT1 host_registers16[HOST_TCNT1]
+#define OCR1A host_registers16[HOST_OCR1A]
+#define OCR1B host_registers16[HOST_OCR1B]
+#define ICR1 host_registers16[HOST_ICR1]
+#define TIMSK1 host_registers[HOST_TIMSK1]
+#define TIFR1 host_registers[HOST_TIFR1]
+#define TCCR2A host_registers[HOST_TCCR2A]
+#define TCCR2B host_registers[HOST_TCCR2B]
+#define TCNT2 host_registers[HOST_TCNT2]
+#define OCR2A host_registers[HOST_OCR2A]
+#define OCR2B host_registers[HOST_OCR2B]
+#define TIMSK2 host_registers[HOST_TIMSK2]
+
+#define ADC host_registers16[HOST_ADC]
+#define ADCL host_registers[HOST_ADCL]
+#define ADCH host_registers[HOST_ADCH]
+#define ADCSRA host_registers[HOST_ADCSRA]
+#define ADMUX host_registers[HOST_ADMUX]
+
+#define SPCR host_registers[HOST_SPCR]
+#define SPSR host_registers[HOST_SPSR]
+#define SPDR host_registers[HOST_SPDR]
+
+#define TWBR host_registers[HOST_TWBR]
+#define TWSR host_registers[HOST_TWSR]
+#define TWDR host_registers[HOST_TWDR]
+#define TWCR host_registers[HOST_TWCR]
+
+#define UCSR0A host_registers[HOST_UCSR0A]
+#define UCSR0B host_registers[HOST_UCSR0B]
+#define UCSR0C host_registers[HOST_UCSR0C]
+#define UBRR0H host_registers[HOST_UBRR0H]
+#define UBRR0L host_registers[HOST_UBRR0L]
+#define UBRR0 host_registers16[HOST_UBRR0]
+#define UDR0 (*HostUartData(0))
+#define UCSR1A host_registers[HOST_UCSR1A]
+#define UCSR1B host_registers[HOST_UCSR1B]
+#define UCSR1C host_registers[HOST_UCSR1C]
+#define UBRR1H host_registers[HOST_UBRR1H]
+#define UBRR1L host_registers[HOST_UBRR1L]
+#define UBRR1 host_registers16[HOST_UBRR1]
+#define UDR1 (*HostUartData(1))
+
+// Bits
+#define WDRF 3
+#define WDP3 5
+#define WDCE 4
+#define WDE 3
+
+#define COM0A1 7
+#define COM0A0 6
+#define COM0B1 5
+#define COM0B0 4
+#define WGM01 1
+#define WGM00 0
+#define COM1A1 7
+#define COM1A0 6
+#define COM1B1 5
+#define COM1B0 4
+#define WGM11 1
+#define WGM10 0
+#define WGM13 4
+#define WGM12 3
+#define COM2A1 7
+#define COM2A0 6
+#define COM2B1 5
+#define COM2B0 4
+#define WGM21 1
+#define WGM20 0
+#define OCIE1A 1
+#define TOIE1 0
+#define OCF1A 1
+
+#define ADEN 7
+#define ADSC 6
+#define ADATE 5
+#define ADIF 4
+#define ADIE 3
+#define REFS1 7
+#define REFS0 6
+#define ADLAR 5
+
+#define SPIE 7
+#define SPE 6
+#define DORD 5
+#define MSTR 4
+#define CPOL 3
+#define CPHA 2
+#define SPR1 1
+#define SPR0 0
+#define SPIF 7
+#define WCOL 6
+#define SPI2X 0
+
+#define TWINT 7
+#define TWEA 6
+#define TWSTA 5
+#define TWSTO 4
+#define TWWC 3
+#define TWEN 2
+#define TWIE 0
+#define TWPS1 1
+#define TWPS0 0
+
+#define RXC0 7
+#define TXC0 6
+#define UDRE0 5
+#define U2X0 1
+#define RXCIE0 7
+#define TXCIE0 6
+#define UDRIE0 5
+#define RXEN0 4
+#define TXEN0 3
+#define UMSEL01 7
+#define UMSEL00 6
+#define UCSZ01 2
+#define UCSZ00 1
+#define RXC1 7
+#define TXC1 6
+#define UDRE1 5
+#define U2X1 1
+#define RXCIE1 7
+#define TXCIE1 6
+#define UDRIE1 5
+#define RXEN1 4
+#define TXEN1 3
+#define UMSEL11 7
+#define UMSEL10 6
+#define UCSZ11 2
+#define UCSZ10 1
+
+#endif  // TOOLS_HOST_AVR_IO_H_
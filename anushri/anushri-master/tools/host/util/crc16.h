@@ -0,0 +1,40 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host stand-in for <util/crc16.h>, same polynomials as avr-libc.
+
+#ifndef TOOLS_HOST_UTIL_CRC16_H_
+#define TOOLS_HOST_UTIL_CRC16_H_
+
+#include <stdint.h>
+
+inline uint16_t _crc16_update(uint16_t crc, uint8_t data) {
+  crc ^= data;
+  for (uint8_t i = 0; i < 8; ++i) {
+    crc = crc & 1 ? (crc >> 1) ^ 0xa001 : crc >> 1;
+  }
+  return crc;
+}
+
+inline uint16_t _crc_ccitt_update(uint16_t crc, uint8_t data) {
+  data ^= crc & 0xff;
+  data ^= data << 4;
+  return ((static_cast<uint16_t>(data) << 8) | (crc >> 8)) ^
+      static_cast<uint8_t>(data >> 4) ^ (static_cast<uint16_t>(data) << 3);
+}
+
+#endif  // TOOLS_HOST_UTIL_CRC16_H_
@@ -0,0 +1,259 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Simulation of the synchronization of the LFO to the MIDI clock.
+//
+// The real anu::Lfo is rendered at the control rate, and is given the
+// position of the MIDI clock pulses (24 per LFO cycle) as
+// VoiceController::Clock() does. The pulses are sent at the given tempo,
+// with a random jitter. The phase error is measured at each pulse, before
+// the correction, against the phase of the ideal clock, without jitter.
+//
+// Scenarios:
+//   lock        start at the given tempo.
+//   step        tempo change, the lock time is counted from the change.
+//   dropout     the clock stops for 2s without a Stop message, then resumes
+//               at the next position.
+//   continue    Stop, then Continue after 2s: the sync is reset and the
+//               position is kept.
+//
+// The lock time is the number of pulses after which the error stays within
+// 2 degrees (or the jitter range, when there is jitter).
+//
+// Build and run, from the source root:
+//   make -f tools/makefile lfo_sync_sim
+//   build/tools/lfo_sync_sim            prints the table
+//   build/tools/lfo_sync_sim --check    exits with an error if the LFO does
+//                                       not lock within a quarter of a beat
+//                                       (a beat and a half after a tempo
+//                                       change), or if the residual error is
+//                                       too large
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The simulation reads the phase of the LFO.
+#define private public
+#include "anu/lfo.h"
+#undef private
+
+using namespace anu;
+
+namespace {
+
+// Rate at which Voice::WriteDACStateSample() renders the LFO: the DAC
+// refresh rate.
+const double kControlRate = 20000000.0 / 510.0 / 8.0 / 2.0;
+
+// The tempo change, dropout or stop happen at 10s, the residual error is
+// measured on the last 5s.
+const double kDuration = 20.0;
+const double kEventTime = 10.0;
+const double kGapDuration = 2.0;
+
+enum Scenario {
+  SCENARIO_LOCK,
+  SCENARIO_STEP,
+  SCENARIO_DROPOUT,
+  SCENARIO_CONTINUE,
+  SCENARIO_LAST
+};
+
+const char* const kScenarioNames[] = {
+  "lock", "step", "dropout", "continue"
+};
+
+struct Pulse {
+  double ideal_time;
+  double time;  // With jitter.
+  double tempo;
+};
+
+const uint16_t kMaxPulses = 8192;
+
+Pulse pulses[kMaxPulses];
+uint16_t num_pulses;
+uint16_t event_pulse;  // First pulse after the event.
+
+void MakePulses(Scenario scenario, double bpm, double new_bpm,
+                double jitter_ms) {
+  double t = 0.0;
+  double tempo = bpm;
+  num_pulses = 0;
+  event_pulse = 0;
+  while (t < kDuration && num_pulses < kMaxPulses) {
+    if (!event_pulse && t >= kEventTime && scenario != SCENARIO_LOCK) {
+      event_pulse = num_pulses;
+      if (scenario == SCENARIO_STEP) {
+        tempo = new_bpm;
+      } else {
+        t += kGapDuration;
+      }
+    }
+    Pulse* pulse = &pulses[num_pulses++];
+    pulse->ideal_time = t;
+    pulse->time = t + jitter_ms * 1e-3 * ((rand() % 2001) - 1000) / 1000.0;
+    if (pulse->time < 0.0) {
+      pulse->time = 0.0;
+    }
+    pulse->tempo = tempo;
+    t += 60.0 / tempo / 24.0;
+  }
+}
+
+struct Result {
+  uint16_t lock_pulses;
+  double residual_rms;  // In degrees.
+  double residual_max;
+};
+
+Lfo lfo;
+
+double WrapDegrees(double cycles) {
+  cycles -= floor(cycles + 0.5);
+  return cycles * 360.0;
+}
+
+Result Run(Scenario scenario, double bpm, double new_bpm, double jitter_ms) {
+  srand(static_cast<uint32_t>(bpm * 1000 + new_bpm * 10 + jitter_ms));
+  MakePulses(scenario, bpm, new_bpm, jitter_ms);
+
+  memset(static_cast<void*>(&lfo), 0, sizeof(lfo));
+  lfo.set_shape(LFO_SHAPE_TRIANGLE);
+  lfo.set_phase(0x12345678);
+  lfo.set_phase_increment(500000);
+  lfo.ResetSync();
+
+  // Errors caused by the jitter of the pulses alone are not counted.
+  double lock_threshold = 2.0 + jitter_ms * 1e-3 * bpm / 60.0 * 360.0;
+  if (scenario == SCENARIO_STEP && new_bpm > bpm) {
+    lock_threshold = 2.0 + jitter_ms * 1e-3 * new_bpm / 60.0 * 360.0;
+  }
+
+  Result result;
+  result.residual_max = 0.0;
+  double sum_squares = 0.0;
+  uint32_t num_residual = 0;
+  int32_t last_unlocked = event_pulse - 1;
+  uint16_t pulse = 0;
+  bool continued = false;
+  uint32_t num_samples = static_cast<uint32_t>(kDuration * kControlRate);
+  for (uint32_t n = 0; n < num_samples && pulse < num_pulses; ++n) {
+    double now = n / kControlRate;
+    if (scenario == SCENARIO_CONTINUE && !continued &&
+        now >= pulses[event_pulse].time - 0.001) {
+      // VoiceController::ContinueClock(), just before the first pulse.
+      lfo.ResetSync();
+      continued = true;
+    }
+    while (pulse < num_pulses && now >= pulses[pulse].time) {
+      // Phase of the ideal clock now, and phase error before the correction.
+      const Pulse& p = pulses[pulse];
+      double ideal_phase = pulse / 24.0 + (now - p.ideal_time) * p.tempo / 60.0;
+      double lfo_phase = lfo.phase_ / 4294967296.0;
+      double error = fabs(WrapDegrees(ideal_phase - lfo_phase));
+      if (pulse > event_pulse && error > lock_threshold) {
+        last_unlocked = pulse;
+      }
+      if (now >= kDuration - 5.0) {
+        sum_squares += error * error;
+        ++num_residual;
+        if (error > result.residual_max) {
+          result.residual_max = error;
+        }
+      }
+      // VoiceController::Clock().
+      lfo.set_target_phase(static_cast<uint16_t>(pulse % 24) * 2730);
+      ++pulse;
+    }
+    lfo.Render();
+  }
+  result.lock_pulses = last_unlocked - event_pulse + 1;
+  result.residual_rms = num_residual ? sqrt(sum_squares / num_residual) : 0.0;
+  return result;
+}
+
+struct Case {
+  Scenario scenario;
+  double bpm;
+  double new_bpm;
+  double jitter_ms;
+};
+
+const Case kCases[] = {
+  { SCENARIO_LOCK, 15, 0, 0 },
+  { SCENARIO_LOCK, 40, 0, 0 },
+  { SCENARIO_LOCK, 120, 0, 0 },
+  { SCENARIO_LOCK, 240, 0, 0 },
+  { SCENARIO_LOCK, 480, 0, 0 },
+  { SCENARIO_LOCK, 960, 0, 0 },
+  { SCENARIO_LOCK, 40, 0, 1 },
+  { SCENARIO_LOCK, 120, 0, 1 },
+  { SCENARIO_LOCK, 240, 0, 1 },
+  { SCENARIO_LOCK, 15, 0, 1 },
+  { SCENARIO_STEP, 120, 60, 0 },
+  { SCENARIO_STEP, 60, 120, 0 },
+  { SCENARIO_STEP, 120, 130, 0 },
+  { SCENARIO_STEP, 120, 180, 1 },
+  { SCENARIO_STEP, 40, 240, 0 },
+  { SCENARIO_DROPOUT, 120, 0, 0 },
+  { SCENARIO_DROPOUT, 40, 0, 1 },
+  { SCENARIO_CONTINUE, 120, 0, 0 },
+  { SCENARIO_CONTINUE, 240, 0, 1 },
+};
+
+// A quarter of a beat, a beat and a half after a tempo change, and the
+// residual error with and without jitter.
+const uint16_t kMaxLockPulses = 6;
+const uint16_t kMaxStepLockPulses = 36;
+const double kMaxResidual = 2.0;
+const double kMaxJitterResidualPerMs = 2.0;
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: lfo_sync_sim [--check]\n");
+    return 1;
+  }
+  int errors = 0;
+  printf("scenario  bpm  new  jitter  lock (pulses)  rms (deg)  max (deg)\n");
+  for (uint8_t i = 0; i < sizeof(kCases) / sizeof(Case); ++i) {
+    const Case& c = kCases[i];
+    Result r = Run(c.scenario, c.bpm, c.new_bpm, c.jitter_ms);
+    printf("%-8s  %3.0f  %3.0f  %4.1fms  %13d  %9.2f  %9.2f\n",
+           kScenarioNames[c.scenario], c.bpm, c.new_bpm, c.jitter_ms,
+           r.lock_pulses, r.residual_rms, r.residual_max);
+    double tempo = c.new_bpm > c.bpm ? c.new_bpm : c.bpm;
+    double max_residual = kMaxResidual + \
+        kMaxJitterResidualPerMs * c.jitter_ms * tempo / 120.0;
+    uint16_t max_lock_pulses = c.scenario == SCENARIO_STEP ?
+        kMaxStepLockPulses : kMaxLockPulses;
+    if (check && (r.lock_pulses > max_lock_pulses ||
+                  r.residual_max > max_residual)) {
+      fprintf(stderr, "%s at %.0f BPM: does not lock\n",
+              kScenarioNames[c.scenario], c.bpm);
+      ++errors;
+    }
+  }
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,523 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Differential fuzzing and throughput of the MIDI input path.
+//
+// Random streams mixing well-formed messages, running status, interleaved
+// realtime bytes, complete and truncated SysEx messages, some of them for
+// the SysEx handler of the firmware, system common messages and stray data
+// bytes are parsed by:
+// - a reference parser written from the MIDI 1.0 specification,
+// - midi::MidiStreamParser with a device recording what it is given,
+// - midi::MidiStreamParser with the firmware MidiDispatcher, whose MIDI thru
+//   output is collected from the output buffers.
+// The MIDI out only forwards the input messages, the parser and the thru
+// output must both give exactly the messages of the reference.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile midi_fuzz
+//   build/tools/midi_fuzz [--streams n] [--seed n]
+//   build/tools/midi_fuzz --benchmark
+//
+// The benchmark gives the throughput of the parser and the firmware handler,
+// and the host time of each PushByte() call, the handler callback of the
+// message it completes included, for random streams and for the worst cases
+// of a live input: a flood of active sensing bytes (0xfe) around notes, and
+// SysEx messages for this device interleaved with clock bytes.
+
+#include "anu/midi_dispatcher.h"
+#include "anu/system_settings.h"
+#include "anu/voice_controller.h"
+
+#include "midi/midi.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+using namespace anu;
+
+namespace {
+
+// The standard containers are not usable with -fpack-struct, which the
+// firmware structures need.
+const uint32_t kMaxSize = 262144;
+
+struct Bytes {
+  uint8_t data[kMaxSize];
+  uint32_t size;
+
+  void clear() { size = 0; }
+  void push_back(uint8_t byte) {
+    if (size < kMaxSize) {
+      data[size++] = byte;
+    }
+  }
+  uint8_t operator[](uint32_t i) const { return data[i]; }
+  bool operator==(const Bytes& other) const {
+    return size == other.size && !memcmp(data, other.data, size);
+  }
+};
+
+// Messages are kept serialized.
+typedef Bytes Messages;
+
+void AddMessage(Messages* messages, uint8_t status, const uint8_t* data,
+                uint8_t size) {
+  messages->push_back(status);
+  for (uint8_t i = 0; i < size; ++i) {
+    messages->push_back(data[i]);
+  }
+}
+
+uint8_t ExpectedDataSize(uint8_t status) {
+  switch (status & 0xf0) {
+    case 0xc0:
+    case 0xd0:
+      return 1;
+    case 0xf0:
+      return status == 0xf2 ? 2 : (status == 0xf1 || status == 0xf3 ? 1 : 0);
+    default:
+      return 2;
+  }
+}
+
+// Parser written from the specification: realtime bytes can appear anywhere
+// and do not change the state; system common messages cancel the running
+// status; only 0xf7 ends a SysEx message, any other status byte aborts it;
+// data bytes without status and incomplete messages are ignored.
+class ReferenceParser {
+ public:
+  ReferenceParser() : status_(0), size_(0), sysex_(false) { }
+
+  void Push(uint8_t byte, Messages* messages) {
+    if (byte >= 0xf8) {
+      AddMessage(messages, byte, NULL, 0);
+    } else if (byte >= 0x80) {
+      size_ = 0;
+      status_ = 0;
+      if (byte == 0xf7) {
+        if (sysex_) {
+          AddMessage(messages, byte, NULL, 0);
+        }
+        sysex_ = false;
+      } else if (byte == 0xf0) {
+        sysex_ = true;
+        AddMessage(messages, byte, NULL, 0);
+      } else {
+        sysex_ = false;
+        if (ExpectedDataSize(byte)) {
+          status_ = byte;
+        } else {
+          AddMessage(messages, byte, NULL, 0);
+        }
+      }
+    } else if (sysex_) {
+      AddMessage(messages, byte, NULL, 0);
+    } else if (status_) {
+      data_[size_++] = byte;
+      if (size_ == ExpectedDataSize(status_)) {
+        AddMessage(messages, status_, data_, size_);
+        size_ = 0;
+        if (status_ >= 0xf0) {
+          status_ = 0;
+        }
+      }
+    }
+  }
+
+ private:
+  uint8_t status_;
+  uint8_t data_[2];
+  uint8_t size_;
+  bool sysex_;
+};
+
+// Device recording what the parser reports.
+Messages recorded;
+
+struct RecordingDevice : public midi::MidiDevice {
+  static void SysExStart() {
+    AddMessage(&recorded, 0xf0, NULL, 0);
+  }
+  static void SysExByte(uint8_t sysex_byte) {
+    AddMessage(&recorded, sysex_byte, NULL, 0);
+  }
+  static void SysExEnd() {
+    AddMessage(&recorded, 0xf7, NULL, 0);
+  }
+  static void RawMidiData(
+      uint8_t status,
+      uint8_t* data,
+      uint8_t data_size,
+      uint8_t accepted_channel) {
+    AddMessage(&recorded, status, data, data_size);
+  }
+};
+
+// Random streams.
+
+uint8_t RandomData() {
+  return rand() & 0x7f;
+}
+
+uint8_t RandomRealtime() {
+  return 0xf8 + (rand() & 7);
+}
+
+void AddRealtime(Bytes* stream) {
+  // Realtime bytes are interleaved anywhere.
+  while ((rand() & 7) == 0) {
+    stream->push_back(RandomRealtime());
+  }
+}
+
+void AddChannelMessage(Bytes* stream, uint8_t* running_status) {
+  uint8_t status = 0x80 + (rand() % 0x70);
+  if (*running_status && (rand() & 1)) {
+    status = *running_status;
+  } else {
+    stream->push_back(status);
+    *running_status = status;
+  }
+  uint8_t size = ExpectedDataSize(status);
+  // Sometimes truncated.
+  if ((rand() & 15) == 0) {
+    size = rand() % size;
+  }
+  for (uint8_t i = 0; i < size; ++i) {
+    AddRealtime(stream);
+    stream->push_back(RandomData());
+  }
+}
+
+// Same as in anu/sysex_handler.cc.
+const uint8_t kSysExHeader[] = { 0x00, 0x21, 0x02, 0x00, 0x08 };
+
+void AddSysEx(Bytes* stream) {
+  stream->push_back(0xf0);
+  // Sometimes for this device, or a part of the header only, followed by a
+  // transfer of a valid or invalid object, or by an unknown command. The
+  // requests are left out: their answer is not MIDI thru, and is written to
+  // the output buffer as the UART drains it.
+  if (rand() & 1) {
+    uint8_t header_size = rand() % (sizeof(kSysExHeader) + 1);
+    for (uint8_t i = 0; i < header_size; ++i) {
+      stream->push_back(kSysExHeader[i]);
+    }
+    if (header_size == sizeof(kSysExHeader)) {
+      stream->push_back(rand() & 1 ? 0x01 : 0x20 + rand() % 0x60);
+      stream->push_back(rand() & 1 ? rand() % 6 : RandomData());
+    }
+  }
+  uint8_t size = rand() % 24;
+  for (uint8_t i = 0; i < size; ++i) {
+    AddRealtime(stream);
+    stream->push_back(RandomData());
+  }
+  // Sometimes ended by another status byte.
+  if (rand() & 3) {
+    stream->push_back(0xf7);
+  }
+}
+
+void AddSystemCommon(Bytes* stream) {
+  uint8_t status = 0xf1 + (rand() % 7);
+  stream->push_back(status);
+  // Not always with the right number of data bytes.
+  uint8_t size = ExpectedDataSize(status);
+  if ((rand() & 7) == 0) {
+    size = rand() % 3;
+  }
+  for (uint8_t i = 0; i < size; ++i) {
+    stream->push_back(RandomData());
+  }
+}
+
+void RandomStream(uint16_t num_messages, Bytes* stream) {
+  stream->clear();
+  uint8_t running_status = 0;
+  for (uint16_t i = 0; i < num_messages; ++i) {
+    uint8_t kind = rand() % 16;
+    AddRealtime(stream);
+    if (kind < 10) {
+      AddChannelMessage(stream, &running_status);
+    } else {
+      running_status = 0;
+      if (kind < 12) {
+        AddSysEx(stream);
+      } else if (kind < 14) {
+        AddSystemCommon(stream);
+      } else {
+        // Stray data bytes.
+        stream->push_back(RandomData());
+      }
+    }
+  }
+}
+
+void ReadThru(Bytes* thru) {
+  // As FlushMidiOut() in anu/anu.cc, after each byte.
+  while (midi_dispatcher.readable_high_priority()) {
+    thru->push_back(midi_dispatcher.ImmediateReadHighPriority());
+  }
+  while (midi_dispatcher.readable_low_priority()) {
+    thru->push_back(midi_dispatcher.ImmediateReadLowPriority());
+  }
+}
+
+void PrintBytes(const char* name, const Bytes& bytes, size_t from) {
+  printf("  %-10s", name);
+  for (size_t i = from; i < bytes.size && i < from + 24; ++i) {
+    printf(" %02x", bytes[i]);
+  }
+  printf("\n");
+}
+
+bool Compare(const char* name, const Bytes& expected, const Bytes& actual,
+             const Bytes& stream) {
+  if (expected == actual) {
+    return true;
+  }
+  size_t i = 0;
+  while (i < expected.size && i < actual.size && expected[i] == actual[i]) {
+    ++i;
+  }
+  printf("%s differs from the reference at byte %d\n", name, int(i));
+  size_t from = i > 8 ? i - 8 : 0;
+  PrintBytes("stream", stream, 0);
+  PrintBytes("reference", expected, from);
+  PrintBytes(name, actual, from);
+  return false;
+}
+
+void InitFirmware() {
+  // As Init() in anu/anu.cc: the control changes reach the voice controller.
+  system_settings.Init();
+  drum_synth.Init();
+  voice_controller.Init();
+  system_settings.set_midi_out_mode(MIDI_OUT_TX_INPUT_MESSAGES);
+  MidiDispatcher::OutputBufferLowPriority::Flush();
+  MidiDispatcher::OutputBufferHighPriority::Flush();
+}
+
+Bytes stream;
+Messages messages;
+Bytes thru;
+
+int Fuzz(uint32_t num_streams, uint32_t seed) {
+  InitFirmware();
+  uint32_t num_bytes = 0;
+  for (uint32_t i = 0; i < num_streams; ++i) {
+    srand(seed + i);
+    RandomStream(1 + rand() % 64, &stream);
+    num_bytes += stream.size;
+
+    ReferenceParser reference;
+    midi::MidiStreamParser<RecordingDevice> parser;
+    midi::MidiStreamParser<MidiDispatcher> dispatcher_parser;
+    messages.clear();
+    thru.clear();
+    recorded.clear();
+    for (uint32_t j = 0; j < stream.size; ++j) {
+      reference.Push(stream[j], &messages);
+      parser.PushByte(stream[j]);
+      dispatcher_parser.PushByte(stream[j]);
+      ReadThru(&thru);
+    }
+    if (!Compare("parser", messages, recorded, stream) ||
+        !Compare("thru", messages, thru, stream)) {
+      printf("stream %d, seed %d\n", i, seed + i);
+      return 1;
+    }
+  }
+  printf("%d streams, %d bytes: parser and thru output match the reference\n",
+         num_streams, num_bytes);
+  return 0;
+}
+
+// Worst case streams for the benchmark.
+const uint8_t kFloodSize = 16;
+const uint8_t kSysExPayloadSize = 64;
+
+void FloodStream(uint16_t num_messages, Bytes* stream) {
+  stream->clear();
+  for (uint16_t i = 0; i < num_messages; ++i) {
+    uint8_t note[] = { uint8_t(0x90 | (i & 0xf)), RandomData(), RandomData() };
+    for (uint8_t j = 0; j < sizeof(note); ++j) {
+      for (uint8_t k = 0; k < kFloodSize; ++k) {
+        stream->push_back(0xfe);
+      }
+      stream->push_back(note[j]);
+    }
+  }
+}
+
+void SysExStream(uint16_t num_messages, Bytes* stream) {
+  stream->clear();
+  for (uint16_t i = 0; i < num_messages; ++i) {
+    stream->push_back(0xf0);
+    for (uint8_t j = 0; j < sizeof(kSysExHeader); ++j) {
+      stream->push_back(kSysExHeader[j]);
+    }
+    for (uint8_t j = 0; j < kSysExPayloadSize; ++j) {
+      stream->push_back(RandomData());
+      stream->push_back(0xf8);
+    }
+    stream->push_back(0xf7);
+    stream->push_back(0x90);
+    stream->push_back(RandomData());
+    stream->push_back(RandomData());
+  }
+}
+
+// Time of each PushByte() call in bins of 10ns, up to 100us.
+const uint32_t kNumLatencyBins = 10000;
+const uint8_t kNumLatencyPasses = 8;
+const uint32_t kMaxStreamSize = kMaxSize;
+
+class LatencyHistogram {
+ public:
+  void Clear() {
+    memset(bins_, 0, sizeof(bins_));
+    count_ = 0;
+    total_ = 0.0;
+    max_ = 0.0;
+  }
+
+  void Add(double ns) {
+    uint32_t bin = ns / 10.0;
+    ++bins_[bin < kNumLatencyBins ? bin : kNumLatencyBins - 1];
+    ++count_;
+    total_ += ns;
+    if (ns > max_) {
+      max_ = ns;
+    }
+  }
+
+  // Upper bound of the bin holding the given fraction of the calls.
+  double Percentile(double fraction) const {
+    uint32_t target = fraction * count_;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < kNumLatencyBins; ++i) {
+      count += bins_[i];
+      if (count > target) {
+        return (i + 1) * 10.0;
+      }
+    }
+    return max_;
+  }
+
+  double mean() const { return count_ ? total_ / count_ : 0.0; }
+  double max() const { return max_; }
+
+ private:
+  uint32_t bins_[kNumLatencyBins];
+  uint32_t count_;
+  double total_;
+  double max_;
+};
+
+LatencyHistogram latency;
+
+double HostNanoseconds() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+// Each byte is timed on several passes over the stream, from the same
+// initial state, and its time is the shortest one: this leaves out the host
+// preemptions and cache misses, not the cost of the firmware code.
+void TimeBytes(const Bytes& stream, LatencyHistogram* histogram) {
+  static double shortest[kMaxStreamSize];
+  for (uint8_t pass = 0; pass < kNumLatencyPasses; ++pass) {
+    InitFirmware();
+    midi::MidiStreamParser<MidiDispatcher> parser;
+    for (uint32_t i = 0; i < stream.size; ++i) {
+      double start = HostNanoseconds();
+      parser.PushByte(stream[i]);
+      double ns = HostNanoseconds() - start;
+      if (pass == 0 || ns < shortest[i]) {
+        shortest[i] = ns;
+      }
+      MidiDispatcher::OutputBufferLowPriority::Flush();
+      MidiDispatcher::OutputBufferHighPriority::Flush();
+    }
+  }
+  histogram->Clear();
+  for (uint32_t i = 0; i < stream.size; ++i) {
+    histogram->Add(shortest[i]);
+  }
+}
+
+Bytes flood;
+Bytes sysex;
+
+void Benchmark() {
+  InitFirmware();
+  srand(1);
+  RandomStream(16384, &stream);
+  FloodStream(1024, &flood);
+  SysExStream(256, &sysex);
+  midi::MidiStreamParser<MidiDispatcher> parser;
+  uint32_t num_bytes = 0;
+  clock_t start = ::clock();
+  while (::clock() - start < CLOCKS_PER_SEC) {
+    for (size_t i = 0; i < stream.size; ++i) {
+      parser.PushByte(stream[i]);
+      MidiDispatcher::OutputBufferLowPriority::Flush();
+    }
+    num_bytes += stream.size;
+  }
+  double seconds = double(::clock() - start) / CLOCKS_PER_SEC;
+  printf("parser + MidiDispatcher: %.1f Mbytes/s, %.0f times the MIDI rate\n",
+         num_bytes / seconds / 1e6, num_bytes / seconds / 3125.0);
+
+  // A MIDI byte lasts 320us.
+  const char* names[] = { "random", "0xfe flood", "SysEx + clock" };
+  const Bytes* streams[] = { &stream, &flood, &sysex };
+  printf("host ns per PushByte    mean   99.9%%      max\n");
+  for (uint8_t i = 0; i < 3; ++i) {
+    TimeBytes(*streams[i], &latency);
+    printf("%-18s %9.0f %7.0f %8.0f\n", names[i], latency.mean(),
+           latency.Percentile(0.999), latency.max());
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t num_streams = 20000;
+  uint32_t seed = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--benchmark")) {
+      Benchmark();
+      return 0;
+    } else if (!strcmp(argv[i], "--streams") && i + 1 < argc) {
+      num_streams = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      seed = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: midi_fuzz [--streams n] [--seed n] "
+              "[--benchmark]\n");
+      return 1;
+    }
+  }
+  return Fuzz(num_streams, seed);
+}
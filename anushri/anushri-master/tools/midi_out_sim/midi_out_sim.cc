@@ -0,0 +1,318 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Simulation of the MIDI out scheduling: MIDI thru throughput and latency of
+// the 0xf8 bytes generated by the internal clock.
+//
+// The real anu::Clock is ticked at 39kHz, the MIDI out is polled at 4.9kHz
+// (Timer0), and the main loop processes the clock events and moves the bytes
+// received on the MIDI in to the low priority output buffer after a random
+// delay. The UART has a data register and a shift register, a byte takes
+// 320us on the wire. Three versions of FlushMidiOut() are compared:
+//   always      the original one, low priority bytes are written whenever
+//               the data register is empty.
+//   alternate   a low priority byte is never written in the call following
+//               the one in which a byte was written.
+//   guard       low priority bytes are only held when a clock event is due
+//               within kClockByteGuardTicks, as in anu/anu.cc.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile midi_out_sim
+//   build/tools/midi_out_sim            prints the comparison table
+//   build/tools/midi_out_sim --check    exits with an error if the output
+//                                       buffer overflows at 90% thru load, or
+//                                       if clock bytes are delayed by more
+//                                       than a byte and a poll
+
+#include "anu/clock.h"
+
+#include "avrlib/ring_buffer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace anu;
+
+namespace {
+
+// Time is counted in CPU cycles (20MHz).
+const uint32_t kClockTickCycles = 510;  // Timer2, phase correct, 39.2kHz.
+const uint32_t kPollCycles = 4080;  // Timer0, phase correct, /8, 4.9kHz.
+const uint32_t kByteCycles = 6400;  // 10 bits at 31250 bps.
+
+// Same as in anu/anu.cc.
+const uint8_t kClockByteGuardTicks = 25;
+
+// Same sizes as in anu/midi_dispatcher.h.
+struct LowPriorityBufferSpecs {
+  enum {
+    buffer_size = 128,
+    data_size = 8,
+  };
+  typedef avrlib::DataTypeForSize<data_size>::Type Value;
+};
+
+struct HighPriorityBufferSpecs {
+  enum {
+    buffer_size = 16,
+    data_size = 8,
+  };
+  typedef avrlib::DataTypeForSize<data_size>::Type Value;
+};
+
+typedef avrlib::RingBuffer<LowPriorityBufferSpecs> LowPriority;
+typedef avrlib::RingBuffer<HighPriorityBufferSpecs> HighPriority;
+
+enum Policy {
+  POLICY_ALWAYS,
+  POLICY_ALTERNATE,
+  POLICY_GUARD,
+  POLICY_LAST
+};
+
+const char* const kPolicyNames[] = { "always", "alternate", "guard" };
+
+// UART with a data register and a shift register.
+struct Uart {
+  bool data_full;
+  uint8_t data;
+  uint32_t written_at;
+  uint32_t shift_end;
+
+  // Called with the time at which the byte entered the shift register.
+  void (*on_start)(uint8_t byte, uint32_t now);
+
+  void Advance(uint32_t now) {
+    if (data_full && shift_end <= now) {
+      uint32_t start = shift_end > written_at ? shift_end : written_at;
+      shift_end = start + kByteCycles;
+      data_full = false;
+      on_start(data, start);
+    }
+  }
+
+  bool writable() const { return !data_full; }
+
+  void Overwrite(uint8_t byte, uint32_t now) {
+    data = byte;
+    data_full = true;
+    written_at = now;
+    Advance(now);
+  }
+};
+
+struct Stats {
+  uint32_t offered;
+  uint32_t sent;
+  uint32_t overflows;
+  uint32_t num_clocks;
+  uint32_t latency_sum;
+  uint32_t latency_max;
+};
+
+Uart uart;
+Stats stats;
+
+// Time at which the pending 0xf8 bytes were generated.
+uint32_t clock_generated_at[HighPriorityBufferSpecs::buffer_size];
+uint8_t clock_read_ptr;
+uint8_t clock_write_ptr;
+
+// A byte has been written during the previous call to FlushMidiOut().
+bool tx_busy;
+
+void OnByteStart(uint8_t byte, uint32_t now) {
+  if (byte == 0xf8) {
+    uint32_t latency = now - clock_generated_at[clock_read_ptr];
+    clock_read_ptr = (clock_read_ptr + 1) % \
+        HighPriorityBufferSpecs::buffer_size;
+    stats.latency_sum += latency;
+    if (latency > stats.latency_max) {
+      stats.latency_max = latency;
+    }
+    ++stats.num_clocks;
+  } else {
+    ++stats.sent;
+  }
+}
+
+// Models of FlushMidiOut() in anu/anu.cc.
+void FlushMidiOut(Policy policy, uint32_t now) {
+  if (policy == POLICY_GUARD) {
+    if (!uart.writable()) {
+      return;
+    }
+    if (HighPriority::readable()) {
+      uart.Overwrite(HighPriority::ImmediateRead(), now);
+    } else if (LowPriority::readable()) {
+      if (clock.event_due(kClockByteGuardTicks)) {
+        return;
+      }
+      uart.Overwrite(LowPriority::ImmediateRead(), now);
+    }
+  } else if (HighPriority::readable()) {
+    if (uart.writable()) {
+      uart.Overwrite(HighPriority::ImmediateRead(), now);
+      tx_busy = true;
+    }
+  } else if (policy == POLICY_ALTERNATE && tx_busy) {
+    tx_busy = false;
+  } else if (LowPriority::readable()) {
+    if (uart.writable()) {
+      uart.Overwrite(LowPriority::ImmediateRead(), now);
+      tx_busy = true;
+    }
+  }
+}
+
+struct Result {
+  Stats stats;
+  uint32_t duration;
+};
+
+// Runs for the given number of seconds with the MIDI in receiving a byte in
+// load percent of the byte slots.
+Result Run(Policy policy, uint8_t bpm, uint8_t load, uint8_t seconds) {
+  memset(&stats, 0, sizeof(stats));
+  memset(&uart, 0, sizeof(uart));
+  uart.on_start = &OnByteStart;
+  clock_read_ptr = clock_write_ptr = 0;
+  tx_busy = false;
+  LowPriority::Flush();
+  HighPriority::Flush();
+  srand(bpm * 256 + load);
+
+  clock.Update(bpm, 1, 0, 1);
+  clock.Reset();
+
+  uint32_t duration = seconds * 20000000UL;
+  uint32_t next_tick = 0;
+  uint32_t next_poll = 0;
+  uint32_t next_loop = 0;
+  uint32_t next_input = 0;
+  uint16_t pending_input = 0;
+  uint32_t now = 0;
+  while (now < duration) {
+    // Next event.
+    now = next_tick;
+    if (next_poll < now) now = next_poll;
+    if (next_loop < now) now = next_loop;
+    if (next_input < now) now = next_input;
+    uart.Advance(now);
+
+    if (now == next_input) {
+      if (static_cast<uint32_t>(rand() % 100) < load) {
+        ++pending_input;
+        ++stats.offered;
+      }
+      next_input += kByteCycles;
+    }
+    if (now == next_tick) {
+      clock.Tick();
+      next_tick += kClockTickCycles;
+    }
+    if (now == next_poll) {
+      FlushMidiOut(policy, now);
+      next_poll += kPollCycles;
+    }
+    if (now == next_loop) {
+      while (pending_input) {
+        if (!LowPriority::writable()) {
+          ++stats.overflows;
+        }
+        LowPriority::Overwrite(0x90);
+        --pending_input;
+      }
+      uint8_t num_events = clock.CountEvents();
+      while (num_events--) {
+        clock_generated_at[clock_write_ptr] = now;
+        clock_write_ptr = (clock_write_ptr + 1) % \
+            HighPriorityBufferSpecs::buffer_size;
+        HighPriority::Overwrite(0xf8);
+      }
+      // The main loop runs every 50 to 500us.
+      next_loop += 1000 + rand() % 9000;
+    }
+  }
+  Result result;
+  result.stats = stats;
+  result.duration = duration;
+  return result;
+}
+
+uint32_t ToMicroseconds(uint32_t cycles) {
+  return cycles / 20;
+}
+
+void PrintResult(Policy policy, uint8_t bpm, uint8_t load, const Result& r) {
+  uint32_t capacity = r.duration / kByteCycles;
+  printf("%-9s %3d %3d%%  %5.1f%%  %6d  %6d  %4dus  %4dus\n",
+         kPolicyNames[policy],
+         bpm,
+         load,
+         100.0 * r.stats.sent / capacity,
+         r.stats.overflows,
+         r.stats.num_clocks,
+         r.stats.num_clocks ?
+             ToMicroseconds(r.stats.latency_sum / r.stats.num_clocks) : 0,
+         ToMicroseconds(r.stats.latency_max));
+}
+
+const uint8_t kTempos[] = { 120, 240 };
+const uint8_t kLoads[] = { 50, 75, 90, 95 };
+
+int Check() {
+  int errors = 0;
+  for (uint8_t i = 0; i < sizeof(kTempos); ++i) {
+    Result r = Run(POLICY_GUARD, kTempos[i], 90, 10);
+    PrintResult(POLICY_GUARD, kTempos[i], 90, r);
+    if (r.stats.overflows) {
+      fprintf(stderr, "%d output buffer overflows at %d BPM\n",
+              r.stats.overflows, kTempos[i]);
+      ++errors;
+    }
+    if (r.stats.latency_max > kByteCycles + kPollCycles) {
+      fprintf(stderr, "clock byte delayed by %dus at %d BPM\n",
+              ToMicroseconds(r.stats.latency_max), kTempos[i]);
+      ++errors;
+    }
+  }
+  return errors ? 1 : 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    return Check();
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: midi_out_sim [--check]\n");
+    return 1;
+  }
+  printf("policy    bpm load   thru    overfl  clocks  mean    max\n");
+  for (uint8_t policy = 0; policy < POLICY_LAST; ++policy) {
+    for (uint8_t i = 0; i < sizeof(kTempos); ++i) {
+      for (uint8_t j = 0; j < sizeof(kLoads); ++j) {
+        Result r = Run(
+            static_cast<Policy>(policy), kTempos[i], kLoads[j], 10);
+        PrintResult(static_cast<Policy>(policy), kTempos[i], kLoads[j], r);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,359 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host model of the pot scanning: synthetic knob trajectories and Gaussian
+// ADC noise are read by the real Ui::Poll(), at 612Hz, with
+// Ui::OversamplePot() converting the same pot again at the 7 other ticks of
+// the 4.9kHz timer, and by a model of the former scanner (one conversion per
+// poll, one pot per poll in a fixed round-robin, fixed thresholds). A
+// conversion is sampled at the tick which starts it, and read at the next.
+//
+// Over 20s, with the 12 other pots left alone:
+//   spurious   events posted by the pots left alone.
+//   sweep      a pot is swept by 400 LSBs, in 0.2s or in 1s. The latency is
+//              the time to its first event above the start position,
+//              averaged over 8 sweeps starting at times spread over a
+//              round-robin scan (it depends on when the pot is next
+//              scanned). The error is the mean difference between the knob
+//              and the last value posted (8 bits), during the sweep and 50ms
+//              after.
+//   noisy      a pot twice as noisy as the others is moved by 100 LSBs in 1s:
+//              number of events posted (a dozen or more to follow it).
+//
+// Build and run, from the source root:
+//   make -f tools/makefile pot_scan_sim
+//   build/tools/pot_scan_sim            prints the table
+//   build/tools/pot_scan_sim --check    exits with an error if the scanner
+//                                       posts more spurious events, reacts
+//                                       later to a sweep (sigma up to 2),
+//                                       follows a fast sweep less closely or
+//                                       posts more events for the noisy pot
+//                                       than the former one, or if the noisy
+//                                       pot cannot be moved
+//
+// At sigma 3, the former scanner posts an event at most scans of a pot left
+// alone: its first event after the start of a sweep is noise more often than
+// the sweep, and its latency is not a bound the scanner can meet without
+// posting noise too.
+
+#include "anu/drum_synth.h"
+#include "anu/system_settings.h"
+#include "anu/voice_controller.h"
+
+// The simulation feeds the pot being converted and reads the event queue.
+#define private public
+#include "anu/ui.h"
+#undef private
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace anu;
+using namespace avrlib;
+
+namespace {
+
+const double kTickRate = 20000000.0 / 510 / 8;  // 4.9kHz
+const uint8_t kTicksPerPoll = 8;
+const double kDuration = 20.0;
+const double kSweepStart = 10.0;
+const double kScanPeriod = kNumPots * kTicksPerPoll / kTickRate;
+const uint8_t kNumSweepPhases = 8;
+const double kNoisyMoveStart = 15.0;
+const uint8_t kSweptPot = 3;
+const uint8_t kNoisyPot = 5;
+const uint16_t kSweepSize = 400;
+const uint16_t kNoisyMoveSize = 100;
+
+// Knobs and ADC.
+
+double knobs[kNumPots];
+
+double Gaussian() {
+  double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+  double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+  return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+uint16_t Convert(uint8_t pot, double sigma) {
+  long x = lround(knobs[pot] + Gaussian() * sigma);
+  return x < 0 ? 0 : (x > 1023 ? 1023 : x);
+}
+
+// Scanners. Poll() is given the conversion started by the previous call (or
+// by the previous Oversample() call), and returns the number of events
+// posted, in events. Oversample() is called at the other ticks, and returns
+// whether it consumed the conversion and started a new one.
+
+struct PotEvent {
+  uint8_t pot;
+  uint8_t value;
+};
+
+class Scanner {
+ public:
+  virtual ~Scanner() { }
+  virtual void Init() = 0;
+  virtual uint8_t converted_pot() const = 0;
+  virtual uint8_t Poll(uint16_t adc_value, PotEvent* events) = 0;
+  virtual bool Oversample(uint16_t adc_value) = 0;
+};
+
+// Ui::Poll().
+class FirmwareScanner : public Scanner {
+ public:
+  virtual void Init() {
+    ui.Init();
+    memset(ui.adc_values_, 0, sizeof(ui.adc_values_));
+    memset(ui.adc_previous_lsbs_, 0, sizeof(ui.adc_previous_lsbs_));
+    memset(ui.adc_noise_, 0, sizeof(ui.adc_noise_));
+    ui.scanned_pot_ = 0;
+    ui.converted_pot_ = 0;
+    ui.moving_pot_ = kNumPots;
+    ui.moving_pot_timeout_ = 0;
+    ui.adc_sum_ = 0;
+    ui.pot_scanning_warm_up_ = 16;
+    ui.FlushEvents();
+  }
+
+  virtual uint8_t converted_pot() const {
+    return ui.converted_pot_;
+  }
+
+  virtual uint8_t Poll(uint16_t adc_value, PotEvent* events) {
+    ADCL = adc_value & 0xff;
+    ADCH = adc_value >> 8;
+    ui.Poll();
+    uint8_t num_events = 0;
+    while (ui.queue_.available()) {
+      Event e = ui.queue_.PullEvent();
+      if (e.control_type == CONTROL_POT) {
+        events[num_events].pot = e.control_id;
+        events[num_events].value = e.value;
+        ++num_events;
+      }
+    }
+    return num_events;
+  }
+
+  virtual bool Oversample(uint16_t adc_value) {
+    ADCL = adc_value & 0xff;
+    ADCH = adc_value >> 8;
+    ui.OversamplePot();
+    return true;
+  }
+};
+
+// The pot scanning of Ui::Poll() before the moving pot was scanned more
+// often, the stationary pots oversampled and the hysteresis adapted to the
+// noise.
+class RoundRobinScanner : public Scanner {
+ public:
+  virtual void Init() {
+    memset(adc_values_, 0, sizeof(adc_values_));
+    scanned_pot_ = 0;
+    warm_up_ = 16;
+  }
+
+  virtual uint8_t converted_pot() const {
+    return scanned_pot_;
+  }
+
+  virtual uint8_t Poll(uint16_t adc_value, PotEvent* events) {
+    uint8_t num_events = 0;
+    int16_t delta = adc_values_[scanned_pot_] - adc_value;
+    if (delta < 0) {
+      delta = -delta;
+    }
+    if (delta >= kThreshold) {
+      adc_values_[scanned_pot_] = adc_value;
+      if (!warm_up_) {
+        events[0].pot = scanned_pot_;
+        events[0].value = adc_value >> 2;
+        num_events = 1;
+      }
+    }
+    ++scanned_pot_;
+    if (scanned_pot_ == kNumPots) {
+      scanned_pot_ = 0;
+      if (warm_up_) {
+        --warm_up_;
+      }
+    }
+    return num_events;
+  }
+
+  virtual bool Oversample(uint16_t adc_value) {
+    return false;
+  }
+
+ private:
+  static const uint8_t kThreshold = 4;
+
+  uint16_t adc_values_[kNumPots];
+  uint8_t scanned_pot_;
+  uint8_t warm_up_;
+};
+
+// Simulation.
+
+struct Result {
+  uint32_t spurious_events;
+  double latency;  // ms
+  double error;  // 8-bit LSBs
+  uint32_t noisy_pot_events;
+};
+
+Result Simulate(
+    Scanner* scanner,
+    double sigma,
+    double sweep_duration,
+    double sweep_start) {
+  srand(1);
+  scanner->Init();
+  for (uint8_t i = 0; i < kNumPots; ++i) {
+    knobs[i] = 300.0 + i * 30.0;
+  }
+  Result result;
+  memset(&result, 0, sizeof(result));
+  result.latency = -1.0;
+  double swept_knob = knobs[kSweptPot];
+  double noisy_knob = knobs[kNoisyPot];
+  int16_t last_value = -1;
+  double total_error = 0.0;
+  uint32_t num_errors = 0;
+  uint16_t adc_value = 0;
+  uint32_t num_ticks = static_cast<uint32_t>(kDuration * kTickRate);
+  for (uint32_t i = 0; i < num_ticks; ++i) {
+    double t = i / kTickRate;
+    if (t >= sweep_start) {
+      double x = (t - sweep_start) / sweep_duration;
+      knobs[kSweptPot] = swept_knob + kSweepSize * (x > 1.0 ? 1.0 : x);
+    }
+    if (t >= kNoisyMoveStart) {
+      double x = t - kNoisyMoveStart;
+      knobs[kNoisyPot] = noisy_knob + kNoisyMoveSize * (x > 1.0 ? 1.0 : x);
+    }
+    PotEvent events[kNumPots];
+    uint8_t num_events = 0;
+    bool converted = true;
+    if (i % kTicksPerPoll == 0) {
+      num_events = scanner->Poll(adc_value, events);
+    } else {
+      converted = scanner->Oversample(adc_value);
+    }
+    if (converted) {
+      uint8_t pot = scanner->converted_pot();
+      adc_value = Convert(pot, pot == kNoisyPot ? 2.0 * sigma : sigma);
+    }
+    for (uint8_t j = 0; j < num_events; ++j) {
+      const PotEvent& e = events[j];
+      if (e.pot == kSweptPot) {
+        last_value = e.value;
+        if (t >= sweep_start && e.value > swept_knob / 4.0 &&
+            result.latency < 0.0) {
+          result.latency = (t - sweep_start) * 1000.0;
+        }
+      } else if (e.pot == kNoisyPot) {
+        if (t >= kNoisyMoveStart) {
+          ++result.noisy_pot_events;
+        }
+      } else if (t >= 1.0) {
+        ++result.spurious_events;
+      }
+    }
+    if (i % kTicksPerPoll == 0 && t >= sweep_start &&
+        t < sweep_start + sweep_duration + 0.05 && last_value >= 0) {
+      total_error += fabs(knobs[kSweptPot] / 4.0 - last_value);
+      ++num_errors;
+    }
+  }
+  result.error = num_errors ? total_error / num_errors : 0.0;
+  return result;
+}
+
+// Simulates the sweep starting at kNumSweepPhases times spread over a scan,
+// and reports the mean latency.
+Result SimulateSweep(Scanner* scanner, double sigma, double sweep_duration) {
+  Result result = Simulate(scanner, sigma, sweep_duration, kSweepStart);
+  double total_latency = result.latency;
+  for (uint8_t i = 1; i < kNumSweepPhases; ++i) {
+    double start = kSweepStart + i * kScanPeriod / kNumSweepPhases;
+    total_latency += Simulate(scanner, sigma, sweep_duration, start).latency;
+  }
+  result.latency = total_latency / kNumSweepPhases;
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: pot_scan_sim [--check]\n");
+    return 1;
+  }
+
+  // As Init() in anu/anu.cc: the pot events reach the voice controller.
+  system_settings.Init();
+  drum_synth.Init();
+  voice_controller.Init();
+
+  RoundRobinScanner round_robin;
+  FirmwareScanner firmware;
+  Scanner* scanners[] = { &round_robin, &firmware };
+  static const char* const kScannerNames[] = { "round-robin", "adaptive" };
+  static const double kSigmas[] = { 1.0, 2.0, 3.0 };
+
+  int failures = 0;
+  printf("%-5s %-11s %9s %14s %14s %6s\n",
+         "", "", "spurious", "0.2s sweep", "1s sweep", "noisy");
+  printf("%-5s %-11s %9s %7s %6s %7s %6s %6s\n",
+         "sigma", "scanner", "events", "ms", "error", "ms", "error", "events");
+  for (uint8_t s = 0; s < sizeof(kSigmas) / sizeof(kSigmas[0]); ++s) {
+    Result fast[2];
+    Result slow[2];
+    for (uint8_t i = 0; i < 2; ++i) {
+      fast[i] = SimulateSweep(scanners[i], kSigmas[s], 0.2);
+      slow[i] = SimulateSweep(scanners[i], kSigmas[s], 1.0);
+      printf("%-5.1f %-11s %9u %7.1f %6.2f %7.1f %6.2f %6u\n",
+             kSigmas[s], kScannerNames[i], slow[i].spurious_events,
+             fast[i].latency, fast[i].error, slow[i].latency, slow[i].error,
+             slow[i].noisy_pot_events);
+    }
+    if (kSigmas[s] >= 2.0 &&
+        slow[1].spurious_events > slow[0].spurious_events) {
+      ++failures;
+    }
+    if (kSigmas[s] <= 2.0 && (fast[1].latency > fast[0].latency ||
+                              slow[1].latency > slow[0].latency)) {
+      ++failures;
+    }
+    if (fast[1].error > fast[0].error) {
+      ++failures;
+    }
+    if (slow[1].noisy_pot_events > slow[0].noisy_pot_events ||
+        slow[1].noisy_pot_events < 12) {
+      ++failures;
+    }
+  }
+  return check && failures ? 1 : 0;
+}
@@ -0,0 +1,258 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Decoding of the compressed resources.
+//
+// Each compressed entry of anu/resources.cc is decoded as the firmware does,
+// and its size and CRC-16 are compared with the _DECODED_SIZE and _CHECKSUM
+// values the resources compiler computed from the data it encoded:
+//
+//   glide_increments, drm_env_increments, env_coefficients
+//              'delta2' tables, read with ResourcesManager::LookupDelta2().
+//   hh, oh, clap, rim
+//              'adpcm' samples, read with AdpcmDecoder as DrumSynth::Render()
+//              does. The ADPCM codec is lossy: the checksum is the one of the
+//              decoder output, see hh_snr for the error against the source.
+//
+// The decode cost is the host time per decoded value, and the worst case in
+// decoding steps: nibbles for a 'delta2' value, ADPCM steps for a sample
+// played at the highest pitch DrumSynth allows (2 source samples per output
+// sample), block restarts included. The AVR cycles are not counted.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile resources_test
+//   build/tools/resources_test            prints the results
+//   build/tools/resources_test --check    exits with an error if an entry does
+//                                         not decode to its checksum
+
+#include "avrlib/adpcm.h"
+
+#include "anu/resources.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+using namespace anu;
+using avrlib::AdpcmDecoder;
+using avrlib::kAdpcmBlockSize;
+
+namespace {
+
+const uint16_t kMaxDecodedSize = 4096;
+const uint16_t kNumPasses = 2000;
+const uint8_t kDelta2BlockSize = 16;
+const uint16_t kMaxHhPhaseIncrement = 32;
+
+// Same as _crc16_update from avr-libc and Crc16 in resources_compiler.py.
+uint16_t Crc16(uint16_t crc, uint8_t value) {
+  crc ^= value;
+  for (uint8_t i = 0; i < 8; ++i) {
+    crc = crc & 1 ? (crc >> 1) ^ 0xa001 : crc >> 1;
+  }
+  return crc;
+}
+
+double HostSeconds() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+struct Result {
+  const char* name;
+  uint16_t stored_size;
+  uint16_t decoded_size;
+  uint16_t expected_decoded_size;
+  uint16_t checksum;
+  uint16_t expected_checksum;
+  double ns_per_value;
+  uint16_t worst;
+  const char* worst_unit;
+};
+
+struct Delta2Table {
+  const char* name;
+  const prog_uint16_t* data;
+  const prog_uint16_t* blocks;
+  uint16_t stored_size;
+  uint16_t decoded_size;
+  uint16_t checksum;
+};
+
+const Delta2Table delta2_tables[] = {
+  { "glide_increments", lut_res_glide_increments,
+    lut_res_glide_increments_blocks, LUT_RES_GLIDE_INCREMENTS_SIZE,
+    LUT_RES_GLIDE_INCREMENTS_DECODED_SIZE,
+    LUT_RES_GLIDE_INCREMENTS_CHECKSUM },
+  { "drm_env_increments", lut_res_drm_env_increments,
+    lut_res_drm_env_increments_blocks, LUT_RES_DRM_ENV_INCREMENTS_SIZE,
+    LUT_RES_DRM_ENV_INCREMENTS_DECODED_SIZE,
+    LUT_RES_DRM_ENV_INCREMENTS_CHECKSUM },
+  { "env_coefficients", lut_res_env_coefficients,
+    lut_res_env_coefficients_blocks, LUT_RES_ENV_COEFFICIENTS_SIZE,
+    LUT_RES_ENV_COEFFICIENTS_DECODED_SIZE,
+    LUT_RES_ENV_COEFFICIENTS_CHECKSUM },
+};
+
+Result TestDelta2(const Delta2Table& table) {
+  static uint16_t decoded[kMaxDecodedSize];
+  Result result;
+  memset(&result, 0, sizeof(Result));
+  result.name = table.name;
+  result.stored_size = table.stored_size * 2;
+  result.expected_decoded_size = table.decoded_size;
+  result.expected_checksum = table.checksum;
+  result.worst_unit = "nibbles";
+
+  result.decoded_size = table.decoded_size;
+  for (uint16_t i = 0; i < result.decoded_size; ++i) {
+    decoded[i] = ResourcesManager::LookupDelta2(table.data, table.blocks, i);
+    // Values are checksummed low byte first, as they are stored.
+    result.checksum = Crc16(result.checksum, decoded[i] & 0xff);
+    result.checksum = Crc16(result.checksum, decoded[i] >> 8);
+    // LookupDelta2 reads a second order difference per value after the
+    // second one of a coded block.
+    uint16_t header = pgm_read_word(table.blocks + i / kDelta2BlockSize);
+    uint8_t n = i % kDelta2BlockSize;
+    if ((header & 0x8000) && n > 1 && n - 1 > result.worst) {
+      result.worst = n - 1;
+    }
+  }
+
+  uint32_t sum = 0;
+  double start = HostSeconds();
+  for (uint16_t pass = 0; pass < kNumPasses; ++pass) {
+    for (uint16_t i = 0; i < result.decoded_size; ++i) {
+      sum += ResourcesManager::LookupDelta2(table.data, table.blocks, i);
+    }
+  }
+  double elapsed = HostSeconds() - start;
+  result.ns_per_value = elapsed * 1e9 / kNumPasses / result.decoded_size;
+  // Keeps the loop from being optimized out.
+  if (sum == 0) {
+    result.ns_per_value = 0.0;
+  }
+  return result;
+}
+
+struct AdpcmSample {
+  const char* name;
+  const prog_uint8_t* data;
+  uint16_t stored_size;
+  uint16_t decoded_size;
+  uint16_t checksum;
+};
+
+const AdpcmSample adpcm_samples[] = {
+  { "hh", wav_res_hh, WAV_RES_HH_SIZE, WAV_RES_HH_DECODED_SIZE,
+    WAV_RES_HH_CHECKSUM },
+  { "oh", wav_res_oh, WAV_RES_OH_SIZE, WAV_RES_OH_DECODED_SIZE,
+    WAV_RES_OH_CHECKSUM },
+  { "clap", wav_res_clap, WAV_RES_CLAP_SIZE, WAV_RES_CLAP_DECODED_SIZE,
+    WAV_RES_CLAP_CHECKSUM },
+  { "rim", wav_res_rim, WAV_RES_RIM_SIZE, WAV_RES_RIM_DECODED_SIZE,
+    WAV_RES_RIM_CHECKSUM },
+};
+
+Result TestAdpcm(const AdpcmSample& adpcm) {
+  Result result;
+  memset(&result, 0, sizeof(Result));
+  result.name = adpcm.name;
+  result.stored_size = adpcm.stored_size;
+  result.expected_decoded_size = adpcm.decoded_size;
+  result.expected_checksum = adpcm.checksum;
+  result.worst_unit = "steps";
+
+  AdpcmDecoder decoder;
+  decoder.Init(adpcm.data);
+  result.decoded_size = adpcm.decoded_size;
+  for (uint16_t i = 0; i < result.decoded_size; ++i) {
+    result.checksum = Crc16(result.checksum, decoder.Read(i));
+  }
+
+  // Playback at the highest pitch, once: the samples are one-shots.
+  decoder.Init(adpcm.data);
+  uint16_t end = adpcm.decoded_size << 4;
+  for (uint16_t phase = kMaxHhPhaseIncrement; phase < end;
+       phase += kMaxHhPhaseIncrement) {
+    uint16_t sample = phase >> 4;
+    uint16_t steps = sample >= decoder.position() &&
+        sample / kAdpcmBlockSize == decoder.position() / kAdpcmBlockSize ?
+            sample - decoder.position() : sample % kAdpcmBlockSize;
+    if (steps > result.worst) {
+      result.worst = steps;
+    }
+    decoder.Read(sample);
+  }
+
+  int32_t sum = 0;
+  double start = HostSeconds();
+  for (uint16_t pass = 0; pass < kNumPasses; ++pass) {
+    for (uint16_t i = 0; i < result.decoded_size; ++i) {
+      sum += decoder.Read(i);
+    }
+  }
+  double elapsed = HostSeconds() - start;
+  result.ns_per_value = elapsed * 1e9 / kNumPasses / result.decoded_size;
+  if (sum == 0) {
+    result.ns_per_value = 0.0;
+  }
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: resources_test [--check]\n");
+    return 1;
+  }
+
+  const uint8_t kNumDelta2Tables = sizeof(delta2_tables) / sizeof(Delta2Table);
+  const uint8_t kNumAdpcmSamples = sizeof(adpcm_samples) / sizeof(AdpcmSample);
+  const uint8_t kNumResults = kNumDelta2Tables + kNumAdpcmSamples;
+  Result results[kNumResults];
+  for (uint8_t i = 0; i < kNumDelta2Tables; ++i) {
+    results[i] = TestDelta2(delta2_tables[i]);
+  }
+  for (uint8_t i = 0; i < kNumAdpcmSamples; ++i) {
+    results[kNumDelta2Tables + i] = TestAdpcm(adpcm_samples[i]);
+  }
+
+  uint8_t failures = 0;
+  printf("%-20s %7s %8s %9s %9s %7s\n",
+         "entry", "stored", "decoded", "checksum", "ns/value", "worst");
+  for (uint8_t i = 0; i < kNumResults; ++i) {
+    const Result& r = results[i];
+    bool ok = r.decoded_size == r.expected_decoded_size &&
+        r.checksum == r.expected_checksum;
+    printf("%-20s %7d %8d    0x%04x %9.1f %7d %s%s\n",
+           r.name, r.stored_size, r.decoded_size, r.checksum,
+           r.ns_per_value, r.worst, r.worst_unit, ok ? "" : "  MISMATCH");
+    if (!ok) {
+      printf("  expected %d values, checksum 0x%04x\n",
+             r.expected_decoded_size, r.expected_checksum);
+      ++failures;
+    }
+  }
+  printf("stored: in bytes. decoded: in values. ns/value: host time.\n");
+  return check && failures ? 1 : 0;
+}
@@ -0,0 +1,439 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Tests and EEPROM timing of anu::SequenceBank.
+//
+// - Round trips: random sequences are saved in random slots, while the main
+//   loop calls Tick() and the EEPROM is randomly busy. All the slots must then
+//   load as saved, truncated if the bank is full.
+// - Playback: a chain is played by the sequencer clock, and must give the
+//   steps of the loaded sequences. During a save, it must go on with the old
+//   version of the saved slot - or give rests once it is overwritten - then
+//   continue with the new version from the same step.
+// - Timing: an EEPROM write takes 3.4ms (ATmega328 datasheet, table 8-2), the
+//   main loop is modelled as calling Tick() every 100us. A save is timed in
+//   the worst cases - a long sequence saved in the first slot of a full bank,
+//   and the same slot cleared - with Tick(), and as a single blocking call,
+//   the way the bank used to be written.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile sequence_bank_sim
+//   build/tools/sequence_bank_sim            prints the timings
+//   build/tools/sequence_bank_sim --check    also exits with an error if a
+//                                            test fails, or if a main loop
+//                                            iteration is blocked for more
+//                                            than 1ms
+
+#include "anu/sequence_bank.h"
+
+#include <avr/eeprom.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace anu;
+
+namespace {
+
+const double kWriteTime = 3.4e-3;
+const double kLoopPeriod = 100e-6;
+const double kMaxBlockingTime = 1e-3;
+
+const uint16_t kBankSize = 743;
+
+void RandomSequence(Sequence* sequence, uint8_t length, bool melodic) {
+  memset(sequence, 0, sizeof(Sequence));
+  sequence->num_notes = length;
+  int16_t note = 48;
+  for (uint8_t i = 0; i < length; ++i) {
+    uint8_t r = rand() % 10;
+    if (r < 2) {
+      sequence->notes[i] = 0xff;
+    } else if (r < 3) {
+      sequence->notes[i] = 0xfe;
+    } else if (!melodic) {
+      sequence->notes[i] = rand() % 128;
+    } else {
+      note += rand() % 13 - 6;
+      if (rand() % 8 == 0) {
+        note += rand() % 2 ? 24 : -24;
+      }
+      note = note < 0 ? 0 : (note > 127 ? 127 : note);
+      sequence->notes[i] = note;
+    }
+    if (rand() % 4 == 0) {
+      sequence->accents[i >> 3] |= 1 << (i & 7);
+    }
+    if (rand() % 5 == 0) {
+      sequence->slides[i >> 3] |= 1 << (i & 7);
+    }
+  }
+}
+
+// Clears what is not stored: the flags of rests and ties, and everything past
+// the end of the sequence.
+void Canonicalize(Sequence* sequence) {
+  for (uint8_t i = 0; i < kMaxSequenceLength; ++i) {
+    uint8_t mask = 1 << (i & 7);
+    if (i >= sequence->num_notes || sequence->notes[i] >= 0x80) {
+      sequence->accents[i >> 3] &= ~mask;
+      sequence->slides[i >> 3] &= ~mask;
+    }
+    if (i >= sequence->num_notes) {
+      sequence->notes[i] = 0;
+    }
+  }
+}
+
+bool SameSequence(const Sequence& a, const Sequence& b) {
+  Sequence x = a;
+  Sequence y = b;
+  Canonicalize(&x);
+  Canonicalize(&y);
+  return !memcmp(&x, &y, sizeof(Sequence));
+}
+
+// Main loop model.
+
+double now;
+double eeprom_ready_time;
+double longest_blocking_time;
+
+// Runs a function called by the main loop, and advances the time by the time
+// spent waiting for the EEPROM, then by one main loop iteration.
+template<typename F>
+void RunMainLoop(F f) {
+  host_eeprom_ready = now >= eeprom_ready_time;
+  uint32_t writes = host_eeprom_writes;
+  f();
+  writes = host_eeprom_writes - writes;
+  double blocking_time = 0.0;
+  if (writes) {
+    // The first write waits for the previous one, each following write waits
+    // for the one before.
+    if (eeprom_ready_time > now) {
+      blocking_time = eeprom_ready_time - now;
+    }
+    blocking_time += (writes - 1) * kWriteTime;
+    eeprom_ready_time = now + blocking_time + kWriteTime;
+  }
+  if (blocking_time > longest_blocking_time) {
+    longest_blocking_time = blocking_time;
+  }
+  now += blocking_time + kLoopPeriod;
+}
+
+uint8_t save_slot;
+Sequence* save_sequence;
+
+void Save() { sequence_bank.Save(save_slot, save_sequence); }
+void SaveAndFlush() { Save(); sequence_bank.Flush(); }
+void Tick() { sequence_bank.Tick(); }
+
+struct Timing {
+  uint32_t writes;
+  double duration;
+  double longest_blocking_time;
+};
+
+Timing TimeSave(uint8_t slot, Sequence* sequence, bool blocking) {
+  now = 0.0;
+  eeprom_ready_time = 0.0;
+  longest_blocking_time = 0.0;
+  save_slot = slot;
+  save_sequence = sequence;
+  uint32_t writes = host_eeprom_writes;
+  RunMainLoop(blocking ? SaveAndFlush : Save);
+  while (sequence_bank.busy()) {
+    RunMainLoop(Tick);
+  }
+  Timing timing;
+  timing.writes = host_eeprom_writes - writes;
+  timing.duration = (eeprom_ready_time > now ? eeprom_ready_time : now);
+  timing.longest_blocking_time = longest_blocking_time;
+  return timing;
+}
+
+uint16_t BankSize() {
+  uint16_t size = 0;
+  uint8_t num_sequences = 0;
+  while (num_sequences < kNumSequences) {
+    if (host_eeprom[257 + size++] == 0xff) {
+      ++num_sequences;
+    }
+  }
+  return size;
+}
+
+// Tests.
+
+Sequence saved[kNumSequences];
+
+bool CheckSlots(uint32_t iteration) {
+  for (uint8_t slot = 0; slot < kNumSequences; ++slot) {
+    Sequence loaded;
+    sequence_bank.Load(slot, &loaded);
+    if (!SameSequence(loaded, saved[slot])) {
+      printf("round trip %d: slot %d differs\n", iteration, slot);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestRoundTrips() {
+  srand(1);
+  memset(saved, 0, sizeof(saved));
+  sequence_bank.Format();
+  if (!sequence_bank.Init()) {
+    printf("the formatted bank is not valid\n");
+    return false;
+  }
+  uint32_t num_truncated = 0;
+  Sequence buffers[2];
+  for (uint32_t i = 0; i < 20000; ++i) {
+    uint8_t slot = rand() % kNumSequences;
+    uint8_t length = rand() % 4 == 0 ? rand() % 129 : (1 + rand() % 4) * 16;
+    // The sequence being saved is not modified until the next save.
+    Sequence* sequence = &buffers[i & 1];
+    RandomSequence(sequence, length, rand() % 2);
+    sequence_bank.Save(slot, sequence);
+    if (sequence->num_notes > length) {
+      printf("round trip %d: sequence longer than saved\n", i);
+      return false;
+    }
+    num_truncated += sequence->num_notes < length;
+    saved[slot] = *sequence;
+    // Every other save is completed by a later save or load.
+    while (sequence_bank.busy() && (i & 1)) {
+      host_eeprom_ready = rand() % 4;
+      sequence_bank.Tick();
+    }
+    host_eeprom_ready = true;
+    if ((i % 16) == 0 && !CheckSlots(i)) {
+      return false;
+    }
+  }
+  if (!CheckSlots(20000)) {
+    return false;
+  }
+  printf("20000 random saves: all slots load as saved, %d truncated\n",
+         num_truncated);
+  return true;
+}
+
+bool CheckStep(const Sequence& sequence, uint8_t i) {
+  const SequenceStep& step = sequence_bank.step();
+  uint8_t mask = 1 << (i & 7);
+  bool accent = sequence.accents[i >> 3] & mask;
+  bool slide = sequence.slides[i >> 3] & mask;
+  return step.note == sequence.notes[i] && step.position == i &&
+      (step.note >= 0x80 || (step.accent == accent && step.slide == slide));
+}
+
+// Position in the chain of the slots in saved[].
+struct Cursor {
+  uint8_t slot;
+  uint8_t position;
+};
+
+// Skips the ends of sequences and the empty slots. restart is set when a new
+// chain was set, which starts at the end of the current sequence.
+void Normalize(Cursor* cursor, uint8_t first_slot, uint8_t num_slots,
+               bool* restart) {
+  while (cursor->position >= saved[cursor->slot].num_notes) {
+    cursor->position = 0;
+    ++cursor->slot;
+    if (cursor->slot >= first_slot + num_slots || *restart) {
+      cursor->slot = first_slot;
+      *restart = false;
+    }
+  }
+}
+
+// Saves slot 0 while the chain of slots 0 to 2 is playing slot 1. The steps
+// must be the ones of the old version of the slots, or rests in slot 0 once
+// it is overwritten, then the ones of the new version.
+bool TestPlaybackDuringSave(uint8_t length, uint16_t* num_notes,
+                            uint16_t* num_rests) {
+  const uint8_t kChainSize = 3;
+  sequence_bank.SetChain(0, kChainSize);
+  sequence_bank.Rewind();
+  Cursor cursor = { 0, 0 };
+  bool restart = false;
+  while (cursor.slot != 1 || cursor.position != 4) {
+    sequence_bank.Advance();
+    ++cursor.position;
+    Normalize(&cursor, 0, kChainSize, &restart);
+  }
+
+  static Sequence sequence;
+  RandomSequence(&sequence, length, true);
+  sequence_bank.Save(0, &sequence);
+  // As VoiceController::SaveSequence() does.
+  sequence_bank.SetChain(0, kChainSize);
+  restart = true;
+  *num_notes = 0;
+  *num_rests = 0;
+  bool saving = true;
+  for (uint16_t i = 0; saving || i < 1000; ++i) {
+    if (CheckStep(saved[cursor.slot], cursor.position)) {
+      *num_notes += saving;
+    } else if (saving && cursor.slot == 0 &&
+               sequence_bank.step().note == 0xff &&
+               sequence_bank.step().position == cursor.position) {
+      ++*num_rests;
+    } else {
+      printf("playback %s the save of %d steps: slot %d, step %d differs\n",
+             saving ? "during" : "after", length, cursor.slot,
+             cursor.position);
+      return false;
+    }
+    sequence_bank.Advance();
+    ++cursor.position;
+    Normalize(&cursor, 0, kChainSize, &restart);
+    sequence_bank.Tick();
+    if (saving && !sequence_bank.busy()) {
+      saving = false;
+      saved[0] = sequence;
+      Normalize(&cursor, 0, kChainSize, &restart);
+    }
+  }
+  return true;
+}
+
+bool TestPlayback() {
+  srand(2);
+  sequence_bank.Format();
+  for (uint8_t slot = 0; slot < kNumSequences; ++slot) {
+    RandomSequence(&saved[slot], slot == 3 ? 0 : (slot + 1) * 8, true);
+    sequence_bank.Save(slot, &saved[slot]);
+  }
+  sequence_bank.Flush();
+
+  // Slots 2 to 5, slot 3 is empty.
+  sequence_bank.SetChain(2, 4);
+  sequence_bank.Rewind();
+  for (uint8_t loop = 0; loop < 3; ++loop) {
+    for (uint8_t slot = 2; slot < 6; ++slot) {
+      for (uint8_t i = 0; i < saved[slot].num_notes; ++i) {
+        if (!CheckStep(saved[slot], i)) {
+          printf("playback: slot %d, step %d differs\n", slot, i);
+          return false;
+        }
+        sequence_bank.Advance();
+      }
+    }
+  }
+
+  // Slot 0 saved longer, then shorter, so that the following slots move up,
+  // then down.
+  uint16_t num_notes[2];
+  uint16_t num_rests[2];
+  if (!TestPlaybackDuringSave(40, &num_notes[0], &num_rests[0]) ||
+      !TestPlaybackDuringSave(4, &num_notes[1], &num_rests[1])) {
+    return false;
+  }
+
+  sequence_bank.Format();
+  sequence_bank.SetChain(0, kNumSequences);
+  sequence_bank.Rewind();
+  if (!sequence_bank.empty()) {
+    printf("playback: the empty bank is not empty\n");
+    return false;
+  }
+  printf("chained playback matches the slots, during a save: %d steps and "
+         "%d rests, then %d steps and %d rests\n", num_notes[0], num_rests[0],
+         num_notes[1], num_rests[1]);
+  return true;
+}
+
+// Timing.
+
+void FillBank() {
+  // Slot 0 empty, the other slots use all the room but what a long sequence
+  // in slot 0 needs, so that saving it moves as many bytes as possible.
+  srand(3);
+  sequence_bank.Format();
+  for (uint8_t slot = 1; slot < kNumSequences; ++slot) {
+    Sequence sequence;
+    RandomSequence(&sequence, slot == 1 ? 128 : 64, slot != 1);
+    sequence_bank.Save(slot, &sequence);
+    sequence_bank.Flush();
+  }
+}
+
+bool PrintTiming(const char* name, const Timing& timing, bool blocking) {
+  printf("%-36s %4d writes  %6.0fms  %7.1fms\n", name, timing.writes,
+         timing.duration * 1000.0, timing.longest_blocking_time * 1000.0);
+  return blocking || timing.longest_blocking_time <= kMaxBlockingTime;
+}
+
+bool TestTiming() {
+  // Both ways of saving start from the same EEPROM contents.
+  FillBank();
+  uint8_t filled_bank[HOST_EEPROM_SIZE];
+  memcpy(filled_bank, host_eeprom, HOST_EEPROM_SIZE);
+  uint16_t size = BankSize();
+
+  Sequence sequence;
+  bool ok = true;
+  printf("\n%-36s %11s  %8s  %9s\n", "save", "", "duration", "blocking");
+  for (uint8_t blocking = 0; blocking < 2; ++blocking) {
+    const char* mode = blocking ? "blocking" : "Tick()";
+    memcpy(host_eeprom, filled_bank, HOST_EEPROM_SIZE);
+    srand(4);
+    RandomSequence(&sequence, 128, true);
+    char name[64];
+    sprintf(name, "128 steps in slot 0 (%s)", mode);
+    ok = PrintTiming(name, TimeSave(0, &sequence, blocking), blocking) && ok;
+    if (!blocking) {
+      printf("(bank: %d then %d of %d bytes used)\n", size, BankSize(),
+             kBankSize);
+    }
+
+    memset(&sequence, 0, sizeof(sequence));
+    sprintf(name, "slot 0 cleared (%s)", mode);
+    ok = PrintTiming(name, TimeSave(0, &sequence, blocking), blocking) && ok;
+  }
+
+  // A 16 step line saved again with one note changed.
+  memcpy(host_eeprom, filled_bank, HOST_EEPROM_SIZE);
+  srand(5);
+  RandomSequence(&sequence, 16, true);
+  TimeSave(0, &sequence, false);
+  sequence.notes[5] = sequence.notes[5] < 0x80 ? sequence.notes[5] ^ 1 : 60;
+  ok = PrintTiming("16 steps, one note edited (Tick())",
+                   TimeSave(0, &sequence, false), false) && ok;
+  return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: sequence_bank_sim [--check]\n");
+    return 1;
+  }
+  bool ok = TestRoundTrips();
+  ok = TestPlayback() && ok;
+  ok = TestTiming() && ok;
+  return check && !ok ? 1 : 0;
+}
@@ -0,0 +1,383 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host simulation of the timing of the edges on the Gate input, from the edge
+// to the DAC state samples it affects.
+//
+// Gate edges arrive at random times. The TIMER0 ISR (4.9kHz) reads the DAC
+// state sample on every other call, then detects the edge. The TIMER2 ISR
+// (39kHz, 16 ticks per DAC state sample) counts the ticks which stamp the
+// edges. The main loop runs at random times: each iteration fills the DAC
+// state buffer of the real Voice, then stays busy (drum rendering, MIDI, UI)
+// for a random time, up to a maximum set by the load. SampleTime(),
+// TriggerDelay() and ProcessInputEvents() are copies of the ones in
+// anu/anu.cc, which holds the ISRs and main() and cannot be linked. Three
+// ways of applying the edge are compared:
+//
+//   next      the former code: the edge is applied to the next DAC state
+//             sample written.
+//   constant  the code before the edges were stamped: the edge is applied to
+//             the sample sent 3 DAC periods after it was seen.
+//   phase     the current code: the edge is applied to the next sample
+//             written, and the envelopes are rendered ahead by the time
+//             elapsed since the edge.
+//
+// Reported:
+//   - the latency, from the edge to the TIMER0 call which sends the sample
+//     written right after the edge was applied;
+//   - the phase error: how far the envelopes are behind the edge when this
+//     sample is sent. A segment triggered at the edge would have been
+//     rendered for the latency, the envelopes were rendered for one sample,
+//     plus the delay they were rendered ahead by.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile trig_latency_sim
+//   build/tools/trig_latency_sim            prints the table
+//   build/tools/trig_latency_sim --check    exits with an error if, with a
+//                                           main loop which keeps up, the
+//                                           phase error exceeds half a poll
+//                                           period, or if the mean latency
+//                                           is not below the one of the
+//                                           constant latency
+
+#include "avrlib/ring_buffer.h"
+
+#include "anu/drum_synth.h"
+#include "anu/system_settings.h"
+#include "anu/voice_controller.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace anu;
+using namespace avrlib;
+
+namespace {
+
+const uint32_t kTickCycles = 510;  // TIMER2, 39kHz
+const uint32_t kPollCycles = 4080;  // TIMER0, 4.9kHz
+const double kCyclesPerMs = 20000.0;
+const double kDuration = 100.0;  // s
+const uint32_t kMinEdgeInterval = 5 * 20000;  // 5ms
+const uint32_t kMaxEdgeInterval = 15 * 20000;
+
+// As in anu/anu.cc.
+
+uint8_t clock_ticks;
+uint8_t dac_read_tick;
+
+enum InputEvent {
+  INPUT_EVENT_TRIG = 0x1000,
+  INPUT_EVENT_GATE_ON = 0x2000,
+  INPUT_EVENT_GATE_OFF = 0x3000
+};
+
+struct InputEventBufferSpecs {
+  enum {
+    buffer_size = 16,
+    data_size = 16,
+  };
+  typedef avrlib::DataTypeForSize<data_size>::Type Value;
+};
+
+RingBuffer<InputEventBufferSpecs> input_events;
+
+const uint8_t kPollTicks = 8;
+const uint8_t kMaxTriggerDelay = 128;
+
+uint16_t SampleTime() {
+  uint8_t read_count = voice_controller.voice().dac_read_count();
+  uint8_t age = clock_ticks - dac_read_tick;
+  return ((static_cast<uint16_t>(read_count) << 4) + age) & 0xfff;
+}
+
+uint8_t TriggerDelay(uint16_t event_time) {
+  uint8_t sample = voice_controller.voice().dac_write_count() + 1;
+  uint16_t sample_time = static_cast<uint16_t>(sample) << 4;
+  int16_t delay = static_cast<int16_t>((sample_time - event_time) & 0xfff) - 16;
+  if (delay < 0) {
+    delay = 0;
+  } else if (delay > kMaxTriggerDelay) {
+    delay = kMaxTriggerDelay;
+  }
+  return delay;
+}
+
+// Delay given to the last edge applied, for the measurement.
+uint8_t applied_delay;
+
+void ProcessInputEvents() {
+  Voice* voice = voice_controller.mutable_voice();
+  while (input_events.readable()) {
+    uint16_t event = input_events.ImmediateRead();
+    applied_delay = TriggerDelay(event & 0xfff);
+    voice->set_trigger_delay(applied_delay);
+    switch (event & 0xf000) {
+      case INPUT_EVENT_GATE_ON:
+        voice_controller.GateOn();
+        break;
+      case INPUT_EVENT_GATE_OFF:
+        voice_controller.GateOff();
+        break;
+    }
+  }
+  voice->set_trigger_delay(0);
+}
+
+// As in anu/anu.cc before the edges were stamped: the LSB of the event is the
+// DAC state sample at which it must be applied.
+
+const uint8_t kInputEventLatency = kDACStateBufferSize - 1;
+
+// A ring buffer is identified by its specs: the due events need their own.
+struct DueEventBufferSpecs {
+  enum {
+    buffer_size = 16,
+    data_size = 16,
+  };
+  typedef avrlib::DataTypeForSize<data_size>::Type Value;
+};
+
+RingBuffer<DueEventBufferSpecs> due_events;
+uint16_t pending_event;
+
+void ProcessDueEvents() {
+  uint8_t now = voice_controller.voice().dac_write_count();
+  while (pending_event || due_events.readable()) {
+    if (!pending_event) {
+      pending_event = due_events.ImmediateRead();
+    }
+    if (static_cast<int8_t>((pending_event & 0xff) - now) > 0) {
+      break;
+    }
+    switch (pending_event & 0xff00) {
+      case 0x200:
+        voice_controller.GateOn();
+        break;
+      case 0x300:
+        voice_controller.GateOff();
+        break;
+    }
+    pending_event = 0;
+  }
+}
+
+// Simulation.
+
+enum Mode {
+  MODE_NEXT,
+  MODE_CONSTANT,
+  MODE_PHASE,
+  MODE_LAST
+};
+
+const char* const kModeNames[] = { "next", "constant", "phase" };
+
+struct Load {
+  const char* name;
+  double max_busy;  // In poll periods.
+};
+
+const Load kLoads[] = {
+  { "idle", 0.25 },
+  { "busy", 3.0 },
+  { "heavy", 5.0 },
+};
+
+struct Statistics {
+  double min;  // ms
+  double max;
+  double sum;
+  double sum_squares;
+
+  void Add(double x) {
+    min = x < min ? x : min;
+    max = x > max ? x : max;
+    sum += x;
+    sum_squares += x * x;
+  }
+  double mean(uint32_t n) const { return sum / n; }
+  double std(uint32_t n) const {
+    return sqrt(sum_squares / n - mean(n) * mean(n));
+  }
+};
+
+struct Result {
+  Statistics latency;
+  Statistics error;
+  uint32_t num_edges;
+  uint32_t num_underruns;
+};
+
+uint32_t RandomInterval(uint32_t min, uint32_t max) {
+  return min + static_cast<uint32_t>(
+      (max - min) * (rand() / (RAND_MAX + 1.0)));
+}
+
+Result Simulate(Mode mode, const Load& load) {
+  srand(1);
+  input_events.Flush();
+  due_events.Flush();
+  pending_event = 0;
+  voice_controller.Init();
+  Voice* voice = voice_controller.mutable_voice();
+  while (voice->writable()) {
+    voice->WriteDACStateSample();
+  }
+
+  uint32_t end = static_cast<uint32_t>(kDuration * 1000.0 * kCyclesPerMs);
+  uint32_t next_poll = kPollCycles;
+  uint32_t next_main_loop = 0;
+  uint32_t next_edge = RandomInterval(kMinEdgeInterval, kMaxEdgeInterval);
+  uint8_t cycle = 0;
+  bool gate = false;
+  bool previous_gate = false;
+  uint8_t counted_edges = 0;  // Former code.
+
+  // Edge in flight.
+  uint32_t edge_time = 0;
+  bool edge_pending = false;
+  bool edge_applied = false;
+  uint8_t edge_sample = 0;
+  uint8_t edge_delay = 0;
+
+  Result result;
+  memset(&result, 0, sizeof(result));
+  result.latency.min = result.error.min = 1e9;
+  result.latency.max = result.error.max = -1e9;
+
+  while (next_poll < end) {
+    if (next_edge <= next_poll && next_edge <= next_main_loop) {
+      gate = !gate;
+      edge_time = next_edge;
+      edge_pending = true;
+      edge_applied = false;
+      next_edge += RandomInterval(kMinEdgeInterval, kMaxEdgeInterval);
+    } else if (next_main_loop < next_poll) {
+      while (voice->writable()) {
+        applied_delay = 0;
+        if (mode == MODE_PHASE) {
+          ProcessInputEvents();
+        } else if (mode == MODE_CONSTANT) {
+          ProcessDueEvents();
+        } else {
+          while (counted_edges) {
+            if (gate) {
+              voice_controller.GateOn();
+            } else {
+              voice_controller.GateOff();
+            }
+            --counted_edges;
+          }
+        }
+        bool applied = voice_controller.voice().gate() == gate;
+        voice->WriteDACStateSample();
+        if (edge_pending && !edge_applied && applied) {
+          edge_applied = true;
+          edge_sample = voice->dac_write_count();
+          edge_delay = applied_delay;
+        }
+      }
+      next_main_loop += RandomInterval(
+          0, static_cast<uint32_t>(load.max_busy * kPollCycles));
+      if (next_main_loop < next_poll) {
+        next_main_loop = next_poll;
+      }
+    } else {
+      uint32_t now = next_poll;
+      clock_ticks = now / kTickCycles;
+      if (cycle & 1) {
+        if (!voice->readable()) {
+          ++result.num_underruns;
+        }
+        voice->ReadDACStateSample();
+        dac_read_tick = clock_ticks;
+        if (edge_pending && edge_applied &&
+            voice->dac_read_count() == edge_sample) {
+          double latency = (now - edge_time) / kCyclesPerMs;
+          double rendered = (16 + edge_delay) * kTickCycles / kCyclesPerMs;
+          result.latency.Add(latency);
+          result.error.Add(latency - rendered);
+          ++result.num_edges;
+          edge_pending = false;
+        }
+      }
+      if (gate != previous_gate) {
+        uint16_t time = (SampleTime() - kPollTicks / 2) & 0xfff;
+        input_events.NonBlockingWrite(
+            (gate ? INPUT_EVENT_GATE_ON : INPUT_EVENT_GATE_OFF) | time);
+        uint16_t due = static_cast<uint8_t>(
+            voice->dac_read_count() + kInputEventLatency);
+        due_events.NonBlockingWrite((gate ? 0x200 : 0x300) | due);
+        ++counted_edges;
+      }
+      previous_gate = gate;
+      ++cycle;
+      next_poll += kPollCycles;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: trig_latency_sim [--check]\n");
+    return 1;
+  }
+
+  // As Init() in anu/anu.cc.
+  system_settings.Init();
+  drum_synth.Init();
+  voice_controller.Init();
+
+  const double kMaxError = kPollCycles / 2 / kCyclesPerMs;
+  int failures = 0;
+  printf("%-6s %-9s %6s  %-26s %-26s %9s\n", "load", "edges", "count",
+         "latency min/max/mean", "phase error min/max/std", "underruns");
+  for (uint8_t i = 0; i < sizeof(kLoads) / sizeof(kLoads[0]); ++i) {
+    double constant_latency = 0.0;
+    for (uint8_t mode = 0; mode < MODE_LAST; ++mode) {
+      Result r = Simulate(static_cast<Mode>(mode), kLoads[i]);
+      uint32_t n = r.num_edges;
+      printf("%-6s %-9s %6u  %6.2f %6.2f %6.2f       %6.2f %6.2f %6.3f %9u\n",
+             kLoads[i].name, kModeNames[mode], n, r.latency.min,
+             r.latency.max, r.latency.mean(n), r.error.min, r.error.max,
+             r.error.std(n), r.num_underruns);
+      if (mode == MODE_CONSTANT) {
+        constant_latency = r.latency.mean(n);
+      } else if (mode == MODE_PHASE) {
+        if (!r.num_underruns && (r.error.min < -kMaxError - 1e-6 ||
+                                 r.error.max > kMaxError + 1e-6)) {
+          ++failures;
+        }
+        if (r.latency.mean(n) >= constant_latency) {
+          ++failures;
+        }
+      }
+    }
+  }
+  printf("in ms. latency: from the edge to the DAC update. phase error: how "
+         "far the envelopes are behind the edge at this update.\n");
+  return check && failures ? 1 : 0;
+}
@@ -0,0 +1,198 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Behavioural model of the analog voice.
+
+#include "tools/voice_render/analog_voice.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace anu {
+
+namespace {
+
+// SSM2164 gain at room temperature (see hardware_design/simulations).
+const double kBoltzmann = 8.6173324e-5;
+const double kRoomTemperature = 273.13 + 25.0;
+
+double Ssm2164Gain(double cv) {
+  return exp(-cv / 10.4 / (kRoomTemperature * kBoltzmann));
+}
+
+// VCF exponential converter (see hardware_design/simulations/vcf.py).
+const double kVcfDacResistor = 49900.0;
+const double kVcfPotResistor = 200000.0;
+const double kVcfReferenceResistor = 62000.0;
+const double kVcfFeedbackResistor = 37300.0;
+const double kVcfMaxCutoff = 1.0 / (2.0 * M_PI * 33000.0 * 220.0e-12);
+
+inline float PolyBlep(float t, float dt) {
+  if (t < dt) {
+    float x = t / dt;
+    return x + x - x * x - 1.0f;
+  } else if (t > 1.0f - dt) {
+    float x = (t - 1.0f) / dt;
+    return x * x + x + x + 1.0f;
+  } else {
+    return 0.0f;
+  }
+}
+
+// Rational approximation of tanh, good to 2% and saturating at +/-3.
+inline float SoftClip(float x) {
+  if (x > 3.0f) {
+    return 1.0f;
+  } else if (x < -3.0f) {
+    return -1.0f;
+  } else {
+    float x2 = x * x;
+    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+  }
+}
+
+}  // namespace
+
+void AnalogVoice::Init(double sample_rate) {
+  sample_rate_ = sample_rate;
+  samples_per_dac_sample_ = sample_rate / kDACRefreshRate;
+  fractional_samples_ = 0.0;
+  // Same as init_settings in anu/system_settings.cc.
+  calibration_.offset = 60 * 128;
+  calibration_.scale_low = 64000 / 3;
+  calibration_.scale_high = 64000 / 3;
+  resonance_ = 0.3f;
+  cutoff_pot_ = 0.0f;
+  started_ = false;
+  memset(&previous_, 0, sizeof(previous_));
+  phase_ = 0.0;
+  memset(state_, 0, sizeof(state_));
+}
+
+double AnalogVoice::VcoFrequency(uint16_t vco_cv) const {
+  // Inverse of the conversion done by Voice::WriteDACStateSample(): the
+  // scale changes at the code of the middle C. The firmware truncates, the
+  // code stands for the middle of its interval.
+  double x = static_cast<double>(vco_cv) - 2048.0 + 0.5;
+  double breakpoint = (60.0 * 128.0 - calibration_.offset) * \
+      calibration_.scale_low / 65536.0;
+  uint16_t scale = x < breakpoint ?
+      calibration_.scale_low : calibration_.scale_high;
+  double pitch = calibration_.offset + x * 65536.0 / scale;
+  return 440.0 * pow(2.0, (pitch / 128.0 - 69.0) / 12.0);
+}
+
+double AnalogVoice::VcfCutoff(uint16_t vcf_cv) const {
+  // The DAC full scale is 4.096V.
+  double current = vcf_cv / 1000.0 / kVcfDacResistor + \
+      cutoff_pot_ / kVcfPotResistor - 4.096 / kVcfReferenceResistor;
+  return kVcfMaxCutoff * Ssm2164Gain(-current * kVcfFeedbackResistor);
+}
+
+inline float AnalogVoice::Ladder(float in, float g, float feedback) {
+  float x = SoftClip(in - feedback * state_[3]);
+  state_[0] += g * (x - state_[0]);
+  state_[1] += g * (state_[0] - state_[1]);
+  state_[2] += g * (state_[1] - state_[2]);
+  state_[3] += g * (state_[2] - state_[3]);
+  return state_[3];
+}
+
+size_t AnalogVoice::Render(
+    const DACState& state,
+    float* out,
+    size_t max_size) {
+  if (!started_) {
+    previous_ = state;
+    started_ = true;
+  }
+  fractional_samples_ += samples_per_dac_sample_;
+  size_t size = static_cast<size_t>(fractional_samples_);
+  fractional_samples_ -= size;
+  if (size > max_size) {
+    size = max_size;
+  }
+
+  // Values at both ends of the DAC sample period, the expensive conversions
+  // are not done for every sample.
+  double f_start = VcoFrequency(previous_.vco_cv) / sample_rate_;
+  double f_end = VcoFrequency(state.vco_cv) / sample_rate_;
+  float duty_start = 0.5f - 0.45f * previous_.pw_cv / 4096.0f;
+  float duty_end = 0.5f - 0.45f * state.pw_cv / 4096.0f;
+  float gain_start = previous_.vca_cv / 4095.0f;
+  float gain_end = state.vca_cv / 4095.0f;
+
+  // The ladder runs at twice the sample rate when the cutoff is high.
+  double cutoff = VcfCutoff(state.vcf_cv);
+  bool oversampled = cutoff > sample_rate_ / 4.0;
+  double filter_rate = oversampled ? 2.0 * sample_rate_ : sample_rate_;
+  if (cutoff > 0.45 * filter_rate) {
+    cutoff = 0.45 * filter_rate;
+  }
+  float g_end = 1.0f - exp(-2.0 * M_PI * cutoff / filter_rate);
+  float g_start = g_end;
+  if (previous_.vcf_cv != state.vcf_cv) {
+    double previous_cutoff = VcfCutoff(previous_.vcf_cv);
+    if (previous_cutoff > 0.45 * filter_rate) {
+      previous_cutoff = 0.45 * filter_rate;
+    }
+    g_start = 1.0f - exp(-2.0 * M_PI * previous_cutoff / filter_rate);
+  }
+  float feedback = 4.0f * resonance_;
+
+  float step = size ? 1.0f / size : 0.0f;
+  for (size_t i = 0; i < size; ++i) {
+    float t = (i + 1) * step;
+    float dt = f_start + (f_end - f_start) * t;
+    if (dt > 0.5f) {
+      dt = 0.5f;
+    }
+    float duty = duty_start + (duty_end - duty_start) * t;
+    float g = g_start + (g_end - g_start) * t;
+    float gain = gain_start + (gain_end - gain_start) * t;
+
+    // VCO.
+    phase_ += dt;
+    if (phase_ >= 1.0) {
+      phase_ -= 1.0;
+    }
+    float phase = phase_;
+    float saw = 2.0f * phase - 1.0f - PolyBlep(phase, dt);
+    float shifted_phase = phase + duty;
+    if (shifted_phase >= 1.0f) {
+      shifted_phase -= 1.0f;
+    }
+    float shifted_saw = 2.0f * shifted_phase - 1.0f - \
+        PolyBlep(shifted_phase, dt);
+    float vco = 0.5f * saw + 0.25f * (saw - shifted_saw);
+
+    // VCF.
+    float vcf;
+    if (oversampled) {
+      vcf = 0.5f * (Ladder(vco, g, feedback) + Ladder(vco, g, feedback));
+    } else {
+      vcf = Ladder(vco, g, feedback);
+    }
+
+    // VCA.
+    out[i] = vcf * gain;
+  }
+  previous_ = state;
+  return size;
+}
+
+}  // namespace anu
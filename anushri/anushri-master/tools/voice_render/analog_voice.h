@@ -0,0 +1,97 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Behavioural model of the analog voice, driven by the DACState samples
+// computed by Voice::WriteDACStateSample() at the DAC refresh rate.
+//
+// - VCO: the exponential converter is described by the VCO calibration of
+//   SystemSettingsData, as measured by the voice tuner. With the same values
+//   as the firmware, the VCO is in tune; other values model a unit whose
+//   calibration is off. The saw and pulse waveforms are band-limited
+//   (PolyBLEP).
+// - VCF: the exponential converter follows the component values of
+//   hardware_design/simulations/vcf.py, with the cutoff pot. 4-pole ladder
+//   with a saturating input stage, run at twice the sample rate only when the
+//   cutoff is above a quarter of the sample rate.
+// - PW and VCA: linear responses.
+//
+// The control voltages are linearly interpolated between DAC samples.
+
+#ifndef TOOLS_VOICE_RENDER_ANALOG_VOICE_H_
+#define TOOLS_VOICE_RENDER_ANALOG_VOICE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "anu/voice.h"
+
+namespace anu {
+
+// 20MHz / 510 / 8 / 2.
+const double kDACRefreshRate = 2450.980392;
+
+struct VcoCalibration {
+  int16_t offset;
+  uint16_t scale_low;
+  uint16_t scale_high;
+};
+
+class AnalogVoice {
+ public:
+  AnalogVoice() { }
+  ~AnalogVoice() { }
+
+  void Init(double sample_rate);
+
+  // Renders the output for one DAC sample: the number of samples written,
+  // at most max_size, is returned.
+  size_t Render(const DACState& state, float* out, size_t max_size);
+
+  void set_calibration(const VcoCalibration& calibration) {
+    calibration_ = calibration;
+  }
+  // 0.0 to 1.0, self-oscillation at 1.0.
+  void set_resonance(float resonance) { resonance_ = resonance; }
+  // -5V to 5V.
+  void set_cutoff_pot(float cutoff_pot) { cutoff_pot_ = cutoff_pot; }
+
+  // Frequency of the VCO and cutoff of the VCF for a given DAC code.
+  double VcoFrequency(uint16_t vco_cv) const;
+  double VcfCutoff(uint16_t vcf_cv) const;
+
+ private:
+  float Ladder(float in, float g, float feedback);
+
+  double sample_rate_;
+  double samples_per_dac_sample_;
+  double fractional_samples_;
+
+  VcoCalibration calibration_;
+  float resonance_;
+  float cutoff_pot_;
+
+  bool started_;
+  DACState previous_;
+  double phase_;
+  float state_[4];
+
+  DISALLOW_COPY_AND_ASSIGN(AnalogVoice);
+};
+
+}  // namespace anu
+
+#endif  // TOOLS_VOICE_RENDER_ANALOG_VOICE_H_
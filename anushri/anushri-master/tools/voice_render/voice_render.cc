@@ -0,0 +1,399 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Patch to WAV renderer: the firmware voice (anu::VoiceController) plays a
+// test sequence, and the DACState samples it computes are rendered by the
+// behavioural model of the analog voice (analog_voice.h).
+//
+// Usage, from the source root:
+//   make -f tools/makefile voice_render
+//   build/tools/voice_render [options] out.wav
+// Options:
+//   --cc n=v             sends a control change to the voice controller
+//                        before playing (patch parameters, see the CC map in
+//                        anu/parameter.cc), can be repeated
+//   --resonance r        resonance pot, 0.0 to 1.0
+//   --cutoff-pot v       cutoff pot, -5.0 to 5.0V
+//   --calibration o,l,h  VCO calibration (offset, low and high scales) of
+//                        both the firmware and the modelled VCO
+//   --vco o,l,h          VCO calibration of the modelled VCO only, to hear a
+//                        unit whose calibration is off
+//   --dac-in file        renders DACState samples read from a file (4
+//                        little-endian 16-bit words per sample) instead of
+//                        running the firmware
+//   --dac-out file       writes the DACState samples to a file
+//   build/tools/voice_render --check
+//     checks that the VCO plays in tune with the default and a non-default
+//     calibration, and that the rendering is at least 10 times faster than
+//     real time.
+
+#include "anu/drum_synth.h"
+#include "anu/system_settings.h"
+#include "anu/voice_controller.h"
+
+#include <avr/eeprom.h>
+
+#include "tools/voice_render/analog_voice.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+using namespace anu;
+
+namespace {
+
+const uint32_t kSampleRate = 48000;
+// Longest block rendered for a DAC sample.
+const size_t kMaxBlockSize = 64;
+// Longest rendering: 60s.
+const uint32_t kMaxSamples = kSampleRate * 60;
+
+float samples[kMaxSamples];
+uint32_t num_samples;
+
+struct Options {
+  float resonance;
+  float cutoff_pot;
+  bool has_calibration;
+  VcoCalibration calibration;
+  bool has_vco_calibration;
+  VcoCalibration vco_calibration;
+  const char* dac_in;
+  const char* dac_out;
+  uint8_t num_ccs;
+  uint8_t ccs[32][2];
+};
+
+void InitFirmware(const Options& options) {
+  // A new unit: the calibration saved by a previous run is erased, then as
+  // Init() in anu/anu.cc.
+  memset(host_eeprom, 0xff, sizeof(host_eeprom));
+  system_settings.Init();
+  if (options.has_calibration) {
+    system_settings.set_calibration_data(
+        options.calibration.offset,
+        options.calibration.scale_low,
+        options.calibration.scale_high);
+  }
+  drum_synth.Init();
+  voice_controller.Init();
+  for (uint8_t i = 0; i < options.num_ccs; ++i) {
+    voice_controller.ControlChange(options.ccs[i][0], options.ccs[i][1]);
+  }
+}
+
+void InitModel(const Options& options, AnalogVoice* model) {
+  model->Init(kSampleRate);
+  model->set_resonance(options.resonance);
+  model->set_cutoff_pot(options.cutoff_pot);
+  if (options.has_vco_calibration) {
+    model->set_calibration(options.vco_calibration);
+  } else {
+    VcoCalibration calibration;
+    calibration.offset = system_settings.vco_cv_offset();
+    calibration.scale_low = system_settings.vco_cv_scale_low();
+    calibration.scale_high = system_settings.vco_cv_scale_high();
+    model->set_calibration(calibration);
+  }
+}
+
+// Computes the next DAC sample, as the main loop and Timer0 do.
+const DACState& NextDACState() {
+  Voice* voice = voice_controller.mutable_voice();
+  voice->WriteDACStateSample();
+  voice->ReadDACStateSample();
+  return voice->dac_state();
+}
+
+void RenderDACState(AnalogVoice* model, const DACState& state, FILE* dac_out) {
+  if (dac_out) {
+    uint8_t bytes[8];
+    const uint16_t words[] = {
+      state.vco_cv, state.pw_cv, state.vcf_cv, state.vca_cv
+    };
+    for (uint8_t i = 0; i < 4; ++i) {
+      bytes[2 * i] = words[i] & 0xff;
+      bytes[2 * i + 1] = words[i] >> 8;
+    }
+    fwrite(bytes, 1, sizeof(bytes), dac_out);
+  }
+  float block[kMaxBlockSize];
+  size_t size = model->Render(state, block, kMaxBlockSize);
+  for (size_t i = 0; i < size && num_samples < kMaxSamples; ++i) {
+    samples[num_samples++] = block[i];
+  }
+}
+
+// Quarter notes at 120 BPM, half a beat long, then a second of release.
+const uint8_t kTestSequence[] = { 36, 48, 43, 55, 36, 60, 46, 41 };
+
+void RenderTestSequence(AnalogVoice* model, FILE* dac_out) {
+  uint32_t step_duration = static_cast<uint32_t>(kDACRefreshRate * 0.5);
+  for (uint8_t i = 0; i < sizeof(kTestSequence); ++i) {
+    voice_controller.NoteOn(kTestSequence[i], 100);
+    for (uint32_t j = 0; j < step_duration; ++j) {
+      if (j == step_duration / 2) {
+        voice_controller.NoteOff(kTestSequence[i]);
+      }
+      RenderDACState(model, NextDACState(), dac_out);
+    }
+  }
+  for (uint32_t j = 0; j < step_duration * 2; ++j) {
+    RenderDACState(model, NextDACState(), dac_out);
+  }
+}
+
+bool RenderDACFile(AnalogVoice* model, const char* file_name) {
+  FILE* fp = fopen(file_name, "rb");
+  if (!fp) {
+    fprintf(stderr, "Cannot open %s\n", file_name);
+    return false;
+  }
+  uint8_t bytes[8];
+  while (fread(bytes, 1, sizeof(bytes), fp) == sizeof(bytes)) {
+    uint16_t words[4];
+    for (uint8_t i = 0; i < 4; ++i) {
+      words[i] = bytes[2 * i] | (bytes[2 * i + 1] << 8);
+    }
+    DACState state;
+    state.vco_cv = words[0];
+    state.pw_cv = words[1];
+    state.vcf_cv = words[2];
+    state.vca_cv = words[3];
+    RenderDACState(model, state, NULL);
+  }
+  fclose(fp);
+  return true;
+}
+
+void WriteLittleEndian(FILE* fp, uint32_t value, uint8_t size) {
+  for (uint8_t i = 0; i < size; ++i) {
+    fputc((value >> (8 * i)) & 0xff, fp);
+  }
+}
+
+bool WriteWav(const char* file_name) {
+  FILE* fp = fopen(file_name, "wb");
+  if (!fp) {
+    fprintf(stderr, "Cannot open %s\n", file_name);
+    return false;
+  }
+  float peak = 1e-6f;
+  for (uint32_t i = 0; i < num_samples; ++i) {
+    if (fabs(samples[i]) > peak) {
+      peak = fabs(samples[i]);
+    }
+  }
+  float scale = 0.9f * 32767.0f / peak;
+  fwrite("RIFF", 1, 4, fp);
+  WriteLittleEndian(fp, 36 + num_samples * 2, 4);
+  fwrite("WAVEfmt ", 1, 8, fp);
+  WriteLittleEndian(fp, 16, 4);
+  WriteLittleEndian(fp, 1, 2);  // PCM.
+  WriteLittleEndian(fp, 1, 2);  // Mono.
+  WriteLittleEndian(fp, kSampleRate, 4);
+  WriteLittleEndian(fp, kSampleRate * 2, 4);
+  WriteLittleEndian(fp, 2, 2);
+  WriteLittleEndian(fp, 16, 2);
+  fwrite("data", 1, 4, fp);
+  WriteLittleEndian(fp, num_samples * 2, 4);
+  for (uint32_t i = 0; i < num_samples; ++i) {
+    int32_t value = static_cast<int32_t>(floor(samples[i] * scale + 0.5f));
+    WriteLittleEndian(fp, static_cast<uint16_t>(value), 2);
+  }
+  fclose(fp);
+  return true;
+}
+
+// Largest error, in cents, of the VCO frequency over the keyboard.
+double MaxPitchError(const Options& options) {
+  InitFirmware(options);
+  AnalogVoice model;
+  InitModel(options, &model);
+  double max_error = 0.0;
+  for (uint8_t note = 24; note <= 96; ++note) {
+    voice_controller.NoteOn(note, 100);
+    const DACState* state = NULL;
+    for (uint8_t i = 0; i < 16; ++i) {
+      state = &NextDACState();
+    }
+    voice_controller.NoteOff(note);
+    double expected = 440.0 * pow(2.0, (note - 69.0) / 12.0);
+    double error = fabs(1200.0 * log(
+        model.VcoFrequency(state->vco_cv) / expected) / log(2.0));
+    if (error > max_error) {
+      max_error = error;
+    }
+  }
+  return max_error;
+}
+
+int Check() {
+  int errors = 0;
+
+  // One DAC code is 2.4 cents with the default calibration.
+  Options options;
+  memset(&options, 0, sizeof(options));
+  options.resonance = 0.3f;
+  double error = MaxPitchError(options);
+  printf("default calibration: %.2f cents\n", error);
+  if (error > 3.0) {
+    ++errors;
+  }
+
+  options.has_calibration = true;
+  options.calibration.offset = 7600;
+  options.calibration.scale_low = 20800;
+  options.calibration.scale_high = 21600;
+  error = MaxPitchError(options);
+  printf("calibration 7600, 20800, 21600: %.2f cents\n", error);
+  if (error > 3.0) {
+    ++errors;
+  }
+
+  // The firmware is not calibrated for this VCO.
+  options.has_calibration = false;
+  options.has_vco_calibration = true;
+  options.vco_calibration = options.calibration;
+  error = MaxPitchError(options);
+  printf("uncalibrated: %.2f cents\n", error);
+  if (error < 50.0) {
+    ++errors;
+  }
+
+  // Speed.
+  options.has_vco_calibration = false;
+  InitFirmware(options);
+  AnalogVoice model;
+  InitModel(options, &model);
+  clock_t start = ::clock();
+  num_samples = 0;
+  RenderTestSequence(&model, NULL);
+  double seconds = double(::clock() - start) / CLOCKS_PER_SEC;
+  double speed = num_samples / double(kSampleRate) / seconds;
+  printf("rendering: %.0f times faster than real time\n", speed);
+  if (speed < 10.0) {
+    ++errors;
+  }
+  for (uint32_t i = 0; i < num_samples; ++i) {
+    if (!(fabs(samples[i]) < 10.0f)) {
+      printf("invalid sample %d: %f\n", i, samples[i]);
+      ++errors;
+      break;
+    }
+  }
+  return errors ? 1 : 0;
+}
+
+bool ParseCalibration(const char* text, VcoCalibration* calibration) {
+  int offset, low, high;
+  if (sscanf(text, "%d,%d,%d", &offset, &low, &high) != 3) {
+    return false;
+  }
+  calibration->offset = offset;
+  calibration->scale_low = low;
+  calibration->scale_high = high;
+  return true;
+}
+
+void Usage() {
+  fprintf(stderr, "Usage: voice_render [--cc n=v] [--resonance r] "
+          "[--cutoff-pot v] [--calibration o,l,h] [--vco o,l,h] "
+          "[--dac-in file] [--dac-out file] out.wav\n"
+          "       voice_render --check\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  memset(&options, 0, sizeof(options));
+  options.resonance = 0.3f;
+  const char* output = NULL;
+  for (int i = 1; i < argc; ++i) {
+    bool has_value = i + 1 < argc;
+    if (!strcmp(argv[i], "--check")) {
+      return Check();
+    } else if (!strcmp(argv[i], "--cc") && has_value &&
+               options.num_ccs < 32) {
+      int cc, value;
+      if (sscanf(argv[++i], "%d=%d", &cc, &value) != 2) {
+        Usage();
+        return 1;
+      }
+      options.ccs[options.num_ccs][0] = cc;
+      options.ccs[options.num_ccs][1] = value;
+      ++options.num_ccs;
+    } else if (!strcmp(argv[i], "--resonance") && has_value) {
+      options.resonance = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--cutoff-pot") && has_value) {
+      options.cutoff_pot = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--calibration") && has_value) {
+      options.has_calibration = true;
+      if (!ParseCalibration(argv[++i], &options.calibration)) {
+        Usage();
+        return 1;
+      }
+    } else if (!strcmp(argv[i], "--vco") && has_value) {
+      options.has_vco_calibration = true;
+      if (!ParseCalibration(argv[++i], &options.vco_calibration)) {
+        Usage();
+        return 1;
+      }
+    } else if (!strcmp(argv[i], "--dac-in") && has_value) {
+      options.dac_in = argv[++i];
+    } else if (!strcmp(argv[i], "--dac-out") && has_value) {
+      options.dac_out = argv[++i];
+    } else if (argv[i][0] != '-' && !output) {
+      output = argv[i];
+    } else {
+      Usage();
+      return 1;
+    }
+  }
+  if (!output) {
+    Usage();
+    return 1;
+  }
+
+  InitFirmware(options);
+  AnalogVoice model;
+  InitModel(options, &model);
+  num_samples = 0;
+  if (options.dac_in) {
+    if (!RenderDACFile(&model, options.dac_in)) {
+      return 1;
+    }
+  } else {
+    FILE* dac_out = NULL;
+    if (options.dac_out) {
+      dac_out = fopen(options.dac_out, "wb");
+      if (!dac_out) {
+        fprintf(stderr, "Cannot open %s\n", options.dac_out);
+        return 1;
+      }
+    }
+    RenderTestSequence(&model, dac_out);
+    if (dac_out) {
+      fclose(dac_out);
+    }
+  }
+  return WriteWav(output) ? 0 : 1;
+}
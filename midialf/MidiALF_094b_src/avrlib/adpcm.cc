@@ -0,0 +1,70 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// IMA ADPCM decoder.
+
+#include "avrlib/adpcm.h"
+
+namespace avrlib {
+
+static const uint8_t kNumAdpcmSteps = 89;
+
+// Must match ADPCM_STEPS in resources_compiler.py.
+static const prog_uint16_t adpcm_steps[kNumAdpcmSteps] PROGMEM = {
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41,
+  45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209,
+  230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876,
+  963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749,
+  3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+  9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385,
+  24623, 27086, 29794, 32767
+};
+
+void AdpcmDecoder::Start(uint16_t block) {
+  const prog_uint8_t* p = data_ + block * kAdpcmBlockBytes;
+  position_ = block * kAdpcmBlockSize;
+  predictor_ = static_cast<int16_t>(static_cast<int8_t>(pgm_read_byte(p))) << 8;
+  step_index_ = pgm_read_byte(p + 1);
+  codes_ = p + 2;
+}
+
+void AdpcmDecoder::Step() {
+  uint8_t n = position_ & (kAdpcmBlockSize - 1);
+  uint8_t code = pgm_read_byte(codes_ + (n >> 1));
+  code = n & 1 ? code & 0xf : code >> 4;
+  ++position_;
+
+  uint16_t step = pgm_read_word(adpcm_steps + step_index_);
+  uint16_t delta = step >> 3;
+  if (code & 4) delta += step;
+  if (code & 2) delta += step >> 1;
+  if (code & 1) delta += step >> 2;
+  int32_t predictor = predictor_;
+  predictor += code & 8 ? -static_cast<int32_t>(delta) : delta;
+  if (predictor > 32767) predictor = 32767;
+  if (predictor < -32768) predictor = -32768;
+  predictor_ = predictor;
+
+  if (code & 4) {
+    step_index_ += ((code & 3) + 1) << 1;
+    if (step_index_ >= kNumAdpcmSteps) step_index_ = kNumAdpcmSteps - 1;
+  } else if (step_index_) {
+    --step_index_;
+  }
+}
+
+}  // namespace avrlib
@@ -0,0 +1,74 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// IMA ADPCM decoder for the 8-bit samples compiled with the 'adpcm' codec of
+// resources_compiler.py. Samples are stored in blocks of 32: the first sample,
+// the initial step index, then a 4-bit code for each other sample, high
+// nibble first. The predictor is on 16 bits, its high byte is the sample.
+
+#ifndef AVRLIB_ADPCM_H_
+#define AVRLIB_ADPCM_H_
+
+#include "avrlib/base.h"
+
+#include <avr/pgmspace.h>
+
+namespace avrlib {
+
+static const uint8_t kAdpcmBlockSize = 32;
+static const uint8_t kAdpcmBlockBytes = 2 + (kAdpcmBlockSize / 2);
+
+class AdpcmDecoder {
+ public:
+  AdpcmDecoder() { }
+
+  void Init(const prog_uint8_t* data) {
+    data_ = data;
+    Start(0);
+  }
+
+  // Returns sample i. Decoding goes on from the current sample when sample i
+  // follows it in the same block, otherwise it starts over from the beginning
+  // of the block of sample i. Each decoded sample costs one step.
+  inline int8_t Read(uint16_t i) {
+    if (i < position_ || (i ^ position_) >= kAdpcmBlockSize) {
+      Start(i / kAdpcmBlockSize);
+    }
+    while (position_ != i) {
+      Step();
+    }
+    return static_cast<uint16_t>(predictor_) >> 8;
+  }
+
+  uint16_t position() const { return position_; }
+
+ private:
+  void Start(uint16_t block);
+  void Step();
+
+  const prog_uint8_t* data_;
+  const prog_uint8_t* codes_;
+  uint16_t position_;
+  int16_t predictor_;
+  uint8_t step_index_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdpcmDecoder);
+};
+
+}  // namespace avrlib
+
+#endif  // AVRLIB_ADPCM_H_
@@ -60,6 +60,7 @@ struct FourCC {
 template<bool b>
 inline void StaticAssertImplementation() {
 	char static_assert_size_mismatch[b] = { 0 };
+	(void) static_assert_size_mismatch;
 }
  
 #define STATIC_ASSERT(expression) StaticAssertImplementation<(expression)>()
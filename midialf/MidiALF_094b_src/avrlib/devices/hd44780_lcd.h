@@ -133,6 +133,7 @@ class Hd44780Lcd {
       return 0;
     }
     OutputBuffer::Overwrite2(LCD_DATA | (c >> 4), LCD_DATA | (c & 0xf));
+    return 1;
   }
 
   static uint8_t WriteCommand(uint8_t c) {
@@ -140,17 +141,20 @@ class Hd44780Lcd {
       return 0;
     }
     OutputBuffer::Overwrite2(LCD_COMMAND | (c >> 4), LCD_COMMAND | (c & 0x0f));
+    return 1;
   }
   
   static inline uint8_t Write(uint8_t character) {
-    WriteData(character);
+    return WriteData(character);
   }
   
   static inline uint8_t Write(const char* s) {
+    uint8_t written = 0;
     while (*s) {
-      WriteData(*s);
+      written += WriteData(*s);
       ++s;
     }
+    return written;
   }
 
   static inline void MoveCursor(uint8_t row, uint8_t col) {
@@ -235,6 +235,7 @@ class I2cMaster {
       case TW_MR_DATA_ACK:
         Input::Overwrite(TWDR);
         ++received_;
+        // Fall through.
       case TW_MR_SLA_ACK:
         if (received_ < requested_) {
           Continue(1);
@@ -246,6 +247,7 @@ class I2cMaster {
       case TW_MR_DATA_NACK:
         Input::Overwrite(TWDR);
         ++received_;
+        // Fall through.
       case TW_MR_SLA_NACK:
         Stop();
         break;
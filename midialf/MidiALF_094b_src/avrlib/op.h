@@ -21,7 +21,10 @@
 #ifndef AVRLIB_OP_H_
 #define AVRLIB_OP_H_
 
+// The portable versions are used when the code is built for the host.
+#ifdef __AVR__
 #define USE_OPTIMIZED_OP
+#endif  // __AVR__
 
 #include <avr/pgmspace.h>
 
@@ -723,6 +726,10 @@ static inline int16_t S16U16MulShift16(int16_t a, uint16_t b) {
   return (static_cast<int32_t>(a) * static_cast<uint32_t>(b)) >> 16;
 }
 
+static inline uint16_t U16U16MulShift16(uint16_t a, uint16_t b) {
+  return (static_cast<uint32_t>(a) * static_cast<uint32_t>(b)) >> 16;
+}
+
 static inline int16_t S16U8MulShift8(int16_t a, uint8_t b) {
   return (static_cast<int32_t>(a) * static_cast<uint32_t>(b)) >> 8;
 }
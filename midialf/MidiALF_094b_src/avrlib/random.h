@@ -34,8 +34,9 @@ class Random {
 
   static inline uint16_t state() { return rng_state_; }
 
+  // The LFSR never leaves the zero state, which is replaced by 1.
   static inline void Seed(uint16_t seed) {
-    rng_state_ = seed;
+    rng_state_ = seed ? seed : 1;
   }
 
   static inline uint8_t state_msb() {
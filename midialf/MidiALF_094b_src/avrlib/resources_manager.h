@@ -40,6 +40,16 @@ struct ResourcesTables {
   }
 };
 
+// Block modes of the tables compiled with the 'fold' and 'delta' codecs, see
+// resources_compiler.py.
+enum BlockMode {
+  BLOCK_RAW = 0,
+  BLOCK_FOLD_EVEN = 1,
+  BLOCK_FOLD_ODD = 2,
+  BLOCK_FOLD_MASK = 3,
+  BLOCK_DELTA = 4
+};
+
 struct NoResourcesTables {
   static inline const prog_char* const* string_table() { return NULL; }
   static inline const prog_uint16_t* const* lookup_table_table() { return NULL; }
@@ -82,6 +92,147 @@ class ResourcesManager {
     return ResultType(pgm_read_word(p + i));
   }
 
+  // Tables compiled with the 'fold' and 'delta' codecs are made of blocks of
+  // 2 * half + 1 samples. The block table holds the offset and mode of each
+  // block; folded blocks only store samples 0..half, the others are mirrored
+  // around the middle sample and complemented for antisymmetric blocks.
+  static inline const prog_uint8_t* LookupBlock(
+      const prog_uint8_t* p,
+      const prog_uint16_t* blocks,
+      uint8_t block,
+      uint8_t* mode) {
+    uint16_t header = pgm_read_word(blocks + block);
+    *mode = header >> 13;
+    return p + (header & 0x1fff);
+  }
+
+  // Reads samples i and i + 1 of a block, for interpolation. For blocks
+  // stored as deltas, this costs one nibble per sample up to i + 1, and two
+  // more for each jump larger than 7.
+  template<uint8_t half>
+  static inline void LookupPair(
+      const prog_uint8_t* block,
+      uint8_t mode,
+      uint8_t i,
+      uint8_t* a,
+      uint8_t* b) {
+    uint8_t fold = mode & BLOCK_FOLD_MASK;
+    uint8_t j = i;
+    uint8_t k = i + 1;
+    if (fold != BLOCK_RAW) {
+      if (j > half) j = 2 * half - j;
+      if (k > half) k = 2 * half - k;
+    }
+    // Mirrored or not, the two samples are adjacent in the block.
+    uint8_t first = j < k ? j : k;
+    uint8_t values[2];
+    if (mode & BLOCK_DELTA) {
+      LookupDelta(block, first, values);
+    } else {
+      values[0] = pgm_read_byte(block + first);
+      values[1] = pgm_read_byte(block + first + 1);
+    }
+    *a = values[j - first];
+    *b = values[k - first];
+    if (fold == BLOCK_FOLD_ODD) {
+      if (i > half && j) *a = ~*a;
+      if (i + 1 > half && k) *b = ~*b;
+    }
+  }
+
+  // Blocks stored as deltas hold their first sample, then a nibble per
+  // sample: its difference with the previous one in -7..7, or 8 followed by
+  // the sample on two nibbles. Decodes samples i and i + 1 into values.
+  static void LookupDelta(const prog_uint8_t* block, uint8_t i,
+                          uint8_t* values) {
+    uint8_t value = pgm_read_byte(block++);
+    uint16_t position = 0;
+    uint8_t n = 0;
+    while (1) {
+      if (n == i) {
+        values[0] = value;
+      } else if (n == i + 1) {
+        values[1] = value;
+        return;
+      }
+      ++n;
+      uint8_t nibble = ReadNibble(block, position++);
+      if (nibble == 8) {
+        value = ReadNibble(block, position++) << 4;
+        value |= ReadNibble(block, position++);
+      } else {
+        value += static_cast<int8_t>(nibble << 4) >> 4;
+      }
+    }
+  }
+
+  // Tables compiled with the 'delta2' codec are made of blocks of 16 values.
+  // Coded blocks hold their first value, their first difference and their
+  // second order differences on 4 bits. Reading value i of a coded block
+  // costs i - 1 nibbles and i additions.
+  static uint16_t LookupDelta2(
+      const prog_uint16_t* p,
+      const prog_uint16_t* blocks,
+      uint16_t i) {
+    uint16_t header = pgm_read_word(blocks + (i >> 4));
+    p += header & 0x7fff;
+    uint8_t n = i & 0xf;
+    if (!(header & 0x8000)) {
+      return pgm_read_word(p + n);
+    }
+    uint16_t value = pgm_read_word(p++);
+    if (n) {
+      uint16_t difference = pgm_read_word(p++);
+      uint16_t nibbles = 0;
+      value += difference;
+      for (uint8_t k = 1; k < n; ++k) {
+        if ((k & 3) == 1) {
+          nibbles = pgm_read_word(p++);
+        }
+        difference += static_cast<int8_t>(
+            static_cast<uint8_t>(nibbles >> 8) & 0xf0) >> 4;
+        nibbles <<= 4;
+        value += difference;
+      }
+    }
+    return value;
+  }
+
+  // Tables compiled with the 'dictionary' codec: each string is a list of
+  // indices in a dictionary of length-prefixed words. The words are written
+  // separated by one space and padded with spaces to width characters. Finding
+  // a word costs one read per word before it in the dictionary.
+  static void LoadDictionaryString(
+      const prog_uint8_t* dictionary,
+      const prog_uint8_t* words,
+      uint8_t num_words,
+      uint8_t i,
+      char* buffer,
+      uint8_t width) {
+    words += static_cast<uint16_t>(i) * num_words;
+    uint8_t size = 0;
+    for (uint8_t w = 0; w < num_words; ++w) {
+      uint8_t word = pgm_read_byte(words + w);
+      if (word == 0xff) {
+        break;
+      }
+      const prog_uint8_t* p = dictionary;
+      while (word--) {
+        p += pgm_read_byte(p) + 1;
+      }
+      uint8_t length = pgm_read_byte(p++);
+      if (size) {
+        buffer[size++] = ' ';
+      }
+      while (length--) {
+        buffer[size++] = pgm_read_byte(p++);
+      }
+    }
+    while (size < width) {
+      buffer[size++] = ' ';
+    }
+  }
+
   template<typename T>
   static void Load(const prog_char* p, uint8_t i, T* destination) {
     memcpy_P(destination, p + i * sizeof(T), sizeof(T));
@@ -97,6 +248,12 @@ class ResourcesManager {
   static void Load(const T* p, uint8_t* destination, uint16_t size) {
     memcpy_P(destination, p, size);
   }
+
+ private:
+  static inline uint8_t ReadNibble(const prog_uint8_t* p, uint16_t position) {
+    uint8_t byte = pgm_read_byte(p + (position >> 1));
+    return position & 1 ? byte & 0xf : byte >> 4;
+  }
 };
 
 typedef ResourcesManager<> SimpleResourcesManager;
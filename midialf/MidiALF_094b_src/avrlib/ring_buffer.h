@@ -89,6 +89,11 @@ class RingBuffer : public Input, Output {
     read_ptr_ = (r + 1) & (size - 1);
     return result;
   }
+  // Value written age writes ago, 0 being the most recent one. Only
+  // meaningful when age is less than readable().
+  static inline Value& Written(uint8_t age) {
+    return buffer_[(write_ptr_ - 1 - age) & (size - 1)];
+  }
   static inline void Flush() {
     write_ptr_ = read_ptr_;
   }
@@ -147,6 +147,7 @@ struct SerialOutput : public Output {
     if (v >= 0) {
       Overwrite(v);
     }
+    return v;
   }
 };
 
@@ -61,15 +61,18 @@ class SpiMaster {
     switch (speed) {
       case 2:
         DoubleSpeed::set();
+        // Fall through.
       case 4:
         break;
       case 8:
         DoubleSpeed::set();
+        // Fall through.
       case 16:
         configuration |= _BV(SPR0);
         break;
       case 32:
         DoubleSpeed::set();
+        // Fall through.
       case 64:
         configuration |= _BV(SPR1);
         break;
@@ -306,4 +309,4 @@ class UartSpiMaster {
 
 }  // namespace avrlib
 
-#endif AVRLIB_SPI_H_
+#endif  // AVRLIB_SPI_H_
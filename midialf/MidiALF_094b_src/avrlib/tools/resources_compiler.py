@@ -22,18 +22,362 @@
 """Compiles python string tables/arrays into .cc and .h files."""
 
 import os
+import re
 import string
 import sys
 
 
+# Block modes of the 'fold' and 'delta' codecs. Must match avrlib::BlockMode.
+BLOCK_RAW = 0
+BLOCK_FOLD_EVEN = 1
+BLOCK_FOLD_ODD = 2
+BLOCK_FOLD_MASK = 3
+BLOCK_DELTA = 4
+
+# Nibble of the 'delta' codec announcing a value stored on two nibbles.
+DELTA_ESCAPE = 8
+
+# Blocks needing more escapes than this are not coded as deltas: reading their
+# last sample would take too long (each escape costs 2 more nibbles).
+DELTA_MAX_ESCAPES = 16
+
+# Block size of the 'delta2' codec. Must match ResourcesManager::LookupDelta2.
+DELTA2_BLOCK_SIZE = 16
+
+# IMA ADPCM step sizes and step index adjustments. Must match avrlib/adpcm.cc.
+ADPCM_STEPS = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41,
+    45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209,
+    230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876,
+    963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749,
+    3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385,
+    24623, 27086, 29794, 32767]
+ADPCM_INDEX_ADJUSTMENTS = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+# Block size of the 'adpcm' codec. Must match avrlib::kAdpcmBlockSize.
+ADPCM_BLOCK_SIZE = 32
+
+
+def Crc16(values, crc=0):
+  """CRC-16 of a list of bytes, same as _crc16_update from avr-libc."""
+  for value in values:
+    crc ^= value & 0xff
+    for i in range(8):
+      crc = (crc >> 1) ^ 0xa001 if crc & 1 else crc >> 1
+  return crc
+
+
+def Unfold(block, mode, block_size):
+  """Expands a block stored with the 'fold' codec."""
+  mode &= BLOCK_FOLD_MASK
+  if mode == BLOCK_RAW:
+    return list(block)
+  half = (block_size - 1) // 2
+  values = list(block)
+  for i in range(half + 1, block_size):
+    j = 2 * half - i
+    if mode == BLOCK_FOLD_EVEN or j == 0:
+      values.append(block[j])
+    else:
+      values.append(255 - block[j])
+  return values
+
+
+def DeltaEncode(values):
+  """Codes a list of 8-bit values as 4-bit deltas.
+
+  The first value is stored as is. Each following value is a nibble holding
+  its difference with the previous one, in -7..7, or the escape nibble
+  followed by the value on two nibbles. Nibbles are packed high first.
+  """
+  nibbles = []
+  for previous, value in zip(values, values[1:]):
+    delta = value - previous
+    if -DELTA_ESCAPE < delta < DELTA_ESCAPE:
+      nibbles.append(delta & 0xf)
+    else:
+      nibbles.extend([DELTA_ESCAPE, value >> 4, value & 0xf])
+  nibbles += [0] * (len(nibbles) % 2)
+  return [values[0]] + [nibbles[i] << 4 | nibbles[i + 1]
+                        for i in range(0, len(nibbles), 2)]
+
+
+def DeltaDecode(data, size):
+  """Decodes size values coded by DeltaEncode."""
+  nibbles = []
+  for byte in data[1:]:
+    nibbles.extend([byte >> 4, byte & 0xf])
+  values = [data[0]]
+  i = 0
+  while len(values) < size:
+    if nibbles[i] == DELTA_ESCAPE:
+      values.append(nibbles[i + 1] << 4 | nibbles[i + 2])
+      i += 3
+    else:
+      delta = nibbles[i] - 16 if nibbles[i] & 8 else nibbles[i]
+      values.append((values[-1] + delta) & 0xff)
+      i += 1
+  return values
+
+
+def PackBlocks(value, block_size, fold, delta):
+  """Compresses an array of 8-bit blocks with the 'fold' and 'delta' codecs.
+
+  Each block holds an odd number of samples, the last one being a copy of the
+  first one (guard sample for interpolation). With 'fold', blocks which are
+  symmetric (x[n - i] = x[i]) or antisymmetric (x[n - i] = 255 - x[i]) around
+  their middle sample are stored as their first half. With 'delta', the
+  stored samples are coded with DeltaEncode when this is shorter and takes
+  no more than DELTA_MAX_ESCAPES escapes.
+  Returns the packed data and a list of (mode << 13 | offset) block headers.
+  """
+  assert block_size % 2 == 1
+  assert len(value) % block_size == 0
+  half = (block_size - 1) // 2
+  data = []
+  blocks = []
+  for i in range(0, len(value), block_size):
+    block = [int(x) for x in value[i:i + block_size]]
+    modes = [BLOCK_FOLD_EVEN, BLOCK_FOLD_ODD] if fold else []
+    for mode in modes + [BLOCK_RAW]:
+      packed = block if mode == BLOCK_RAW else block[:half + 1]
+      if Unfold(packed, mode, block_size) == block:
+        break
+    if delta:
+      coded = DeltaEncode(packed)
+      escapes = len([1 for previous, value in zip(packed, packed[1:])
+                     if abs(value - previous) >= DELTA_ESCAPE])
+      if len(coded) < len(packed) and escapes <= DELTA_MAX_ESCAPES:
+        mode |= BLOCK_DELTA
+        packed = coded
+    assert len(data) < (1 << 13)
+    blocks.append(mode << 13 | len(data))
+    data.extend(packed)
+  return data, blocks
+
+
+def UnpackBlocks(data, blocks, block_size):
+  """Expands the blocks packed by PackBlocks."""
+  values = []
+  for header in blocks:
+    offset = header & 0x1fff
+    mode = header >> 13
+    size = block_size
+    if mode & BLOCK_FOLD_MASK != BLOCK_RAW:
+      size = (block_size + 1) // 2
+    if mode & BLOCK_DELTA:
+      stored = DeltaDecode(data[offset:], size)
+    else:
+      stored = data[offset:offset + size]
+    values.extend(Unfold(stored, mode, block_size))
+  return values
+
+
+def PackDelta2(value):
+  """Compresses a 16-bit table with the 'delta2' codec.
+
+  Blocks of DELTA2_BLOCK_SIZE values whose second order differences are in
+  -8..7 are stored as their first value, their first difference and the
+  second order differences on 4 bits, 4 per word, high nibble first. The
+  other blocks are stored as is. Returns the packed data and a list of
+  (coded << 15 | offset) block headers.
+  """
+  data = []
+  blocks = []
+  for i in range(0, len(value), DELTA2_BLOCK_SIZE):
+    block = [int(x) for x in value[i:i + DELTA2_BLOCK_SIZE]]
+    assert all(0 <= x < 65536 for x in block)
+    differences = [b - a for a, b in zip(block, block[1:])]
+    residuals = [b - a for a, b in zip(differences, differences[1:])]
+    packed = block
+    coded = 0
+    if len(block) > 2 and all(-8 <= r < 8 for r in residuals):
+      nibbles = [r & 0xf for r in residuals]
+      nibbles += [0] * (-len(nibbles) % 4)
+      words = [block[0], differences[0] & 0xffff]
+      for j in range(0, len(nibbles), 4):
+        words.append(nibbles[j] << 12 | nibbles[j + 1] << 8 | \
+                     nibbles[j + 2] << 4 | nibbles[j + 3])
+      if len(words) < len(block):
+        packed = words
+        coded = 1
+    assert len(data) < (1 << 15)
+    blocks.append(coded << 15 | len(data))
+    data.extend(packed)
+  return data, blocks
+
+
+def UnpackDelta2(data, blocks, size):
+  """Expands a table packed by PackDelta2."""
+  values = []
+  for header in blocks:
+    offset = header & 0x7fff
+    n = min(DELTA2_BLOCK_SIZE, size - len(values))
+    if not header & 0x8000:
+      values.extend(data[offset:offset + n])
+      continue
+    value = data[offset]
+    difference = data[offset + 1]
+    values.append(value)
+    for k in range(n - 1):
+      if k:
+        nibble = (data[offset + 2 + (k - 1) // 4] >> (12 - 4 * ((k - 1) % 4)))
+        nibble &= 0xf
+        difference += nibble - 16 if nibble & 8 else nibble
+      value = (value + difference) & 0xffff
+      values.append(value)
+  return values
+
+
+def AdpcmDecodeSample(predictor, index, code):
+  """Updates the IMA ADPCM predictor and step index with a 4-bit code."""
+  step = ADPCM_STEPS[index]
+  delta = step >> 3
+  if code & 4:
+    delta += step
+  if code & 2:
+    delta += step >> 1
+  if code & 1:
+    delta += step >> 2
+  predictor = predictor - delta if code & 8 else predictor + delta
+  predictor = max(-32768, min(32767, predictor))
+  index += ADPCM_INDEX_ADJUSTMENTS[code & 7]
+  index = max(0, min(len(ADPCM_STEPS) - 1, index))
+  return predictor, index
+
+
+def AdpcmEncode(value):
+  """Compresses 8-bit signed samples with the 'adpcm' codec.
+
+  Samples are coded in blocks of ADPCM_BLOCK_SIZE with IMA ADPCM, on a 16-bit
+  predictor whose high byte is the sample. A block holds its first sample,
+  the initial step index, and a 4-bit code for each other sample, high nibble
+  first. Codes are picked greedily; the initial step index minimizing the
+  error of the block is searched for.
+  Returns the packed data and the decoded samples.
+  """
+  assert len(value) % ADPCM_BLOCK_SIZE == 0
+  samples = [(int(x) & 0xff) - ((int(x) & 0x80) << 1) for x in value]
+  data = []
+  decoded = []
+  for i in range(0, len(samples), ADPCM_BLOCK_SIZE):
+    block = samples[i:i + ADPCM_BLOCK_SIZE]
+    best = None
+    for start_index in range(len(ADPCM_STEPS)):
+      predictor, index = block[0] << 8, start_index
+      codes = []
+      error = 0
+      for sample in block[1:]:
+        candidates = [AdpcmDecodeSample(predictor, index, code) + (code,)
+                      for code in range(16)]
+        predictor, index, code = min(
+            candidates, key=lambda c: abs(c[0] - (sample << 8)))
+        error += ((predictor >> 8) - sample) ** 2
+        codes.append(code)
+      if best is None or error < best[0]:
+        best = (error, start_index, codes)
+    error, start_index, codes = best
+    codes += [0] * (len(codes) % 2)
+    data.extend([block[0] & 0xff, start_index])
+    data.extend(codes[j] << 4 | codes[j + 1] for j in range(0, len(codes), 2))
+    decoded.extend(AdpcmDecode(data[-ADPCM_BLOCK_SIZE // 2 - 2:]))
+  return data, decoded
+
+
+def AdpcmDecode(block):
+  """Decodes a block coded by AdpcmEncode, as unsigned bytes."""
+  predictor, index = ((block[0] ^ 0x80) - 0x80) << 8, block[1]
+  values = [predictor >> 8]
+  for i in range(ADPCM_BLOCK_SIZE - 1):
+    code = block[2 + i // 2] >> 4 if i % 2 == 0 else block[2 + i // 2] & 0xf
+    predictor, index = AdpcmDecodeSample(predictor, index, code)
+    values.append(predictor >> 8)
+  return [x & 0xff for x in values]
+
+
+def PackDictionary(strings, width):
+  """Compresses a table of strings with the 'dictionary' codec.
+
+  The strings are split into words, each stored once in a dictionary of
+  length-prefixed words, the most frequent first. A string becomes a fixed
+  number of word indices, 255 marking its end. The decoder writes the words
+  separated by one space and pads them with spaces to width characters.
+  Returns the dictionary, the word indices and the number of words per
+  string.
+  """
+  counts = {}
+  for s in strings:
+    assert len(s) <= width and ' '.join(s.split()) == s, s
+    for word in s.split():
+      counts[word] = counts.get(word, 0) + 1
+  words = sorted(counts.keys(), key=lambda w: (-counts[w], w))
+  assert len(words) < 255
+  dictionary = []
+  for word in words:
+    dictionary.append(len(word))
+    dictionary.extend(ord(c) for c in word)
+  num_words = max(len(s.split()) for s in strings)
+  indices = []
+  for s in strings:
+    split = s.split()
+    indices.extend([words.index(w) for w in split])
+    indices.extend([255] * (num_words - len(split)))
+  return dictionary, indices, num_words
+
+
+def UnpackDictionary(dictionary, indices, num_words, width):
+  """Expands the strings packed by PackDictionary."""
+  words = []
+  i = 0
+  while i < len(dictionary):
+    length = dictionary[i]
+    words.append(''.join(chr(c) for c in dictionary[i + 1:i + 1 + length]))
+    i += dictionary[i] + 1
+  strings = []
+  for i in range(0, len(indices), num_words):
+    s = ' '.join(words[j] for j in indices[i:i + num_words] if j != 255)
+    strings.append(s.ljust(width))
+  return strings
+
+
 class ResourceEntry(object):
   
-  def __init__(self, index, key, value, dupe_of, table):
+  def __init__(self, index, key, value, dupe_of, table, codec=None):
     self._index = index
     self._key = key
     self._value = value
     self._dupe_of = self._key if dupe_of is None else dupe_of
     self._table = table
+    self._codec = codec
+    self._blocks = None
+    if codec:
+      self._Pack(value)
+
+  def _Pack(self, value):
+    name, block_size = self._codec
+    source = [int(x) for x in value]
+    if name == 'adpcm':
+      # Lossy: the checksum is the one of the data the decoder will output.
+      assert block_size == ADPCM_BLOCK_SIZE
+      self._value, unpacked = AdpcmEncode(source)
+    elif name == 'delta2':
+      assert block_size == DELTA2_BLOCK_SIZE
+      self._value, self._blocks = PackDelta2(source)
+      unpacked = UnpackDelta2(self._value, self._blocks, len(source))
+    else:
+      codecs = name.split('+')
+      assert set(codecs) <= set(['fold', 'delta'])
+      self._value, self._blocks = PackBlocks(
+          source, block_size, 'fold' in codecs, 'delta' in codecs)
+      unpacked = UnpackBlocks(self._value, self._blocks, block_size)
+    # Make sure the decoder will get back the original data.
+    if name != 'adpcm':
+      assert unpacked == source
+    self._decoded_size = len(unpacked)
+    if self._table.c_type == 'prog_uint16_t':
+      unpacked = sum([[x & 0xff, x >> 8] for x in unpacked], [])
+    self._checksum = Crc16(unpacked)
 
   @property
   def variable_name(self):
@@ -45,10 +389,17 @@ class ResourceEntry(object):
     name = self.variable_name
     return 'const %(c_type)s %(name)s[] PROGMEM' % locals()
     
+  @property
+  def blocks_declaration(self):
+    name = self.variable_name
+    return 'const prog_uint16_t %(name)s_blocks[] PROGMEM' % locals()
+
   def Declare(self, f):
     if self._dupe_of == self._key:
       # Dupes are not declared.
       f.write('extern %s;\n' % self.declaration)
+      if self._blocks:
+        f.write('extern %s;\n' % self.blocks_declaration)
 
   def DeclareAlias(self, f):
     prefix = self._table.prefix
@@ -63,6 +414,16 @@ class ResourceEntry(object):
     f.write('#define %(prefix)s_%(key)s %(index)d%(comment)s\n' % locals())
     if not size is None:
       f.write('#define %(prefix)s_%(key)s_SIZE %(size)d\n' % locals())
+    if self._codec:
+      block_size = self._codec[1]
+      decoded_size = self._decoded_size
+      checksum = self._checksum
+      f.write('#define %(prefix)s_%(key)s_BLOCK_SIZE %(block_size)d\n' % \
+          locals())
+      f.write('#define %(prefix)s_%(key)s_DECODED_SIZE %(decoded_size)d\n' % \
+          locals())
+      f.write('#define %(prefix)s_%(key)s_CHECKSUM 0x%(checksum)04x\n' % \
+          locals())
   
   def Compile(self, f):
     # Do not create declaration for dupes.
@@ -74,14 +435,26 @@ class ResourceEntry(object):
       value = self._value
       f.write('static %(declaration)s = "%(value)s";\n' % locals())
     else:
-      f.write('%(declaration)s = {\n' % locals())
-      n_elements = len(self._value)
-      for i in xrange(0, n_elements, 8):
-        f.write('  ');
-        f.write(', '.join(
-            '%6d' % self._value[j] for j in xrange(i, min(n_elements, i + 8))))
-        f.write(',\n');
-      f.write('};\n')
+      self._CompileArray(f, declaration, self._value, self._table.c_type)
+      if self._blocks:
+        self._CompileArray(f, self.blocks_declaration, self._blocks,
+                           'prog_uint16_t')
+
+  @staticmethod
+  def _CompileArray(f, declaration, values, c_type):
+    # Negative values go to unsigned tables as the value they are stored as.
+    bits = re.match('prog_uint(\d+)_t', c_type)
+    if bits:
+      mask = (1 << int(bits.group(1))) - 1
+      values = [x & mask for x in values]
+    f.write('%(declaration)s = {\n' % locals())
+    n_elements = len(values)
+    for i in xrange(0, n_elements, 8):
+      f.write('  ');
+      f.write(', '.join(
+          '%6d' % values[j] for j in xrange(i, min(n_elements, i + 8))))
+      f.write(',\n');
+    f.write('};\n')
     
 
 class ResourceTable(object):
@@ -92,28 +465,53 @@ class ResourceTable(object):
     self.c_type = resource_tuple[3]
     self.python_type = resource_tuple[4]
     self.ram_based_table = resource_tuple[5]
+    # String tables can have an optional codec, for example ('dictionary', 20).
+    self.codec = resource_tuple[6] if len(resource_tuple) > 6 else None
     self.entries = []
     self._ComputeIdentifierRewriteTable()
     keys = set()
     values = {}
     for index, entry in enumerate(resource_tuple[0]):
+      codec = None
       if self.python_type == str:
         # There is no name/value for string entries
         key, value = entry, entry.strip()
       else:
-        key, value = entry
+        # Entries can have an optional codec, for example ('fold', 129).
+        key, value = entry[:2]
+        codec = entry[2] if len(entry) > 2 else None
 
       # Add a prefix to avoid key duplicates.
       key = self._MakeIdentifier(key)
       while key in keys:
         key = '_%s' % key
       keys.add(key)
-      hashable_value = tuple(value)
+      hashable_value = (tuple(value), codec)
       self.entries.append(ResourceEntry(index, key, value,
-          values.get(hashable_value, None), self))
+          values.get(hashable_value, None), self, codec))
       if not hashable_value in values:
         values[hashable_value] = key
-  
+    if self.codec:
+      self._Pack()
+
+  def _Pack(self):
+    name, width = self.codec
+    assert name == 'dictionary' and self.python_type == str
+    strings = [entry._value for entry in self.entries]
+    self._dictionary, self._words, self._num_words = PackDictionary(
+        strings, width)
+    # Make sure the decoder will get back the original strings.
+    unpacked = UnpackDictionary(
+        self._dictionary, self._words, self._num_words, width)
+    assert unpacked == [s.ljust(width) for s in strings]
+    self._checksum = Crc16([ord(c) for c in ''.join(unpacked)])
+
+  @property
+  def declarations(self):
+    name = self.name
+    return ['const prog_uint8_t %(name)s_dictionary[] PROGMEM' % locals(),
+            'const prog_uint8_t %(name)s_words[] PROGMEM' % locals()]
+
   def _ComputeIdentifierRewriteTable(self):
     in_chr = ''.join(map(chr, range(256)))
     out_chr = [ord('_')] * 256
@@ -132,15 +530,36 @@ class ResourceTable(object):
     self._MakeIdentifier = lambda s:s.translate(table, bad_chars)
   
   def DeclareEntries(self, f):
-    if self.python_type != str:
+    if self.codec:
+      for declaration in self.declarations:
+        f.write('extern %s;\n' % declaration)
+    elif self.python_type != str:
       for entry in self.entries:
         entry.Declare(f)
 
   def DeclareAliases(self, f):
+    if self.codec:
+      # Strings packed with the dictionary are only accessed by their index.
+      prefix = self.prefix
+      num_strings = len(self.entries)
+      width = self.codec[1]
+      num_words = self._num_words
+      checksum = self._checksum
+      f.write('#define %(prefix)s_NUM_STRINGS %(num_strings)d\n' % locals())
+      f.write('#define %(prefix)s_WIDTH %(width)d\n' % locals())
+      f.write('#define %(prefix)s_WORDS_PER_STRING %(num_words)d\n' % locals())
+      f.write('#define %(prefix)s_CHECKSUM 0x%(checksum)04x\n' % locals())
+      return
     for entry in self.entries:
       entry.DeclareAlias(f)
   
   def Compile(self, f):
+    if self.codec:
+      dictionary, words = self.declarations
+      ResourceEntry._CompileArray(f, dictionary, self._dictionary)
+      ResourceEntry._CompileArray(f, words, self._words)
+      return
+
     # Write a declaration for each entry.
     for entry in self.entries:
       entry.Compile(f)
@@ -187,6 +606,9 @@ class ResourceLibrary(object):
 
   def _DeclareTables(self, f):
     for table in self._tables:
+      if table.codec:
+        # Packed tables have no pointer table.
+        continue
       f.write('extern const %s* const %s_table[];\n\n' % (table.c_type, table.name)) 
 
   def _DeclareEntries(self, f):
@@ -234,7 +656,8 @@ class ResourceLibrary(object):
     file_name = os.path.join(self._root.target, 'resources.cc')
     f = file(file_name, 'wb')
     f.write(self._root.header + '\n\n')
-    f.write('#include "%s"\n' % file_name.replace('.cc', '.h'))
+    f.write('#include "%s"\n' % file_name.replace('.cc', '.h').replace(
+        os.sep, '/'))
     self._OpenNamespace(f)
     self._CompileTables(f)
     self._CloseNamespace(f)
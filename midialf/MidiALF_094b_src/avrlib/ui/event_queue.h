@@ -20,6 +20,8 @@
 #ifndef AVRLIB_UI_EVENT_QUEUE_H_
 #define AVRLIB_UI_EVENT_QUEUE_H_
 
+#include <avr/interrupt.h>
+
 #include "avrlib/base.h"
 #include "avrlib/op.h"
 #include "avrlib/ring_buffer.h"
@@ -63,6 +65,36 @@ class EventQueue {
     v.bytes[1] = data;
     events_.Overwrite(v.value);
   }
+
+  // Same as AddEvent, but a signed increment is merged into the most recent
+  // unread event of the same control instead of taking a new slot. The
+  // search goes past the unread increments of other controls of the same
+  // type, which the merged one doesn't need to stay ordered with, and stops
+  // at any other event. The accumulated value saturates at the int8 limits.
+  static void AddIncrement(uint8_t control_type, uint8_t id, int8_t data) {
+    uint8_t type = U8ShiftLeft4(control_type);
+    uint8_t tag = type | (id & 0x0f);
+    uint8_t pending = events_.readable();
+    for (uint8_t age = 0; age < pending; ++age) {
+      Word v;
+      v.value = events_.Written(age);
+      if (v.bytes[0] == tag) {
+        int16_t sum = static_cast<int8_t>(v.bytes[1]) + data;
+        if (sum > 127) {
+          sum = 127;
+        } else if (sum < -128) {
+          sum = -128;
+        }
+        v.bytes[1] = static_cast<uint8_t>(sum);
+        events_.Written(age) = v.value;
+        return;
+      }
+      if ((v.bytes[0] & 0xf0) != type) {
+        break;
+      }
+    }
+    AddEvent(control_type, id, data);
+  }
   
   static uint8_t available() {
     return events_.readable();
@@ -85,7 +117,11 @@ class EventQueue {
   static Event PullEvent() {
     Event e;
     Word v;
+    // The producer may merge into the entry being read, so the read must be
+    // atomic.
+    uint8_t sreg = SREG; cli();
     v.value = events_.ImmediateRead();
+    SREG = sreg;
     e.control_type = U8ShiftRight4(v.bytes[0]);
     e.control_id = v.bytes[0] & 0x0f;
     e.value = v.bytes[1];
@@ -73,6 +73,7 @@ struct MidiDevice {
   static void Start() { }
   static void Continue() { }
   static void Stop() { }
+  static void SongPosition(uint16_t position) { }
   static void ActiveSensing() { }
   static void Reset() { }
 
@@ -136,19 +137,24 @@ void MidiStreamParser<Device>::PushByte(uint8_t byte) {
           expected_data_size_ = 2;
           break;
         case 0xf0:
-          if (lo > 0 && lo < 3) {
+          if (lo == 2) {
             expected_data_size_ = 2;
           } else if (lo >= 4) {
             expected_data_size_ = 0;
           }
           break;
       }
-      if (running_status_ == 0xf0) {
-        Device::SysExEnd();
-      }
-      running_status_ = byte;
-      if (running_status_ == 0xf0) {
+      // Only 0xf7 completes a SysEx message, other status bytes abort it.
+      if (byte == 0xf7) {
+        if (running_status_ == 0xf0) {
+          Device::SysExEnd();
+        }
+        running_status_ = 0;
+      } else if (byte == 0xf0) {
+        running_status_ = 0xf0;
         Device::SysExStart();
+      } else {
+        running_status_ = byte;
       }
     } else {
       data_[data_size_++] = byte;
@@ -167,20 +173,28 @@ void MidiStreamParser<Device>::PushByte(uint8_t byte) {
 template<typename Device>
 void MidiStreamParser<Device>::MessageReceived(uint8_t status) {
   if (!status) {
-    Device::BozoByte(data_[0]);
+    // Data byte without running status, or end of a SysEx message. There is
+    // nothing to forward.
+    if (data_size_) {
+      Device::BozoByte(data_[0]);
+    }
+    return;
   }
 
   uint8_t hi = status & 0xf0;
   uint8_t lo = status & 0x0f;
+  // Realtime messages can be interleaved with the data bytes of another
+  // message, which must not be forwarded with them.
+  uint8_t data_size = status >= 0xf8 ? 0 : data_size_;
 
   // If this is a channel-specific message, check first that the receiver is
   // tuned to this channel.
   if (hi != 0xf0 && !Device::CheckChannel(lo)) {
-    Device::RawMidiData(status, data_, data_size_, 0);
+    Device::RawMidiData(status, data_, data_size, 0);
     return;
   }
   if (status != 0xf0 && status != 0xf7) {
-    Device::RawMidiData(status, data_, data_size_, 1);
+    Device::RawMidiData(status, data_, data_size, 1);
   }
   switch (hi) {
     case 0x80:
@@ -248,17 +262,17 @@ void MidiStreamParser<Device>::MessageReceived(uint8_t status) {
         case 0x0:
           Device::SysExByte(data_[0]);
           break;
-        case 0x1:
         case 0x2:
+          Device::SongPosition(
+              (static_cast<uint16_t>(data_[1]) << 7) + data_[0]);
+          break;
+        case 0x1:
         case 0x3:
         case 0x4:
         case 0x5:
         case 0x6:
           // TODO(pichenettes): implement this if it makes sense.
           break;
-        case 0x7:
-          Device::SysExEnd();
-          break;
         case 0x8:
           Device::Clock();
           break;
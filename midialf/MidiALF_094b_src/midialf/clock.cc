@@ -21,17 +21,51 @@
 
 #include "midialf/resources.h"
 
+#include <avr/interrupt.h>
+
 namespace midialf {
 
+// Number of ticks over which a tempo change is spread (one beat).
+static const uint8_t kNumRampTicks = kNumTicksPerStep * 4;
+
+// Range of tick durations accepted from the external clock, in timer counts
+// (300 to 12 bpm). Longer intervals mean the clock was stopped.
+static const uint16_t kMinSyncPeriod = 2604;
+static const uint16_t kMaxSyncPeriod = 65535;
+
+// Timer counts before a tick forced by an external clock. Writing TCNT1
+// blocks the compare match on the next timer clock, so this must be > 1.
+static const uint8_t kForcedTickDelay = 4;
+
 Clock clock;
 
 /* <static> */
 bool Clock::running_;
 uint32_t Clock::clock_;
-uint16_t Clock::intervals_[kNumStepsInGroovePattern];
 uint16_t Clock::interval_;
 uint8_t Clock::tick_count_;
 uint8_t Clock::step_count_;
+uint16_t Clock::period_;
+uint16_t Clock::remainder_;
+uint16_t Clock::divisor_ = 1;
+uint16_t Clock::phase_;
+uint32_t Clock::ramp_period_;
+int32_t Clock::ramp_increment_;
+uint16_t Clock::ramp_phase_;
+uint8_t Clock::ramp_ticks_;
+int16_t Clock::groove_[kNumStepsInGroovePattern];
+int16_t Clock::groove_offset_;
+uint8_t Clock::groove_template_ = 0xff;
+uint8_t Clock::groove_amount_;
+bool Clock::external_;
+bool Clock::hold_;
+bool Clock::sync_start_;
+bool Clock::sync_locked_;
+int8_t Clock::sync_lead_;
+uint32_t Clock::sync_time_;
+int32_t Clock::sync_period_;
+int32_t Clock::sync_correction_;
+uint8_t Clock::sync_phase_;
 /* </static> */
 
 /* static */
@@ -40,15 +74,11 @@ void Clock::Update(
     uint8_t bpm_tenth,
     uint8_t groove_template,
     uint8_t groove_amount) {
-  int32_t base_tick_duration = 7812500 / \
-      (static_cast<uint32_t>(bpm) * 10 + bpm_tenth) - 1;
-  for (uint8_t i = 0; i < kNumStepsInGroovePattern; ++i) {
-    int32_t swing_direction = ResourcesManager::Lookup<int16_t, uint8_t>(
-          LUT_RES_GROOVE_SWING + groove_template, i);
-    swing_direction *= base_tick_duration;
-    swing_direction *= groove_amount;
-    intervals_[i] = base_tick_duration + (swing_direction >> 16);
-  }
+  SetTickDuration(
+      7812500,
+      bpm * 10 + bpm_tenth,
+      groove_template,
+      groove_amount);
 }
 
 /* static */
@@ -58,15 +88,231 @@ void Clock::UpdateFractional(
     uint8_t divider,
     uint8_t groove_template,
     uint8_t groove_amount) {
-  int32_t base_tick_duration = (781250L * divider) / \
-      (static_cast<uint32_t>(bpm) * multiplier) - 1;
-  for (uint8_t i = 0; i < kNumStepsInGroovePattern; ++i) {
-    int32_t swing_direction = ResourcesManager::Lookup<int16_t, uint8_t>(
+  SetTickDuration(
+      781250L * divider,
+      bpm * multiplier,
+      groove_template,
+      groove_amount);
+}
+
+/* static */
+void Clock::SetTickDuration(
+    uint32_t numerator,
+    uint16_t denominator,
+    uint8_t groove_template,
+    uint8_t groove_amount) {
+  uint16_t period = numerator / denominator;
+  uint16_t remainder = numerator - static_cast<uint32_t>(period) * denominator;
+  uint32_t ramp_period = (static_cast<uint32_t>(period) << 16) + \
+      (static_cast<uint32_t>(remainder) << 16) / denominator;
+
+  // The groove template is made zero-sum by removing its average, and stored
+  // as cumulated offsets so that rounding errors do not add up either. The
+  // offsets are 16 times too large here, and scaled back with amount.
+  bool groove_changed = groove_template != groove_template_ || \
+      groove_amount != groove_amount_;
+  int16_t groove[kNumStepsInGroovePattern];
+  if (groove_changed) {
+    int16_t sum = 0;
+    for (uint8_t i = 0; i < kNumStepsInGroovePattern; ++i) {
+      sum += ResourcesManager::Lookup<int16_t, uint8_t>(
           LUT_RES_GROOVE_SWING + groove_template, i);
-    swing_direction *= base_tick_duration;
-    swing_direction *= groove_amount;
-    intervals_[i] = base_tick_duration + (swing_direction >> 16);
+    }
+    int32_t offset = 0;
+    for (uint8_t i = 0; i < kNumStepsInGroovePattern; ++i) {
+      groove[i] = (offset * groove_amount) >> 8;
+      offset += ResourcesManager::Lookup<int16_t, uint8_t>(
+          LUT_RES_GROOVE_SWING + groove_template, i) * 16 - sum;
+    }
+  }
+
+  uint8_t sreg = SREG;
+  cli();
+
+  if (groove_changed) {
+    for (uint8_t i = 0; i < kNumStepsInGroovePattern; ++i) {
+      groove_[i] = groove[i];
+    }
+    groove_template_ = groove_template;
+    groove_amount_ = groove_amount;
+  }
+
+  // While running, tempo changes are interpolated from the current tick
+  // duration instead of jumping to the new one.
+  if (period != period_ || remainder != remainder_ || \
+      denominator != divisor_) {
+    if (running_) {
+      ramp_increment_ = static_cast<int32_t>(ramp_period - ramp_period_) / \
+          kNumRampTicks;
+      ramp_phase_ = 0;
+      ramp_ticks_ = kNumRampTicks;
+    } else {
+      ramp_period_ = ramp_period;
+      ramp_ticks_ = 0;
+    }
+    phase_ = 0;
+  }
+  period_ = period;
+  remainder_ = remainder;
+  divisor_ = denominator;
+
+  SREG = sreg;
+}
+
+/* static */
+uint16_t Clock::NextInterval() {
+  uint16_t base;
+  uint16_t period;
+  if (ramp_ticks_) {
+    ramp_period_ += ramp_increment_;
+    uint32_t phase = static_cast<uint32_t>(ramp_phase_) + \
+        static_cast<uint16_t>(ramp_period_);
+    ramp_phase_ = phase;
+    base = ramp_period_ >> 16;
+    period = base + (phase >> 16);
+    --ramp_ticks_;
+  } else {
+    base = period_;
+    period = period_;
+    if (phase_ >= divisor_ - remainder_) {
+      phase_ -= divisor_ - remainder_;
+      ++period;
+    } else {
+      phase_ += remainder_;
+    }
+  }
+
+  // The offset of a step is the difference between the cumulated offsets at
+  // its end and at its beginning, scaled by the same tick duration.
+  if (tick_count_ == 0) {
+    uint8_t next_step = step_count_ + 1;
+    int32_t end = next_step == kNumStepsInGroovePattern ? \
+        0 : groove_[next_step];
+    int32_t start = groove_[step_count_];
+    groove_offset_ = ((end * base) >> 12) - ((start * base) >> 12);
+  }
+  return period + groove_offset_ - 1;
+}
+
+/* static */
+void Clock::set_external(bool external) {
+  uint8_t sreg = SREG;
+  cli();
+  if (external != external_) {
+    external_ = external;
+    hold_ = false;
+    sync_start_ = false;
+    sync_locked_ = false;
+    sync_lead_ = 0;
+    // Until locked, the external clock runs at the internal tempo
+    sync_period_ = static_cast<int32_t>(period_) << 8;
+    sync_correction_ = 0;
+    ramp_ticks_ = 0;
+    phase_ = 0;
+  }
+  SREG = sreg;
+}
+
+/* static */
+void Clock::StartExternal() {
+  uint8_t sreg = SREG;
+  cli();
+  // Hold the ticks until the next clock, which restarts them
+  sync_start_ = true;
+  sync_lead_ = 0;
+  SREG = sreg;
+}
+
+/* static */
+void Clock::OnExternalClock() {
+  uint8_t sreg = SREG;
+  cli();
+
+  // Time elapsed since the beginning of the current tick. If a compare match
+  // is pending, the counter has already been cleared.
+  uint16_t elapsed = TCNT1;
+  bool pending = (TIFR1 & _BV(OCF1A)) && elapsed < (interval_ >> 1);
+  if (pending) {
+    elapsed += interval_ + 1;
+  }
+  uint32_t interval = clock_ + elapsed - sync_time_;
+  sync_time_ = clock_ + elapsed;
+  --sync_lead_;
+
+  bool valid = interval >= kMinSyncPeriod && interval <= kMaxSyncPeriod;
+  if (!valid) {
+    sync_locked_ = false;
   }
+
+  if (sync_start_ || hold_ || !sync_locked_) {
+    // Restart the ticks on this clock. Until the PLL is locked, the tempo is
+    // given by the interval between the last two clocks.
+    if (!sync_locked_ && valid) {
+      sync_period_ = interval << 8;
+      sync_locked_ = true;
+    }
+    if (sync_start_) {
+      sync_start_ = false;
+      tick_count_ = kNumTicksPerStep - 1;
+    }
+    sync_correction_ = 0;
+    if (!pending) {
+      if (sync_lead_ < 0) {
+        // The tick for this clock is due now
+        RestartTick(elapsed, kForcedTickDelay);
+      } else {
+        // The tick for this clock was early, start the next one from here
+        sync_phase_ = 0;
+        interval_ = (sync_period_ >> 8) - 1;
+        OCR1A = interval_;
+        RestartTick(elapsed, interval_ + 1);
+      }
+    }
+  } else {
+    // Second order PLL on the phase error, with a proportional gain of 1/8
+    // and an integral gain of 1/256 (critically damped).
+    int32_t error = static_cast<int32_t>(elapsed) + \
+        sync_lead_ * (sync_period_ >> 8);
+    sync_period_ += error;
+    sync_correction_ = error << 5;
+  }
+
+  SREG = sreg;
+}
+
+/* static */
+uint16_t Clock::TickExternal() {
+  // Never run more than one tick ahead of the incoming clocks, so that the
+  // sequencer stops with them.
+  hold_ = sync_start_ || sync_lead_ >= 1;
+  if (!hold_) {
+    ++sync_lead_;
+    ++tick_count_;
+    if (tick_count_ == kNumTicksPerStep) {
+      tick_count_ = 0;
+    }
+  }
+
+  int32_t period = sync_period_ + sync_correction_;
+  sync_correction_ = 0;
+  if (period < static_cast<int32_t>(kMinSyncPeriod) << 8) {
+    period = static_cast<int32_t>(kMinSyncPeriod) << 8;
+  } else if (period > static_cast<int32_t>(kMaxSyncPeriod) << 8) {
+    period = static_cast<int32_t>(kMaxSyncPeriod) << 8;
+  }
+  uint16_t phase = sync_phase_ + static_cast<uint8_t>(period);
+  sync_phase_ = phase;
+  interval_ = (period >> 8) + (phase >> 8) - 1;
+  return interval_;
+}
+
+/* static */
+void Clock::RestartTick(uint16_t elapsed, uint16_t remaining) {
+  // Make the current tick end in remaining timer counts, keeping clock_ +
+  // TCNT1 equal to the time elapsed since Reset.
+  uint16_t count = interval_ + 1 - remaining;
+  TCNT1 = count;
+  clock_ += elapsed - count;
 }
 
 } // namespace midialf
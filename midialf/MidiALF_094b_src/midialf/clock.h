@@ -41,6 +41,7 @@ class Clock {
     running_ = false;
   }
   static inline void Reset() {
+    sync_time_ -= clock_;
     clock_ = 0;
   }
   
@@ -49,7 +50,9 @@ class Clock {
     running_ = true;
     tick_count_ = 0;
     step_count_ = 0;
-    interval_ = intervals_[0];
+    ramp_ticks_ = 0;
+    phase_ = 0;
+    interval_ = NextInterval();
   }
   
   static inline void Stop() {
@@ -64,8 +67,17 @@ class Clock {
     return running_;
   }
 
+  // True when the last tick was not delivered, because the external clock
+  // is late.
+  static inline bool held() {
+    return hold_;
+  }
+
   static inline uint16_t Tick() {
     clock_ += interval_ + 1;
+    if (external_) {
+      return TickExternal();
+    }
     ++tick_count_;
     if (tick_count_ == kNumTicksPerStep) {
       tick_count_ = 0;
@@ -73,8 +85,8 @@ class Clock {
       if (step_count_ == kNumStepsInGroovePattern) {
         step_count_ = 0;
       }
-      interval_ = intervals_[step_count_];
     }
+    interval_ = NextInterval();
     return interval_;
   }
   
@@ -102,13 +114,63 @@ class Clock {
       uint8_t groove_template,
       uint8_t groove_amount);
 
+  // External clock following. Incoming MIDI clocks are tracked by a PLL,
+  // and ticks are regenerated at the estimated tempo and phase.
+  static void set_external(bool external);
+  static void StartExternal();
+  static void OnExternalClock();
+
  private:
+  static void SetTickDuration(
+      uint32_t numerator,
+      uint16_t denominator,
+      uint8_t groove_template,
+      uint8_t groove_amount);
+  static uint16_t NextInterval();
+  static uint16_t TickExternal();
+  static void RestartTick(uint16_t elapsed, uint16_t count);
+
   static bool running_;
   static uint32_t clock_;  // Counts forever
-  static uint16_t intervals_[kNumStepsInGroovePattern];
   static uint16_t interval_;
   static uint8_t tick_count_;
   static uint8_t step_count_;
+
+  // The tick duration is period_ + remainder_ / divisor_ timer counts. The
+  // fractional part is carried from tick to tick in phase_, so the long run
+  // tempo is exact.
+  static uint16_t period_;
+  static uint16_t remainder_;
+  static uint16_t divisor_;
+  static uint16_t phase_;
+
+  // During a tempo change, the tick duration (in 1/65536 of timer counts)
+  // moves linearly from the old value to the new one.
+  static uint32_t ramp_period_;
+  static int32_t ramp_increment_;
+  static uint16_t ramp_phase_;
+  static uint8_t ramp_ticks_;
+
+  // Cumulated groove offsets at the beginning of each step, summing to zero
+  // over the pattern so that groove does not change the tempo.
+  static int16_t groove_[kNumStepsInGroovePattern];
+  static int16_t groove_offset_;
+  static uint8_t groove_template_;
+  static uint8_t groove_amount_;
+
+  // The tick duration estimated from the external clock is sync_period_
+  // (in 1/256 of timer counts), corrected once by sync_correction_ after
+  // each incoming clock. sync_lead_ is the number of ticks generated minus
+  // the number of clocks received.
+  static bool external_;
+  static bool hold_;
+  static bool sync_start_;
+  static bool sync_locked_;
+  static int8_t sync_lead_;
+  static uint32_t sync_time_;
+  static int32_t sync_period_;
+  static int32_t sync_correction_;
+  static uint8_t sync_phase_;
 };
 
 extern Clock clock;
@@ -34,6 +34,13 @@ CV cv;
 /* <static> */
 uint16_t CV::cv_value_[kCVCount];
 uint8_t CV::cv_dirty_ = 0xff;
+uint8_t CV::glide_;
+uint16_t CV::cv_position_[kCVCount];
+uint16_t CV::cv_target_[kCVCount];
+int16_t CV::cv_increment_[kCVCount];
+uint16_t CV::cv_ramp_[kCVCount];
+uint16_t CV::cv_remainder_[kCVCount];
+uint16_t CV::cv_ticks_[kCVCount];
 int16_t CV::cv_tune_[128] = { 0 };
 /* </static> */
 
@@ -67,7 +74,37 @@ void CV::Init() {
 
 /* static */
 void CV::Tick() {
-  
+
+  // Advance the slews. Notes, CCs and LFOs may be sent from the clock ISR,
+  // which must not change a slew while it is updated.
+  uint8_t sreg = SREG;
+  cli();
+  for (uint8_t n = 0; n < kCVCount; n++) {
+    if (cv_ticks_[n] != 0xffff) {
+      ++cv_ticks_[n];
+    }
+    if (cv_ramp_[n]) {
+      uint16_t ramp = --cv_ramp_[n];
+      uint16_t position = cv_target_[n];
+      if (ramp) {
+        // The remainder of the distance is spread over the last ticks
+        int16_t increment = cv_increment_[n];
+        if (ramp < cv_remainder_[n]) {
+          increment+= increment < 0 ? -1 : 1;
+        }
+        position = cv_position_[n] + increment;
+      }
+      cv_position_[n] = position;
+      // Only changed values are written to the DACs
+      uint16_t value = position >> 4;
+      if (cv_value_[n] != value) {
+        cv_value_[n] = value;
+        cv_dirty_|= (1 << n);
+      }
+    }
+  }
+  SREG = sreg;
+
   if (!cv_dirty_)
     return;
 
@@ -121,12 +158,59 @@ void CV::Tick() {
   cv_dirty_ = 0;
 }
 
+/* static */
+void CV::Slew(uint8_t index, uint16_t value, uint16_t ticks) {
+  uint8_t sreg = SREG;
+  cli();
+
+  uint16_t target = value << 4;
+  uint16_t position = cv_position_[index];
+  uint16_t distance = target > position ? target - position : position - target;
+  cv_ticks_[index] = 0;
+
+  if (ticks > 1 && distance > 1) {
+    // Short distances move by one unit per tick and end early
+    if (ticks > distance) {
+      ticks = distance;
+    }
+    int16_t increment = distance / ticks;
+    cv_increment_[index] = target > position ? increment : -increment;
+    cv_remainder_[index] = distance - increment * ticks;
+    cv_target_[index] = target;
+    cv_ramp_[index] = ticks;
+  } else {
+    cv_position_[index] = target;
+    cv_ramp_[index] = 0;
+    if (cv_value_[index] != value) {
+      cv_value_[index] = value;
+      cv_dirty_|= (1 << index);
+    }
+  }
+
+  SREG = sreg;
+}
+
 /* static */
 void CV::SendMode(uint8_t mode, uint8_t value)
 {
   for (uint8_t n = 0; n < kCVCount; n++) {
     if (seq.cv_mode(n) == mode) {
-      set7F(n, value);
+      uint16_t ticks;
+      switch (mode) {
+        case CVMODE_VELO:
+          // Velocity must be settled when the gate opens
+          ticks = 0;
+          break;
+        case CVMODE_LFO1:
+        case CVMODE_LFO2:
+          // Interpolate over the interval between LFO updates
+          ticks = cv_ticks_[n] < kCVMaxInterpolationTicks ? cv_ticks_[n] : 0;
+          break;
+        default:
+          ticks = kCVSmoothTicks;
+          break;
+      }
+      Slew(n, value << 5, ticks);
     }
   }
 
@@ -142,7 +226,7 @@ void CV::SendNote(uint8_t value)
       int16_t dacvalue = ResourcesManager::Lookup<uint16_t, uint8_t>(note2dac, value) + cv_tune_[value];
       if (dacvalue < 0) dacvalue = 0; else
       if (dacvalue > 0x0fff) dacvalue = 0x0fff;
-      set(n, dacvalue);
+      Slew(n, dacvalue, glide_ ? kCVGlideTicks : 0);
     }
   }
 
@@ -157,7 +241,7 @@ void CV::SendPBnd(uint16_t value) {
       int16_t dacvalue = value >> 2;
       if (dacvalue < 0) dacvalue = 0; else
       if (dacvalue > 0x0fff) dacvalue = 0x0fff;
-      set(n, dacvalue);
+      Slew(n, dacvalue, kCVSmoothTicks);
     }
   }
 
@@ -236,7 +320,7 @@ void CV::LoadTune() {
 
   // Check if uninitialized and clear
   for (uint8_t n = 0; n < numbof(cv_tune_); n++) {
-    if (cv_tune_[n] != 0xffff)
+    if (static_cast<uint16_t>(cv_tune_[n]) != 0xffff)
       return;
   }
   ClearTune(); 
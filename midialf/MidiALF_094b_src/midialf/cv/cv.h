@@ -29,6 +29,11 @@ namespace midialf {
 
 static const int kCVCount = 4;
 
+// Slew durations, in CV::Tick calls (4.9KHz)
+static const uint16_t kCVGlideTicks = 245;  // 50ms
+static const uint16_t kCVSmoothTicks = 24;  // 5ms
+static const uint16_t kCVMaxInterpolationTicks = 4900;  // 1s
+
 class CV {
  public:
   CV() {}
@@ -36,16 +41,21 @@ class CV {
   static void Tick();
 
   static void set(uint8_t index, uint16_t value) {
-    if (cv_value_[index] != value) {
-      cv_value_[index] = value;
-      cv_dirty_|= (1 << index);
-    }
+    Slew(index, value, 0);
   }
 
   static void set7F(uint8_t index, uint8_t value) {
     set(index, value << 5);
   }
 
+  // Moves linearly to value in the given number of ticks
+  static void Slew(uint8_t index, uint16_t value, uint16_t ticks);
+
+  // Notes sent while set glide to their CV instead of jumping
+  static void set_glide(uint8_t glide) {
+    glide_ = glide;
+  }
+
   static uint16_t get(uint8_t index) {
     return cv_value_[index];
   }
@@ -90,6 +100,15 @@ private:
 
   static uint16_t cv_value_[kCVCount];
   static uint8_t cv_dirty_;
+  static uint8_t glide_;
+
+  // Slews run in 1/16 of DAC steps
+  static uint16_t cv_position_[kCVCount];
+  static uint16_t cv_target_[kCVCount];
+  static int16_t cv_increment_[kCVCount];
+  static uint16_t cv_ramp_[kCVCount];
+  static uint16_t cv_remainder_[kCVCount];
+  static uint16_t cv_ticks_[kCVCount];  // Since the last value was sent
   static int16_t cv_tune_[128];
 
   DISALLOW_COPY_AND_ASSIGN(CV);
@@ -70,7 +70,30 @@ uint8_t EventScheduler::Remove(uint8_t note, uint8_t velocity) {
 }
 
 /* static */
-void EventScheduler::Schedule(
+void EventScheduler::RemoveNoteOns() {
+  uint8_t current = root_ptr_;
+  while (current) {
+    if (entries_[current].velocity) {
+      entries_[current].note = kZombieSlot;
+    }
+    current = entries_[current].next;
+  }
+}
+
+/* static */
+uint8_t EventScheduler::NextNoteOn() {
+  uint8_t current = root_ptr_;
+  while (current) {
+    if (entries_[current].velocity && entries_[current].note != kZombieSlot) {
+      return entries_[current].when;
+    }
+    current = entries_[current].next;
+  }
+  return 0xff;
+}
+
+/* static */
+uint8_t EventScheduler::Schedule(
     uint8_t note,
     uint8_t velocity,
     uint8_t when,
@@ -85,7 +108,7 @@ void EventScheduler::Schedule(
   }
   
   if (!free_slot) {
-    return;  // Queue is full!
+    return 0;  // Queue is full!
   }
   ++size_;
   entries_[free_slot].note = note;
@@ -105,6 +128,7 @@ void EventScheduler::Schedule(
     entries_[free_slot].next = entries_[insert_position].next;
     entries_[insert_position].next = free_slot;
   }
+  return 1;
 }
 
 /* extern */
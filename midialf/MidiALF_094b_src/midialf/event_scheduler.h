@@ -25,7 +25,10 @@
 
 namespace midialf {
 
-static const uint8_t kEventSchedulerSize = 8;
+// Slot 0 is never used. Each of the 4 tracks can have several note offs
+// pending when the gate is longer than the step, and up to 7 notes and note
+// offs for the ratchets of a step.
+static const uint8_t kEventSchedulerSize = 32;
 
 static const uint8_t kFreeSlot = 0xff;
 static const uint8_t kZombieSlot = 0xfe;
@@ -44,18 +47,23 @@ class EventScheduler {
   
   static void Init();
   static void Tick();
-  static void Schedule(uint8_t note, uint8_t velocity, uint8_t when, uint8_t tag);
-  static void Schedule(uint8_t note, uint8_t velocity, uint8_t when) {
-    Schedule(note, velocity, when, 0);
+  // Returns 0 if the queue is full.
+  static uint8_t Schedule(uint8_t note, uint8_t velocity, uint8_t when, uint8_t tag);
+  static uint8_t Schedule(uint8_t note, uint8_t velocity, uint8_t when) {
+    return Schedule(note, velocity, when, 0);
   }
   static uint8_t Remove(uint8_t note, uint8_t velocity);
+  static void RemoveNoteOns();
+  // Ticks before the first note on is sent, 0xff when none is scheduled.
+  static uint8_t NextNoteOn();
   
   static inline const SchedulerEntry& entry(uint8_t address) {
     return entries_[address];
   }
-  static inline const uint8_t root() { return root_ptr_; }
-  static inline const uint8_t size() { return size_; }
-  static inline const uint8_t overflow() {
+  static inline uint8_t root() { return root_ptr_; }
+  static inline uint8_t size() { return size_; }
+  static inline uint8_t room() { return kEventSchedulerSize - 1 - size_; }
+  static inline uint8_t overflow() {
     return size() >= kEventSchedulerSize - 8;
   }
 
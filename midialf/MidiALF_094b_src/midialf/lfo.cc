@@ -22,6 +22,7 @@
 #include "midialf/lfo.h"
 #include "midialf/note_duration.h"
 #include "midialf/clock.h"
+#include "midialf/midi_handler.h"
 #include "midialf/seq.h"
 #include "midialf/ui.h"
 #ifdef ENABLE_CV_OUTPUT
@@ -44,10 +45,14 @@ Lfo lfo;
 /* <static> */
 uint8_t Lfo::resolution_ = kDefLfoResolution;
 LfoData Lfo::data_[kNumLfos];
+uint8_t Lfo::output_[kNumLfos];
 
 uint16_t Lfo::phase_[kNumLfos];
 uint16_t Lfo::phase_increment_[kNumLfos];
 
+uint16_t Lfo::sent_value_[kNumLfos];
+uint8_t Lfo::budget_[kNumLfos];
+
 uint8_t Lfo::tick_;
 uint8_t Lfo::midi_clock_prescaler_;
 uint8_t Lfo::running_;
@@ -104,16 +109,23 @@ void Lfo::Start() {
   tick_ = midi_clock_prescaler_ - 1;
   running_ = 1;
 
-  // Sync lfos
+  // Sync lfos and make sure first values get sent
   for (uint8_t i = 0; i < kNumLfos; ++i) {
     if (data_[i].sync == LFO_SYNC_START) {
       phase_[i] = 0;
     }
+    sent_value_[i] = 0xffff;
+    budget_[i] = kLfoBudgetMax;
   }
 }
 
 /* static */
 void Lfo::Tick() {
+  // Refill MIDI byte budgets
+  for (uint8_t i = 0; i < kNumLfos; ++i) {
+    budget_[i] = U8AddClip(budget_[i], kLfoBudgetPerTick, kLfoBudgetMax);
+  }
+
   ++tick_;
   if (tick_ >= midi_clock_prescaler_) {
     tick_ = 0;
@@ -137,28 +149,41 @@ void Lfo::Tick() {
           skip = 1;
         }
       } else {
-        uint16_t offset = U8U8Mul(data_[i].waveform - 1, 129);
-        value = InterpolateSample(
-            wav_res_lfo_waveforms + offset,
-            phase_[i] >> 1);
+        // Waveforms are stored folded and/or as deltas, decode them on the
+        // fly. Delta blocks cost a nibble per sample up to the one read, see
+        // tools/resources_test for the worst case.
+        uint8_t mode;
+        const prog_uint8_t* waveform = ResourcesManager::LookupBlock(
+            wav_res_lfo_waveforms, wav_res_lfo_waveforms_blocks,
+            data_[i].waveform - 1, &mode);
+        uint16_t phase = phase_[i] >> 1;
+        if (mode == BLOCK_RAW) {
+          value = InterpolateSample(waveform, phase);
+        } else {
+          uint8_t a, b;
+          ResourcesManager::LookupPair<kLfoWaveformHalf>(
+              waveform, mode, phase >> 8, &a, &b);
+          value = U8Mix(a, b, phase & 0xff);
+        }
       }
 
       phase_[i] += phase_increment_[i];
 
       if (!skip) {
+        int16_t modulation = S8S8Mul((data_[i].amount - 63) << 1, value - 128);
         int16_t scaled_value = static_cast<int16_t>(data_[i].center) + 
-            S8S8MulShift8((data_[i].amount - 63) << 1, value - 128);
+            (modulation >> 8);
         scaled_value = Clip(scaled_value, 0, 127);
 #ifdef MIDIOUT_DEBUG_OUTPUT  
         //printf("Lfo::Tick: scaled_value=%d\n", scaled_value);
 #endif
         if (data_[i].cc_number) {
-          seq.Send3(
-              0xb0 | seq.channel(),
-              data_[i].cc_number,
-              scaled_value & 0x7f);
+          int16_t hires_value = (static_cast<int16_t>(data_[i].center) << 7) +
+              (modulation >> 1);
+          SendCC(i, Clip(hires_value, 0, 0x3fff));
         }
 #ifdef ENABLE_CV_OUTPUT
+        // CVs are updated at full rate, the DAC is only written on change
         switch (i) {
           case 0: cv.SendLFO1(scaled_value & 0x7f); break;
           case 1: cv.SendLFO2(scaled_value & 0x7f); break;
@@ -169,6 +194,52 @@ void Lfo::Tick() {
   }
 }
 
+/* static */
+void Lfo::SendCC(uint8_t lfo, uint16_t value) {
+  // Leave the output buffer to notes when it is congested, the value is
+  // still pending and will be sent on a later tick
+  if (MidiHandler::OutputBuffer::writable() < kLfoMinOutputSpace)
+    return;
+
+  uint8_t status = 0xb0 | seq.channel();
+  uint8_t cc_number = data_[lfo].cc_number;
+  uint16_t sent_value = sent_value_[lfo];
+  uint8_t msb = value >> 7;
+
+  // Send 14-bit CC pairs when the budget allows, LSB only if MSB is unchanged
+  if (output_[lfo] == kLfoOutputHiRes && cc_number < 32) {
+    if (value == sent_value)
+      return;
+    uint8_t send_msb = sent_value == 0xffff || msb != (sent_value >> 7);
+    uint8_t size = send_msb ? 6 : 3;
+    if (budget_[lfo] >= size) {
+      if (send_msb) {
+        seq.Send3(status, cc_number, msb);
+      }
+      seq.Send3(status, cc_number + 32, value & 0x7f);
+      budget_[lfo] -= size;
+      sent_value_[lfo] = value;
+      return;
+    }
+  }
+
+  // Otherwise send 7-bit CC if outside of the deadband
+  if (sent_value != 0xffff) {
+    uint8_t sent_msb = sent_value >> 7;
+    uint8_t delta = msb > sent_msb ? msb - sent_msb : sent_msb - msb;
+    uint8_t deadband = output_[lfo] == kLfoOutputHiRes ? 0 : output_[lfo];
+    if (delta <= deadband)
+      return;
+  }
+
+  if (budget_[lfo] < 3)
+    return;
+
+  seq.Send3(status, cc_number, msb);
+  budget_[lfo] -= 3;
+  sent_value_[lfo] = msb << 7;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Save/Load lfo info rroutines
 
@@ -181,6 +252,10 @@ uint16_t Lfo::CalcCrc16(uint16_t crc16) {
     crc16 = _crc16_update(crc16, *p++);
   }
 
+  for (uint8_t i = 0; i < kNumLfos; ++i) {
+    crc16 = _crc16_update(crc16, output_[i]);
+  }
+
   return crc16;
 }
 
@@ -188,6 +263,7 @@ uint16_t Lfo::CalcCrc16(uint16_t crc16) {
 void Lfo::SaveLfoInfo(SeqInfo& info) {
   info.lfo_resolution_ = resolution_;
   memcpy(info.lfo_data_, data_, sizeof(info.lfo_data_));
+  memcpy(info.lfo_output_, output_, sizeof(info.lfo_output_));
 }
 
 /* static */
@@ -207,6 +283,10 @@ void Lfo::LoadLfoInfo(const SeqInfo& info) {
   data_[1].waveform = Verify(info.lfo_data_[1].waveform, 0, kNumLfoWaveforms - 1, kDefLfo2Waveform);
   data_[1].rate = Verify(info.lfo_data_[1].rate, 0, kNumLfoRates - 1, kDefLfo2Rate);
   data_[1].sync = Verify(info.lfo_data_[1].sync, 0, LFO_SYNC_START, kDefLfo2Sync);
+
+  for (uint8_t i = 0; i < kNumLfos; ++i) {
+    set_output(i, Verify(info.lfo_output_[i], 0, kMaxLfoOutput, kDefLfoOutput));
+  }
 }
 
 /* static */
@@ -65,8 +65,21 @@ const uint8_t kDefLfo2Rate = 3;  // 1 Bar
 const uint8_t kDefLfo2Sync = LFO_SYNC_FREE_RUNNING;
 
 const uint8_t kNumLfoWaveforms = 19;
+const uint8_t kLfoWaveformHalf = (WAV_RES_LFO_WAVEFORMS_BLOCK_SIZE - 1) / 2;
 const uint8_t kNumLfoRates = 18;
 
+// LFO CC output: 7-bit CC with a deadband of 0..7, or 14-bit CC pairs
+const uint8_t kLfoOutputHiRes = 8;
+const uint8_t kMaxLfoOutput = kLfoOutputHiRes;
+const uint8_t kDefLfoOutput = 0;
+
+// Per LFO MIDI byte budget, refilled on every MIDI clock tick
+const uint8_t kLfoBudgetPerTick = 2;  // 48 bytes per beat
+const uint8_t kLfoBudgetMax = 12;
+
+// Free output buffer space below which LFO CCs yield to notes
+const uint8_t kLfoMinOutputSpace = 32;
+
 class SeqInfo;
 
 class Lfo {
@@ -107,14 +120,23 @@ class Lfo {
   static void set_rate(uint8_t lfo, uint8_t value) { data_[lfo].rate = value; UpdatePrescaler(); }
   static void set_sync(uint8_t lfo, uint8_t value) { data_[lfo].sync = value; }
 
+  static uint8_t output(uint8_t lfo) { return output_[lfo]; }
+  static void set_output(uint8_t lfo, uint8_t value) { output_[lfo] = value; sent_value_[lfo] = 0xffff; }
+
  private:
   static uint8_t Verify(uint8_t value, uint8_t min, uint8_t max, uint8_t def);
 
+  static void SendCC(uint8_t lfo, uint16_t value);
+
   static uint8_t resolution_;
   static LfoData data_[kNumLfos];
+  static uint8_t output_[kNumLfos];
 
   static uint16_t phase_[kNumLfos];
   static uint16_t phase_increment_[kNumLfos];
+
+  static uint16_t sent_value_[kNumLfos];
+  static uint8_t budget_[kNumLfos];
   
   static uint8_t tick_;
   static uint8_t midi_clock_prescaler_;
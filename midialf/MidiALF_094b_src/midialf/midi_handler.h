@@ -89,6 +89,10 @@ struct MidiHandler : public midi::MidiDevice {
     seq.OnStop();
   }
   
+  static void SongPosition(uint16_t position) {
+    seq.OnSongPosition(position);
+  }
+  
   static uint8_t CheckChannel(uint8_t channel) {
     return seq.CheckChannel(channel);
   }
@@ -108,14 +108,26 @@ inline void PollMidiIn() {
 
 inline void SendMidiOut() {
 #ifndef MIDIOUT_DEBUG_OUTPUT  
-  // Send midi output
-  if (MidiHandler::OutputBuffer::readable() && midi_io.writable()) {
-    uint8_t byte = MidiHandler::OutputBuffer::ImmediateRead();
+  // Send midi output. The SysEx blocks go between the other messages, which
+  // wait while a block is open. The rest of an aborted block is dropped.
+  if (!midi_io.writable())
+    return;
+  uint8_t byte;
+  if (MidiHandler::OutputBuffer::readable() && !SysExHandler::block_open()) {
+    byte = MidiHandler::OutputBuffer::ImmediateRead();
+  } else
+  if (SysExHandler::OutputBuffer::readable()) {
+    if (SysExHandler::block_aborted()) {
+      SysExHandler::OutputBuffer::ImmediateRead();
+      return;
+    }
+    byte = SysExHandler::ReadOutput();
+  } else
+    return;
 #ifndef ENABLE_CV_OUTPUT
-    if (byte != 0xf8) midiOutLed.On();
+  if (byte != 0xf8) midiOutLed.On();
 #endif
-    midi_io.Overwrite(byte);
-  }
+  midi_io.Overwrite(byte);
 #endif
 }
 
@@ -213,5 +225,6 @@ int main(void) {
 
   while (1) {
     ui.DoEvents();
+    sysex_handler.Poll();
   }
 }
@@ -71,6 +71,9 @@ static const uint8_t kDefStrobeWidth = 0;
 static const uint8_t kMinStrobeWidth = 0;
 static const uint8_t kMaxStrobeWidth = 4;
 
+static const uint8_t kDefRecordLatency = 0;  // ms
+static const uint8_t kMaxRecordLatency = 99;
+
 static const uint8_t kDefSeqSwitchMode = SEQ_SWITCH_MODE_IMMEDIATE;
 
 static const uint8_t kMinNameChar = ' ';
@@ -63,7 +63,7 @@ class NoteStack {
     // In case of saturation, remove the least recently played note from the
     // stack.
     if (size_ == capacity) {
-      uint8_t least_recent_note;
+      uint8_t least_recent_note = 0;
       for (uint8_t i = 1; i <= capacity; ++i) {
         if (pool_[i].next_ptr == 0) {
           least_recent_note = pool_[i].note;
@@ -72,7 +72,7 @@ class NoteStack {
       NoteOff(least_recent_note);
     }
     // Now we are ready to insert the new note. Find a free slot to insert it.
-    uint8_t free_slot;
+    uint8_t free_slot = 1;
     for (uint8_t i = 1; i <= capacity; ++i) {
       if (pool_[i].note == kFreeSlot) {
         free_slot = i;
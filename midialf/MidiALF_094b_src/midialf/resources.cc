@@ -21,7 +21,7 @@
 // make resources
 
 
-#include "midialf\resources.h"
+#include "midialf/resources.h"
 
 namespace midialf {
 
@@ -52,28 +52,28 @@ const prog_uint16_t lut_res_drum_patterns[] PROGMEM = {
    61456,  42116,   4168,  16657,   5193,  21845,  22616,  25253,
 };
 const prog_uint16_t lut_res_groove_swing[] PROGMEM = {
-     127,    127,   -127,   -127,    127,    127,   -127,   -127,
-     127,    127,   -127,   -127,    127,    127,   -127,   -127,
+     127,    127,  65409,  65409,    127,    127,  65409,  65409,
+     127,    127,  65409,  65409,    127,    127,  65409,  65409,
 };
 const prog_uint16_t lut_res_groove_shuffle[] PROGMEM = {
-     127,   -127,    127,   -127,    127,   -127,    127,   -127,
-     127,   -127,    127,   -127,    127,   -127,    127,   -127,
+     127,  65409,    127,  65409,    127,  65409,    127,  65409,
+     127,  65409,    127,  65409,    127,  65409,    127,  65409,
 };
 const prog_uint16_t lut_res_groove_push[] PROGMEM = {
-     -63,    -63,    127,      0,   -127,      0,      0,     88,
-       0,      0,     88,    -50,    -88,      0,     88,      0,
+   65473,  65473,    127,      0,  65409,      0,      0,     88,
+       0,      0,     88,  65486,  65448,      0,     88,      0,
 };
 const prog_uint16_t lut_res_groove_lag[] PROGMEM = {
-      19,     44,     93,     -4,     32,    -53,    -90,   -127,
-     117,     32,   -102,    -53,    105,    -53,     93,    -53,
+      19,     44,     93,  65532,     32,  65483,  65446,  65409,
+     117,     32,  65434,  65483,    105,  65483,     93,  65483,
 };
 const prog_uint16_t lut_res_groove_human[] PROGMEM = {
-      88,   -101,    107,    -95,     88,    -88,     50,    -38,
-      65,    -88,    101,    -95,    101,   -127,     63,    -31,
+      88,  65435,    107,  65441,     88,  65448,     50,  65498,
+      65,  65448,    101,  65441,    101,  65409,     63,  65505,
 };
 const prog_uint16_t lut_res_groove_monkey[] PROGMEM = {
-      70,    -84,     84,   -112,     84,    -98,    112,    -98,
-      54,    -70,    127,    -84,    127,   -112,     84,    -84,
+      70,  65452,     84,  65424,     84,  65438,    112,  65438,
+      54,  65466,    127,  65452,    127,  65424,     84,  65452,
 };
 const prog_uint16_t lut_res_euclidian_patterns[] PROGMEM = {
        0,      1,      3,      7,     15,     63,    127,    255,
@@ -138,287 +138,492 @@ const prog_uint8_t* character_table[] = {
 };
 
 const prog_uint8_t wav_res_lfo_waveforms[] PROGMEM = {
-       1,      5,      9,     13,     17,     21,     25,     29,
-      33,     37,     41,     44,     48,     52,     56,     60,
-      64,     68,     72,     76,     80,     84,     88,     92,
-      96,    100,    104,    108,    112,    116,    120,    124,
-     128,    131,    135,    139,    143,    147,    151,    155,
-     159,    163,    167,    171,    175,    179,    183,    187,
-     191,    195,    199,    203,    207,    211,    214,    218,
-     222,    226,    230,    234,    238,    242,    246,    250,
-     254,    250,    246,    242,    238,    234,    230,    226,
-     222,    218,    214,    211,    207,    203,    199,    195,
-     191,    187,    183,    179,    175,    171,    167,    163,
-     159,    155,    151,    147,    143,    139,    135,    131,
-     128,    124,    120,    116,    112,    108,    104,    100,
-      96,     92,     88,     84,     80,     76,     72,     68,
-      64,     60,     56,     52,     48,     44,     41,     37,
-      33,     29,     25,     21,     17,     13,      9,      5,
-       1,    254,    254,    254,    254,    254,    254,    254,
-     254,    254,    254,    254,    254,    254,    254,    254,
-     254,    254,    254,    254,    254,    254,    254,    254,
-     254,    254,    254,    254,    254,    254,    254,    254,
-     254,    254,    254,    254,    254,    254,    254,    254,
-     254,    254,    254,    254,    254,    254,    254,    254,
-     254,    254,    254,    254,    254,    254,    254,    254,
-     254,    254,    254,    254,    254,    254,    254,    254,
-     254,      1,      1,      1,      1,      1,      1,      1,
+       1,     68,     68,     68,     68,     68,     52,     68,
+      68,     68,     68,     68,     68,     68,     68,     68,
+      68,     52,     68,     68,     68,     68,     68,     68,
+      68,     68,     68,     67,     68,     68,     68,     68,
+      68,    254,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      8,      1,      1,     34,     34,     34,     34,
+      34,     34,     34,     34,     34,     34,     34,     34,
+      34,     34,     34,     34,     34,     34,     34,     34,
+      34,     34,     34,     34,     34,     34,     34,     34,
+      34,     34,     34,     33,     34,     34,     34,     34,
+      34,     34,     34,     34,     34,     34,     34,     34,
+      34,     34,     34,     34,     34,     34,     34,     34,
+      34,     34,     34,     34,     34,     34,     34,     34,
+      34,     34,     34,     40,      1,    128,    102,    102,
+     102,    102,    101,    101,     85,     69,     68,     68,
+      51,     50,     50,     18,     16,     16,     15,     15,
+     239,    237,    237,    221,    204,    204,    188,    187,
+     186,    186,    170,    170,    170,    170,    128,    136,
+     168,    148,    137,    216,    167,    139,     24,    186,
+     140,     40,    203,    120,    218,    102,    101,     67,
+      49,     32,     15,    238,    221,    203,    202,    186,
+     170,    170,    154,    170,    186,    187,    204,    205,
+     222,    239,    255,      0,      1,     17,     33,     34,
+     128,    143,    158,    172,    186,    199,    211,    222,
+     231,    239,    245,    250,    253,    254,    254,    252,
+     249,    244,    239,    232,    225,    217,    209,    201,
+     194,    186,    179,    173,    168,    163,    160,    158,
+     158,    158,    160,    163,    168,    173,    179,    186,
+     194,    201,    209,    217,    225,    232,    239,    244,
+     249,    252,    254,    254,    253,    250,    245,    239,
+     231,    222,    211,    199,    186,    172,    158,    143,
+     128,    128,    144,    159,    173,    185,    195,    201,
+     204,    204,    201,    196,    188,    179,    169,    160,
+     151,    143,    138,    135,    135,    138,    144,    153,
+     164,    176,    190,    204,    217,    229,    240,    247,
+     252,    254,    252,    247,    240,    229,    217,    204,
+     190,    176,    164,    153,    144,    138,    135,    135,
+     138,    143,    151,    160,    169,    179,    188,    196,
+     201,    204,    204,    201,    195,    185,    173,    159,
+     144,    128,      1,      1,      1,      3,      5,      8,
+      13,     19,     27,     37,     49,     62,     77,     93,
+     110,    128,    145,    163,    180,    196,    211,    224,
+     235,    243,    250,    253,    254,    252,    248,    241,
+     231,    220,    206,    191,    176,    159,    142,    125,
+     108,     92,     76,     62,     49,     37,     27,     19,
+      12,      6,      2,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
+       1,      1,      1,      1,      1,      1,      2,      2,
+       3,      3,      4,      5,      6,      7,      7,      6,
+       5,      3,      1,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
+       1,      1,      1,      1,      1,      2,      5,      9,
+      17,     27,     41,     58,     77,     99,    122,    146,
+     169,    191,    211,    228,    241,    250,    254,    254,
+     249,    240,    227,    212,    196,    178,    161,    146,
+     133,    123,    116,    114,    116,    123,    133,    146,
+     161,    178,    196,    212,    227,    240,    249,    254,
+     254,    250,    241,    228,    211,    191,    169,    146,
+     122,     99,     77,     58,     41,     27,     17,      9,
+       5,      2,      1,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
-       1,    254,      1,      3,      5,      7,      9,     11,
-      13,     15,     17,     19,     21,     23,     25,     27,
-      29,     31,     33,     35,     37,     39,     41,     43,
-      45,     47,     49,     51,     53,     55,     57,     59,
-      61,     63,     65,     67,     69,     71,     73,     75,
-      77,     79,     81,     83,     85,     87,     89,     91,
-      93,     95,     97,     99,    101,    103,    105,    107,
-     109,    111,    113,    115,    117,    119,    121,    123,
-     125,    127,    128,    130,    132,    134,    136,    138,
-     140,    142,    144,    146,    148,    150,    152,    154,
-     156,    158,    160,    162,    164,    166,    168,    170,
-     172,    174,    176,    178,    180,    182,    184,    186,
-     188,    190,    192,    194,    196,    198,    200,    202,
-     204,    206,    208,    210,    212,    214,    216,    218,
-     220,    222,    224,    226,    228,    230,    232,    234,
-     236,    238,    240,    242,    244,    246,    248,    250,
-     252,    254,      1,    128,    134,    140,    146,    152,
-     158,    164,    170,    176,    182,    187,    193,    198,
-     203,    208,    212,    217,    221,    225,    229,    233,
-     236,    239,    242,    244,    247,    249,    250,    252,
-     253,    253,    254,    254,    254,    253,    253,    252,
-     250,    249,    247,    244,    242,    239,    236,    233,
-     229,    225,    221,    217,    212,    208,    203,    198,
-     193,    187,    182,    176,    170,    164,    158,    152,
-     146,    140,    134,    128,    121,    115,    109,    103,
-      97,     91,     85,     79,     73,     68,     62,     57,
-      52,     47,     43,     38,     34,     30,     26,     22,
-      19,     16,     13,     11,      8,      6,      5,      3,
-       2,      2,      1,      1,      1,      2,      2,      3,
-       5,      6,      8,     11,     13,     16,     19,     22,
-      26,     30,     34,     38,     43,     47,     52,     57,
-      62,     68,     73,     79,     85,     91,     97,    103,
-     109,    115,    121,    128,    128,    138,    148,    157,
-     167,    177,    186,    194,    203,    210,    218,    224,
-     230,    236,    241,    245,    248,    251,    252,    254,
-     254,    254,    253,    251,    249,    246,    243,    239,
-     234,    230,    224,    219,    213,    207,    201,    195,
-     189,    182,    176,    170,    164,    159,    153,    148,
-     143,    139,    135,    131,    128,    125,    123,    121,
-     120,    119,    118,    118,    118,    118,    119,    120,
-     121,    123,    124,    126,    128,    129,    131,    132,
-     134,    135,    136,    137,    137,    137,    137,    136,
-     135,    134,    132,    130,    127,    124,    120,    116,
-     112,    107,    102,     96,     91,     85,     79,     73,
-      66,     60,     54,     48,     42,     36,     31,     25,
-      21,     16,     12,      9,      6,      4,      2,      1,
-       1,      1,      3,      4,      7,     10,     14,     19,
-      25,     31,     37,     45,     52,     61,     69,     78,
-      88,     98,    107,    117,    128,    128,    143,    158,
-     172,    186,    199,    211,    222,    231,    239,    245,
-     250,    253,    254,    254,    252,    249,    244,    239,
-     232,    225,    217,    209,    201,    194,    186,    179,
-     173,    168,    163,    160,    158,    158,    158,    160,
-     163,    168,    173,    179,    186,    194,    201,    209,
-     217,    225,    232,    239,    244,    249,    252,    254,
-     254,    253,    250,    245,    239,    231,    222,    211,
-     199,    186,    172,    158,    143,    128,    112,     97,
-      83,     69,     56,     44,     33,     24,     16,     10,
-       5,      2,      1,      1,      3,      6,     11,     16,
-      23,     30,     38,     46,     54,     61,     69,     76,
-      82,     87,     92,     95,     97,     97,     97,     95,
-      92,     87,     82,     76,     69,     61,     54,     46,
-      38,     30,     23,     16,     11,      6,      3,      1,
-       1,      2,      5,     10,     16,     24,     33,     44,
-      56,     69,     83,     97,    112,    128,    128,    144,
-     159,    173,    185,    195,    201,    204,    204,    201,
-     196,    188,    179,    169,    160,    151,    143,    138,
-     135,    135,    138,    144,    153,    164,    176,    190,
-     204,    217,    229,    240,    247,    252,    254,    252,
-     247,    240,    229,    217,    204,    190,    176,    164,
-     153,    144,    138,    135,    135,    138,    143,    151,
-     160,    169,    179,    188,    196,    201,    204,    204,
-     201,    195,    185,    173,    159,    144,    128,    111,
-      96,     82,     70,     60,     54,     51,     51,     54,
-      59,     67,     76,     86,     95,    104,    112,    117,
-     120,    120,    117,    111,    102,     91,     79,     65,
-      51,     38,     26,     15,      8,      3,      1,      3,
-       8,     15,     26,     38,     51,     65,     79,     91,
-     102,    111,    117,    120,    120,    117,    112,    104,
-      95,     86,     76,     67,     59,     54,     51,     51,
-      54,     60,     70,     82,     96,    111,    128,      1,
-       1,      1,      3,      5,      8,     13,     19,     27,
-      37,     49,     62,     77,     93,    110,    128,    145,
-     163,    180,    196,    211,    224,    235,    243,    250,
-     253,    254,    252,    248,    241,    231,    220,    206,
-     191,    176,    159,    142,    125,    108,     92,     76,
-      62,     49,     37,     27,     19,     12,      6,      2,
        1,      1,      1,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      1,      2,      2,      3,      3,      4,
-       5,      6,      7,      7,      6,      5,      3,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
        1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      2,      5,      9,     17,     27,     41,
-      58,     77,     99,    122,    146,    169,    191,    211,
-     228,    241,    250,    254,    254,    249,    240,    227,
-     212,    196,    178,    161,    146,    133,    123,    116,
-     114,    116,    123,    133,    146,    161,    178,    196,
-     212,    227,    240,    249,    254,    254,    250,    241,
-     228,    211,    191,    169,    146,    122,     99,     77,
-      58,     41,     27,     17,      9,      5,      2,      1,
-       1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      1,      1,      1,      1,      1,      1,
-       1,      1,      1,      1,      1,      1,      1,      1,
-       1,     63,     57,     51,     45,     39,     33,     27,
-      21,     15,      9,      3,      1,      7,     13,     19,
-      25,     31,     37,     43,     49,     55,     61,     67,
-      73,     79,     85,     91,     97,    103,    109,    115,
-     121,    128,    134,    140,    146,    152,    158,    164,
-     170,    176,    182,    188,    194,    200,    206,    212,
-     218,    224,    230,    236,    242,    248,    254,    252,
-     246,    240,    234,    228,    222,    216,    210,    204,
-     198,    192,    198,    204,    210,    216,    222,    228,
-     234,    240,    246,    252,    254,    248,    242,    236,
-     230,    224,    218,    212,    206,    200,    194,    188,
-     182,    176,    170,    164,    158,    152,    146,    140,
-     134,    128,    121,    115,    109,    103,     97,     91,
-      85,     79,     73,     67,     61,     55,     49,     43,
-      37,     31,     25,     19,     13,      7,      1,      3,
-       9,     15,     21,     27,     33,     39,     45,     51,
-      57,     63,    128,    120,    112,    104,     96,     88,
-      80,     72,     64,     56,     48,     41,     33,     25,
-      17,      9,      1,      9,     17,     25,     33,     41,
-      48,     56,     64,     72,     80,     88,     96,    104,
-     112,    120,    128,    135,    143,    151,    159,    167,
-     175,    183,    191,    199,    207,    214,    222,    230,
-     238,    246,    254,    246,    238,    230,    222,    214,
-     207,    199,    191,    183,    175,    167,    159,    151,
-     143,    135,    128,    135,    143,    151,    159,    167,
-     175,    183,    191,    199,    207,    214,    222,    230,
-     238,    246,    254,    246,    238,    230,    222,    214,
-     207,    199,    191,    183,    175,    167,    159,    151,
-     143,    135,    128,    120,    112,    104,     96,     88,
-      80,     72,     64,     56,     48,     41,     33,     25,
-      17,      9,      1,      9,     17,     25,     33,     41,
-      48,     56,     64,     72,     80,     88,     96,    104,
-     112,    120,    128,      1,      2,      3,      3,      4,
-       5,      6,      7,      8,      9,     10,     11,     12,
-      14,     15,     16,     18,     19,     21,     23,     24,
-      26,     28,     30,     32,     34,     36,     38,     41,
-      43,     46,     49,     52,     55,     58,     61,     64,
-      68,     72,     76,     80,     84,     88,     93,     98,
-     103,    108,    113,    119,    125,    131,    138,    145,
-     152,    159,    167,    175,    183,    192,    201,    211,
-     221,    232,    243,    254,    243,    232,    221,    211,
-     201,    192,    183,    175,    167,    159,    152,    145,
-     138,    131,    125,    119,    113,    108,    103,     98,
-      93,     88,     84,     80,     76,     72,     68,     64,
-      61,     58,     55,     52,     49,     46,     43,     41,
-      38,     36,     34,     32,     30,     28,     26,     24,
-      23,     21,     19,     18,     16,     15,     14,     12,
-      11,     10,      9,      8,      7,      6,      5,      4,
-       3,      3,      2,      1,      1,     12,     22,     32,
-      41,     48,     56,     62,     68,     74,     79,     84,
-      88,     92,     96,     99,    102,    105,    108,    110,
-     112,    114,    116,    118,    119,    120,    122,    123,
-     124,    125,    126,    127,    128,    128,    129,    130,
-     131,    132,    133,    135,    136,    137,    139,    141,
-     143,    145,    147,    150,    153,    156,    159,    163,
-     167,    171,    176,    181,    187,    193,    199,    207,
-     214,    223,    233,    243,    254,    243,    233,    223,
-     214,    207,    199,    193,    187,    181,    176,    171,
-     167,    163,    159,    156,    153,    150,    147,    145,
-     143,    141,    139,    137,    136,    135,    133,    132,
-     131,    130,    129,    128,    128,    127,    126,    125,
-     124,    123,    122,    120,    119,    118,    116,    114,
-     112,    110,    108,    105,    102,     99,     96,     92,
-      88,     84,     79,     74,     68,     62,     56,     48,
-      41,     32,     22,     12,      1,    229,    205,    184,
-     164,    147,    130,    116,    102,     90,     79,     69,
-      60,     51,     44,     38,     32,     26,     22,     18,
-      14,     11,      9,      7,      5,      4,      2,      2,
-       1,      1,      1,      1,      2,      2,      3,      4,
-       5,      6,      8,      9,     11,     13,     14,     16,
-      18,     20,     22,     25,     27,     29,     31,     34,
-      36,     39,     41,     44,     46,     49,     51,     54,
-      57,     59,     62,     65,     68,     70,     73,     76,
-      79,     82,     84,     87,     90,     93,     96,     99,
-     102,    104,    107,    110,    113,    116,    119,    122,
-     125,    128,    130,    133,    136,    139,    142,    145,
-     148,    151,    154,    157,    160,    163,    166,    169,
-     171,    174,    177,    180,    183,    186,    189,    192,
-     195,    198,    201,    204,    207,    210,    213,    216,
-     219,    222,    225,    227,    230,    233,    236,    239,
-     242,    245,    248,    251,    254,    229,     20,     38,
-      54,     69,     83,     96,    108,    119,    130,    139,
-     148,    156,    163,    170,    177,    183,    188,    193,
-     198,    202,    206,    210,    213,    217,    220,    222,
-     225,    227,    229,    231,    233,    235,    236,    238,
-     239,    240,    242,    243,    244,    245,    245,    246,
-     247,    248,    248,    249,    249,    250,    250,    251,
-     251,    251,    252,    252,    252,    253,    253,    253,
-     253,    253,    254,    254,    254,    254,    235,    217,
-     201,    186,    172,    159,    147,    136,    125,    116,
-     107,     99,     92,     85,     78,     72,     67,     62,
-      57,     53,     49,     45,     42,     38,     35,     33,
-      30,     28,     26,     24,     22,     20,     19,     17,
-      16,     15,     13,     12,     11,     10,     10,      9,
-       8,      7,      7,      6,      6,      5,      5,      4,
-       4,      4,      3,      3,      3,      2,      2,      2,
-       2,      2,      1,      1,      1,      1,     20,    254,
-     230,    189,    139,     88,     45,     15,      1,      2,
-      17,     41,     70,     99,    124,    142,    152,    153,
-     148,    137,    123,    110,     98,     91,     88,     89,
-      94,    102,    111,    121,    129,    135,    139,    140,
-     139,    137,    134,    131,    129,    128,    128,    129,
-     131,    135,    138,    142,    145,    148,    150,    151,
-     152,    152,    152,    153,    153,    153,    154,    156,
-     157,    159,    161,    163,    165,    167,    168,    170,
-     171,    172,    173,    174,    175,    176,    177,    179,
-     180,    182,    183,    185,    186,    188,    189,    190,
-     192,    193,    194,    195,    197,    198,    199,    200,
-     202,    203,    205,    206,    207,    209,    210,    211,
-     213,    214,    215,    217,    218,    219,    221,    222,
-     223,    225,    226,    227,    229,    230,    231,    233,
-     234,    235,    237,    238,    239,    241,    242,    243,
-     245,    246,    247,    249,    250,    251,    253,    254,
-      67,     85,    115,    152,    189,    221,    243,    254,
-     254,    244,    228,    208,    189,    172,    160,    154,
-     154,    159,    168,    178,    189,    198,    204,    207,
-     207,    205,    200,    194,    189,    184,    181,    179,
-     179,    180,    183,    186,    189,    191,    193,    194,
-     194,    193,    192,    190,    189,    187,    186,    186,
-     186,    186,    187,    188,    189,    190,    190,    190,
-     190,    190,    190,    189,    189,    188,    188,    188,
-     188,    170,    140,    103,     66,     34,     12,      1,
-       1,     11,     27,     47,     66,     83,     95,    101,
-     101,     96,     87,     77,     66,     57,     51,     48,
-      48,     50,     55,     61,     66,     71,     74,     76,
-      76,     75,     72,     69,     66,     64,     62,     61,
-      61,     62,     63,     65,     66,     68,     69,     69,
-      69,     69,     68,     67,     66,     65,     65,     65,
-      65,     65,     65,     66,     66,     67,     67,     67,
-      67,
+       1,      1,      1,      1,     63,    170,    170,    170,
+     170,    170,    230,    102,    102,    102,    102,    102,
+     102,    102,    102,    102,    103,    102,    102,    102,
+     102,    102,    102,    102,    102,    102,    102,    110,
+     170,    170,    170,    170,    170,    128,    120,    112,
+     104,     96,     88,     80,     72,     64,     56,     48,
+      41,     33,     25,     17,      9,      1,      9,     17,
+      25,     33,     41,     48,     56,     64,     72,     80,
+      88,     96,    104,    112,    120,    128,    135,    143,
+     151,    159,    167,    175,    183,    191,    199,    207,
+     214,    222,    230,    238,    246,    254,    246,    238,
+     230,    222,    214,    207,    199,    191,    183,    175,
+     167,    159,    151,    143,    135,    128,      1,     17,
+       1,     17,     17,     17,     17,     33,     18,     18,
+      33,     34,     34,     34,     35,     35,     51,     51,
+      51,     68,     68,     68,     85,     85,     86,    102,
+     119,    119,    138,    120,    175,    139,    120,    192,
+     140,    152,    211,    141,    216,    232,    143,     56,
+     254,      1,    128,    200,     22,    130,      8,     41,
+     120,     56,    102,    101,     84,     68,     51,     51,
+      34,     34,     33,     18,     17,     17,     17,      1,
+      17,     17,     33,     18,     34,     34,     51,     51,
+      68,     69,     86,    102,    140,    247,    141,    248,
+     233,    143,     56,    254,    229,    140,    216,    184,
+     138,     72,    147,    136,     40,    116,    134,    104,
+      90,    132,    248,     69,    131,    200,     51,    154,
+     170,    204,    205,    238,    239,    224,    240,      0,
+      16,     17,     17,     33,     34,     18,     34,     35,
+      34,     35,     35,     35,     35,     35,     50,     51,
+      50,     51,     51,     35,     51,     51,     50,     51,
+      51,     51,     51,     35,     51,     51,     51,     51,
+      51,     51,     35,     51,     51,     51,     51,     51,
+      51,     51,     51,     50,     51,     51,     51,     51,
+      56,    229,     20,     38,     54,     69,     83,     96,
+     108,    119,    130,    139,    148,    156,    163,    170,
+     177,    183,    188,    193,    198,    202,    206,    210,
+     213,    217,    220,    222,    225,    227,    229,    231,
+     233,    235,    236,    238,    239,    240,    242,    243,
+     244,    245,    245,    246,    247,    248,    248,    249,
+     249,    250,    250,    251,    251,    251,    252,    252,
+     252,    253,    253,    253,    253,    253,    254,    254,
+     254,    254,    235,    217,    201,    186,    172,    159,
+     147,    136,    125,    116,    107,     99,     92,     85,
+      78,     72,     67,     62,     57,     53,     49,     45,
+      42,     38,     35,     33,     30,     28,     26,     24,
+      22,     20,     19,     17,     16,     15,     13,     12,
+      11,     10,     10,      9,      8,      7,      7,      6,
+       6,      5,      5,      4,      4,      4,      3,      3,
+       3,      2,      2,      2,      2,      2,      1,      1,
+       1,      1,     20,    254,    230,    189,    139,     88,
+      45,     15,      1,      2,     17,     41,     70,     99,
+     124,    142,    152,    153,    148,    137,    123,    110,
+      98,     91,     88,     89,     94,    102,    111,    121,
+     129,    135,    139,    140,    139,    137,    134,    131,
+     129,    128,    128,    129,    131,    135,    138,    142,
+     145,    148,    150,    151,    152,    152,    152,    153,
+     153,    153,    154,    156,    157,    159,    161,    163,
+     165,    167,    168,    170,    171,    172,    173,    174,
+     175,    176,    177,    179,    180,    182,    183,    185,
+     186,    188,    189,    190,    192,    193,    194,    195,
+     197,    198,    199,    200,    202,    203,    205,    206,
+     207,    209,    210,    211,    213,    214,    215,    217,
+     218,    219,    221,    222,    223,    225,    226,    227,
+     229,    230,    231,    233,    234,    235,    237,    238,
+     239,    241,    242,    243,    245,    246,    247,    249,
+     250,    251,    253,    254,     67,     85,    115,    152,
+     189,    221,    243,    254,    254,    244,    228,    208,
+     189,    172,    160,    154,    154,    159,    168,    178,
+     189,    198,    204,    207,    207,    205,    200,    194,
+     189,    184,    181,    179,    179,    180,    183,    186,
+     189,    191,    193,    194,    194,    193,    192,    190,
+     189,    187,    186,    186,    186,    186,    187,    188,
+     189,    190,    190,    190,    190,    190,    190,    189,
+     189,    188,    188,    188,    188,    170,    140,    103,
+      66,     34,     12,      1,      1,     11,     27,     47,
+      66,     83,     95,    101,    101,     96,     87,     77,
+      66,     57,     51,     48,     48,     50,     55,     61,
+      66,     71,     74,     76,     76,     75,     72,     69,
+      66,     64,     62,     61,     61,     62,     63,     65,
+      66,     68,     69,     69,     69,     69,     68,     67,
+      66,     65,     65,     65,     65,     65,     65,     66,
+      66,     67,     67,     67,     67,
 };
+const prog_uint16_t wav_res_lfo_waveforms_blocks[] PROGMEM = {
+   40960,  49185,  32835,  49285,  49318,  16592,  16657,    338,
+     467,  41556,   8821,  41654,  41697,  33548,    858,    987,
+    1116,
+};
+
 
 
 const prog_uint8_t* waveform_table[] = {
   wav_res_lfo_waveforms,
 };
 
+const prog_uint8_t scale_name_dictionary[] PROGMEM = {
+       2,     77,     46,      5,     77,    105,    110,    111,
+     114,      6,     84,    104,    101,    116,     97,     44,
+      10,     68,    105,    109,    105,    110,    105,    115,
+     104,    101,    100,      5,     77,     97,    106,    111,
+     114,      4,     84,    111,    110,    101,      9,     72,
+     117,    110,    103,     97,    114,    105,     97,    110,
+       6,     76,    121,    100,    105,     97,    110,     10,
+      80,    101,    110,    116,     97,    116,    111,    110,
+     105,     99,      3,     40,     65,     41,      3,     40,
+      66,     41,      9,     65,    117,    103,    109,    101,
+     110,    116,    101,    100,      9,     65,    117,    120,
+     105,    108,    105,     97,    114,    121,      4,     72,
+      97,    108,    102,      7,     76,    111,     99,    114,
+     105,     97,    110,      5,     87,    104,    111,    108,
+     101,      9,     40,     76,    111,     99,    114,    105,
+      97,    110,     41,      1,     49,      1,     50,      1,
+      52,      7,     65,    114,     97,     98,    105,     97,
+     110,      5,     66,    108,    117,    101,    115,      7,
+      67,    104,    105,    110,    101,    115,    101,      3,
+      68,    105,    109,     11,     68,    105,    109,    105,
+     110,    105,    115,    104,    101,    100,     44,      8,
+      68,    111,    109,    105,    110,     97,    110,    116,
+       9,     69,    116,    104,    105,    111,    112,    105,
+      97,    110,      5,     71,    121,    112,    115,    121,
+       8,     72,     97,    114,    109,    111,    110,    105,
+      99,      6,     74,     97,    112,     97,    110,     46,
+       8,     74,     97,    112,     97,    110,    101,    115,
+     101,      6,     74,    101,    119,    105,    115,    104,
+      10,     78,    101,    111,    112,    111,    108,    105,
+     116,     97,    110,      9,     79,     99,    116,     97,
+     116,    111,    110,    105,     99,      8,     79,    114,
+     105,    101,    110,    116,     97,    108,      8,     79,
+     118,    101,    114,    116,    111,    110,    101,      7,
+      80,    101,    114,    115,    105,     97,    110,      7,
+      83,    112,     97,    110,    105,    115,    104,      5,
+      84,    104,    101,    116,     97,      2,     40,     65,
+       6,     40,     65,    104,     97,     98,     97,      5,
+      40,     72,     45,     87,     41,     13,     40,     73,
+      99,    104,    105,    107,    111,    115,    117,     99,
+     104,    111,     41,      6,     40,     77,     97,    103,
+     101,    110,     13,     40,     84,     97,    105,    115,
+     104,    105,    107,    105,     99,    104,    111,     41,
+       5,     40,     87,     45,     72,     41,      2,     49,
+      48,      2,     49,     49,      2,     49,     50,      2,
+      49,     51,      2,     49,     52,      2,     49,     54,
+       2,     49,     55,      2,     49,     56,      2,     49,
+      57,      2,     50,     48,      2,     50,     49,      2,
+      50,     50,      2,     50,     51,      2,     50,     52,
+       2,     50,     53,      2,     50,     54,      2,     50,
+      55,      2,     50,     56,      1,     51,      2,     51,
+      48,      2,     51,     49,      2,     51,     50,      2,
+      51,     51,      2,     51,     52,      2,     51,     53,
+       2,     51,     54,      2,     51,     55,      2,     51,
+      56,      2,     51,     57,      2,     52,     48,      2,
+      52,     49,      2,     52,     50,      2,     52,     51,
+       2,     52,     52,      2,     52,     55,      2,     52,
+      56,      2,     52,     57,      1,     53,      2,     53,
+      48,      2,     53,     49,      2,     53,     50,      2,
+      53,     51,      2,     53,     52,      2,     53,     53,
+       2,     53,     54,      2,     53,     56,      2,     53,
+      57,      1,     54,      2,     54,     48,      2,     54,
+      49,      2,     54,     50,      2,     54,     51,      2,
+      54,     52,      2,     54,     53,      2,     54,     54,
+       2,     54,     55,      2,     54,     56,      2,     54,
+      57,      1,     55,      2,     55,     48,      2,     55,
+      49,      2,     55,     50,      3,     55,    116,    104,
+       1,     56,      1,     57,      5,     65,     98,    111,
+     116,     41,      7,     65,    101,    111,    108,    105,
+      97,    110,      8,     65,    108,    103,    101,    114,
+     105,     97,    110,      7,     65,    115,     97,    118,
+      97,    114,    105,      8,     66,     97,    108,    105,
+     110,    101,    115,    101,      7,     66,    104,     97,
+     105,    114,     97,    118,      8,     66,    104,     97,
+     105,    114,     97,    118,    105,     10,     66,    104,
+      97,    118,     97,    112,    114,    105,    121,     97,
+       7,     66,    105,    108,     97,    118,     97,    108,
+       9,     66,    121,    122,     97,    110,    116,    105,
+     110,    101,     11,     67,    104,     97,    107,    114,
+      97,    118,     97,    107,     97,    109,      9,     67,
+     104,     97,    108,     97,    110,     97,    116,     97,
+       9,     67,    104,     97,    114,    117,    107,    101,
+     115,    105,     11,     67,    104,    105,    116,    114,
+      97,    109,     98,     97,    114,    105,      9,     67,
+     104,    114,    111,    109,     97,    116,    105,     99,
+      10,     68,    104,     97,    114,    109,     97,    118,
+      97,    116,    105,     13,     68,    104,     97,    116,
+     117,    118,     97,    114,    100,    104,     97,    110,
+     105,     12,     68,    104,     97,    118,     97,    108,
+      97,    109,     98,     97,    114,    105,      7,     68,
+     104,    101,    110,    117,    107,     97,     17,     68,
+     104,    105,    114,     97,    115,     97,    110,    107,
+      97,    114,     97,     98,    104,     97,    114,     97,
+       8,     68,    105,     97,    116,    111,    110,    105,
+      99,      9,     68,    105,    118,    121,     97,    109,
+      97,    110,    105,      6,     68,    111,    114,    105,
+      97,    110,      6,     68,    111,    117,     98,    108,
+     101,      8,     69,    103,    121,    112,    116,    105,
+      97,    110,      5,     69,    105,    103,    104,    116,
+       9,     69,    110,    105,    103,    109,     97,    116,
+     105,     99,      4,     69,    122,    101,    108,      2,
+      71,     46,     11,     71,     97,    109,     97,    110,
+      97,    115,    114,     97,    109,     97,      9,     71,
+      97,    110,     97,    109,    117,    114,    116,    105,
+      14,     71,     97,    110,    103,    101,    121,     97,
+      98,    104,    117,    115,     97,    110,    105,     13,
+      71,     97,    117,    114,    105,    109,     97,    110,
+     111,    104,     97,    114,    105,     10,     71,     97,
+     118,     97,    109,     98,    111,    100,    104,    105,
+      11,     71,     97,    121,     97,    107,     97,    112,
+     114,    105,    121,     97,      4,     71,    101,    101,
+     122,     11,     72,     97,    110,    117,    109,     97,
+     116,    116,    111,    100,    105,     12,     72,     97,
+     114,    105,    107,     97,    109,     98,    104,    111,
+     106,    105,     11,     72,     97,    116,     97,    107,
+      97,    109,     98,     97,    114,    105,      8,     72,
+      97,    119,     97,    105,    105,     97,    110,      8,
+      72,    101,    109,     97,    118,     97,    116,    105,
+       5,     72,    105,    110,    100,    117,      9,     72,
+     105,    110,    100,    117,    115,    116,     97,    110,
+       9,     72,    105,    114,     97,    106,    111,    115,
+     104,    105,      6,     73,    111,    110,    105,     97,
+     110,     10,     74,     97,    108,     97,    114,    110,
+      97,    118,     97,    109,      8,     74,     97,    118,
+      97,    110,    101,    115,    101,     20,     74,    101,
+     119,    105,    115,    104,     40,     65,    100,    111,
+     110,     97,    105,     77,     97,    108,     97,    107,
+     104,     41,     11,     74,    104,     97,    108,     97,
+     118,     97,    114,     97,    108,    105,     14,     74,
+     104,     97,    110,    107,     97,    114,     97,    100,
+     104,    118,     97,    110,    105,     14,     74,    121,
+     111,    116,    105,    115,    118,     97,    114,    117,
+     112,    105,    110,    105,      4,     75,     97,    102,
+     105,      6,     75,     97,    108,    121,     97,    110,
+      12,     75,     97,    109,     97,    118,     97,    114,
+     100,    104,     97,    110,    105,      9,     75,     97,
+     110,     97,    107,     97,    110,    103,    105,      9,
+      75,     97,    110,    116,     97,    109,     97,    110,
+     105,      6,     75,    104,     97,    109,     97,    106,
+      14,     75,    104,     97,    114,     97,    104,     97,
+     114,     97,    112,    114,    105,    121,     97,      8,
+      75,    105,    114,     97,    118,     97,    110,    105,
+      11,     75,    111,    107,    105,    108,     97,    112,
+     114,    105,    121,     97,      7,     75,    111,    115,
+      97,    108,     97,    109,      5,     75,    117,    109,
+     111,    105,      7,     76,     97,    116,     97,    110,
+     103,    105,      7,     76,    101,     97,    100,    105,
+     110,    103,      8,     77,     97,    110,     97,    118,
+      97,    116,    105,     11,     77,     97,    114,     97,
+     114,     97,    110,    106,     97,    110,    105,      5,
+      77,     97,    114,    118,     97,     15,     77,     97,
+     121,     97,    109,     97,    108,     97,    118,     97,
+     103,     97,    117,    108,     97,     12,     77,    101,
+      99,    104,     97,    107,     97,    108,    121,     97,
+     110,    105,      7,     77,    101,    108,    111,    100,
+     105,     99,     10,     77,    105,    120,    111,    108,
+     121,    100,    105,     97,    110,     10,     77,    111,
+     104,     97,    109,    109,    101,    100,     97,    110,
+       9,     77,    111,    110,    103,    111,    108,    105,
+      97,    110,     11,     78,     97,    103,     97,    110,
+      97,    110,    100,    105,    110,    105,     12,     78,
+      97,    109,     97,    110,     97,    114,     97,    121,
+      97,    110,    105,     13,     78,     97,    115,    105,
+     107,     97,     98,    104,    117,    115,     97,    110,
+     105,     12,     78,     97,    116,     97,     98,    104,
+      97,    105,    114,     97,    118,    105,     11,     78,
+      97,    116,     97,    107,     97,    112,    114,    105,
+     121,     97,      7,     78,     97,    116,    117,    114,
+      97,    108,      9,     78,     97,    118,     97,    110,
+     105,    116,     97,    109,     10,     78,    101,    111,
+     112,    108,    111,    105,    116,     97,    110,      7,
+      78,    101,    117,    116,    114,     97,    108,      4,
+      78,    105,    110,    101,      8,     78,    105,    116,
+     105,    109,     97,    116,    105,      6,     80,     97,
+     118,     97,    110,    105,      5,     80,    101,    108,
+     111,    103,      8,     80,    104,    114,    121,    103,
+     105,     97,    110,     10,     80,    114,    111,    109,
+     101,    116,    104,    101,    117,    115,     20,     80,
+     114,    111,    109,    101,    116,    104,    101,    117,
+     115,     78,    101,    111,    112,    111,    108,    105,
+     116,     97,    110,      4,     80,    117,    114,    101,
+       5,     80,    117,    114,    118,    105,      6,     82,
+      97,     98,     98,     97,     41,     12,     82,     97,
+     103,     97,    118,     97,    114,    100,    104,     97,
+     110,    105,     10,     82,     97,    103,    104,    117,
+     112,    114,    105,    121,     97,      9,     82,     97,
+     109,     97,    112,    114,    105,    121,     97,     11,
+      82,     97,    115,    105,    107,     97,    112,    114,
+     105,    121,     97,      8,     82,     97,    116,    110,
+      97,    110,    103,    105,     12,     82,    105,    115,
+      97,     98,    104,     97,    112,    114,    105,    121,
+      97,      9,     82,    111,    117,    109,     97,    110,
+     105,     97,    110,      8,     82,    117,    112,     97,
+     118,     97,    116,    105,     15,     83,     97,    100,
+     118,    105,    100,    104,     97,    109,     97,    114,
+     103,    105,    110,    105,      7,     83,     97,    108,
+      97,    103,     97,    109,     13,     83,     97,    110,
+     109,    117,    107,    104,     97,    112,    114,    105,
+     121,     97,      9,     83,     97,    114,     97,    115,
+      97,    110,    103,    105,      5,     83,     99,     97,
+     108,    101,      8,     83,    101,    110,     97,    118,
+      97,    116,    105,     17,     83,    105,    109,    104,
+     101,    110,    100,    114,     97,    109,     97,    100,
+     104,    121,     97,    109,     97,      3,     83,    105,
+     120,     16,     83,    117,     98,    104,     97,    112,
+      97,    110,    116,    117,    118,     97,    114,     97,
+     108,    105,     10,     83,    117,     99,    104,     97,
+     114,    105,    116,    114,     97,      6,     83,    117,
+     108,    105,    110,    105,      5,     83,    117,    112,
+     101,    114,     11,     83,    117,    114,    121,     97,
+     107,     97,    110,    116,     97,    109,     10,     83,
+     117,    118,     97,    114,    110,     97,    110,    103,
+     105,     10,     83,    121,     97,    109,     97,    108,
+      97,    110,    103,    105,     11,     83,    121,    109,
+     109,    101,    116,    114,    105,     99,     97,    108,
+       8,     84,     97,    110,     97,    114,    117,    112,
+     105,      4,     84,    111,    100,    105,     12,     86,
+      97,    103,     97,    100,    104,    105,    115,    118,
+      97,    114,    105,     14,     86,     97,    107,    117,
+     108,     97,     98,    104,     97,    114,     97,    110,
+      97,    109,      9,     86,     97,    110,     97,    115,
+     112,     97,    116,    105,     11,     86,     97,    114,
+     117,    110,     97,    112,    114,    105,    121,     97,
+      11,     86,     97,    115,     99,    104,     97,    115,
+     112,     97,    116,    105,     10,     86,    105,    115,
+     118,     97,    109,     98,     97,    114,    105,      9,
+      87,    104,    111,    108,    101,     84,    111,    110,
+     101,      9,     89,     97,    103,     97,    112,    114,
+     105,    121,     97,      6,    114,     97,    114,     97,
+     121,     41,
+};
+const prog_uint8_t scale_name_words[] PROGMEM = {
+       4,    255,    255,    255,     28,      1,    255,    255,
+     180,      1,    255,    255,    189,      1,    255,    255,
+     125,    255,    255,    255,     15,      5,    255,    255,
+       8,      4,    255,    255,      8,      1,    255,    255,
+       8,     21,    255,    255,      8,    192,    255,    255,
+      33,     41,    255,    255,     33,     45,    255,    255,
+     155,    255,    255,    255,    133,    255,    255,    255,
+     197,    255,    255,    255,      7,    255,    255,    255,
+     181,    255,    255,    255,    112,    255,    255,    255,
+      14,    255,    255,    255,    113,    255,    255,    255,
+      20,      9,    255,    255,     20,     10,    255,    255,
+      11,    255,    255,    255,     12,      3,    255,    255,
+      12,     11,    255,    255,     12,      3,    255,    255,
+     115,    255,    255,    255,     21,    255,    255,    255,
+     120,    255,    255,    255,     22,    255,    255,    255,
+      22,    183,    255,    255,    131,    255,    255,    255,
+       3,    255,    255,    255,     24,     13,    255,    255,
+      24,     15,    255,    255,      3,    235,    255,    255,
+      25,    108,    255,    255,    134,     28,    255,    255,
+     135,    255,    255,    255,    136,      5,     37,    255,
+     137,    255,    255,    255,     26,     39,    237,    255,
+      26,    146,    138,    255,     13,     23,     16,    255,
+      13,     23,     18,     16,    150,    255,    255,    255,
+     152,    255,    255,    255,    153,    255,    255,    255,
+     154,    255,    255,    255,      6,      4,    255,    255,
+       6,     27,    255,    255,      6,    139,     36,    255,
+       6,      1,    255,    255,     30,      9,    255,    255,
+      30,     10,    255,    255,     29,     42,    255,    255,
+      29,     44,    255,    255,    157,    255,    255,    255,
+     158,    255,    255,    255,     31,     40,    202,    255,
+      31,     43,    111,    255,    172,    255,    255,    255,
+     174,     15,      5,    255,      7,     11,    255,    255,
+       7,      1,    255,    255,      7,      3,    255,    255,
+       4,     14,    255,    255,    182,    255,    255,    255,
+      32,    255,    255,    255,    191,      4,    255,    255,
+      32,      1,    255,    255,    193,      5,    215,    255,
+      34,      9,    255,    255,     34,     10,    255,    255,
+      35,    255,    255,    255,     35,     25,    255,    255,
+     196,    255,    255,    255,     36,    255,    255,    255,
+     198,    255,    255,    255,    199,    255,    255,    255,
+     200,      1,    255,    255,    201,     38,    255,    255,
+     209,      1,    255,    255,    218,      5,    226,    255,
+      37,     27,    255,    255,    222,     14,    255,    255,
+       2,    114,    255,    255,      2,    119,    255,    255,
+       2,    116,    255,    255,      2,    117,    255,    255,
+       2,    162,    255,    255,      2,    163,    255,    255,
+       2,    167,    255,    255,      2,    177,    255,    255,
+     228,     38,    255,    255,      0,    118,     79,    255,
+       0,    121,     51,    255,      0,    122,     71,    255,
+       0,    123,     61,    255,      0,    124,    100,    255,
+       0,    126,     92,    255,      0,    127,    103,    255,
+       0,    128,     82,    255,      0,    129,    110,    255,
+       0,    130,    255,    255,      0,    132,     81,    255,
+       0,    140,     87,    255,      0,    141,     64,    255,
+       0,    142,     68,    255,      0,    143,     58,    255,
+       0,    144,     78,    255,      0,    145,     49,    255,
+       0,    147,    109,    255,      0,    148,     63,    255,
+       0,    149,     53,    255,      0,    151,     91,    255,
+       0,    156,     73,    255,      0,    159,     74,    255,
+       0,    160,     54,    255,      0,    161,    102,    255,
+       0,    164,     85,    255,      0,    165,     17,    255,
+       0,    166,     95,    255,      0,    168,     57,    255,
+       0,    169,     56,    255,      0,    170,     47,    255,
+       0,    171,    106,    255,      0,    173,     97,    255,
+       0,    175,     83,    255,      0,    176,     60,    255,
+       0,    178,     17,    255,      0,    179,     99,    255,
+       0,    184,     65,    255,      0,    185,     84,    255,
+       0,    186,    105,    255,      0,    187,     55,    255,
+       0,    188,     46,    255,      0,    190,     75,    255,
+       0,    194,     94,    255,      0,    195,     76,    255,
+       0,    203,     67,    255,      0,    204,     77,    255,
+       0,    205,     86,    255,      0,    206,    107,    255,
+       0,    207,     18,    255,      0,    208,     96,    255,
+       0,    210,     48,    255,      0,    211,     19,    255,
+       0,    212,     72,    255,      0,    213,     90,    255,
+       0,    214,     62,    255,      0,    216,    104,    255,
+       0,    217,    255,    255,      0,    219,    255,    255,
+       0,    220,    101,    255,      0,    221,     70,    255,
+       0,    223,     52,    255,      0,    224,     80,    255,
+       0,    225,     89,    255,      0,    227,     93,    255,
+       0,    233,     98,    255,      0,    229,     69,    255,
+       0,    230,     50,    255,      0,    231,     19,    255,
+       0,    232,     59,    255,      0,    234,     88,    255,
+       0,    236,     66,    255,
+};
+
 
 }  // namespace midialf
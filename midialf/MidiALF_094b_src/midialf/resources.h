@@ -57,6 +57,9 @@ extern const prog_uint16_t lut_res_increments[] PROGMEM;
 extern const prog_uint8_t chr_res_digits_10[] PROGMEM;
 extern const prog_uint8_t chr_res_sequencer_icons[] PROGMEM;
 extern const prog_uint8_t wav_res_lfo_waveforms[] PROGMEM;
+extern const prog_uint16_t wav_res_lfo_waveforms_blocks[] PROGMEM;
+extern const prog_uint8_t scale_name_dictionary[] PROGMEM;
+extern const prog_uint8_t scale_name_words[] PROGMEM;
 #define STR_RES_OFF 0  // off
 #define STR_RES_ON 1  // on
 #define STR_RES_NO 2  // no
@@ -86,7 +89,14 @@ extern const prog_uint8_t wav_res_lfo_waveforms[] PROGMEM;
 #define CHR_RES_SEQUENCER_ICONS 1
 #define CHR_RES_SEQUENCER_ICONS_SIZE 32
 #define WAV_RES_LFO_WAVEFORMS 0
-#define WAV_RES_LFO_WAVEFORMS_SIZE 2193
+#define WAV_RES_LFO_WAVEFORMS_SIZE 1245
+#define WAV_RES_LFO_WAVEFORMS_BLOCK_SIZE 129
+#define WAV_RES_LFO_WAVEFORMS_DECODED_SIZE 2193
+#define WAV_RES_LFO_WAVEFORMS_CHECKSUM 0x9fb6
+#define SCL_RES_NUM_STRINGS 167
+#define SCL_RES_WIDTH 20
+#define SCL_RES_WORDS_PER_STRING 4
+#define SCL_RES_CHECKSUM 0xa403
 typedef avrlib::ResourcesManager<
     ResourceId,
     avrlib::ResourcesTables<
@@ -282,4 +282,4 @@ for i, values in enumerate(custom_lfos):
   lfo_waveforms[i * 129: i * 129 + 128] = values
   lfo_waveforms[i * 129 + 128] = values[0]
 
-waveforms = [('lfo_waveforms', lfo_waveforms)]
+waveforms = [('lfo_waveforms', lfo_waveforms, ('fold+delta', 129))]
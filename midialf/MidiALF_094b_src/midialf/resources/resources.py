@@ -56,6 +56,7 @@ create_specialized_manager = True
 
 import characters
 import lookup_tables
+import scales
 import strings
 
 resources = [
@@ -64,4 +65,6 @@ resources = [
    'lookup_table', 'LUT_RES', 'prog_uint16_t', int, False),
   (characters.characters, 'character', 'CHR_RES', 'prog_uint8_t', int, True),
   (lookup_tables.waveforms, 'waveform', 'WAV_RES', 'prog_uint8_t', int, True),
+  (scales.names, 'scale_name', 'SCL_RES', 'prog_uint8_t', str, False,
+   ('dictionary', 20)),
 ]
@@ -0,0 +1,192 @@
+#!/usr/bin/python2.5
+#
+# Copyright 2026 agent.
+#
+# Author: agent (agent@local)
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# -----------------------------------------------------------------------------
+#
+# Scale names, in the order of seq_scale_table in scale.cc. They are shown on
+# 20 characters and packed with the 'dictionary' codec. The names are
+# courtesy of midibox.org, see scale.cc.
+
+names = """
+Major
+Harmonic Minor
+Melodic Minor
+Natural Minor
+Chromatic
+Whole Tone
+Pentatonic Major
+Pentatonic Minor
+Pentatonic Blues
+Pentatonic Neutral
+Octatonic (H-W)
+Octatonic (W-H)
+Ionian
+Dorian
+Phrygian
+Lydian
+Mixolydian
+Aeolian
+Locrian
+Algerian
+Arabian (A)
+Arabian (B)
+Augmented
+Auxiliary Diminished
+Auxiliary Augmented
+Auxiliary Diminished
+Balinese
+Blues
+Byzantine
+Chinese
+Chinese Mongolian
+Diatonic
+Diminished
+Diminished, Half
+Diminished, Whole
+Diminished WholeTone
+Dominant 7th
+Double Harmonic
+Egyptian
+Eight Tone Spanish
+Enigmatic
+Ethiopian (A raray)
+Ethiopian Geez Ezel
+Half Dim (Locrian)
+Half Dim 2 (Locrian)
+Hawaiian
+Hindu
+Hindustan
+Hirajoshi
+Hungarian Major
+Hungarian Gypsy
+Hungarian G. Persian
+Hungarian Minor
+Japanese (A)
+Japanese (B)
+Japan. (Ichikosucho)
+Japan. (Taishikicho)
+Javanese
+Jewish(AdonaiMalakh)
+Jewish (Ahaba Rabba)
+Jewish (Magen Abot)
+Kumoi
+Leading Whole Tone
+Lydian Augmented
+Lydian Minor
+Lydian Diminished
+Major Locrian
+Mohammedan
+Neopolitan
+Neoploitan Major
+Neopolitan Minor
+Nine Tone Scale
+Oriental (A)
+Oriental (B)
+Overtone
+Overtone Dominant
+Pelog
+Persian
+Prometheus
+PrometheusNeopolitan
+Pure Minor
+Purvi Theta
+Roumanian Minor
+Six Tone Symmetrical
+Spanish Gypsy
+Super Locrian
+Theta, Asavari
+Theta, Bilaval
+Theta, Bhairav
+Theta, Bhairavi
+Theta, Kafi
+Theta, Kalyan
+Theta, Khamaj
+Theta, Marva
+Todi Theta
+M. Bhavapriya 44
+M. Chakravakam 16
+M. Chalanata 36
+M. Charukesi 26
+M. Chitrambari 66
+M. Dharmavati 59
+M. Dhatuvardhani 69
+M. Dhavalambari 49
+M. Dhenuka 9
+M. Dhirasankarabhara
+M. Divyamani 48
+M. Gamanasrama 53
+M. Ganamurti 3
+M. Gangeyabhusani 33
+M. Gaurimanohari 23
+M. Gavambodhi 43
+M. Gayakapriya 13
+M. Hanumattodi 8
+M. Harikambhoji 28
+M. Hatakambari 18
+M. Hemavati 58
+M. Jalarnavam 38
+M. Jhalavarali 39
+M. Jhankaradhvani 19
+M. Jyotisvarupini 68
+M. Kamavardhani 51
+M. Kanakangi 1
+M. Kantamani 61
+M. Kharaharapriya 22
+M. Kiravani 21
+M. Kokilapriya 11
+M. Kosalam 71
+M. Latangi 63
+M. Manavati 5
+M. Mararanjani 25
+M. Mayamalavagaula 1
+M. Mechakalyani 65
+M. Naganandini 30
+M. Namanarayani 50
+M. Nasikabhusani 70
+M. Natabhairavi 20
+M. Natakapriya 10
+M. Navanitam 40
+M. Nitimati 60
+M. Pavani 41
+M. Ragavardhani 32
+M. Raghupriya 42
+M. Ramapriya 52
+M. Rasikapriya 72
+M. Ratnangi 2
+M. Risabhapriya 62
+M. Rupavati 12
+M. Sadvidhamargini 4
+M. Salagam 37
+M. Sanmukhapriya 56
+M. Sarasangi 27
+M. Senavati 7
+M. Simhendramadhyama
+M. Subhapantuvarali
+M. Sucharitra 67
+M. Sulini 35
+M. Suryakantam 17
+M. Suvarnangi 47
+M. Syamalangi 55
+M. Tanarupi 6
+M. Vaschaspati 64
+M. Vagadhisvari 34
+M. Vakulabharanam 14
+M. Vanaspati 4
+M. Varunapriya 24
+M. Visvambari 54
+M. Yagapriya 31
+"""
@@ -25,6 +25,7 @@
 #include "midialf/midi_handler.h"
 #include "midialf/display.h"
 #include "midialf/storage.h"
+#include "midialf/sysex_handler.h"
 #include "midialf/clock.h"
 #include "midialf/leds.h"
 #include "midialf/lfo.h"
@@ -45,6 +46,9 @@ using namespace avrlib;
 
 Serial<MidiPort, 31250, DISABLED, POLLED> midi_out;
 
+// No song position pointer received since the sequencer stopped
+static const uint16_t kNoSongPosition = 0xffff;
+
 /* extern */
 Seq seq;
 
@@ -74,6 +78,9 @@ uint8_t Seq::steps_skip_;
 uint8_t Seq::seq_switch_mode_;
 uint8_t Seq::cv_mode_[4];
 uint8_t Seq::gate_mode_[4];
+uint8_t Seq::track_channel_[4];
+uint8_t Seq::track_direction_[4];
+uint8_t Seq::track_clock_division_[4];
 
 uint8_t Seq::seq_;
 uint8_t Seq::tick_;
@@ -84,6 +91,7 @@ uint8_t Seq::step_hold_;
 uint8_t Seq::last_note_;
 uint8_t Seq::pendulum_backward_;
 uint8_t Seq::midi_clock_prescaler_;
+uint8_t Seq::ratchet_ticks_[CLOCK_DIVISION_X4 + 1][kMaxRatchets * (kMaxRatchets - 1) / 2];
 uint8_t Seq::clock_division_counter_;
 uint8_t Seq::steps_forward_counter_;
 uint8_t Seq::steps_replay_counter_;
@@ -96,6 +104,15 @@ uint8_t Seq::next_step_;
 uint8_t Seq::next_seq_;
 uint8_t Seq::last_recorded_step_;
 uint8_t Seq::last_recorded_seq_;
+RecordedNote Seq::recorded_notes_[kNumRecordedNotes];
+uint16_t Seq::step_time_;
+uint16_t Seq::prev_step_times_[kNumTimedSteps];
+uint16_t Seq::step_duration_;
+uint8_t Seq::timed_steps_;
+uint8_t Seq::record_seq_;
+uint8_t Seq::record_step_;
+uint8_t Seq::record_latency_ = kDefRecordLatency;
+uint16_t Seq::song_position_ = kNoSongPosition;
 uint8_t Seq::last_legato_note_;
 uint8_t Seq::manual_step_selected_;
 uint8_t Seq::bank_select_msb_;
@@ -106,6 +123,8 @@ uint8_t Seq::strobe_width_;
 uint8_t Seq::last_received_note_;
 uint8_t Seq::last_received_cc_;
 uint8_t Seq::request_set_seq_;
+volatile uint8_t Seq::changes_ = SEQ_CHANGE_ALL;
+TrackState Seq::track_[4];
 
 NoteStack<16> Seq::note_stack_;
 /* </static> */
@@ -206,14 +225,26 @@ void SeqData::RotR() {
 
 void SeqData::Verify() {
   for (uint8_t n = 0; n < 8; n++) {
-    if (note_[n] > 127 || velo_[n] > 127 || gate_[n] >= kNoteDurationCount || 
-      cc1_[n] > 127  || cc2_[n] > 127 ) {
+    if (gate(n) >= kNoteDurationCount) {
       Init();
       return;
     }
   }
 }
 
+void SeqData::Migrate(uint8_t version) {
+  // Older programs don't have the trigger attributes
+  if (version != kSeqDataVersion) {
+    for (uint8_t n = 0; n < 8; n++) {
+      note_[n]&= 0x7f;
+      velo_[n]&= 0x7f;
+      gate_[n]&= 0x1f;
+      cc1_[n]&= 0x7f;
+      cc2_[n]&= 0x7f;
+    }
+  }
+}
+
 void SeqData::SwapSteps(uint8_t step1, uint8_t step2) {
   uint8_t tmp;
   tmp = note(step1); set_note(step1, note(step2)); set_note(step2, tmp);
@@ -226,6 +257,9 @@ void SeqData::SwapSteps(uint8_t step1, uint8_t step2) {
   tmp = lega(step1); set_lega(step1, lega(step2)); set_lega(step2, tmp);
   tmp = cc1send(step1); set_cc1send(step1, cc1send(step2)); set_cc1send(step2, tmp);
   tmp = cc2send(step1); set_cc2send(step1, cc2send(step2)); set_cc2send(step2, tmp);
+  tmp = prob(step1); set_prob(step1, prob(step2)); set_prob(step2, tmp);
+  tmp = ratchets(step1); set_ratchets(step1, ratchets(step2)); set_ratchets(step2, tmp);
+  tmp = delay(step1); set_delay(step1, delay(step2)); set_delay(step2, tmp);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -245,6 +279,9 @@ const prog_uint8_t default_seqinfo_data[] PROGMEM = {
   kDefCV1Mode, kDefCV2Mode, kDefCV3Mode, kDefCV4Mode, 
   kDefGate1Mode, kDefGate2Mode, kDefGate3Mode, kDefGate4Mode, 
   kDefSeqSwitchMode,
+  kDefLfoOutput, kDefLfoOutput,
+  0, 1, 2, 3, // tracks on channels 1-4, forward, no clock division
+  kSeqDataVersion,
 };
 
 void SeqInfo::Init(uint8_t slot) {
@@ -270,7 +307,7 @@ void Seq::OnInit() {
 //lcd.SetCustomCharMapRes(chr_res_sequencer_icons, 4, 1);
   UpdateClock();
   clock.Start();
-  running_ = 0;
+  set_running(0);
   set_seq(0);
   set_step(0);
   UpdatePrescaler();
@@ -291,6 +328,9 @@ void Seq::OnNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
     last_note_ = note;
 
   if (recording_) {
+    if (running_) {
+      RecordNoteOn(note, velocity);
+    } else
       RecordStep(note, velocity);
   }
 }
@@ -304,6 +344,9 @@ void Seq::OnNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
     uint8_t top_note = note_stack_.most_recent_note().note;
     note_stack_.NoteOff(note);
     Send3(0x80 | channel, note, velocity);
+    if (recording_ && running_) {
+      RecordNoteOff(note);
+    } else
     if (recording_ && note_stack_.size() > 0) {
       // Most recent pressed key has been released, however some keys are 
       // still pressed, so we need to record the most recent one...
@@ -397,8 +440,9 @@ void Seq::OnSysExByte(uint8_t sysex_byte) {
 
 /* static */
 void Seq::OnClock() {
-  if (clock_mode_ == CLOCK_MODE_EXTERNAL && running_) {
-    Tick();
+  // The sequencer is ticked by the clock regenerated from the MIDI clocks
+  if (clock_mode_ == CLOCK_MODE_EXTERNAL) {
+    clock.OnExternalClock();
   }
 }
 
@@ -412,7 +456,15 @@ void Seq::OnStart() {
 /* static */
 void Seq::OnContinue() {
   if (clock_mode_ == CLOCK_MODE_EXTERNAL) {
-    running_ = 1;
+    if (song_position_ != kNoSongPosition) {
+      Start();
+      Locate(song_position_);
+      song_position_ = kNoSongPosition;
+    } else
+    if (!running_) {
+      clock.StartExternal();
+      set_running(1);
+    }
   }
 }
 
@@ -423,6 +475,14 @@ void Seq::OnStop() {
   }
 }
 
+/* static */
+void Seq::OnSongPosition(uint16_t position) {
+  // Song position is only meaningful while stopped, it is applied on continue
+  if (clock_mode_ == CLOCK_MODE_EXTERNAL && !running_) {
+    song_position_ = position;
+  }
+}
+
 /* static */
 uint8_t Seq::CheckChannel(uint8_t channel) {
   return 1;
@@ -450,8 +510,10 @@ void Seq::OnRawMidiData(
 
 /* static */
 void Seq::OnInternalClockTick() {
-  if (clock_mode_ == CLOCK_MODE_INTERNAL && running_) {
-    SendNow(0xf8);
+  if (running_ && !clock.held()) {
+    if (clock_mode_ == CLOCK_MODE_INTERNAL) {
+      SendNow(0xf8);
+    }
     Tick();
   } else
   // Make sure ENCx click notes get their note offs served
@@ -467,13 +529,33 @@ void Seq::OnInternalClockStep() {
 ///////////////////////////////////////////////////////////////////////////////
 // Sequence actions
 
+/* static */
+void Seq::Invalidate(uint8_t changes) {
+  // Raised from both the clock and the MIDI interrupts
+  uint8_t sreg = SREG;
+  cli();
+  changes_|= changes;
+  SREG = sreg;
+}
+
+/* static */
+uint8_t Seq::TakeChanges() {
+  uint8_t sreg = SREG;
+  cli();
+  uint8_t changes = changes_;
+  changes_ = 0;
+  SREG = sreg;
+  return changes;
+}
+
 /* static */
 void Seq::SetSeq(uint8_t seq) {
   if (seq == seq_)
     return;
 
-  if (running_ && seq_switch_mode_) {
-    request_set_seq_ = 1 + seq;
+  // Tracks always play, selecting one only changes the track being edited
+  if (running_ && seq_switch_mode_ && link_mode_ != LINK_MODE_TRACKS) {
+    set_request_set_seq(1 + seq);
   } else
     set_seq(seq);
 }
@@ -490,6 +572,10 @@ void Seq::Stop() {
   // Flush the note off messages in the queue.
   FlushQueue(channel_);
 
+  if (link_mode_ == LINK_MODE_TRACKS) {
+    StopTracks();
+  }
+
   // Send an all notes/controllers off messages.
   Send3(0xb0 | channel_, 123, 0);
   Send3(0xb0 | channel_, 121, 0);
@@ -497,9 +583,11 @@ void Seq::Stop() {
     SendNow(0xfc);
   }
 
-  running_ = 0;
-  request_set_seq_ = 0;
+  set_running(0);
+  set_request_set_seq(0);
+  song_position_ = kNoSongPosition;
   last_legato_note_ = -1;
+  ResetRecordedNotes();
 
   lfo.Stop();
 }
@@ -512,7 +600,8 @@ void Seq::Start() {
   if (clock_mode_ == CLOCK_MODE_INTERNAL) {
     clock.Start();
     SendNow(0xfa);
-  }
+  } else
+    clock.StartExternal();
 
   UpdatePrescaler();
 
@@ -520,57 +609,70 @@ void Seq::Start() {
   port.SendStart(1);
 #endif
 
+  // Reset progression controls
   saved_replay_step_ = 0;
+  steps_forward_counter_ = 0;
+  steps_replay_counter_ = 0;
+  steps_interval_counter_ = 0;
+  steps_repeat_counter_ = 0;
+  steps_skip_counter_ = 0;
 
   // Set step to start with
+  if (link_mode_ == LINK_MODE_TRACKS) {
+    StartTracks();
+  } else
   if (step_hold_) {
     ;
   } else
   if (CheckAllSkipped()) {
-    step_ = 0;
+    set_step(0);
   } else {
     // Set initial step one before the start step to ensure consistent led behavior
     switch (direction_) {
       case DIRECTION_FORWARD: {
-          uint8_t first_step = (kNumSteps << link_mode_) - 1;
+          uint8_t first_step = num_linked_steps() - 1;
           switch (link_mode_) {
-            case LINK_MODE_16: seq_ = (seq_ & 2) + (first_step >> 3); break;
-            case LINK_MODE_32: seq_ = first_step >> 3; break;
+            case LINK_MODE_16: set_seq((seq_ & 2) + (first_step >> 3)); break;
+            case LINK_MODE_32: set_seq(first_step >> 3); break;
           }
-          step_ = first_step & (kNumSteps - 1);
+          set_step(first_step & (kNumSteps - 1));
         }
         break;
       case DIRECTION_BACKWARD: 
-        step_ = 0; 
+        set_step(0); 
         break;
       case DIRECTION_PENDULUM:
-        step_ = 1; pendulum_backward_ = 1;
+        set_step(1); pendulum_backward_ = 1;
         switch (link_mode_) {
-          case LINK_MODE_16: seq_&= 2; break;
-          case LINK_MODE_32: seq_ = 0; break;
+          case LINK_MODE_16: set_seq(seq_ & 2); break;
+          case LINK_MODE_32: set_seq(0); break;
         }
         break;
       case DIRECTION_RANDOM: 
         Random::Seed((uint16_t)milliseconds()); 
         break;
     }
-    AdvanceStep();
+    // Move onto the start step without counting it as a played step,
+    // replays return to it
+    NextStep(0);
+    saved_replay_step_ = next_step_;
   }
 
-  // Reset progression controls
-  steps_forward_counter_ = 0;
-  steps_replay_counter_ = 0;
-  steps_interval_counter_ = 0;
-  steps_repeat_counter_ = 0;
-  steps_skip_counter_ = 0;
-
   // Reset running controls
   tick_ = midi_clock_prescaler_ - 1;
   clock_division_counter_ = -1;
   last_legato_note_ = -1;
   last_note_ = root_note_;
-  request_set_seq_ = 0;
-  running_ = -1;
+  set_request_set_seq(0);
+  set_running(-1);
+
+  // Notes played before the first step go to the first step
+  ResetRecordedNotes();
+  step_time_ = milliseconds();
+  step_duration_ = 0;
+  timed_steps_ = 0;
+  record_seq_ = seq_;
+  record_step_ = step_;
   
   lfo.Start();
 }
@@ -592,6 +694,11 @@ void Seq::Tick() {
 
   tick_ = 0;
 
+  if (link_mode_ == LINK_MODE_TRACKS) {
+    TickTracks();
+    return;
+  }
+
   switch (clock_division_) {
     case CLOCK_DIVISION_X2:
       if ((clock_division_counter_++ & 1) != 1)
@@ -608,7 +715,7 @@ void Seq::Tick() {
       AdvanceStep();
     }
   } else
-    running_ = 1;
+    set_running(1);
 
   if (step_ == 0) {
     switch (link_mode_) {
@@ -623,8 +730,7 @@ void Seq::Tick() {
       default:
 OnSeq:  if (request_set_seq_) {
           set_seq(request_set_seq_ - 1);
-          request_set_seq_ = 0;
-          Ui::RequestRefresh();
+          set_request_set_seq(0);
         }
 #ifdef ENABLE_CV_OUTPUT
         port.SendSeq();
@@ -635,11 +741,20 @@ OnSeq:  if (request_set_seq_) {
 
   // Send CCs and note if not muted
   SendStep();
+
+  // Recorded notes are merged after the step is sent, so that the notes
+  // just played live are not sent twice.
+  MergeRecordedNotes();
 }
 
 /* static */
 void Seq::AdvanceStep() {
-  manual_step_selected_ = 0;
+  NextStep(1);
+}
+
+/* static */
+void Seq::NextStep(uint8_t progress) {
+  set_manual_step_selected(0);
 
   // If all steps are skipped, do nothing
   available_steps_ = CountAvailableSteps();
@@ -661,7 +776,7 @@ void Seq::AdvanceStep() {
   uint8_t advance = 1;
  
   // Check if progrssion options are not applicable
-  if (available_steps_ > 1 && direction_ != DIRECTION_RANDOM) {
+  if (progress && available_steps_ > 1 && direction_ != DIRECTION_RANDOM) {
 
     if (steps_forward_ && ++steps_forward_counter_ >= steps_forward_) {
       steps_forward_counter_ = 0;
@@ -675,6 +790,7 @@ void Seq::AdvanceStep() {
         save_step = 1;
       } else {
         next_step_ = saved_replay_step_;
+        UpdateNextSeq();
         advance = 0;
       }
     }
@@ -706,7 +822,6 @@ void Seq::AdvanceStep() {
   // Advance to the next sequence
   if (next_seq_ != seq_) {
     set_seq(next_seq_);
-    Ui::AddRequest(REQUEST_UPDATESCREEN);
   }
 
   set_step(next_step_ & (kNumSteps - 1));
@@ -725,7 +840,7 @@ void Seq::AdvanceStep(uint8_t direction) {
   uint8_t current_step = next_step_;
 
   // Find out number of virtual steps
-  uint8_t num_steps = kNumSteps << link_mode_;
+  uint8_t num_steps = num_linked_steps();
 
   // Advance to the next virtual step
   for (;;) {
@@ -761,10 +876,7 @@ void Seq::AdvanceStep(uint8_t direction) {
     }
 
     // Figure out next sequence
-    switch (link_mode_) {
-      case LINK_MODE_16: next_seq_ = (next_seq_ & 2) + (next_step_ >> 3); break;
-      case LINK_MODE_32: next_seq_ = next_step_ >> 3; break;
-    }
+    UpdateNextSeq();
 
     // Check if next step is not skipped, keep trying if it is
     if (!skip(next_seq_, next_step_ & (kNumSteps - 1))) {
@@ -777,9 +889,243 @@ void Seq::AdvanceStep(uint8_t direction) {
   }
 }
 
+/* static */
+void Seq::UpdateNextSeq() {
+  switch (link_mode_) {
+    case LINK_MODE_16: next_seq_ = (next_seq_ & 2) + (next_step_ >> 3); break;
+    case LINK_MODE_32: next_seq_ = next_step_ >> 3; break;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Track mode, all 4 sequences play at once with their own channel, direction
+// and clock division
+
+// Scheduled note offs of the tracks carry their channel in the tag
+static const uint8_t kTrackTag = 0x10;
+
+/* static */
+void Seq::set_link_mode(uint8_t link_mode) {
+  uint8_t tracks = link_mode == LINK_MODE_TRACKS;
+  if (running_ && tracks != (link_mode_ == LINK_MODE_TRACKS)) {
+    // The legato notes are released now, their delayed note ons must not
+    // follow
+    event_scheduler.RemoveNoteOns();
+    if (tracks) {
+      // Release the legato note, the tracks take over from the next step
+      if (last_legato_note_ != 0xff) {
+        Send3(0x80 | channel_, last_legato_note_, 0);
+        last_legato_note_ = 0xff;
+      }
+      StartTracks();
+      set_running(-1);  // Play the first steps on the next tick
+    } else {
+      StopTracks();
+      set_step(track_[seq_].step);
+    }
+  }
+  link_mode_ = link_mode;
+}
+
+/* static */
+void Seq::StartTracks() {
+  set_manual_step_selected(0);
+  Random::Seed((uint16_t)milliseconds()); 
+
+  // Set initial steps one before the start step, like the main sequencer
+  for (uint8_t track = 0; track < 4; ++track) {
+    TrackState& t = track_[track];
+    t.clock_division_counter = -1;
+    t.pendulum_backward = 0;
+    t.last_legato_note = 0xff;
+    switch (track_direction_[track]) {
+      case DIRECTION_FORWARD: t.step = kNumSteps - 1; break;
+      case DIRECTION_BACKWARD: t.step = 0; break;
+      case DIRECTION_PENDULUM: t.step = 1; t.pendulum_backward = 1; break;
+      case DIRECTION_RANDOM: t.step = 0; break;
+    }
+    AdvanceTrack(track);
+  }
+  set_step(track_[seq_].step);
+}
+
+/* static */
+void Seq::StopTracks() {
+  for (uint8_t track = 0; track < 4; ++track) {
+    TrackState& t = track_[track];
+    uint8_t channel = track_channel_[track];
+    if (t.last_legato_note != 0xff) {
+      Send3(0x80 | channel, t.last_legato_note, 0);
+      t.last_legato_note = 0xff;
+    }
+    if (channel != channel_) {
+      Send3(0xb0 | channel, 123, 0);
+      Send3(0xb0 | channel, 121, 0);
+    }
+  }
+}
+
+/* static */
+void Seq::TickTracks() {
+  uint8_t advance = running_ == 1 && !step_hold_;
+  uint8_t stepped = 0;
+  if (advance) {
+    set_manual_step_selected(0);
+  } else
+  if (step_hold_) {
+    // The held step of the edited track can be changed from the UI
+    track_[seq_].step = step_;
+  }
+  set_running(1);
+
+  // Each track does a constant amount of work, so a tick costs the same
+  // whatever the directions and divisions.
+  for (uint8_t track = 0; track < 4; ++track) {
+    TrackState& t = track_[track];
+    switch (track_clock_division_[track]) {
+      case CLOCK_DIVISION_X2:
+        if ((t.clock_division_counter++ & 1) != 1)
+          continue;
+        break;
+      case CLOCK_DIVISION_X4:
+        if ((t.clock_division_counter++ & 3) != 3)
+          continue;
+        break;
+    }
+
+    if (all_skipped(track))
+      continue;
+
+    if (advance) {
+      AdvanceTrack(track);
+    }
+
+#ifdef ENABLE_CV_OUTPUT
+    if (track == seq_ && t.step == 0) {
+      port.SendSeq();
+    }
+#endif
+
+    SendStep(track, t.step, track_channel_[track], kTrackTag | track_channel_[track], t.last_legato_note);
+    if (track == seq_) {
+      stepped = 1;
+    }
+  }
+
+  set_step(track_[seq_].step);
+
+  // Notes are recorded into the edited track
+  if (stepped) {
+    MergeRecordedNotes();
+  }
+
+  // Sync lfos
+  if (advance) {
+    lfo.OnStep();
+  }
+}
+
+/* static */
+void Seq::AdvanceTrack(uint8_t track) {
+  TrackState& t = track_[track];
+  uint8_t available_steps = data_[track].available_steps();
+  if (available_steps == 0)
+    return;
+
+  uint8_t current_step = t.step;
+  for (;;) {
+    switch (track_direction_[track]) {
+      case DIRECTION_FORWARD:
+        if (++t.step >= kNumSteps) {
+          t.step = 0;
+        }
+        break;
+      case DIRECTION_BACKWARD:
+        if (t.step-- == 0) {
+          t.step = kNumSteps - 1;
+        }
+        break;
+      case DIRECTION_PENDULUM:
+        if (t.pendulum_backward) {
+          if (t.step-- == 0) {
+            t.pendulum_backward = 0;
+            t.step = 1;
+          }
+        } else {
+          if (++t.step >= kNumSteps) {
+            t.pendulum_backward = 1;
+            t.step = kNumSteps - 2;
+          }
+        }
+        break;
+      case DIRECTION_RANDOM:
+        do {
+          t.step = Random::GetByte() & (kNumSteps - 1); 
+        } while (t.step == current_step && available_steps > 1);
+        break;
+    }
+
+    if (!skip(track, t.step)) {
+      if (t.step == current_step && available_steps > 1)
+        continue;
+      break;
+    }
+  }
+}
+
+/* static */
+void Seq::Locate(uint16_t position) {
+  // Called right after Start, to continue from a song position given in
+  // 16th notes. The steps are advanced as if the ticks had been played,
+  // but progression options restart from there.
+  uint32_t ticks = position * static_cast<uint32_t>(kNumTicksPerStep);
+  if (!ticks)
+    return;
+
+  // Number of prescaled ticks already handled, the first one playing the
+  // start step.
+  uint32_t triggers = (ticks - 1) / midi_clock_prescaler_ + 1;
+  tick_ = (ticks - 1) % midi_clock_prescaler_;
+
+  if (link_mode_ == LINK_MODE_TRACKS) {
+    for (uint8_t track = 0; track < 4; ++track) {
+      TrackState& t = track_[track];
+      uint8_t clock_division = track_clock_division_[track];
+      uint8_t steps = ((triggers - 1) >> clock_division) % NumStepsInCycle(
+          track_direction_[track], data_[track].available_steps());
+      while (steps--) {
+        AdvanceTrack(track);
+      }
+      t.clock_division_counter = triggers - 1;
+    }
+    set_step(track_[seq_].step);
+  } else {
+    uint8_t steps = ((triggers - 1) >> clock_division_) % NumStepsInCycle(
+        direction_, CountAvailableSteps());
+    while (steps--) {
+      AdvanceStep();
+    }
+    clock_division_counter_ = triggers - 1;
+  }
+
+  set_running(1);
+}
+
+/* static */
+uint8_t Seq::NumStepsInCycle(uint8_t direction, uint8_t available_steps) {
+  switch (direction) {
+    case DIRECTION_PENDULUM:
+      return available_steps > 1 ? 2 * available_steps - 2 : 1;
+    case DIRECTION_RANDOM:
+      return 1;
+  }
+  return available_steps ? available_steps : 1;
+}
+
 /* static */
 void Seq::UpdateClock() {
   clock.Update(bpm_, groove_template_, groove_amount_);
+  clock.set_external(clock_mode_ == CLOCK_MODE_EXTERNAL);
 #ifdef MIDIOUT_DEBUG_OUTPUT  
   //printf("Seq::UpdateClock: bpm=%u grv=%u amt=%u\n", bpm_, groove_template_, groove_amount_);
 #endif
@@ -792,6 +1138,22 @@ void Seq::UpdatePrescaler() {
   //printf("Seq::UpdatePrescaler: clock_rate=%u midi_clock_tick_per_step=%u\n", clock_rate, midi_clock_tick_per_step);
 #endif
   lfo.UpdatePrescaler();
+  UpdateRatchetTicks();
+}
+
+/* static */
+void Seq::UpdateRatchetTicks() {
+  // Ratchet i of n starts i * step ticks / n into the step. The offsets are
+  // computed for each clock division here, so that SendStep only looks them up.
+  for (uint8_t division = CLOCK_DIVISION_NONE; division <= CLOCK_DIVISION_X4; division++) {
+    uint16_t step_ticks = midi_clock_prescaler_ << division;
+    uint8_t* ticks = ratchet_ticks_[division];
+    for (uint8_t ratchets = 2; ratchets <= kMaxRatchets; ratchets++) {
+      for (uint8_t i = 1; i < ratchets; i++) {
+        *ticks++ = min(step_ticks * i / ratchets, 0xff);
+      }
+    }
+  }
 }
 
 /* static */
@@ -826,10 +1188,151 @@ void Seq::RecordStep(uint8_t note, uint8_t velocity) {
   Ui::AddRequest(REQUEST_UPDATESCREEN);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Real time recording
+//
+// Notes played while running are timestamped and kept until the next step
+// starts. They are then merged into the nearest of the two steps around them,
+// using the actual step times, so that the groove is taken into account. The
+// gate is set from the note length once the note off is received.
+
+/* static */
+void Seq::RecordNoteOn(uint8_t note, uint8_t velocity) {
+  uint16_t time = static_cast<uint16_t>(milliseconds()) - record_latency_;
+
+  // Notes are received in the MIDI ISR, which can be interrupted by the clock
+  uint8_t sreg = SREG;
+  cli();
+
+  // Use a free entry, or one waiting only for its note off
+  RecordedNote* recorded_note = NULL;
+  for (uint8_t n = 0; n < kNumRecordedNotes; n++) {
+    RecordedNote& entry = recorded_notes_[n];
+    if (entry.note == 0xff) {
+      recorded_note = &entry;
+      break;
+    }
+    if (entry.step != 0xff && !recorded_note) {
+      recorded_note = &entry;
+    }
+  }
+
+  if (recorded_note) {
+    recorded_note->note = note;
+    recorded_note->velocity = velocity;
+    recorded_note->step = 0xff;
+    recorded_note->time = time;
+    recorded_note->duration = 0;
+  }
+
+  SREG = sreg;
+}
+
+/* static */
+void Seq::RecordNoteOff(uint8_t note) {
+  uint16_t time = static_cast<uint16_t>(milliseconds()) - record_latency_;
+
+  uint8_t sreg = SREG;
+  cli();
+
+  for (uint8_t n = 0; n < kNumRecordedNotes; n++) {
+    RecordedNote& entry = recorded_notes_[n];
+    if (entry.note == note && !entry.duration) {
+      uint16_t duration = time - entry.time;
+      entry.duration = duration ? duration : 1;
+      if (entry.step != 0xff) {
+        MergeRecordedNote(entry);
+      }
+      break;
+    }
+  }
+
+  SREG = sreg;
+}
+
+/* static */
+void Seq::MergeRecordedNotes() {
+  uint16_t time = static_cast<uint16_t>(milliseconds());
+
+  if (recording_) {
+    for (uint8_t n = 0; n < kNumRecordedNotes; n++) {
+      RecordedNote& entry = recorded_notes_[n];
+      if (entry.note == 0xff || entry.step != 0xff)
+        continue;
+
+      // Snap to the previous step or to the one that has just started
+      if (static_cast<int16_t>(entry.time - step_time_) < static_cast<int16_t>(time - entry.time)) {
+        entry.seq = record_seq_;
+        entry.step = record_step_;
+      } else {
+        entry.seq = seq_;
+        entry.step = step_;
+      }
+      MergeRecordedNote(entry);
+    }
+  }
+
+  // Averaged over the last steps, which cancels the swing of most grooves.
+  // The first steps are counted, then the count cycles through the entries.
+  uint8_t oldest = timed_steps_ & (kNumTimedSteps - 1);
+  if (timed_steps_ >= kNumTimedSteps) {
+    step_duration_ = static_cast<uint16_t>(time - prev_step_times_[oldest]) / kNumTimedSteps;
+  }
+  prev_step_times_[oldest] = time;
+  if (++timed_steps_ == 2 * kNumTimedSteps) {
+    timed_steps_ = kNumTimedSteps;
+  }
+  step_time_ = time;
+  record_seq_ = seq_;
+  record_step_ = step_;
+}
+
+/* static */
+void Seq::MergeRecordedNote(RecordedNote& entry) {
+  set_note(entry.seq, entry.step, entry.note);
+  set_velo(entry.seq, entry.step, entry.velocity);
+  set_mute(entry.seq, entry.step, 0);
+  set_lega(entry.seq, entry.step, 0);
+
+  if (entry.duration) {
+    // Convert the length to 1/16th of clock ticks using the length of the
+    // last steps, and pick the closest note duration. The gate is left as is
+    // until the first steps have been timed.
+    if (step_duration_) {
+      uint8_t ticks_per_step = midi_clock_prescaler_ << active_clock_division();
+      uint32_t length = (static_cast<uint32_t>(entry.duration) * ticks_per_step << 4) / step_duration_;
+      uint16_t ticks = length > 0xffff ? 0xffff : length;
+      uint8_t gate = 0;
+      uint16_t best_error = 0xffff;
+      for (uint8_t n = 0; n < kNoteDurationCount; n++) {
+        uint16_t duration_ticks = NoteDuration::GetMidiClockTicks(n) << 4;
+        uint16_t error = ticks > duration_ticks ? ticks - duration_ticks : duration_ticks - ticks;
+        if (error < best_error) {
+          best_error = error;
+          gate = n;
+        }
+      }
+      set_gate(entry.seq, entry.step, gate);
+    }
+    entry.note = 0xff;
+  }
+
+  Ui::AddRequest(REQUEST_UPDATESCREEN);
+}
+
+/* static */
+void Seq::ResetRecordedNotes() {
+  for (uint8_t n = 0; n < kNumRecordedNotes; n++) {
+    recorded_notes_[n].note = 0xff;
+  }
+}
+
 /* static */
 uint8_t Seq::CheckAllSkipped() {
   switch (link_mode_) {
     case LINK_MODE_NONE: 
+    case LINK_MODE_TRACKS:
+    default:
       return all_skipped();
     case LINK_MODE_16:
       return all_skipped(seq_ & 2) && all_skipped((seq_ & 2) + 1);
@@ -842,6 +1345,8 @@ uint8_t Seq::CheckAllSkipped() {
 uint8_t Seq::CountAvailableSteps() {
   switch (link_mode_) {
     case LINK_MODE_NONE: 
+    case LINK_MODE_TRACKS:
+    default:
       return available_steps();
     case LINK_MODE_16:
       return available_steps(seq_ & 2) + available_steps((seq_ & 2) + 1);
@@ -908,8 +1413,8 @@ void Seq::Send3(uint8_t a, uint8_t b, uint8_t c) {
             port.SendGate(0);
           }
         } else {
-          // This check assumes we're only scheduling note offs
-          if (event_scheduler.size() <= 1) {
+          // Other tracks may have note offs pending on their own channels
+          if (PendingNoteOffs(channel_) <= 1) {
             port.SendGate(0);
           }
         }
@@ -962,6 +1467,8 @@ void Seq::Send(uint8_t status, uint8_t* data, uint8_t size) {
 void Seq::FlushOutputBuffer(uint8_t requested_size) {
 #ifndef MIDIOUT_DEBUG_OUTPUT  
   while (MidiHandler::OutputBuffer::writable() < requested_size) {
+    // The byte would end the SysEx block on the wire, which is sent again
+    SysExHandler::AbortBlock();
     display.set_status('!');
     uint8_t byte = MidiHandler::OutputBuffer::Read();
 #ifndef ENABLE_CV_OUTPUT
@@ -975,7 +1482,10 @@ void Seq::FlushOutputBuffer(uint8_t requested_size) {
 /* static */
 void Seq::SendLater(uint8_t note, uint8_t velocity, uint8_t when, uint8_t tag) {
 #ifndef MIDIOUT_DEBUG_OUTPUT  
-  event_scheduler.Schedule(note, velocity, when, tag);
+  if (!event_scheduler.Schedule(note, velocity, when, tag) && !velocity) {
+    // Queue is full, a short note is better than a stuck one
+    Send3(0x80 | TagChannel(tag, channel_), note, 0);
+  }
   if (!clock.running()) {
     clock.Start();
   }
@@ -991,10 +1501,11 @@ void Seq::SendScheduledNotes(uint8_t channel) {
       break;
     }
     if (entry.note != kZombieSlot) {
+      uint8_t note_channel = TagChannel(entry.tag, channel);
       if (entry.velocity == 0) {
-        Send3(0x80 | channel, entry.note, 0);
+        Send3(0x80 | note_channel, entry.note, 0);
       } else {
-        Send3(0x90 | channel, entry.note, entry.velocity);
+        Send3(0x90 | note_channel, entry.note, entry.velocity);
       }
     }
     current = entry.next;
@@ -1002,8 +1513,63 @@ void Seq::SendScheduledNotes(uint8_t channel) {
   event_scheduler.Tick();
 }
 
+/* static */
+uint16_t Seq::TimeToNextNoteOn() {
+  uint8_t sreg = SREG;
+  cli();
+
+  // Ticks before the next step. With the divided clocks, the steps are
+  // skipped until the division counter wraps, and any tick can start the
+  // step of some track in the track link mode.
+  uint16_t ticks = midi_clock_prescaler_ - tick_;
+  if (link_mode_ != LINK_MODE_TRACKS) {
+    uint8_t mask = (1 << clock_division_) - 1;
+    ticks += midi_clock_prescaler_ * ((mask - (clock_division_counter_ & mask)) & mask);
+  }
+  uint8_t ticks_per_step = midi_clock_prescaler_ << active_clock_division();
+  uint16_t duration = step_duration_;
+  uint8_t when = event_scheduler.NextNoteOn();
+
+  SREG = sreg;
+
+  // The current tick is partly elapsed
+  --ticks;
+  if (when < ticks) {
+    ticks = when;
+  }
+  return static_cast<uint32_t>(ticks) * duration / ticks_per_step;
+}
+
+/* static */
+uint8_t Seq::TagChannel(uint8_t tag, uint8_t channel) {
+  return tag & kTrackTag ? tag & 0x0f : channel;
+}
+
+/* static */
+uint8_t Seq::PendingNoteOffs(uint8_t channel) {
+  // The note offs of the ratchets and delayed notes not played yet don't
+  // count: each one follows its own note on, still waiting in the queue
+  int8_t count = 0;
+  uint8_t current = event_scheduler.root();
+  while (current) {
+    const SchedulerEntry& entry = event_scheduler.entry(current);
+    if (entry.note != kZombieSlot && TagChannel(entry.tag, channel_) == channel) {
+      if (entry.velocity == 0) {
+        ++count;
+      } else
+      if (entry.when) {
+        --count;
+      }
+    }
+    current = entry.next;
+  }
+  return count;
+}
+
 /* static */
 void Seq::FlushQueue(uint8_t channel) {
+  // Pending ratchets and delayed notes are dropped, only the note offs are sent
+  event_scheduler.RemoveNoteOns();
   while (event_scheduler.size()) {
     SendScheduledNotes(channel);
   }
@@ -1020,18 +1586,19 @@ void Seq::ToggleRun() {
 /* static */
 void Seq::StopRecording() {
   if (recording_) {
-    recording_ = 0;
+    set_recording(0);
   }
 }
 
 /* static */
 void Seq::StartRecording() {
   if (!recording_) {
-    step_ = 0;
+    set_step(0);
     direction_ = DIRECTION_FORWARD;
     last_note_ = root_note_;
     last_recorded_step_ = 0xff;
-    recording_ = 1;
+    ResetRecordedNotes();
+    set_recording(1);
   }
 }
 
@@ -1045,6 +1612,12 @@ void Seq::ToggleRecording() {
 
 /* static */
 void Seq::AdvanceClockDivision() {
+  if (link_mode_ == LINK_MODE_TRACKS) {
+    if (track_clock_division_[seq_] < CLOCK_DIVISION_X4) {
+      track_clock_division_[seq_]++;
+    } else
+      track_clock_division_[seq_] = CLOCK_DIVISION_NONE;
+  } else
   if (clock_division_ < CLOCK_DIVISION_X4) {
     clock_division_++;
   } else
@@ -1065,39 +1638,106 @@ void Seq::CopyTo(uint8_t seq) {
 
 /* static */
 void Seq::SendStep(uint8_t step) {
+  if (link_mode_ == LINK_MODE_TRACKS) {
+    uint8_t channel = track_channel_[seq_];
+    SendStep(seq_, step, channel, kTrackTag | channel, track_[seq_].last_legato_note);
+  } else
+    SendStep(seq_, step, channel_, 0, last_legato_note_);
+}
+
+/* static */
+void Seq::SendStep(uint8_t seq, uint8_t step, uint8_t channel, uint8_t tag, uint8_t& last_legato_note) {
   // Send CCs
-  if (cc1send(step)) {
-    Send3(0xb0 | channel_, cc1_numb(), cc1(step));
+  if (cc1send(seq, step)) {
+    Send3(0xb0 | channel, cc1_numb(), cc1(seq, step));
   }
-  if (cc2send()) {
-    Send3(0xb0 | channel_, cc2_numb(), cc2(step));
+  if (cc2send(seq, step)) {
+    Send3(0xb0 | channel, cc2_numb(), cc2(seq, step));
   }
 
   // Send note if not muted
-  if (velo(step) > 0 && (!mute(step) || manual_step_selected_)) {
+  if (velo(seq, step) == 0 || (mute(seq, step) && !manual_step_selected_))
+    return;
 
-    // Fixup last note
-    if (last_note_ == 0) {
-      last_note_ = root_note_;
-    } 
+  // The trigger attributes are ignored for the steps played from the UI
+  uint8_t step_delay = 0;
+  uint8_t step_ratchets = 1;
+  uint8_t legato = lega(seq, step) && !(step_hold_ || manual_step_selected_);
+  if (!manual_step_selected_) {
+    uint8_t step_prob = prob(seq, step);
+    if (step_prob && (Random::GetByte() >> 5) < step_prob)
+      return;
+    step_delay = delay(seq, step);
+    if (!legato) {
+      step_ratchets = ratchets(seq, step);
+    }
+  }
 
-    // Send note
-    uint8_t the_note = Clip(static_cast<int16_t>(note(step)) + last_note_ - root_note_, 0, 0x7f);
-    Send3(0x90 | channel_, the_note, velo(step));
+  // A delayed note on is scheduled with its note off and the release of
+  // the previous legato note, so each ratchet needs 2 free entries and the
+  // release 1. The attributes are dropped if the scheduler runs out of room,
+  // rather than risking a note on without its note off.
+  uint8_t room = event_scheduler.room();
+  if (room < step_ratchets * 2 + 1) {
+    step_ratchets = room > 2 ? (room - 1) >> 1 : 1;
+    if (room < 3) {
+      step_delay = 0;
+    }
+  }
+
+  // Fixup last note
+  if (last_note_ == 0) {
+    last_note_ = root_note_;
+  } 
+
+  uint8_t the_note = Clip(static_cast<int16_t>(note(seq, step)) + last_note_ - root_note_, 0, 0x7f);
+  uint8_t velocity = velo(seq, step);
+  uint8_t duration = NoteDuration::GetMidiClockTicks(gate(seq, step));
+
+  // Ratchets are cut a tick before the next one or the end of the step, so
+  // that gates retrigger
+  uint8_t division = link_mode_ == LINK_MODE_TRACKS ? track_clock_division_[seq] : clock_division_;
+  const uint8_t* ratchet_ticks = ratchet_ticks_[division] + (((step_ratchets - 1) * (step_ratchets - 2)) >> 1);
+  uint8_t step_ticks = min(midi_clock_prescaler_ << division, 0xff);
+
+  uint8_t start = 0;
+  for (uint8_t n = 0; n < step_ratchets; n++) {
+    uint8_t end = n + 1 < step_ratchets ? ratchet_ticks[n] : step_ticks;
+    uint8_t length = duration;
+    if (step_ratchets > 1) {
+      if (end == start)
+        continue;
+      length = min(length, end - start > 1 ? end - start - 1 : 1);
+    }
+    uint8_t when = min(step_delay + start, 0xff);
+    start = end;
+
+    // Send note, the CV glides from a legato note
+    if (when == 0) {
+#ifdef ENABLE_CV_OUTPUT
+      cv.set_glide(last_legato_note != 0xff);
+#endif
+      Send3(0x90 | channel, the_note, velocity);
+#ifdef ENABLE_CV_OUTPUT
+      cv.set_glide(0);
+#endif
+    } else
+      SendLater(the_note, velocity, when - 1, tag);
 
     // Release previous legato note if any
-    if (last_legato_note_ != 0xff) {
-      Send3(0x80 | channel_, last_legato_note_, 0);
-      last_legato_note_ = 0xff;
+    if (last_legato_note != 0xff) {
+      if (when == 0) {
+        Send3(0x80 | channel, last_legato_note, 0);
+      } else
+        SendLater(last_legato_note, 0, when - 1, tag);
+      last_legato_note = 0xff;
     }
 
     // Schedule note off
-    if (lega(step) && !(step_hold_ || manual_step_selected_)) {
-      last_legato_note_ = the_note;
-    } else {
-      uint8_t duration = NoteDuration::GetMidiClockTicks(gate(step));
-      SendLater(the_note, 0, duration - 1);
-    }
+    if (legato) {
+      last_legato_note = the_note;
+    } else
+      SendLater(the_note, 0, min(when + length - 1, 0xff), tag);
   }
 }
 
@@ -1164,12 +1804,19 @@ uint16_t Seq::CalcCrc16(uint16_t crc16) {
 
   crc16 = _crc16_update(crc16, seq_switch_mode_);
 
+  for (uint8_t n = 0; n < 4; n++) {
+    crc16 = _crc16_update(crc16, track_channel_[n]);
+    crc16 = _crc16_update(crc16, track_direction_[n]);
+    crc16 = _crc16_update(crc16, track_clock_division_[n]);
+  }
+
   crc16 = lfo.CalcCrc16(crc16);
 
   // These are not part of the sequence data but we track/save them anyway
   crc16 = _crc16_update(crc16, prog_change_flags_);
   crc16 = _crc16_update(crc16, ctrl_change_flags_);
   crc16 = _crc16_update(crc16, strobe_width_);
+  crc16 = _crc16_update(crc16, record_latency_);
 
   return crc16;
 }
@@ -1178,6 +1825,7 @@ uint16_t Seq::CalcCrc16(uint16_t crc16) {
 void Seq::LoadSeqData(uint8_t seq, const SeqData& data) {
   memcpy(&data_[seq], &data, sizeof(data));
   VerifySeqData(seq);
+  Invalidate(SEQ_CHANGE_PROGRAM);
 }
 
 /* static */
@@ -1193,6 +1841,7 @@ void Seq::LoadFromIntEeprom(const uint8_t* p) {
   eeprom_read_block(&info, p, sizeof(SeqInfo)); p+= sizeof(SeqInfo);
   eeprom_read_block(&data_[0], p, sizeof(data_)); p+= sizeof(data_);
   LoadSeqInfo(info);
+  MigrateSeqData(info.data_version_);
   VerifySeqData();
 }
 
@@ -1221,7 +1870,9 @@ void Seq::LoadFromStorage(uint8_t slot) {
   if (storage.ReadSeqInfo(slot, &info)) {
     LoadSeqInfo(info); info.slot_ = slot_;
     storage.ReadSeqData(slot, &data_[0], sizeof(data_));
+    MigrateSeqData(info.data_version_);
     VerifySeqData(); set_slot(slot); 
+    Invalidate(SEQ_CHANGE_PROGRAM);
   }
 }
 
@@ -1250,6 +1901,10 @@ void Seq::SaveSeqInfo(SeqInfo& info) {
   memcpy(info.cv_mode_, cv_mode_, sizeof(cv_mode_));
   memcpy(info.gate_mode_, gate_mode_, sizeof(gate_mode_));
   info.seq_switch_mode_ = seq_switch_mode_;
+  for (uint8_t n = 0; n < 4; n++) {
+    info.track_settings_[n] = track_channel_[n] | (track_direction_[n] << 4) | (track_clock_division_[n] << 6);
+  }
+  info.data_version_ = kSeqDataVersion;
   lfo.SaveLfoInfo(info);
 }
 
@@ -1266,7 +1921,6 @@ void Seq::LoadSeqInfo(const SeqInfo& info) {
   groove_template_ = Verify(info.groove_template_, 0, kNumGrooveTemplates - 1, 0);
   groove_amount_ = Verify(info.groove_amount_, 0, 127, 0);
   root_note_ = Verify(info.root_note_, 0, 127, kDefRootNote);
-  link_mode_ = Verify(info.link_mode_, LINK_MODE_NONE, LINK_MODE_32, LINK_MODE_NONE);
   cc1_numb_ = Verify(info.cc1_numb_, 0, 127, kDefCC1Numb);
   cc2_numb_ = Verify(info.cc2_numb_, 0, 127, kDefCC2Numb);
   steps_forward_ = Verify(info.steps_forward_, 0, kNumSteps, 0);
@@ -1288,6 +1942,21 @@ void Seq::LoadSeqInfo(const SeqInfo& info) {
 
   seq_switch_mode_ = Verify(info.seq_switch_mode_, SEQ_SWITCH_MODE_IMMEDIATE, SEQ_SWITCH_MODE_ONSEQEND, kDefSeqSwitchMode);
 
+  // Programs saved before track mode existed have garbage there
+  for (uint8_t n = 0; n < 4; n++) {
+    uint8_t settings = info.track_settings_[n];
+    if ((settings >> 6) > CLOCK_DIVISION_X4) {
+      settings = n;
+    }
+    track_channel_[n] = settings & 0x0f;
+    track_direction_[n] = (settings >> 4) & 0x03;
+    track_clock_division_[n] = settings >> 6;
+  }
+
+  // Switching to track mode while running starts the tracks, so this comes
+  // after their settings
+  set_link_mode(Verify(info.link_mode_, LINK_MODE_NONE, LINK_MODE_TRACKS, LINK_MODE_NONE));
+
 #ifdef ENABLE_CV_OUTPUT
   port.UpdateCvOffset();
   port.UpdateGateInvert();
@@ -1297,6 +1966,8 @@ void Seq::LoadSeqInfo(const SeqInfo& info) {
   
   UpdateClock();
   UpdatePrescaler();
+
+  Invalidate(SEQ_CHANGE_PROGRAM);
 }
 
 /* static */
@@ -1320,6 +1991,13 @@ void Seq::VerifySeqData() {
   }
 }
 
+/* static */
+void Seq::MigrateSeqData(uint8_t version) {
+  for (uint8_t n = 0; n < numbof(data_); n++) {
+    data_[n].Migrate(version);
+  }
+}
+
 /* static */
 void Seq::FixSeqName(uint8_t* name) {
   for (uint8_t n = 0; n < kNameLength; n++) {
@@ -1350,7 +2028,7 @@ uint8_t Seq::HandleCC(uint8_t channel, uint8_t controller, uint8_t value) {
       break;
 
     case kCCSetLinkMode:
-      if (value <= LINK_MODE_32) {
+      if (value <= LINK_MODE_TRACKS) {
         set_link_mode(value);
       }
       break;
@@ -1427,6 +2105,11 @@ SetBpm: set_bpm(Clip(setting, kMinBpm, kMaxBpm));
 
 /* static */
 void Seq::RotLSeq() {
+  if (link_mode_ == LINK_MODE_TRACKS) {
+    RotLSeq(seq_);
+    return;
+  }
+
   // Find out number of virtual steps
   uint8_t num_steps = kNumSteps << link_mode_;
 
@@ -1477,6 +2160,11 @@ void Seq::RotLSeq() {
 
 /* static */
 void Seq::RotRSeq() {
+  if (link_mode_ == LINK_MODE_TRACKS) {
+    RotRSeq(seq_);
+    return;
+  }
+
   // Find out number of virtual steps
   uint8_t num_steps = kNumSteps << link_mode_;
 
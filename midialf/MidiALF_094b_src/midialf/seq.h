@@ -28,6 +28,13 @@
 
 namespace midialf {
 
+// Format of the sequence data, stored with the program to migrate older ones
+static const uint8_t kSeqDataVersion = 1;
+
+static const uint8_t kNumProbLevels = 8;
+static const uint8_t kMaxRatchets = 4;
+static const uint8_t kMaxStepDelay = 3;
+
 class SeqData {
 public:
 
@@ -39,23 +46,50 @@ public:
   void RotR();
 
   void Verify();
+  void Migrate(uint8_t version);
 
-  inline uint8_t note(uint8_t step) { return note_[step]; }
-  inline uint8_t velo(uint8_t step) { return velo_[step]; }
-  inline uint8_t gate(uint8_t step) { return gate_[step]; }
-  inline uint8_t cc1(uint8_t step) { return cc1_[step]; }
-  inline uint8_t cc2(uint8_t step) { return cc2_[step]; }
+  inline uint8_t note(uint8_t step) { return note_[step] & 0x7f; }
+  inline uint8_t velo(uint8_t step) { return velo_[step] & 0x7f; }
+  inline uint8_t gate(uint8_t step) { return gate_[step] & 0x1f; }
+  inline uint8_t cc1(uint8_t step) { return cc1_[step] & 0x7f; }
+  inline uint8_t cc2(uint8_t step) { return cc2_[step] & 0x7f; }
   inline uint8_t mute(uint8_t step) { return mute_ & (1 << step); }
   inline uint8_t skip(uint8_t step) { return skip_ & (1 << step); }
   inline uint8_t lega(uint8_t step) { return lega_ & (1 << step); }
   inline uint8_t cc1send(uint8_t step) { return cc1send_ & (1 << step); }
   inline uint8_t cc2send(uint8_t step) { return cc2send_ & (1 << step); }
 
-  inline void set_note(uint8_t step, uint8_t value) { note_[step] = value; }
-  inline void set_velo(uint8_t step, uint8_t value) { velo_[step] = value; }
-  inline void set_gate(uint8_t step, uint8_t value) { gate_[step] = value; }
-  inline void set_cc1(uint8_t step, uint8_t value) { cc1_[step] = value; }
-  inline void set_cc2(uint8_t step, uint8_t value) { cc2_[step] = value; }
+  inline void set_note(uint8_t step, uint8_t value) { note_[step] = (note_[step] & 0x80) | (value & 0x7f); }
+  inline void set_velo(uint8_t step, uint8_t value) { velo_[step] = (velo_[step] & 0x80) | (value & 0x7f); }
+  inline void set_gate(uint8_t step, uint8_t value) { gate_[step] = (gate_[step] & 0xe0) | (value & 0x1f); }
+  inline void set_cc1(uint8_t step, uint8_t value) { cc1_[step] = (cc1_[step] & 0x80) | (value & 0x7f); }
+  inline void set_cc2(uint8_t step, uint8_t value) { cc2_[step] = (cc2_[step] & 0x80) | (value & 0x7f); }
+
+  // Trigger attributes, packed in the bits the step values leave unused so
+  // that the slot layout doesn't change: the probability level in the top 3
+  // bits of the gate, the number of ratchets - 1 in the top bits of the note
+  // and velocity, and the delay in clock ticks in the top bits of cc1/cc2.
+  // All zero is a step always played, once and on time.
+  inline uint8_t prob(uint8_t step) { return gate_[step] >> 5; }
+  inline uint8_t ratchets(uint8_t step) {
+    return 1 + (note_[step] >> 7) + ((velo_[step] >> 6) & 2);
+  }
+  inline uint8_t delay(uint8_t step) {
+    return (cc1_[step] >> 7) + ((cc2_[step] >> 6) & 2);
+  }
+
+  inline void set_prob(uint8_t step, uint8_t value) {
+    gate_[step] = (gate_[step] & 0x1f) | (value << 5);
+  }
+  inline void set_ratchets(uint8_t step, uint8_t value) {
+    --value;
+    note_[step] = (note_[step] & 0x7f) | ((value & 1) << 7);
+    velo_[step] = (velo_[step] & 0x7f) | ((value & 2) << 6);
+  }
+  inline void set_delay(uint8_t step, uint8_t value) {
+    cc1_[step] = (cc1_[step] & 0x7f) | ((value & 1) << 7);
+    cc2_[step] = (cc2_[step] & 0x7f) | ((value & 2) << 6);
+  }
   inline void set_mute(uint8_t step, uint8_t value) { value ? mute_ |= (1 << step) : mute_ &= ~(1 << step); }
   inline void set_skip(uint8_t step, uint8_t value) { value ? skip_ |= (1 << step) : skip_ &= ~(1 << step); }
   inline void set_lega(uint8_t step, uint8_t value) { value ? lega_ |= (1 << step) : lega_ &= ~(1 << step); }
@@ -133,9 +167,51 @@ class SeqInfo {
 
   uint8_t seq_switch_mode_;
 
+  uint8_t lfo_output_[kNumLfos];
+
+  // Channel, direction and clock division of each track in LINK_MODE_TRACKS,
+  // packed as ddrrcccc.
+  uint8_t track_settings_[4];
+
+  uint8_t data_version_;  // kSeqDataVersion, padding in older programs
+
   void Init(uint8_t slot = 0);
 };
 
+// Note played while recording in real time, waiting for the step it belongs
+// to and for its note off
+struct RecordedNote {
+  uint8_t note;  // 0xff for free entry
+  uint8_t velocity;
+  uint8_t seq;
+  uint8_t step;  // 0xff until merged into the sequence
+  uint16_t time;  // ms, input latency removed
+  uint16_t duration;  // ms, 0 until the note off is received
+};
+
+static const uint8_t kNumRecordedNotes = 4;
+
+// Number of steps the step duration is measured over while recording. The
+// swing and shuffle grooves cancel out over 4 steps.
+static const uint8_t kNumTimedSteps = 4;
+
+// Running state of a sequence played as a track in LINK_MODE_TRACKS
+struct TrackState {
+  uint8_t step;
+  uint8_t clock_division_counter;
+  uint8_t pendulum_backward;
+  uint8_t last_legato_note;
+};
+
+// Sequencer state the Ui display and leds depend on
+enum SeqChange {
+  SEQ_CHANGE_STEP = 1,  // current step
+  SEQ_CHANGE_SEQ = 2,  // current or requested sequence
+  SEQ_CHANGE_TRANSPORT = 4,  // running, recording or manual step
+  SEQ_CHANGE_PROGRAM = 8,  // program settings or sequence data loaded
+  SEQ_CHANGE_ALL = 0x0f,
+};
+
 class Seq {
  public:
   Seq() {}
@@ -156,6 +232,7 @@ class Seq {
   static void OnStart();
   static void OnContinue();
   static void OnStop();
+  static void OnSongPosition(uint16_t position);
 
   static uint8_t CheckChannel(uint8_t channel);
   
@@ -188,8 +265,17 @@ class Seq {
   static uint8_t seq() { return seq_; }
   static uint8_t step() { return step_; }
   
-  static void set_seq(uint8_t seq) { seq_ = seq & 0x03; }
-  static void set_step(uint8_t step) { step_ = step & 0x07; }
+  static void set_seq(uint8_t seq) {
+    seq&= 0x03; if (seq != seq_) { seq_ = seq; Invalidate(SEQ_CHANGE_SEQ); }
+  }
+  static void set_step(uint8_t step) {
+    step&= 0x07; if (step != step_) { step_ = step; Invalidate(SEQ_CHANGE_STEP); }
+  }
+
+  // Change flags raised by the state setters and consumed by the Ui, which
+  // only refreshes the leds and the page that depend on what changed
+  static void Invalidate(uint8_t changes);
+  static uint8_t TakeChanges();
 
   static uint8_t note() { return note(seq_, step_); }
   static uint8_t velo() { return velo(seq_, step_); }
@@ -212,6 +298,9 @@ class Seq {
   static uint8_t lega(uint8_t step) { return lega(seq_, step); }
   static uint8_t cc1send(uint8_t step) { return cc1send(seq_, step); }
   static uint8_t cc2send(uint8_t step) { return cc2send(seq_, step); }
+  static uint8_t prob(uint8_t step) { return prob(seq_, step); }
+  static uint8_t ratchets(uint8_t step) { return ratchets(seq_, step); }
+  static uint8_t delay(uint8_t step) { return delay(seq_, step); }
 
   static uint8_t note(uint8_t seq, uint8_t step) { return data_[seq].note(step); }
   static uint8_t velo(uint8_t seq, uint8_t step) { return data_[seq].velo(step); }
@@ -223,6 +312,9 @@ class Seq {
   static uint8_t lega(uint8_t seq, uint8_t step) { return data_[seq].lega(step); }
   static uint8_t cc1send(uint8_t seq, uint8_t step) { return data_[seq].cc1send(step); }
   static uint8_t cc2send(uint8_t seq, uint8_t step) { return data_[seq].cc2send(step); }
+  static uint8_t prob(uint8_t seq, uint8_t step) { return data_[seq].prob(step); }
+  static uint8_t ratchets(uint8_t seq, uint8_t step) { return data_[seq].ratchets(step); }
+  static uint8_t delay(uint8_t seq, uint8_t step) { return data_[seq].delay(step); }
 
   static void set_note(uint8_t value) { set_note(seq_, step_, value); }
   static void set_velo(uint8_t value) { set_velo(seq_, step_, value); }
@@ -245,6 +337,9 @@ class Seq {
   static void set_lega(uint8_t step, uint8_t value) { set_lega(seq_, step, value); }
   static void set_cc1send(uint8_t step, uint8_t value) { set_cc1send(seq_, step, value); }
   static void set_cc2send(uint8_t step, uint8_t value) { set_cc2send(seq_, step, value); }
+  static void set_prob(uint8_t step, uint8_t value) { set_prob(seq_, step, value); }
+  static void set_ratchets(uint8_t step, uint8_t value) { set_ratchets(seq_, step, value); }
+  static void set_delay(uint8_t step, uint8_t value) { set_delay(seq_, step, value); }
 
   static void set_note(uint8_t seq, uint8_t step, uint8_t value) { data_[seq].set_note(step, value); }
   static void set_velo(uint8_t seq, uint8_t step, uint8_t value) { data_[seq].set_velo(step, value); }
@@ -256,6 +351,9 @@ class Seq {
   static void set_lega(uint8_t seq, uint8_t step, uint8_t value) { data_[seq].set_lega(step, value); }
   static void set_cc1send(uint8_t seq, uint8_t step, uint8_t value) { data_[seq].set_cc1send(step, value); }
   static void set_cc2send(uint8_t seq, uint8_t step, uint8_t value) { data_[seq].set_cc2send(step, value); }
+  static void set_prob(uint8_t seq, uint8_t step, uint8_t value) { data_[seq].set_prob(step, value); }
+  static void set_ratchets(uint8_t seq, uint8_t step, uint8_t value) { data_[seq].set_ratchets(step, value); }
+  static void set_delay(uint8_t seq, uint8_t step, uint8_t value) { data_[seq].set_delay(step, value); }
 
   static uint8_t mute_mask(uint8_t seq) { return data_[seq].mute_mask(); }
   static uint8_t skip_mask(uint8_t seq) { return data_[seq].skip_mask(); }
@@ -302,7 +400,7 @@ class Seq {
   static void set_clock_rate(uint8_t clock_rate) { clock_rate_ = clock_rate; UpdatePrescaler(); }
 
   static uint8_t clock_mode() { return clock_mode_; }
-  static void set_clock_mode(uint8_t clock_mode) { clock_mode_ = clock_mode; }
+  static void set_clock_mode(uint8_t clock_mode) { clock_mode_ = clock_mode; UpdateClock(); }
 
   static uint8_t clock_division() { return clock_division_; }
   static void set_clock_division(uint8_t clock_division) { clock_division_ = clock_division; }
@@ -320,7 +418,7 @@ class Seq {
   static void set_root_note(uint8_t root_note) { root_note_ = root_note; }
 
   static uint8_t link_mode() { return link_mode_; }
-  static void set_link_mode(uint8_t link_mode) { link_mode_ = link_mode; }
+  static void set_link_mode(uint8_t link_mode);
 
   static uint8_t cc1_numb() { return cc1_numb_; }
   static void set_cc1_numb(uint8_t cc1_numb) { cc1_numb_ = cc1_numb; }
@@ -361,6 +459,19 @@ class Seq {
   static uint8_t seq_switch_mode() { return seq_switch_mode_; }
   static void set_seq_switch_mode(uint8_t seq_switch_mode) { seq_switch_mode_ = seq_switch_mode; }
 
+  static uint8_t track_channel(uint8_t track) { return track_channel_[track]; }
+  static void set_track_channel(uint8_t track, uint8_t channel) { track_channel_[track] = channel; }
+
+  static uint8_t track_direction(uint8_t track) { return track_direction_[track]; }
+  static void set_track_direction(uint8_t track, uint8_t direction) { track_direction_[track] = direction; }
+
+  static uint8_t track_clock_division(uint8_t track) { return track_clock_division_[track]; }
+  static void set_track_clock_division(uint8_t track, uint8_t clock_division) { track_clock_division_[track] = clock_division; }
+
+  // Clock division shown and changed by the CLK switch
+  static uint8_t active_clock_division() {
+    return link_mode_ == LINK_MODE_TRACKS ? track_clock_division_[seq_] : clock_division_; }
+
   static uint8_t running() { return running_; }
   static uint8_t recording() { return recording_; }
   static uint8_t last_note() { return last_note_; }
@@ -369,7 +480,11 @@ class Seq {
   static void set_step_hold(uint8_t step_hold) { step_hold_ = step_hold; }
 
   static uint8_t manual_step_selected() { return manual_step_selected_; }
-  static void set_manual_step_selected(uint8_t manual_step_selected) { manual_step_selected_ = manual_step_selected; }
+  static void set_manual_step_selected(uint8_t manual_step_selected) {
+    if (manual_step_selected != manual_step_selected_) {
+      manual_step_selected_ = manual_step_selected; Invalidate(SEQ_CHANGE_TRANSPORT);
+    }
+  }
 
   static uint8_t prog_change_flags() { return prog_change_flags_; }
   static void set_prog_change_flags(uint8_t prog_change_flags) { prog_change_flags_ = prog_change_flags; }
@@ -380,6 +495,9 @@ class Seq {
   static uint8_t strobe_width() { return strobe_width_; }
   static void set_strobe_width(uint8_t strobe_width) { strobe_width_ = strobe_width; UpdateStrobeWidth(); }
 
+  static uint8_t record_latency() { return record_latency_; }
+  static void set_record_latency(uint8_t record_latency) { record_latency_ = record_latency; }
+
   static uint8_t last_received_note() { return last_received_note_; }
   static uint8_t last_received_cc() { return last_received_cc_; }
 
@@ -388,6 +506,10 @@ class Seq {
   static uint8_t tick() { return tick_; }
   static void set_tick(uint8_t tick) { tick_ = tick; }
 
+  // Milliseconds left before the next note on, played by a step or
+  // scheduled by the ratchets and delays. 0 until the steps are timed.
+  static uint16_t TimeToNextNoteOn();
+
   // Operations
 
   static void SetSeq(uint8_t seq);
@@ -465,14 +587,35 @@ class Seq {
   static void Tick();
   static void AdvanceStep();
   static void AdvanceStep(uint8_t direction);
+  static void NextStep(uint8_t progress);
+  static void UpdateNextSeq();
   static void UpdateClock();
   static void UpdatePrescaler();
+  static void UpdateRatchetTicks();
   static void UpdateStrobeWidth();
   static void RecordStep(uint8_t note, uint8_t velocity);
+  static void RecordNoteOn(uint8_t note, uint8_t velocity);
+  static void RecordNoteOff(uint8_t note);
+  static void MergeRecordedNotes();
+  static void MergeRecordedNote(RecordedNote& recorded_note);
+  static void ResetRecordedNotes();
   static uint8_t CheckAllSkipped();
   static uint8_t CountAvailableSteps();
   static uint8_t GetRunningDirection(uint8_t reversed);
   static uint8_t HandleCC(uint8_t channel, uint8_t controller, uint8_t value);
+  static uint8_t num_linked_steps() {
+    return link_mode_ == LINK_MODE_TRACKS ? kNumSteps : kNumSteps << link_mode_; }
+
+  static void SendStep(uint8_t seq, uint8_t step, uint8_t channel, uint8_t tag, uint8_t& last_legato_note);
+  static uint8_t TagChannel(uint8_t tag, uint8_t channel);
+  static uint8_t PendingNoteOffs(uint8_t channel);
+
+  static void StartTracks();
+  static void StopTracks();
+  static void Locate(uint16_t position);
+  static uint8_t NumStepsInCycle(uint8_t direction, uint8_t available_steps);
+  static void TickTracks();
+  static void AdvanceTrack(uint8_t track);
   
   // Persistent data, see State.h/.cc
   static SeqData data_[4];
@@ -503,6 +646,10 @@ class Seq {
 
   static uint8_t seq_switch_mode_;
 
+  static uint8_t track_channel_[4];
+  static uint8_t track_direction_[4];
+  static uint8_t track_clock_division_[4];
+
   static const uint8_t kSeqSaveSize = sizeof(SeqInfo) + sizeof(data_);
   
   // Volatile data
@@ -515,6 +662,7 @@ class Seq {
   static uint8_t last_note_;
   static uint8_t pendulum_backward_;
   static uint8_t midi_clock_prescaler_;
+  static uint8_t ratchet_ticks_[CLOCK_DIVISION_X4 + 1][kMaxRatchets * (kMaxRatchets - 1) / 2];
   static uint8_t clock_division_counter_;
   static uint8_t steps_forward_counter_;
   static uint8_t steps_replay_counter_;
@@ -527,6 +675,14 @@ class Seq {
   static uint8_t next_seq_;
   static uint8_t last_recorded_step_;
   static uint8_t last_recorded_seq_;
+  static RecordedNote recorded_notes_[kNumRecordedNotes];
+  static uint16_t step_time_;
+  static uint16_t prev_step_times_[kNumTimedSteps];
+  static uint16_t step_duration_;
+  static uint8_t timed_steps_;
+  static uint8_t record_seq_;
+  static uint8_t record_step_;
+  static uint8_t record_latency_;
   static uint8_t last_legato_note_;
   static uint8_t manual_step_selected_;
   static uint8_t bank_select_msb_;
@@ -537,11 +693,25 @@ class Seq {
   static uint8_t last_received_note_;
   static uint8_t last_received_cc_;
   static uint8_t request_set_seq_;
+  static uint16_t song_position_;
+  static volatile uint8_t changes_;
+  static TrackState track_[4];
 
   static NoteStack<16> note_stack_;
 
   static void VerifySeqData(uint8_t seq) { data_[seq].Verify(); }
   static void VerifySeqData();
+  static void MigrateSeqData(uint8_t version);
+
+  static void set_running(uint8_t running) {
+    if (running != running_) { running_ = running; Invalidate(SEQ_CHANGE_TRANSPORT); }
+  }
+  static void set_recording(uint8_t recording) {
+    if (recording != recording_) { recording_ = recording; Invalidate(SEQ_CHANGE_TRANSPORT); }
+  }
+  static void set_request_set_seq(uint8_t request_set_seq) {
+    if (request_set_seq != request_set_seq_) { request_set_seq_ = request_set_seq; Invalidate(SEQ_CHANGE_SEQ); }
+  }
 
   DISALLOW_COPY_AND_ASSIGN(Seq);
 };
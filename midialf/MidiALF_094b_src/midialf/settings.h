@@ -40,6 +40,7 @@ enum LinkMode {
   LINK_MODE_NONE,
   LINK_MODE_16,
   LINK_MODE_32,
+  LINK_MODE_TRACKS,  // All 4 sequences play at once as independent tracks
 };
 
 enum SeqSwitchMode {
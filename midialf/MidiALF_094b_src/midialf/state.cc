@@ -27,13 +27,14 @@ namespace midialf {
 State state;
 
 struct StateData {
-  static const uint16_t kMagicWord = 0xbad0;
+  static const uint16_t kMagicWord = 0xbad3;  // Changes with the layout
   uint16_t magic_;
   uint16_t crc16_;
   uint8_t seqSave_[Seq::kSeqSaveSize];
   uint8_t prog_change_flags_;
   uint8_t ctrl_change_flags_;
   uint8_t strobe_width_;
+  uint8_t record_latency_;
 };
 
 StateData EEMEM stateData;
@@ -61,6 +62,7 @@ void State::Save() {
   eeprom_update_byte(&stateData.prog_change_flags_, seq.prog_change_flags());
   eeprom_update_byte(&stateData.ctrl_change_flags_, seq.ctrl_change_flags());
   eeprom_update_byte(&stateData.strobe_width_, seq.strobe_width());
+  eeprom_update_byte(&stateData.record_latency_, seq.record_latency());
 }
 
 /* static */
@@ -84,6 +86,10 @@ void State::Load() {
     seq.Verify(eeprom_read_byte(&stateData.strobe_width_), 
       kMinStrobeWidth, kMaxStrobeWidth, kDefStrobeWidth));
 
+  seq.set_record_latency(
+    seq.Verify(eeprom_read_byte(&stateData.record_latency_), 
+      0, kMaxRecordLatency, kDefRecordLatency));
+
 #ifdef MIDIOUT_DEBUG_OUTPUT  
   //printf("State::Load: crc16=%04x size=%d\n", crc16_, sizeof(StateData));
 #endif
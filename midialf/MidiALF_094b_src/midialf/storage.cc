@@ -21,11 +21,22 @@
 
 #include "midialf/storage.h"
 
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+
 using namespace avrlib;
 
 namespace midialf {
 
-ExternalEeprom<kMaxNumBanks * kBankSize, I2cMaster<8, 64, 400000> > external_eeprom;
+ExternalEeprom<kBankSize, I2cMaster<8, 64, 400000> > external_eeprom;
+
+uint16_t EEMEM eememSlotIndexMagic;
+
+enum BulkOperation {
+  BULK_COPY,
+  BULK_INIT,
+  BULK_SWAP,
+};
 
 /* extern */
 Storage storage;
@@ -56,6 +67,11 @@ void Storage::Init() {
     --num_accessible_banks_;
     address -= kBankSize;
   }
+  // Make sure the slot checksum index is there.
+  if (num_slots() && eeprom_read_word(&eememSlotIndexMagic) != index_magic()) {
+    RebuildIndex();
+    eeprom_update_word(&eememSlotIndexMagic, index_magic());
+  }
 #ifdef MIDIOUT_DEBUG_OUTPUT  
   //printf("Storage::Init: num_accessible_banks=%u\n", num_accessible_banks_);
 #endif
@@ -74,7 +90,7 @@ uint16_t Storage::ReadExternal(uint8_t* data, uint16_t address, uint8_t size) {
 /* static */
 uint8_t Storage::ReadSlotName(uint8_t slot, uint8_t* name) {
   uint16_t address = kSlotSize * slot;
-  if (address + kSlotSize > addressable_space_size())
+  if (slot >= num_slots())
     return 0;
 
   uint16_t read = ReadExternal(name, address, kNameLength);
@@ -89,20 +105,22 @@ uint8_t Storage::ReadSlotName(uint8_t slot, uint8_t* name) {
 /* static */
 uint8_t Storage::WriteSlotName(uint8_t slot, const uint8_t* name) {
   uint16_t address = kSlotSize * slot;
-  if (address + kSlotSize > addressable_space_size())
+  if (slot >= num_slots())
     return 0;
 
   uint16_t written = WriteExternal(name, address, kNameLength);
   if (written != kNameLength)
     return 0;
 
+  UpdateSlotCrc(slot);
+
   return written;
 }
 
 /* static */
 uint8_t Storage::ReadSeqInfo(uint8_t slot, SeqInfo* info) {
   uint16_t address = kSlotSize * slot;
-  if (address + kSlotSize > addressable_space_size())
+  if (slot >= num_slots())
     return 0;
 
   uint16_t read = ReadExternal((uint8_t*)info, address, sizeof(SeqInfo));
@@ -117,7 +135,7 @@ uint8_t Storage::ReadSeqInfo(uint8_t slot, SeqInfo* info) {
 /* static */
 uint8_t Storage::WriteSeqInfo(uint8_t slot, const SeqInfo* info) {
   uint16_t address = kSlotSize * slot;
-  if (address + kSlotSize > addressable_space_size())
+  if (slot >= num_slots())
     return 0;
 
   // This takes about 7ms
@@ -125,13 +143,15 @@ uint8_t Storage::WriteSeqInfo(uint8_t slot, const SeqInfo* info) {
   if (written != sizeof(SeqInfo))
     return 0;
 
+  UpdateSlotCrc(slot);
+
   return written;
 }
  
 /* static */
 uint8_t Storage::ReadSeqData(uint8_t slot, SeqData* data, uint8_t size) {
   uint16_t address = kSlotSize * slot;
-  if (address + kSlotSize > addressable_space_size())
+  if (slot >= num_slots())
     return 0;
 
   uint16_t read = ReadExternal((uint8_t*)data, address + kSeqDataOffset, size);
@@ -144,14 +164,212 @@ uint8_t Storage::ReadSeqData(uint8_t slot, SeqData* data, uint8_t size) {
 /* static */
 uint8_t Storage::WriteSeqData(uint8_t slot, const SeqData* data, uint8_t size) {
   uint16_t address = kSlotSize * slot;
-  if (address + kSlotSize > addressable_space_size())
+  if (slot >= num_slots())
     return 0;
 
   uint16_t written = WriteExternal((uint8_t*)data, address + kSeqDataOffset, size);
   if (written != size)
     return 0;
 
+  UpdateSlotCrc(slot);
+
   return written;
 }
+
+/* static */
+uint8_t Storage::ReadSlotIndex(uint8_t slot, uint8_t count, uint16_t* crcs) {
+  if (slot + count > num_slots())
+    return 0;
+
+  uint16_t address = kSlotSize * slot + kSlotCrcOffset;
+  for (uint8_t n = 0; n < count; n++, address+= kSlotSize) {
+    if (ReadExternal((uint8_t*)&crcs[n], address, 2) != 2)
+      return 0;
+  }
+
+  return count;
+}
+
+/* static */
+uint8_t Storage::ReadSlotPage(uint8_t slot, uint8_t offset, uint8_t* data, uint8_t size) {
+  uint16_t address = kSlotSize * slot + offset;
+  if (slot >= num_slots())
+    return 0;
+
+  uint16_t read = ReadExternal(data, address, size);
+  if (read != size)
+    return 0;
+
+  return read;
+}
+
+/* static */
+uint8_t Storage::WriteSlotPage(uint8_t slot, uint8_t offset, const uint8_t* data, uint8_t size) {
+  uint16_t address = kSlotSize * slot + offset;
+  if (slot >= num_slots() || offset + size > kSlotCrcOffset)
+    return 0;
+
+  uint16_t written = WriteExternal(data, address, size);
+  if (written != size)
+    return 0;
+
+  if (offset + size == kSlotCrcOffset) {
+    UpdateSlotCrc(slot);
+  }
+
+  return written;
+}
+
+/* static */
+uint16_t Storage::CopySlots(uint8_t from, uint8_t to, uint16_t count, ProgressCallback callback) {
+  return ProcessSlots(BULK_COPY, from, to, count, callback);
+}
+
+/* static */
+uint16_t Storage::MoveSlots(uint8_t from, uint8_t to, uint16_t count, ProgressCallback callback) {
+  uint16_t moved = CopySlots(from, to, count, callback);
+  if (moved != count || from == to)
+    return moved;
+
+  // Initialize the source slots that haven't been overwritten
+  if (to > from) {
+    InitSlots(from, min(count, to - from), callback);
+  } else {
+    uint16_t first = max(from, to + count);
+    InitSlots(first, from + count - first, callback);
+  }
+
+  return moved;
+}
+
+/* static */
+uint16_t Storage::InitSlots(uint8_t slot, uint16_t count, ProgressCallback callback) {
+  return ProcessSlots(BULK_INIT, slot, slot, count, callback);
+}
+
+/* static */
+uint16_t Storage::SwapSlots(uint8_t slot1, uint8_t slot2, uint16_t count, ProgressCallback callback) {
+  if (slot1 < slot2 + count && slot2 < slot1 + count)
+    return 0;
+
+  return ProcessSlots(BULK_SWAP, slot1, slot2, count, callback);
+}
+
+/* static */
+uint16_t Storage::ProcessSlots(uint8_t op, uint8_t from, uint8_t to, uint16_t count, ProgressCallback callback) {
+  uint16_t total = num_slots();
+  if (!count || from + count > total || to + count > total)
+    return 0;
+
+  // Copy overlapping ranges backwards when needed, like memmove()
+  int8_t step = 1;
+  if (op == BULK_COPY && to > from) {
+    from+= count - 1;
+    to+= count - 1;
+    step = -1;
+  }
+
+  for (uint16_t n = 0; n < count; n++, from+= step, to+= step) {
+    if (callback && !(*callback)(to, total))
+      return n;
+    if (op != BULK_COPY || from != to) {
+      ProcessSlot(op, from, to);
+    }
+  }
+
+  return count;
+}
+
+/* static */
+void Storage::ProcessSlot(uint8_t op, uint8_t from, uint8_t to) {
+  // The destination page is always read: the page is only written when
+  // its contents change, which saves most of the 5ms write cycles when
+  // initializing or copying similar programs.
+  uint8_t page[kSlotPageSize];
+  uint8_t other[kSlotPageSize];
+  SeqInfo info(to);
+  SeqData data;
+  uint16_t from_address = kSlotSize * from;
+  uint16_t to_address = kSlotSize * to;
+  uint16_t from_crc16 = 0xffff;
+  uint16_t to_crc16 = 0xffff;
+  for (uint16_t offset = 0; offset < kSlotCrcSize; offset+= kSlotPageSize) {
+    uint8_t size = min(kSlotCrcSize - offset, kSlotPageSize);
+    ReadExternal(other, to_address + offset, size);
+    if (op == BULK_INIT) {
+      // Only the sequence info and data are reset, the padding is kept
+      memcpy(page, other, size);
+      for (uint8_t i = 0; i < size; i++) {
+        uint16_t address = offset + i;
+        if (address < sizeof(SeqInfo)) {
+          page[i] = ((uint8_t*)&info)[address];
+        } else
+        if (address >= kSeqDataOffset && address < kSeqDataOffset + 4 * sizeof(SeqData)) {
+          page[i] = ((uint8_t*)&data)[(address - kSeqDataOffset) % sizeof(SeqData)];
+        }
+      }
+    } else {
+      ReadExternal(page, from_address + offset, size);
+    }
+
+    if (memcmp(page, other, size) != 0) {
+      WriteExternal(page, to_address + offset, size);
+      if (op == BULK_SWAP) {
+        WriteExternal(other, from_address + offset, size);
+      }
+    }
+
+    for (uint8_t i = 0; i < size; i++) {
+      to_crc16 = _crc16_update(to_crc16, page[i]);
+      from_crc16 = _crc16_update(from_crc16, other[i]);
+    }
+  }
+
+  WriteSlotCrc(to, to_crc16);
+  if (op == BULK_SWAP) {
+    WriteSlotCrc(from, from_crc16);
+  }
+}
+
+/* static */
+void Storage::RebuildIndex() {
+  // This reads all the slots, so it takes a few seconds; but it only
+  // happens on first boot with a given memory configuration.
+  uint16_t total = num_slots();
+  for (uint16_t slot = 0; slot < total; slot++) {
+    WriteSlotCrc(slot, CalcSlotCrc(slot));
+  }
+}
+
+/* static */
+uint16_t Storage::CalcSlotCrc(uint8_t slot) {
+  uint8_t data[32];
+  uint16_t address = kSlotSize * slot;
+  uint16_t crc16 = 0xffff;
+  for (uint16_t i = 0; i < kSlotCrcSize; i += sizeof(data)) {
+    uint8_t size = min(kSlotCrcSize - i, static_cast<uint16_t>(sizeof(data)));
+    ReadExternal(data, address + i, size);
+    for (uint8_t n = 0; n < size; n++) {
+      crc16 = _crc16_update(crc16, data[n]);
+    }
+  }
+  return crc16;
+}
+
+/* static */
+void Storage::UpdateSlotCrc(uint8_t slot) {
+  // Reading back the slot takes about 7ms, small change compared to the write.
+  WriteSlotCrc(slot, CalcSlotCrc(slot));
+}
+
+/* static */
+void Storage::WriteSlotCrc(uint8_t slot, uint16_t crc16) {
+  uint16_t address = kSlotSize * slot + kSlotCrcOffset;
+  uint16_t stored;
+  ReadExternal((uint8_t*)&stored, address, 2);
+  if (stored != crc16) {
+    WriteExternal((uint8_t*)&crc16, address, 2);
+  }
+}
  
 }  // midialf
@@ -37,11 +37,24 @@ enum {
   kSlotSize = 256,
   kMaxNumSlots = 256,
   kSeqDataOffset = 64,  // Accomodates sequence info
+  kSlotCrcOffset = kSlotSize - 4,  // Slot checksum, in the padding before the bank marker
+  kSlotCrcSize = kSlotCrcOffset,
+  kSlotPageSize = 32,   // External EEPROM write block
 };
 
-// Currently SeqInfo is 53 bytes, so existing layout allows 11 bytes for SeqInfo extensions and
-// 3 bytes for SeqData extensions. Note that 2 bytes at the end of the last memory block are 
-// garbled by eeprom memory availability check!
+// Currently SeqInfo is 64 bytes, so existing layout allows no more SeqInfo extensions. The 4
+// SeqData take 180 bytes, which leaves 2 bytes for the extensions of each SeqData before the 
+// slot checksum; the step trigger attributes live in the unused top bits of the step values 
+// instead. Note that 2 bytes at the end of the last memory block are garbled by eeprom memory 
+// availability check!
+
+// The slot checksum index is spread over the slots: each one holds a little-endian CRC16 of 
+// its first kSlotCrcSize bytes at kSlotCrcOffset. The checksums are rebuilt by Init() when 
+// the magic word in the internal EEPROM doesn't match the memory configuration, and each one 
+// is updated after every write to its slot, so that a host can tell which slots have changed 
+// without dumping them all.
+
+typedef uint8_t (*ProgressCallback)(uint16_t done, uint16_t total);
 
 class Storage {
  public:
@@ -56,6 +69,23 @@ class Storage {
    
   static uint8_t ReadSeqData(uint8_t slot, SeqData* data, uint8_t size);
   static uint8_t WriteSeqData(uint8_t slot, const SeqData* data, uint8_t size);
+
+  static uint8_t ReadSlotIndex(uint8_t slot, uint8_t count, uint16_t* crcs);
+
+  // Raw slot contents, for the transfers that don't go through the sequencer.
+  // The slot checksum is updated by the write of the last page before it.
+  static uint8_t ReadSlotPage(uint8_t slot, uint8_t offset, uint8_t* data, uint8_t size);
+  static uint8_t WriteSlotPage(uint8_t slot, uint8_t offset, const uint8_t* data, uint8_t size);
+
+  // Bulk operations on ranges of slots. They stream the slots page by page
+  // without going through the sequencer, and skip the pages that already
+  // have the right contents. The callback is called before each slot with
+  // the index of the slot about to be written, and returning 0 cancels the
+  // operation. The number of slots processed is returned.
+  static uint16_t CopySlots(uint8_t from, uint8_t to, uint16_t count, ProgressCallback callback = NULL);
+  static uint16_t MoveSlots(uint8_t from, uint8_t to, uint16_t count, ProgressCallback callback = NULL);
+  static uint16_t InitSlots(uint8_t slot, uint16_t count, ProgressCallback callback = NULL);
+  static uint16_t SwapSlots(uint8_t slot1, uint8_t slot2, uint16_t count, ProgressCallback callback = NULL);
    
   static uint32_t addressable_space_size() {
     return (uint32_t)num_accessible_banks_ * kBankSize;
@@ -69,6 +99,16 @@ class Storage {
   static uint16_t WriteExternal(const uint8_t* data, uint16_t address, uint8_t size);
   static uint16_t ReadExternal(uint8_t* data, uint16_t address, uint8_t size);
 
+  static uint16_t index_magic() { return 0xc500 | num_accessible_banks_; }
+
+  static void RebuildIndex();
+  static uint16_t CalcSlotCrc(uint8_t slot);
+  static void UpdateSlotCrc(uint8_t slot);
+  static void WriteSlotCrc(uint8_t slot, uint16_t crc16);
+
+  static uint16_t ProcessSlots(uint8_t op, uint8_t from, uint8_t to, uint16_t count, ProgressCallback callback);
+  static void ProcessSlot(uint8_t op, uint8_t from, uint8_t to);
+
   static uint8_t num_accessible_banks_;
 };
 
@@ -20,8 +20,6 @@
 // SysEx messages handler class.
 
 #include "midialf/sysex_handler.h"
-#include "midialf/display.h"
-#include "midialf/state.h"
 #include "midialf/ui.h"
 
 namespace midialf {
@@ -37,9 +35,29 @@ uint8_t SysExHandler::buffer_[kSysExBlockSize];
 uint8_t SysExHandler::state_;
 uint8_t SysExHandler::checksum_;
 uint8_t SysExHandler::command_[2];
+uint8_t SysExHandler::program_set_[kMaxNumSlots / 8];
+
+uint8_t SysExHandler::send_state_;
+uint8_t SysExHandler::send_slot_;
+uint16_t SysExHandler::send_next_;
+uint16_t SysExHandler::send_end_;
+const uint8_t* SysExHandler::send_set_;
+uint8_t SysExHandler::send_cmd_;
+uint8_t SysExHandler::send_arg_;
+uint8_t SysExHandler::send_page_;
+uint8_t SysExHandler::send_block_page_;
+uint16_t SysExHandler::send_eox_offset_;
+uint16_t SysExHandler::send_offset_;
+uint8_t SysExHandler::send_checksum_;
+uint8_t SysExHandler::send_budget_;
+uint16_t SysExHandler::send_time_;
+uint8_t SysExHandler::page_address_;
+uint8_t SysExHandler::page_[kSlotPageSize];
+volatile uint8_t SysExHandler::block_open_;
+volatile uint8_t SysExHandler::block_aborted_;
 /* </static> */
 
-static const prog_char header[] PROGMEM = {
+static const prog_uint8_t header[] PROGMEM = {
   0xf0,  // <SysEx>
   0x29,  // PPG manufacturer ID
   'A','L','F',0x00, // ALF Product ID
@@ -51,6 +69,20 @@ static const prog_char header[] PROGMEM = {
   // 0xf7 EOX byte
 };
 
+// Layout of a SYSEXCMD_PROGRAMDATA block, as sent by the background task
+static const uint16_t kPgmDataSize = 1 + sizeof(SeqInfo) + 1 + 4 * sizeof(SeqData);
+static const uint16_t kPgmDataOffset = sizeof(header) + 2;
+static const uint16_t kPgmChecksumOffset = kPgmDataOffset + 2 * kPgmDataSize;
+static const uint16_t kPgmEoxOffset = kPgmChecksumOffset + 2;
+
+// Layout of a full SYSEXCMD_PROGRAMPAGE block, slot index and page data
+static const uint16_t kPageEoxOffset = kPgmDataOffset + 2 * (1 + kSlotPageSize) + 2;
+
+// Time needed to send a block at the background transfer pace, with some
+// room for the groove and for the slow passes of the main loop
+static const uint16_t kPgmBlockTime = (kPgmEoxOffset + 1) / kSysExBytesPerMs * 5 / 4;
+static const uint16_t kPageBlockTime = (kPageEoxOffset + 1) / kSysExBytesPerMs * 5 / 4;
+
 ///////////////////////////////////////////////////////////////////////////////
 // Send SysEx routines
 ///////////////////////////////////////////////////////////////////////////////
@@ -71,29 +103,33 @@ void SysExHandler::SendPgm() {
 
 /* static */
 void SysExHandler::SendPgm(uint8_t slot) {
-  state.Save();
-  seq.LoadFromStorage(slot);
-  SendPgm();
-  state.Load();
+  StartSend(slot, slot + 1, NULL, SYSEXCMD_PROGRAMDATA, 0);
 }
 
 /* static */
-void SysExHandler::SendAll(ProgressCallback callback) {
-  state.Save();
+void SysExHandler::SendSet(const uint8_t* set) {
+  StartSend(0, storage.num_slots(), set, SYSEXCMD_PROGRAMPAGE, 0);
+}
+
+/* static */
+void SysExHandler::SendIndex() {
+  // The last page is shorter, so that the host knows the number of slots.
+  // It is empty when all the pages are full.
   uint16_t total = storage.num_slots();
-  for (uint16_t n = 0; n < total; n++) {
-    if (!(*callback)(n, total))
+  for (uint16_t n = 0; n <= total; n+= kSlotIndexPageSize) {
+    uint8_t count = min(total - n, kSlotIndexPageSize);
+    if (count && !storage.ReadSlotIndex(n, count, (uint16_t*)buffer_))
       break;
-    seq.LoadFromStorage(n);
-    uint8_t cb = PreparePgmData();
-    SendSysExHeader(SYSEXCMD_PROGRAMDATA, 1);
-    SendSysExData(buffer_, cb);
+    SendSysExHeader(SYSEXCMD_SLOTINDEX, n / kSlotIndexPageSize);
+    SendSysExData(buffer_, count * 2);
   }
-  state.Load();
 }
 
 /* static */
 void SysExHandler::SendSysExHeader(uint8_t cmd, uint8_t arg) {
+  // Blocks can't overlap
+  FinishBlock();
+
   // Send SysEx header
   for (uint8_t i = 0; i < sizeof(header); i++) {
     SendByte(pgm_read_byte(header + i));
@@ -126,6 +162,172 @@ void SysExHandler::SendSysExData(const void* data, uint16_t size) {
   ConstantDelay(100);
 }
 
+/* static */
+void SysExHandler::StartSend(uint8_t slot, uint16_t end, const uint8_t* set, uint8_t cmd, uint8_t arg) {
+  FinishBlock();
+  if (send_state_ == SENDING_IDLE) {
+    send_time_ = static_cast<uint16_t>(milliseconds()) - kSysExBlockGap;
+  }
+  send_state_ = SENDING_GAP;
+  send_slot_ = slot;
+  send_next_ = slot;
+  send_end_ = min(end, storage.num_slots());
+  send_set_ = set;
+  send_cmd_ = cmd;
+  send_arg_ = arg;
+  send_page_ = kSlotCrcOffset;  // No slot started
+}
+
+/* static */
+void SysExHandler::FinishBlock() {
+  while (send_state_ == SENDING_BLOCK || block_aborted_) {
+    Poll();
+  }
+}
+
+/* static */
+uint8_t SysExHandler::NextSlot() {
+  while (send_next_ < send_end_) {
+    uint16_t n = send_next_++;
+    // Skip the slots not in the set, if any
+    if (!send_set_ || (send_set_[n >> 3] & (1 << (n & 7)))) {
+      send_slot_ = n;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* static */
+void SysExHandler::Poll() {
+  uint16_t now = milliseconds();
+  uint16_t elapsed = now - send_time_;
+
+  if (block_aborted_) {
+    // Wait for the output ISR to drop what is left of the aborted block,
+    // then send the program again
+    if (OutputBuffer::readable())
+      return;
+    block_aborted_ = 0;
+    if (send_state_ != SENDING_IDLE) {
+      send_state_ = SENDING_GAP;
+      if (send_end_) {
+        send_page_ = send_block_page_;
+      }
+      send_time_ = now;
+    }
+    return;
+  }
+
+  uint8_t paged = send_cmd_ == SYSEXCMD_PROGRAMPAGE;
+  switch (send_state_) {
+    case SENDING_GAP:
+      // While the sequencer runs, the notes come first: a block only starts
+      // when it can be sent before the next note on. Otherwise the transfer
+      // waits for a slower tempo or for the sequencer to stop.
+      if (elapsed < (send_page_ && send_page_ < kSlotCrcOffset ? kSysExPageGap : kSysExBlockGap) ||
+          (seq.running() && seq.TimeToNextNoteOn() < (paged ? kPageBlockTime : kPgmBlockTime)))
+        break;
+      if (send_page_ >= kSlotCrcOffset) {
+        if (!NextSlot()) {
+          send_state_ = SENDING_IDLE;
+          break;
+        }
+        send_page_ = 0;
+      }
+      // The next page is only sent once this block is on its way, an
+      // aborted block is sent again
+      send_block_page_ = send_page_;
+      if (paged) {
+        send_page_ = min(send_page_ + kSlotPageSize, kSlotCrcOffset);
+        send_eox_offset_ = kPgmDataOffset + 2 * (1 + min(kSlotPageSize, kSlotCrcOffset - send_block_page_)) + 2;
+      } else {
+        send_page_ = kSlotCrcOffset;
+        send_eox_offset_ = kPgmEoxOffset;
+      }
+      send_state_ = SENDING_BLOCK;
+      send_offset_ = 0;
+      send_checksum_ = 0;
+      send_budget_ = 0;
+      send_time_ = now;
+      page_address_ = 1;  // No page read
+      break;
+
+    case SENDING_BLOCK:
+      // The budget grows with time, and the bytes are only queued when
+      // there is room left
+      send_budget_ = min(send_budget_ + min(elapsed, kSysExMaxBudget) * kSysExBytesPerMs, kSysExMaxBudget);
+      send_time_ = now;
+      uint8_t pages = 1;  // A single page is read per pass of the main loop
+      while (send_budget_ && OutputBuffer::writable()) {
+        int16_t byte = NextBlockByte(&pages);
+        if (byte < 0)
+          break;
+        OutputBuffer::Overwrite(byte);
+        --send_budget_;
+        if (++send_offset_ > send_eox_offset_) {
+          send_state_ = SENDING_GAP;
+          break;
+        }
+      }
+      break;
+  }
+}
+
+/* static */
+int16_t SysExHandler::NextBlockByte(uint8_t* pages) {
+  if (send_offset_ < kPgmDataOffset) {
+    if (send_offset_ < sizeof(header))
+      return pgm_read_byte(header + send_offset_);
+    if (send_offset_ == sizeof(header))
+      return send_cmd_;
+    return send_cmd_ == SYSEXCMD_PROGRAMPAGE ? send_block_page_ / kSlotPageSize : send_arg_;
+  }
+  uint16_t checksum_offset = send_eox_offset_ - 2;
+  if (send_offset_ >= checksum_offset) {
+    if (send_offset_ == send_eox_offset_)
+      return 0xf7;
+    return send_offset_ == checksum_offset ? U8ShiftRight4(send_checksum_) : send_checksum_ & 0x0f;
+  }
+
+  // Page data comes after the slot index, raw. Program data has the sizes
+  // before the sequence info and data.
+  uint8_t i = (send_offset_ - kPgmDataOffset) >> 1;
+  uint8_t value;
+  uint8_t address;
+  if (send_cmd_ == SYSEXCMD_PROGRAMPAGE) {
+    address = send_block_page_ + i - 1;
+  } else {
+    address = i <= sizeof(SeqInfo) ? i - 1 : kSeqDataOffset + i - 2 - sizeof(SeqInfo);
+  }
+  if (i == 0) {
+    value = send_cmd_ == SYSEXCMD_PROGRAMPAGE ? send_slot_ : sizeof(SeqInfo);
+  } else
+  if (send_cmd_ == SYSEXCMD_PROGRAMDATA && i == 1 + sizeof(SeqInfo)) {
+    value = 4 * sizeof(SeqData);
+  } else {
+    uint8_t page_address = address & ~(kSlotPageSize - 1);
+    if (page_address != page_address_) {
+      if (!*pages)
+        return -1;
+      --*pages;
+      storage.ReadSlotPage(send_slot_, page_address, page_, kSlotPageSize);
+      page_address_ = page_address;
+      if (page_address == 0 && send_cmd_ == SYSEXCMD_PROGRAMDATA) {
+        SeqInfo* info = (SeqInfo*)page_;
+        Seq::FixSeqName(info->name_);
+        info->slot_ = send_slot_;
+      }
+    }
+    value = page_[address & (kSlotPageSize - 1)];
+  }
+
+  if (send_offset_ & 1)
+    return value & 0x0f;
+  send_checksum_ += value;
+  return U8ShiftRight4(value);
+}
+
 /* static */
 uint8_t SysExHandler::PreparePgmData() {
   uint8_t cb = 0;
@@ -200,7 +402,10 @@ void SysExHandler::Receive(uint8_t byte) {
 
 /* static */
 void SysExHandler::AcceptCommand() {
-  seq.Stop();
+  // The requests are served while the sequencer runs
+  if (command_[0] < SYSEXCMD_REQCURSEQUENCEDATA || command_[0] > SYSEXCMD_REQPROGRAMSETDATA) {
+    seq.Stop();
+  }
   switch (command_[0]) {
     case SYSEXCMD_SEQUENCEDATA:
       RecvSeq();
@@ -208,6 +413,9 @@ void SysExHandler::AcceptCommand() {
     case SYSEXCMD_PROGRAMDATA:
       RecvPgm();
       break;
+    case SYSEXCMD_PROGRAMPAGE:
+      RecvPage();
+      break;
     case SYSEXCMD_REQCURSEQUENCEDATA:
       if (bytes_received_ == 0) {
         Ui::AddRequest(REQUEST_SENDCURSEQUENCE);
@@ -228,6 +436,17 @@ void SysExHandler::AcceptCommand() {
         Ui::AddRequest(REQUEST_SENDALLPROGRAMS);
       }
       break;
+    case SYSEXCMD_REQSLOTINDEX:
+      if (bytes_received_ == 0) {
+        Ui::AddRequest(REQUEST_SENDSLOTINDEX);
+      }
+      break;
+    case SYSEXCMD_REQPROGRAMSETDATA:
+      if (bytes_received_ == sizeof(program_set_)) {
+        memcpy(program_set_, buffer_, sizeof(program_set_));
+        Ui::AddRequest(REQUEST_SENDPROGRAMSET);
+      }
+      break;
     case SYSEXCMD_REQSEQUENCEDATA_SAVE:
       if (bytes_received_ == 0) {
         seq.SaveToStorage();
@@ -250,30 +469,6 @@ uint8_t SysExHandler::CalcCheckSum(const uint8_t* data, uint16_t size) {
   return checksum;
 }
 
-uint8_t SysExHandler::SendAllProgressCallback(uint16_t done, uint16_t total) {
-  Ui::Clear();
-
-  char* line1 = display.line_buffer(0);
-  char* line2 = display.line_buffer(1);
-  
-  static const prog_char cmdCancel[] PROGMEM = "[Cancel]";
-
-  memcpy_P(&line1[0], PSTRN("Sending program:"));
-  memcpy_P(&line1[kLcdWidth - lengof(cmdCancel)], cmdCancel, lengof(cmdCancel));
-
-  uint8_t name[kNameLength]; storage.ReadSlotName(done, name);
-  Ui::PrintNumb(&line2[0], 1 + done);
-  memcpy(&line2[4], name, kNameLength);
-  
-  Ui::RedrawScreen();
-
-  // Check if cancelled
-  if (Ui::GetEncoderState(ENCODER_B) == 0)
-    return 0;
-
-  return 1;
-}
-
 /* static */
 void SysExHandler::RecvSeq() {
   SeqData data;
@@ -312,4 +507,17 @@ void SysExHandler::RecvPgm() {
   Ui::AddRequest(REQUEST_SHOWPAGE, PAGE_RECV_SYSEX);
 }
 
+/* static */
+void SysExHandler::RecvPage() {
+  // The pages are written as they come, the slot checksum with the last one
+  uint16_t offset = command_[1] * kSlotPageSize;
+  if (offset >= kSlotCrcOffset || bytes_received_ != 1 + min(kSlotPageSize, kSlotCrcOffset - offset))
+    return;
+
+  uint8_t size = bytes_received_ - 1;
+  if (storage.WriteSlotPage(buffer_[0], offset, &buffer_[1], size) && offset + size == kSlotCrcOffset) {
+    Ui::AddRequest(REQUEST_SHOWPAGE, PAGE_RECV_SYSEX);
+  }
+}
+
 } // namespace midialf
@@ -22,6 +22,8 @@
 #ifndef MIDIALF_SYSEX_HANDLER_H_
 #define MIDIALF_SYSEX_HANDLER_H_
 
+#include "avrlib/ring_buffer.h"
+
 #include "midialf/midialf.h"
 #include "midialf/storage.h"
 #include "midialf/seq.h"
@@ -29,6 +31,11 @@
 namespace midialf {
 
 static const uint16_t kSysExBlockSize = 256 + 1;  // slot data plus checksum
+static const uint8_t kSlotIndexPageSize = 128;    // slots per SYSEXCMD_SLOTINDEX block
+static const uint8_t kSysExBlockGap = 100;        // ms between the programs, for slow receivers
+static const uint8_t kSysExPageGap = 10;          // ms between the pages of a program
+static const uint8_t kSysExBytesPerMs = 3;        // background transfer pace, MIDI carries 3.125
+static const uint8_t kSysExMaxBudget = 16;        // bytes sent at once after a slow main loop pass
 
 enum SysExReceptionState {
   RECEIVING_HEADER,
@@ -38,21 +45,35 @@ enum SysExReceptionState {
   RECEPTION_ERROR,
 };
 
+enum SysExSendState {
+  SENDING_IDLE,
+  SENDING_GAP,    // waiting to start the next block
+  SENDING_BLOCK,  // streaming a program or page block
+};
+
 enum SysExCommand {
  SYSEXCMD_SEQUENCEDATA = 0x01, // SeqData structure
  SYSEXCMD_PROGRAMDATA  = 0x02, // (cb)SeqInfo + (cb)4 x SeqData), arg == 1 saves to storage
+ SYSEXCMD_SLOTINDEX    = 0x03, // little-endian slot CRC16s, arg is page index (kSlotIndexPageSize slots per page)
+ SYSEXCMD_PROGRAMPAGE  = 0x04, // slot index + raw slot page, arg is page index (kSlotPageSize bytes per page, up to kSlotCrcOffset)
  SYSEXCMD_REQCURSEQUENCEDATA = 0x11, // send current sequence data request
  SYSEXCMD_REQCURPROGRAMDATA  = 0x12, // send current program data request
  SYSEXCMD_REQPROGRAMDATA     = 0x13, // send program data request, 1 byte payload is program slot index
  SYSEXCMD_REQALLPROGRAMDATA  = 0x14, // send all programs data request
+ SYSEXCMD_REQSLOTINDEX       = 0x15, // send slot index request
+ SYSEXCMD_REQPROGRAMSETDATA  = 0x16, // send programs data request, 32 bytes payload is slot bit mask
  SYSEXCMD_REQSEQUENCEDATA_SAVE = 0x21, // save current sequence data request
  SYSEXCMD_REQPROGRAMDATA_SAVE  = 0x22, // save program data request, 1 byte payload is program slot index
 };
 
-typedef uint8_t (*ProgressCallback)(uint16_t done, uint16_t total);
-
 class SysExHandler {
  public:
+  enum {
+    buffer_size = 32,
+    data_size = 8,
+  };
+  typedef avrlib::RingBuffer<SysExHandler> OutputBuffer;
+  typedef avrlib::DataTypeForSize<data_size>::Type Value;
 
   static void SendSeq(uint8_t seq);
   static void SendSeq() { SendSeq(seq.seq()); }
@@ -60,8 +81,51 @@ class SysExHandler {
   static void SendPgm();
   static void SendPgm(uint8_t slot);
 
-  static void SendAll(ProgressCallback callback);
-  static void SendAll() { SendAll(SendAllProgressCallback); }
+  static void SendAll() { SendSet(NULL); }
+
+  static void SendSet(const uint8_t* set);
+  static void SendSet() { SendSet(program_set_); }
+
+  static void SendIndex();
+
+  // The programs are sent from the storage by a background task, which the
+  // main loop runs. While the sequencer runs, a block only starts when it
+  // can be sent before the next note on. A single program goes as one
+  // SYSEXCMD_PROGRAMDATA block, the sets of programs as SYSEXCMD_PROGRAMPAGE
+  // blocks, one per storage page, short enough to fit between the 1/16
+  // notes at 120 BPM. Cancelling stops the task after the current block.
+  static void Poll();
+  static void Cancel() {
+    send_end_ = 0;
+    send_page_ = kSlotCrcOffset;
+  }
+  static uint8_t sending() { return send_state_ != SENDING_IDLE; }
+  static uint8_t sending_slot() { return send_slot_; }
+
+  // Called by the MIDI output ISR. The messages waiting in the MIDI output
+  // buffer must not be sent while a block is open, they would end it.
+  static uint8_t block_open() { return block_open_; }
+
+  // Called when a message can't wait for the end of the block. The rest of
+  // the block is dropped by the MIDI output ISR, and the program is sent
+  // again by the background task.
+  static void AbortBlock() {
+    if (block_open_) {
+      block_open_ = 0;
+      block_aborted_ = 1;
+    }
+  }
+  static uint8_t block_aborted() { return block_aborted_; }
+  static uint8_t ReadOutput() {
+    uint8_t byte = OutputBuffer::ImmediateRead();
+    if (byte == 0xf0) {
+      block_open_ = 1;
+    } else
+    if (byte == 0xf7) {
+      block_open_ = 0;
+    }
+    return byte;
+  }
 
   static void Receive(uint8_t byte);
   
@@ -69,23 +133,48 @@ class SysExHandler {
   static void SendSysExHeader(uint8_t cmd, uint8_t arg = 0);
   static void SendSysExData(const void* data, uint16_t size);
   static void SendByte(uint8_t byte) {
-    seq.SendNow(byte);
+    OutputBuffer::Write(byte);
   }
 
   static uint8_t PreparePgmData();
-  static uint8_t SendAllProgressCallback(uint16_t done, uint16_t total);
+
+  static void StartSend(uint8_t slot, uint16_t end, const uint8_t* set, uint8_t cmd, uint8_t arg);
+  static void FinishBlock();
+  static uint8_t NextSlot();
+  static int16_t NextBlockByte(uint8_t* pages);
 
   static void AcceptCommand();
   static uint8_t CalcCheckSum(const uint8_t* data, uint16_t size);
 
   static void RecvSeq();
   static void RecvPgm();
+  static void RecvPage();
 
   static uint16_t bytes_received_;
   static uint8_t buffer_[kSysExBlockSize];
   static uint8_t state_;
   static uint8_t checksum_;
   static uint8_t command_[2];
+  static uint8_t program_set_[kMaxNumSlots / 8];
+
+  static uint8_t send_state_;
+  static uint8_t send_slot_;
+  static uint16_t send_next_;
+  static uint16_t send_end_;
+  static const uint8_t* send_set_;
+  static uint8_t send_cmd_;
+  static uint8_t send_arg_;
+  static uint8_t send_page_;
+  static uint8_t send_block_page_;
+  static uint16_t send_eox_offset_;
+  static uint16_t send_offset_;
+  static uint8_t send_checksum_;
+  static uint8_t send_budget_;
+  static uint16_t send_time_;
+  static uint8_t page_address_;
+  static uint8_t page_[kSlotPageSize];
+  static volatile uint8_t block_open_;
+  static volatile uint8_t block_aborted_;
 };
 
 extern SysExHandler sysex_handler;
@@ -33,6 +33,7 @@
 #include "midialf/ui_pages/gate_page.h"
 #include "midialf/ui_pages/cc1_page.h"
 #include "midialf/ui_pages/cc2_page.h"
+#include "midialf/ui_pages/trig_page.h"
 #include "midialf/ui_pages/seq_settings_page.h"
 #include "midialf/ui_pages/prg_settings_page.h"
 #include "midialf/ui_pages/sys_settings_page.h"
@@ -44,6 +45,7 @@
 #include "midialf/ui_pages/copy_seq_page.h"
 #include "midialf/ui_pages/command_page.h"
 #include "midialf/ui_pages/init_page.h"
+#include "midialf/ui_pages/slots_page.h"
 #include "midialf/ui_pages/save_page.h"
 #include "midialf/ui_pages/load_page.h"
 #include "midialf/ui_pages/send_sysex_page.h"
@@ -58,6 +60,10 @@ using namespace avrlib;
 
 static const uint8_t kDblClickTime = 250;
 
+// Detent intervals (ms) below which encoder increments get accelerated
+static const uint8_t kAccelFastTime = 6;
+static const uint8_t kAccelSlowTime = 16;
+
 /* <static> */
 EncoderA Ui::encoderA_;
 EncoderB Ui::encoderB_;
@@ -76,9 +82,10 @@ PageInfo Ui::page_info_;
 uint8_t Ui::cycle_;
 uint8_t Ui::save_state_;
 uint8_t Ui::inhibit_sel_raised_;
+uint8_t Ui::increment_shifted_;
 uint8_t Ui::last_click_encoder_;
 uint32_t Ui::last_click_time_;
-uint16_t Ui::led_blink_cycle_;
+uint16_t Ui::detent_time_[ENCODER_B + 1];
 /* </static> */
 
 /* extern */
@@ -87,72 +94,107 @@ Ui ui;
 const prog_PageInfo page_registry[] PROGMEM = {
   { PAGE_NOTE,
     &NotePage::event_handlers_,
+    SEQ_CHANGE_SEQ | SEQ_CHANGE_PROGRAM,
+    kStepEncoders | _BV(ENCODER_A),
   },
   { PAGE_VELO,
     &VeloPage::event_handlers_,
+    SEQ_CHANGE_SEQ | SEQ_CHANGE_PROGRAM,
   },
   { PAGE_GATE,
     &GatePage::event_handlers_,
+    SEQ_CHANGE_SEQ | SEQ_CHANGE_PROGRAM,
   },
   { PAGE_CC1,
     &CC1Page::event_handlers_,
+    SEQ_CHANGE_SEQ | SEQ_CHANGE_PROGRAM,
   },
   { PAGE_CC2,
     &CC2Page::event_handlers_,
+    SEQ_CHANGE_SEQ | SEQ_CHANGE_PROGRAM,
+  },
+  { PAGE_TRIG,
+    &TrigPage::event_handlers_,
+    SEQ_CHANGE_SEQ | SEQ_CHANGE_PROGRAM,
   },
   { PAGE_SEQ_SETTINGS,
     &SeqSettingsPage::event_handlers_,
+    SEQ_CHANGE_PROGRAM,
+    _BV(ENCODER_5),
   },
   { PAGE_PRG_SETTINGS,
     &PrgSettingsPage::event_handlers_,
+    SEQ_CHANGE_SEQ | SEQ_CHANGE_PROGRAM,
   },
   { PAGE_SYS_SETTINGS,
     &SysSettingsPage::event_handlers_,
+    SEQ_CHANGE_PROGRAM,
   },
 #ifdef ENABLE_CV_OUTPUT
   { PAGE_EXT_SETTINGS,
     &ExtSettingsPage::event_handlers_,
+    SEQ_CHANGE_PROGRAM,
   },
 #endif
   { PAGE_LFO1,
     &LfoPage::event_handlers_,
+    SEQ_CHANGE_PROGRAM,
   },
   { PAGE_LFO2,
     &LfoPage::event_handlers_,
+    SEQ_CHANGE_PROGRAM,
   },
   { PAGE_DLG,
     &DlgPage::event_handlers_,
+    0,
   },
   { PAGE_COPYSEQ,
     &CopySeqPage::event_handlers_,
+    SEQ_CHANGE_SEQ | kPageAnimated,
   },
   { PAGE_COMMAND,
     &CommandPage::event_handlers_,
+    0,
   },
   { PAGE_INIT,
     &InitPage::event_handlers_,
+    0,
+  },
+  { PAGE_SLOTS,
+    &SlotsPage::event_handlers_,
+    0,
   },
   { PAGE_SAVE,
     &SavePage::event_handlers_,
+    SEQ_CHANGE_PROGRAM,
   },
   { PAGE_LOAD,
     &LoadPage::event_handlers_,
+    SEQ_CHANGE_PROGRAM,
   },
   { PAGE_SEND_SYSEX,
     &SendSysExPage::event_handlers_,
+    0,
   },
   { PAGE_RECV_SYSEX,
     &RecvSysExPage::event_handlers_,
+    0,
   },
   { PAGE_RANDOMIZE,
     &RandomizePage::event_handlers_,
+    0,
+    kStepEncoders | _BV(ENCODER_A),
   },
   { PAGE_ROTATE,
     &RotatePage::event_handlers_,
+    0,
+    kStepEncoders | _BV(ENCODER_A),
   },
 #ifdef ENABLE_CV_OUTPUT
   { PAGE_TUNE,
     &TunePage::event_handlers_,
+    0,
+    _BV(ENCODER_B),
   },
 #endif
 };
@@ -245,8 +287,7 @@ void Ui::Poll() {
   // Poll Encoder A
   { int8_t increment = encoderA_.Read();
     if (increment) {
-      if (CheckShifted()) increment*= 10;
-      queue_.AddEvent(CONTROL_ENCODER, ENCODER_A, increment);
+      AddIncrement(ENCODER_A, increment);
     }
     if (encoderA_.clicked()) {    
       queue_.AddEvent(CONTROL_ENCODER_CLICK, ENCODER_A, GetEncoderClickValue(ENCODER_A));
@@ -256,8 +297,7 @@ void Ui::Poll() {
   // Poll Encoder B
   { int8_t increment = encoderB_.Read();
     if (increment) {
-      if (CheckShifted()) increment*= 10;
-      queue_.AddEvent(CONTROL_ENCODER, ENCODER_B, increment);
+      AddIncrement(ENCODER_B, increment);
     }
 
     if (encoderB_.clicked()) {    
@@ -270,8 +310,7 @@ void Ui::Poll() {
     for (uint8_t i = 0; i < 8; ++i) {
       int8_t increment = encoders_.Read(i);
       if (increment) {
-        if (CheckShifted()) increment*= 10;
-        queue_.AddEvent(CONTROL_ENCODER, ENCODER_1 + i, increment);
+        AddIncrement(ENCODER_1 + i, increment);
       }
       if (encoders_.lowered(i)) {
         uint8_t id = ENCODER_1 + i;
@@ -308,10 +347,39 @@ void Ui::Poll() {
   lcd.Tick();
 }
 
+/* static */
+void Ui::AddIncrement(uint8_t id, int8_t increment) {
+  uint16_t time = milliseconds();
+  uint16_t interval = time - detent_time_[id];
+  detent_time_[id] = time;
+
+  // Shifted increments are queued as detents under their own control type,
+  // so that they never merge with unshifted ones
+  if (CheckShifted()) {
+    queue_.AddIncrement(CONTROL_ENCODER_SHIFTED, id, increment);
+    return;
+  }
+
+  // Accelerate unshifted increments by detent rate, except on the encoders
+  // editing notes in semitones
+  if (!(page_info_.unaccelerated & _BV(id))) {
+    if (interval < kAccelFastTime) {
+      increment*= 4;
+    } else
+    if (interval < kAccelSlowTime) {
+      increment*= 2;
+    }
+  }
+
+  // Consecutive increments from the same encoder are merged in the queue
+  queue_.AddIncrement(CONTROL_ENCODER, id, increment);
+}
+
 /* static */
 void Ui::DoEvents() {
   display.Tick();
   
+  // Handle all pending events before a single redraw
   uint8_t redraw = 0;
   while (queue_.available()) {
     Event e = queue_.PullEvent();
@@ -335,14 +403,32 @@ void Ui::DoEvents() {
     }
   }
   
+  // Events can change anything, otherwise only what depends on the sequencer
+  // state changed since the last pass is refreshed
+  uint8_t changes = seq.TakeChanges();
+  if (redraw) {
+    changes = SEQ_CHANGE_ALL;
+  } else
+  if (changes & page_info_.refresh) {
+    redraw = 1;
+  }
+
   if (redraw) {
     display.Clear();
     (*event_handlers_.UpdateScreen)();
   }
-  
-  UpdateSideLeds();
-  UpdateStepLeds();
-  (*event_handlers_.UpdateLeds)();
+
+  uint8_t animated = page_info_.refresh & kPageAnimated;
+  if (animated || (changes & (SEQ_CHANGE_SEQ | SEQ_CHANGE_TRANSPORT | SEQ_CHANGE_PROGRAM)) ||
+      (seq.running() && seq.request_set_seq())) {
+    UpdateSideLeds();
+  }
+  if (changes & (SEQ_CHANGE_STEP | SEQ_CHANGE_TRANSPORT | SEQ_CHANGE_PROGRAM)) {
+    UpdateStepLeds();
+  }
+  if (animated || changes) {
+    (*event_handlers_.UpdateLeds)();
+  }
 }
 
 /* static */
@@ -353,6 +439,26 @@ void Ui::HandleEvent(const Event& e) {
         HandleEncoderEvent(e);
       }
       break;
+    case CONTROL_ENCODER_SHIFTED:
+      {
+        // Shifted increments come in tens
+        int8_t value = static_cast<int8_t>(e.value);
+        if (value > 12) {
+          value = 12;
+        } else
+        if (value < -12) {
+          value = -12;
+        }
+        value*= 10;
+        increment_shifted_ = 1;
+        if (!(*event_handlers_.OnIncrement)(e.control_id, value)) {
+          Event shifted = e;
+          shifted.value = value;
+          HandleEncoderEvent(shifted);
+        }
+        increment_shifted_ = 0;
+      }
+      break;
     case CONTROL_ENCODER_CLICK:
       if (!(*event_handlers_.OnClick)(e.control_id, e.value)) {
         HandleEncoderClickEvent(e);
@@ -498,6 +604,14 @@ void Ui::HandleRequestEvent(const Event& e) {
     case REQUEST_SENDPROGRAM:
       sysex_handler.SendPgm(e.value);
       break;
+
+    case REQUEST_SENDSLOTINDEX:
+      sysex_handler.SendIndex();
+      break;
+
+    case REQUEST_SENDPROGRAMSET:
+      sysex_handler.SendSet();
+      break;
   }
 }
 
@@ -510,21 +624,21 @@ void Ui::UpdateSideLeds() {
     } else {
       switch (seq.link_mode()) {
         case LINK_MODE_16: leds.set_pixel(LED_SEQA + n, ((seq.seq() & 2) == (n & 2)) ? 1 : 0); break;
-        case LINK_MODE_32: leds.set_pixel(LED_SEQA + n, 1); break;
+        case LINK_MODE_32:
+        case LINK_MODE_TRACKS: leds.set_pixel(LED_SEQA + n, 1); break;
         default: leds.clr_pixel(LED_SEQA + n); break;
       }
     }
   }
 
   if (seq.running() && seq.request_set_seq()) {
-      led_blink_cycle_ = (led_blink_cycle_ + 1) & 0x1fff;
-      leds.set_pixel(LED_SEQA + seq.request_set_seq() - 1, led_blink_cycle_ & 0x1000 ? 0 : 0xf);
+      leds.set_pixel(LED_SEQA + seq.request_set_seq() - 1, milliseconds() & 0x100 ? 0 : 0xf);
   }
 
   // Update right side leds
   leds.set_pixel(LED_RUN, seq.running() ? 0xf : 0);
   
-  switch (seq.clock_division()) {
+  switch (seq.active_clock_division()) {
     case CLOCK_DIVISION_NONE: leds.clr_pixel(LED_CLK); break;
     case CLOCK_DIVISION_X2: leds.set_pixel(LED_CLK, 0x1); break;
     case CLOCK_DIVISION_X4: leds.set_pixel(LED_CLK, 0xf); break;
@@ -575,6 +689,7 @@ void Ui::ShowPage(UiPageIndex page) {
   (*event_handlers_.OnInit)(&page_info_, prevPage);
 
   UpdateScreen();
+  seq.Invalidate(SEQ_CHANGE_ALL);
 }
 
 Dialog::Dialog(prog_char* text, prog_char* buttons, uint8_t num_buttons) {
@@ -653,9 +768,14 @@ uint8_t Ui::CheckShifted() {
 
 /* static */
 int8_t Ui::FixOctaveIncrement(int8_t value) {
-  if (value > 1) return 12;
-  if (value < -1) return -12;
-  return value;
+  // Shifted increments are octaves, the others semitones
+  if (!increment_shifted_) {
+    return value;
+  }
+  int16_t result = (value / 10) * 12;
+  if (result > 127) return 127;
+  if (result < -127) return -127;
+  return result;
 }
 
 /* static */
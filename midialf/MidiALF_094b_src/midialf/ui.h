@@ -88,6 +88,7 @@ enum EncoderClickValue {
 
 enum ControlTypeEx {
   CONTROL_REQUEST = 10,
+  CONTROL_ENCODER_SHIFTED,  // encoder turned with SEL held
 };
 
 enum RequestControlId {
@@ -97,6 +98,8 @@ enum RequestControlId {
   REQUEST_SENDCURPROGRAM, 
   REQUEST_SENDALLPROGRAMS,
   REQUEST_SENDPROGRAM,      // event.value specifies program slot
+  REQUEST_SENDSLOTINDEX,
+  REQUEST_SENDPROGRAMSET,   // slots are specified by SysExHandler::program_set_
 };
 
 enum UiPageIndex {
@@ -105,6 +108,7 @@ enum UiPageIndex {
   PAGE_GATE,
   PAGE_CC1,
   PAGE_CC2,
+  PAGE_TRIG,
   PAGE_SEQ_SETTINGS,
   PAGE_PRG_SETTINGS,
   PAGE_SYS_SETTINGS,
@@ -120,6 +124,7 @@ enum UiPageIndex {
   PAGE_COPYSEQ,
   PAGE_COMMAND,
   PAGE_INIT,
+  PAGE_SLOTS,
   PAGE_SAVE,
   PAGE_LOAD,
   PAGE_SEND_SYSEX,
@@ -131,6 +136,12 @@ enum UiPageIndex {
 #endif
 };
 
+// Set in PageInfo::refresh for pages whose leds change on every pass
+static const uint8_t kPageAnimated = 0x80;
+
+// PageInfo::unaccelerated bits for the step encoders
+static const uint16_t kStepEncoders = 0x00ff;
+
 struct PageInfo;
 
 struct EventHandlers {
@@ -166,6 +177,8 @@ class Dialog {
 struct PageInfo {
   uint8_t index;
   const prog_EventHandlers* event_handlers;
+  uint8_t refresh;  // SeqChange flags the screen depends on, kPageAnimated
+  uint16_t unaccelerated;  // ControlId bits of the encoders in semitones
   union {
     uint8_t data[1];
     DlgData dlg_data;
@@ -203,6 +216,9 @@ class Ui {
 
   static uint8_t CheckShifted();
   
+  // Set while a shifted increment is handled, its value comes in tens
+  static uint8_t increment_shifted() { return increment_shifted_; }
+
   static int8_t FixOctaveIncrement(int8_t value);
   
   static void PrintChannel(char* buffer, uint8_t channel);
@@ -233,11 +249,14 @@ class Ui {
   static uint8_t cycle_;
   static uint8_t save_state_;
   static uint8_t inhibit_sel_raised_;
+  static uint8_t increment_shifted_;
 
   static uint8_t last_click_encoder_;
   static uint32_t last_click_time_;
 
-  static uint16_t led_blink_cycle_;
+  static uint16_t detent_time_[ENCODER_B + 1];
+
+  static void AddIncrement(uint8_t id, int8_t increment);
 
   static void HandleEvent(const Event& e);
   static void HandleEncoderEvent(const Event& e);
@@ -57,7 +57,7 @@ uint8_t CommandPage::OnClick(uint8_t id, uint8_t value) {
   switch (id) {
     case ENCODER_1: Ui::ShowPage(PAGE_RANDOMIZE); return 1;
     case ENCODER_2: Ui::ShowPage(PAGE_ROTATE); return 1;
-    case ENCODER_3: return 1;
+    case ENCODER_3: Ui::ShowPage(PAGE_SLOTS); return 1;
 #ifdef ENABLE_CV_OUTPUT
     case ENCODER_4: Ui::ShowPage(PAGE_TUNE); return 1;
 #else
@@ -89,9 +89,9 @@ uint8_t CommandPage::OnIdle() {
 void CommandPage::UpdateScreen() {
   DrawSeparators();
 #ifdef ENABLE_CV_OUTPUT
-  DrawCells(0, PSTR("RandRota----TuneInitLoadSaveSysX"));
+  DrawCells(0, PSTR("RandRotaSlotTuneInitLoadSaveSysX"));
 #else
-  DrawCells(0, PSTR("RandRota--------InitLoadSaveSysX"));
+  DrawCells(0, PSTR("RandRotaSlot----InitLoadSaveSysX"));
 #endif
 }
 
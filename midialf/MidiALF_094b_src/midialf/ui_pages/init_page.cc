@@ -118,9 +118,8 @@ void InitPage::SetSlot(uint8_t slot) {
 
 /* static */
 void InitPage::InitSlot() {
-  seq.set_slot(slot_);
-  InitPgm();
-  seq.SaveToStorage(slot_);
+  storage.InitSlots(slot_, 1);
+  SetSlot(slot_);
 }
 
 /* static */
@@ -147,32 +146,31 @@ void InitPage::InitAll() {
   Ui::Clear();
 
   char* line1 = display.line_buffer(0);
-  char* line2 = display.line_buffer(1);
   
   static const prog_char cmdCancel[] PROGMEM = "[Cancel]";
 
   memcpy_P(&line1[0], PSTRN("Initializing program:"));
   memcpy_P(&line1[kLcdWidth - lengof(cmdCancel)], cmdCancel, lengof(cmdCancel));
 
-  seq.set_slot(0); InitPgm();
+  // Overwrite programs, leaving the current one alone
+  storage.InitSlots(0, storage.num_slots(), InitAllProgressCallback);
+}
 
-  for (uint16_t n = 0; n < storage.num_slots(); n++) {
-    seq.set_slot(n);
-    // Update display
-    uint8_t name[kNameLength]; storage.ReadSlotName(n, name);
-    Ui::PrintNumb(&line2[0], 1 + n);
-    memcpy(&line2[4], name, kNameLength);
-    Ui::RedrawScreen();
+/* static */
+uint8_t InitPage::InitAllProgressCallback(uint16_t slot, uint16_t total) {
+  char* line2 = display.line_buffer(1);
 
-    // Check if cancelled
-    if (Ui::GetEncoderState(ENCODER_B) == 0)
-      return;
+  // Update display
+  uint8_t name[kNameLength]; storage.ReadSlotName(slot, name);
+  Ui::PrintNumb(&line2[0], 1 + slot);
+  memcpy(&line2[4], name, kNameLength);
+  Ui::RedrawScreen();
 
-    // Overwrite program
-    seq.SaveToStorage(n);
-  }
+  // Check if cancelled
+  if (Ui::GetEncoderState(ENCODER_B) == 0)
+    return 0;
 
-  seq.LoadFromStorage(0);
+  return 1;
 }
 
 } // namespace midialf
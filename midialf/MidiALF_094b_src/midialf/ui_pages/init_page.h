@@ -53,6 +53,8 @@ class InitPage : public UiPage {
   static void InitPgm();
   static void InitAll();
 
+  static uint8_t InitAllProgressCallback(uint16_t slot, uint16_t total);
+
   DISALLOW_COPY_AND_ASSIGN(InitPage);
 };
 
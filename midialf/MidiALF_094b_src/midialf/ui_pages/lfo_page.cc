@@ -56,7 +56,7 @@ uint8_t LfoPage::OnIncrement(uint8_t id, int8_t value) {
     case ENCODER_5: UpdateCenter(value); return 1;
     case ENCODER_6: UpdateRate(value); return 1;
     case ENCODER_7: UpdateSync(value); return 1;
-    case ENCODER_8: return 1;
+    case ENCODER_8: UpdateOutput(value); return 1;
   }
   return 0;
 }
@@ -84,7 +84,7 @@ uint8_t LfoPage::OnClick(uint8_t id, uint8_t value) {
     case ENCODER_5: lfo.set_center(lfo_, lfo_ ? kDefLfo2Center : kDefLfo1Center); return 1;
     case ENCODER_6: lfo.set_rate(lfo_, lfo_ ? kDefLfo2Rate : kDefLfo1Rate); return 1;
     case ENCODER_7: lfo.set_sync(lfo_, lfo_ ? kDefLfo2Sync : kDefLfo1Sync); return 1;
-    case ENCODER_8: return 1;
+    case ENCODER_8: lfo.set_output(lfo_, kDefLfoOutput); return 1;
   }
   return 0;
 }
@@ -100,7 +100,7 @@ uint8_t LfoPage::OnSwitch(uint8_t id, uint8_t value) {
       case SWITCH_5: UpdateCenter(0); return 1;
       case SWITCH_6: UpdateRate(0); return 1;
       case SWITCH_7: UpdateSync(0); return 1;
-      case SWITCH_8: return 1;
+      case SWITCH_8: UpdateOutput(0); return 1;
     }
   }
   return 0;
@@ -114,7 +114,7 @@ uint8_t LfoPage::OnIdle() {
 /* static */
 void LfoPage::UpdateScreen() {
   DrawSeparators();
-  DrawCells(0, PSTR("LFO? CC ResoAmntCentRateSync----"));
+  DrawCells(0, PSTR("LFO? CC ResoAmntCentRateSyncOutp"));
   
   char* line1 = display.line_buffer(0);
   char* line2 = display.line_buffer(1);
@@ -133,6 +133,8 @@ void LfoPage::UpdateScreen() {
     midi_clock_ticks_per_note_str + (kNoteDurationCount - kNumLfoRates) * 4);
   
   DrawSelStr(&line2[cell_pos(6)], lfo.sync(lfo_), PSTR("freestrt seqstep"));
+
+  DrawSelStr(&line2[cell_pos(7)], lfo.output(lfo_), PSTR("db 0db 1db 2db 3db 4db 5db 6db 7 14b"));
 }
 
 /* static */
@@ -219,4 +221,15 @@ void LfoPage::UpdateSync(int8_t value) {
   }
 }
 
+/* static */
+void LfoPage::UpdateOutput(int8_t value) {
+  if (value) {
+    lfo.set_output(lfo_, Clamp(static_cast<int16_t>(lfo.output(lfo_)) + value, 0, kMaxLfoOutput));
+  } else {
+    uint8_t output = lfo.output(lfo_);
+    if (++output > kMaxLfoOutput) output = 0;
+    lfo.set_output(lfo_, output);
+  }
+}
+
 } // namespace midialf
@@ -51,6 +51,7 @@ class LfoPage : public UiPage {
   static void UpdateCenter(int8_t value);
   static void UpdateRate(int8_t value);
   static void UpdateSync(int8_t value);
+  static void UpdateOutput(int8_t value);
 
   DISALLOW_COPY_AND_ASSIGN(LfoPage);
 };
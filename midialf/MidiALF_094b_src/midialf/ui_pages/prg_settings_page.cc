@@ -43,6 +43,17 @@ void PrgSettingsPage::OnQuit(UiPageIndex nextPage) {
 
 /* static */
 uint8_t PrgSettingsPage::OnIncrement(uint8_t id, int8_t value) {
+  // Step progression options do not apply to tracks
+  if (seq.link_mode() == LINK_MODE_TRACKS) {
+    switch (id) {
+      case ENCODER_1: UpdateTrackDirection(value); return 1;
+      case ENCODER_2: UpdateTrackClockDivision(value); return 1;
+      case ENCODER_3: UpdateTrackChannel(value); return 1;
+      case ENCODER_8: UpdateLinkMode(value); return 1;
+    }
+    return 0;
+  }
+
   switch (id) {
     case ENCODER_1: UpdateDirection(value); return 1;
     case ENCODER_2: UpdateStepsForward(value); return 1;
@@ -61,6 +72,16 @@ uint8_t PrgSettingsPage::OnClick(uint8_t id, uint8_t value) {
   if (value != CLICK)
     return 0;
 
+  if (seq.link_mode() == LINK_MODE_TRACKS) {
+    switch (id) {
+      case ENCODER_1: seq.set_track_direction(seq.seq(), DIRECTION_FORWARD); return 1;
+      case ENCODER_2: seq.set_track_clock_division(seq.seq(), CLOCK_DIVISION_NONE); return 1;
+      case ENCODER_3: seq.set_track_channel(seq.seq(), seq.seq()); return 1;
+      case ENCODER_8: seq.set_link_mode(LINK_MODE_NONE); return 1;
+    }
+    return 0;
+  }
+
   switch (id) {
     case ENCODER_1: seq.set_direction(DIRECTION_FORWARD); return 1;
     case ENCODER_2: seq.set_steps_forward(0); return 1;
@@ -76,6 +97,14 @@ uint8_t PrgSettingsPage::OnClick(uint8_t id, uint8_t value) {
 
 /* static */
 uint8_t PrgSettingsPage::OnSwitch(uint8_t id, uint8_t value) {
+  if (id == SWITCH && seq.link_mode() == LINK_MODE_TRACKS) {
+    switch (value) {
+      case SWITCH_1: UpdateTrackDirection(0); return 1;
+      case SWITCH_2: UpdateTrackClockDivision(0); return 1;
+      case SWITCH_3: UpdateTrackChannel(0); return 1;
+      case SWITCH_8: UpdateLinkMode(0); return 1;
+    }
+  } else
   if (id == SWITCH) {
     switch (value) {
       case SWITCH_1: UpdateDirection(0); return 1;
@@ -99,9 +128,21 @@ uint8_t PrgSettingsPage::OnIdle() {
 /* static */
 void PrgSettingsPage::UpdateScreen() {
   DrawSeparators();
-  DrawCells(0, PSTR(" DirForwBackReplIntvReptSkipLink"));
-  
+
   char* line2 = display.line_buffer(1);
+
+  if (seq.link_mode() == LINK_MODE_TRACKS) {
+    // Settings of the selected track
+    uint8_t track = seq.seq();
+    DrawCells(0, PSTR(" Dir Div Chan                Link"));
+    DrawSelStr(&line2[cell_pos(0)], seq.track_direction(track), PSTR("forwbackpendrand"));
+    DrawSelStr(&line2[cell_pos(1)], seq.track_clock_division(track), PSTR(" /1  /2  /4 "));
+    UnsafeItoa(seq.track_channel(track) + 1, 3, &line2[cell_pos(2) + 1]);
+    DrawSelStr(&line2[cell_pos(7)], seq.link_mode(), PSTR(" no 2x161x32trks"));
+    return;
+  }
+
+  DrawCells(0, PSTR(" DirForwBackReplIntvReptSkipLink"));
   
   DrawSelStr(&line2[cell_pos(0)], seq.direction(), PSTR("forwbackpendrand"));
   UnsafeItoa(seq.steps_forward(), 3, &line2[cell_pos(1) + 1]);
@@ -110,7 +151,7 @@ void PrgSettingsPage::UpdateScreen() {
   UnsafeItoa(seq.steps_interval(), 3, &line2[cell_pos(4) + 1]);
   UnsafeItoa(seq.steps_repeat(), 3, &line2[cell_pos(5) + 1]);
   UnsafeItoa(seq.steps_skip(), 3, &line2[cell_pos(6) + 1]);
-  DrawSelStr(&line2[cell_pos(7)], seq.link_mode(), PSTR(" no 2x161x32"));
+  DrawSelStr(&line2[cell_pos(7)], seq.link_mode(), PSTR(" no 2x161x32trks"));
 }
 
 /* static */
@@ -200,12 +241,48 @@ void PrgSettingsPage::UpdateStepsSkip(int8_t value) {
 /* static */
 void PrgSettingsPage::UpdateLinkMode(int8_t value) {
   if (value) {
-    seq.set_link_mode(Clamp(static_cast<int16_t>(seq.link_mode()) + value, LINK_MODE_NONE, LINK_MODE_32));
+    seq.set_link_mode(Clamp(static_cast<int16_t>(seq.link_mode()) + value, LINK_MODE_NONE, LINK_MODE_TRACKS));
   } else {
     uint8_t link_mode = seq.link_mode();
-    if (++link_mode > LINK_MODE_32) link_mode = LINK_MODE_NONE;
+    if (++link_mode > LINK_MODE_TRACKS) link_mode = LINK_MODE_NONE;
     seq.set_link_mode(link_mode);
   }
 }
 
+/* static */
+void PrgSettingsPage::UpdateTrackDirection(int8_t value) {
+  uint8_t track = seq.seq();
+  if (value) {
+    seq.set_track_direction(track, Clamp(static_cast<int16_t>(seq.track_direction(track)) + value, DIRECTION_FORWARD, DIRECTION_RANDOM));
+  } else {
+    uint8_t direction = seq.track_direction(track);
+    if (++direction > DIRECTION_RANDOM) direction = DIRECTION_FORWARD;
+    seq.set_track_direction(track, direction);
+  }
+}
+
+/* static */
+void PrgSettingsPage::UpdateTrackClockDivision(int8_t value) {
+  uint8_t track = seq.seq();
+  if (value) {
+    seq.set_track_clock_division(track, Clamp(static_cast<int16_t>(seq.track_clock_division(track)) + value, CLOCK_DIVISION_NONE, CLOCK_DIVISION_X4));
+  } else {
+    uint8_t clock_division = seq.track_clock_division(track);
+    if (++clock_division > CLOCK_DIVISION_X4) clock_division = CLOCK_DIVISION_NONE;
+    seq.set_track_clock_division(track, clock_division);
+  }
+}
+
+/* static */
+void PrgSettingsPage::UpdateTrackChannel(int8_t value) {
+  uint8_t track = seq.seq();
+  if (value) {
+    seq.set_track_channel(track, Clamp(static_cast<int16_t>(seq.track_channel(track)) + value, 0, 15));
+  } else {
+    uint8_t channel = seq.track_channel(track);
+    if (++channel > 15) channel = 0;
+    seq.set_track_channel(track, channel);
+  }
+}
+
 } // namespace midialf
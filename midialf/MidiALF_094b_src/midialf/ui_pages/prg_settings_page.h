@@ -50,6 +50,9 @@ class PrgSettingsPage : public UiPage {
   static void UpdateStepsRepeat(int8_t value);
   static void UpdateStepsSkip(int8_t value);
   static void UpdateLinkMode(int8_t value);
+  static void UpdateTrackDirection(int8_t value);
+  static void UpdateTrackClockDivision(int8_t value);
+  static void UpdateTrackChannel(int8_t value);
 
   DISALLOW_COPY_AND_ASSIGN(PrgSettingsPage);
 };
@@ -69,9 +69,9 @@ void RandomizePage::OnQuit(UiPageIndex nextPage) {
 uint8_t RandomizePage::OnIncrement(uint8_t id, int8_t value) {
   // ENCA advances all notes within scale or octave if shifted
   if (id == ENCODER_A) {
-    if (value == -1 || value == 1) {
+    if (!Ui::increment_shifted()) {
       for (uint8_t n = 0; n < kNumSteps; n++) {
-        ScaleStep(n, value > 0);
+        ScaleStep(n, value);
       }
     } else {
       value = Ui::FixOctaveIncrement(value);
@@ -90,8 +90,8 @@ uint8_t RandomizePage::OnIncrement(uint8_t id, int8_t value) {
   // ENCx advances note within scale or octave if shifted
   if (id >= ENCODER_1 && id <= ENCODER_8) {
     uint8_t step = id - ENCODER_1;
-    if (value == -1 || value == 1) {
-      ScaleStep(step, value > 0);
+    if (!Ui::increment_shifted()) {
+      ScaleStep(step, value);
     } else {
       uint8_t note = seq.note(step);
       value = Ui::FixOctaveIncrement(value);
@@ -174,11 +174,12 @@ void RandomizePage::SetScale(uint8_t scale) {
 }
 
 /* static */
-void RandomizePage::ScaleStep(uint8_t step, uint8_t up) {
+void RandomizePage::ScaleStep(uint8_t step, int8_t count) {
   uint8_t note = seq.note(step);
-  if (up) {
+  for (; count > 0; --count) {
     note = Scale::GetNextScaledNote(scale_, note);
-  } else { 
+  }
+  for (; count < 0; ++count) {
     note = Scale::GetPrevScaledNote(scale_, note);
   }
   seq.set_note(step, note);
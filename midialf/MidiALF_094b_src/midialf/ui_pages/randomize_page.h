@@ -48,7 +48,7 @@ class RandomizePage : public UiPage {
 
   static void SetScale(uint8_t scale);
   
-  static void ScaleStep(uint8_t step, uint8_t up);
+  static void ScaleStep(uint8_t step, int8_t count);
   static void RandStep(uint8_t step);
   static void ShuffleOrder();
   static void ResetNotes();
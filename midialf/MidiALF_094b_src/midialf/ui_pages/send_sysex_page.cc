@@ -28,6 +28,9 @@ uint8_t SendSysExPage::slot_;
 /* static */
 uint8_t SendSysExPage::name_[kNameLength];
 
+/* static */
+uint8_t SendSysExPage::sending_;
+
 /* static */
 const prog_EventHandlers SendSysExPage::event_handlers_ PROGMEM = {
   OnInit,
@@ -42,7 +45,6 @@ const prog_EventHandlers SendSysExPage::event_handlers_ PROGMEM = {
 
 /* static */
 void SendSysExPage::OnInit(PageInfo* pageInfo, UiPageIndex prevPage) {
-  seq.Stop();
   SetSlot(seq.slot());
 }
 
@@ -67,7 +69,7 @@ uint8_t SendSysExPage::OnClick(uint8_t id, uint8_t value) {
 
   switch (id) {
     case ENCODER_A: Ui::ShowLastPage(); break;  // ENCA cancels mode
-    case ENCODER_B: SendSlot(); break;          // ENCB sends selected program slot
+    case ENCODER_B: SendSlot(); break;          // ENCB sends selected program slot or cancels
     case ENCODER_6: SendSeq(); break;           // ENC6 sends current sequence
     case ENCODER_7: SendPgm(); break;           // ENC7 sends current program
     case ENCODER_8: SendAll(); break;           // ENC8 sends all program slots
@@ -87,6 +89,11 @@ uint8_t SendSysExPage::OnSwitch(uint8_t id, uint8_t value) {
 
 /* static */
 uint8_t SendSysExPage::OnIdle() {
+  // Follow the progress of the programs being sent
+  if (sysex_handler.sending() || sending_) {
+    sending_ = sysex_handler.sending();
+    return 1;
+  }
   return 0;
 }
 
@@ -96,8 +103,20 @@ void SendSysExPage::UpdateScreen() {
   char* line2 = display.line_buffer(1);
 
   static const prog_char cmdSend[] PROGMEM = "[Send]";
+  static const prog_char cmdCancel[] PROGMEM = "[Cancel]";
   static const prog_char cmds[] PROGMEM = "[Seq] [Pgm] [All]";
 
+  if (sysex_handler.sending()) {
+    memcpy_P(&line1[0], PSTRN("Sending program:"));
+    memcpy_P(&line1[kLcdWidth - lengof(cmdCancel)], cmdCancel, lengof(cmdCancel));
+
+    uint8_t slot = sysex_handler.sending_slot();
+    uint8_t name[kNameLength]; storage.ReadSlotName(slot, name);
+    Ui::PrintNumb(&line2[0], 1 + slot);
+    memcpy(&line2[4], name, kNameLength);
+    return;
+  }
+
   memcpy_P(&line1[0], PSTRN("Send sysex with:"));
   memcpy_P(&line1[kLcdWidth - lengof(cmdSend)], cmdSend, lengof(cmdSend));
 
@@ -119,7 +138,12 @@ void SendSysExPage::SetSlot(uint8_t slot) {
 
 /* static */
 void SendSysExPage::SendSlot() {
-  sysex_handler.SendPgm(slot_);
+  if (sysex_handler.sending()) {
+    sysex_handler.Cancel();
+  } else {
+    sysex_handler.SendPgm(slot_);
+    sending_ = 1;
+  }
 }
 
 /* static */
@@ -135,6 +159,7 @@ void SendSysExPage::SendPgm() {
 /* static */
 void SendSysExPage::SendAll() {
   sysex_handler.SendAll();
+  sending_ = 1;
 }
 
 } // namespace midialf
@@ -45,6 +45,7 @@ class SendSysExPage : public UiPage {
  protected:
   static uint8_t slot_;
   static uint8_t name_[kNameLength];
+  static uint8_t sending_;
 
   static void SetSlot(uint8_t slot);
 
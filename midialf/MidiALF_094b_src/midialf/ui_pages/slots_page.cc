@@ -0,0 +1,195 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Program slots copy/move/swap page class.
+
+#include "midialf/ui_pages/slots_page.h"
+#include "midialf/storage.h"
+
+namespace midialf {
+
+/* static */
+uint8_t SlotsPage::from_;
+
+/* static */
+uint8_t SlotsPage::to_;
+
+/* static */
+uint16_t SlotsPage::count_;
+
+/* static */
+uint8_t SlotsPage::from_name_[kNameLength];
+
+/* static */
+uint8_t SlotsPage::to_name_[kNameLength];
+
+/* static */
+const prog_EventHandlers SlotsPage::event_handlers_ PROGMEM = {
+  OnInit,
+  OnQuit,
+  OnIncrement,
+  OnClick,
+  OnSwitch,
+  OnIdle,
+  UpdateScreen,
+  UpdateLeds,
+};
+
+/* static */
+void SlotsPage::OnInit(PageInfo* pageInfo, UiPageIndex prevPage) {
+  SetSlots(seq.slot(), seq.slot() + 1, 1);
+}
+
+/* static */
+void SlotsPage::OnQuit(UiPageIndex nextPage) {
+}
+
+/* static */
+uint8_t SlotsPage::OnIncrement(uint8_t id, int8_t value) {
+  switch (id) {
+    case ENCODER_1: SetSlots((int16_t)from_ + value, to_, count_); break;   // ENC1 changes first source slot
+    case ENCODER_2: SetSlots(from_, to_, (int16_t)count_ + value); break;   // ENC2 changes number of slots
+    case ENCODER_B: SetSlots(from_, (int16_t)to_ + value, count_); break;   // ENCB changes first target slot
+  }
+  return 1;
+}
+
+/* static */
+uint8_t SlotsPage::OnClick(uint8_t id, uint8_t value) {
+  if (value != CLICK)
+    return 0;
+
+  switch (id) {
+    case ENCODER_A: break;                // ENCA cancels mode
+    case ENCODER_6: CopySlots(); break;   // ENC6 copies slots
+    case ENCODER_7: MoveSlots(); break;   // ENC7 moves slots
+    case ENCODER_8: SwapSlots(); break;   // ENC8 swaps slots
+    default: return 1;
+  }
+  Ui::ShowLastPage();
+  return 1;
+}
+
+/* static */
+uint8_t SlotsPage::OnSwitch(uint8_t id, uint8_t value) {
+  // Execute commands
+  if (id == SWITCH) {
+    return 1;
+  }
+  return 0;
+}
+
+/* static */
+uint8_t SlotsPage::OnIdle() {
+  return 0;
+}
+
+/* static */
+void SlotsPage::UpdateScreen() {
+  char* line1 = display.line_buffer(0);
+  char* line2 = display.line_buffer(1);
+
+  static const prog_char cmds[] PROGMEM = "[Cpy] [Mov] [Swp]";
+
+  memcpy_P(&line1[0], PSTRN("Slots"));
+  Ui::PrintNumb(&line1[6], 1 + from_);
+  line1[9] = '-';
+  Ui::PrintNumb(&line1[10], from_ + count_);
+  memcpy(&line1[14], from_name_, kNameLength);
+  memcpy_P(&line1[14 + kNameLength + 1], PSTRN("to:"));
+
+  Ui::PrintNumb(&line2[0], 1 + to_);
+  memcpy(&line2[4], to_name_, kNameLength);
+  
+  memcpy_P(&line2[kLcdWidth - lengof(cmds)], cmds, lengof(cmds));
+}
+
+/* static */
+void SlotsPage::UpdateLeds() {
+}
+
+/* static */
+void SlotsPage::SetSlots(int16_t from, int16_t to, int16_t count) {
+  uint16_t num_slots = storage.num_slots();
+  from_ = Clamp(from, 0, num_slots - 1);
+  to_ = Clamp(to, 0, num_slots - 1);
+  count_ = Clamp(count, 1, num_slots - max(from_, to_));
+  storage.ReadSlotName(from_, from_name_);
+  storage.ReadSlotName(to_, to_name_);
+}
+
+/* static */
+void SlotsPage::CopySlots() {
+  if (!Confirm())
+    return;
+
+  StartProgress(PSTR("Copying program:"));
+  storage.CopySlots(from_, to_, count_, ProgressCallback);
+}
+
+/* static */
+void SlotsPage::MoveSlots() {
+  if (!Confirm())
+    return;
+
+  StartProgress(PSTR("Moving program:"));
+  storage.MoveSlots(from_, to_, count_, ProgressCallback);
+}
+
+/* static */
+void SlotsPage::SwapSlots() {
+  // Nothing is lost, so no confirmation here
+  StartProgress(PSTR("Swapping program:"));
+  storage.SwapSlots(from_, to_, count_, ProgressCallback);
+}
+
+/* static */
+uint8_t SlotsPage::Confirm() {
+  Dialog dialog(PSTR("This will overwrite the target programs!\nAre you sure?"), PSTR("[Yes] [No]"), 2);
+  return dialog.result() == 1;
+}
+
+/* static */
+void SlotsPage::StartProgress(const prog_char* prompt) {
+  Ui::Clear();
+
+  char* line1 = display.line_buffer(0);
+
+  static const prog_char cmdCancel[] PROGMEM = "[Cancel]";
+
+  memcpy_P(&line1[0], prompt, strlen_P(prompt));
+  memcpy_P(&line1[kLcdWidth - lengof(cmdCancel)], cmdCancel, lengof(cmdCancel));
+}
+
+/* static */
+uint8_t SlotsPage::ProgressCallback(uint16_t slot, uint16_t total) {
+  // The sequencer keeps running from the timer interrupts meanwhile
+  char* line2 = display.line_buffer(1);
+
+  uint8_t name[kNameLength]; storage.ReadSlotName(slot, name);
+  Ui::PrintNumb(&line2[0], 1 + slot);
+  memcpy(&line2[4], name, kNameLength);
+  Ui::RedrawScreen();
+
+  // Check if cancelled
+  if (Ui::GetEncoderState(ENCODER_B) == 0)
+    return 0;
+
+  return 1;
+}
+
+} // namespace midialf
@@ -46,7 +46,7 @@ uint8_t SysSettingsPage::OnIncrement(uint8_t id, int8_t value) {
   switch (id) {
     case ENCODER_1: UpdateClockMode(value); return 1;
     case ENCODER_2: UpdateSeqSwitchMode(value); return 1;
-    case ENCODER_3: return 1;
+    case ENCODER_3: UpdateRecordLatency(value); return 1;
 #ifdef ENABLE_CV_OUTPUT
     case ENCODER_4: UpdateStrobeWidth(value); return 1;
 #else
@@ -68,7 +68,7 @@ uint8_t SysSettingsPage::OnClick(uint8_t id, uint8_t value) {
   switch (id) {
     case ENCODER_1: seq.set_clock_mode(CLOCK_MODE_INTERNAL); return 1;
     case ENCODER_2: seq.set_seq_switch_mode(SEQ_SWITCH_MODE_IMMEDIATE); return 1;
-    case ENCODER_3: return 1;
+    case ENCODER_3: seq.set_record_latency(kDefRecordLatency); return 1;
 #ifdef ENABLE_CV_OUTPUT
     case ENCODER_4: seq.set_strobe_width(kDefStrobeWidth); return 1;
 #else
@@ -88,7 +88,7 @@ uint8_t SysSettingsPage::OnSwitch(uint8_t id, uint8_t value) {
     switch (value) {
       case SWITCH_1: UpdateClockMode(0); return 1;
       case SWITCH_2: UpdateSeqSwitchMode(0); return 1;
-      case SWITCH_3: return 1;
+      case SWITCH_3: UpdateRecordLatency(0); return 1;
 #ifdef ENABLE_CV_OUTPUT
       case SWITCH_4: UpdateStrobeWidth(0); return 1;
 #else
@@ -112,15 +112,17 @@ uint8_t SysSettingsPage::OnIdle() {
 void SysSettingsPage::UpdateScreen() {
   DrawSeparators();
 #ifdef ENABLE_CV_OUTPUT
-  DrawCells(0, PSTR(" ClkSeqX----StrbPrgCCtlC--------"));
+  DrawCells(0, PSTR(" ClkSeqXRLatStrbPrgCCtlC--------"));
 #else
-  DrawCells(0, PSTR(" ClkSeqX--------PrgCCtlC--------"));
+  DrawCells(0, PSTR(" ClkSeqXRLat----PrgCCtlC--------"));
 #endif
 
   char* line2 = display.line_buffer(1);
 
   DrawSelStr(&line2[cell_pos(0)], seq.clock_mode(), PSTR(" int ext"));
   DrawSelStr(&line2[cell_pos(1)], seq.seq_switch_mode(), PSTR(" imm end"));
+  UnsafeItoa(seq.record_latency(), 2, &line2[cell_pos(2)]);
+  memcpy_P(&line2[cell_pos(2) + 2], PSTRN("ms"));
 #ifdef ENABLE_CV_OUTPUT
   DrawSelStr(&line2[cell_pos(3)], seq.strobe_width(), PSTR(" 1ms 2ms 3ms 4ms 5ms"));
 #endif
@@ -157,6 +159,17 @@ void SysSettingsPage::UpdateSeqSwitchMode(int8_t value) {
   }
 }
 
+/* static */
+void SysSettingsPage::UpdateRecordLatency(int8_t value) {
+  if (value) {
+    seq.set_record_latency(Clamp(static_cast<int16_t>(seq.record_latency()) + value, 0, kMaxRecordLatency));
+  } else {
+    uint8_t record_latency = seq.record_latency() + 5;
+    if (record_latency > kMaxRecordLatency) record_latency = 0;
+    seq.set_record_latency(record_latency);
+  }
+}
+
 /* static */
 void SysSettingsPage::UpdateStrobeWidth(int8_t value) {
   if (value) {
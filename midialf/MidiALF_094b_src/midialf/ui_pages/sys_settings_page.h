@@ -44,6 +44,7 @@ class SysSettingsPage : public UiPage {
  protected:
   static void UpdateClockMode(int8_t value);
   static void UpdateSeqSwitchMode(int8_t value);
+  static void UpdateRecordLatency(int8_t value);
   static void UpdateStrobeWidth(int8_t value);
   static void UpdateProgramChange(int8_t value);
   static void UpdateControlChange(int8_t value);
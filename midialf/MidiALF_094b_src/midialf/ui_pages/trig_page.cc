@@ -0,0 +1,114 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// UI page for step probability/ratchets/delay editing
+
+#include "midialf/ui_pages/trig_page.h"
+
+namespace midialf {
+
+/* static */
+const prog_EventHandlers TrigPage::event_handlers_ PROGMEM = {
+  OnInit,
+  OnQuit,
+  OnIncrement,
+  OnClick,
+  OnSwitch,
+  OnIdle,
+  UpdateScreen,
+  UpdateLeds,
+};
+
+/* static */
+void TrigPage::OnInit(PageInfo* pageInfo, UiPageIndex prevPage) {
+}
+
+/* static */
+void TrigPage::OnQuit(UiPageIndex nextPage) {
+}
+
+/* static */
+uint8_t TrigPage::OnIncrement(uint8_t id, int8_t value) {
+  // ENCA changes all probabilities, the level goes down as the probability goes up
+  if (id == ENCODER_A) {
+    for (uint8_t n = 0; n < kNumSteps; n++) {
+      uint8_t prob = seq.prob(n);
+      seq.set_prob(n, Clamp(static_cast<int16_t>(prob) - value, 0, kNumProbLevels - 1));
+    }
+    return 1;
+  }
+  // ENCx changes the probability, shifted ENCx the number of ratchets
+  if (id >= ENCODER_1 && id <= ENCODER_8) {
+    uint8_t step = id - ENCODER_1;
+    if (Ui::increment_shifted()) {
+      seq.set_ratchets(step, Clamp(static_cast<int16_t>(seq.ratchets(step)) + value / 10, 1, kMaxRatchets));
+    } else {
+      seq.set_prob(step, Clamp(static_cast<int16_t>(seq.prob(step)) - value, 0, kNumProbLevels - 1));
+    }
+    return 1;
+  }
+  return 0;
+}
+
+/* static */
+uint8_t TrigPage::OnClick(uint8_t id, uint8_t value) {
+  return 0;
+}
+
+/* static */
+uint8_t TrigPage::OnSwitch(uint8_t id, uint8_t value) {
+  // Step switch cycles the delay
+  if (id == SWITCH && value < kNumSteps) {
+    uint8_t delay = seq.delay(value);
+    seq.set_delay(value, delay < kMaxStepDelay ? delay + 1 : 0);
+    return 1;
+  }
+  return 0;
+}
+
+/* static */
+uint8_t TrigPage::OnIdle() {
+  return 0;
+}
+
+/* static */
+void TrigPage::UpdateScreen() {
+  static const prog_char probs[] PROGMEM = "100% 88% 75% 63% 50% 38% 25% 13%";
+  DrawSeparators();
+  char* line1 = display.line_buffer(0);
+  char* line2 = display.line_buffer(1);
+  for (uint8_t n = 0; n < kNumSteps; n++) {
+    uint8_t x = cell_pos(n);
+    DrawSelStr(&line1[x], seq.prob(n), probs);
+    uint8_t ratchets = seq.ratchets(n);
+    if (ratchets > 1) {
+      line2[x] = 'x';
+      line2[x + 1] = '0' + ratchets;
+    }
+    uint8_t delay = seq.delay(n);
+    if (delay) {
+      line2[x + 2] = '+';
+      line2[x + 3] = '0' + delay;
+    }
+  }
+}
+
+/* static */
+void TrigPage::UpdateLeds() {
+}
+
+} // namespace midialf
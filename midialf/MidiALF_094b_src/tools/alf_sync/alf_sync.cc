@@ -0,0 +1,568 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host tool keeping a .syx backup of the MidiALF program slots in sync with
+// the unit, transferring only the slots whose checksum has changed.
+//
+// Build:
+//   g++ -O2 -o alf_sync tools/alf_sync/alf_sync.cc
+//
+// Usage:
+//   alf_sync [--full] --port /dev/snd/midiC1D0 backup.syx
+//   alf_sync [--full] --loopback backup.syx
+//   alf_sync --benchmark [num_changed_slots...]
+//
+// The backup file holds the slot index (SYSEXCMD_SLOTINDEX blocks) read at
+// the time of the last sync, followed by the SYSEXCMD_PROGRAMPAGE blocks of
+// each slot, in slot order. The unit ignores the index blocks and writes the
+// pages to its storage, so sending the file back restores all the programs.
+// The backups holding one SYSEXCMD_PROGRAMDATA block per slot, with the save
+// flag set, are still read.
+//
+// A sync requests the slot index, compares it with the one in the backup,
+// and requests the programs of the mismatching slots with a single
+// SYSEXCMD_REQPROGRAMSETDATA message. The unit sends them in slot order.
+//
+// --loopback replaces the MIDI port with a model of the unit, which keeps
+// track of the time the transfer would take over a 31250 baud link
+// (including the spacing between the blocks and the page read time), so
+// that full and differential syncs can be compared without hardware.
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Keep in sync with midialf/sysex_handler.h and midialf/storage.h.
+enum SysExCommand {
+  SYSEXCMD_PROGRAMDATA = 0x02,
+  SYSEXCMD_SLOTINDEX = 0x03,
+  SYSEXCMD_PROGRAMPAGE = 0x04,
+  SYSEXCMD_REQALLPROGRAMDATA = 0x14,
+  SYSEXCMD_REQSLOTINDEX = 0x15,
+  SYSEXCMD_REQPROGRAMSETDATA = 0x16,
+};
+
+const uint8_t kHeader[] = { 0xf0, 0x29, 'A', 'L', 'F', 0x00 };
+const int kSlotIndexPageSize = 128;
+const int kMaxNumSlots = 256;
+const int kSlotSize = 256;
+const int kSlotCrcSize = kSlotSize - 4;
+const int kSlotPageSize = 32;
+const int kNumSlotPages = (kSlotCrcSize + kSlotPageSize - 1) / kSlotPageSize;
+const int kSeqDataOffset = 64;
+const int kSeqDataSize = 4 * 45;
+
+typedef std::vector<uint8_t> Bytes;
+
+struct Message {
+  uint8_t command;
+  uint8_t argument;
+  Bytes payload;
+};
+
+// Same as _crc16_update() from avr-libc.
+uint16_t Crc16Update(uint16_t crc, uint8_t data) {
+  crc ^= data;
+  for (int i = 0; i < 8; ++i) {
+    crc = crc & 1 ? (crc >> 1) ^ 0xa001 : crc >> 1;
+  }
+  return crc;
+}
+
+Bytes Encode(const Message& message) {
+  Bytes bytes(kHeader, kHeader + sizeof(kHeader));
+  bytes.push_back(message.command);
+  bytes.push_back(message.argument);
+  uint8_t checksum = 0;
+  for (size_t i = 0; i < message.payload.size(); ++i) {
+    checksum += message.payload[i];
+    bytes.push_back(message.payload[i] >> 4);
+    bytes.push_back(message.payload[i] & 0x0f);
+  }
+  bytes.push_back(checksum >> 4);
+  bytes.push_back(checksum & 0x0f);
+  bytes.push_back(0xf7);
+  return bytes;
+}
+
+// Decodes a complete SysEx block, from 0xf0 to 0xf7 included.
+bool Decode(const Bytes& bytes, Message* message) {
+  size_t size = bytes.size();
+  if (size < sizeof(kHeader) + 5 || (size - sizeof(kHeader) - 3) & 1 ||
+      memcmp(&bytes[0], kHeader, sizeof(kHeader)) != 0) {
+    return false;
+  }
+  message->command = bytes[sizeof(kHeader)];
+  message->argument = bytes[sizeof(kHeader) + 1];
+  message->payload.clear();
+  uint8_t checksum = 0;
+  for (size_t i = sizeof(kHeader) + 2; i < size - 3; i += 2) {
+    uint8_t byte = (bytes[i] << 4) | (bytes[i + 1] & 0x0f);
+    checksum += byte;
+    message->payload.push_back(byte);
+  }
+  return checksum == ((bytes[size - 3] << 4) | (bytes[size - 2] & 0x0f));
+}
+
+class MidiPort {
+ public:
+  virtual ~MidiPort() { }
+  virtual bool Write(const Bytes& bytes) = 0;
+  // Returns false if nothing was received within timeout_ms.
+  virtual bool Read(uint8_t* byte, int timeout_ms) = 0;
+  virtual double elapsed_ms() = 0;
+
+  bool Send(const Message& message) {
+    return Write(Encode(message));
+  }
+
+  bool Receive(Message* message, int timeout_ms) {
+    Bytes bytes;
+    uint8_t byte;
+    while (Read(&byte, timeout_ms)) {
+      if (byte == 0xf0) {
+        bytes.clear();
+      } else if (bytes.empty() || byte >= 0xf8) {
+        continue;  // Not in a SysEx block, or realtime message.
+      }
+      bytes.push_back(byte);
+      if (byte == 0xf7 && Decode(bytes, message)) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+class RawMidiPort : public MidiPort {
+ public:
+  RawMidiPort() : fd_(-1) { }
+  ~RawMidiPort() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  bool Open(const char* path) {
+    fd_ = open(path, O_RDWR);
+    gettimeofday(&start_, NULL);
+    return fd_ >= 0;
+  }
+
+  virtual bool Write(const Bytes& bytes) {
+    return write(fd_, &bytes[0], bytes.size()) == (ssize_t)bytes.size();
+  }
+
+  virtual bool Read(uint8_t* byte, int timeout_ms) {
+    struct pollfd pfd = { fd_, POLLIN, 0 };
+    return poll(&pfd, 1, timeout_ms) == 1 && read(fd_, byte, 1) == 1;
+  }
+
+  virtual double elapsed_ms() {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (now.tv_sec - start_.tv_sec) * 1000.0 +
+        (now.tv_usec - start_.tv_usec) / 1000.0;
+  }
+
+ private:
+  int fd_;
+  struct timeval start_;
+};
+
+// Model of the unit, answering the sync requests the way SysExHandler does.
+class LoopbackPort : public MidiPort {
+ public:
+  LoopbackPort(int num_slots) : slots_(num_slots, Bytes(kSlotSize)),
+                                read_position_(0),
+                                elapsed_us_(0) {
+    srand(1);
+    for (int slot = 0; slot < num_slots; ++slot) {
+      for (int i = 0; i < kSlotSize; ++i) {
+        slots_[slot][i] = rand() & 0x7f;
+      }
+    }
+  }
+
+  void ModifySlot(int slot) {
+    slots_[slot][kSeqDataOffset + rand() % kSeqDataSize] ^= 0x01;
+  }
+
+  virtual bool Write(const Bytes& bytes) {
+    elapsed_us_ += bytes.size() * kByteTime;
+    Message message;
+    if (!Decode(bytes, &message)) {
+      return true;
+    }
+    switch (message.command) {
+      case SYSEXCMD_REQSLOTINDEX:
+        SendIndex();
+        break;
+      case SYSEXCMD_REQALLPROGRAMDATA:
+        SendSet(NULL);
+        break;
+      case SYSEXCMD_REQPROGRAMSETDATA:
+        if (message.payload.size() == kMaxNumSlots / 8) {
+          SendSet(&message.payload[0]);
+        }
+        break;
+    }
+    return true;
+  }
+
+  virtual bool Read(uint8_t* byte, int /* timeout_ms */) {
+    if (read_position_ == output_.size()) {
+      return false;
+    }
+    *byte = output_[read_position_++];
+    return true;
+  }
+
+  virtual double elapsed_ms() {
+    return elapsed_us_ / 1000.0;
+  }
+
+ private:
+  // 10 bits per byte at 31250 baud.
+  static const uint32_t kByteTime = 320;
+  // kSysExBlockGap between the programs and the index pages,
+  // kSysExPageGap between the pages of a program.
+  static const uint32_t kBlockSpacing = 100000;
+  static const uint32_t kPageSpacing = 10000;
+  // Storage::ReadSlotPage() and Storage::ReadSlotIndex() I2C transfers.
+  static const uint32_t kPageReadTime = 1000;
+  static const uint32_t kIndexPageReadTime = 7000;
+
+  void SendBlock(const Message& message, uint32_t spacing = kBlockSpacing) {
+    Bytes bytes = Encode(message);
+    output_.insert(output_.end(), bytes.begin(), bytes.end());
+    elapsed_us_ += bytes.size() * kByteTime + spacing;
+  }
+
+  void SendIndex() {
+    int num_slots = slots_.size();
+    for (int n = 0; n <= num_slots; n += kSlotIndexPageSize) {
+      Message message;
+      message.command = SYSEXCMD_SLOTINDEX;
+      message.argument = n / kSlotIndexPageSize;
+      for (int slot = n; slot < num_slots && slot < n + kSlotIndexPageSize;
+           ++slot) {
+        uint16_t crc = 0xffff;
+        for (int i = 0; i < kSlotCrcSize; ++i) {
+          crc = Crc16Update(crc, slots_[slot][i]);
+        }
+        message.payload.push_back(crc & 0xff);
+        message.payload.push_back(crc >> 8);
+      }
+      elapsed_us_ += kIndexPageReadTime;
+      SendBlock(message);
+    }
+  }
+
+  void SendSet(const uint8_t* set) {
+    for (size_t slot = 0; slot < slots_.size(); ++slot) {
+      if (set && !(set[slot >> 3] & (1 << (slot & 7)))) {
+        continue;
+      }
+      const Bytes& data = slots_[slot];
+      for (int page = 0; page < kNumSlotPages; ++page) {
+        int offset = page * kSlotPageSize;
+        int size = std::min(kSlotPageSize, kSlotCrcSize - offset);
+        Message message;
+        message.command = SYSEXCMD_PROGRAMPAGE;
+        message.argument = page;
+        message.payload.push_back(slot);
+        message.payload.insert(message.payload.end(),
+                               data.begin() + offset,
+                               data.begin() + offset + size);
+        elapsed_us_ += kPageReadTime;
+        SendBlock(message, page == kNumSlotPages - 1 ?
+            kBlockSpacing : kPageSpacing);
+      }
+    }
+  }
+
+  std::vector<Bytes> slots_;
+  Bytes output_;
+  size_t read_position_;
+  uint64_t elapsed_us_;
+};
+
+struct Backup {
+  std::vector<uint16_t> index;
+  std::vector<Bytes> programs;  // Encoded blocks of each slot.
+};
+
+bool LoadBackup(const std::string& path, Backup* backup) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) {
+    return false;
+  }
+  Bytes bytes;
+  int c;
+  while ((c = fgetc(f)) != EOF) {
+    if (c == 0xf0) {
+      bytes.clear();
+    }
+    bytes.push_back(c);
+    Message message;
+    if (c != 0xf7 || !Decode(bytes, &message)) {
+      continue;
+    }
+    if (message.command == SYSEXCMD_SLOTINDEX) {
+      for (size_t i = 0; i + 1 < message.payload.size(); i += 2) {
+        backup->index.push_back(
+            message.payload[i] | (message.payload[i + 1] << 8));
+      }
+    } else if (message.command == SYSEXCMD_PROGRAMDATA ||
+               (message.command == SYSEXCMD_PROGRAMPAGE &&
+                message.argument == 0)) {
+      backup->programs.push_back(bytes);
+    } else if (message.command == SYSEXCMD_PROGRAMPAGE &&
+               !backup->programs.empty()) {
+      Bytes& program = backup->programs.back();
+      program.insert(program.end(), bytes.begin(), bytes.end());
+    }
+  }
+  fclose(f);
+  // An index not matching the programs is useless.
+  if (backup->index.size() != backup->programs.size()) {
+    backup->index.clear();
+    backup->programs.clear();
+  }
+  return true;
+}
+
+bool SaveBackup(const std::string& path, const Backup& backup) {
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) {
+    return false;
+  }
+  for (size_t n = 0; n < backup.index.size(); n += kSlotIndexPageSize) {
+    Message message;
+    message.command = SYSEXCMD_SLOTINDEX;
+    message.argument = n / kSlotIndexPageSize;
+    for (size_t slot = n;
+         slot < backup.index.size() && slot < n + kSlotIndexPageSize;
+         ++slot) {
+      message.payload.push_back(backup.index[slot] & 0xff);
+      message.payload.push_back(backup.index[slot] >> 8);
+    }
+    Bytes bytes = Encode(message);
+    fwrite(&bytes[0], 1, bytes.size(), f);
+  }
+  for (size_t slot = 0; slot < backup.programs.size(); ++slot) {
+    fwrite(&backup.programs[slot][0], 1, backup.programs[slot].size(), f);
+  }
+  return fclose(f) == 0;
+}
+
+const int kTimeout = 2000;
+
+bool ReadIndex(MidiPort* port, std::vector<uint16_t>* index) {
+  Message request;
+  request.command = SYSEXCMD_REQSLOTINDEX;
+  request.argument = 0;
+  if (!port->Send(request)) {
+    return false;
+  }
+  // The last page is always shorter, and empty when the number of slots is
+  // a multiple of the page size.
+  index->clear();
+  Message message;
+  while (port->Receive(&message, kTimeout)) {
+    if (message.command != SYSEXCMD_SLOTINDEX ||
+        message.argument * kSlotIndexPageSize != (int)index->size()) {
+      continue;
+    }
+    for (size_t i = 0; i + 1 < message.payload.size(); i += 2) {
+      index->push_back(message.payload[i] | (message.payload[i + 1] << 8));
+    }
+    if (message.payload.size() < kSlotIndexPageSize * 2) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the number of slots transferred, or -1 on failure.
+int Sync(MidiPort* port, Backup* backup, bool full) {
+  std::vector<uint16_t> index;
+  if (!ReadIndex(port, &index)) {
+    fprintf(stderr, "No slot index received\n");
+    return -1;
+  }
+
+  std::vector<int> slots;
+  Message request;
+  if (full || backup->programs.size() != index.size()) {
+    backup->programs.assign(index.size(), Bytes());
+    for (size_t slot = 0; slot < index.size(); ++slot) {
+      slots.push_back(slot);
+    }
+    request.command = SYSEXCMD_REQALLPROGRAMDATA;
+    request.argument = 0;
+  } else {
+    request.command = SYSEXCMD_REQPROGRAMSETDATA;
+    request.argument = 0;
+    request.payload.assign(kMaxNumSlots / 8, 0);
+    for (size_t slot = 0; slot < index.size(); ++slot) {
+      if (index[slot] != backup->index[slot]) {
+        slots.push_back(slot);
+        request.payload[slot >> 3] |= 1 << (slot & 7);
+      }
+    }
+  }
+
+  if (!slots.empty()) {
+    if (!port->Send(request)) {
+      return -1;
+    }
+    // The programs are sent in slot order, page by page. A page cut by
+    // another message is sent again.
+    for (size_t n = 0; n < slots.size(); ++n) {
+      Bytes& program = backup->programs[slots[n]];
+      program.clear();
+      for (int page = 0; page < kNumSlotPages; ) {
+        Message message;
+        if (!port->Receive(&message, kTimeout)) {
+          fprintf(stderr, "Sync interrupted after %d slots\n", (int)n);
+          return -1;
+        }
+        if (message.command != SYSEXCMD_PROGRAMPAGE ||
+            message.argument != page || message.payload.empty() ||
+            message.payload[0] != slots[n]) {
+          continue;
+        }
+        Bytes bytes = Encode(message);
+        program.insert(program.end(), bytes.begin(), bytes.end());
+        ++page;
+      }
+    }
+  }
+  backup->index = index;
+  return slots.size();
+}
+
+int Benchmark(const std::vector<int>& changes) {
+  const int kNumSlots = kMaxNumSlots;
+  printf("%d slots\n", kNumSlots);
+  printf("changed     full (s)  differential (s)\n");
+  for (size_t i = 0; i < changes.size(); ++i) {
+    LoopbackPort port(kNumSlots);
+    Backup backup;
+    if (Sync(&port, &backup, true) != kNumSlots) {
+      return 1;
+    }
+    for (int n = 0; n < changes[i]; ++n) {
+      port.ModifySlot((n * 97) % kNumSlots);
+    }
+    double start = port.elapsed_ms();
+    Backup full_backup = backup;
+    if (Sync(&port, &full_backup, true) < 0) {
+      return 1;
+    }
+    double full = port.elapsed_ms() - start;
+    start = port.elapsed_ms();
+    if (Sync(&port, &backup, false) != changes[i]) {
+      return 1;
+    }
+    double differential = port.elapsed_ms() - start;
+    if (backup.programs != full_backup.programs) {
+      fprintf(stderr, "Differential sync mismatch\n");
+      return 1;
+    }
+    printf("%7d %12.1f %17.1f\n", changes[i], full / 1000, differential / 1000);
+  }
+  return 0;
+}
+
+void Usage() {
+  fprintf(stderr,
+      "usage: alf_sync [--full] (--port device | --loopback) backup.syx\n"
+      "       alf_sync --benchmark [num_changed_slots...]\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* device = NULL;
+  const char* path = NULL;
+  bool loopback = false;
+  bool full = false;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--benchmark")) {
+      std::vector<int> changes;
+      for (int j = i + 1; j < argc; ++j) {
+        changes.push_back(atoi(argv[j]));
+      }
+      if (changes.empty()) {
+        int defaults[] = { 0, 1, 4, 16, 64 };
+        changes.assign(defaults, defaults + 5);
+      }
+      return Benchmark(changes);
+    } else if (!strcmp(argv[i], "--port") && i + 1 < argc) {
+      device = argv[++i];
+    } else if (!strcmp(argv[i], "--loopback")) {
+      loopback = true;
+    } else if (!strcmp(argv[i], "--full")) {
+      full = true;
+    } else {
+      path = argv[i];
+    }
+  }
+  if (!path || !(device || loopback)) {
+    Usage();
+    return 1;
+  }
+
+  RawMidiPort raw_port;
+  LoopbackPort loopback_port(kMaxNumSlots);
+  MidiPort* port = &loopback_port;
+  if (!loopback) {
+    if (!raw_port.Open(device)) {
+      perror(device);
+      return 1;
+    }
+    port = &raw_port;
+  }
+
+  Backup backup;
+  LoadBackup(path, &backup);
+  int num_transferred = Sync(port, &backup, full);
+  if (num_transferred < 0) {
+    return 1;
+  }
+  if (!SaveBackup(path, backup)) {
+    perror(path);
+    return 1;
+  }
+  printf("%d of %d slots transferred in %.1fs\n",
+         num_transferred, (int)backup.index.size(), port->elapsed_ms() / 1000);
+  return 0;
+}
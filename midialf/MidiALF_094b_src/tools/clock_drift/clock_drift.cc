@@ -0,0 +1,181 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Long run accuracy and tempo ramps of the internal clock.
+//
+// The real Clock is ticked as the Timer1 compare ISR does: each Tick() returns
+// the compare value of the next tick, which lasts that many timer counts plus
+// one.
+//
+//   drift   for every tempo from 25.0 to 250.0 BPM, the time taken by an
+//           hour's worth of ticks (whole groove patterns), against the exact
+//           7812500 / (bpm * 10 + tenth) counts per tick. The groove
+//           templates at full amount are played on every 5th tempo. The
+//           former clock used the truncated tick duration, its drift is
+//           given for comparison.
+//   ramps   tempo changes while running: the largest change of the tick
+//           duration from one tick to the next, against the even steps of a
+//           linear ramp over a beat, and the ticks taken to reach the new
+//           tempo.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile clock_drift
+//   build/tools/clock_drift            prints the results
+//   build/tools/clock_drift --check    exits with an error if the clock drifts
+//                                      by more than 100us in an hour, or if a
+//                                      ramp is not monotonic, steps by more
+//                                      than 2 counts (rounding of the two
+//                                      durations) over the even steps, or
+//                                      does not reach the new tempo in a beat
+
+#include "midialf/clock.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace midialf;
+
+namespace {
+
+const double kTimerCountsPerSecond = F_CPU / 64.0;
+const uint32_t kNumTicksPerBeat = 24;
+const uint32_t kNumTicksPerPattern = kNumTicksPerStep *
+    kNumStepsInGroovePattern;
+
+double TickDuration(uint16_t bpm_10) {
+  return 7812500.0 / bpm_10;
+}
+
+// Drift over an hour, in seconds.
+double Drift(uint16_t bpm_10, uint8_t groove_template, uint8_t groove_amount) {
+  clock.Update(bpm_10 / 10, bpm_10 % 10, groove_template, groove_amount);
+  clock.Start();
+  double tick = TickDuration(bpm_10);
+  uint32_t num_ticks = static_cast<uint32_t>(3600.0 * kTimerCountsPerSecond /
+      tick);
+  num_ticks -= num_ticks % kNumTicksPerPattern;
+  for (uint32_t i = 0; i < num_ticks; ++i) {
+    clock.Tick();
+  }
+  clock.Stop();
+  return (clock.value() - num_ticks * tick) / kTimerCountsPerSecond;
+}
+
+struct Ramp {
+  uint16_t from;
+  uint16_t to;
+};
+
+const Ramp kRamps[] = {
+  { 120, 121 },
+  { 121, 180 },
+  { 180, 60 },
+  { 60, 250 },
+  { 250, 25 },
+  { 25, 120 },
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: clock_drift [--check]\n");
+    return 1;
+  }
+  int failures = 0;
+
+  double worst = 0.0;
+  uint16_t worst_bpm_10 = 0;
+  uint8_t worst_template = 0;
+  double former_worst = 0.0;
+  uint16_t former_worst_bpm_10 = 0;
+  for (uint16_t bpm_10 = kMinBpm * 10; bpm_10 <= kMaxBpm * 10; ++bpm_10) {
+    uint8_t num_templates = bpm_10 % 5 ? 1 : kNumGrooveTemplates + 1;
+    for (uint8_t t = 0; t < num_templates; ++t) {
+      double drift = t ? Drift(bpm_10, t - 1, 127) : Drift(bpm_10, 0, 0);
+      if (fabs(drift) > fabs(worst)) {
+        worst = drift;
+        worst_bpm_10 = bpm_10;
+        worst_template = t;
+      }
+    }
+    double tick = TickDuration(bpm_10);
+    double former = (floor(tick) - tick) / tick * 3600.0;
+    if (fabs(former) > fabs(former_worst)) {
+      former_worst = former;
+      former_worst_bpm_10 = bpm_10;
+    }
+  }
+  printf("drift over an hour, 25.0 to 250.0 BPM:\n");
+  printf("  fractional tick:  %+.1f us at %d.%d BPM",
+         worst * 1e6, worst_bpm_10 / 10, worst_bpm_10 % 10);
+  if (worst_template) {
+    printf(", groove template %d", worst_template - 1);
+  }
+  printf("\n  truncated tick:   %+.3f s at %d.%d BPM (former clock)\n",
+         former_worst, former_worst_bpm_10 / 10, former_worst_bpm_10 % 10);
+  if (fabs(worst) > 100e-6) {
+    ++failures;
+  }
+
+  printf("tempo ramps, tick duration in timer counts:\n");
+  printf("  %7s %9s %9s %9s %9s\n", "BPM", "max step", "even", "ticks",
+         "monotonic");
+  for (uint8_t r = 0; r < sizeof(kRamps) / sizeof(kRamps[0]); ++r) {
+    const Ramp& ramp = kRamps[r];
+    clock.Update(ramp.from, 0, 0);
+    clock.Start();
+    for (uint32_t i = 0; i < kNumTicksPerBeat; ++i) {
+      clock.Tick();
+    }
+    clock.Update(ramp.to, 0, 0);
+    double from = TickDuration(ramp.from * 10);
+    double to = TickDuration(ramp.to * 10);
+    double even_step = fabs(to - from) / kNumTicksPerBeat;
+    double max_step = 0.0;
+    bool monotonic = true;
+    uint32_t ticks_to_target = 0;
+    uint32_t previous = clock.Tick() + 1;
+    for (uint32_t i = 1; i < 4 * kNumTicksPerBeat; ++i) {
+      uint32_t duration = clock.Tick() + 1;
+      double step = fabs(static_cast<double>(duration) - previous);
+      if (step > max_step) {
+        max_step = step;
+      }
+      if ((to > from && duration + 1 < previous) ||
+          (to < from && duration > previous + 1)) {
+        monotonic = false;
+      }
+      if (!ticks_to_target && fabs(duration - to) <= 1.0) {
+        ticks_to_target = i + 1;
+      }
+      previous = duration;
+    }
+    clock.Stop();
+    printf("  %3d-%-3d %9.0f %9.1f %9u %9s\n", ramp.from, ramp.to, max_step,
+           even_step, ticks_to_target, monotonic ? "yes" : "no");
+    if (!monotonic || max_step > even_step + 2.0 || !ticks_to_target ||
+        ticks_to_target > kNumTicksPerBeat + 1) {
+      ++failures;
+    }
+  }
+  return check && failures ? 1 : 0;
+}
@@ -0,0 +1,429 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Slew curves and cost of the CV outputs.
+//
+// The real seq, clock, LFO, CV and port code runs on a virtual Timer1 and a
+// virtual TIMER2 (4.9kHz), which calls CV::Tick() and Port::Tick() as the
+// ISR in midialf.cc does. The CV outputs are set to note, LFO 1, CC 1 and
+// velocity.
+//
+//   glide   a sequence of wide intervals, with legato on every other step,
+//           plays for 8 passes. After a legato step, the note CV must glide
+//           to the new note monotonically in 50ms. Otherwise, and for the
+//           velocity CV, the new value must be reached on the next tick.
+//   lfo     LFO values are sent once per MIDI clock at 120 BPM (102 ticks),
+//           as LFO 1 does, and follow a sine. The former firmware set the
+//           CV to each value, the largest of these steps is given against
+//           the largest change of the interpolated CV from one tick to the
+//           next.
+//   cc      a full range CC 1 change ramps over 5ms.
+//   idle    once the sequencer is stopped and the slews are over, no DAC is
+//           written for a second.
+//   cost    host time per CV::Tick() call, idle and with the 4 outputs
+//           ramping. The AVR cycles are not counted.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile cv_slew
+//   build/tools/cv_slew            prints the results
+//   build/tools/cv_slew --check    exits with an error if a glide is not
+//                                  monotonic, ends 2 ticks away from 50ms or
+//                                  moves by more than 1 unit over the even
+//                                  steps, if a jump takes more than a tick,
+//                                  if the LFO CV moves by more than 1 unit
+//                                  over the even steps, or if a DAC is
+//                                  written while idle
+
+#include "midialf/clock.h"
+#include "midialf/cv/cv.h"
+#include "midialf/cv/port.h"
+#include "midialf/event_scheduler.h"
+#include "midialf/lfo.h"
+#include "midialf/midi_handler.h"
+#include "midialf/note_duration.h"
+#include "midialf/seq.h"
+#include "midialf/storage.h"
+#include "midialf/sysex_handler.h"
+#include "midialf/ui.h"
+
+#include "avrlib/time.h"
+
+#include "tools/host/host.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+namespace midialf {
+
+// Stubs for the parts of the firmware the sequencer calls into.
+
+volatile uint8_t SysExHandler::block_open_;
+volatile uint8_t SysExHandler::block_aborted_;
+
+uint8_t Storage::ReadSeqData(uint8_t, SeqData*, uint8_t) { return 0; }
+uint8_t Storage::ReadSeqInfo(uint8_t, SeqInfo*) { return 0; }
+uint8_t Storage::WriteSeqData(uint8_t, const SeqData*, uint8_t) { return 0; }
+uint8_t Storage::WriteSeqInfo(uint8_t, const SeqInfo*) { return 0; }
+
+int16_t Ui::Scale(int16_t, int16_t, int16_t, int16_t, int16_t x1max) {
+  return x1max;
+}
+
+}  // namespace midialf
+
+using namespace avrlib;
+using namespace midialf;
+
+namespace {
+
+// Time is counted in CPU cycles.
+const uint32_t kCyclesPerTimer1Count = 64;
+const uint32_t kCyclesPerCvTick = 4080;  // TIMER2, 4.9kHz
+const uint8_t kBpm = 120;
+const uint8_t kNumPasses = 8;
+const uint32_t kMaxCvTicks = 65536;
+const uint8_t kNotes[kNumSteps] = {
+  36, 72, 48, 96, 60, 24, 100, 52,
+};
+
+enum CvOutput {
+  CV_NOTE,
+  CV_LFO,
+  CV_CC,
+  CV_VELO,
+};
+
+// Values of the CVs after each CV tick, and the CV tick each step starts on.
+uint16_t values[kCVCount][kMaxCvTicks];
+uint32_t num_cv_ticks;
+uint32_t step_ticks[kNumPasses * kNumSteps];
+uint8_t step_numbers[kNumPasses * kNumSteps];
+uint32_t num_steps;
+uint32_t num_dac_writes;
+
+uint64_t now;
+uint16_t interval;
+
+void DrainOutput() {
+  uint8_t data[256];
+  while (HostUartRead(0, data, sizeof(data))) { }
+  MidiHandler::OutputBuffer::Flush();
+}
+
+// See ISR(TIMER1_COMPA_vect) in midialf.cc.
+void Timer1Interrupt() {
+  timer0_milliseconds.value = static_cast<uint32_t>(now / (F_CPU / 1000));
+  interval = midialf::clock.Tick() + 1;
+  if (midialf::clock.running()) {
+    seq.OnInternalClockTick();
+    if (midialf::clock.stepped()) {
+      seq.OnInternalClockStep();
+    }
+  }
+  DrainOutput();
+}
+
+// See ISR(TIMER2_OVF_vect) in midialf.cc. Each dirty output is a 2 byte DAC
+// write.
+void CvTick() {
+  uint8_t dirty = cv.dirty();
+  for (uint8_t n = 0; n < kCVCount; ++n) {
+    if (dirty & (1 << n)) {
+      ++num_dac_writes;
+    }
+  }
+  cv.Tick();
+  port.Tick();
+  if (num_cv_ticks < kMaxCvTicks) {
+    for (uint8_t n = 0; n < kCVCount; ++n) {
+      values[n][num_cv_ticks] = cv.get(n);
+    }
+  }
+  ++num_cv_ticks;
+}
+
+void Reset() {
+  now = 0;
+  interval = 1;
+  num_cv_ticks = 0;
+  num_steps = 0;
+  num_dac_writes = 0;
+  timer0_milliseconds.value = 0;
+
+  event_scheduler.Init();
+  seq.set_slot(0);
+  seq.InitSeqInfo();
+  for (uint8_t s = 0; s < 4; ++s) {
+    seq.InitSeq(s);
+  }
+  seq.Init();
+  seq.set_bpm(kBpm);
+  seq.set_clock_rate(k16thNote);
+  seq.set_cv_mode(CV_NOTE, CVMODE_NOTE);
+  seq.set_cv_mode(CV_LFO, CVMODE_LFO1);
+  seq.set_cv_mode(CV_CC, CVMODE_CC1);
+  seq.set_cv_mode(CV_VELO, CVMODE_VELO);
+  for (uint8_t n = 0; n < kCVCount; ++n) {
+    cv.set(n, 0);
+  }
+  DrainOutput();
+}
+
+// Runs the firmware until the given CV tick, logging the steps started.
+void RunUntil(uint32_t cv_tick, uint64_t* next_timer1) {
+  uint8_t step = seq.step();
+  while (num_cv_ticks < cv_tick) {
+    uint64_t next_cv_tick = static_cast<uint64_t>(num_cv_ticks + 1) *
+        kCyclesPerCvTick;
+    if (*next_timer1 < next_cv_tick) {
+      now = *next_timer1;
+      Timer1Interrupt();
+      *next_timer1 += interval * kCyclesPerTimer1Count;
+      if (seq.running() && seq.step() != step) {
+        step = seq.step();
+        if (num_steps < kNumPasses * kNumSteps) {
+          step_ticks[num_steps] = num_cv_ticks;
+          step_numbers[num_steps] = step;
+          ++num_steps;
+        }
+      }
+    } else {
+      now = next_cv_tick;
+      CvTick();
+    }
+  }
+}
+
+uint16_t NoteDacValue(uint8_t note) {
+  // As note2dac in cv.cc: 4096 units for 120 notes.
+  return (note * 512 + 7) / 15;
+}
+
+struct GlideResult {
+  uint32_t num_glides;
+  uint32_t num_jumps;
+  uint32_t min_glide;  // ticks
+  uint32_t max_glide;
+  uint32_t max_jump;
+  double max_excess;  // DAC units per tick, over the even steps
+  bool monotonic;
+};
+
+// Measures how the CV moves from the start of each step to the value of the
+// step, which is reached in ticks.
+uint32_t Follow(uint8_t cv, uint32_t start, uint32_t end, uint16_t from,
+                uint16_t to, double* max_step, bool* monotonic) {
+  uint32_t t = start;
+  uint16_t previous = from;
+  *max_step = 0.0;
+  while (t < end && values[cv][t] != to) {
+    uint16_t value = values[cv][t];
+    if ((to > from && value < previous) || (to < from && value > previous)) {
+      *monotonic = false;
+    }
+    double step = fabs(static_cast<double>(value) - previous);
+    *max_step = step > *max_step ? step : *max_step;
+    previous = value;
+    ++t;
+  }
+  double step = fabs(static_cast<double>(to) - previous);
+  *max_step = step > *max_step ? step : *max_step;
+  return t - start + 1;
+}
+
+GlideResult Glides() {
+  Reset();
+  for (uint8_t step = 0; step < kNumSteps; ++step) {
+    seq.set_note(0, step, kNotes[step]);
+    seq.set_velo(0, step, 20 + step * 7);
+    seq.set_gate(0, step, k16thNote);
+    seq.set_lega(0, step, step & 1);
+  }
+  seq.Start();
+  uint64_t next_timer1 = 0;
+  uint32_t end = static_cast<uint32_t>(
+      (kNumPasses * kNumSteps + 1) * 60.0 / kBpm / 4 * F_CPU /
+      kCyclesPerCvTick);
+  RunUntil(end, &next_timer1);
+  seq.Stop();
+  DrainOutput();
+
+  GlideResult r;
+  memset(&r, 0, sizeof(r));
+  r.min_glide = ~0;
+  r.monotonic = true;
+  for (uint32_t i = 1; i < num_steps; ++i) {
+    uint8_t step = step_numbers[i];
+    uint8_t previous_step = step_numbers[i - 1];
+    uint16_t from = NoteDacValue(kNotes[previous_step]);
+    uint16_t to = NoteDacValue(kNotes[step]);
+    uint32_t start = step_ticks[i];
+    uint32_t end = i + 1 < num_steps ? step_ticks[i + 1] : num_cv_ticks;
+    double max_step;
+    uint32_t ticks = Follow(CV_NOTE, start, end, from, to, &max_step,
+                            &r.monotonic);
+    if (seq.lega(0, previous_step)) {
+      ++r.num_glides;
+      r.min_glide = ticks < r.min_glide ? ticks : r.min_glide;
+      r.max_glide = ticks > r.max_glide ? ticks : r.max_glide;
+      double even = fabs(static_cast<double>(to) - from) / kCVGlideTicks;
+      if (max_step - even > r.max_excess) {
+        r.max_excess = max_step - even;
+      }
+    } else {
+      ++r.num_jumps;
+      r.max_jump = ticks > r.max_jump ? ticks : r.max_jump;
+    }
+    // The velocity CV jumps on every step.
+    ticks = Follow(CV_VELO, start, end, seq.velo(0, previous_step) << 5,
+                   seq.velo(0, step) << 5, &max_step, &r.monotonic);
+    r.max_jump = ticks > r.max_jump ? ticks : r.max_jump;
+  }
+  return r;
+}
+
+struct LfoResult {
+  uint16_t max_staircase;  // DAC units per update
+  uint16_t max_step;  // DAC units per tick
+  double max_excess;
+};
+
+LfoResult LfoSine() {
+  Reset();
+  // One LFO value per MIDI clock at 120 BPM, a 4 beat sine.
+  const uint32_t kUpdateTicks = 102;
+  const uint32_t kNumUpdates = 4 * 24 * 4;
+  uint64_t next_timer1 = ~0ULL;
+  LfoResult r;
+  memset(&r, 0, sizeof(r));
+  uint8_t previous_value = 64;
+  for (uint32_t k = 0; k < kNumUpdates; ++k) {
+    uint8_t value = 64 + static_cast<int8_t>(63 * sin(2 * M_PI * k / 96));
+    uint16_t staircase = abs(value - previous_value) << 5;
+    if (k > 1 && staircase > r.max_staircase) {
+      r.max_staircase = staircase;
+    }
+    cv.SendLFO1(value);
+    uint32_t start = num_cv_ticks;
+    RunUntil(start + kUpdateTicks, &next_timer1);
+    for (uint32_t t = start; k > 1 && t < num_cv_ticks; ++t) {
+      uint16_t step = abs(values[CV_LFO][t] - values[CV_LFO][t - 1]);
+      r.max_step = step > r.max_step ? step : r.max_step;
+      double excess = step - static_cast<double>(staircase) / kUpdateTicks;
+      r.max_excess = excess > r.max_excess ? excess : r.max_excess;
+    }
+    previous_value = value;
+  }
+  return r;
+}
+
+uint32_t CcRamp(uint16_t* halfway) {
+  Reset();
+  uint64_t next_timer1 = ~0ULL;
+  cv.SendCC1(0);
+  RunUntil(10, &next_timer1);
+  cv.SendCC1(127);
+  uint32_t start = num_cv_ticks;
+  RunUntil(start + 100, &next_timer1);
+  uint32_t t = start;
+  while (t < num_cv_ticks && values[CV_CC][t] != 127 << 5) {
+    ++t;
+  }
+  *halfway = values[CV_CC][start + kCVSmoothTicks / 2 - 1];
+  return t - start + 1;
+}
+
+uint32_t IdleDacWrites() {
+  // After the glides, stopped, once the last slew is over.
+  uint64_t next_timer1 = ~0ULL;
+  RunUntil(num_cv_ticks + kCVMaxInterpolationTicks, &next_timer1);
+  num_dac_writes = 0;
+  RunUntil(num_cv_ticks + 4900, &next_timer1);
+  return num_dac_writes;
+}
+
+double HostSeconds() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+double TickCost(bool ramping) {
+  const uint32_t kNumCalls = 10000000;
+  double start = HostSeconds();
+  for (uint32_t i = 0; i < kNumCalls; ++i) {
+    if (ramping && i % 4000 == 0) {
+      for (uint8_t n = 0; n < kCVCount; ++n) {
+        cv.Slew(n, i & 4000 ? 0 : 4095, 4000);
+      }
+    }
+    cv.Tick();
+  }
+  return (HostSeconds() - start) / kNumCalls;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: cv_slew [--check]\n");
+    return 1;
+  }
+  SPSR = _BV(SPIF);
+  int failures = 0;
+
+  GlideResult g = Glides();
+  printf("glide: %u after a legato step, %.1f to %.1fms, monotonic: %s, "
+         "max %.1f units/tick over the even steps\n", g.num_glides,
+         g.min_glide / 4.9, g.max_glide / 4.9, g.monotonic ? "yes" : "no",
+         g.max_excess);
+  printf("jump:  %u notes and the velocities, in %u tick(s) at most\n",
+         g.num_jumps, g.max_jump);
+  if (!g.num_glides || !g.monotonic || g.max_excess > 1.0 + 1e-6 ||
+      g.min_glide + 2 < kCVGlideTicks || g.max_glide > kCVGlideTicks + 2 ||
+      g.max_jump > 1) {
+    ++failures;
+  }
+  uint32_t idle = IdleDacWrites();
+  printf("idle:  %u DAC writes in 1s\n", idle);
+  if (idle) {
+    ++failures;
+  }
+
+  LfoResult l = LfoSine();
+  printf("lfo:   max %u units/tick (%.1f over the even steps), the former "
+         "steps were up to %u units\n", l.max_step, l.max_excess,
+         l.max_staircase);
+  if (l.max_excess > 1.0 + 1e-6) {
+    ++failures;
+  }
+
+  uint16_t halfway;
+  uint32_t cc_ticks = CcRamp(&halfway);
+  printf("cc:    0 to 127 in %.1fms, %u units halfway\n", cc_ticks / 4.9,
+         halfway);
+
+  printf("cost:  %.0f ns per CV::Tick() idle, %.0f ns ramping (host)\n",
+         TickCost(false) * 1e9, TickCost(true) * 1e9);
+  return check && failures ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host stand-in for avrlib/i2c/i2c.h, with a 24LC512 type EEPROM on the bus.
+//
+// The transfers run when they are started, instead of from the TWI
+// interrupt, and add their duration on the bus to I2cBus::time. The memory
+// does not acknowledge its address for I2cBus::write_cycle after a write,
+// like the real one does during its internal write cycle.
+
+#ifndef AVRLIB_I2C_I2C_H_
+#define AVRLIB_I2C_I2C_H_
+
+#include <util/twi.h>
+
+#include "avrlib/avrlib.h"
+#include "avrlib/ring_buffer.h"
+
+namespace avrlib {
+
+enum I2cState {
+  I2C_STATE_READY,
+  I2C_STATE_TRANSMITTING,
+  I2C_STATE_RECEIVING,
+};
+
+enum I2cError {
+  I2C_ERROR_NONE = 0xff,
+  I2C_ERROR_NO_ACK_FOR_ADDRESS = 0x01,
+  I2C_ERROR_NO_ACK_FOR_DATA = TW_MT_SLA_NACK,
+  I2C_ERROR_ARBITRATION_LOST = TW_MT_DATA_NACK,
+  I2C_ERROR_BUS_ERROR = 0xfe,
+  I2C_ERROR_TIMEOUT = 0x02,
+};
+
+template<uint8_t output_buffer_size = 4>
+class I2cOutput {
+ public:
+  I2cOutput() { }
+  enum {
+    buffer_size = output_buffer_size,
+    data_size = 8
+  };
+  typedef typename DataTypeForSize<data_size>::Type Value;
+};
+
+template<uint8_t input_buffer_size = 4>
+class I2cInput {
+ public:
+  I2cInput() { }
+  enum {
+    buffer_size = input_buffer_size,
+    data_size = 8
+  };
+  typedef typename DataTypeForSize<data_size>::Type Value;
+};
+
+// The bus and the memory, defined by the tool.
+struct I2cBus {
+  static const uint8_t kDeviceAddress = 0x50;
+  static const uint16_t kPageSize = 128;
+
+  static uint8_t memory[65536];
+  static uint16_t pointer;
+  static double time;  // us
+  static double byte_time;  // 9 bits
+  static double write_cycle;
+  static double busy_until;
+  static uint32_t num_write_cycles;
+
+  // Start or repeated start, address byte, stop.
+  static uint8_t Address(uint8_t address) {
+    time += byte_time + byte_time / 4;
+    if (address != kDeviceAddress) {
+      return 0;
+    }
+    return time >= busy_until;
+  }
+
+  static void Write(const uint8_t* data, uint8_t size) {
+    time += size * byte_time;
+    if (size < 2) {
+      return;
+    }
+    pointer = (data[0] << 8) | data[1];
+    if (size == 2) {
+      return;
+    }
+    // Writes wrap within a page of the memory.
+    uint16_t page = pointer & ~(kPageSize - 1);
+    for (uint8_t i = 2; i < size; ++i) {
+      memory[pointer] = data[i];
+      pointer = page | ((pointer + 1) & (kPageSize - 1));
+    }
+    busy_until = time + write_cycle;
+    ++num_write_cycles;
+  }
+
+  static uint8_t Read() {
+    time += byte_time;
+    return memory[pointer++];
+  }
+};
+
+template<uint8_t input_buffer_size = 16,
+         uint8_t output_buffer_size = 16,
+         uint32_t frequency = 100000 /* Hz */>
+class I2cMaster {
+ public:
+  I2cMaster() { }
+
+  typedef typename DataTypeForSize<I2cInput<0>::data_size>::Type Value;
+
+  static void Init() {
+    I2cBus::byte_time = 9e6 / frequency;
+    error_ = I2C_ERROR_NONE;
+  }
+
+  static void Done() { }
+
+  static uint8_t Wait() {
+    return error_;
+  }
+
+  static uint8_t Wait(uint16_t num_cycles) {
+    return error_;
+  }
+
+  static uint8_t Send(uint8_t address) {
+    if (!Output::readable()) {
+      return 0;
+    }
+    uint8_t size = Output::readable();
+    if (!I2cBus::Address(address)) {
+      error_ = TW_MT_SLA_NACK;
+      return size;
+    }
+    uint8_t data[output_buffer_size];
+    for (uint8_t i = 0; i < size; ++i) {
+      data[i] = Output::ImmediateRead();
+    }
+    I2cBus::Write(data, size);
+    error_ = I2C_ERROR_NONE;
+    return size;
+  }
+
+  static uint8_t Request(uint8_t address, uint8_t requested) {
+    if (requested >= Input::writable()) {
+      requested = Input::writable() - 1;
+    }
+    if (!I2cBus::Address(address)) {
+      error_ = TW_MR_SLA_NACK;
+      return requested;
+    }
+    for (uint8_t i = 0; i < requested; ++i) {
+      Input::Overwrite(I2cBus::Read());
+    }
+    error_ = I2C_ERROR_NONE;
+    return requested;
+  }
+
+  static inline void Write(Value v) { Output::Write(v); }
+  static inline uint8_t writable() { return Output::writable(); }
+  static inline uint8_t NonBlockingWrite(Value v) {
+    return Output::NonBlockingWrite(v);
+  }
+  static inline void Overwrite(Value v) { Output::Overwrite(v); }
+  static inline Value Read() { return Input::Read(); }
+  static inline uint8_t readable() { return Input::readable(); }
+  static inline int16_t NonBlockingRead() { return Input::NonBlockingRead(); }
+  static inline Value ImmediateRead() { return Input::ImmediateRead(); }
+
+  static inline void FlushInputBuffer() { Input::Flush(); }
+  static inline void FlushOutputBuffer() { Output::Flush(); }
+
+ public:
+  typedef RingBuffer<I2cInput<input_buffer_size> > Input;
+  typedef RingBuffer<I2cOutput<output_buffer_size> > Output;
+
+ private:
+  static uint8_t error_;
+
+  DISALLOW_COPY_AND_ASSIGN(I2cMaster);
+};
+
+/* static */
+template<uint8_t input_buffer_size, uint8_t output_buffer_size,
+         uint32_t frequency>
+uint8_t I2cMaster<input_buffer_size, output_buffer_size, frequency>::error_;
+
+}  // namespace avrlib
+
+#endif   // AVRLIB_I2C_I2C_H_
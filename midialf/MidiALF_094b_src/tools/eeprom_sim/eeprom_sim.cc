@@ -0,0 +1,376 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Correctness and bus time of the bulk slot operations.
+//
+// The real Storage and ExternalEeprom code runs over the I2C bus model of
+// tools/eeprom_sim/avrlib/i2c/i2c.h (400kHz, 64KB memory), which takes the
+// place of avrlib/i2c/i2c.h for this tool only.
+//
+//   ops      random copies, moves, inits and swaps of slot ranges on random
+//            memory contents, against a model of each operation: the first
+//            252 bytes of every slot must match, its checksum must be the
+//            one of these bytes, and the bank markers must be kept. The
+//            playing sequences must not change, and a cancelled operation
+//            must stop on the slot it was cancelled on.
+//   timing   bus time of each 64-slot operation, with a 5ms (the maximum)
+//            and a 3ms memory write cycle, and that of the former path,
+//            Seq::LoadFromStorage() and Seq::SaveToStorage() for each slot.
+//            The CPU time of the checksums is not counted.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile eeprom_sim
+//   build/tools/eeprom_sim            prints the results
+//   build/tools/eeprom_sim --check    exits with an error if an operation
+//                                     gives wrong contents, if an operation
+//                                     with nothing to change writes a page,
+//                                     or if a 64-slot copy does not take
+//                                     less bus time than the former path
+
+#include "midialf/clock.h"
+#include "midialf/cv/cv.h"
+#include "midialf/cv/port.h"
+#include "midialf/seq.h"
+#include "midialf/storage.h"
+#include "midialf/sysex_handler.h"
+#include "midialf/ui.h"
+
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace avrlib {
+
+uint8_t I2cBus::memory[65536];
+uint16_t I2cBus::pointer;
+double I2cBus::time;
+double I2cBus::byte_time;
+double I2cBus::write_cycle = 5000.0;
+double I2cBus::busy_until;
+uint32_t I2cBus::num_write_cycles;
+
+}  // namespace avrlib
+
+namespace midialf {
+
+// Stubs for the parts of the firmware the sequencer calls into.
+
+volatile uint8_t SysExHandler::block_open_;
+volatile uint8_t SysExHandler::block_aborted_;
+
+int16_t Ui::Scale(int16_t, int16_t, int16_t, int16_t, int16_t x1max) {
+  return x1max;
+}
+
+uint8_t CV::glide_;
+
+void CV::SendMode(uint8_t, uint8_t) { }
+void CV::SendNote(uint8_t) { }
+void CV::SendPBnd(uint16_t) { }
+
+void Port::SetState(uint8_t, uint8_t) { }
+void Port::SetPulse(uint8_t) { }
+void Port::UpdateCvOffset() { }
+void Port::UpdateGateInvert() { }
+void Port::UpdateStrobeWidth() { }
+
+}  // namespace midialf
+
+using namespace avrlib;
+using namespace midialf;
+
+namespace {
+
+const uint16_t kNumSlots = 256;
+const uint16_t kNumOpRuns = 400;
+const uint8_t kNumTimedSlots = 64;
+
+uint8_t* const memory = I2cBus::memory;
+uint8_t reference[65536];
+
+enum Op {
+  OP_COPY,
+  OP_MOVE,
+  OP_INIT,
+  OP_SWAP,
+};
+
+const char* const kOpNames[] = { "copy", "move", "init", "swap" };
+
+uint16_t SlotCrc(const uint8_t* slot) {
+  uint16_t crc16 = 0xffff;
+  for (uint16_t i = 0; i < kSlotCrcSize; ++i) {
+    crc16 = _crc16_update(crc16, slot[i]);
+  }
+  return crc16;
+}
+
+// Random contents, with a valid index.
+void Fill(uint32_t seed) {
+  srand(seed);
+  for (uint32_t i = 0; i < sizeof(reference); ++i) {
+    memory[i] = rand();
+  }
+  for (uint16_t slot = 0; slot < kNumSlots; ++slot) {
+    uint8_t* p = &memory[slot * kSlotSize];
+    uint16_t crc16 = SlotCrc(p);
+    memcpy(p + kSlotCrcOffset, &crc16, 2);
+  }
+  memcpy(reference, memory, sizeof(reference));
+}
+
+void InitSlot(uint8_t* slots, uint8_t slot) {
+  SeqInfo info(slot);
+  SeqData data;
+  uint8_t* p = &slots[slot * kSlotSize];
+  memcpy(p, &info, sizeof(info));
+  for (uint8_t n = 0; n < 4; ++n) {
+    memcpy(p + kSeqDataOffset + n * sizeof(data), &data, sizeof(data));
+  }
+}
+
+// The model: slot contents up to the checksum.
+void CopySlots(uint8_t from, uint8_t to, uint16_t count) {
+  static uint8_t source[65536];
+  memcpy(source, reference, sizeof(source));
+  for (uint16_t n = 0; n < count; ++n) {
+    memcpy(&reference[(to + n) * kSlotSize],
+           &source[(from + n) * kSlotSize], kSlotCrcSize);
+  }
+}
+
+void Apply(uint8_t op, uint8_t from, uint8_t to, uint16_t count) {
+  switch (op) {
+    case OP_COPY:
+      CopySlots(from, to, count);
+      break;
+    case OP_MOVE:
+      CopySlots(from, to, count);
+      for (uint16_t slot = from; from != to && slot < from + count; ++slot) {
+        if (slot < to || slot >= to + count) {
+          InitSlot(reference, slot);
+        }
+      }
+      break;
+    case OP_INIT:
+      for (uint16_t n = 0; n < count; ++n) {
+        InitSlot(reference, from + n);
+      }
+      break;
+    case OP_SWAP:
+      for (uint16_t n = 0; n < count; ++n) {
+        for (uint16_t i = 0; i < kSlotCrcSize; ++i) {
+          uint8_t a = reference[(from + n) * kSlotSize + i];
+          reference[(from + n) * kSlotSize + i] =
+              reference[(to + n) * kSlotSize + i];
+          reference[(to + n) * kSlotSize + i] = a;
+        }
+      }
+      break;
+  }
+}
+
+uint16_t Run(uint8_t op, uint8_t from, uint8_t to, uint16_t count,
+             ProgressCallback callback = NULL) {
+  switch (op) {
+    case OP_COPY:
+      return storage.CopySlots(from, to, count, callback);
+    case OP_MOVE:
+      return storage.MoveSlots(from, to, count, callback);
+    case OP_INIT:
+      return storage.InitSlots(from, count, callback);
+    default:
+      return storage.SwapSlots(from, to, count, callback);
+  }
+}
+
+// Returns the first slot which doesn't match the model, or kNumSlots.
+uint16_t Verify() {
+  for (uint16_t slot = 0; slot < kNumSlots; ++slot) {
+    const uint8_t* p = &memory[slot * kSlotSize];
+    const uint8_t* q = &reference[slot * kSlotSize];
+    uint16_t crc16;
+    memcpy(&crc16, p + kSlotCrcOffset, 2);
+    if (memcmp(p, q, kSlotCrcSize) || crc16 != SlotCrc(p) ||
+        memcmp(p + kSlotCrcOffset + 2, q + kSlotCrcOffset + 2, 2)) {
+      return slot;
+    }
+  }
+  return kNumSlots;
+}
+
+uint8_t num_callbacks;
+uint8_t cancel_after;
+
+uint8_t Cancel(uint16_t, uint16_t) {
+  return num_callbacks++ < cancel_after;
+}
+
+void TakeSnapshot(SeqData* data) {
+  for (uint8_t s = 0; s < 4; ++s) {
+    seq.CopySeqData(s, data[s]);
+  }
+}
+
+void StartTiming(double write_cycle) {
+  I2cBus::write_cycle = write_cycle;
+  I2cBus::time = 0.0;
+  I2cBus::busy_until = 0.0;
+  I2cBus::num_write_cycles = 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: eeprom_sim [--check]\n");
+    return 1;
+  }
+  int failures = 0;
+
+  storage.Init();
+  seq.InitSeqInfo();
+  for (uint8_t s = 0; s < 4; ++s) {
+    seq.InitSeq(s);
+    seq.set_note(s, 0, 30 + s);
+  }
+  seq.Init();
+  SeqData before[4];
+  TakeSnapshot(before);
+  printf("%u slots\n", storage.num_slots());
+  if (storage.num_slots() != kNumSlots) {
+    return 1;
+  }
+
+  // Random operations against the model.
+  uint32_t num_runs[4] = { 0 };
+  uint32_t num_refused = 0;
+  uint32_t num_failures = 0;
+  for (uint16_t run = 0; run < kNumOpRuns; ++run) {
+    Fill(run + 1);
+    uint8_t op = rand() % 4;
+    uint8_t from = rand() % kNumSlots;
+    uint8_t to = op == OP_INIT ? from : rand() % kNumSlots;
+    uint16_t count = 1 + rand() % 40;
+    uint16_t last = from > to ? from : to;
+    if (last + count > kNumSlots) {
+      count = kNumSlots - last;
+    }
+    bool overlap = from < to + count && to < from + count;
+    uint16_t done = Run(op, from, to, count);
+    if (op == OP_SWAP && overlap) {
+      ++num_refused;
+      if (done) {
+        printf("%s %u-%u x%u: overlapping swap done\n", kOpNames[op],
+               from, to, count);
+        ++num_failures;
+      }
+    } else {
+      Apply(op, from, to, count);
+      ++num_runs[op];
+    }
+    uint16_t slot = Verify();
+    if (slot != kNumSlots) {
+      printf("%s %u-%u x%u: slot %u differs\n", kOpNames[op], from, to, count,
+             slot);
+      ++num_failures;
+    }
+  }
+
+  // Cancelled copy, which runs backwards to a higher slot.
+  Fill(1000);
+  num_callbacks = 0;
+  cancel_after = 5;
+  uint16_t done = storage.CopySlots(0, 100, 20, &Cancel);
+  CopySlots(20 - cancel_after, 120 - cancel_after, cancel_after);
+  if (done != cancel_after || Verify() != kNumSlots) {
+    printf("cancelled copy: %u slots done\n", done);
+    ++num_failures;
+  }
+
+  SeqData after[4];
+  TakeSnapshot(after);
+  bool untouched = !memcmp(before, after, sizeof(before));
+  printf("ops: %u copies, %u moves, %u inits, %u swaps (%u overlapping, "
+         "refused), %u failures, sequences %s\n", num_runs[OP_COPY],
+         num_runs[OP_MOVE], num_runs[OP_INIT], num_runs[OP_SWAP], num_refused,
+         num_failures, untouched ? "untouched" : "changed");
+  if (num_failures || !untouched) {
+    ++failures;
+  }
+
+  // Bus time of each 64-slot operation.
+  struct Timing {
+    const char* name;
+    uint8_t op;
+    bool prepared;  // The target already holds the result
+  };
+  static const Timing kTimings[] = {
+    { "copy", OP_COPY, false },
+    { "copy, same contents", OP_COPY, true },
+    { "move", OP_MOVE, false },
+    { "init", OP_INIT, false },
+    { "init, already done", OP_INIT, true },
+    { "swap", OP_SWAP, false },
+  };
+  static const double kWriteCycles[] = { 5000.0, 3000.0 };
+  printf("64 slots, bus time in s (page writes) for a write cycle of:\n");
+  printf("  %-22s %16s %16s\n", "", "5ms", "3ms");
+  double copy_time[2] = { 0.0, 0.0 };
+  for (uint8_t i = 0; i < sizeof(kTimings) / sizeof(kTimings[0]); ++i) {
+    const Timing& t = kTimings[i];
+    printf("  %-22s", t.name);
+    for (uint8_t w = 0; w < 2; ++w) {
+      Fill(2000);
+      if (t.prepared) {
+        Run(t.op, 0, 100, kNumTimedSlots);
+      }
+      StartTiming(kWriteCycles[w]);
+      Run(t.op, 0, 100, kNumTimedSlots);
+      printf(" %7.2f (%5u)", I2cBus::time * 1e-6, I2cBus::num_write_cycles);
+      if (t.prepared && I2cBus::num_write_cycles) {
+        ++failures;
+      }
+      if (i == 0) {
+        copy_time[w] = I2cBus::time;
+      }
+    }
+    printf("\n");
+  }
+
+  printf("  %-22s", "former copy");
+  for (uint8_t w = 0; w < 2; ++w) {
+    Fill(2000);
+    StartTiming(kWriteCycles[w]);
+    for (uint8_t n = 0; n < kNumTimedSlots; ++n) {
+      seq.LoadFromStorage(n);
+      seq.SaveToStorage(100 + n);
+    }
+    printf(" %7.2f (%5u)", I2cBus::time * 1e-6, I2cBus::num_write_cycles);
+    if (copy_time[w] >= I2cBus::time) {
+      ++failures;
+    }
+  }
+  printf("\n");
+  return check && failures ? 1 : 0;
+}
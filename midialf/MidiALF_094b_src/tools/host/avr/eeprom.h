@@ -0,0 +1,71 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host stand-in for <avr/eeprom.h>. EEMEM variables are ordinary variables,
+// so the EEPROM contents live in the host memory for the process lifetime.
+// Addresses given as numbers, below HOST_EEPROM_SIZE, are mapped to
+// host_eeprom.
+
+#ifndef TOOLS_HOST_AVR_EEPROM_H_
+#define TOOLS_HOST_AVR_EEPROM_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define EEMEM
+
+#define HOST_EEPROM_SIZE 2048
+
+extern uint8_t host_eeprom[HOST_EEPROM_SIZE];
+
+inline void* HostEepromAddress(const void* address) {
+  uintptr_t offset = reinterpret_cast<uintptr_t>(address);
+  return offset < HOST_EEPROM_SIZE ?
+      &host_eeprom[offset] : const_cast<void*>(address);
+}
+
+inline uint8_t eeprom_read_byte(const uint8_t* address) {
+  return *static_cast<uint8_t*>(HostEepromAddress(address));
+}
+
+inline uint16_t eeprom_read_word(const uint16_t* address) {
+  uint16_t value;
+  memcpy(&value, HostEepromAddress(address), sizeof(value));
+  return value;
+}
+
+inline void eeprom_read_block(void* data, const void* address, size_t size) {
+  memcpy(data, HostEepromAddress(address), size);
+}
+
+inline void eeprom_write_byte(uint8_t* address, uint8_t value) {
+  *static_cast<uint8_t*>(HostEepromAddress(address)) = value;
+}
+
+inline void eeprom_write_word(uint16_t* address, uint16_t value) {
+  memcpy(HostEepromAddress(address), &value, sizeof(value));
+}
+
+inline void eeprom_write_block(const void* data, void* address, size_t size) {
+  memcpy(HostEepromAddress(address), data, size);
+}
+
+#define eeprom_update_byte eeprom_write_byte
+#define eeprom_update_word eeprom_write_word
+#define eeprom_update_block eeprom_write_block
+
+#endif  // TOOLS_HOST_AVR_EEPROM_H_
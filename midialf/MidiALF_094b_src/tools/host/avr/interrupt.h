@@ -0,0 +1,33 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host stand-in for <avr/interrupt.h>. Interrupt handlers are plain
+// functions, called by the simulation when the interrupt would fire.
+
+#ifndef TOOLS_HOST_AVR_INTERRUPT_H_
+#define TOOLS_HOST_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+#define cli() do { } while (0)
+#define sei() do { } while (0)
+
+#define ISR_BLOCK
+#define ISR_NOBLOCK
+#define ISR(vector, ...) extern "C" void vector(void)
+
+#endif  // TOOLS_HOST_AVR_INTERRUPT_H_
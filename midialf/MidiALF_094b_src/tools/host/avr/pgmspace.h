@@ -0,0 +1,68 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host stand-in for <avr/pgmspace.h>. Program memory is ordinary memory.
+// Tables of pointers are read with pgm_read_word() on the AVR, where
+// pointers are 16 bits wide; here the read returns the whole pointer.
+
+#ifndef TOOLS_HOST_AVR_PGMSPACE_H_
+#define TOOLS_HOST_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (__extension__({ static char __c[] = (s); &__c[0]; }))
+
+typedef char prog_char;
+typedef int8_t prog_int8_t;
+typedef uint8_t prog_uint8_t;
+typedef int16_t prog_int16_t;
+typedef uint16_t prog_uint16_t;
+typedef int32_t prog_int32_t;
+typedef uint32_t prog_uint32_t;
+
+template<typename T>
+inline T* HostReadProgramWord(T* const* address) {
+  return *address;
+}
+
+inline uint16_t HostReadProgramWord(const void* address) {
+  uint16_t value;
+  memcpy(&value, address, sizeof(value));
+  return value;
+}
+
+inline uint32_t HostReadProgramDword(const void* address) {
+  uint32_t value;
+  memcpy(&value, address, sizeof(value));
+  return value;
+}
+
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_word(address) HostReadProgramWord(address)
+#define pgm_read_dword(address) HostReadProgramDword(address)
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strchr_P strchr
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+
+#endif  // TOOLS_HOST_AVR_PGMSPACE_H_
@@ -0,0 +1,68 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Support code for running the firmware sources on the host.
+
+#include "tools/host/host.h"
+
+#include <avr/eeprom.h>
+#include <string.h>
+
+volatile uint8_t host_registers[HOST_NUM_REGISTERS];
+volatile uint16_t host_registers16[HOST_NUM_REGISTERS16];
+
+uint8_t host_eeprom[HOST_EEPROM_SIZE];
+
+namespace {
+
+const uint16_t kUartLogSize = 1024;
+
+struct UartLog {
+  uint8_t data[kUartLogSize + 1];
+  uint16_t size;
+};
+
+UartLog uart_log[2];
+
+// The UARTs are always ready to send, the EEPROM is erased.
+struct Init {
+  Init() {
+    UCSR0A = _BV(UDRE0);
+    UCSR1A = _BV(UDRE1);
+    memset(host_eeprom, 0xff, sizeof(host_eeprom));
+  }
+} init;
+
+}  // namespace
+
+volatile uint8_t* HostUartData(uint8_t port) {
+  UartLog* log = &uart_log[port];
+  // Overflowing bytes all go to the last, extra, location
+  return &log->data[log->size < kUartLogSize ? log->size++ : kUartLogSize];
+}
+
+uint16_t HostUartRead(uint8_t port, uint8_t* data, uint16_t max_size) {
+  UartLog* log = &uart_log[port];
+  uint16_t size = log->size < max_size ? log->size : max_size;
+  memcpy(data, log->data, size);
+  log->size = 0;
+  return size;
+}
+
+uint16_t HostUartSize(uint8_t port) {
+  return uart_log[port].size;
+}
@@ -0,0 +1,34 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Support code for running the firmware sources on the host. The tools
+// under tools/ are built with tools/host first on the include path, so that
+// the avr-libc headers resolve to the stand-ins in this directory.
+
+#ifndef TOOLS_HOST_HOST_H_
+#define TOOLS_HOST_HOST_H_
+
+#include <avr/io.h>
+
+// Moves the bytes written to the UART since the last call to data, and
+// returns their number. At most max_size bytes are kept between calls.
+uint16_t HostUartRead(uint8_t port, uint8_t* data, uint16_t max_size);
+
+// Number of bytes written to the UART since the last HostUartRead().
+uint16_t HostUartSize(uint8_t port);
+
+#endif  // TOOLS_HOST_HOST_H_
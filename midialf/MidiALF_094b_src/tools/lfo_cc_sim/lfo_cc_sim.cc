@@ -0,0 +1,476 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// MIDI line load of the LFO CC output, with and without the output shaping
+// (deadband, byte budget and yielding to notes, see Lfo::SendCC()).
+//
+// The real seq, clock, event scheduler and LFO code runs on a virtual Timer1
+// and the output buffer is drained by a virtual Timer2, as in midialf.cc, into
+// a 31250 baud line: a byte takes 320us and the UART takes the next one when
+// the previous one starts shifting out. Bytes the sequencer writes directly
+// to the UART when the output buffer is full go on the line at once.
+//
+// For each configuration, the line use, the LFO share of it and the note on
+// latency (from Seq::Send3() to the end of the message on the line) are
+// given, as well as the latency added to the same notes without LFO. The
+// output without shaping is the one of the firmware before it: a 7-bit CC on
+// every LFO update, which this tool sends itself.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile lfo_cc_sim
+//   build/tools/lfo_cc_sim            prints the tables
+//   build/tools/lfo_cc_sim --check    exits with an error if the shaped output
+//                                     exceeds the byte budget, overflows the
+//                                     output buffer or adds more note latency
+//                                     than the unshaped output
+
+#include "midialf/clock.h"
+#include "midialf/cv/cv.h"
+#include "midialf/cv/port.h"
+#include "midialf/event_scheduler.h"
+#include "midialf/lfo.h"
+#include "midialf/midi_handler.h"
+#include "midialf/note_duration.h"
+#include "midialf/seq.h"
+#include "midialf/storage.h"
+#include "midialf/sysex_handler.h"
+#include "midialf/ui.h"
+
+#include "avrlib/random.h"
+#include "avrlib/time.h"
+
+#include "tools/host/host.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <deque>
+
+namespace {
+
+const uint8_t kLfoCcNumbers[] = { 16, 17 };
+bool unshaped;
+
+}  // namespace
+
+namespace midialf {
+
+// Stubs for the parts of the firmware the sequencer calls into.
+
+volatile uint8_t SysExHandler::block_open_;
+volatile uint8_t SysExHandler::block_aborted_;
+
+uint8_t Storage::ReadSeqData(uint8_t, SeqData*, uint8_t) { return 0; }
+uint8_t Storage::ReadSeqInfo(uint8_t, SeqInfo*) { return 0; }
+uint8_t Storage::WriteSeqData(uint8_t, const SeqData*, uint8_t) { return 0; }
+uint8_t Storage::WriteSeqInfo(uint8_t, const SeqInfo*) { return 0; }
+
+int16_t Ui::Scale(int16_t, int16_t, int16_t, int16_t, int16_t x1max) {
+  return x1max;
+}
+
+uint8_t CV::glide_;
+
+// Lfo::Tick() sets the LFO CVs on every update, with the 7-bit value the
+// firmware without shaping sent as a CC just before.
+void CV::SendMode(uint8_t mode, uint8_t value) {
+  if (unshaped && (mode == CVMODE_LFO1 || mode == CVMODE_LFO2)) {
+    seq.Send3(0xb0 | seq.channel(), kLfoCcNumbers[mode - CVMODE_LFO1],
+              value & 0x7f);
+  }
+}
+
+void CV::SendNote(uint8_t) { }
+void CV::SendPBnd(uint16_t) { }
+
+void Port::SetState(uint8_t, uint8_t) { }
+void Port::SetPulse(uint8_t) { }
+void Port::UpdateCvOffset() { }
+void Port::UpdateGateInvert() { }
+void Port::UpdateStrobeWidth() { }
+
+}  // namespace midialf
+
+using namespace avrlib;
+using namespace midialf;
+
+namespace {
+
+// Time is counted in CPU cycles.
+const uint32_t kCyclesPerTimer1Count = 64;
+const uint32_t kCyclesPerTimer2Interrupt = 4080;  // 4.9KHz
+const uint32_t kCyclesPerMidiByte = F_CPU / 3125;  // 10 bits at 31250 baud
+const uint32_t kCyclesPerMs = F_CPU / 1000;
+
+const uint8_t kNumSeqs = 4;
+const uint8_t kNumBeats = 64;
+
+uint64_t now;
+uint64_t line_free;  // End of the byte shifting out
+std::deque<uint64_t> queued_times;  // Of the bytes in the output buffer
+
+// Line statistics.
+uint32_t line_bytes;
+uint32_t lfo_bytes;
+uint32_t flushed_bytes;
+uint32_t num_notes;
+uint64_t total_latency;
+uint64_t max_latency;
+std::deque<uint64_t> latencies;
+
+// Line decoder.
+uint8_t running_status;
+uint8_t message[3];
+uint8_t message_size;
+uint64_t message_time;
+
+uint8_t MessageSize(uint8_t status) {
+  if (status >= 0xf0) {
+    return status == 0xf2 ? 3 : (status == 0xf1 || status == 0xf3 ? 2 : 1);
+  }
+  return (status & 0xe0) == 0xc0 ? 2 : 3;
+}
+
+bool IsLfoCc(uint8_t cc) {
+  for (uint8_t i = 0; i < kNumLfos; ++i) {
+    if (cc == kLfoCcNumbers[i] || cc == kLfoCcNumbers[i] + 32) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Puts a byte queued at the given time on the line.
+void SendByte(uint8_t byte, uint64_t queued_time) {
+  uint64_t start = line_free > now ? line_free : now;
+  line_free = start + kCyclesPerMidiByte;
+  ++line_bytes;
+  if (byte >= 0xf8) {
+    return;
+  }
+  if (byte & 0x80) {
+    running_status = byte;
+    message_size = 0;
+  } else if (!running_status) {
+    return;
+  }
+  if (!message_size) {
+    message[message_size++] = running_status;
+    message_time = queued_time;
+    if (byte & 0x80) {
+      return;
+    }
+  }
+  message[message_size++] = byte;
+  if (message_size == MessageSize(running_status)) {
+    if ((message[0] & 0xf0) == 0x90 && message[2]) {
+      uint64_t latency = line_free - message_time;
+      ++num_notes;
+      total_latency += latency;
+      if (latency > max_latency) {
+        max_latency = latency;
+      }
+      latencies.push_back(latency);
+    } else if ((message[0] & 0xf0) == 0xb0 && IsLfoCc(message[1])) {
+      lfo_bytes += message_size;
+    }
+    message_size = 0;
+    if (running_status >= 0xf0) {
+      running_status = 0;
+    }
+  }
+}
+
+// Runs firmware code, timestamps what it queued in the output buffer and
+// sends what it wrote directly to the UART: the realtime messages of
+// Seq::SendNow(), and the bytes Seq::FlushOutputBuffer() takes from the front
+// of the buffer.
+template<typename F>
+void RunFirmware(F f) {
+  uint16_t size = MidiHandler::OutputBuffer::readable();
+  f();
+  uint8_t data[256];
+  uint16_t num_written;
+  while ((num_written = HostUartRead(0, data, sizeof(data))) != 0) {
+    for (uint16_t i = 0; i < num_written; ++i) {
+      if (data[i] >= 0xf8) {
+        SendByte(data[i], now);
+        continue;
+      }
+      SendByte(data[i], queued_times.front());
+      queued_times.pop_front();
+      --size;
+      ++flushed_bytes;
+    }
+  }
+  for (uint16_t i = MidiHandler::OutputBuffer::readable(); i > size; --i) {
+    queued_times.push_back(now);
+  }
+}
+
+// See ISR(TIMER1_COMPA_vect) in midialf.cc. Returns the number of timer
+// counts to the next one.
+uint16_t interval;
+
+void Timer1Interrupt() {
+  timer0_milliseconds.value = now / kCyclesPerMs;
+  interval = midialf::clock.Tick() + 1;
+  if (midialf::clock.running()) {
+    seq.OnInternalClockTick();
+    if (midialf::clock.stepped()) {
+      seq.OnInternalClockStep();
+    }
+  }
+}
+
+// See SendMidiOut() in midialf.cc. The UART is writable once the previous
+// byte is in the shift register.
+void Timer2Interrupt() {
+  if (line_free > now + kCyclesPerMidiByte ||
+      !MidiHandler::OutputBuffer::readable()) {
+    return;
+  }
+  uint64_t queued_time = queued_times.front();
+  queued_times.pop_front();
+  SendByte(MidiHandler::OutputBuffer::ImmediateRead(), queued_time);
+}
+
+void Start() { seq.Start(); }
+void Stop() { seq.Stop(); }
+
+void Run(uint64_t num_cycles) {
+  uint64_t end = now + num_cycles;
+  uint64_t next_timer1 = now;
+  uint64_t next_timer2 = now;
+  while (now < end) {
+    if (next_timer1 <= next_timer2) {
+      now = next_timer1;
+      RunFirmware(&Timer1Interrupt);
+      next_timer1 += interval * kCyclesPerTimer1Count;
+    } else {
+      now = next_timer2;
+      Timer2Interrupt();
+      next_timer2 += kCyclesPerTimer2Interrupt;
+    }
+  }
+}
+
+// LFO output configurations.
+
+enum Shaping {
+  NO_LFO,
+  UNSHAPED,
+  SHAPED
+};
+
+struct Config {
+  const char* name;
+  Shaping shaping;
+  uint8_t output;  // Deadband, or kLfoOutputHiRes
+};
+
+const Config kConfigs[] = {
+  { "no LFO", NO_LFO, 0 },
+  { "unshaped", UNSHAPED, 0 },
+  { "shaped, 7-bit", SHAPED, 0 },
+  { "shaped, deadband 2", SHAPED, 2 },
+  { "shaped, 14-bit", SHAPED, kLfoOutputHiRes },
+};
+
+const uint8_t kNumConfigs = sizeof(kConfigs) / sizeof(kConfigs[0]);
+
+// Sequencer loads.
+
+struct Load {
+  const char* name;
+  uint8_t bpm;
+  bool tracks;
+};
+
+const Load kLoads[] = {
+  { "1 sequence, 120 BPM", 120, false },
+  { "4 tracks with step CCs, 120 BPM", 120, true },
+  { "4 tracks with step CCs, 240 BPM", 240, true },
+};
+
+const uint8_t kNumLoads = sizeof(kLoads) / sizeof(kLoads[0]);
+
+struct Result {
+  double line_bytes_per_second;
+  double lfo_bytes_per_second;
+  double lfo_bytes_per_beat;  // Per LFO
+  double mean_latency;  // ms
+  double max_latency;
+  double mean_added_latency;
+  double max_added_latency;
+  uint32_t flushed_bytes;
+};
+
+void Reset(const Load& load, const Config& config) {
+  now = 0;
+  line_free = 0;
+  queued_times.clear();
+  line_bytes = lfo_bytes = flushed_bytes = 0;
+  num_notes = 0;
+  total_latency = max_latency = 0;
+  latencies.clear();
+  running_status = 0;
+  message_size = 0;
+  timer0_milliseconds.value = 0;
+  Random::Seed(1);
+
+  event_scheduler.Init();
+  seq.set_slot(0);
+  seq.InitSeqInfo();
+  for (uint8_t s = 0; s < kNumSeqs; ++s) {
+    seq.InitSeq(s);
+    for (uint8_t step = 0; step < kNumSteps; ++step) {
+      seq.set_note(s, step, 48 + s * 12 + step);
+      seq.set_velo(s, step, 64 + step * 8);
+    }
+  }
+  seq.Init();
+  seq.set_bpm(load.bpm);
+  seq.set_clock_rate(k16thNote);
+  if (load.tracks) {
+    seq.set_link_mode(LINK_MODE_TRACKS);
+    for (uint8_t track = 0; track < kNumSeqs; ++track) {
+      seq.set_track_channel(track, track);
+      seq.set_cc1send_mask(track, 0xff);
+      seq.set_cc2send_mask(track, 0xff);
+    }
+  }
+
+  // A fast LFO, one cycle per beat, and a slow one, one cycle per 6 beats,
+  // both updated on every MIDI clock tick.
+  unshaped = config.shaping == UNSHAPED;
+  lfo.set_resolution(0);
+  for (uint8_t i = 0; i < kNumLfos; ++i) {
+    lfo.set_waveform(i, config.shaping == NO_LFO ? 0 : 1);
+    lfo.set_cc_number(i, config.shaping == SHAPED ? kLfoCcNumbers[i] : 0);
+    lfo.set_amount(i, 126);
+    lfo.set_center(i, 63);
+    lfo.set_sync(i, LFO_SYNC_START);
+    lfo.set_output(i, config.output);
+  }
+  lfo.set_rate(0, 10);
+  lfo.set_rate(1, 3);
+
+  // Start from an idle line.
+  uint8_t data[256];
+  while (HostUartRead(0, data, sizeof(data))) { }
+  MidiHandler::OutputBuffer::Flush();
+}
+
+Result Play(const Load& load, const Config& config) {
+  Reset(load, config);
+  RunFirmware(&Start);
+  uint64_t num_cycles = static_cast<uint64_t>(F_CPU) * 60 * kNumBeats /
+      load.bpm;
+  Run(num_cycles);
+  RunFirmware(&Stop);
+
+  Result result;
+  double seconds = static_cast<double>(num_cycles) / F_CPU;
+  result.line_bytes_per_second = line_bytes / seconds;
+  result.lfo_bytes_per_second = lfo_bytes / seconds;
+  result.lfo_bytes_per_beat = static_cast<double>(lfo_bytes) / kNumBeats /
+      kNumLfos;
+  result.mean_latency = num_notes ?
+      static_cast<double>(total_latency) / num_notes / kCyclesPerMs : 0.0;
+  result.max_latency = static_cast<double>(max_latency) / kCyclesPerMs;
+  result.mean_added_latency = 0.0;
+  result.max_added_latency = 0.0;
+  result.flushed_bytes = flushed_bytes;
+  return result;
+}
+
+int Simulate(bool check) {
+  int failures = 0;
+  for (uint8_t l = 0; l < kNumLoads; ++l) {
+    const Load& load = kLoads[l];
+    printf("%s\n", load.name);
+    printf("  %-20s %9s %9s %7s %9s %9s %9s %9s %7s\n",
+           "", "line B/s", "LFO B/s", "B/beat", "note ms", "max ms",
+           "added ms", "max ms", "flushed");
+    std::deque<uint64_t> reference;
+    Result unshaped_result = Result();
+    for (uint8_t c = 0; c < kNumConfigs; ++c) {
+      const Config& config = kConfigs[c];
+      Result r = Play(load, config);
+      if (config.shaping == NO_LFO) {
+        reference = latencies;
+      } else if (latencies.size() == reference.size()) {
+        // The same notes are played, in the same order.
+        double total = 0.0;
+        for (size_t i = 0; i < latencies.size(); ++i) {
+          double added = (static_cast<double>(latencies[i]) - reference[i]) /
+              kCyclesPerMs;
+          total += added;
+          if (added > r.max_added_latency) {
+            r.max_added_latency = added;
+          }
+        }
+        r.mean_added_latency = latencies.size() ? total / latencies.size() : 0;
+      } else {
+        printf("  %s: %u notes, %u without LFO\n", config.name,
+               static_cast<uint32_t>(latencies.size()),
+               static_cast<uint32_t>(reference.size()));
+        ++failures;
+      }
+      printf("  %-20s %9.0f %9.0f %7.1f %9.2f %9.2f %9.2f %9.2f %7u\n",
+             config.name, r.line_bytes_per_second, r.lfo_bytes_per_second,
+             r.lfo_bytes_per_beat, r.mean_latency, r.max_latency,
+             r.mean_added_latency, r.max_added_latency, r.flushed_bytes);
+      if (config.shaping == UNSHAPED) {
+        unshaped_result = r;
+      } else if (config.shaping == SHAPED) {
+        // The budget, plus what is left of the initial one.
+        double max_bytes_per_beat = kLfoBudgetPerTick * 24 +
+            static_cast<double>(kLfoBudgetMax) / kNumBeats;
+        if (r.lfo_bytes_per_beat > max_bytes_per_beat) {
+          printf("  %s: over the byte budget\n", config.name);
+          ++failures;
+        }
+        if (r.flushed_bytes) {
+          printf("  %s: the output buffer overflowed\n", config.name);
+          ++failures;
+        }
+        if (config.output != kLfoOutputHiRes &&
+            (r.mean_added_latency > unshaped_result.mean_added_latency ||
+             r.max_added_latency > unshaped_result.max_added_latency)) {
+          printf("  %s: more note latency than unshaped\n", config.name);
+          ++failures;
+        }
+      }
+    }
+  }
+  return check && failures ? 1 : 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: lfo_cc_sim [--check]\n");
+    return 1;
+  }
+  return Simulate(check);
+}
@@ -0,0 +1,295 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Jitter and lock time of the external clock PLL.
+//
+// The real Clock follows a MIDI clock stream on a virtual Timer1, run count by
+// count: when TCNT1 reaches OCR1A, the counter is cleared and the compare ISR
+// loads the next Tick(), which is a sequencer tick unless the clock is held.
+// The incoming clocks have Gaussian jitter, or uniform jitter rounded up to
+// 1ms USB frames, as sent by a DAW. The clocks start 1s before the Start
+// message, or with it (cold start), and some streams change tempo or drop
+// clocks while playing.
+//
+// The n-th sequencer tick is due at the ideal time of the n-th clock received
+// after the Start message. The error of the ticks is measured once the PLL has
+// settled. The former firmware ticked the sequencer on each received clock,
+// its error is that of the input. The lock time is the time taken, from the
+// Start message or from the end of a tempo change or dropout, for the error to
+// stay within max(1ms, 4x its settled rms).
+//
+// Build and run, from the source root:
+//   make -f tools/makefile pll_sim
+//   build/tools/pll_sim            prints the table
+//   build/tools/pll_sim --check    exits with an error if the settled error of
+//                                  a jittery stream is not below half of the
+//                                  input's, if a lock takes more than 3
+//                                  beats (5 after a tempo change), or if the
+//                                  count of ticks is more than one away from
+//                                  the count of clocks received
+
+#include "midialf/clock.h"
+
+#include <avr/io.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace midialf;
+
+namespace {
+
+const double kTimerCountsPerSecond = F_CPU / 64.0;
+const double kStartTime = 2.0;  // s
+const double kDuration = 60.0;
+const double kSettleTime = 10.0;  // Before the error is measured.
+const uint32_t kMaxClocks = 8192;
+const uint8_t kNumDroppedClocks = 3;
+const double kMaxLock = 3.0;  // beats
+const double kMaxRelock = 5.0;  // After a tempo change
+
+struct Stream {
+  const char* name;
+  double bpm;
+  double new_bpm;
+  double change_time;  // s, 0 for none
+  double change_duration;  // 0 for a step
+  double jitter;  // ms, rms for Gaussian, peak for USB
+  bool usb;
+  bool cold_start;
+  bool dropout;  // At change_time
+};
+
+const Stream kStreams[] = {
+  { "120 clean", 120, 120, 0, 0, 0.0, false, false, false },
+  { "120 gauss 0.5ms", 120, 120, 0, 0, 0.5, false, false, false },
+  { "120 usb 1ms", 120, 120, 0, 0, 1.0, true, false, false },
+  { "174.3 usb 1ms", 174.3, 174.3, 0, 0, 1.0, true, false, false },
+  { "60 gauss 2ms", 60, 60, 0, 0, 2.0, false, false, false },
+  { "250 usb 1ms", 250, 250, 0, 0, 1.0, true, false, false },
+  { "30 usb 1ms", 30, 30, 0, 0, 1.0, true, false, false },
+  { "90-140 step", 90, 140, 20, 0, 0.5, false, false, false },
+  { "100-160 ramp 8s", 100, 160, 20, 8, 0.5, true, false, false },
+  { "120 dropout", 120, 120, 20, 0, 0.5, false, false, true },
+  { "cold 120 usb 1ms", 120, 120, 0, 0, 1.0, true, true, false },
+  { "cold 140 gauss 0.5ms", 140, 140, 0, 0, 0.5, false, true, false },
+  { "cold 60 usb 1ms", 60, 60, 0, 0, 1.0, true, true, false },
+};
+
+double ideal[kMaxClocks];  // s
+double actual[kMaxClocks];
+bool dropped[kMaxClocks];
+uint32_t num_clocks;
+
+double ticks[kMaxClocks];
+uint32_t num_ticks;
+
+double Gaussian() {
+  double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+  double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+  return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+double Bpm(const Stream& s, double t) {
+  if (!s.change_time || t < s.change_time) {
+    return s.bpm;
+  }
+  if (!s.change_duration) {
+    return s.new_bpm;
+  }
+  double x = (t - s.change_time) / s.change_duration;
+  return s.bpm + (s.new_bpm - s.bpm) * (x < 1.0 ? x : 1.0);
+}
+
+void MakeClocks(const Stream& s) {
+  num_clocks = 0;
+  uint32_t num_dropped = 0;
+  double t = s.cold_start ? kStartTime : kStartTime - 1.0;
+  while (t < kDuration + 1.0 && num_clocks < kMaxClocks) {
+    double error = 0.0;
+    if (s.usb) {
+      error = (rand() / (double)RAND_MAX - 0.5) * 2.0 * s.jitter;
+    } else {
+      error = Gaussian() * s.jitter;
+    }
+    double a = t + error * 1e-3;
+    if (s.usb) {
+      a = ceil(a * 1000.0) / 1000.0;
+    }
+    ideal[num_clocks] = t;
+    actual[num_clocks] = a;
+    dropped[num_clocks] = s.dropout && t >= s.change_time &&
+        num_dropped++ < kNumDroppedClocks;
+    ++num_clocks;
+    t += 60.0 / Bpm(s, t) / 24.0;
+  }
+}
+
+// Runs the clock, from the Start message (or the clock it comes with).
+void Run() {
+  clock.Init();
+  clock.Start();
+  clock.set_external(false);
+  clock.Update(120, 0, 0);
+  clock.set_external(true);
+  TCNT1 = 0;
+  OCR1A = 6509;
+  TIFR1 = 0;
+
+  num_ticks = 0;
+  bool started = false;
+  uint32_t next = 0;
+  uint32_t end = static_cast<uint32_t>(kDuration * kTimerCountsPerSecond);
+  for (uint32_t count = 0; count < end; ++count) {
+    double now = count / kTimerCountsPerSecond;
+    while (next < num_clocks && actual[next] <= now) {
+      if (!started && ideal[next] >= kStartTime) {
+        clock.StartExternal();
+        started = true;
+      }
+      if (!dropped[next]) {
+        clock.OnExternalClock();
+      }
+      ++next;
+    }
+    if (TCNT1 == OCR1A) {
+      TCNT1 = 0;
+      OCR1A = clock.Tick();
+      if (started && !clock.held() && num_ticks < kMaxClocks) {
+        ticks[num_ticks++] = now;
+      }
+    } else {
+      ++TCNT1;
+    }
+  }
+}
+
+struct Result {
+  double lock;  // beats
+  double mean;  // ms
+  double rms;
+  double max;
+  double input_rms;
+  double period_rms;
+  uint32_t num_ticks;
+  uint32_t num_clocks;  // Received after the Start message
+};
+
+Result Measure(const Stream& s) {
+  Result r;
+  memset(&r, 0, sizeof(r));
+
+  // The n-th tick is due on the n-th clock received.
+  static uint32_t clock_index[kMaxClocks];
+  double end = kDuration;
+  for (uint32_t j = 0; j < num_clocks; ++j) {
+    if (ideal[j] >= kStartTime && !dropped[j] && actual[j] < end) {
+      clock_index[r.num_clocks++] = j;
+    }
+  }
+  r.num_ticks = num_ticks;
+  uint32_t n = num_ticks < r.num_clocks ? num_ticks : r.num_clocks;
+  static double error[kMaxClocks];
+  for (uint32_t i = 0; i < n; ++i) {
+    error[i] = (ticks[i] - ideal[clock_index[i]]) * 1000.0;
+  }
+
+  // Settled error.
+  double settle = kStartTime + kSettleTime;
+  if (s.change_time) {
+    settle = s.change_time + s.change_duration + kSettleTime;
+  }
+  double sum = 0.0;
+  double sum_squares = 0.0;
+  double input_squares = 0.0;
+  double period_squares = 0.0;
+  uint32_t num_settled = 0;
+  uint32_t num_periods = 0;
+  for (uint32_t i = 0; i < n; ++i) {
+    uint32_t j = clock_index[i];
+    if (ticks[i] < settle) {
+      continue;
+    }
+    double input = (actual[j] - ideal[j]) * 1000.0;
+    sum += error[i];
+    sum_squares += error[i] * error[i];
+    input_squares += input * input;
+    ++num_settled;
+    if (i && clock_index[i - 1] == j - 1) {
+      double p = (ticks[i] - ticks[i - 1]) - (ideal[j] - ideal[j - 1]);
+      period_squares += p * p * 1e6;
+      ++num_periods;
+    }
+  }
+  r.mean = sum / num_settled;
+  r.rms = sqrt(sum_squares / num_settled - r.mean * r.mean);
+  r.input_rms = sqrt(input_squares / num_settled);
+  r.period_rms = sqrt(period_squares / num_periods);
+
+  double threshold = 4.0 * r.rms > 1.0 ? 4.0 * r.rms : 1.0;
+  double from = s.change_time ? s.change_time + s.change_duration : kStartTime;
+  double lock = 0.0;
+  for (uint32_t i = 0; i < n; ++i) {
+    double deviation = fabs(error[i] - r.mean);
+    if (ticks[i] >= settle && deviation > r.max) {
+      r.max = deviation;
+    }
+    if (deviation > threshold && ticks[i] - from > lock) {
+      lock = ticks[i] - from;
+    }
+  }
+  r.lock = lock * Bpm(s, kDuration) / 60.0;
+  return r;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: pll_sim [--check]\n");
+    return 1;
+  }
+
+  int failures = 0;
+  printf("%-20s %5s %7s %6s %6s %7s %7s %6s %6s\n", "", "lock", "mean",
+         "rms", "max", "input", "period", "clocks", "ticks");
+  for (uint8_t i = 0; i < sizeof(kStreams) / sizeof(kStreams[0]); ++i) {
+    const Stream& s = kStreams[i];
+    srand(1234 + i);
+    MakeClocks(s);
+    Run();
+    Result r = Measure(s);
+    printf("%-20s %5.2f %+7.3f %6.3f %6.3f %7.3f %7.3f %6u %6u\n",
+           s.name, r.lock, r.mean, r.rms, r.max, r.input_rms, r.period_rms,
+           r.num_clocks, r.num_ticks);
+    int32_t lead = r.num_ticks - r.num_clocks;
+    double max_lock = s.change_time && !s.dropout ? kMaxRelock : kMaxLock;
+    if ((s.jitter && r.rms > 0.5 * r.input_rms) || r.lock > max_lock ||
+        lead < -1 || lead > 1) {
+      ++failures;
+    }
+  }
+  printf("lock in beats, errors in ms. input: error of the former firmware, "
+         "ticked on\neach clock received. period: rms error of the tick "
+         "durations.\n");
+  return check && failures ? 1 : 0;
+}
@@ -0,0 +1,347 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Replay of humanized playing into the real time recording.
+//
+// The real seq, clock, event scheduler and LFO code runs on a virtual Timer1,
+// with milliseconds() following it. A first pass logs the start time of each
+// step. In a second, identical pass, a player records an 8-step line 3 times
+// over, from the second time the sequence plays. Each note is played on the
+// start of its step, with a Gaussian timing error, reaches Seq::OnNoteOn()
+// after the MIDI input latency, and is held for 90% of its length (a 16th, 8th
+// or quarter note), with the same error on the release. The input latency
+// setting matches the actual latency.
+//
+// After the last pass, each step must hold its note (placement) and its length
+// (gate). The placement the firmware had before real time recording, the step
+// playing when the note is received, is given for comparison, as well as the
+// host time taken by the note on and off handlers while recording.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile record_sim
+//   build/tools/record_sim            prints the table
+//   build/tools/record_sim --check    exits with an error if less than 99%
+//                                     of the notes played with up to 15ms of
+//                                     error are placed on their step, or if
+//                                     less than 99% of the notes played
+//                                     without error get their gate
+
+#include "midialf/clock.h"
+#include "midialf/cv/cv.h"
+#include "midialf/cv/port.h"
+#include "midialf/event_scheduler.h"
+#include "midialf/lfo.h"
+#include "midialf/midi_handler.h"
+#include "midialf/note_duration.h"
+#include "midialf/seq.h"
+#include "midialf/storage.h"
+#include "midialf/sysex_handler.h"
+#include "midialf/ui.h"
+
+#include "avrlib/random.h"
+#include "avrlib/time.h"
+
+#include "tools/host/host.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+namespace midialf {
+
+// Stubs for the parts of the firmware the sequencer calls into.
+
+volatile uint8_t SysExHandler::block_open_;
+volatile uint8_t SysExHandler::block_aborted_;
+
+uint8_t Storage::ReadSeqData(uint8_t, SeqData*, uint8_t) { return 0; }
+uint8_t Storage::ReadSeqInfo(uint8_t, SeqInfo*) { return 0; }
+uint8_t Storage::WriteSeqData(uint8_t, const SeqData*, uint8_t) { return 0; }
+uint8_t Storage::WriteSeqInfo(uint8_t, const SeqInfo*) { return 0; }
+
+int16_t Ui::Scale(int16_t, int16_t, int16_t, int16_t, int16_t x1max) {
+  return x1max;
+}
+
+uint8_t CV::glide_;
+
+void CV::SendMode(uint8_t, uint8_t) { }
+void CV::SendNote(uint8_t) { }
+void CV::SendPBnd(uint16_t) { }
+
+void Port::SetState(uint8_t, uint8_t) { }
+void Port::SetPulse(uint8_t) { }
+void Port::UpdateCvOffset() { }
+void Port::UpdateGateInvert() { }
+void Port::UpdateStrobeWidth() { }
+
+}  // namespace midialf
+
+using namespace avrlib;
+using namespace midialf;
+
+namespace {
+
+// Time is counted in CPU cycles.
+const uint32_t kCyclesPerTimer1Count = 64;
+const double kCyclesPerMs = F_CPU / 1000.0;
+
+const uint8_t kBpm = 120;
+const uint8_t kInputLatency = 12;  // ms
+const uint8_t kNumLoops = 3;
+const uint8_t kNumNotes = kNumLoops * kNumSteps;
+const uint16_t kNumTrials = 200;
+const uint8_t kFirstNote = 40;
+const uint8_t kGates[] = { k16thNote, k8thNote, k4thNote };
+
+uint64_t now;
+uint16_t interval;
+
+void SetMilliseconds() {
+  timer0_milliseconds.value = static_cast<uint32_t>(now / kCyclesPerMs);
+}
+
+// The output is not looked at.
+void DrainOutput() {
+  uint8_t data[256];
+  while (HostUartRead(0, data, sizeof(data))) { }
+  MidiHandler::OutputBuffer::Flush();
+}
+
+// See ISR(TIMER1_COMPA_vect) in midialf.cc.
+void Timer1Interrupt() {
+  SetMilliseconds();
+  interval = midialf::clock.Tick() + 1;
+  if (midialf::clock.running()) {
+    seq.OnInternalClockTick();
+    if (midialf::clock.stepped()) {
+      seq.OnInternalClockStep();
+    }
+  }
+  DrainOutput();
+}
+
+struct Config {
+  const char* name;
+  uint8_t groove_template;
+  uint8_t groove_amount;
+};
+
+const Config kConfigs[] = {
+  { "straight", 0, 0 },
+  { "swing", 0, 127 },
+  { "shuffle", 1, 127 },
+};
+
+void Reset(const Config& config) {
+  now = 0;
+  interval = 1;
+  SetMilliseconds();
+  Random::Seed(1);
+
+  event_scheduler.Init();
+  seq.set_slot(0);
+  seq.InitSeqInfo();
+  for (uint8_t s = 0; s < 4; ++s) {
+    seq.InitSeq(s);
+  }
+  seq.Init();
+  seq.set_bpm(kBpm);
+  seq.set_clock_rate(k16thNote);
+  seq.set_groove_template(config.groove_template);
+  seq.set_groove_amount(config.groove_amount);
+  seq.set_record_latency(kInputLatency);
+  seq.StartRecording();
+  DrainOutput();
+}
+
+// Start time of the steps played, in ms. The player starts on the second
+// pass of the sequence.
+double step_times[kNumNotes + kNumSteps + 2];
+
+void LogStepTimes(const Config& config) {
+  Reset(config);
+  seq.Start();
+  uint8_t num_steps = 0;
+  uint8_t step = 0xff;
+  uint64_t next_timer1 = 0;
+  while (num_steps < sizeof(step_times) / sizeof(step_times[0])) {
+    now = next_timer1;
+    Timer1Interrupt();
+    if (seq.running() == 1 && seq.step() != step) {
+      step = seq.step();
+      step_times[num_steps++] = now / kCyclesPerMs;
+    }
+    next_timer1 += interval * kCyclesPerTimer1Count;
+  }
+  seq.Stop();
+}
+
+struct NoteEvent {
+  double time;  // ms
+  uint8_t note;
+  uint8_t velocity;
+};
+
+NoteEvent events[kNumNotes * 2];
+
+int CompareEvents(const void* a, const void* b) {
+  double d = static_cast<const NoteEvent*>(a)->time -
+      static_cast<const NoteEvent*>(b)->time;
+  return d < 0 ? -1 : (d > 0 ? 1 : 0);
+}
+
+double Gaussian() {
+  double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+  double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+  return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+struct Result {
+  uint32_t num_steps;
+  uint32_t placed;
+  uint32_t gated;
+  uint32_t placed_before;  // On the step playing when received
+  uint32_t num_events;
+  double host_time;  // s
+};
+
+double HostSeconds() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+void Record(const Config& config, double sigma, Result* result) {
+  uint8_t gates[kNumSteps];
+  for (uint8_t s = 0; s < kNumSteps; ++s) {
+    gates[s] = kGates[rand() % sizeof(kGates)];
+  }
+  double ms_per_tick = 60000.0 / kBpm / 24;
+  for (uint8_t i = 0; i < kNumNotes; ++i) {
+    uint8_t s = i % kNumSteps;
+    double time = step_times[kNumSteps + i] + sigma * Gaussian() +
+        kInputLatency;
+    double length = NoteDuration::GetMidiClockTicks(gates[s]) * ms_per_tick *
+        0.9;
+    events[2 * i].time = time;
+    events[2 * i].note = kFirstNote + s;
+    events[2 * i].velocity = 100;
+    events[2 * i + 1].time = time + length + sigma * Gaussian();
+    events[2 * i + 1].note = kFirstNote + s;
+    events[2 * i + 1].velocity = 0;
+    if (i >= kNumNotes - kNumSteps) {
+      // The step the note used to be written into.
+      uint8_t j = 0;
+      while (j + 1U < sizeof(step_times) / sizeof(step_times[0]) &&
+             step_times[j + 1] <= time) {
+        ++j;
+      }
+      if (j % kNumSteps == s) {
+        ++result->placed_before;
+      }
+    }
+  }
+  qsort(events, kNumNotes * 2, sizeof(NoteEvent), &CompareEvents);
+
+  Reset(config);
+  seq.Start();
+  uint64_t next_timer1 = 0;
+  uint8_t next_event = 0;
+  double end = events[kNumNotes * 2 - 1].time +
+      2 * (step_times[1] - step_times[0]);
+  while (now / kCyclesPerMs < end) {
+    uint64_t event_time = next_event < kNumNotes * 2 ?
+        static_cast<uint64_t>(events[next_event].time * kCyclesPerMs) :
+        ~0ULL;
+    if (event_time < next_timer1) {
+      now = event_time;
+      SetMilliseconds();
+      const NoteEvent& e = events[next_event++];
+      double start = HostSeconds();
+      if (e.velocity) {
+        seq.OnNoteOn(seq.channel(), e.note, e.velocity);
+      } else {
+        seq.OnNoteOff(seq.channel(), e.note, 0);
+      }
+      result->host_time += HostSeconds() - start;
+      ++result->num_events;
+      DrainOutput();
+    } else {
+      now = next_timer1;
+      Timer1Interrupt();
+      next_timer1 += interval * kCyclesPerTimer1Count;
+    }
+  }
+  seq.Stop();
+  DrainOutput();
+
+  for (uint8_t s = 0; s < kNumSteps; ++s) {
+    ++result->num_steps;
+    if (seq.note(0, s) == kFirstNote + s) {
+      ++result->placed;
+      if (seq.gate(0, s) == gates[s]) {
+        ++result->gated;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: record_sim [--check]\n");
+    return 1;
+  }
+
+  static const double kSigmas[] = { 0.0, 5.0, 15.0, 25.0 };
+  int failures = 0;
+  double host_time = 0.0;
+  uint32_t num_events = 0;
+  printf("%-9s %8s %8s %8s %8s\n", "", "error", "placed", "gate", "before");
+  for (uint8_t c = 0; c < sizeof(kConfigs) / sizeof(kConfigs[0]); ++c) {
+    LogStepTimes(kConfigs[c]);
+    for (uint8_t i = 0; i < sizeof(kSigmas) / sizeof(kSigmas[0]); ++i) {
+      srand(1);
+      Result result;
+      memset(&result, 0, sizeof(result));
+      for (uint16_t trial = 0; trial < kNumTrials; ++trial) {
+        Record(kConfigs[c], kSigmas[i], &result);
+      }
+      double placed = 100.0 * result.placed / result.num_steps;
+      double gated = 100.0 * result.gated / result.num_steps;
+      printf("%-9s %6.0fms %7.1f%% %7.1f%% %7.1f%%\n",
+             kConfigs[c].name, kSigmas[i], placed, gated,
+             100.0 * result.placed_before / result.num_steps);
+      if ((kSigmas[i] <= 15.0 && placed < 99.0) ||
+          (kSigmas[i] == 0.0 && gated < 99.0)) {
+        ++failures;
+      }
+      host_time += result.host_time;
+      num_events += result.num_events;
+    }
+  }
+  printf("note on/off while recording: %.0f ns per event (host)\n",
+         host_time / num_events * 1e9);
+  return check && failures ? 1 : 0;
+}
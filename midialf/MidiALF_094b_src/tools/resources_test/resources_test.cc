@@ -0,0 +1,244 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Decoding of the compressed resources.
+//
+// Each compressed entry of midialf/resources.cc is decoded with the readers
+// of avrlib/resources_manager.h, as the firmware does, and its size and
+// CRC-16 are compared with the _DECODED_SIZE and _CHECKSUM values the
+// resources compiler computed from the source data:
+//
+//   lfo_waveforms   'fold+delta' blocks, read as sample pairs with
+//                   LookupPair(), as Lfo::Tick() does.
+//   scale names     'dictionary' strings, read with LoadDictionaryString(),
+//                   as Scale::GetScaleName() does.
+//
+// The decode cost is the host time per decoded value (per sample, per
+// string), and the worst case: the number of nibbles read for the most
+// expensive sample pair, the number of dictionary entries skipped for the
+// most expensive string. The AVR cycles are not counted.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile resources_test
+//   build/tools/resources_test            prints the results
+//   build/tools/resources_test --check    exits with an error if an entry does
+//                                         not decode to its checksum
+
+#include "midialf/lfo.h"
+#include "midialf/resources.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+using namespace midialf;
+
+namespace {
+
+const uint16_t kMaxDecodedSize = 4096;
+const uint16_t kNumPasses = 2000;
+
+// Same as _crc16_update from avr-libc and Crc16 in resources_compiler.py.
+uint16_t Crc16(uint16_t crc, uint8_t value) {
+  crc ^= value;
+  for (uint8_t i = 0; i < 8; ++i) {
+    crc = crc & 1 ? (crc >> 1) ^ 0xa001 : crc >> 1;
+  }
+  return crc;
+}
+
+double HostSeconds() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+struct Result {
+  const char* name;
+  uint16_t stored_size;
+  uint16_t decoded_size;
+  uint16_t expected_decoded_size;
+  uint16_t checksum;
+  uint16_t expected_checksum;
+  double ns_per_value;
+  uint16_t worst;
+  const char* worst_unit;
+};
+
+// Nibbles LookupDelta() reads to decode the samples up to last.
+uint16_t DeltaNibbles(const prog_uint8_t* block, uint8_t last) {
+  uint16_t position = 0;
+  for (uint8_t n = 0; n < last; ++n) {
+    uint8_t byte = pgm_read_byte(block + 1 + (position >> 1));
+    uint8_t nibble = position & 1 ? byte & 0xf : byte >> 4;
+    position += nibble == 8 ? 3 : 1;
+  }
+  return position;
+}
+
+uint8_t ReadLfoWaveforms(uint8_t* decoded, uint16_t* worst) {
+  const uint8_t kBlockSize = WAV_RES_LFO_WAVEFORMS_BLOCK_SIZE;
+  uint8_t num_blocks = WAV_RES_LFO_WAVEFORMS_DECODED_SIZE / kBlockSize;
+  for (uint8_t block = 0; block < num_blocks; ++block) {
+    uint8_t mode;
+    const prog_uint8_t* waveform = ResourcesManager::LookupBlock(
+        wav_res_lfo_waveforms, wav_res_lfo_waveforms_blocks, block, &mode);
+    for (uint8_t i = 0; i < kBlockSize - 1; ++i) {
+      uint8_t a, b;
+      ResourcesManager::LookupPair<kLfoWaveformHalf>(
+          waveform, mode, i, &a, &b);
+      decoded[block * kBlockSize + i] = a;
+      decoded[block * kBlockSize + i + 1] = b;
+      if (worst && (mode & avrlib::BLOCK_DELTA)) {
+        // Same mirroring as LookupPair().
+        uint8_t j = i;
+        uint8_t k = i + 1;
+        if (mode & avrlib::BLOCK_FOLD_MASK) {
+          if (j > kLfoWaveformHalf) j = 2 * kLfoWaveformHalf - j;
+          if (k > kLfoWaveformHalf) k = 2 * kLfoWaveformHalf - k;
+        }
+        uint16_t nibbles = DeltaNibbles(waveform, (j < k ? j : k) + 1);
+        if (nibbles > *worst) {
+          *worst = nibbles;
+        }
+      }
+    }
+  }
+  return num_blocks;
+}
+
+Result TestLfoWaveforms() {
+  static uint8_t decoded[kMaxDecodedSize];
+  Result result;
+  memset(&result, 0, sizeof(Result));
+  result.name = "lfo_waveforms";
+  result.stored_size = WAV_RES_LFO_WAVEFORMS_SIZE;
+  result.expected_decoded_size = WAV_RES_LFO_WAVEFORMS_DECODED_SIZE;
+  result.expected_checksum = WAV_RES_LFO_WAVEFORMS_CHECKSUM;
+  result.worst_unit = "nibbles";
+
+  uint8_t num_blocks = ReadLfoWaveforms(decoded, &result.worst);
+  result.decoded_size = num_blocks * WAV_RES_LFO_WAVEFORMS_BLOCK_SIZE;
+  for (uint16_t i = 0; i < result.decoded_size; ++i) {
+    result.checksum = Crc16(result.checksum, decoded[i]);
+  }
+
+  double start = HostSeconds();
+  for (uint16_t pass = 0; pass < kNumPasses; ++pass) {
+    ReadLfoWaveforms(decoded, NULL);
+  }
+  double elapsed = HostSeconds() - start;
+  result.ns_per_value = elapsed * 1e9 / kNumPasses / result.decoded_size;
+  return result;
+}
+
+void ReadScaleNames(char* decoded) {
+  for (uint8_t i = 0; i < SCL_RES_NUM_STRINGS; ++i) {
+    ResourcesManager::LoadDictionaryString(
+        scale_name_dictionary, scale_name_words, SCL_RES_WORDS_PER_STRING, i,
+        decoded + i * SCL_RES_WIDTH, SCL_RES_WIDTH);
+  }
+}
+
+Result TestScaleNames() {
+  static char decoded[SCL_RES_NUM_STRINGS * SCL_RES_WIDTH];
+  Result result;
+  memset(&result, 0, sizeof(Result));
+  result.name = "scale names";
+  result.expected_decoded_size = sizeof(decoded);
+  result.expected_checksum = SCL_RES_CHECKSUM;
+  result.worst_unit = "words";
+
+  // Stored size: the word indices, and the dictionary up to its last word.
+  uint8_t num_words = 0;
+  for (uint16_t i = 0; i < SCL_RES_NUM_STRINGS * SCL_RES_WORDS_PER_STRING;
+       ++i) {
+    uint8_t word = pgm_read_byte(scale_name_words + i);
+    if (word != 0xff && word >= num_words) {
+      num_words = word + 1;
+    }
+  }
+  const prog_uint8_t* p = scale_name_dictionary;
+  for (uint8_t i = 0; i < num_words; ++i) {
+    p += pgm_read_byte(p) + 1;
+  }
+  result.stored_size = SCL_RES_NUM_STRINGS * SCL_RES_WORDS_PER_STRING +
+      (p - scale_name_dictionary);
+
+  // Worst case: the dictionary entries skipped to find the words of a string.
+  for (uint8_t i = 0; i < SCL_RES_NUM_STRINGS; ++i) {
+    uint16_t skipped = 0;
+    for (uint8_t w = 0; w < SCL_RES_WORDS_PER_STRING; ++w) {
+      uint8_t word = pgm_read_byte(
+          scale_name_words + i * SCL_RES_WORDS_PER_STRING + w);
+      if (word == 0xff) {
+        break;
+      }
+      skipped += word;
+    }
+    if (skipped > result.worst) {
+      result.worst = skipped;
+    }
+  }
+
+  memset(decoded, 0, sizeof(decoded));
+  ReadScaleNames(decoded);
+  result.decoded_size = sizeof(decoded);
+  for (uint16_t i = 0; i < result.decoded_size; ++i) {
+    result.checksum = Crc16(result.checksum, decoded[i]);
+  }
+
+  double start = HostSeconds();
+  for (uint16_t pass = 0; pass < kNumPasses; ++pass) {
+    ReadScaleNames(decoded);
+  }
+  double elapsed = HostSeconds() - start;
+  result.ns_per_value = elapsed * 1e9 / kNumPasses / SCL_RES_NUM_STRINGS;
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: resources_test [--check]\n");
+    return 1;
+  }
+
+  Result results[] = { TestLfoWaveforms(), TestScaleNames() };
+  uint8_t failures = 0;
+  printf("%-16s %7s %8s %9s %9s %7s\n",
+         "entry", "stored", "decoded", "checksum", "ns/value", "worst");
+  for (uint8_t i = 0; i < sizeof(results) / sizeof(Result); ++i) {
+    const Result& r = results[i];
+    bool ok = r.decoded_size == r.expected_decoded_size &&
+        r.checksum == r.expected_checksum;
+    printf("%-16s %7d %8d    0x%04x %9.1f %7d %s%s\n",
+           r.name, r.stored_size, r.decoded_size, r.checksum,
+           r.ns_per_value, r.worst, r.worst_unit, ok ? "" : "  MISMATCH");
+    if (!ok) {
+      printf("  expected %d bytes, checksum 0x%04x\n",
+             r.expected_decoded_size, r.expected_checksum);
+      ++failures;
+    }
+  }
+  printf("ns/value: host time per sample, per string for the names.\n");
+  return check && failures ? 1 : 0;
+}
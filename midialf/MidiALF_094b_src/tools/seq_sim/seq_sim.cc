@@ -0,0 +1,723 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host simulator of the sequencer core. The real seq, clock, event
+// scheduler, LFO and note duration code runs on a virtual Timer1, as fast as
+// the host allows, and the MIDI, CV and gate output is written to a
+// timestamped log or to a standard MIDI file. Port and CV only log what they
+// are asked to output, the rest of the UI and storage is stubbed out.
+//
+// Build:
+//   make -f tools/makefile seq_sim
+//
+// Usage:
+//   seq_sim --list
+//   seq_sim [--clock] [--ticks n] [--smf file.mid] scenario
+//   seq_sim --check tools/seq_sim/golden
+//   seq_sim --update tools/seq_sim/golden
+//   seq_sim --benchmark
+//
+// --check plays all the scenarios and compares their logs with the golden
+// logs in the given directory, --update rewrites them. --benchmark measures
+// the number of Timer1 interrupts (clock.Tick() and Seq::OnInternalClockTick)
+// run per second of host time.
+
+#include "midialf/clock.h"
+#include "midialf/cv/cv.h"
+#include "midialf/cv/port.h"
+#include "midialf/event_scheduler.h"
+#include "midialf/lfo.h"
+#include "midialf/midi_handler.h"
+#include "midialf/note_duration.h"
+#include "midialf/seq.h"
+#include "midialf/storage.h"
+#include "midialf/sysex_handler.h"
+#include "midialf/ui.h"
+
+#include "avrlib/random.h"
+#include "avrlib/time.h"
+
+#include "tools/host/host.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <string>
+#include <vector>
+
+namespace midialf {
+
+// Stubs for the parts of the firmware the sequencer calls into.
+
+volatile uint8_t SysExHandler::block_open_;
+volatile uint8_t SysExHandler::block_aborted_;
+
+uint8_t Storage::ReadSeqData(uint8_t, SeqData*, uint8_t) { return 0; }
+uint8_t Storage::ReadSeqInfo(uint8_t, SeqInfo*) { return 0; }
+uint8_t Storage::WriteSeqData(uint8_t, const SeqData*, uint8_t) { return 0; }
+uint8_t Storage::WriteSeqInfo(uint8_t, const SeqInfo*) { return 0; }
+
+int16_t Ui::Scale(
+    int16_t x0, int16_t x0min, int16_t x0max, int16_t x1min, int16_t x1max) {
+  if (x0max == x0min) {
+    return x1max;
+  }
+  int16_t x1 = x1min + ((x0 - x0min) * (x1max - x1min)) / (x0max - x0min);
+  int16_t low = x1min < x1max ? x1min : x1max;
+  int16_t high = x1min < x1max ? x1max : x1min;
+  return x1 < low ? low : (x1 > high ? high : x1);
+}
+
+}  // namespace midialf
+
+using namespace avrlib;
+using namespace midialf;
+
+namespace {
+
+// Timer1 runs at F_CPU / 64.
+const uint32_t kTimerCountsPerSecond = F_CPU / 64;
+
+struct Event {
+  uint64_t time;  // us
+  std::string text;
+  uint8_t midi[3];
+  uint8_t midi_size;
+};
+
+uint64_t now;  // Timer1 counts
+bool logging;
+bool log_clock;
+std::vector<Event> events;
+
+uint64_t Microseconds() {
+  return now * 1000000 / kTimerCountsPerSecond;
+}
+
+void Log(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+void Log(const char* format, ...) {
+  if (!logging) {
+    return;
+  }
+  char text[64];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  Event event;
+  event.time = Microseconds();
+  event.text = text;
+  event.midi_size = 0;
+  events.push_back(event);
+}
+
+// MIDI output, split into messages.
+
+uint8_t running_status;
+uint8_t message[3];
+uint8_t message_size;
+
+uint8_t MessageSize(uint8_t status) {
+  if (status >= 0xf0) {
+    return status == 0xf2 ? 3 : (status == 0xf1 || status == 0xf3 ? 2 : 1);
+  }
+  return (status & 0xe0) == 0xc0 ? 2 : 3;
+}
+
+void LogMidiByte(uint8_t byte) {
+  if (!logging) {
+    return;
+  }
+  if (byte >= 0xf8) {
+    if (byte != 0xf8 || log_clock) {
+      Log("midi %02x", byte);
+    }
+    return;
+  }
+  if (byte & 0x80) {
+    running_status = byte;
+    message_size = 0;
+  } else if (!running_status) {
+    return;
+  } else if (!message_size) {
+    message[message_size++] = running_status;
+  }
+  message[message_size++] = byte;
+  if (message_size == MessageSize(running_status)) {
+    if (message_size == 3) {
+      Log("midi %02x %02x %02x", message[0], message[1], message[2]);
+    } else if (message_size == 2) {
+      Log("midi %02x %02x", message[0], message[1]);
+    } else {
+      Log("midi %02x", message[0]);
+    }
+    Event& event = events.back();
+    memcpy(event.midi, message, message_size);
+    event.midi_size = message_size;
+    message_size = 0;
+    if (running_status >= 0xf0) {
+      running_status = 0;
+    }
+  }
+}
+
+// Collects the bytes written directly to the UART, then the bytes queued
+// in the output buffer, which the Timer2 interrupt sends within the next ms.
+void CollectMidiOutput() {
+  uint8_t data[256];
+  uint16_t size;
+  while ((size = HostUartRead(0, data, sizeof(data))) != 0) {
+    for (uint16_t i = 0; i < size; ++i) {
+      LogMidiByte(data[i]);
+    }
+  }
+  while (MidiHandler::OutputBuffer::readable()) {
+    LogMidiByte(MidiHandler::OutputBuffer::ImmediateRead());
+  }
+}
+
+// One Timer1 interrupt, see ISR(TIMER1_COMPA_vect) in midialf.cc. Returns
+// the number of timer counts to the next one.
+uint16_t Timer1Interrupt() {
+  timer0_milliseconds.value = Microseconds() / 1000;
+  uint16_t interval = midialf::clock.Tick();
+  if (midialf::clock.running()) {
+    seq.OnInternalClockTick();
+    if (midialf::clock.stepped()) {
+      seq.OnInternalClockStep();
+    }
+  }
+  return interval + 1;
+}
+
+void Run(uint32_t num_ticks) {
+  while (num_ticks--) {
+    uint16_t interval = Timer1Interrupt();
+    CollectMidiOutput();
+    now += interval;
+  }
+}
+
+const uint8_t kNumSeqs = 4;
+
+const char* const kCvModeNames[] = {
+  "note", "velo", "cc1", "cc2", "lfo1", "lfo2", "atch", "pbnd"
+};
+
+const char* const kGateModeNames[] = {
+  "gate", "strobe", "clock", "start", "seq", "lfo1", "lfo2"
+};
+
+}  // namespace
+
+namespace midialf {
+
+// CV and gate back ends, logging the values they are asked to output.
+
+uint8_t CV::glide_;
+
+void CV::SendMode(uint8_t mode, uint8_t value) {
+  Log("cv %s %d", kCvModeNames[mode], value);
+}
+
+void CV::SendNote(uint8_t value) {
+  Log("cv %s %d%s", kCvModeNames[CVMODE_NOTE], value, glide_ ? " glide" : "");
+}
+
+void CV::SendPBnd(uint16_t value) {
+  Log("cv %s %d", kCvModeNames[CVMODE_PBND], value);
+}
+
+void Port::SetState(uint8_t index, uint8_t on) {
+  Log("%s %s", kGateModeNames[index], on ? "on" : "off");
+}
+
+void Port::SetPulse(uint8_t index) {
+  if (index != GATEMODE_CLOCK || log_clock) {
+    Log("%s pulse", kGateModeNames[index]);
+  }
+}
+
+void Port::UpdateCvOffset() { }
+void Port::UpdateGateInvert() { }
+void Port::UpdateStrobeWidth() { }
+
+}  // namespace midialf
+
+namespace {
+
+// Scenarios. All start from the default program, with a different note on
+// each step of each sequence, and play at 120 BPM.
+
+struct Scenario {
+  const char* name;
+  void (*setup)();
+  uint16_t num_steps;  // 16th notes
+};
+
+void SetupForward() { }
+
+void SetupBackward() {
+  seq.set_direction(DIRECTION_BACKWARD);
+}
+
+void SetupPendulum() {
+  seq.set_direction(DIRECTION_PENDULUM);
+}
+
+void SetupPendulumSkip() {
+  seq.set_direction(DIRECTION_PENDULUM);
+  seq.set_skip_mask(0, 0x89);
+}
+
+void SetupRandom() {
+  seq.set_direction(DIRECTION_RANDOM);
+  seq.set_skip_mask(0, 0x22);
+}
+
+void SetupOneStep() {
+  // The skip loop of AdvanceStep() must end with a single step left
+  seq.set_skip_mask(0, 0xdf);
+  seq.set_steps_forward(2);
+  seq.set_steps_backward(1);
+}
+
+void SetupAllSkipped() {
+  seq.set_skip_mask(0, 0xff);
+}
+
+void SetupLink16() {
+  seq.set_link_mode(LINK_MODE_16);
+  seq.set_skip_mask(1, 0x81);
+}
+
+void SetupLink32() {
+  seq.set_link_mode(LINK_MODE_32);
+}
+
+void SetupLink32Backward() {
+  seq.set_link_mode(LINK_MODE_32);
+  seq.set_direction(DIRECTION_BACKWARD);
+  seq.set_skip_mask(0, 0x80);
+  seq.set_skip_mask(3, 0x01);
+}
+
+void SetupLink32Pendulum() {
+  seq.set_link_mode(LINK_MODE_32);
+  seq.set_direction(DIRECTION_PENDULUM);
+}
+
+void SetupTracks() {
+  seq.set_link_mode(LINK_MODE_TRACKS);
+  static const uint8_t directions[] = {
+    DIRECTION_FORWARD, DIRECTION_BACKWARD, DIRECTION_PENDULUM,
+    DIRECTION_FORWARD
+  };
+  static const uint8_t divisions[] = {
+    CLOCK_DIVISION_NONE, CLOCK_DIVISION_X2, CLOCK_DIVISION_NONE,
+    CLOCK_DIVISION_X4
+  };
+  for (uint8_t track = 0; track < 4; ++track) {
+    seq.set_track_channel(track, track);
+    seq.set_track_direction(track, directions[track]);
+    seq.set_track_clock_division(track, divisions[track]);
+  }
+  seq.set_skip_mask(2, 0x10);
+}
+
+void SetupProgression() {
+  seq.set_steps_forward(3);
+  seq.set_steps_backward(1);
+  seq.set_steps_replay(1);
+}
+
+void SetupProgressionLink32() {
+  seq.set_link_mode(LINK_MODE_32);
+  seq.set_steps_forward(5);
+  seq.set_steps_backward(2);
+  seq.set_steps_replay(2);
+}
+
+void SetupProgressionBackward() {
+  seq.set_direction(DIRECTION_BACKWARD);
+  seq.set_steps_forward(2);
+  seq.set_steps_backward(1);
+  seq.set_steps_replay(3);
+}
+
+void SetupInterval() {
+  seq.set_steps_interval(3);
+  seq.set_steps_repeat(1);
+  seq.set_steps_skip(2);
+}
+
+void SetupDivision() {
+  seq.set_clock_division(CLOCK_DIVISION_X2);
+}
+
+void SetupSwing() {
+  seq.set_groove_template(1);
+  seq.set_groove_amount(160);
+}
+
+void SetupLegato() {
+  seq.set_lega_mask(0, 0x66);
+  seq.set_mute_mask(0, 0x08);
+}
+
+void SetupRatchets() {
+  static const uint8_t ratchets[] = { 1, 2, 3, 4, 1, 4, 2, 3 };
+  static const uint8_t delays[] = { 0, 0, 1, 0, 3, 2, 0, 1 };
+  for (uint8_t step = 0; step < 8; ++step) {
+    seq.set_ratchets(0, step, ratchets[step]);
+    seq.set_delay(0, step, delays[step]);
+  }
+}
+
+void SetupProbability() {
+  for (uint8_t step = 0; step < 8; ++step) {
+    seq.set_prob(0, step, step);
+  }
+}
+
+const Scenario kScenarios[] = {
+  { "forward", &SetupForward, 32 },
+  { "backward", &SetupBackward, 32 },
+  { "pendulum", &SetupPendulum, 32 },
+  { "pendulum_skip", &SetupPendulumSkip, 32 },
+  { "random", &SetupRandom, 32 },
+  { "one_step", &SetupOneStep, 16 },
+  { "all_skipped", &SetupAllSkipped, 16 },
+  { "link16", &SetupLink16, 48 },
+  { "link32", &SetupLink32, 64 },
+  { "link32_backward", &SetupLink32Backward, 64 },
+  { "link32_pendulum", &SetupLink32Pendulum, 80 },
+  { "tracks", &SetupTracks, 32 },
+  { "progression", &SetupProgression, 40 },
+  { "progression_link32", &SetupProgressionLink32, 64 },
+  { "progression_backward", &SetupProgressionBackward, 40 },
+  { "interval", &SetupInterval, 40 },
+  { "division", &SetupDivision, 32 },
+  { "swing", &SetupSwing, 32 },
+  { "legato", &SetupLegato, 32 },
+  { "ratchets", &SetupRatchets, 32 },
+  { "probability", &SetupProbability, 64 },
+};
+
+const uint8_t kNumScenarios = sizeof(kScenarios) / sizeof(kScenarios[0]);
+
+const Scenario* FindScenario(const char* name) {
+  for (uint8_t i = 0; i < kNumScenarios; ++i) {
+    if (!strcmp(kScenarios[i].name, name)) {
+      return &kScenarios[i];
+    }
+  }
+  return NULL;
+}
+
+void Reset() {
+  logging = false;
+  events.clear();
+  running_status = 0;
+  message_size = 0;
+  now = 0;
+  timer0_milliseconds.value = 0;
+  Random::Seed(1);
+
+  event_scheduler.Init();
+  seq.set_slot(0);
+  seq.InitSeqInfo();
+  for (uint8_t s = 0; s < kNumSeqs; ++s) {
+    seq.InitSeq(s);
+    for (uint8_t step = 0; step < kNumSteps; ++step) {
+      seq.set_note(s, step, 48 + s * 12 + step);
+      seq.set_velo(s, step, 64 + step * 8);
+    }
+  }
+  seq.Init();
+  seq.set_bpm(120);
+  seq.set_clock_rate(k16thNote);
+  CollectMidiOutput();
+}
+
+// Plays the scenario, plus one beat after the stop for the note offs.
+void Play(const Scenario& scenario, uint32_t num_ticks) {
+  Reset();
+  scenario.setup();
+  logging = true;
+  seq.Start();
+  CollectMidiOutput();
+  Run(num_ticks ? num_ticks : scenario.num_steps * kNumTicksPerStep);
+  seq.Stop();
+  CollectMidiOutput();
+  Run(kNumTicksPerStep * 4);
+  logging = false;
+}
+
+std::string FormatLog() {
+  std::string log;
+  char line[96];
+  for (size_t i = 0; i < events.size(); ++i) {
+    snprintf(line, sizeof(line), "%6u.%03u  %s\n",
+        static_cast<uint32_t>(events[i].time / 1000),
+        static_cast<uint32_t>(events[i].time % 1000),
+        events[i].text.c_str());
+    log += line;
+  }
+  return log;
+}
+
+void WriteVariableLength(std::string* track, uint32_t value) {
+  uint8_t bytes[4];
+  uint8_t size = 0;
+  do {
+    bytes[size++] = value & 0x7f;
+    value >>= 7;
+  } while (value);
+  while (size--) {
+    track->push_back(bytes[size] | (size ? 0x80 : 0));
+  }
+}
+
+void WriteBigEndian(FILE* fp, uint32_t value, uint8_t size) {
+  while (size--) {
+    fputc((value >> (size * 8)) & 0xff, fp);
+  }
+}
+
+// Writes the MIDI messages of the log as a format 0 standard MIDI file.
+bool WriteSmf(const char* file_name) {
+  const uint16_t kDivision = 96;
+  const uint32_t kTempo = 60000000 / 120;  // us per quarter note
+  std::string track;
+  track += std::string("\x00\xff\x51\x03", 4);
+  track.push_back(kTempo >> 16);
+  track.push_back((kTempo >> 8) & 0xff);
+  track.push_back(kTempo & 0xff);
+  uint32_t last_tick = 0;
+  for (size_t i = 0; i < events.size(); ++i) {
+    const Event& event = events[i];
+    if (!event.midi_size || event.midi[0] >= 0xf0) {
+      continue;
+    }
+    uint32_t tick = (event.time * kDivision + kTempo / 2) / kTempo;
+    WriteVariableLength(&track, tick - last_tick);
+    last_tick = tick;
+    track.append(reinterpret_cast<const char*>(event.midi), event.midi_size);
+  }
+  track += std::string("\x00\xff\x2f\x00", 4);
+
+  FILE* fp = fopen(file_name, "wb");
+  if (!fp) {
+    return false;
+  }
+  fwrite("MThd", 1, 4, fp);
+  WriteBigEndian(fp, 6, 4);
+  WriteBigEndian(fp, 0, 2);
+  WriteBigEndian(fp, 1, 2);
+  WriteBigEndian(fp, kDivision, 2);
+  fwrite("MTrk", 1, 4, fp);
+  WriteBigEndian(fp, track.size(), 4);
+  fwrite(track.data(), 1, track.size(), fp);
+  return fclose(fp) == 0;
+}
+
+std::string GoldenLogPath(const char* directory, const char* name) {
+  return std::string(directory) + "/" + name + ".log";
+}
+
+bool ReadFile(const std::string& path, std::string* data) {
+  FILE* fp = fopen(path.c_str(), "rb");
+  if (!fp) {
+    return false;
+  }
+  char buffer[4096];
+  size_t size;
+  data->clear();
+  while ((size = fread(buffer, 1, sizeof(buffer), fp)) != 0) {
+    data->append(buffer, size);
+  }
+  fclose(fp);
+  return true;
+}
+
+// Line number of the first difference, ignoring carriage returns.
+uint32_t FirstDifference(const std::string& a, const std::string& b) {
+  uint32_t line = 1;
+  size_t i = 0, j = 0;
+  for (;;) {
+    while (i < a.size() && a[i] == '\r') ++i;
+    while (j < b.size() && b[j] == '\r') ++j;
+    if (i == a.size() || j == b.size()) {
+      return i == a.size() && j == b.size() ? 0 : line;
+    }
+    if (a[i] != b[j]) {
+      return line;
+    }
+    if (a[i] == '\n') {
+      ++line;
+    }
+    ++i;
+    ++j;
+  }
+}
+
+int CheckGoldenLogs(const char* directory, bool update) {
+  int failures = 0;
+  for (uint8_t i = 0; i < kNumScenarios; ++i) {
+    const Scenario& scenario = kScenarios[i];
+    Play(scenario, 0);
+    std::string log = FormatLog();
+    std::string path = GoldenLogPath(directory, scenario.name);
+    if (update) {
+      FILE* fp = fopen(path.c_str(), "wb");
+      if (!fp || fwrite(log.data(), 1, log.size(), fp) != log.size()) {
+        fprintf(stderr, "Cannot write %s\n", path.c_str());
+        return 1;
+      }
+      fclose(fp);
+      printf("%-24s updated\n", scenario.name);
+      continue;
+    }
+    std::string golden;
+    if (!ReadFile(path, &golden)) {
+      printf("%-24s missing %s\n", scenario.name, path.c_str());
+      ++failures;
+      continue;
+    }
+    uint32_t line = FirstDifference(log, golden);
+    if (line) {
+      printf("%-24s differs from line %u\n", scenario.name, line);
+      ++failures;
+    } else {
+      printf("%-24s ok\n", scenario.name);
+    }
+  }
+  if (!update) {
+    printf("%d of %d scenarios differ\n", failures, kNumScenarios);
+  }
+  return failures ? 1 : 0;
+}
+
+double HostSeconds() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+void Benchmark(const char* name, void (*setup)()) {
+  const uint32_t kNumTicks = 2000000;
+  Reset();
+  setup();
+  seq.Start();
+  uint64_t start_time = now;
+  double start = HostSeconds();
+  uint8_t data[256];
+  for (uint32_t i = 0; i < kNumTicks; ++i) {
+    now += Timer1Interrupt();
+    while (MidiHandler::OutputBuffer::readable()) {
+      MidiHandler::OutputBuffer::ImmediateRead();
+    }
+    if (HostUartSize(0) > 512) {
+      HostUartRead(0, data, sizeof(data));
+    }
+  }
+  double elapsed = HostSeconds() - start;
+  double simulated = static_cast<double>(now - start_time) /
+      kTimerCountsPerSecond;
+  seq.Stop();
+  printf("%-24s %10.0f ticks/s, %6.0fx real time\n",
+      name, kNumTicks / elapsed, simulated / elapsed);
+}
+
+void SetupBenchmarkLoad() {
+  SetupTracks();
+  for (uint8_t s = 0; s < kNumSeqs; ++s) {
+    seq.set_cc1send_mask(s, 0xff);
+    seq.set_cc2send_mask(s, 0xff);
+  }
+  for (uint8_t i = 0; i < kNumLfos; ++i) {
+    lfo.set_output(i, 1);
+    lfo.set_rate(i, 10);
+  }
+}
+
+void Usage() {
+  fprintf(stderr,
+      "Usage: seq_sim --list\n"
+      "       seq_sim [--clock] [--ticks n] [--smf file.mid] scenario\n"
+      "       seq_sim --check|--update golden_log_directory\n"
+      "       seq_sim --benchmark\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* smf = NULL;
+  uint32_t num_ticks = 0;
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-'; ++i) {
+    if (!strcmp(argv[i], "--list")) {
+      for (uint8_t j = 0; j < kNumScenarios; ++j) {
+        printf("%s\n", kScenarios[j].name);
+      }
+      return 0;
+    } else if (!strcmp(argv[i], "--check") && i + 1 < argc) {
+      return CheckGoldenLogs(argv[i + 1], false);
+    } else if (!strcmp(argv[i], "--update") && i + 1 < argc) {
+      return CheckGoldenLogs(argv[i + 1], true);
+    } else if (!strcmp(argv[i], "--benchmark")) {
+      Benchmark("forward, 1/16", &SetupForward);
+      Benchmark("random, skips", &SetupRandom);
+      Benchmark("progression", &SetupProgression);
+      Benchmark("4 tracks, CCs, LFOs", &SetupBenchmarkLoad);
+      return 0;
+    } else if (!strcmp(argv[i], "--clock")) {
+      log_clock = true;
+    } else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) {
+      num_ticks = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--smf") && i + 1 < argc) {
+      smf = argv[++i];
+    } else {
+      Usage();
+      return 1;
+    }
+  }
+  if (i + 1 != argc) {
+    Usage();
+    return 1;
+  }
+  const Scenario* scenario = FindScenario(argv[i]);
+  if (!scenario) {
+    fprintf(stderr, "Unknown scenario %s, see --list\n", argv[i]);
+    return 1;
+  }
+  Play(*scenario, num_ticks);
+  if (smf) {
+    if (!WriteSmf(smf)) {
+      fprintf(stderr, "Cannot write %s\n", smf);
+      return 1;
+    }
+  } else {
+    fputs(FormatLog().c_str(), stdout);
+  }
+  return 0;
+}
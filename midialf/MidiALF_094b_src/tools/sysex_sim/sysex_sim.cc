@@ -0,0 +1,499 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Background program dumps while the sequencer plays.
+//
+// The real sequencer, SysExHandler and Storage run on a virtual time line:
+//
+//   Timer1   the compare ISR of midialf.cc, ticking the sequencer at 120 BPM.
+//   TIMER2   SendMidiOut() of midialf.cc at 4.9kHz, with a 31250 baud UART
+//            which holds one byte while it shifts out the previous one.
+//   main     SysExHandler::Poll(), in a main loop whose passes take 300us
+//            for the UI plus the bus time of the EEPROM page reads, on the
+//            I2C bus model of tools/eeprom_sim (400kHz).
+//
+// The bytes written to the UART directly, the clock bytes and those flushed
+// when the MIDI output buffer is full, go out after the byte being sent.
+//
+// Each scenario sends all the programs, as the send page does, one
+// SYSEXCMD_PROGRAMPAGE block per storage page. The blocks received are decoded
+// and compared with the EEPROM, and a slot counts as received when all its
+// pages are. The latency of a note
+// on is the time from its step, or from its scheduled time, to its status
+// byte on the wire, and the delay of a clock byte is counted from its tick.
+// The former firmware loaded and sent each slot with blocking writes and a
+// 100ms delay, which froze the main loop for the whole dump.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile sysex_sim
+//   build/tools/sysex_sim            prints the results
+//   build/tools/sysex_sim --check    exits with an error if a block is bad or
+//                                    missing, if a note on is late by more
+//                                    than 2ms, if a clock byte is delayed by
+//                                    more than 2 bytes, if no block is sent
+//                                    while the sequencer plays, or if a main
+//                                    loop pass takes more than 2ms
+
+#include "midialf/clock.h"
+#include "midialf/cv/cv.h"
+#include "midialf/cv/port.h"
+#include "midialf/event_scheduler.h"
+#include "midialf/midi_handler.h"
+#include "midialf/note_duration.h"
+#include "midialf/seq.h"
+#include "midialf/storage.h"
+#include "midialf/sysex_handler.h"
+#include "midialf/ui.h"
+
+#include "avrlib/time.h"
+
+#include "tools/host/host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace avrlib {
+
+uint8_t I2cBus::memory[65536];
+uint16_t I2cBus::pointer;
+double I2cBus::time;
+double I2cBus::byte_time;
+double I2cBus::write_cycle = 5000.0;
+double I2cBus::busy_until;
+uint32_t I2cBus::num_write_cycles;
+
+}  // namespace avrlib
+
+namespace midialf {
+
+// Stubs for the parts of the firmware the sequencer calls into.
+
+avrlib::EventQueue<32> Ui::queue_;
+
+int16_t Ui::Scale(int16_t, int16_t, int16_t, int16_t, int16_t x1max) {
+  return x1max;
+}
+
+uint8_t CV::glide_;
+
+void CV::SendMode(uint8_t, uint8_t) { }
+void CV::SendNote(uint8_t) { }
+void CV::SendPBnd(uint16_t) { }
+
+void Port::SetState(uint8_t, uint8_t) { }
+void Port::SetPulse(uint8_t) { }
+void Port::UpdateCvOffset() { }
+void Port::UpdateGateInvert() { }
+void Port::UpdateStrobeWidth() { }
+
+}  // namespace midialf
+
+using namespace avrlib;
+using namespace midialf;
+
+namespace {
+
+// Time is counted in CPU cycles.
+const uint32_t kCyclesPerUs = F_CPU / 1000000;
+const uint32_t kCyclesPerTimer1Count = 64;
+const uint32_t kCyclesPerOutputTick = 4080;  // TIMER2, 4.9kHz
+const uint32_t kCyclesPerByte = 320 * kCyclesPerUs;  // 10 bits at 31250 baud
+const uint32_t kCyclesPerMainLoopPass = 300 * kCyclesPerUs;
+const uint32_t kCyclesPerFloodMessage = 900 * kCyclesPerUs;
+const uint32_t kMaxDuration = 300;  // s
+const uint32_t kMaxWireBytes = 1 << 20;
+const uint16_t kMaxQueuedBytes = 256;
+
+const uint8_t kHeaderSize = 6;  // F0, manufacturer and product IDs
+const uint8_t kNumSlotPages = (kSlotCrcOffset + kSlotPageSize - 1) / kSlotPageSize;
+const uint8_t kAllSlotPages = (1 << kNumSlotPages) - 1;
+
+const double kMaxNoteOnLatency = 2.0;  // ms
+const uint32_t kMaxClockDelay = 2 * kCyclesPerByte;
+const double kMaxMainLoopPass = 2.0;  // ms
+
+struct Scenario {
+  const char* name;
+  uint8_t clock_rate;
+  bool playing;
+  double stop_time;  // s, 0 to play until the dump is done
+  double flood_time;  // s of MIDI thru traffic at line rate
+};
+
+const Scenario kScenarios[] = {
+  { "stopped", k16thNote, false, 0, 0 },
+  { "1/16 at 120 BPM, 20s", k16thNote, true, 20, 0 },
+  { "1/8 at 120 BPM", k8thNote, true, 0, 0 },
+  { "1/4 at 120 BPM", k4thNote, true, 0, 0 },
+  { "stopped, 5s CC flood", k16thNote, false, 0, 5 },
+};
+
+struct WireByte {
+  uint64_t time;
+  uint8_t byte;
+};
+
+WireByte wire[kMaxWireBytes];
+uint32_t num_wire_bytes;
+uint64_t uart_busy;  // End of the byte being sent
+
+// Time each byte of the MIDI output buffer was queued at.
+uint64_t queued[kMaxQueuedBytes];
+uint16_t queued_read;
+uint16_t queued_write;
+
+uint64_t now;
+uint16_t interval;
+
+struct Result {
+  double dump_time;  // s, from the request
+  double stop_time;
+  uint32_t num_blocks;
+  uint32_t num_blocks_while_playing;
+  uint32_t num_bad_blocks;
+  uint32_t num_cut_blocks;  // Ended by a status byte
+  uint32_t num_slots_received;
+  uint32_t num_note_ons;
+  uint32_t num_late_note_ons;
+  double max_note_on_latency;  // ms
+  double mean_note_on_latency;
+  uint64_t max_clock_delay;  // cycles
+  uint64_t max_main_loop_pass;
+};
+
+void Wire(uint8_t byte) {
+  uint64_t time = uart_busy > now ? uart_busy : now;
+  if (num_wire_bytes < kMaxWireBytes) {
+    wire[num_wire_bytes].time = time;
+    wire[num_wire_bytes].byte = byte;
+    ++num_wire_bytes;
+  }
+  uart_busy = time + kCyclesPerByte;
+}
+
+void NoteOnLatency(uint8_t byte, uint64_t queued_at, Result* r) {
+  if ((byte & 0xf0) != 0x90) {
+    return;
+  }
+  double latency = (now - queued_at) / (1000.0 * kCyclesPerUs);
+  ++r->num_note_ons;
+  r->mean_note_on_latency += latency;
+  if (latency > r->max_note_on_latency) {
+    r->max_note_on_latency = latency;
+  }
+  if (latency > kMaxNoteOnLatency) {
+    ++r->num_late_note_ons;
+  }
+}
+
+// Puts the bytes written to the UART by a call into the firmware on the wire,
+// and times the bytes it queued. Clock bytes are sent with SendNow(), and
+// Seq::FlushOutputBuffer() writes the oldest queued bytes when the buffer is
+// full.
+template<typename F>
+void Call(F f, Result* r) {
+  uint8_t before = MidiHandler::OutputBuffer::readable();
+  f();
+  uint8_t direct[64];
+  uint8_t num_direct = HostUartRead(0, direct, sizeof(direct));
+  uint8_t num_flushed = 0;
+  for (uint8_t i = 0; i < num_direct; ++i) {
+    uint8_t byte = direct[i];
+    if (byte >= 0xf8) {
+      uint64_t delay = uart_busy > now ? uart_busy - now : 0;
+      if (byte == 0xf8 && delay > r->max_clock_delay) {
+        r->max_clock_delay = delay;
+      }
+    } else {
+      NoteOnLatency(byte, queued[queued_read++ % kMaxQueuedBytes], r);
+      ++num_flushed;
+    }
+    Wire(byte);
+  }
+  uint8_t after = MidiHandler::OutputBuffer::readable();
+  for (uint8_t i = before - num_flushed; i < after; ++i) {
+    queued[queued_write++ % kMaxQueuedBytes] = now;
+  }
+}
+
+// See ISR(TIMER1_COMPA_vect) in midialf.cc.
+void Timer1Interrupt() {
+  timer0_milliseconds.value = static_cast<uint32_t>(now / (F_CPU / 1000));
+  interval = midialf::clock.Tick() + 1;
+  if (midialf::clock.running()) {
+    seq.OnInternalClockTick();
+    if (midialf::clock.stepped()) {
+      seq.OnInternalClockStep();
+    }
+  }
+}
+
+// See SendMidiOut() in midialf.cc.
+void SendMidiOut(Result* r) {
+  if (uart_busy > now + kCyclesPerByte) {
+    return;
+  }
+  uint8_t byte;
+  if (MidiHandler::OutputBuffer::readable() && !SysExHandler::block_open()) {
+    byte = MidiHandler::OutputBuffer::ImmediateRead();
+    NoteOnLatency(byte, queued[queued_read++ % kMaxQueuedBytes], r);
+  } else if (SysExHandler::OutputBuffer::readable()) {
+    if (SysExHandler::block_aborted()) {
+      SysExHandler::OutputBuffer::ImmediateRead();
+      return;
+    }
+    byte = SysExHandler::ReadOutput();
+  } else {
+    return;
+  }
+  Wire(byte);
+}
+
+void FloodMessage() {
+  Seq::Send3(0xb0, 1, 64);
+}
+
+void MainLoopPass() {
+  sysex_handler.Poll();
+}
+
+// Fills the memory with random contents, and names the slots.
+void Fill() {
+  srand(1);
+  for (uint32_t i = 0; i < sizeof(I2cBus::memory); ++i) {
+    I2cBus::memory[i] = rand();
+  }
+  for (uint16_t slot = 0; slot < kMaxNumSlots; ++slot) {
+    for (uint8_t i = 0; i < kNameLength; ++i) {
+      I2cBus::memory[slot * kSlotSize + i] = 'A' + (slot + i) % 26;
+    }
+  }
+}
+
+// Decodes a SYSEXCMD_PROGRAMPAGE block, slot index and raw page, and compares
+// it with the memory.
+bool CheckBlock(const uint8_t* block, uint16_t size, uint8_t* received) {
+  uint8_t page = block[kHeaderSize + 1];
+  if (block[kHeaderSize] != SYSEXCMD_PROGRAMPAGE || page >= kNumSlotPages) {
+    return false;
+  }
+  uint16_t offset = page * kSlotPageSize;
+  uint8_t page_size = kSlotCrcOffset - offset < kSlotPageSize ?
+      kSlotCrcOffset - offset : kSlotPageSize;
+  if (size != kHeaderSize + 2 + 2 * (1 + page_size + 1)) {
+    return false;
+  }
+  uint8_t data[1 + kSlotPageSize + 1];
+  uint8_t checksum = 0;
+  for (uint8_t i = 0; i <= 1 + page_size; ++i) {
+    data[i] = (block[kHeaderSize + 2 + 2 * i] << 4) |
+        block[kHeaderSize + 3 + 2 * i];
+    if (i <= page_size) {
+      checksum += data[i];
+    }
+  }
+  uint8_t slot = data[0];
+  if (checksum != data[1 + page_size] ||
+      memcmp(&data[1], &I2cBus::memory[slot * kSlotSize + offset],
+             page_size)) {
+    return false;
+  }
+  received[slot] |= 1 << page;
+  return true;
+}
+
+void CheckWire(uint64_t stop, Result* r) {
+  static uint8_t block[1024];
+  uint16_t size = 0;
+  bool open = false;
+  uint8_t received[kMaxNumSlots] = { 0 };
+  for (uint32_t i = 0; i < num_wire_bytes; ++i) {
+    uint8_t byte = wire[i].byte;
+    if (byte >= 0xf8) {
+      continue;
+    }
+    if (byte == 0xf0) {
+      open = true;
+      size = 0;
+      if (wire[i].time < stop) {
+        ++r->num_blocks_while_playing;
+      }
+    } else if (!open) {
+      continue;
+    } else if (byte == 0xf7) {
+      open = false;
+      ++r->num_blocks;
+      if (!CheckBlock(block, size, received)) {
+        ++r->num_bad_blocks;
+      }
+      continue;
+    } else if (byte & 0x80) {
+      // The receiver drops a block ended by any other status byte.
+      open = false;
+      ++r->num_cut_blocks;
+      continue;
+    }
+    if (size < sizeof(block)) {
+      block[size++] = byte;
+    }
+  }
+  if (open) {
+    ++r->num_bad_blocks;
+  }
+  for (uint16_t slot = 0; slot < kMaxNumSlots; ++slot) {
+    r->num_slots_received += received[slot] == kAllSlotPages;
+  }
+}
+
+Result Run(const Scenario& s) {
+  Result r;
+  memset(&r, 0, sizeof(r));
+  num_wire_bytes = 0;
+  uart_busy = 0;
+  queued_read = queued_write = 0;
+  interval = 1;
+  MidiHandler::OutputBuffer::Flush();
+  SysExHandler::OutputBuffer::Flush();
+
+  event_scheduler.Init();
+  seq.InitSeqInfo();
+  for (uint8_t n = 0; n < 4; ++n) {
+    seq.InitSeq(n);
+  }
+  seq.Init();
+  seq.set_bpm(120);
+  seq.set_clock_rate(s.clock_rate);
+  HostUartRead(0, NULL, 0);
+
+  uint64_t start = now;
+  uint64_t next_timer1 = now;
+  uint64_t next_output_tick = now;
+  uint64_t next_pass = now;
+  uint64_t next_flood = now;
+  uint64_t flood_end = now + static_cast<uint64_t>(s.flood_time * F_CPU);
+  uint64_t stop = s.playing ? (s.stop_time ?
+      now + static_cast<uint64_t>(s.stop_time * F_CPU) : ~0ULL) : now;
+  uint64_t end = now + static_cast<uint64_t>(kMaxDuration) * F_CPU;
+  uint64_t done = 0;
+
+  if (s.playing) {
+    Call(&Seq::Start, &r);
+  }
+  sysex_handler.SendAll();
+  while (now < end) {
+    uint64_t next = next_timer1;
+    if (next_output_tick < next) next = next_output_tick;
+    if (next_pass < next) next = next_pass;
+    if (next_flood < flood_end && next_flood < next) next = next_flood;
+    if (stop > now && stop < next) next = stop;
+    now = next;
+    timer0_milliseconds.value = static_cast<uint32_t>(now / (F_CPU / 1000));
+
+    if (now == stop && seq.running()) {
+      Call(&Seq::Stop, &r);
+    } else if (next_flood < flood_end && now == next_flood) {
+      Call(&FloodMessage, &r);
+      next_flood += kCyclesPerFloodMessage;
+    } else if (now == next_timer1) {
+      Call(&Timer1Interrupt, &r);
+      next_timer1 += interval * kCyclesPerTimer1Count;
+    } else if (now == next_output_tick) {
+      SendMidiOut(&r);
+      next_output_tick += kCyclesPerOutputTick;
+    } else {
+      double bus_time = I2cBus::time;
+      Call(&MainLoopPass, &r);
+      uint64_t pass = kCyclesPerMainLoopPass + static_cast<uint64_t>(
+          (I2cBus::time - bus_time) * kCyclesPerUs);
+      if (pass > r.max_main_loop_pass) {
+        r.max_main_loop_pass = pass;
+      }
+      next_pass += pass;
+      if (!done && !sysex_handler.sending() &&
+          !SysExHandler::OutputBuffer::readable()) {
+        done = now;
+        // Play on for a few steps.
+        end = now + F_CPU;
+      }
+    }
+  }
+  if (seq.running()) {
+    Call(&Seq::Stop, &r);
+  }
+  if (!done) {
+    sysex_handler.Cancel();
+    while (sysex_handler.sending()) {
+      sysex_handler.Poll();
+    }
+  }
+
+  r.dump_time = done ? static_cast<double>(done - start) / F_CPU : -1.0;
+  r.stop_time = s.stop_time;
+  if (r.num_note_ons) {
+    r.mean_note_on_latency /= r.num_note_ons;
+  }
+  CheckWire(s.stop_time ? stop : (s.playing ? end : start), &r);
+  return r;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: sysex_sim [--check]\n");
+    return 1;
+  }
+
+  Fill();
+  storage.Init();
+  printf("%u slots\n", storage.num_slots());
+  printf("%-22s %6s %6s %6s %4s %4s %6s %6s %5s %6s %6s\n", "", "dump",
+         "blocks", "slots", "bad", "cut", "notes", "late", "max", "clock",
+         "pass");
+
+  int failures = 0;
+  for (uint8_t i = 0; i < sizeof(kScenarios) / sizeof(kScenarios[0]); ++i) {
+    const Scenario& s = kScenarios[i];
+    Result r = Run(s);
+    printf("%-22s %6.1f %6u %6u %4u %4u %6u %6u %5.1f %6.2f %6.2f\n", s.name,
+           r.dump_time, r.num_blocks, r.num_slots_received, r.num_bad_blocks,
+           r.num_cut_blocks, r.num_note_ons, r.num_late_note_ons,
+           r.max_note_on_latency,
+           r.max_clock_delay / (1000.0 * kCyclesPerUs),
+           r.max_main_loop_pass / (1000.0 * kCyclesPerUs));
+    if (s.playing) {
+      printf("%-22s %u blocks started while playing\n", "",
+             r.num_blocks_while_playing);
+    }
+    if (r.dump_time < 0 || r.num_bad_blocks ||
+        r.num_slots_received != storage.num_slots() ||
+        r.num_late_note_ons || r.max_clock_delay > kMaxClockDelay ||
+        r.max_main_loop_pass > kMaxMainLoopPass * 1000 * kCyclesPerUs ||
+        (s.playing && !r.num_blocks_while_playing)) {
+      ++failures;
+    }
+  }
+  printf("dump in s, from the request. cut: blocks ended by another message, "
+         "sent again.\nlate: note ons more than %.0fms late, max: latest note "
+         "on in ms. clock: longest\ndelay of a clock byte, pass: longest main "
+         "loop pass, in ms.\n", kMaxNoteOnLatency);
+  return check && failures ? 1 : 0;
+}
@@ -0,0 +1,284 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Note off stress test of the track link mode.
+//
+// The real seq, clock, event scheduler and LFO code plays the 4 sequences as
+// tracks on a virtual Timer1, with random channels (tracks may share one),
+// directions, clock divisions, skips, and random gates, legato, ratchets,
+// delays and probabilities on every step. In some runs the link mode is
+// switched away from the tracks and back while notes are pending. After
+// Seq::Stop(), every note on sent must have been matched by a note off on its
+// channel: the all notes off controllers Stop() also sends do not count.
+//
+// The worst case tick cost of the track mode is measured by
+// seq_sim --benchmark.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile track_stress
+//   build/tools/track_stress [--runs n]
+
+#include "midialf/clock.h"
+#include "midialf/cv/cv.h"
+#include "midialf/cv/port.h"
+#include "midialf/event_scheduler.h"
+#include "midialf/lfo.h"
+#include "midialf/midi_handler.h"
+#include "midialf/note_duration.h"
+#include "midialf/seq.h"
+#include "midialf/storage.h"
+#include "midialf/sysex_handler.h"
+#include "midialf/ui.h"
+
+#include "avrlib/random.h"
+#include "avrlib/time.h"
+
+#include "tools/host/host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace midialf {
+
+// Stubs for the parts of the firmware the sequencer calls into.
+
+volatile uint8_t SysExHandler::block_open_;
+volatile uint8_t SysExHandler::block_aborted_;
+
+uint8_t Storage::ReadSeqData(uint8_t, SeqData*, uint8_t) { return 0; }
+uint8_t Storage::ReadSeqInfo(uint8_t, SeqInfo*) { return 0; }
+uint8_t Storage::WriteSeqData(uint8_t, const SeqData*, uint8_t) { return 0; }
+uint8_t Storage::WriteSeqInfo(uint8_t, const SeqInfo*) { return 0; }
+
+int16_t Ui::Scale(int16_t, int16_t, int16_t, int16_t, int16_t x1max) {
+  return x1max;
+}
+
+uint8_t CV::glide_;
+
+void CV::SendMode(uint8_t, uint8_t) { }
+void CV::SendNote(uint8_t) { }
+void CV::SendPBnd(uint16_t) { }
+
+void Port::SetState(uint8_t, uint8_t) { }
+void Port::SetPulse(uint8_t) { }
+void Port::UpdateCvOffset() { }
+void Port::UpdateGateInvert() { }
+void Port::UpdateStrobeWidth() { }
+
+}  // namespace midialf
+
+using namespace avrlib;
+using namespace midialf;
+
+namespace {
+
+const uint32_t kTimerCountsPerMs = F_CPU / 64 / 1000;
+const uint8_t kNumSeqs = 4;
+const uint16_t kMinRunSteps = 32;
+const uint16_t kMaxRunSteps = 256;
+
+// Notes sounding, per channel and note.
+uint8_t sounding[16][128];
+uint32_t num_note_ons;
+uint32_t num_note_offs;
+uint32_t num_orphan_note_offs;
+
+// MIDI output decoder.
+uint8_t running_status;
+uint8_t message[3];
+uint8_t message_size;
+
+void OnMessage() {
+  uint8_t channel = message[0] & 0x0f;
+  uint8_t type = message[0] & 0xf0;
+  if (type == 0x90 && message[2]) {
+    ++sounding[channel][message[1]];
+    ++num_note_ons;
+  } else if (type == 0x80 || type == 0x90) {
+    if (sounding[channel][message[1]]) {
+      --sounding[channel][message[1]];
+    } else {
+      ++num_orphan_note_offs;
+    }
+    ++num_note_offs;
+  }
+}
+
+void Parse(uint8_t byte) {
+  if (byte >= 0xf8) {
+    return;
+  }
+  if (byte & 0x80) {
+    running_status = byte < 0xf0 ? byte : 0;
+    message_size = 0;
+    return;
+  }
+  if (!running_status) {
+    return;
+  }
+  if (!message_size) {
+    message[message_size++] = running_status;
+  }
+  message[message_size++] = byte;
+  uint8_t size = (running_status & 0xe0) == 0xc0 ? 2 : 3;
+  if (message_size == size) {
+    OnMessage();
+    message_size = 0;
+  }
+}
+
+// Runs firmware code, then parses what it wrote directly to the UART, which
+// comes first, and the output buffer.
+template<typename F>
+void RunFirmware(F f) {
+  f();
+  uint8_t data[256];
+  uint16_t size;
+  while ((size = HostUartRead(0, data, sizeof(data))) != 0) {
+    for (uint16_t i = 0; i < size; ++i) {
+      Parse(data[i]);
+    }
+  }
+  while (MidiHandler::OutputBuffer::readable()) {
+    Parse(MidiHandler::OutputBuffer::ImmediateRead());
+  }
+}
+
+// See ISR(TIMER1_COMPA_vect) in midialf.cc.
+uint32_t now;  // Timer1 counts
+uint16_t interval;
+
+void Timer1Interrupt() {
+  timer0_milliseconds.value = now / kTimerCountsPerMs;
+  interval = midialf::clock.Tick() + 1;
+  if (midialf::clock.running()) {
+    seq.OnInternalClockTick();
+    if (midialf::clock.stepped()) {
+      seq.OnInternalClockStep();
+    }
+  }
+}
+
+void Start() { seq.Start(); }
+void Stop() { seq.Stop(); }
+void LinkSequences() { seq.set_link_mode(LINK_MODE_16); }
+void LinkTracks() { seq.set_link_mode(LINK_MODE_TRACKS); }
+
+void RunTicks(uint32_t num_ticks) {
+  while (num_ticks--) {
+    RunFirmware(&Timer1Interrupt);
+    now += interval;
+  }
+}
+
+void Reset() {
+  now = 0;
+  interval = 1;
+  memset(sounding, 0, sizeof(sounding));
+  running_status = 0;
+  message_size = 0;
+  timer0_milliseconds.value = 0;
+
+  event_scheduler.Init();
+  seq.set_slot(0);
+  seq.InitSeqInfo();
+  for (uint8_t s = 0; s < kNumSeqs; ++s) {
+    seq.InitSeq(s);
+  }
+  seq.Init();
+
+  uint8_t data[256];
+  while (HostUartRead(0, data, sizeof(data))) { }
+  MidiHandler::OutputBuffer::Flush();
+}
+
+void Randomize() {
+  seq.set_bpm(40 + rand() % 211);
+  seq.set_clock_rate(k16thNote);
+  seq.set_link_mode(LINK_MODE_TRACKS);
+  for (uint8_t s = 0; s < kNumSeqs; ++s) {
+    seq.set_track_channel(s, rand() % 6);
+    seq.set_track_direction(s, rand() % 4);
+    seq.set_track_clock_division(s, rand() % 3);
+    for (uint8_t step = 0; step < kNumSteps; ++step) {
+      seq.set_note(s, step, 36 + rand() % 24);
+      seq.set_velo(s, step, rand() % 8 ? 1 + rand() % 127 : 0);
+      seq.set_gate(s, step, rand() % 32);
+      seq.set_skip(s, step, rand() % 6 == 0);
+      seq.set_mute(s, step, rand() % 10 == 0);
+      seq.set_lega(s, step, rand() % 4 == 0);
+      seq.set_prob(s, step, rand() % 4 ? 0 : rand() % 8);
+      seq.set_ratchets(s, step, rand() % 3 ? 1 : 1 + rand() % 4);
+      seq.set_delay(s, step, rand() % 3 ? 0 : rand() % 12);
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t num_runs = 2000;
+  if (argc == 3 && !strcmp(argv[1], "--runs")) {
+    num_runs = atoi(argv[2]);
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: track_stress [--runs n]\n");
+    return 1;
+  }
+
+  uint32_t failures = 0;
+  for (uint32_t run = 0; run < num_runs; ++run) {
+    srand(run);
+    Random::Seed(run + 1);
+    Reset();
+    Randomize();
+    uint32_t num_ticks = (kMinRunSteps +
+        rand() % (kMaxRunSteps - kMinRunSteps)) * kNumTicksPerStep;
+    RunFirmware(&Start);
+    if (run & 1) {
+      RunTicks(num_ticks);
+    } else {
+      // Switch the link mode while notes are pending.
+      RunTicks(num_ticks / 3 + rand() % kNumTicksPerStep);
+      RunFirmware(&LinkSequences);
+      RunTicks(num_ticks / 3);
+      RunFirmware(&LinkTracks);
+      RunTicks(num_ticks / 3 + rand() % kNumTicksPerStep);
+    }
+    RunFirmware(&Stop);
+    uint16_t stuck = 0;
+    for (uint8_t channel = 0; channel < 16; ++channel) {
+      for (uint8_t note = 0; note < 128; ++note) {
+        if (sounding[channel][note]) {
+          if (!stuck) {
+            printf("run %u: channel %d note %d stuck\n",
+                   run, channel + 1, note);
+          }
+          stuck += sounding[channel][note];
+        }
+      }
+    }
+    if (stuck) {
+      ++failures;
+    }
+  }
+  printf("%u runs, %u note ons, %u note offs (%u without note on): "
+         "%u with stuck notes\n", num_runs, num_note_ons, num_note_offs,
+         num_orphan_note_offs, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,489 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Timing of the step trigger attributes, and load of the event scheduler.
+//
+// The real sequencer and event scheduler are ticked as the Timer1 compare
+// ISR does, at 120 BPM, and the MIDI output is collected after each tick.
+//
+//   timing   every ratchet count (1 to 4) with every delay (0 to 3 ticks), at
+//            1/16, 1/8 and 1/4 notes: the tick of each note on against the
+//            step, delayed and split evenly, and its error in ms against the
+//            exact fraction of the step. Each ratchet must be released
+//            before the next one starts.
+//   prob     the share of the steps played at each of the 8 probability
+//            levels, over 2000 steps.
+//   load     4 tracks stepping on the same ticks, each step with 4 ratchets
+//            3 ticks late and a gate of the whole step: the largest number of
+//            scheduler entries in use and of messages sent in a tick, and
+//            the steps played with fewer ratchets because the scheduler was
+//            nearly full. No note may be cut short by a note off sent
+//            early for lack of room.
+//
+// After each run, the sequencer is stopped and every note on must have had
+// its note off.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile trig_sim
+//   build/tools/trig_sim            prints the results
+//   build/tools/trig_sim --check    exits with an error if a note on is not
+//                                   on its tick, if a ratchet is not released
+//                                   before the next one, if a note is left
+//                                   hanging, if a probability level is off by
+//                                   more than 4 standard deviations, or if
+//                                   the scheduler loses a step or a note off
+
+#include "midialf/clock.h"
+#include "midialf/cv/cv.h"
+#include "midialf/cv/port.h"
+#include "midialf/event_scheduler.h"
+#include "midialf/midi_handler.h"
+#include "midialf/note_duration.h"
+#include "midialf/seq.h"
+#include "midialf/storage.h"
+#include "midialf/sysex_handler.h"
+#include "midialf/ui.h"
+
+#include "avrlib/random.h"
+#include "avrlib/time.h"
+
+#include "tools/host/host.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace midialf {
+
+// Stubs for the parts of the firmware the sequencer calls into.
+
+volatile uint8_t SysExHandler::block_open_;
+volatile uint8_t SysExHandler::block_aborted_;
+
+uint8_t Storage::ReadSeqData(uint8_t, SeqData*, uint8_t) { return 0; }
+uint8_t Storage::ReadSeqInfo(uint8_t, SeqInfo*) { return 0; }
+uint8_t Storage::WriteSeqData(uint8_t, const SeqData*, uint8_t) { return 0; }
+uint8_t Storage::WriteSeqInfo(uint8_t, const SeqInfo*) { return 0; }
+
+int16_t Ui::Scale(int16_t, int16_t, int16_t, int16_t, int16_t x1max) {
+  return x1max;
+}
+
+uint8_t CV::glide_;
+
+void CV::SendMode(uint8_t, uint8_t) { }
+void CV::SendNote(uint8_t) { }
+void CV::SendPBnd(uint16_t) { }
+
+void Port::SetState(uint8_t, uint8_t) { }
+void Port::SetPulse(uint8_t) { }
+void Port::UpdateCvOffset() { }
+void Port::UpdateGateInvert() { }
+void Port::UpdateStrobeWidth() { }
+
+}  // namespace midialf
+
+using namespace avrlib;
+using namespace midialf;
+
+namespace {
+
+const uint8_t kNumSeqs = 4;
+const uint8_t kBaseNote = 48;
+const double kTickDuration = 60000.0 / 120 / 24;  // ms
+const uint32_t kMaxMessages = 65536;
+const uint16_t kNumProbSteps = 2000;
+const uint32_t kNumLoadSteps = 64;
+
+struct Message {
+  uint32_t tick;
+  uint8_t status;
+  uint8_t note;
+  uint8_t velocity;
+};
+
+Message messages[kMaxMessages];
+uint32_t num_messages;
+uint8_t message[3];
+uint8_t message_size;
+
+// Tick each step started on.
+uint32_t step_starts[kMaxMessages];
+uint8_t step_numbers[kMaxMessages];
+uint32_t num_steps;
+
+uint32_t tick;
+uint8_t max_scheduler_size;
+uint8_t max_messages_per_tick;
+
+void MidiByte(uint8_t byte) {
+  if (byte >= 0xf8) {
+    return;
+  }
+  if (byte & 0x80) {
+    message_size = 0;
+  }
+  message[message_size++] = byte;
+  if (message_size == 3) {
+    message_size = 0;
+    if (num_messages < kMaxMessages) {
+      Message* m = &messages[num_messages++];
+      m->tick = tick;
+      m->status = message[0];
+      m->note = message[1];
+      m->velocity = message[2];
+    }
+  }
+}
+
+void CollectMidiOutput() {
+  uint8_t data[256];
+  uint16_t size;
+  while ((size = HostUartRead(0, data, sizeof(data))) != 0) {
+    for (uint16_t i = 0; i < size; ++i) {
+      MidiByte(data[i]);
+    }
+  }
+  while (MidiHandler::OutputBuffer::readable()) {
+    MidiByte(MidiHandler::OutputBuffer::ImmediateRead());
+  }
+}
+
+// See ISR(TIMER1_COMPA_vect) in midialf.cc.
+void Timer1Interrupt() {
+  midialf::clock.Tick();
+  if (midialf::clock.running()) {
+    seq.OnInternalClockTick();
+    if (midialf::clock.stepped()) {
+      seq.OnInternalClockStep();
+    }
+  }
+}
+
+void Run(uint32_t num_ticks) {
+  uint8_t step = seq.step();
+  while (num_ticks--) {
+    uint32_t before = num_messages;
+    Timer1Interrupt();
+    CollectMidiOutput();
+    if (seq.running() && (seq.step() != step || !num_steps)) {
+      step = seq.step();
+      step_starts[num_steps] = tick;
+      step_numbers[num_steps] = step;
+      ++num_steps;
+    }
+    if (event_scheduler.size() > max_scheduler_size) {
+      max_scheduler_size = event_scheduler.size();
+    }
+    if (num_messages - before > max_messages_per_tick) {
+      max_messages_per_tick = num_messages - before;
+    }
+    ++tick;
+  }
+}
+
+void Reset(uint8_t clock_rate) {
+  num_messages = 0;
+  message_size = 0;
+  num_steps = 0;
+  tick = 0;
+  max_scheduler_size = 0;
+  max_messages_per_tick = 0;
+  Random::Seed(1);
+
+  event_scheduler.Init();
+  seq.set_slot(0);
+  seq.InitSeqInfo();
+  for (uint8_t s = 0; s < kNumSeqs; ++s) {
+    seq.InitSeq(s);
+    for (uint8_t step = 0; step < kNumSteps; ++step) {
+      seq.set_note(s, step, kBaseNote + step);
+      seq.set_velo(s, step, 100);
+    }
+  }
+  seq.Init();
+  seq.set_bpm(120);
+  seq.set_clock_rate(clock_rate);
+  CollectMidiOutput();
+  num_messages = 0;
+}
+
+// Plays the given number of steps, then stops and waits for the note offs.
+void Play(uint32_t step_ticks, uint32_t num_steps_to_play) {
+  seq.Start();
+  CollectMidiOutput();
+  Run(step_ticks * num_steps_to_play);
+  seq.Stop();
+  CollectMidiOutput();
+  Run(step_ticks * 4);
+}
+
+bool IsNoteOn(const Message& m) {
+  return (m.status & 0xf0) == 0x90 && m.velocity;
+}
+
+bool IsNoteOff(const Message& m) {
+  return (m.status & 0xf0) == 0x80 ||
+      ((m.status & 0xf0) == 0x90 && !m.velocity);
+}
+
+// Counts the note ons played over a sounding note, and the notes left
+// sounding.
+void CheckNoteOffs(uint32_t* num_overlaps, uint32_t* num_hanging) {
+  static uint8_t sounding[16][128];
+  memset(sounding, 0, sizeof(sounding));
+  for (uint32_t i = 0; i < num_messages; ++i) {
+    const Message& m = messages[i];
+    uint8_t* s = &sounding[m.status & 0x0f][m.note];
+    if (IsNoteOn(m)) {
+      if (*s) {
+        ++*num_overlaps;
+      }
+      *s = 1;
+    } else if (IsNoteOff(m)) {
+      *s = 0;
+    }
+  }
+  for (uint8_t c = 0; c < 16; ++c) {
+    for (uint8_t n = 0; n < 128; ++n) {
+      *num_hanging += sounding[c][n];
+    }
+  }
+}
+
+struct TimingResult {
+  uint32_t num_steps;
+  uint32_t num_note_ons;
+  uint32_t num_misplaced;  // Note ons missing, extra or on another tick
+  double max_error;  // ms, against the exact fraction of the step
+  uint32_t num_overlaps;
+  uint32_t num_hanging;
+};
+
+// Steps 0-7 get the ratchets and delays first + 0 to first + 7 of the 16
+// combinations.
+TimingResult Timing(uint8_t clock_rate, uint8_t first) {
+  TimingResult r;
+  memset(&r, 0, sizeof(r));
+  Reset(clock_rate);
+  for (uint8_t step = 0; step < kNumSteps; ++step) {
+    uint8_t combination = first + step;
+    seq.set_ratchets(0, step, 1 + (combination & 3));
+    seq.set_delay(0, step, combination >> 2);
+    seq.set_gate(0, step, clock_rate);
+  }
+  uint8_t step_ticks = NoteDuration::GetMidiClockTicks(clock_rate);
+  Play(step_ticks, 4 * kNumSteps);
+
+  for (uint32_t s = 0; s < num_steps; ++s) {
+    uint8_t step = step_numbers[s];
+    uint32_t start = step_starts[s];
+    uint8_t ratchets = seq.ratchets(0, step);
+    uint8_t delay = seq.delay(0, step);
+    ++r.num_steps;
+
+    // Expected ticks, the ratchets landing on the same tick are merged.
+    uint32_t expected[kMaxRatchets];
+    uint8_t num_expected = 0;
+    for (uint8_t n = 0; n < ratchets; ++n) {
+      uint32_t t = start + delay + step_ticks * n / ratchets;
+      if (!num_expected || expected[num_expected - 1] != t) {
+        expected[num_expected++] = t;
+      }
+      double exact = delay + static_cast<double>(step_ticks) * n / ratchets;
+      double error = fabs(t - start - exact) * kTickDuration;
+      if (error > r.max_error) {
+        r.max_error = error;
+      }
+    }
+
+    // Note ons of the step, before the next start of the same step.
+    uint32_t end = start + step_ticks * kNumSteps;
+    uint8_t num_found = 0;
+    for (uint32_t i = 0; i < num_messages; ++i) {
+      const Message& m = messages[i];
+      if (!IsNoteOn(m) || m.note != kBaseNote + step || m.tick < start ||
+          m.tick >= end) {
+        continue;
+      }
+      ++r.num_note_ons;
+      if (num_found >= num_expected || m.tick != expected[num_found]) {
+        ++r.num_misplaced;
+      }
+      ++num_found;
+    }
+    if (num_found < num_expected) {
+      // The last steps are cut by the stop.
+      if (start + delay + step_ticks <= step_starts[num_steps - 1]) {
+        r.num_misplaced += num_expected - num_found;
+      }
+    }
+  }
+  CheckNoteOffs(&r.num_overlaps, &r.num_hanging);
+  return r;
+}
+
+// Share of the steps played at the given probability level.
+double Probability(uint8_t level, uint32_t* num_hanging) {
+  Reset(k16thNote);
+  for (uint8_t step = 0; step < kNumSteps; ++step) {
+    seq.set_prob(0, step, level);
+  }
+  uint8_t step_ticks = NoteDuration::GetMidiClockTicks(k16thNote);
+  Play(step_ticks, kNumProbSteps);
+  uint32_t num_note_ons = 0;
+  for (uint32_t i = 0; i < num_messages; ++i) {
+    num_note_ons += IsNoteOn(messages[i]);
+  }
+  uint32_t num_overlaps = 0;
+  CheckNoteOffs(&num_overlaps, num_hanging);
+  return static_cast<double>(num_note_ons) / kNumProbSteps;
+}
+
+struct LoadResult {
+  uint32_t num_steps;
+  uint32_t num_note_ons;
+  uint32_t num_degraded;  // Steps played with fewer ratchets
+  uint32_t num_short;  // Note offs sent with their note on
+  uint32_t num_overlaps;
+  uint32_t num_hanging;
+};
+
+LoadResult Load() {
+  LoadResult r;
+  memset(&r, 0, sizeof(r));
+  Reset(k16thNote);
+  seq.set_link_mode(LINK_MODE_TRACKS);
+  for (uint8_t track = 0; track < kNumSeqs; ++track) {
+    seq.set_track_channel(track, track);
+    seq.set_track_clock_division(track, CLOCK_DIVISION_NONE);
+    for (uint8_t step = 0; step < kNumSteps; ++step) {
+      seq.set_ratchets(track, step, kMaxRatchets);
+      seq.set_delay(track, step, 3);
+      seq.set_gate(track, step, k16thNote);
+    }
+  }
+  uint8_t step_ticks = NoteDuration::GetMidiClockTicks(k16thNote);
+  Play(step_ticks, kNumLoadSteps);
+
+  // Note ons per track and step, counted from their channel and note.
+  static uint8_t played[kNumSeqs][kNumLoadSteps + 2][kNumSteps];
+  memset(played, 0, sizeof(played));
+  for (uint32_t i = 0; i < num_messages; ++i) {
+    const Message& m = messages[i];
+    if (!IsNoteOn(m)) {
+      continue;
+    }
+    ++r.num_note_ons;
+    uint32_t step_index = (m.tick - 3) / step_ticks;
+    if (step_index < kNumLoadSteps + 2) {
+      ++played[m.status & 0x03][step_index][m.note - kBaseNote];
+    }
+    // A note off on the same tick, sent as the scheduler was full
+    for (uint32_t j = i + 1; j < num_messages && messages[j].tick == m.tick;
+         ++j) {
+      if (IsNoteOff(messages[j]) && messages[j].note == m.note &&
+          messages[j].status == (0x80 | (m.status & 0x0f))) {
+        ++r.num_short;
+        break;
+      }
+    }
+  }
+  for (uint8_t track = 0; track < kNumSeqs; ++track) {
+    for (uint32_t s = 0; s < kNumLoadSteps; ++s) {
+      for (uint8_t step = 0; step < kNumSteps; ++step) {
+        if (played[track][s][step]) {
+          ++r.num_steps;
+          if (played[track][s][step] < kMaxRatchets) {
+            ++r.num_degraded;
+          }
+        }
+      }
+    }
+  }
+  CheckNoteOffs(&r.num_overlaps, &r.num_hanging);
+  return r;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: trig_sim [--check]\n");
+    return 1;
+  }
+  int failures = 0;
+
+  static const uint8_t kRates[] = { k16thNote, k8thNote, k4thNote };
+  static const char* const kRateNames[] = { "1/16", "1/8", "1/4" };
+  printf("timing, 120 BPM:\n");
+  printf("  %4s %6s %6s %10s %10s %8s %8s\n", "", "steps", "notes",
+         "misplaced", "max error", "overlaps", "hanging");
+  for (uint8_t i = 0; i < sizeof(kRates); ++i) {
+    TimingResult total;
+    memset(&total, 0, sizeof(total));
+    for (uint8_t first = 0; first < 16; first += kNumSteps) {
+      TimingResult r = Timing(kRates[i], first);
+      total.num_steps += r.num_steps;
+      total.num_note_ons += r.num_note_ons;
+      total.num_misplaced += r.num_misplaced;
+      total.num_overlaps += r.num_overlaps;
+      total.num_hanging += r.num_hanging;
+      if (r.max_error > total.max_error) {
+        total.max_error = r.max_error;
+      }
+    }
+    printf("  %4s %6u %6u %10u %8.1fms %8u %8u\n", kRateNames[i],
+           total.num_steps, total.num_note_ons, total.num_misplaced,
+           total.max_error, total.num_overlaps, total.num_hanging);
+    if (!total.num_note_ons || total.num_misplaced || total.num_overlaps ||
+        total.num_hanging || total.max_error > kTickDuration / 2 + 1e-6) {
+      ++failures;
+    }
+  }
+
+  printf("probability, share of %u steps played:\n ", kNumProbSteps);
+  for (uint8_t level = 0; level < 8; ++level) {
+    uint32_t num_hanging = 0;
+    double share = Probability(level, &num_hanging);
+    double expected = (8 - level) / 8.0;
+    double sigma = sqrt(expected * (1.0 - expected) / kNumProbSteps);
+    printf(" %.3f/%.3f", share, expected);
+    if (fabs(share - expected) > 4.0 * sigma + 1e-6 || num_hanging) {
+      ++failures;
+    }
+  }
+  printf("\n");
+
+  LoadResult load = Load();
+  printf("load, 4 tracks of 4 ratchets 3 ticks late:\n");
+  printf("  %u steps, %u note ons, %u steps with fewer ratchets, %u short "
+         "notes\n", load.num_steps, load.num_note_ons, load.num_degraded,
+         load.num_short);
+  printf("  scheduler entries: %u of %u, messages per tick: %u\n",
+         max_scheduler_size, kEventSchedulerSize - 1, max_messages_per_tick);
+  printf("  %u overlaps, %u hanging\n", load.num_overlaps, load.num_hanging);
+  if (load.num_steps != kNumSeqs * kNumLoadSteps || load.num_short ||
+      load.num_overlaps || load.num_hanging ||
+      max_scheduler_size >= kEventSchedulerSize) {
+    ++failures;
+  }
+  return check && failures ? 1 : 0;
+}
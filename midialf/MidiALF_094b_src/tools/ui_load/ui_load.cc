@@ -0,0 +1,378 @@
+// Copyright 2026 agent.
+//
+// Author: agent (agent@local)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Load and correctness of the change driven UI refresh.
+//
+// The sequencer plays at 120 BPM on the Timer1 model, and the main loop runs
+// Ui::DoEvents every 100us. A scripted user turns encoders, switches pages
+// and sequences, starts and stops the sequencer, and toggles recording and
+// the manual step, about twice a second.
+//
+//   stale   after each pass, the leds and the screen buffer are compared with
+//           those given by a full refresh of the page. A difference is a
+//           refresh the change flags missed.
+//   load    the screen and page led refreshes, and the host time of a pass
+//           less that of a pass which refreshes nothing, against the former
+//           DoEvents, which refreshed all the leds on every pass and redrew
+//           the screen on events and sequence switches.
+//
+// Build and run, from the source root:
+//   make -f tools/makefile ui_load
+//   build/tools/ui_load            prints the results
+//   build/tools/ui_load --check    exits with an error if a pass leaves stale
+//                                  leds or a stale screen, or if the page
+//                                  leds are refreshed as often or the screen
+//                                  more often than with the former DoEvents
+
+// The tool runs the private refresh functions of the Ui class, and peeks at
+// the change flags of the sequencer.
+#define private public
+#include "midialf/seq.h"
+#include "midialf/ui.h"
+#undef private
+
+#include "midialf/clock.h"
+#include "midialf/display.h"
+#include "midialf/event_scheduler.h"
+#include "midialf/leds.h"
+#include "midialf/midi_handler.h"
+#include "midialf/note_duration.h"
+
+#include "avrlib/time.h"
+
+#include "tools/host/host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+using namespace avrlib;
+using namespace midialf;
+
+namespace {
+
+// Time is counted in CPU cycles.
+const uint32_t kCyclesPerTimer1Count = 64;
+const uint32_t kCyclesPerPass = F_CPU / 10000;
+const uint32_t kCyclesPerAction = F_CPU / 20;
+const uint32_t kDuration = 60;  // s
+const uint8_t kNumLeds = 16;
+const uint8_t kScreenSize = kLcdWidth * kLcdHeight;
+const uint8_t kNumTimedRuns = 5;  // The fastest is kept.
+
+enum Mode {
+  MODE_VERIFY,
+  MODE_CURRENT,
+  MODE_FORMER,
+  MODE_BASELINE,  // Events and changes are dropped, nothing is refreshed.
+};
+
+struct Result {
+  uint32_t num_passes;
+  uint32_t num_changed_passes;  // The sequencer raised a change flag
+  uint32_t num_actions;
+  uint32_t num_stale_leds;
+  uint32_t num_stale_screens;
+  uint32_t num_screen_updates;
+  uint32_t num_led_updates;
+  double elapsed;  // ns
+};
+
+uint64_t now;
+uint16_t interval;
+
+double Min(double a, double b) {
+  return a < b ? a : b;
+}
+
+// The page handlers, which are copied to RAM by Ui::ShowPage, are wrapped to
+// count the refreshes.
+void (*page_update_screen)();
+void (*page_update_leds)();
+uint32_t num_screen_updates;
+uint32_t num_led_updates;
+
+void CountedUpdateScreen() {
+  ++num_screen_updates;
+  (*page_update_screen)();
+}
+
+void CountedUpdateLeds() {
+  ++num_led_updates;
+  (*page_update_leds)();
+}
+
+void WrapPageHandlers() {
+  if (Ui::event_handlers_.UpdateScreen != &CountedUpdateScreen) {
+    page_update_screen = Ui::event_handlers_.UpdateScreen;
+    Ui::event_handlers_.UpdateScreen = &CountedUpdateScreen;
+  }
+  if (Ui::event_handlers_.UpdateLeds != &CountedUpdateLeds) {
+    page_update_leds = Ui::event_handlers_.UpdateLeds;
+    Ui::event_handlers_.UpdateLeds = &CountedUpdateLeds;
+  }
+}
+
+
+void DrainOutput() {
+  uint8_t data[256];
+  while (HostUartRead(0, data, sizeof(data))) { }
+  MidiHandler::OutputBuffer::Flush();
+}
+
+// See ISR(TIMER1_COMPA_vect) in midialf.cc.
+void Timer1Interrupt() {
+  interval = midialf::clock.Tick() + 1;
+  if (midialf::clock.running()) {
+    seq.OnInternalClockTick();
+    if (midialf::clock.stepped()) {
+      seq.OnInternalClockStep();
+    }
+  }
+  DrainOutput();
+}
+
+// Ui::DoEvents before the change flags: all the leds were refreshed on every
+// pass, and the screen on events and on the refresh requests the sequencer
+// posted when it switched sequences.
+void FormerDoEvents() {
+  display.Tick();
+
+  uint8_t redraw = 0;
+  while (Ui::queue_.available()) {
+    Event e = Ui::queue_.PullEvent();
+    Ui::queue_.Touch();
+    Ui::HandleEvent(e);
+    Ui::save_state_ = 1;
+    redraw = 1;
+  }
+
+  if (Ui::queue_.idle_time_ms() > 1000) {
+    Ui::queue_.Touch();
+    if ((*Ui::event_handlers_.OnIdle)()) {
+      redraw = 1;
+    }
+  }
+
+  if (seq.TakeChanges() & SEQ_CHANGE_SEQ) {
+    redraw = 1;
+  }
+
+  if (redraw) {
+    display.Clear();
+    (*Ui::event_handlers_.UpdateScreen)();
+  }
+
+  Ui::UpdateSideLeds();
+  Ui::UpdateStepLeds();
+  (*Ui::event_handlers_.UpdateLeds)();
+}
+
+void Snapshot(uint8_t* pixels, char* screen) {
+  for (uint8_t n = 0; n < kNumLeds; ++n) {
+    pixels[n] = leds.pixel(n);
+  }
+  for (uint8_t line = 0; line < kLcdHeight; ++line) {
+    memcpy(screen + line * kLcdWidth, display.line_buffer(line), kLcdWidth);
+  }
+}
+
+// Compares the state left by the pass with a full refresh, which leaves the
+// state right for the next pass.
+void Verify(Result* r) {
+  uint8_t pixels[kNumLeds];
+  char screen[kScreenSize];
+  Snapshot(pixels, screen);
+
+  // The refresh must not raise changes for the next pass.
+  uint8_t changes = Seq::changes_;
+  display.Clear();
+  (*page_update_screen)();
+  Ui::UpdateSideLeds();
+  Ui::UpdateStepLeds();
+  (*page_update_leds)();
+  Seq::changes_ = changes;
+
+  uint8_t expected_pixels[kNumLeds];
+  char expected_screen[kScreenSize];
+  Snapshot(expected_pixels, expected_screen);
+  if (memcmp(pixels, expected_pixels, kNumLeds)) {
+    if (!r->num_stale_leds) {
+      printf("first stale leds: page %d at %.3fs\n", Ui::active_page(),
+             now / static_cast<double>(F_CPU));
+    }
+    ++r->num_stale_leds;
+  }
+  if (memcmp(screen, expected_screen, kScreenSize)) {
+    if (!r->num_stale_screens) {
+      printf("first stale screen: page %d at %.3fs\n", Ui::active_page(),
+             now / static_cast<double>(F_CPU));
+    }
+    ++r->num_stale_screens;
+  }
+}
+
+// A user action, as the switch and encoder handlers would perform it.
+void Act(Result* r) {
+  if (rand() % 10) {
+    return;
+  }
+  ++r->num_actions;
+  switch (rand() % 8) {
+    case 0:
+    case 1:
+    case 2:
+      Ui::queue_.AddIncrement(CONTROL_ENCODER, ENCODER_1 + rand() % 8,
+                              rand() % 2 ? 1 : -1);
+      break;
+    case 3:
+      Ui::ShowPage(static_cast<UiPageIndex>(
+          (Ui::active_page() + 1) % (LAST_PAGE + 1)));
+      break;
+    case 4:
+      seq.SetSeq(rand() % 4);
+      break;
+    case 5:
+      seq.ToggleRun();
+      break;
+    case 6:
+      seq.ToggleRecording();
+      break;
+    case 7:
+      seq.set_manual_step_selected(!seq.manual_step_selected());
+      break;
+  }
+  // The settings are not saved to the EEPROM.
+  Ui::save_state_ = 0;
+}
+
+Result Run(Mode mode) {
+  Result r;
+  memset(&r, 0, sizeof(r));
+  srand(1234);
+
+  now = 0;
+  interval = 1;
+  num_screen_updates = 0;
+  num_led_updates = 0;
+  timer0_milliseconds.value = 0;
+  event_scheduler.Init();
+  seq.set_slot(0);
+  seq.InitSeqInfo();
+  for (uint8_t s = 0; s < 4; ++s) {
+    seq.InitSeq(s);
+  }
+  seq.Init();
+  seq.set_bpm(120);
+  seq.set_clock_rate(k16thNote);
+  seq.set_seq_switch_mode(1);
+  Ui::ShowPage(PAGE_NOTE);
+  Ui::queue_.Flush();
+  seq.Start();
+  DrainOutput();
+
+  uint64_t next_timer1 = 0;
+  uint64_t next_action = kCyclesPerAction;
+  uint64_t end = static_cast<uint64_t>(kDuration) * F_CPU;
+  struct timespec start, stop;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (now = 0; now < end; now += kCyclesPerPass) {
+    while (next_timer1 <= now) {
+      Timer1Interrupt();
+      next_timer1 += interval * kCyclesPerTimer1Count;
+    }
+    timer0_milliseconds.value = static_cast<uint32_t>(now / (F_CPU / 1000));
+    if (now >= next_action) {
+      Act(&r);
+      next_action += kCyclesPerAction;
+    }
+    if (Seq::changes_) {
+      ++r.num_changed_passes;
+    }
+    WrapPageHandlers();
+
+    if (mode == MODE_FORMER) {
+      FormerDoEvents();
+    } else if (mode == MODE_BASELINE) {
+      Ui::queue_.Flush();
+      seq.TakeChanges();
+    } else {
+      Ui::DoEvents();
+    }
+    ++r.num_passes;
+
+    if (mode == MODE_VERIFY) {
+      Verify(&r);
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  r.elapsed = (stop.tv_sec - start.tv_sec) * 1e9 +
+      (stop.tv_nsec - start.tv_nsec);
+  seq.Stop();
+  DrainOutput();
+  r.num_screen_updates = num_screen_updates;
+  r.num_led_updates = num_led_updates;
+  return r;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool check = false;
+  if (argc == 2 && !strcmp(argv[1], "--check")) {
+    check = true;
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: ui_load [--check]\n");
+    return 1;
+  }
+
+  Result verified = Run(MODE_VERIFY);
+  Result current = Run(MODE_CURRENT);
+  Result former = Run(MODE_FORMER);
+  Result baseline = Run(MODE_BASELINE);
+  for (uint8_t i = 1; i < kNumTimedRuns; ++i) {
+    current.elapsed = Min(current.elapsed, Run(MODE_CURRENT).elapsed);
+    former.elapsed = Min(former.elapsed, Run(MODE_FORMER).elapsed);
+    baseline.elapsed = Min(baseline.elapsed, Run(MODE_BASELINE).elapsed);
+  }
+  double current_ns = (current.elapsed - baseline.elapsed) /
+      current.num_passes;
+  double former_ns = (former.elapsed - baseline.elapsed) / former.num_passes;
+
+  printf("%u passes over %us, %u user actions, %u passes with sequencer "
+         "changes\n", verified.num_passes, kDuration, verified.num_actions,
+         verified.num_changed_passes);
+  printf("stale after a pass: %u leds, %u screens\n", verified.num_stale_leds,
+         verified.num_stale_screens);
+  printf("%-20s %10s %10s\n", "", "DoEvents", "former");
+  printf("%-20s %10u %10u\n", "screen redraws", current.num_screen_updates,
+         former.num_screen_updates);
+  printf("%-20s %10u %10u\n", "page led refreshes", current.num_led_updates,
+         former.num_led_updates);
+  printf("%-20s %10.1f %10.1f\n", "host ns per pass", current_ns, former_ns);
+
+  int failures = 0;
+  if (verified.num_stale_leds || verified.num_stale_screens) {
+    ++failures;
+  }
+  if (current.num_led_updates >= former.num_led_updates ||
+      current.num_screen_updates > former.num_screen_updates) {
+    ++failures;
+  }
+  return check && failures ? 1 : 0;
+}